@@ -0,0 +1,117 @@
+//=================================================================//
+// This file is part of the BrainGenix-NES Neuron Emulation System //
+//=================================================================//
+
+/*
+    Description: Micro-benchmark of the per-request cost of NES batch dispatch, running
+                 RPCManager::NESRequest() on batches of Simulation/Geometry/Sphere/Create
+                 requests, once through the JSON route of GeometryRPCInterface and once
+                 through a string route registered with the RPCManager::AddRoute() adapter.
+    Additional Notes: Links against the NES core library and its dependencies (rpclib,
+                      BG-Logger, ...), build with e.g.
+                      g++ -O2 -std=c++17 -I../Source/Core -I<vcpkg include dir> RPC/NESDispatchBenchmark.cpp
+                          <build dir>/libbraingenix_nes.a <libraries of the BrainGenix-NES target> -o NESDispatchBenchmark
+                      The RPCManager starts its RPC server, on the port given as third
+                      argument (default 0, a free port picked by the system).
+    Date Created: 2026-10-17
+*/
+
+// Standard Libraries (BG convention: use <> instead of "")
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+
+// Third-Party Libraries (BG convention: use <> instead of "")
+#include <nlohmann/json.hpp>
+
+// Internal Libraries (BG convention: use <> instead of "")
+#include <BG/Common/Logger/Logger.h>
+#include <Config/Config.h>
+#include <RPC/RPCManager.h>
+#include <Simulator/RPC/GeometryRPCInterface.h>
+#include <Simulator/Structs/Simulation.h>
+#include <Simulator/Structs/RecordingElectrode.h>
+#include <Util/SafeContainers.h>
+
+
+// The string route is the same handler behind the text round trip that
+// handlers registered with AddRoute() pay for, as all of them did before
+// AddJSONRoute().
+static const std::string JSONRoute = "Simulation/Geometry/Sphere/Create";
+static const std::string StringRoute = "Benchmark/StringSphereCreate";
+
+std::string MakeBatch(const std::string& _Route, int _NumRequests) {
+    nlohmann::json Batch = nlohmann::json::array();
+    for (int i = 0; i < _NumRequests; i++) {
+        nlohmann::json Params;
+        Params["SimulationID"] = 0;
+        Params["Name"] = "Sphere" + std::to_string(i);
+        Params["Radius_um"] = 1.5 + 0.001 * i;
+        Params["CenterPosX_um"] = 0.25 * i;
+        Params["CenterPosY_um"] = 12.5;
+        Params["CenterPosZ_um"] = -3.75;
+        Batch.push_back({ { "ReqID", i }, { _Route, Params } });
+    }
+    return Batch.dump();
+}
+
+template <typename F>
+double MicrosecondsPerRequest(F _Dispatch, int _NumRequests, int _Repetitions) {
+    double Total_us = 0.0;
+    for (int r = 0; r < _Repetitions; r++) {
+        auto Start = std::chrono::steady_clock::now();
+        _Dispatch();
+        std::chrono::duration<double, std::micro> Elapsed = std::chrono::steady_clock::now() - Start;
+        Total_us += Elapsed.count();
+    }
+    return Total_us / (double(_NumRequests) * _Repetitions);
+}
+
+int main(int _NumArgs, char** _Args) {
+    int NumRequests = (_NumArgs > 1) ? std::atoi(_Args[1]) : 10000;
+    int Repetitions = (_NumArgs > 2) ? std::atoi(_Args[2]) : 20;
+
+    BG::Common::Logger::LoggingSystem Logger;
+    BG::NES::Config::Config Config;
+    Config.PortNumber = (_NumArgs > 3) ? std::atoi(_Args[3]) : 0;
+
+    BG::NES::API::RPCManager Manager(&Config, &Logger);
+    BG::NES::ConcurrentUniquePtrRegistry<BG::NES::Simulator::Simulation> Simulations;
+    BG::NES::Simulator::Simulation* Sim = Simulations.read(Simulations.append(std::make_unique<BG::NES::Simulator::Simulation>(&Logger)));
+    BG::NES::Simulator::GeometryRPCInterface Geometry(&Logger, &Simulations, &Manager);
+    Manager.AddRoute(StringRoute, [&Geometry](std::string _JSONRequest) {
+        return Geometry.SphereCreate(nlohmann::json::parse(_JSONRequest)).dump();
+    });
+
+    std::string JSONBatch = MakeBatch(JSONRoute, NumRequests);
+    std::string StringBatch = MakeBatch(StringRoute, NumRequests);
+
+    // Every batch starts on an empty model, so that the shape IDs and the
+    // replay log are the same in every repetition.
+    auto Dispatch = [&](const std::string& _Batch) {
+        Sim->ClearModel();
+        Sim->ClearStoredRequests();
+        return Manager.NESRequest(_Batch);
+    };
+
+    // Warm up, then make sure that both routes answer the same.
+    if (Dispatch(StringBatch) != Dispatch(JSONBatch)) {
+        std::cerr << "Responses differ\n";
+        return 1;
+    }
+    if (Sim->Collection.Size() != size_t(NumRequests)) {
+        std::cerr << "Not all spheres were created\n";
+        return 1;
+    }
+
+    double StringUs = MicrosecondsPerRequest([&]() { Dispatch(StringBatch); }, NumRequests, Repetitions);
+    double JSONUs = MicrosecondsPerRequest([&]() { Dispatch(JSONBatch); }, NumRequests, Repetitions);
+
+    std::cout << "Batch of " << NumRequests << " Sphere/Create requests, " << Repetitions << " repetitions\n";
+    std::cout << "String route through AddRoute() adapter: " << StringUs << " us/request\n";
+    std::cout << "JSON route (AddJSONRoute()):             " << JSONUs << " us/request\n";
+    return 0;
+}
@@ -0,0 +1,173 @@
+//=================================================================//
+// This file is part of the BrainGenix-NES Neuron Emulation System //
+//=================================================================//
+
+/*
+    Description: Latency benchmark of the simulation engine thread hand-over. Issues
+                 thousands of short RunFor commands to a Simulation, the way the
+                 Simulation/RunFor route does, and waits for each like a client that
+                 polls IsSimulating.
+    Additional Notes: The engine thread is the real SimulationEngineThread(), started like
+                      SimulationRPCInterface does. The render and visualizer pools are
+                      created without render threads, RunFor does not use them. For
+                      comparison, the polling loop that SimulationEngineThread() had
+                      before (10 ms sleep when idle) runs the same Engine on the same
+                      Simulation; that loop no longer exists in the tree and is
+                      reproduced here.
+                      Links against the NES core library and its dependencies, build with e.g.
+                      g++ -O2 -std=c++17 -I../Source/Core -I<vcpkg include dir> Simulator/EngineLatencyBenchmark.cpp
+                          <build dir>/libbraingenix_nes.a <libraries of the BrainGenix-NES target> -o EngineLatencyBenchmark
+    Date Created: 2026-10-17
+*/
+
+// Standard Libraries (BG convention: use <> instead of "")
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// Third-Party Libraries (BG convention: use <> instead of "")
+#include <nlohmann/json.hpp>
+
+// Internal Libraries (BG convention: use <> instead of "")
+#include <BG/Common/Logger/Logger.h>
+#include <Config/Config.h>
+#include <Simulator/Engine.h>
+#include <Simulator/EngineController.h>
+#include <Simulator/Geometries/Sphere.h>
+#include <Simulator/Structs/Simulation.h>
+#include <Simulator/Structs/RecordingElectrode.h>
+#include <VSDA/RenderPool.h>
+#include <Visualizer/VisualizerPool.h>
+
+
+using namespace BG::NES::Simulator;
+
+// A small network of ball-and-stick neurons, a RunFor of 1 ms simulated time
+// takes a few microseconds, so the hand-over dominates the response time.
+std::unique_ptr<Simulation> MakeSimulation(BG::Common::Logger::LoggingSystem* _Logger, int _NumNeurons) {
+    auto Sim = std::make_unique<Simulation>(_Logger);
+    Sim->Dt_ms = 0.1;
+    for (int i = 0; i < _NumNeurons; i++) {
+        Geometries::Sphere S(Geometries::Vec3D(10.0 * i, 0.0, 0.0), 2.0);
+        Compartments::BS C;
+        C.Name = "Soma" + std::to_string(i);
+        C.ShapeID = Sim->AddSphere(S);
+        C.MembranePotential_mV = -60.0;
+        C.SpikeThreshold_mV = -50.0;
+        C.DecayTime_ms = 30.0;
+        C.RestingPotential_mV = -60.0;
+        C.AfterHyperpolarizationAmplitude_mV = -10.0;
+        int SomaID = Sim->AddSCCompartment(C, BSNEURONS);
+
+        CoreStructs::BSNeuronStruct N;
+        N.Name = "Neuron" + std::to_string(i);
+        N.SomaCompartmentID = SomaID;
+        N.AxonCompartmentID = SomaID;
+        N.MembranePotential_mV = -60.0;
+        N.RestingPotential_mV = -60.0;
+        N.SpikeThreshold_mV = -50.0;
+        N.DecayTime_ms = 30.0;
+        N.AfterHyperpolarizationAmplitude_mV = -10.0;
+        N.PostsynapticPotentialRiseTime_ms = 5.0;
+        N.PostsynapticPotentialDecayTime_ms = 25.0;
+        N.PostsynapticPotentialAmplitude_nA = 1.0;
+        N.SomaCompartmentPtr = Sim->FindBSCompartmentByID(SomaID);
+        N.AxonCompartmentPtr = N.SomaCompartmentPtr;
+        Sim->AddBSNeuron(N);
+    }
+    return Sim;
+}
+
+// The engine loop before it waited on RequestWork(): poll the flag, sleep
+// 10 ms when there is no work. Only handles RunFor.
+void PollingEngineThread(Simulation* _Sim, std::atomic<bool>* _StopThreads) {
+    Engine SE;
+    while ((!*_StopThreads) && _Sim->KeepResident) {
+        if (_Sim->WorkRequested && (_Sim->CurrentTask == SIMULATION_RUNFOR)) {
+            _Sim->IsProcessing = true;
+            SE.RunFor(_Sim);
+            _Sim->CurrentTask = SIMULATION_NONE;
+            _Sim->WorkRequested = false;
+            _Sim->IsProcessing = false;
+        } else {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+    }
+}
+
+struct Result {
+    double Mean_us = 0.0;
+    double P50_us = 0.0;
+    double P99_us = 0.0;
+};
+
+// Issues _NumCommands RunFor commands one after the other. Each command is
+// issued once the last is done, i.e. once IsSimulating would be false.
+Result Measure(Simulation* _Sim, int _NumCommands) {
+    std::vector<double> Latencies_us;
+    Latencies_us.reserve(_NumCommands);
+    for (int i = 0; i < _NumCommands; i++) {
+        auto Start = std::chrono::steady_clock::now();
+        _Sim->RequestRun(1.0, _Sim->Dt_ms);
+        while (_Sim->WorkRequested || _Sim->IsProcessing) {
+            std::this_thread::yield();
+        }
+        std::chrono::duration<double, std::micro> Elapsed = std::chrono::steady_clock::now() - Start;
+        Latencies_us.push_back(Elapsed.count());
+    }
+
+    Result R;
+    for (double L : Latencies_us) {
+        R.Mean_us += L;
+    }
+    R.Mean_us /= Latencies_us.size();
+    std::sort(Latencies_us.begin(), Latencies_us.end());
+    R.P50_us = Latencies_us[Latencies_us.size() / 2];
+    R.P99_us = Latencies_us[(Latencies_us.size() * 99) / 100];
+    return R;
+}
+
+void Print(const char* _Name, const Result& _R) {
+    std::cout << _Name << "mean " << _R.Mean_us << " us, p50 " << _R.P50_us << " us, p99 " << _R.P99_us << " us\n";
+}
+
+int main(int _NumArgs, char** _Args) {
+    int NumCommands = (_NumArgs > 1) ? std::atoi(_Args[1]) : 2000;
+    int NumNeurons = (_NumArgs > 2) ? std::atoi(_Args[2]) : 10;
+
+    BG::Common::Logger::LoggingSystem Logger;
+    BG::NES::Config::Config Config;
+    VSDA::RenderPool RenderPool(&Config, &Logger, false, 0);
+    VisualizerPool VisualizerPool(&Logger, false, 0);
+
+    std::cout << NumCommands << " RunFor commands of 1 ms simulated time, " << NumNeurons << " BS neurons\n";
+
+    {
+        std::atomic<bool> StopThreads{false};
+        std::unique_ptr<Simulation> Sim = MakeSimulation(&Logger, NumNeurons);
+        std::thread EngineThread(&PollingEngineThread, Sim.get(), &StopThreads);
+        Result R = Measure(Sim.get(), NumCommands);
+        StopThreads = true;
+        EngineThread.join();
+        Print("Polling engine loop (before):    ", R);
+    }
+
+    {
+        std::atomic<bool> StopThreads{false};
+        std::unique_ptr<Simulation> Sim = MakeSimulation(&Logger, NumNeurons);
+        std::thread EngineThread(&SimulationEngineThread, &Logger, Sim.get(), &RenderPool, &VisualizerPool, &StopThreads);
+        Result R = Measure(Sim.get(), NumCommands);
+        nlohmann::json Stats = Sim->GetEngineStatsJSON();
+        StopThreads = true;
+        Sim->WakeEngine();
+        EngineThread.join();
+        Print("SimulationEngineThread (after):  ", R);
+        std::cout << "Engine stats: " << Stats["NumCommands"] << " commands, mean request to pick-up " << Stats["MeanWait_ms"] << " ms\n";
+    }
+    return 0;
+}
@@ -0,0 +1,151 @@
+//=================================================================//
+// This file is part of the BrainGenix-NES Neuron Emulation System //
+//=================================================================//
+
+/*
+    Description: Rasterization benchmark of the polar sampling that FillCylinderPart used against
+                 the scanline cone frustum rasterizer, over tapered dendritic arbors of the kind
+                 Netmorph grows.
+    Additional Notes: Build from the Benchmarking directory with e.g.
+                      g++ -O2 -std=c++17 -I../Source/Core Simulator/FrustumRasterizerBenchmark.cpp
+                          ../Source/Core/Simulator/Geometries/FrustumRasterizer.cpp
+                          ../Source/Core/Simulator/Geometries/BakedGeometry.cpp
+                          ../Source/Core/Simulator/Geometries/Cylinder.cpp
+                          ../Source/Core/Simulator/Geometries/VecTools.cpp
+                          ../Source/Core/Simulator/Structs/BoundingBox.cpp
+                          ../Source/Core/VSDA/Ca/VoxelSubsystem/Structs/CaVoxelArray.cpp -o FrustumRasterizerBenchmark
+    Date Created: 2026-10-17
+*/
+
+// Standard Libraries (BG convention: use <> instead of "")
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+// Internal Libraries (BG convention: use <> instead of "")
+#include <Simulator/Geometries/BakedGeometry.h>
+#include <Simulator/Geometries/Cylinder.h>
+#include <Simulator/Geometries/FrustumRasterizer.h>
+#include <Simulator/Geometries/VecTools.h>
+
+
+using namespace BG::NES::Simulator::Geometries;
+
+double Elapsed_ms(std::chrono::steady_clock::time_point _Start) {
+    std::chrono::duration<double, std::milli> Elapsed = std::chrono::steady_clock::now() - _Start;
+    return Elapsed.count();
+}
+
+// Arbors grown from somas spread over the region: segments of 1-5 um that
+// bend a little at each step, branch now and then and taper towards the tips.
+std::vector<BakedCylinder> GrowArbors(int _NumNeurons, float _Extent_um, std::mt19937& _Generator) {
+    std::uniform_real_distribution<float> Position(0.2 * _Extent_um, 0.8 * _Extent_um);
+    std::uniform_real_distribution<float> Unit(-1.0, 1.0);
+    std::uniform_real_distribution<float> Length(1.0, 5.0);
+    std::uniform_real_distribution<float> Chance(0.0, 1.0);
+    BG::NES::VSDA::WorldInfo Info;
+
+    struct Tip { Vec3D Position_um; Vec3D Direction; float Radius_um; int Depth; };
+    std::vector<BakedCylinder> Segments;
+    for (int n = 0; n < _NumNeurons; n++) {
+        Vec3D Soma(Position(_Generator), Position(_Generator), Position(_Generator));
+        std::vector<Tip> Tips;
+        for (int d = 0; d < 6; d++) {
+            Tips.push_back(Tip{Soma, Vec3D(Unit(_Generator), Unit(_Generator), Unit(_Generator)).Normalize(), 1.2, 0});
+        }
+        while (!Tips.empty()) {
+            Tip T = Tips.back();
+            Tips.pop_back();
+            if ((T.Depth > 40) || (T.Radius_um < 0.1)) {
+                continue;
+            }
+            Vec3D Bend(Unit(_Generator), Unit(_Generator), Unit(_Generator));
+            Vec3D Direction = (T.Direction + Bend * 0.3).Normalize();
+            Vec3D End = T.Position_um + Direction * Length(_Generator);
+            float EndRadius_um = T.Radius_um * 0.95;
+            Segments.push_back(BakeCylinder(Cylinder(T.Radius_um, T.Position_um, EndRadius_um, End), Info));
+            Tips.push_back(Tip{End, Direction, EndRadius_um, T.Depth + 1});
+            if (Chance(_Generator) < 0.12) {
+                Tips.push_back(Tip{End, (Direction + Bend).Normalize(), EndRadius_um * 0.8f, T.Depth + 1});
+            }
+        }
+    }
+    return Segments;
+}
+
+// The sampling FillCylinderPart used: discs at half-voxel steps along the
+// axis, circles at half-voxel steps on each, each sample rounded to a voxel.
+size_t PolarSampling(const BakedCylinder& _C, const VoxelGrid& _Grid, std::vector<uint8_t>& _Voxels) {
+    size_t Samples = 0;
+    auto Write = [&](const Vec3D& _Point) {
+        int X = std::round((_Point.x - _Grid.Origin_um.x) / _Grid.VoxelScale_um);
+        int Y = std::round((_Point.y - _Grid.Origin_um.y) / _Grid.VoxelScale_um);
+        int Z = std::round((_Point.z - _Grid.Origin_um.z) / _Grid.VoxelScale_um);
+        Samples++;
+        if ((X >= 0) && (X < _Grid.Size[0]) && (Y >= 0) && (Y < _Grid.Size[1]) && (Z >= 0) && (Z < _Grid.Size[2])) {
+            _Voxels[(size_t(X) * _Grid.Size[1] + Y) * _Grid.Size[2] + Z] = 1;
+        }
+    };
+    float Step = 0.5 * _Grid.VoxelScale_um;
+    float RadiusDifference = _C.End1Radius_um - _C.End0Radius_um;
+    float MidpointRadius = _C.End0Radius_um + 0.5 * RadiusDifference;
+    for (float z = -0.5 * _C.Length_um; z <= 0.5 * _C.Length_um; z += Step) {
+        float RadiusAtZ = MidpointRadius + (z / _C.Length_um) * RadiusDifference;
+        Vec3D DiscCenter = _C.Midpoint_um + _C.AxisFrame[2] * z;
+        Write(DiscCenter);
+        for (float r = Step; r <= RadiusAtZ; r += Step) {
+            for (float Theta = 0; Theta < 2.0 * M_PI; Theta += Step / r) {
+                Write(DiscCenter + _C.AxisFrame[0] * (r * std::sin(Theta)) + _C.AxisFrame[1] * (r * std::cos(Theta)));
+            }
+        }
+    }
+    return Samples;
+}
+
+int main(int _NumArgs, char** _Args) {
+    int NumNeurons = (_NumArgs > 1) ? std::atoi(_Args[1]) : 20;
+    float VoxelScale_um = (_NumArgs > 2) ? std::atof(_Args[2]) : 0.1;
+    const float Extent_um = 40.0;
+
+    std::mt19937 Generator(42);
+    std::vector<BakedCylinder> Segments = GrowArbors(NumNeurons, Extent_um, Generator);
+
+    VoxelGrid Grid;
+    Grid.VoxelScale_um = VoxelScale_um;
+    for (int Axis = 0; Axis < 3; Axis++) {
+        Grid.Size[Axis] = int(Extent_um / VoxelScale_um);
+    }
+    std::vector<uint8_t> Voxels(size_t(Grid.Size[0]) * Grid.Size[1] * Grid.Size[2], 0);
+
+    // Before: polar sampling.
+    auto Start = std::chrono::steady_clock::now();
+    size_t Samples = 0;
+    for (const BakedCylinder& C : Segments) {
+        Samples += PolarSampling(C, Grid, Voxels);
+    }
+    double Sampling_ms = Elapsed_ms(Start);
+    size_t SampledVoxels = std::count(Voxels.begin(), Voxels.end(), 1);
+
+    // After: one run per voxel row.
+    std::fill(Voxels.begin(), Voxels.end(), 0);
+    Start = std::chrono::steady_clock::now();
+    size_t Runs = 0;
+    for (const BakedCylinder& C : Segments) {
+        RasterizeFrustum(C, Grid, 1, 0, [&](int _X, int _Y, int _ZBegin, int _ZEnd) {
+            uint8_t* Row = &Voxels[(size_t(_X) * Grid.Size[1] + _Y) * Grid.Size[2]];
+            std::fill(Row + _ZBegin, Row + _ZEnd, 1);
+            Runs++;
+        });
+    }
+    double Scanline_ms = Elapsed_ms(Start);
+    size_t ScanlineVoxels = std::count(Voxels.begin(), Voxels.end(), 1);
+
+    std::cout << Segments.size() << " segments of " << NumNeurons << " neurons, " << VoxelScale_um << " um voxels\n";
+    std::cout << "Polar sampling (before): " << Sampling_ms << " ms, " << Samples << " samples, " << SampledVoxels << " voxels\n";
+    std::cout << "Scanline (after):        " << Scanline_ms << " ms, " << Runs << " runs, " << ScanlineVoxels << " voxels\n";
+    return 0;
+}
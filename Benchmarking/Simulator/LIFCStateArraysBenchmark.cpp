@@ -0,0 +1,167 @@
+//=================================================================//
+// This file is part of the BrainGenix-NES Neuron Emulation System //
+//=================================================================//
+
+/*
+    Description: Benchmark of the LIFC neuron update with the structure-of-arrays
+                 engine (use_lifc_state_arrays) against the per-object update, serially
+                 and on the parallel update pool.
+    Additional Notes: Builds a randomly connected, spontaneously active LIFC network and
+                      times RunFor() on identical copies of it, so the timings include
+                      conductances, spike delivery and STDP, not only the kernels.
+                      Links against the NES core library and its dependencies, build with e.g.
+                      g++ -O2 -std=c++17 -I../Source/Core -I<vcpkg include dir> Simulator/LIFCStateArraysBenchmark.cpp
+                          <build dir>/libbraingenix_nes.a <libraries of the BrainGenix-NES target> -o LIFCStateArraysBenchmark
+    Date Created: 2026-10-17
+*/
+
+// Standard Libraries (BG convention: use <> instead of "")
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <random>
+#include <vector>
+
+// Third-Party Libraries (BG convention: use <> instead of "")
+
+// Internal Libraries (BG convention: use <> instead of "")
+#include <BG/Common/Logger/Logger.h>
+#include <Simulator/Geometries/Sphere.h>
+#include <Simulator/Structs/Simulation.h>
+#include <Simulator/Structs/RecordingElectrode.h>
+
+
+using namespace BG::NES::Simulator;
+
+std::unique_ptr<Simulation> MakeNetwork(BG::Common::Logger::LoggingSystem* _Logger, int _NumNeurons, int _ReceptorsPerNeuron) {
+    auto Sim = std::make_unique<Simulation>(_Logger);
+    Sim->SetRandomSeed(1);
+    Sim->Dt_ms = 0.1;
+
+    std::vector<int> CompartmentIDs;
+    for (int i = 0; i < _NumNeurons; i++) {
+        Geometries::Sphere S(Geometries::Vec3D(10.0 * i, 0.0, 0.0), 2.0);
+        Compartments::LIFC C;
+        C.ShapeID = Sim->AddSphere(S);
+        C.RestingPotential_mV = -60.0;
+        C.ResetPotential_mV = -55.0;
+        C.SpikeThreshold_mV = -50.0;
+        C.MembraneResistance_MOhm = 100.0;
+        C.MembraneCapacitance_pF = 100.0;
+        C.AfterHyperpolarizationAmplitude_mV = 0.0;
+        CompartmentIDs.push_back(Sim->AddLIFCCompartment(C));
+
+        CoreStructs::LIFCNeuronStruct N;
+        N.RestingPotential_mV = -60.0;
+        N.ResetPotential_mV = -55.0;
+        N.SpikeThreshold_mV = -50.0;
+        N.MembraneResistance_MOhm = 100.0;
+        N.MembraneCapacitance_pF = 100.0;
+        N.RefractoryPeriod_ms = 2.0;
+        N.SpikeDepolarization_mV = 30.0;
+        N.UpdateMethod = CoreStructs::EXPEULER_CM;
+        N.ResetMethod = CoreStructs::TOVM;
+        N.AfterHyperpolarizationReversalPotential_mV = -90.0;
+        N.FastAfterHyperpolarizationRise_ms = 2.5;
+        N.FastAfterHyperpolarizationDecay_ms = 30.0;
+        N.FastAfterHyperpolarizationPeakConductance_nS = 3.0;
+        N.FastAfterHyperpolarizationMaxPeakConductance_nS = 10.0;
+        N.FastAfterHyperpolarizationHalfActConstant = 0.5;
+        N.SlowAfterHyperpolarizationRise_ms = 30.0;
+        N.SlowAfterHyperpolarizationDecay_ms = 300.0;
+        N.SlowAfterHyperpolarizationPeakConductance_nS = 1.0;
+        N.SlowAfterHyperpolarizationMaxPeakConductance_nS = 5.0;
+        N.SlowAfterHyperpolarizationHalfActConstant = 0.5;
+        N.AfterHyperpolarizationSaturationModel = CoreStructs::AHPCLIP;
+        N.FatigueThreshold = 300.0;
+        N.FatigueRecoveryTime_ms = 1000.0;
+        N.AfterDepolarizationReversalPotential_mV = -20.0;
+        N.AfterDepolarizationRise_ms = 20.0;
+        N.AfterDepolarizationDecay_ms = 200.0;
+        N.AfterDepolarizationPeakConductance_nS = 0.3;
+        N.AfterDepolarizationSaturationMultiplier = 2.0;
+        N.AfterDepolarizationRecoveryTime_ms = 300.0;
+        N.AfterDepolarizationDepletion = 0.3;
+        N.AfterDepolarizationSaturationModel = CoreStructs::ADPCLIP;
+        N.AdaptiveThresholdDiffPerSpike = 0.2;
+        N.AdaptiveTresholdRecoveryTime_ms = 50.0;
+        N.AdaptiveThresholdDiffPotential_mV = 10.0;
+        N.AdaptiveThresholdFloor_mV = -50.0;
+        N.AdaptiveThresholdFloorDeltaPerSpike_mV = 1.0;
+        N.AdaptiveThresholdFloorRecoveryTime_ms = 500.0;
+        N.SomaCompartmentIDs.push_back(CompartmentIDs.back());
+        Sim->AddLIFCNeuron(N);
+    }
+
+    std::mt19937 Generator(2);
+    std::uniform_int_distribution<int> Neuron(0, _NumNeurons - 1);
+    std::uniform_real_distribution<float> Delay(0.5, 5.0);
+    for (int i = 0; i < _NumNeurons * _ReceptorsPerNeuron; i++) {
+        Connections::LIFCReceptor R;
+        R.SourceCompartmentID = CompartmentIDs[Neuron(Generator)];
+        R.DestinationCompartmentID = CompartmentIDs[Neuron(Generator)];
+        bool Inhibitory = (i % 4) == 0;
+        R.ReversalPotential_mV = Inhibitory ? -70.0 : 0.0;
+        R.PSPRise_ms = 0.5;
+        R.PSPDecay_ms = 3.0;
+        R.PeakConductance_nS = Inhibitory ? 4.0 : 2.0;
+        R.Weight = 1.0;
+        R.OnsetDelay_ms = Delay(Generator);
+        R.Neurotransmitter = Inhibitory ? Connections::GABA : Connections::AMPA;
+        Sim->AddLIFCReceptor(R);
+    }
+
+    for (auto& NeuronPtr : Sim->Neurons) {
+        NeuronPtr->SetSpontaneousActivity(100.0, 20.0, Sim->MasterRandom_->UniformRandomInt());
+    }
+    return Sim;
+}
+
+// Returns the wall time in ms per simulated ms.
+double TimeRun(BG::Common::Logger::LoggingSystem* _Logger, int _NumNeurons, int _ReceptorsPerNeuron, float _T_ms,
+               bool _StateArrays, int _NumThreads, unsigned long& _Spikes) {
+    auto Sim = MakeNetwork(_Logger, _NumNeurons, _ReceptorsPerNeuron);
+    Sim->use_lifc_state_arrays = _StateArrays;
+    Sim->SetParallelUpdate(_NumThreads > 1, _NumThreads);
+    Sim->RunFor(10.0); // Warm up, sorts stimulation and prepares conductances
+
+    auto Start = std::chrono::steady_clock::now();
+    Sim->RunFor(_T_ms);
+    double Elapsed_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - Start).count();
+    _Spikes = Sim->TotalSpikes();
+    return Elapsed_ms / _T_ms;
+}
+
+int main(int _NumArguments, char** _Arguments) {
+    int NumNeurons = (_NumArguments > 1) ? std::atoi(_Arguments[1]) : 10000;
+    int ReceptorsPerNeuron = (_NumArguments > 2) ? std::atoi(_Arguments[2]) : 10;
+    float T_ms = (_NumArguments > 3) ? std::atof(_Arguments[3]) : 100.0;
+    int NumThreads = (_NumArguments > 4) ? std::atoi(_Arguments[4]) : 4;
+    int Repetitions = (_NumArguments > 5) ? std::atoi(_Arguments[5]) : 3;
+
+    BG::Common::Logger::LoggingSystem Logger;
+
+    std::cout << NumNeurons << " LIFC neurons, " << ReceptorsPerNeuron << " receptors per neuron, "
+              << T_ms << " ms simulated time, best of " << Repetitions << "\n";
+    std::cout << "Update | ms per simulated ms | spikes\n";
+    for (int Threads : {1, NumThreads}) {
+        // Alternate the modes, so that both see the same machine load.
+        double Best[2] = { std::numeric_limits<double>::max(), std::numeric_limits<double>::max() };
+        unsigned long Spikes[2] = { 0, 0 };
+        for (int r = 0; r < Repetitions; r++) {
+            for (int StateArrays : {0, 1}) {
+                double Time = TimeRun(&Logger, NumNeurons, ReceptorsPerNeuron, T_ms, StateArrays == 1, Threads, Spikes[StateArrays]);
+                Best[StateArrays] = std::min(Best[StateArrays], Time);
+            }
+        }
+        for (int StateArrays : {0, 1}) {
+            std::cout << (StateArrays ? "State arrays" : "Per object") << ", " << Threads << " thread(s) | "
+                      << Best[StateArrays] << " | " << Spikes[StateArrays] << "\n";
+        }
+        if (NumThreads <= 1) break;
+    }
+    return 0;
+}
@@ -0,0 +1,173 @@
+//=================================================================//
+// This file is part of the BrainGenix-NES Neuron Emulation System //
+//=================================================================//
+
+/*
+    Description: Culling benchmark of the bounding volume hierarchy against the linear scan
+                 over all shapes, for the voxelization of a sample tiled into subregions and
+                 for the neurons within the cutoff of recording electrode sites.
+    Additional Notes: Build from the Benchmarking directory with e.g.
+                      g++ -O2 -std=c++17 -I../Source/Core Simulator/SpatialIndexBenchmark.cpp
+                          ../Source/Core/Simulator/Geometries/SpatialIndex.cpp
+                          ../Source/Core/Simulator/Geometries/VecTools.cpp
+                          ../Source/Core/Simulator/Structs/BoundingBox.cpp -o SpatialIndexBenchmark
+    Date Created: 2026-10-17
+*/
+
+// Standard Libraries (BG convention: use <> instead of "")
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+// Internal Libraries (BG convention: use <> instead of "")
+#include <Simulator/Geometries/SpatialIndex.h>
+#include <Simulator/Geometries/VecTools.h>
+#include <Simulator/Structs/BoundingBox.h>
+
+
+using BG::NES::Simulator::BoundingBox;
+using BG::NES::Simulator::Geometries::BoundingVolumeHierarchy;
+using BG::NES::Simulator::Geometries::Vec3D;
+
+// Mirrors the cylinders of a morphology: short segments of random walks.
+struct Segment {
+    Vec3D End0_um;
+    Vec3D End1_um;
+    float Radius_um;
+};
+
+static const float Rotation_rad[3] = { 0.1f, 0.2f, 0.0f };
+
+// As CylinderBase::GetBoundingBox(), rotated ends extended by the radius.
+BoundingBox RegionBox(const Segment& _S) {
+    Vec3D A = _S.End0_um.rotate_around_xyz(Rotation_rad[0], Rotation_rad[1], Rotation_rad[2]);
+    Vec3D B = _S.End1_um.rotate_around_xyz(Rotation_rad[0], Rotation_rad[1], Rotation_rad[2]);
+    BoundingBox Box;
+    Box.bb_point1[0] = std::min(A.x, B.x) - _S.Radius_um;
+    Box.bb_point1[1] = std::min(A.y, B.y) - _S.Radius_um;
+    Box.bb_point1[2] = std::min(A.z, B.z) - _S.Radius_um;
+    Box.bb_point2[0] = std::max(A.x, B.x) + _S.Radius_um;
+    Box.bb_point2[1] = std::max(A.y, B.y) + _S.Radius_um;
+    Box.bb_point2[2] = std::max(A.z, B.z) + _S.Radius_um;
+    return Box;
+}
+
+double Elapsed_ms(std::chrono::steady_clock::time_point _Start) {
+    std::chrono::duration<double, std::milli> Elapsed = std::chrono::steady_clock::now() - _Start;
+    return Elapsed.count();
+}
+
+int main(int _NumArgs, char** _Args) {
+    size_t NumShapes = (_NumArgs > 1) ? std::atol(_Args[1]) : 200000;
+    int TilesPerAxis = (_NumArgs > 2) ? std::atoi(_Args[2]) : 8;
+    const float Extent_um = 1000.0;
+
+    std::mt19937 Generator(42);
+    std::uniform_real_distribution<float> Position(0.0, Extent_um);
+    std::uniform_real_distribution<float> Step(-10.0, 10.0);
+    std::vector<Segment> Segments;
+    Vec3D Tip;
+    for (size_t i = 0; i < NumShapes; i++) {
+        if (i % 100 == 0) {
+            Tip = Vec3D(Position(Generator), Position(Generator), Position(Generator));
+        }
+        Vec3D Next = Tip + Vec3D(Step(Generator), Step(Generator), Step(Generator));
+        Segments.push_back(Segment{Tip, Next, 1.0});
+        Tip = Next;
+    }
+
+    // Subregions as the renderer would voxelize them, one after the other.
+    std::vector<BoundingBox> Tiles;
+    float Tile_um = Extent_um / TilesPerAxis;
+    for (int x = 0; x < TilesPerAxis; x++) {
+        for (int y = 0; y < TilesPerAxis; y++) {
+            BoundingBox Tile;
+            Tile.bb_point1[0] = x * Tile_um;
+            Tile.bb_point1[1] = y * Tile_um;
+            Tile.bb_point1[2] = 0.4 * Extent_um;
+            Tile.bb_point2[0] = (x + 1) * Tile_um;
+            Tile.bb_point2[1] = (y + 1) * Tile_um;
+            Tile.bb_point2[2] = 0.5 * Extent_um;
+            Tiles.push_back(Tile);
+        }
+    }
+
+    // Before: rotate and test every shape for every subregion.
+    auto Start = std::chrono::steady_clock::now();
+    size_t LinearFound = 0;
+    for (auto& Tile : Tiles) {
+        for (const Segment& S : Segments) {
+            if (RegionBox(S).IsIntersecting(Tile)) {
+                LinearFound++;
+            }
+        }
+    }
+    double Linear_ms = Elapsed_ms(Start);
+
+    // After: build the index once, query it for every subregion.
+    Start = std::chrono::steady_clock::now();
+    BoundingVolumeHierarchy Tree;
+    std::vector<BoundingBox> Boxes;
+    for (const Segment& S : Segments) {
+        Boxes.push_back(RegionBox(S));
+    }
+    Tree.Build(Boxes);
+    double Build_ms = Elapsed_ms(Start);
+
+    Start = std::chrono::steady_clock::now();
+    size_t IndexedFound = 0;
+    std::vector<size_t> Found;
+    for (auto& Tile : Tiles) {
+        Tree.QueryAABB(Tile, Found);
+        IndexedFound += Found.size();
+    }
+    double Query_ms = Elapsed_ms(Start);
+
+    std::cout << NumShapes << " cylinders, " << Tiles.size() << " subregions, " << LinearFound << " shapes found (" << IndexedFound << " indexed)\n";
+    std::cout << "Linear scan (before):  " << Linear_ms << " ms\n";
+    std::cout << "BVH (after):           " << Build_ms + Query_ms << " ms (build " << Build_ms << " ms, queries " << Query_ms << " ms)\n";
+
+    // Electrode sites along a shank, neurons within a 100 um cutoff.
+    std::vector<Vec3D> Somas;
+    std::vector<BoundingBox> SomaPoints;
+    for (size_t i = 0; i < NumShapes / 100; i++) {
+        Somas.emplace_back(Position(Generator), Position(Generator), Position(Generator));
+        const Vec3D& C = Somas.back();
+        SomaPoints.push_back(BoundingBox{{C.x, C.y, C.z}, {C.x, C.y, C.z}});
+    }
+    std::vector<Vec3D> Sites;
+    for (int i = 0; i < 384; i++) {
+        Sites.emplace_back(500.0, 500.0, 100.0 + 2.0 * i);
+    }
+    const float Cutoff_um = 100.0;
+
+    Start = std::chrono::steady_clock::now();
+    size_t LinearNearby = 0;
+    for (const Vec3D& Site : Sites) {
+        for (const Vec3D& Soma : Somas) {
+            float Distance = Soma.Distance(Site);
+            if (Distance * Distance <= Cutoff_um * Cutoff_um) {
+                LinearNearby++;
+            }
+        }
+    }
+    Linear_ms = Elapsed_ms(Start);
+
+    Start = std::chrono::steady_clock::now();
+    BoundingVolumeHierarchy SomaIndex;
+    SomaIndex.Build(SomaPoints);
+    size_t IndexedNearby = 0;
+    for (const Vec3D& Site : Sites) {
+        SomaIndex.QueryRadius(Site, Cutoff_um, Found);
+        IndexedNearby += Found.size();
+    }
+    double Indexed_ms = Elapsed_ms(Start);
+
+    std::cout << Somas.size() << " somas, " << Sites.size() << " sites, " << LinearNearby << " within the cutoff (" << IndexedNearby << " indexed)\n";
+    std::cout << "Linear scan (before):  " << Linear_ms << " ms\n";
+    std::cout << "BVH (after):           " << Indexed_ms << " ms\n";
+    return 0;
+}
@@ -0,0 +1,185 @@
+//=================================================================//
+// This file is part of the BrainGenix-NES Neuron Emulation System //
+//=================================================================//
+
+/*
+    Description: Memory and render time benchmark of the dense EM voxel array against the sparse,
+                 bricked one, for subregions holding Netmorph-like arbors at several densities.
+    Additional Notes: Build from the Benchmarking directory with e.g.
+                      g++ -O2 -std=c++17 -I../Source/Core -I<vcpkg include dir> Simulator/VoxelArrayStorageBenchmark.cpp
+                          ../Source/Core/VSDA/EM/VoxelSubsystem/Structs/VoxelArray.cpp
+                          ../Source/Core/Simulator/Geometries/FrustumRasterizer.cpp
+                          ../Source/Core/Simulator/Geometries/BakedGeometry.cpp
+                          ../Source/Core/Simulator/Geometries/Cylinder.cpp
+                          ../Source/Core/Simulator/Geometries/VecTools.cpp
+                          ../Source/Core/Simulator/Structs/BoundingBox.cpp
+                          ../Source/Core/VSDA/Common/Structs/ScanRegion.cpp
+                          ../Source/Core/VSDA/Ca/VoxelSubsystem/Structs/CaVoxelArray.cpp
+                          <BG-Logger library> -o VoxelArrayStorageBenchmark
+    Date Created: 2026-10-17
+*/
+
+// Standard Libraries (BG convention: use <> instead of "")
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+// Internal Libraries (BG convention: use <> instead of "")
+#include <Simulator/Geometries/BakedGeometry.h>
+#include <Simulator/Geometries/Cylinder.h>
+#include <Simulator/Geometries/FrustumRasterizer.h>
+#include <Simulator/Geometries/VecTools.h>
+
+#include <VSDA/EM/VoxelSubsystem/Structs/VoxelArray.h>
+
+#include <BG/Common/Logger/Logger.h>
+
+
+using namespace BG::NES::Simulator;
+using namespace BG::NES::Simulator::Geometries;
+
+double Elapsed_ms(std::chrono::steady_clock::time_point _Start) {
+    std::chrono::duration<double, std::milli> Elapsed = std::chrono::steady_clock::now() - _Start;
+    return Elapsed.count();
+}
+
+// Arbors grown from somas spread over the region: segments of 1-5 um that
+// bend a little at each step, branch now and then and taper towards the tips.
+std::vector<BakedCylinder> GrowArbors(int _NumNeurons, float _Extent_um, std::mt19937& _Generator) {
+    std::uniform_real_distribution<float> Position(0.0, _Extent_um);
+    std::uniform_real_distribution<float> Unit(-1.0, 1.0);
+    std::uniform_real_distribution<float> Length(1.0, 5.0);
+    std::uniform_real_distribution<float> Chance(0.0, 1.0);
+    BG::NES::VSDA::WorldInfo Info;
+
+    struct Tip { Vec3D Position_um; Vec3D Direction; float Radius_um; int Depth; };
+    std::vector<BakedCylinder> Segments;
+    for (int n = 0; n < _NumNeurons; n++) {
+        Vec3D Soma(Position(_Generator), Position(_Generator), Position(_Generator));
+        std::vector<Tip> Tips;
+        for (int d = 0; d < 6; d++) {
+            Tips.push_back(Tip{Soma, Vec3D(Unit(_Generator), Unit(_Generator), Unit(_Generator)).Normalize(), 1.2, 0});
+        }
+        while (!Tips.empty()) {
+            Tip T = Tips.back();
+            Tips.pop_back();
+            if ((T.Depth > 40) || (T.Radius_um < 0.1)) {
+                continue;
+            }
+            Vec3D Bend(Unit(_Generator), Unit(_Generator), Unit(_Generator));
+            Vec3D Direction = (T.Direction + Bend * 0.3).Normalize();
+            Vec3D End = T.Position_um + Direction * Length(_Generator);
+            float EndRadius_um = T.Radius_um * 0.95;
+            Segments.push_back(BakeCylinder(Cylinder(T.Radius_um, T.Position_um, EndRadius_um, End), Info));
+            Tips.push_back(Tip{End, Direction, EndRadius_um, T.Depth + 1});
+            if (Chance(_Generator) < 0.12) {
+                Tips.push_back(Tip{End, (Direction + Bend).Normalize(), EndRadius_um * 0.8f, T.Depth + 1});
+            }
+        }
+    }
+    return Segments;
+}
+
+struct Result {
+    double Clear_ms = 0.0;
+    double Voxelize_ms = 0.0;
+    double Render_ms = 0.0;
+    double Memory_MiB = 0.0;
+    uint64_t Checksum = 0;
+};
+
+// Clears the array, composites the segments as FillCylinderPart does and then
+// renders every slice the way the image processor pool composes its images.
+Result Run(VoxelArray& _Array, const std::vector<BakedCylinder>& _Segments) {
+    Result R;
+    auto Start = std::chrono::steady_clock::now();
+    _Array.ClearArrayThreaded(std::thread::hardware_concurrency());
+    R.Clear_ms = Elapsed_ms(Start);
+
+    VoxelGrid Grid;
+    Grid.VoxelScale_um = _Array.GetResolution();
+    Grid.Size[0] = _Array.GetX();
+    Grid.Size[1] = _Array.GetY();
+    Grid.Size[2] = _Array.GetZ();
+    Start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < _Segments.size(); i++) {
+        const BakedCylinder& C = _Segments[i];
+        uint32_t PaletteIndex = _Array.GetPaletteIndex(i + 1);
+        RasterizeFrustum(C, Grid, 1, 0, [&](int _X, int _Y, int _ZBegin, int _ZEnd) {
+            for (int Z = _ZBegin; Z < _ZEnd; Z++) {
+                Vec3D Point = _Array.GetPositionAtIndex(_X, _Y, Z);
+                _Array.CompositeVoxelAtIndex(_X, _Y, Z, VoxelState_INTERIOR, GetFrustumDistanceToEdge(C, Point), PaletteIndex);
+            }
+        });
+    }
+    _Array.CollapseUniformBricks();
+    R.Voxelize_ms = Elapsed_ms(Start);
+    R.Memory_MiB = _Array.GetAllocatedBytes() / 1024. / 1024.;
+
+    std::vector<uint8_t> Image(size_t(Grid.Size[0]) * Grid.Size[1]);
+    Start = std::chrono::steady_clock::now();
+    for (int Z = 0; Z < Grid.Size[2]; Z++) {
+        for (unsigned int BrickStartX = 0; BrickStartX < unsigned(Grid.Size[0]); BrickStartX = GetNextBrickStart(BrickStartX)) {
+            for (unsigned int BrickStartY = 0; BrickStartY < unsigned(Grid.Size[1]); BrickStartY = GetNextBrickStart(BrickStartY)) {
+                CompactVoxelType BrickValue;
+                bool IsBrickUniform = _Array.GetUniformBrick(BrickStartX, BrickStartY, Z, &BrickValue);
+                unsigned int BrickEndX = std::min(unsigned(Grid.Size[0]), GetNextBrickStart(BrickStartX));
+                unsigned int BrickEndY = std::min(unsigned(Grid.Size[1]), GetNextBrickStart(BrickStartY));
+                for (unsigned int X = BrickStartX; X < BrickEndX; X++) {
+                    for (unsigned int Y = BrickStartY; Y < BrickEndY; Y++) {
+                        if (IsBrickUniform && (BrickValue.State_ == VoxelState_EMPTY)) {
+                            Image[size_t(X) * Grid.Size[1] + Y] = 240;
+                            continue;
+                        }
+                        CompactVoxelType Voxel = IsBrickUniform ? BrickValue : _Array.GetCompactVoxel(X, Y, Z);
+                        Image[size_t(X) * Grid.Size[1] + Y] = (Voxel.State_ == VoxelState_EMPTY) ? 240 : std::max(0, 180 - 10 * int(Voxel.DistanceToEdge_vox_));
+                    }
+                }
+            }
+        }
+        for (uint8_t Pixel : Image) {
+            R.Checksum += Pixel;
+        }
+    }
+    R.Render_ms = Elapsed_ms(Start);
+    return R;
+}
+
+int main(int _NumArgs, char** _Args) {
+    int NumNeurons = (_NumArgs > 1) ? std::atoi(_Args[1]) : 20;
+    float VoxelScale_um = (_NumArgs > 2) ? std::atof(_Args[2]) : 0.1;
+    float Extent_um = (_NumArgs > 3) ? std::atof(_Args[3]) : 40.0;
+
+    std::mt19937 Generator(42);
+    std::vector<BakedCylinder> Segments = GrowArbors(NumNeurons, Extent_um, Generator);
+
+    BG::Common::Logger::LoggingSystem Logger;
+    BoundingBox BB;
+    for (int Axis = 0; Axis < 3; Axis++) {
+        BB.bb_point1[Axis] = 0.0;
+        BB.bb_point2[Axis] = Extent_um;
+    }
+
+    Result Dense, Sparse;
+    {
+        VoxelArray Array(&Logger, BB, VoxelScale_um);
+        Dense = Run(Array, Segments);
+    }
+    {
+        VoxelArray Array(&Logger, BB, VoxelScale_um, true);
+        Sparse = Run(Array, Segments);
+    }
+
+    std::cout << Segments.size() << " segments of " << NumNeurons << " neurons in a " << Extent_um << " um cube, " << VoxelScale_um << " um voxels\n";
+    std::cout << "Dense:  " << Dense.Memory_MiB << " MiB, clear " << Dense.Clear_ms << " ms, voxelize " << Dense.Voxelize_ms << " ms, render " << Dense.Render_ms << " ms\n";
+    std::cout << "Sparse: " << Sparse.Memory_MiB << " MiB, clear " << Sparse.Clear_ms << " ms, voxelize " << Sparse.Voxelize_ms << " ms, render " << Sparse.Render_ms << " ms\n";
+    if (Dense.Checksum != Sparse.Checksum) {
+        std::cout << "Rendered slices differ!\n";
+        return 1;
+    }
+    return 0;
+}
@@ -63,6 +63,14 @@ struct Config {
 
     int MaxVoxelArraySize_; /**Sets the maximum size of each voxel array even if enough memory exists*/
     float VoxelArrayPercentOfSystemMemory_; /**Set the amount of system memory we allow*/
+    bool SparseVoxelArray_ = CONFIG_DEFAULT_VSDA_EM_SPARSE_VOXEL_ARRAY; /**Store EM voxel arrays in bricks allocated on demand instead of one dense block*/
+
+    int ManagedTaskWorkers = CONFIG_DEFAULT_MANAGED_TASK_WORKERS;                   /**Number of threads that run managed tasks (loads, saves, connectomes, ...)*/
+    int ManagedTaskQueueLimit = CONFIG_DEFAULT_MANAGED_TASK_QUEUE_LIMIT;            /**Managed tasks that may wait for a worker before new ones are refused*/
+    int ManagedTaskMaxRunningRender = CONFIG_DEFAULT_MANAGED_TASK_MAX_RENDER;       /**Connectome and similar tasks that may run at once, <= 0 for no limit*/
+    int ManagedTaskMaxRunningSaveLoad = CONFIG_DEFAULT_MANAGED_TASK_MAX_SAVELOAD;   /**Save and load tasks that may run at once, <= 0 for no limit*/
+
+    bool ChunkedSaveTransfer = CONFIG_DEFAULT_CHUNKED_SAVE_TRANSFER; /**Register the routes for chunked, resumable save downloads and uploads*/
 
 };
 
@@ -23,4 +23,10 @@
 #define CONFIG_DEFAULT_CFG_FILE_PATH1 "NES.yaml"
 #define CONFIG_DEFAULT_CFG_FILE_PATH2 "/etc/BrainGenix/NES/NES.yaml"
 #define CONFIG_DEFAULT_PORT_NUMBER 8001
-#define CONFIG_DEFAULT_HOST "0.0.0.0"
\ No newline at end of file
+#define CONFIG_DEFAULT_HOST "0.0.0.0"
+#define CONFIG_DEFAULT_MANAGED_TASK_WORKERS 4
+#define CONFIG_DEFAULT_MANAGED_TASK_QUEUE_LIMIT 64
+#define CONFIG_DEFAULT_MANAGED_TASK_MAX_RENDER 2
+#define CONFIG_DEFAULT_MANAGED_TASK_MAX_SAVELOAD 1
+#define CONFIG_DEFAULT_VSDA_EM_SPARSE_VOXEL_ARRAY false
+#define CONFIG_DEFAULT_CHUNKED_SAVE_TRANSFER false
\ No newline at end of file
@@ -50,6 +50,26 @@ ConfigFileParser::ConfigFileParser(Config &_Config) {
     _Config.MaxVoxelArraySize_ = Config["VSDA_EM_MaxVoxelArraySize"].as<int>();
     _Config.VoxelArrayPercentOfSystemMemory_ = Config["VSDA_EM_PercentOfSysteMemoryLimit"].as<int>();
 
+    // Optional, older config files keep the defaults.
+    if (Config["ManagedTask_Workers"]) {
+        _Config.ManagedTaskWorkers = Config["ManagedTask_Workers"].as<int>();
+    }
+    if (Config["ManagedTask_QueueLimit"]) {
+        _Config.ManagedTaskQueueLimit = Config["ManagedTask_QueueLimit"].as<int>();
+    }
+    if (Config["ManagedTask_MaxRunningRender"]) {
+        _Config.ManagedTaskMaxRunningRender = Config["ManagedTask_MaxRunningRender"].as<int>();
+    }
+    if (Config["ManagedTask_MaxRunningSaveLoad"]) {
+        _Config.ManagedTaskMaxRunningSaveLoad = Config["ManagedTask_MaxRunningSaveLoad"].as<int>();
+    }
+    if (Config["VSDA_EM_SparseVoxelArray"]) {
+        _Config.SparseVoxelArray_ = Config["VSDA_EM_SparseVoxelArray"].as<bool>();
+    }
+    if (Config["Simulation_ChunkedSaveTransfer"]) {
+        _Config.ChunkedSaveTransfer = Config["Simulation_ChunkedSaveTransfer"].as<bool>();
+    }
+
 }
 
 
@@ -0,0 +1,74 @@
+// Standard Libraries (BG convention: use <> instead of "")
+
+// Third-Party Libraries (BG convention: use <> instead of "")
+
+// Internal Libraries (BG convention: use <> instead of "")
+#include <RPC/BulkRequest.h>
+
+
+namespace BG {
+namespace NES {
+namespace API {
+
+
+BulkRequest::BulkRequest(HandlerData& _Handle, BG::Common::Logger::LoggingSystem* _Logger) {
+    Logger_ = _Logger;
+
+    int Count = 0;
+    if (!_Handle.GetParInt("Count", Count)) {
+        return;
+    }
+    if (Count < 0) {
+        Logger_->Log("Error: Bulk request Count must not be negative", 7);
+        return;
+    }
+    Count_ = Count;
+
+    nlohmann::json::iterator ColumnsIt;
+    bool HasColumns = _Handle.FindPar("Columns", ColumnsIt, true);
+    if (HasColumns && (!ColumnsIt.value().is_object())) {
+        Logger_->Log("Error: Bulk request Columns must be an object", 7);
+        return;
+    }
+
+    // Shared parameters, as they would be passed to the single create route.
+    Item_ = nlohmann::json::object();
+    for (const auto& [Key, Value] : _Handle.ReqJSON().items()) {
+        if ((Key != "SimulationID") && (Key != "Count") && (Key != "Columns")) {
+            Item_[Key] = Value;
+        }
+    }
+
+    if (HasColumns) {
+        for (const auto& [Key, Column] : ColumnsIt.value().items()) {
+            if ((!Column.is_array()) || (Column.size() != Count_)) {
+                Logger_->Log("Error: Bulk request column '" + Key + "' must be an array of Count values", 7);
+                return;
+            }
+            // Objects are std::map based, so the slots keep their address.
+            Columns_.emplace_back(&Item_[Key], &Column);
+        }
+    }
+
+    Valid_ = true;
+}
+
+bool BulkRequest::IsValid() const {
+    return Valid_;
+}
+
+size_t BulkRequest::Size() const {
+    return Count_;
+}
+
+nlohmann::json& BulkRequest::Item(size_t _Index) {
+    for (auto& [Slot, Column] : Columns_) {
+        *Slot = (*Column)[_Index];
+    }
+    return Item_;
+}
+
+
+}; // Close Namespace API
+}; // Close Namespace NES
+}; // Close Namespace BG
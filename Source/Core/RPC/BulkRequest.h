@@ -0,0 +1,126 @@
+//=================================================================//
+// This file is part of the BrainGenix-NES Neuron Emulation System //
+//=================================================================//
+
+/*
+    Description: This file provides the columnar request format used by the bulk create routes.
+    Additional Notes: None
+    Date Created: 2026-10-17
+*/
+
+#pragma once
+
+// Standard Libraries (BG convention: use <> instead of "")
+#include <string>
+#include <utility>
+#include <vector>
+
+// Third-Party Libraries (BG convention: use <> instead of "")
+#include <nlohmann/json.hpp>
+
+// Internal Libraries (BG convention: use <> instead of "")
+#include <BG/Common/Logger/Logger.h>
+
+#include <RPC/RPCHandlerHelper.h>
+#include <RPC/APIStatusCode.h>
+
+
+namespace BG {
+namespace NES {
+namespace API {
+
+
+/**
+ * @brief Splits a bulk create request into the parameters of its items.
+ *
+ * A bulk request has the parameters of the matching single create route,
+ * plus the number of items and the columns that differ per item:
+ * {
+ *   "SimulationID": <SimID>,
+ *   "Count": <N>,
+ *   "Columns": {
+ *     "Radius_um": [ <N values> ],
+ *     "CenterPosX_um": [ <N values> ],
+ *     ...
+ *   },
+ *   "Name": <name> // Parameters outside of Columns are shared by all items.
+ * }
+ *
+ * Item() returns the parameters of one item in the form expected by the
+ * HandlerData::GetPar*() overloads that take the JSON to read from.
+ */
+class BulkRequest {
+
+private:
+    BG::Common::Logger::LoggingSystem* Logger_ = nullptr; /**Pointer to the instance of the logging system*/
+
+    size_t Count_ = 0;
+    bool Valid_ = false;
+
+    nlohmann::json Item_; /**Shared parameters, the columns are filled in by Item()*/
+    std::vector<std::pair<nlohmann::json*, const nlohmann::json*>> Columns_; /**Slot in Item_ and its column*/
+
+public:
+    BulkRequest(HandlerData& _Handle, BG::Common::Logger::LoggingSystem* _Logger);
+
+    bool IsValid() const;
+    size_t Size() const;
+
+    /**
+     * @brief Parameters of item _Index. The returned object is reused by the
+     * next call.
+     */
+    nlohmann::json& Item(size_t _Index);
+
+};
+
+
+/**
+ * @brief Handles a bulk create request all-or-nothing.
+ *
+ * Every item is read with _Get(Params, Item) and checked with _Check(Item)
+ * before the first one is added with _Add(Item), so that a rejected request
+ * leaves the simulation unchanged. _Check has to cover everything that would
+ * make _Add fail. Items are added in order, their IDs are consecutive and
+ * returned as FirstID and Count. As with every handler, the request is
+ * stored once, so a bulk call takes one record in the replay log.
+ */
+template <typename T, typename GetFn, typename CheckFn, typename AddFn>
+nlohmann::json BulkCreate(HandlerData& _Handle, BG::Common::Logger::LoggingSystem* _Logger, GetFn _Get, CheckFn _Check, AddFn _Add) {
+
+    BulkRequest Request(_Handle, _Logger);
+    if (!Request.IsValid()) {
+        return _Handle.ErrResponseJSON(BGStatusCode::BGStatusInvalidParametersPassed);
+    }
+
+    std::vector<T> Items(Request.Size());
+    for (size_t i = 0; i < Items.size(); i++) {
+        if ((!_Get(Request.Item(i), Items[i])) || (!_Check(Items[i]))) {
+            _Logger->Log("Error: Bulk create rejected at item " + std::to_string(i) + ", nothing was created", 7);
+            return _Handle.ErrResponseJSON(BGStatusCode::BGStatusInvalidParametersPassed);
+        }
+    }
+
+    int FirstID = -1;
+    for (size_t i = 0; i < Items.size(); i++) {
+        int ID = _Add(Items[i]);
+        if (ID < 0) {
+            _Logger->Log("Error: Bulk create failed at item " + std::to_string(i) + " after validation", 8);
+            return _Handle.ErrResponseJSON(BGStatusCode::BGStatusGeneralFailure);
+        }
+        if (i == 0) {
+            FirstID = ID;
+        }
+    }
+
+    nlohmann::json ResponseJSON;
+    ResponseJSON["StatusCode"] = 0;
+    ResponseJSON["FirstID"] = FirstID;
+    ResponseJSON["Count"] = Items.size();
+    return _Handle.ResponseAndStoreRequestJSON(ResponseJSON);
+}
+
+
+}; // Close Namespace API
+}; // Close Namespace NES
+}; // Close Namespace BG
@@ -0,0 +1,516 @@
+//=================================================================//
+// This file is part of the BrainGenix-NES Neuron Emulation System //
+//=================================================================//
+
+/*
+    Description: This file provides unit tests for the bulk create routes.
+    Additional Notes: The bulk routes check every item before adding the first one,
+                      with the *CanBeAdded() checks in ModelRPCInterface.cpp. These
+                      tests fail when those checks and the Simulation::Add*() functions
+                      drift apart, in either direction.
+    Date Created: 2026-10-17
+*/
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+
+#include <BG/Common/Logger/Logger.h>
+#include <Config/Config.h>
+#include <RPC/RPCManager.h>
+#include <RPC/BulkRequest.h>
+#include <Simulator/RPC/GeometryRPCInterface.h>
+#include <Simulator/RPC/ModelRPCInterface.h>
+#include <Simulator/Structs/Simulation.h>
+#include <Simulator/Structs/RecordingElectrode.h>
+#include <Util/SafeContainers.h>
+
+
+typedef std::function<nlohmann::json(nlohmann::json)> Route;
+
+/**
+ * @brief Test class for the bulk create routes. Registers the geometry and
+ * model routes with an RPCManager and calls them directly, the bulk routes
+ * on one simulation and the single create routes on another.
+ */
+
+struct BulkRequestTest : testing::Test {
+    BG::Common::Logger::LoggingSystem Logger;
+    BG::NES::Config::Config Config;
+    std::unique_ptr<BG::NES::API::RPCManager> Manager;
+    BG::NES::ConcurrentUniquePtrRegistry<BG::NES::Simulator::Simulation> Simulations;
+    std::unique_ptr<BG::NES::Simulator::GeometryRPCInterface> Geometry;
+    std::unique_ptr<BG::NES::Simulator::ModelRPCInterface> Model;
+
+    static constexpr int BulkSimID = 0;
+    static constexpr int SingleSimID = 1;
+
+    void SetUp() {
+        using namespace BG::NES::Simulator;
+
+        Config.PortNumber = 0; // Any free port, the routes are called directly.
+        Manager = std::make_unique<BG::NES::API::RPCManager>(&Config, &Logger);
+        Simulations.append(std::make_unique<Simulation>(&Logger));
+        Simulations.append(std::make_unique<Simulation>(&Logger));
+        Geometry = std::make_unique<GeometryRPCInterface>(&Logger, &Simulations, Manager.get());
+        Model = std::make_unique<ModelRPCInterface>(&Logger, &Simulations, Manager.get());
+    }
+
+    void TearDown() {
+        return;
+    }
+
+    BG::NES::Simulator::Simulation* Sim(int _SimulationID) {
+        return Simulations.read(_SimulationID);
+    }
+
+    // Parameters of the single create routes, without SimulationID.
+    static nlohmann::json SphereParams(int _i) {
+        return {
+            { "Radius_um", 2.0 + 0.25 * _i },
+            { "CenterPosX_um", 10.0 * _i }, { "CenterPosY_um", -3.5 }, { "CenterPosZ_um", 1.0 * _i },
+            { "Name", "Soma" },
+        };
+    }
+
+    static nlohmann::json LIFCCompartmentParams(int _ShapeID) {
+        return {
+            { "ShapeID", _ShapeID },
+            { "RestingPotential_mV", -60.0 }, { "ResetPotential_mV", -55.0 }, { "SpikeThreshold_mV", -50.0 - _ShapeID },
+            { "MembraneResistance_MOhm", 100.0 }, { "MembraneCapacitance_pF", 100.0 },
+            { "AfterHyperpolarizationAmplitude_mV", 0.0 },
+            { "Name", "LIFC" },
+        };
+    }
+
+    static nlohmann::json LIFCNeuronParams(std::vector<int> _SomaIDs) {
+        return {
+            { "SomaIDs", _SomaIDs }, { "DendriteIDs", std::vector<int>() }, { "AxonIDs", std::vector<int>() },
+            { "RestingPotential_mV", -60.0 }, { "ResetPotential_mV", -55.0 }, { "SpikeThreshold_mV", -50.0 },
+            { "MembraneResistance_MOhm", 100.0 }, { "MembraneCapacitance_pF", 100.0 },
+            { "RefractoryPeriod_ms", 2.0 }, { "SpikeDepolarization_mV", 30.0 },
+            { "UpdateMethod", "ExpEulerCm" }, { "ResetMethod", "ToVm" },
+            { "AfterHyperpolarizationReversalPotential_mV", -90.0 },
+            { "FastAfterHyperpolarizationRise_ms", 2.5 }, { "FastAfterHyperpolarizationDecay_ms", 30.0 },
+            { "FastAfterHyperpolarizationPeakConductance_nS", 3.0 }, { "FastAfterHyperpolarizationMaxPeakConductance_nS", 10.0 },
+            { "FastAfterHyperpolarizationHalfActConstant", 0.5 },
+            { "SlowAfterHyperpolarizationRise_ms", 30.0 }, { "SlowAfterHyperpolarizationDecay_ms", 300.0 },
+            { "SlowAfterHyperpolarizationPeakConductance_nS", 1.0 }, { "SlowAfterHyperpolarizationMaxPeakConductance_nS", 5.0 },
+            { "SlowAfterHyperpolarizationHalfActConstant", 0.5 },
+            { "AfterHyperpolarizationSaturationModel", "clip" },
+            { "FatigueThreshold", 300.0 }, { "FatigueRecoveryTime_ms", 1000.0 },
+            { "AfterDepolarizationReversalPotential_mV", -20.0 },
+            { "AfterDepolarizationRise_ms", 20.0 }, { "AfterDepolarizationDecay_ms", 200.0 },
+            { "AfterDepolarizationPeakConductance_nS", 0.3 }, { "AfterDepolarizationSaturationMultiplier", 2.0 },
+            { "AfterDepolarizationRecoveryTime_ms", 300.0 }, { "AfterDepolarizationDepletion", 0.3 },
+            { "AfterDepolarizationSaturationModel", "clip" },
+            { "AdaptiveThresholdDiffPerSpike", 0.2 }, { "AdaptiveTresholdRecoveryTime_ms", 50.0 },
+            { "AdaptiveThresholdDiffPotential_mV", 10.0 }, { "AdaptiveThresholdFloor_mV", -50.0 },
+            { "AdaptiveThresholdFloorDeltaPerSpike_mV", 1.0 }, { "AdaptiveThresholdFloorRecoveryTime_ms", 500.0 },
+            { "Name", "LIFCNeuron" },
+        };
+    }
+
+    static nlohmann::json LIFCReceptorParams(int _Source, int _Destination, int _i) {
+        return {
+            { "SourceCompartmentID", _Source }, { "DestinationCompartmentID", _Destination },
+            { "ReversalPotential_mV", (_i % 3 == 0) ? -70.0 : 0.0 },
+            { "PSPRise_ms", 0.5 }, { "PSPDecay_ms", 3.0 }, { "PeakConductance_nS", 10.0 + _i },
+            { "Weight", 1.0 }, { "OnsetDelay_ms", 1.0 + 0.25 * _i },
+            { "Neurotransmitter", (_i % 3 == 0) ? "GABA" : "AMPA" }, { "voltage_gated", false },
+            { "STDP_Method", (_i % 2 == 0) ? "Hebbian" : "None" },
+            { "STDP_A_pos", 0.1 }, { "STDP_A_neg", 0.1 }, { "STDP_Tau_pos", 20.0 }, { "STDP_Tau_neg", 20.0 }, { "STDP_Shift", 0.0 },
+            { "ReceptorMorphology", -1 },
+            { "Name", "Synapse" },
+        };
+    }
+
+    static nlohmann::json NetmorphLIFCReceptorParams(int _Source, int _Destination, int _i) {
+        return {
+            { "SourceCompartmentID", _Source }, { "DestinationCompartmentID", _Destination },
+            { "ReversalPotential_mV", 0.0 }, { "PSPRise_ms", 0.5 }, { "PSPDecay_ms", 3.0 },
+            { "ReceptorPeakConductance_nS", 0.5 }, { "ReceptorQuantity", 10 + _i },
+            { "HillocDistance_um", 50.0 * _i }, { "Velocity_mps", 1.0 }, { "SynapticDelay_ms", 0.5 },
+            { "Neurotransmitter", "AMPA" }, { "voltage_gated", false }, { "Weight", 1.0 },
+            { "STDP_Method", "None" },
+            { "STDP_A_pos", 0.1 }, { "STDP_A_neg", 0.1 }, { "STDP_Tau_pos", 20.0 }, { "STDP_Tau_neg", 20.0 }, { "STDP_Shift", 0.0 },
+            { "ReceptorMorphology", -1 },
+            { "Name", "NetmorphSynapse" },
+        };
+    }
+
+    // Used by the SC and the BS compartment routes.
+    static nlohmann::json BSCompartmentParams(int _ShapeID) {
+        return {
+            { "ShapeID", _ShapeID },
+            { "MembranePotential_mV", -60.0 }, { "SpikeThreshold_mV", -50.0 }, { "DecayTime_ms", 30.0 + _ShapeID },
+            { "RestingPotential_mV", -60.0 }, { "AfterHyperpolarizationAmplitude_mV", -10.0 },
+            { "Name", "Compartment" },
+        };
+    }
+
+    static nlohmann::json SCNeuronParams(std::vector<int> _SomaIDs) {
+        return {
+            { "SomaIDs", _SomaIDs }, { "DendriteIDs", std::vector<int>() }, { "AxonIDs", std::vector<int>() },
+            { "MembranePotential_mV", -60.0 }, { "RestingPotential_mV", -60.0 }, { "SpikeThreshold_mV", -50.0 },
+            { "DecayTime_ms", 30.0 }, { "AfterHyperpolarizationAmplitude_mV", -10.0 },
+            { "PostsynapticPotentialRiseTime_ms", 5.0 }, { "PostsynapticPotentialDecayTime_ms", 25.0 },
+            { "PostsynapticPotentialAmplitude_nA", 1.0 },
+            { "Name", "SCNeuron" },
+        };
+    }
+
+    static nlohmann::json BSNeuronParams(int _SomaID, int _AxonID) {
+        return {
+            { "SomaID", _SomaID }, { "AxonID", _AxonID },
+            { "MembranePotential_mV", -60.0 }, { "RestingPotential_mV", -60.0 }, { "SpikeThreshold_mV", -50.0 },
+            { "DecayTime_ms", 30.0 }, { "AfterHyperpolarizationAmplitude_mV", -10.0 },
+            { "PostsynapticPotentialRiseTime_ms", 5.0 }, { "PostsynapticPotentialDecayTime_ms", 25.0 },
+            { "PostsynapticPotentialAmplitude_nA", 1.0 },
+            { "Name", "BSNeuron" },
+        };
+    }
+
+    static nlohmann::json ReceptorParams(int _Source, int _Destination, int _i) {
+        return {
+            { "SourceCompartmentID", _Source }, { "DestinationCompartmentID", _Destination },
+            { "Conductance_nS", 1.0 + _i }, { "TimeConstantRise_ms", 0.5 }, { "TimeConstantDecay_ms", 3.0 },
+            { "Neurotransmitter", "AMPA" }, { "ReceptorMorphology", -1 },
+            { "Name", "Synapse" },
+        };
+    }
+
+    /**
+     * Columnar form of _Items, parameters that are the same for all items
+     * are shared, the others become columns.
+     */
+    static nlohmann::json BulkParams(int _SimulationID, const std::vector<nlohmann::json>& _Items) {
+        nlohmann::json Request;
+        Request["SimulationID"] = _SimulationID;
+        Request["Count"] = _Items.size();
+        Request["Columns"] = nlohmann::json::object();
+        for (const auto& [Key, Value] : _Items.front().items()) {
+            bool Shared = std::all_of(_Items.begin(), _Items.end(), [&](const nlohmann::json& _Item) { return _Item.at(Key) == Value; });
+            if (Shared) {
+                Request[Key] = Value;
+                continue;
+            }
+            for (const auto& Item : _Items) {
+                Request["Columns"][Key].push_back(Item.at(Key));
+            }
+        }
+        return Request;
+    }
+
+    /**
+     * Creates _Items with one bulk request on the bulk simulation and with
+     * one request each on the single simulation, and checks that the IDs
+     * agree. Returns the IDs.
+     */
+    std::vector<int> CreateBoth(Route _Bulk, Route _Single, const std::string& _IDName, const std::vector<nlohmann::json>& _Items) {
+        nlohmann::json BulkResponse = _Bulk(BulkParams(BulkSimID, _Items));
+        EXPECT_EQ(BulkResponse["StatusCode"], 0) << BulkResponse.dump();
+        EXPECT_EQ(BulkResponse["Count"], _Items.size());
+
+        std::vector<int> IDs;
+        for (const auto& Item : _Items) {
+            nlohmann::json Params = Item;
+            Params["SimulationID"] = SingleSimID;
+            nlohmann::json Response = _Single(Params);
+            EXPECT_EQ(Response["StatusCode"], 0) << Response.dump();
+            IDs.push_back(Response[_IDName]);
+        }
+        for (size_t i = 0; i < IDs.size(); i++) {
+            EXPECT_EQ(IDs[i], int(BulkResponse["FirstID"]) + int(i));
+        }
+        return IDs;
+    }
+
+    /**
+     * Sends _Items, which hold one bad row, as a bulk request and checks
+     * that the bulk simulation is unchanged. With _SingleToo, the single
+     * create route has to reject the bad row as well.
+     */
+    void ExpectRejected(Route _Bulk, Route _Single, const std::vector<nlohmann::json>& _Items, size_t _BadRow, bool _SingleToo = true) {
+        BG::NES::Simulator::Simulation* Bulk = Sim(BulkSimID);
+        std::vector<uint8_t> Before;
+        bool Saved = Bulk->SaveModel(Before);
+        size_t NumShapes = Bulk->Collection.Size();
+        size_t NumCompartments = Bulk->BSCompartments.size() + Bulk->LIFCCompartments.size();
+        size_t NumNeurons = Bulk->Neurons.size();
+        size_t NumReceptors = Bulk->Receptors.size() + Bulk->LIFCReceptors.size();
+        BG::NES::Simulator::SimulationNeuronClass Class = Bulk->SimNeuronClass;
+
+        nlohmann::json Response = _Bulk(BulkParams(BulkSimID, _Items));
+        EXPECT_NE(Response["StatusCode"], 0) << Response.dump();
+        EXPECT_FALSE(Response.contains("FirstID"));
+
+        EXPECT_EQ(Bulk->Collection.Size(), NumShapes);
+        EXPECT_EQ(Bulk->BSCompartments.size() + Bulk->LIFCCompartments.size(), NumCompartments);
+        EXPECT_EQ(Bulk->Neurons.size(), NumNeurons);
+        EXPECT_EQ(Bulk->Receptors.size() + Bulk->LIFCReceptors.size(), NumReceptors);
+        EXPECT_EQ(Bulk->SimNeuronClass, Class);
+        if (Saved) {
+            std::vector<uint8_t> After;
+            ASSERT_TRUE(Bulk->SaveModel(After));
+            EXPECT_TRUE(After == Before) << "the rejected batch changed the model";
+        }
+
+        if (_SingleToo) {
+            nlohmann::json Params = _Items[_BadRow];
+            Params["SimulationID"] = SingleSimID;
+            nlohmann::json SingleResponse = _Single(Params);
+            EXPECT_NE(SingleResponse["StatusCode"], 0) << "the single create route accepts row " << _BadRow << ": " << Params.dump();
+        }
+    }
+
+    // Routes of the interfaces.
+    Route R(nlohmann::json (BG::NES::Simulator::ModelRPCInterface::*_Handler)(nlohmann::json)) {
+        return std::bind(_Handler, Model.get(), std::placeholders::_1);
+    }
+    Route R(nlohmann::json (BG::NES::Simulator::GeometryRPCInterface::*_Handler)(nlohmann::json)) {
+        return std::bind(_Handler, Geometry.get(), std::placeholders::_1);
+    }
+
+    // Spheres 0.._Count-1 on both simulations.
+    void CreateSpheres(int _Count) {
+        using BG::NES::Simulator::GeometryRPCInterface;
+        std::vector<nlohmann::json> Items;
+        for (int i = 0; i < _Count; i++) {
+            Items.push_back(SphereParams(i));
+        }
+        CreateBoth(R(&GeometryRPCInterface::SphereBulkCreate), R(&GeometryRPCInterface::SphereCreate), "ShapeID", Items);
+    }
+
+    // A LIFC model on both simulations: _Count neurons with one compartment
+    // each, compartment IDs equal to neuron IDs.
+    void CreateLIFCNeurons(int _Count) {
+        using BG::NES::Simulator::ModelRPCInterface;
+        CreateSpheres(_Count);
+        std::vector<nlohmann::json> Compartments;
+        std::vector<nlohmann::json> Neurons;
+        for (int i = 0; i < _Count; i++) {
+            Compartments.push_back(LIFCCompartmentParams(i));
+            Neurons.push_back(LIFCNeuronParams({ i }));
+        }
+        CreateBoth(R(&ModelRPCInterface::LIFCBulkCreate), R(&ModelRPCInterface::LIFCCreate), "CompartmentID", Compartments);
+        CreateBoth(R(&ModelRPCInterface::LIFCNeuronBulkCreate), R(&ModelRPCInterface::LIFCNeuronCreate), "NeuronID", Neurons);
+    }
+
+    // The same with SC neurons.
+    void CreateSCNeurons(int _Count) {
+        using BG::NES::Simulator::ModelRPCInterface;
+        CreateSpheres(_Count);
+        std::vector<nlohmann::json> Compartments;
+        std::vector<nlohmann::json> Neurons;
+        for (int i = 0; i < _Count; i++) {
+            Compartments.push_back(BSCompartmentParams(i));
+            Neurons.push_back(SCNeuronParams({ i }));
+        }
+        CreateBoth(R(&ModelRPCInterface::SCBulkCreate), R(&ModelRPCInterface::SCCreate), "CompartmentID", Compartments);
+        CreateBoth(R(&ModelRPCInterface::SCNeuronBulkCreate), R(&ModelRPCInterface::SCNeuronCreate), "NeuronID", Neurons);
+    }
+
+    void ExpectSameModels() {
+        std::vector<uint8_t> BulkImage;
+        std::vector<uint8_t> SingleImage;
+        ASSERT_TRUE(Sim(BulkSimID)->SaveModel(BulkImage));
+        ASSERT_TRUE(Sim(SingleSimID)->SaveModel(SingleImage));
+        EXPECT_TRUE(BulkImage == SingleImage) << "the bulk and the single requests built different models";
+    }
+};
+
+TEST_F(BulkRequestTest, test_LIFC_bulk_matches_single_requests) {
+    using BG::NES::Simulator::ModelRPCInterface;
+
+    const int NumNeurons = 5;
+    CreateLIFCNeurons(NumNeurons);
+
+    std::vector<nlohmann::json> Receptors;
+    std::vector<nlohmann::json> NetmorphReceptors;
+    for (int i = 0; i < 12; i++) {
+        Receptors.push_back(LIFCReceptorParams(i % NumNeurons, (3 * i + 1) % NumNeurons, i));
+        NetmorphReceptors.push_back(NetmorphLIFCReceptorParams((i + 2) % NumNeurons, (5 * i + 3) % NumNeurons, i));
+    }
+    CreateBoth(R(&ModelRPCInterface::LIFCReceptorBulkCreate), R(&ModelRPCInterface::LIFCReceptorCreate), "ReceptorID", Receptors);
+    CreateBoth(R(&ModelRPCInterface::NetmorphLIFCReceptorBulkCreate), R(&ModelRPCInterface::NetmorphLIFCReceptorCreate), "ReceptorID", NetmorphReceptors);
+
+    ASSERT_EQ(Sim(BulkSimID)->Neurons.size(), size_t(NumNeurons));
+    ASSERT_EQ(Sim(BulkSimID)->LIFCReceptors.size(), Receptors.size() + NetmorphReceptors.size());
+    ASSERT_EQ(Sim(BulkSimID)->LIFCReceptorDataVec.size(), Sim(SingleSimID)->LIFCReceptorDataVec.size());
+    ExpectSameModels();
+}
+
+TEST_F(BulkRequestTest, test_SC_bulk_matches_single_requests) {
+    using BG::NES::Simulator::ModelRPCInterface;
+
+    const int NumNeurons = 4;
+    CreateSCNeurons(NumNeurons);
+
+    std::vector<nlohmann::json> Receptors;
+    for (int i = 0; i < 9; i++) {
+        Receptors.push_back(ReceptorParams(i % NumNeurons, (i + 1) % NumNeurons, i));
+    }
+    CreateBoth(R(&ModelRPCInterface::ReceptorBulkCreate), R(&ModelRPCInterface::ReceptorCreate), "ReceptorID", Receptors);
+
+    ASSERT_EQ(Sim(BulkSimID)->Neurons.size(), size_t(NumNeurons));
+    ASSERT_EQ(Sim(BulkSimID)->Receptors.size(), Receptors.size());
+    ExpectSameModels();
+}
+
+TEST_F(BulkRequestTest, test_BS_bulk_matches_single_requests) {
+    using BG::NES::Simulator::ModelRPCInterface;
+
+    // Soma and axon compartment per neuron.
+    const int NumNeurons = 3;
+    CreateSpheres(2 * NumNeurons);
+    std::vector<nlohmann::json> Compartments;
+    std::vector<nlohmann::json> Neurons;
+    for (int i = 0; i < NumNeurons; i++) {
+        Compartments.push_back(BSCompartmentParams(2 * i));
+        Compartments.push_back(BSCompartmentParams(2 * i + 1));
+        Neurons.push_back(BSNeuronParams(2 * i, 2 * i + 1));
+    }
+    CreateBoth(R(&ModelRPCInterface::BSBulkCreate), R(&ModelRPCInterface::BSCreate), "CompartmentID", Compartments);
+    CreateBoth(R(&ModelRPCInterface::BSNeuronBulkCreate), R(&ModelRPCInterface::BSNeuronCreate), "NeuronID", Neurons);
+
+    BG::NES::Simulator::Simulation* Bulk = Sim(BulkSimID);
+    BG::NES::Simulator::Simulation* Single = Sim(SingleSimID);
+    ASSERT_EQ(Bulk->BSCompartments.size(), Single->BSCompartments.size());
+    for (size_t i = 0; i < Bulk->BSCompartments.size(); i++) {
+        EXPECT_EQ(Bulk->BSCompartments[i].ShapeID, Single->BSCompartments[i].ShapeID);
+        EXPECT_EQ(Bulk->BSCompartments[i].DecayTime_ms, Single->BSCompartments[i].DecayTime_ms);
+    }
+    ASSERT_EQ(Bulk->Neurons.size(), size_t(NumNeurons));
+    EXPECT_EQ(Bulk->NeuronByCompartment, Single->NeuronByCompartment);
+    EXPECT_EQ(Bulk->SimNeuronClass, BG::NES::Simulator::BSNEURONS);
+}
+
+TEST_F(BulkRequestTest, test_Bad_row_rejects_the_whole_LIFC_batch) {
+    using BG::NES::Simulator::GeometryRPCInterface;
+    using BG::NES::Simulator::ModelRPCInterface;
+
+    const int NumNeurons = 4;
+    CreateLIFCNeurons(NumNeurons);
+
+    // Each batch has good rows before and after the bad one.
+    std::vector<nlohmann::json> Spheres = { SphereParams(10), SphereParams(11), SphereParams(12) };
+    Spheres[1]["Radius_um"] = "large";
+    ExpectRejected(R(&GeometryRPCInterface::SphereBulkCreate), R(&GeometryRPCInterface::SphereCreate), Spheres, 1);
+
+    std::vector<nlohmann::json> Compartments = { LIFCCompartmentParams(0), LIFCCompartmentParams(99), LIFCCompartmentParams(1) };
+    ExpectRejected(R(&ModelRPCInterface::LIFCBulkCreate), R(&ModelRPCInterface::LIFCCreate), Compartments, 1);
+
+    std::vector<nlohmann::json> Neurons = { LIFCNeuronParams({ 0 }), LIFCNeuronParams({}), LIFCNeuronParams({ 1 }) };
+    ExpectRejected(R(&ModelRPCInterface::LIFCNeuronBulkCreate), R(&ModelRPCInterface::LIFCNeuronCreate), Neurons, 1);
+    Neurons = { LIFCNeuronParams({ 0 }), LIFCNeuronParams({ 1 }), LIFCNeuronParams({ 2 }) };
+    Neurons[2]["UpdateMethod"] = "Implicit";
+    ExpectRejected(R(&ModelRPCInterface::LIFCNeuronBulkCreate), R(&ModelRPCInterface::LIFCNeuronCreate), Neurons, 2);
+
+    std::vector<nlohmann::json> Receptors = { LIFCReceptorParams(0, 1, 0), LIFCReceptorParams(1, 99, 1), LIFCReceptorParams(2, 3, 2) };
+    ExpectRejected(R(&ModelRPCInterface::LIFCReceptorBulkCreate), R(&ModelRPCInterface::LIFCReceptorCreate), Receptors, 1);
+    Receptors = { LIFCReceptorParams(99, 1, 0), LIFCReceptorParams(1, 2, 1), LIFCReceptorParams(2, 3, 2) };
+    ExpectRejected(R(&ModelRPCInterface::LIFCReceptorBulkCreate), R(&ModelRPCInterface::LIFCReceptorCreate), Receptors, 0);
+
+    std::vector<nlohmann::json> NetmorphReceptors = { NetmorphLIFCReceptorParams(0, 1, 0), NetmorphLIFCReceptorParams(1, 2, 1), NetmorphLIFCReceptorParams(2, 3, 2) };
+    NetmorphReceptors[1]["STDP_Method"] = "Symmetric";
+    ExpectRejected(R(&ModelRPCInterface::NetmorphLIFCReceptorBulkCreate), R(&ModelRPCInterface::NetmorphLIFCReceptorCreate), NetmorphReceptors, 1);
+    NetmorphReceptors = { NetmorphLIFCReceptorParams(0, 1, 0), NetmorphLIFCReceptorParams(1, 2, 1), NetmorphLIFCReceptorParams(2, 99, 2) };
+    ExpectRejected(R(&ModelRPCInterface::NetmorphLIFCReceptorBulkCreate), R(&ModelRPCInterface::NetmorphLIFCReceptorCreate), NetmorphReceptors, 2);
+
+    // Compartments and neurons of other classes do not mix with LIFC ones.
+    std::vector<nlohmann::json> SCCompartments = { BSCompartmentParams(0), BSCompartmentParams(1) };
+    ExpectRejected(R(&ModelRPCInterface::SCBulkCreate), R(&ModelRPCInterface::SCCreate), SCCompartments, 0);
+    ExpectRejected(R(&ModelRPCInterface::BSBulkCreate), R(&ModelRPCInterface::BSCreate), SCCompartments, 0);
+    std::vector<nlohmann::json> SCNeurons = { SCNeuronParams({ 0 }), SCNeuronParams({ 1 }) };
+    ExpectRejected(R(&ModelRPCInterface::SCNeuronBulkCreate), R(&ModelRPCInterface::SCNeuronCreate), SCNeurons, 0);
+
+    // Nothing above got through, the simulations still agree.
+    ExpectSameModels();
+}
+
+TEST_F(BulkRequestTest, test_Bad_row_rejects_the_whole_SC_batch) {
+    using BG::NES::Simulator::ModelRPCInterface;
+
+    const int NumNeurons = 3;
+    CreateSCNeurons(NumNeurons);
+
+    std::vector<nlohmann::json> Compartments = { BSCompartmentParams(0), BSCompartmentParams(1), BSCompartmentParams(-1) };
+    ExpectRejected(R(&ModelRPCInterface::SCBulkCreate), R(&ModelRPCInterface::SCCreate), Compartments, 2);
+
+    std::vector<nlohmann::json> Neurons = { SCNeuronParams({}), SCNeuronParams({ 1 }) };
+    ExpectRejected(R(&ModelRPCInterface::SCNeuronBulkCreate), R(&ModelRPCInterface::SCNeuronCreate), Neurons, 0);
+
+    std::vector<nlohmann::json> Receptors = { ReceptorParams(0, 1, 0), ReceptorParams(1, 2, 1), ReceptorParams(2, 99, 2), ReceptorParams(2, 0, 3) };
+    ExpectRejected(R(&ModelRPCInterface::ReceptorBulkCreate), R(&ModelRPCInterface::ReceptorCreate), Receptors, 2);
+    Receptors[2] = ReceptorParams(2, 0, 2);
+    Receptors[3]["Conductance_nS"] = nullptr;
+    ExpectRejected(R(&ModelRPCInterface::ReceptorBulkCreate), R(&ModelRPCInterface::ReceptorCreate), Receptors, 3);
+
+    std::vector<nlohmann::json> LIFCCompartments = { LIFCCompartmentParams(0) };
+    ExpectRejected(R(&ModelRPCInterface::LIFCBulkCreate), R(&ModelRPCInterface::LIFCCreate), LIFCCompartments, 0);
+
+    // LIFC receptors need LIFC neurons. The single route does not check
+    // this, so only the bulk route is tried.
+    std::vector<nlohmann::json> LIFCReceptors = { LIFCReceptorParams(0, 1, 0), LIFCReceptorParams(1, 2, 1) };
+    ExpectRejected(R(&ModelRPCInterface::LIFCReceptorBulkCreate), R(&ModelRPCInterface::LIFCReceptorCreate), LIFCReceptors, 0, false);
+
+    ExpectSameModels();
+}
+
+TEST_F(BulkRequestTest, test_Bad_row_rejects_the_whole_BS_batch) {
+    using BG::NES::Simulator::ModelRPCInterface;
+
+    CreateSpheres(4);
+    std::vector<nlohmann::json> Compartments = { BSCompartmentParams(0), BSCompartmentParams(1) };
+    CreateBoth(R(&ModelRPCInterface::BSBulkCreate), R(&ModelRPCInterface::BSCreate), "CompartmentID", Compartments);
+
+    Compartments = { BSCompartmentParams(2), BSCompartmentParams(7), BSCompartmentParams(3) };
+    ExpectRejected(R(&ModelRPCInterface::BSBulkCreate), R(&ModelRPCInterface::BSCreate), Compartments, 1);
+
+    std::vector<nlohmann::json> Neurons = { BSNeuronParams(0, 1), BSNeuronParams(0, 5) };
+    ExpectRejected(R(&ModelRPCInterface::BSNeuronBulkCreate), R(&ModelRPCInterface::BSNeuronCreate), Neurons, 1);
+    Neurons = { BSNeuronParams(5, 1), BSNeuronParams(0, 1) };
+    ExpectRejected(R(&ModelRPCInterface::BSNeuronBulkCreate), R(&ModelRPCInterface::BSNeuronCreate), Neurons, 0);
+
+    EXPECT_EQ(Sim(BulkSimID)->Neurons.size(), 0);
+}
+
+TEST_F(BulkRequestTest, test_Malformed_requests_are_rejected) {
+    using BG::NES::Simulator::GeometryRPCInterface;
+
+    CreateSpheres(2);
+    Route Bulk = R(&GeometryRPCInterface::SphereBulkCreate);
+    std::vector<nlohmann::json> Spheres = { SphereParams(5), SphereParams(6), SphereParams(7) };
+
+    nlohmann::json ShortColumn = BulkParams(BulkSimID, Spheres);
+    ShortColumn["Columns"]["Radius_um"].erase(0);
+    nlohmann::json NegativeCount = BulkParams(BulkSimID, Spheres);
+    NegativeCount["Count"] = -3;
+    nlohmann::json NoCount = BulkParams(BulkSimID, Spheres);
+    NoCount.erase("Count");
+    nlohmann::json ColumnsNotAnObject = BulkParams(BulkSimID, Spheres);
+    ColumnsNotAnObject["Columns"] = nlohmann::json::array();
+    nlohmann::json MissingParameter = BulkParams(BulkSimID, Spheres);
+    MissingParameter.erase("Name");
+
+    for (const nlohmann::json& Request : { ShortColumn, NegativeCount, NoCount, ColumnsNotAnObject, MissingParameter }) {
+        nlohmann::json Response = Bulk(Request);
+        EXPECT_NE(Response["StatusCode"], 0) << Request.dump();
+        EXPECT_EQ(Sim(BulkSimID)->Collection.Size(), 2);
+    }
+
+    // An empty batch creates nothing and succeeds.
+    nlohmann::json Empty = BulkParams(BulkSimID, Spheres);
+    Empty["Count"] = 0;
+    Empty["Columns"] = nlohmann::json::object();
+    nlohmann::json Response = Bulk(Empty);
+    EXPECT_EQ(Response["StatusCode"], 0);
+    EXPECT_EQ(Response["Count"], 0);
+    EXPECT_EQ(Sim(BulkSimID)->Collection.Size(), 2);
+}
@@ -0,0 +1,197 @@
+// Standard Libraries (BG convention: use <> instead of "")
+#include <algorithm>
+
+// Third-Party Libraries (BG convention: use <> instead of "")
+
+// Internal Libraries (BG convention: use <> instead of "")
+#include <RPC/ManagedTaskExecutor.h>
+
+
+namespace BG {
+namespace NES {
+namespace API {
+
+
+ManagedTaskPriority PriorityOfTask(ManagedTasks _Task) {
+    switch (_Task) {
+        case SimLoadingTask:
+        case SimulationSaveModelTask:
+        case SimulationLoadModelTask:
+        case SimulationSaveCheckpointTask:
+        case SimulationLoadCheckpointTask:
+        case SimulationCloneTask:
+            return TaskPrioritySaveLoad;
+        case GetConnectomeTask:
+        case GetAbstractConnectomeTask:
+        case SimulationSweepTask:
+            return TaskPriorityRender;
+        default:
+            return TaskPriorityInteractive;
+    }
+}
+
+
+ManagedTaskExecutor::ManagedTaskExecutor(BG::Common::Logger::LoggingSystem* _Logger, int _NumWorkers, int _MaxQueued, const std::array<int, NUMManagedTaskPriority>& _MaxRunning) {
+    Logger_ = _Logger;
+    MaxQueued_ = std::max(_MaxQueued, 0);
+    MaxRunning_ = _MaxRunning;
+
+    int NumWorkers = std::max(_NumWorkers, 1);
+    Logger_->Log("Starting Managed Task Executor With '" + std::to_string(NumWorkers) + "' Workers", 5);
+    for (int i = 0; i < NumWorkers; i++) {
+        Workers_.emplace_back(&ManagedTaskExecutor::WorkerThread, this);
+    }
+}
+
+ManagedTaskExecutor::~ManagedTaskExecutor() {
+    std::deque<QueuedTask> Cancelled;
+    {
+        std::lock_guard<std::mutex> Lock(Mutex_);
+        Stopping_ = true;
+        for (ManagerTaskData* Data : Running_) {
+            Data->RequestCancel();
+        }
+        for (auto& Queue : Queues_) {
+            for (auto& Task : Queue) {
+                Cancelled.emplace_back(std::move(Task));
+            }
+            Queue.clear();
+        }
+    }
+    WorkAvailable_.notify_all();
+
+    for (auto& Task : Cancelled) {
+        Task.Data->RequestCancel();
+        Task.Job();
+    }
+
+    Logger_->Log("Joining Managed Task Workers", 2);
+    for (auto& Worker : Workers_) {
+        Worker.join();
+    }
+}
+
+size_t ManagedTaskExecutor::NumQueued() const {
+    size_t Num = 0;
+    for (const auto& Queue : Queues_) {
+        Num += Queue.size();
+    }
+    return Num;
+}
+
+// Must be called with Mutex_ held.
+bool ManagedTaskExecutor::NextRunnable(ManagedTaskPriority& _Priority) const {
+    for (int p = 0; p < NUMManagedTaskPriority; p++) {
+        if (Queues_[p].empty()) continue;
+        if ((MaxRunning_[p] > 0) && (NumRunning_[p] >= MaxRunning_[p])) continue;
+        _Priority = ManagedTaskPriority(p);
+        return true;
+    }
+    return false;
+}
+
+void ManagedTaskExecutor::WorkerThread() {
+    std::unique_lock<std::mutex> Lock(Mutex_);
+    while (true) {
+        ManagedTaskPriority Priority;
+        WorkAvailable_.wait(Lock, [this, &Priority]() { return Stopping_ || NextRunnable(Priority); });
+        if (Stopping_) {
+            return;
+        }
+
+        QueuedTask Task = std::move(Queues_[Priority].front());
+        Queues_[Priority].pop_front();
+        NumRunning_[Priority]++;
+        Running_.insert(Task.Data);
+
+        Lock.unlock();
+        Task.Job();
+        Lock.lock();
+
+        Running_.erase(Task.Data);
+        NumRunning_[Priority]--;
+        // A class limit was freed, another worker may be able to start one.
+        WorkAvailable_.notify_all();
+    }
+}
+
+bool ManagedTaskExecutor::Submit(ManagerTaskData* _Data, ManagedTaskPriority _Priority, std::function<void()> _Job) {
+    {
+        std::lock_guard<std::mutex> Lock(Mutex_);
+        if (Stopping_) {
+            return false;
+        }
+        if (NumQueued() >= MaxQueued_) {
+            Logger_->Log("Managed task queue is full (" + std::to_string(MaxQueued_) + " tasks), task refused", 8);
+            return false;
+        }
+        Queues_[_Priority].push_back({ _Data, std::move(_Job) });
+    }
+    WorkAvailable_.notify_one();
+    return true;
+}
+
+bool ManagedTaskExecutor::SubmitManagerTask(ManagerTaskData* _Data, std::function<void(ManagerTaskData*)> _Task, std::function<void()> _NotStarted) {
+    // Set before the job is queued, a worker may start it right away.
+    ManagerTaskStatus Previous = _Data->Status;
+    _Data->SetStatus(ManagerTaskStatus::Queued);
+
+    auto Job = [_Data, _Task = std::move(_Task), _NotStarted = std::move(_NotStarted)]() {
+        if (_Data->IsCancelled()) {
+            _Data->SetStatus(ManagerTaskStatus::Cancelled);
+            if (_NotStarted) _NotStarted();
+            return;
+        }
+        _Data->SetStatus(ManagerTaskStatus::Active);
+        _Task(_Data);
+    };
+    if (!Submit(_Data, PriorityOfTask(_Data->TaskType), std::move(Job))) {
+        _Data->SetStatus(Previous);
+        return false;
+    }
+    return true;
+}
+
+bool ManagedTaskExecutor::Cancel(ManagerTaskData* _Data) {
+    _Data->RequestCancel();
+
+    QueuedTask Task;
+    {
+        std::lock_guard<std::mutex> Lock(Mutex_);
+        bool Found = false;
+        for (auto& Queue : Queues_) {
+            auto it = std::find_if(Queue.begin(), Queue.end(), [_Data](const QueuedTask& _Task) { return _Task.Data == _Data; });
+            if (it != Queue.end()) {
+                Task = std::move(*it);
+                Queue.erase(it);
+                Found = true;
+                break;
+            }
+        }
+        if (!Found) {
+            return false;
+        }
+    }
+
+    Task.Job();
+    return true;
+}
+
+nlohmann::json ManagedTaskExecutor::GetStatusJSON() {
+    std::lock_guard<std::mutex> Lock(Mutex_);
+    nlohmann::json StatusJSON;
+    StatusJSON["NumWorkers"] = Workers_.size();
+    StatusJSON["MaxQueued"] = MaxQueued_;
+    StatusJSON["Queued"] = nlohmann::json::array();
+    StatusJSON["Running"] = nlohmann::json::array();
+    for (int p = 0; p < NUMManagedTaskPriority; p++) {
+        StatusJSON["Queued"].push_back(Queues_[p].size());
+        StatusJSON["Running"].push_back(NumRunning_[p]);
+    }
+    return StatusJSON;
+}
+
+
+}; // Close Namespace API
+}; // Close Namespace NES
+}; // Close Namespace BG
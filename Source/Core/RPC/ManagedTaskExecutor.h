@@ -0,0 +1,138 @@
+//=================================================================//
+// This file is part of the BrainGenix-NES Neuron Emulation System //
+//=================================================================//
+
+/*
+    Description: This file provides the bounded worker pool that runs managed tasks.
+    Additional Notes: None
+    Date Created: 2026-10-17
+*/
+
+#pragma once
+
+// Standard Libraries (BG convention: use <> instead of "")
+#include <array>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+// Third-Party Libraries (BG convention: use <> instead of "")
+#include <nlohmann/json.hpp>
+
+// Internal Libraries (BG convention: use <> instead of "")
+#include <BG/Common/Logger/Logger.h>
+
+#include <RPC/ManagerTaskData.h>
+
+
+namespace BG {
+namespace NES {
+namespace API {
+
+
+/**
+ * Priority classes of managed tasks. Queued tasks of a lower class are
+ * started first, tasks of the same class in the order they were added.
+ */
+enum ManagedTaskPriority {
+    TaskPriorityInteractive = 0, // Quick queries and bookkeeping, e.g. resource status.
+    TaskPriorityRender = 1,      // Long computations that produce output, e.g. connectomes.
+    TaskPrioritySaveLoad = 2,    // Saving and loading of models and simulations.
+    NUMManagedTaskPriority
+};
+
+ManagedTaskPriority PriorityOfTask(ManagedTasks _Task);
+
+/**
+ * @brief Runs managed tasks on a fixed number of worker threads.
+ *
+ * At most MaxQueued tasks wait for a worker, further tasks are refused so
+ * that a burst of requests cannot pile up unbounded work and memory. Each
+ * priority class can additionally be limited in how many of its tasks run
+ * at once, which keeps workers free for interactive tasks while long saves
+ * or loads are running.
+ *
+ * Submit() only schedules, SubmitManagerTask() adds the status changes and
+ * cancellation handling of managed tasks (see
+ * SimulationRPCInterface::AddManagerTask()).
+ */
+class ManagedTaskExecutor {
+
+private:
+    struct QueuedTask {
+        ManagerTaskData* Data = nullptr;
+        std::function<void()> Job;
+    };
+
+    BG::Common::Logger::LoggingSystem* Logger_ = nullptr; /**Pointer to the instance of the logging system*/
+
+    size_t MaxQueued_ = 0;
+    std::array<int, NUMManagedTaskPriority> MaxRunning_; /**Per priority class, <= 0 means no limit besides the number of workers*/
+
+    std::mutex Mutex_;
+    std::condition_variable WorkAvailable_;
+    bool Stopping_ = false;
+    std::array<std::deque<QueuedTask>, NUMManagedTaskPriority> Queues_;
+    std::array<int, NUMManagedTaskPriority> NumRunning_ = {};
+    std::set<ManagerTaskData*> Running_;
+
+    std::vector<std::thread> Workers_;
+
+    size_t NumQueued() const;
+    bool NextRunnable(ManagedTaskPriority& _Priority) const;
+    void WorkerThread();
+
+public:
+    /**
+     * @brief Starts _NumWorkers worker threads (at least 1).
+     *
+     * @param _MaxQueued Tasks that may wait for a worker before Submit() refuses more.
+     * @param _MaxRunning Tasks of each priority class that may run at once, <= 0 for no limit.
+     */
+    ManagedTaskExecutor(BG::Common::Logger::LoggingSystem* _Logger, int _NumWorkers, int _MaxQueued, const std::array<int, NUMManagedTaskPriority>& _MaxRunning);
+
+    /**
+     * @brief Requests cancellation of running tasks, cancels queued tasks
+     * (their jobs run with the cancellation requested) and joins the workers.
+     */
+    ~ManagedTaskExecutor();
+
+    /**
+     * @brief Queues _Job to run for the task _Data. Returns false if the
+     * queue is full or the executor is stopping, _Job is not run then.
+     */
+    bool Submit(ManagerTaskData* _Data, ManagedTaskPriority _Priority, std::function<void()> _Job);
+
+    /**
+     * @brief Queues the managed task _Data with the priority of its type.
+     * Its status is Queued until a worker starts it, then Active while
+     * _Task runs and sets the final status. A task cancelled before it
+     * started is not run: its status becomes Cancelled and _NotStarted is
+     * called instead. Returns false like Submit(), nothing is called then.
+     */
+    bool SubmitManagerTask(ManagerTaskData* _Data, std::function<void(ManagerTaskData*)> _Task, std::function<void()> _NotStarted = nullptr);
+
+    /**
+     * @brief Requests cancellation of the task _Data. If the task is still
+     * queued, it is removed from the queue and its job runs right away on
+     * the calling thread, so that it can finish as cancelled. Returns true
+     * in that case. Running tasks stop where they check
+     * ManagerTaskData::IsCancelled().
+     */
+    bool Cancel(ManagerTaskData* _Data);
+
+    /**
+     * @brief Numbers of queued and running tasks per priority class.
+     */
+    nlohmann::json GetStatusJSON();
+
+};
+
+
+}; // Close Namespace API
+}; // Close Namespace NES
+}; // Close Namespace BG
@@ -0,0 +1,316 @@
+//=================================================================//
+// This file is part of the BrainGenix-NES Neuron Emulation System //
+//=================================================================//
+
+/*
+    Description: This file provides unit tests for the managed task executor.
+    Additional Notes: The cancel tests go through SubmitManagerTask() and Cancel(), the
+                      same calls as AddManagerTask() and the ManTaskCancel route.
+    Date Created: 2026-10-17
+*/
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+
+#include <BG/Common/Logger/Logger.h>
+#include <RPC/ManagedTaskExecutor.h>
+#include <RPC/ManagerTaskData.h>
+
+
+using namespace BG::NES::API;
+
+/**
+ * @brief Blocks jobs until it is opened, and lets the test wait until a
+ * number of jobs have arrived at it.
+ */
+class Gate {
+private:
+    std::mutex Mutex_;
+    std::condition_variable Changed_;
+    bool Open_ = false;
+    int NumWaiting_ = 0;
+
+public:
+    void Wait() {
+        std::unique_lock<std::mutex> Lock(Mutex_);
+        NumWaiting_++;
+        Changed_.notify_all();
+        Changed_.wait(Lock, [this]() { return Open_; });
+    }
+
+    void Open() {
+        std::lock_guard<std::mutex> Lock(Mutex_);
+        Open_ = true;
+        Changed_.notify_all();
+    }
+
+    bool WaitForWaiting(int _Num) {
+        std::unique_lock<std::mutex> Lock(Mutex_);
+        return Changed_.wait_for(Lock, std::chrono::seconds(10), [this, _Num]() { return NumWaiting_ >= _Num; });
+    }
+};
+
+/**
+ * @brief Test class for the managed task executor.
+ */
+struct ManagedTaskExecutorTest : testing::Test {
+    BG::Common::Logger::LoggingSystem Logger;
+
+    std::array<int, NUMManagedTaskPriority> NoLimits = { 0, 0, 0 };
+
+    void TearDown() {
+        return;
+    }
+
+    // Polls until _Done() holds, false after a generous time-out.
+    template <typename F>
+    bool Eventually(F _Done) {
+        auto Deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (!_Done()) {
+            if (std::chrono::steady_clock::now() > Deadline) return false;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return true;
+    }
+};
+
+TEST_F(ManagedTaskExecutorTest, test_LowerClassesStartFirstInOrder) {
+    ManagedTaskExecutor Executor(&Logger, 1, 16, NoLimits);
+    Gate Blocker;
+    ManagerTaskData BlockerData(GetResourceStatusTask);
+    ASSERT_TRUE(Executor.Submit(&BlockerData, TaskPriorityInteractive, [&Blocker]() { Blocker.Wait(); }));
+    ASSERT_TRUE(Blocker.WaitForWaiting(1));
+
+    std::mutex OrderMutex;
+    std::vector<std::string> Order;
+    auto Record = [&OrderMutex, &Order](const std::string& _Name) {
+        return [&OrderMutex, &Order, _Name]() {
+            std::lock_guard<std::mutex> Lock(OrderMutex);
+            Order.push_back(_Name);
+        };
+    };
+    ManagerTaskData Save(SimulationSaveModelTask), Render(GetConnectomeTask), First(GetResourceStatusTask), Second(DeleteResidentByIDTask);
+    ASSERT_TRUE(Executor.Submit(&Save, TaskPrioritySaveLoad, Record("Save")));
+    ASSERT_TRUE(Executor.Submit(&Render, TaskPriorityRender, Record("Render")));
+    ASSERT_TRUE(Executor.Submit(&First, TaskPriorityInteractive, Record("First")));
+    ASSERT_TRUE(Executor.Submit(&Second, TaskPriorityInteractive, Record("Second")));
+
+    Blocker.Open();
+    ASSERT_TRUE(Eventually([&]() { std::lock_guard<std::mutex> Lock(OrderMutex); return Order.size() == 4; }));
+    std::vector<std::string> Expected = { "First", "Second", "Render", "Save" };
+    EXPECT_EQ(Order, Expected);
+}
+
+TEST_F(ManagedTaskExecutorTest, test_PriorityOfTask) {
+    EXPECT_EQ(PriorityOfTask(GetResourceStatusTask), TaskPriorityInteractive);
+    EXPECT_EQ(PriorityOfTask(DeleteResidentByIDTask), TaskPriorityInteractive);
+    EXPECT_EQ(PriorityOfTask(GetConnectomeTask), TaskPriorityRender);
+    EXPECT_EQ(PriorityOfTask(SimulationSweepTask), TaskPriorityRender);
+    EXPECT_EQ(PriorityOfTask(SimulationSaveModelTask), TaskPrioritySaveLoad);
+    EXPECT_EQ(PriorityOfTask(SimulationLoadCheckpointTask), TaskPrioritySaveLoad);
+    EXPECT_EQ(PriorityOfTask(SimulationCloneTask), TaskPrioritySaveLoad);
+}
+
+TEST_F(ManagedTaskExecutorTest, test_ClassCapKeepsWorkersFree) {
+    ManagedTaskExecutor Executor(&Logger, 3, 16, { 0, 0, 1 });
+    Gate Saves;
+    std::atomic<int> NumSaving{0};
+    std::atomic<int> MaxSaving{0};
+    auto SaveJob = [&]() {
+        int Now = ++NumSaving;
+        int Max = MaxSaving;
+        while ((Now > Max) && !MaxSaving.compare_exchange_weak(Max, Now)) {}
+        Saves.Wait();
+        NumSaving--;
+    };
+
+    std::vector<std::unique_ptr<ManagerTaskData>> SaveData;
+    for (int i = 0; i < 3; i++) {
+        SaveData.emplace_back(std::make_unique<ManagerTaskData>(SimulationSaveModelTask));
+        ASSERT_TRUE(Executor.Submit(SaveData.back().get(), TaskPrioritySaveLoad, SaveJob));
+    }
+    ASSERT_TRUE(Saves.WaitForWaiting(1));
+
+    // The other workers stay available for interactive tasks.
+    std::atomic<bool> InteractiveDone{false};
+    ManagerTaskData Interactive(GetResourceStatusTask);
+    ASSERT_TRUE(Executor.Submit(&Interactive, TaskPriorityInteractive, [&InteractiveDone]() { InteractiveDone = true; }));
+    ASSERT_TRUE(Eventually([&]() { return InteractiveDone.load(); }));
+
+    nlohmann::json Status = Executor.GetStatusJSON();
+    EXPECT_EQ(Status["NumWorkers"], 3);
+    EXPECT_EQ(Status["MaxQueued"], 16);
+    EXPECT_EQ(Status["Running"][int(TaskPrioritySaveLoad)], 1);
+    EXPECT_EQ(Status["Queued"][int(TaskPrioritySaveLoad)], 2);
+    EXPECT_EQ(Status["Running"][int(TaskPriorityInteractive)], 0);
+
+    Saves.Open();
+    ASSERT_TRUE(Eventually([&]() {
+        nlohmann::json Now = Executor.GetStatusJSON();
+        return (Now["Running"][int(TaskPrioritySaveLoad)] == 0) && (Now["Queued"][int(TaskPrioritySaveLoad)] == 0);
+    }));
+    EXPECT_EQ(MaxSaving, 1);
+}
+
+TEST_F(ManagedTaskExecutorTest, test_FullQueueRefusesTasks) {
+    ManagedTaskExecutor Executor(&Logger, 1, 2, NoLimits);
+    Gate Blocker;
+    ManagerTaskData BlockerData(GetResourceStatusTask);
+    ASSERT_TRUE(Executor.Submit(&BlockerData, TaskPriorityInteractive, [&Blocker]() { Blocker.Wait(); }));
+    ASSERT_TRUE(Blocker.WaitForWaiting(1));
+
+    // The running task does not count against the queue limit.
+    std::atomic<int> NumRun{0};
+    ManagerTaskData A(GetResourceStatusTask), B(GetResourceStatusTask), Refused(GetResourceStatusTask);
+    EXPECT_TRUE(Executor.Submit(&A, TaskPriorityInteractive, [&NumRun]() { NumRun++; }));
+    EXPECT_TRUE(Executor.Submit(&B, TaskPriorityInteractive, [&NumRun]() { NumRun++; }));
+
+    std::atomic<bool> RefusedRun{false};
+    EXPECT_FALSE(Executor.Submit(&Refused, TaskPriorityInteractive, [&RefusedRun]() { RefusedRun = true; }));
+
+    // A refused managed task keeps its status and none of its functions run.
+    ManagerTaskData RefusedManaged(GetResourceStatusTask);
+    std::atomic<bool> NotStartedCalled{false};
+    EXPECT_FALSE(Executor.SubmitManagerTask(&RefusedManaged, [&RefusedRun](ManagerTaskData*) { RefusedRun = true; }, [&NotStartedCalled]() { NotStartedCalled = true; }));
+    EXPECT_EQ(RefusedManaged.Status, ManagerTaskStatus::Active);
+
+    Blocker.Open();
+    ASSERT_TRUE(Eventually([&]() { return NumRun == 2; }));
+    EXPECT_FALSE(RefusedRun);
+    EXPECT_FALSE(NotStartedCalled);
+}
+
+TEST_F(ManagedTaskExecutorTest, test_StatusQueuedUntilStarted) {
+    ManagedTaskExecutor Executor(&Logger, 1, 16, NoLimits);
+    Gate Blocker;
+    ManagerTaskData BlockerData(GetResourceStatusTask);
+    ASSERT_TRUE(Executor.Submit(&BlockerData, TaskPriorityInteractive, [&Blocker]() { Blocker.Wait(); }));
+    ASSERT_TRUE(Blocker.WaitForWaiting(1));
+
+    ManagerTaskData Data(GetResourceStatusTask);
+    EXPECT_EQ(Data.Status, ManagerTaskStatus::Active);
+
+    Gate Task;
+    std::atomic<int> StatusWhileRunning{-1};
+    ASSERT_TRUE(Executor.SubmitManagerTask(&Data, [&](ManagerTaskData* _Data) {
+        StatusWhileRunning = int(_Data->Status.load());
+        Task.Wait();
+        _Data->SetStatus(ManagerTaskStatus::Success);
+    }));
+    Data.IncludeStatusInOutputData();
+    EXPECT_EQ(Data.OutputData["TaskStatus"], int(ManagerTaskStatus::Queued));
+    EXPECT_EQ(Data.OutputData["TaskState"], "queued");
+
+    Blocker.Open();
+    ASSERT_TRUE(Task.WaitForWaiting(1));
+    EXPECT_EQ(StatusWhileRunning, int(ManagerTaskStatus::Active));
+    Data.IncludeStatusInOutputData();
+    EXPECT_EQ(Data.OutputData["TaskState"], "running");
+
+    Task.Open();
+    ASSERT_TRUE(Eventually([&]() { return Data.Status == ManagerTaskStatus::Success; }));
+    Data.IncludeStatusInOutputData();
+    EXPECT_EQ(Data.OutputData["TaskState"], "done");
+}
+
+TEST_F(ManagedTaskExecutorTest, test_CancelQueuedTask) {
+    ManagedTaskExecutor Executor(&Logger, 1, 16, NoLimits);
+    Gate Blocker;
+    ManagerTaskData BlockerData(GetResourceStatusTask);
+    ASSERT_TRUE(Executor.Submit(&BlockerData, TaskPriorityInteractive, [&Blocker]() { Blocker.Wait(); }));
+    ASSERT_TRUE(Blocker.WaitForWaiting(1));
+
+    ManagerTaskData Data(SimulationSaveModelTask);
+    std::atomic<bool> TaskRun{false};
+    std::atomic<int> NumNotStarted{0};
+    ASSERT_TRUE(Executor.SubmitManagerTask(&Data, [&TaskRun](ManagerTaskData*) { TaskRun = true; }, [&NumNotStarted]() { NumNotStarted++; }));
+
+    // Cancelled and finished before Cancel() returns.
+    EXPECT_TRUE(Executor.Cancel(&Data));
+    EXPECT_EQ(Data.Status, ManagerTaskStatus::Cancelled);
+    EXPECT_EQ(ManagerTaskData::StateName(Data.Status), "done");
+    EXPECT_EQ(NumNotStarted, 1);
+    EXPECT_EQ(Executor.GetStatusJSON()["Queued"][int(TaskPrioritySaveLoad)], 0);
+
+    // Cancelling again finds nothing to do.
+    EXPECT_FALSE(Executor.Cancel(&Data));
+    Blocker.Open();
+    ManagerTaskData After(GetResourceStatusTask);
+    std::atomic<bool> AfterRun{false};
+    ASSERT_TRUE(Executor.Submit(&After, TaskPriorityInteractive, [&AfterRun]() { AfterRun = true; }));
+    ASSERT_TRUE(Eventually([&]() { return AfterRun.load(); }));
+    EXPECT_FALSE(TaskRun);
+    EXPECT_EQ(NumNotStarted, 1);
+}
+
+TEST_F(ManagedTaskExecutorTest, test_CancelRunningTask) {
+    ManagedTaskExecutor Executor(&Logger, 1, 16, NoLimits);
+    ManagerTaskData Data(SimulationSweepTask);
+    std::atomic<bool> Started{false};
+    std::atomic<bool> NotStartedCalled{false};
+    ASSERT_TRUE(Executor.SubmitManagerTask(&Data, [&Started](ManagerTaskData* _Data) {
+        Started = true;
+        while (!_Data->IsCancelled()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        _Data->SetStatus(ManagerTaskStatus::Cancelled);
+    }, [&NotStartedCalled]() { NotStartedCalled = true; }));
+    ASSERT_TRUE(Eventually([&]() { return Started.load(); }));
+
+    // Only asked to stop, the task sets its own status.
+    EXPECT_FALSE(Executor.Cancel(&Data));
+    EXPECT_TRUE(Data.IsCancelled());
+    ASSERT_TRUE(Eventually([&]() { return Data.Status == ManagerTaskStatus::Cancelled; }));
+    EXPECT_FALSE(NotStartedCalled);
+}
+
+TEST_F(ManagedTaskExecutorTest, test_CancelDoneTaskKeepsStatus) {
+    ManagedTaskExecutor Executor(&Logger, 1, 16, NoLimits);
+    ManagerTaskData Data(GetResourceStatusTask);
+    ASSERT_TRUE(Executor.SubmitManagerTask(&Data, [](ManagerTaskData* _Data) { _Data->SetStatus(ManagerTaskStatus::Success); }));
+    ASSERT_TRUE(Eventually([&]() { return Data.Status == ManagerTaskStatus::Success; }));
+
+    EXPECT_FALSE(Executor.Cancel(&Data));
+    EXPECT_EQ(Data.Status, ManagerTaskStatus::Success);
+}
+
+TEST_F(ManagedTaskExecutorTest, test_DestructorCancelsQueuedTasks) {
+    Gate Blocker;
+    ManagerTaskData BlockerData(GetResourceStatusTask);
+    ManagerTaskData Data(SimulationLoadModelTask);
+    std::atomic<bool> TaskRun{false};
+    std::atomic<bool> NotStartedCalled{false};
+    std::thread Release;
+    {
+        ManagedTaskExecutor Executor(&Logger, 1, 16, NoLimits);
+        ASSERT_TRUE(Executor.Submit(&BlockerData, TaskPriorityInteractive, [&Blocker, &BlockerData]() {
+            Blocker.Wait();
+            EXPECT_TRUE(BlockerData.IsCancelled());
+        }));
+        ASSERT_TRUE(Blocker.WaitForWaiting(1));
+        ASSERT_TRUE(Executor.SubmitManagerTask(&Data, [&TaskRun](ManagerTaskData*) { TaskRun = true; }, [&NotStartedCalled]() { NotStartedCalled = true; }));
+
+        // The destructor joins the worker, so the blocker is released from
+        // another thread once the running task has been asked to stop.
+        Release = std::thread([&]() {
+            while (!BlockerData.IsCancelled()) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            Blocker.Open();
+        });
+    }
+    Release.join();
+    EXPECT_FALSE(TaskRun);
+    EXPECT_TRUE(NotStartedCalled);
+    EXPECT_EQ(Data.Status, ManagerTaskStatus::Cancelled);
+}
@@ -14,6 +14,7 @@
 #include <string>
 #include <memory>
 #include <map>
+#include <atomic>
 
 // Third-Party Libraries (BG convention: use <> instead of "")
 #include <nlohmann/json.hpp>
@@ -32,6 +33,8 @@ enum ManagerTaskStatus {
     Active = 1,  // Freshly created and/or actively operating.
     TimeOut = 2, // Failed due to time-out.
     GeneralFailure = 3,
+    Queued = 4,    // Waiting for a worker of the managed task executor.
+    Cancelled = 5, // Cancelled with ManTaskCancel before or while running.
     NUMManagerTaskStatus
 };
 
@@ -48,6 +51,10 @@ enum ManagedTasks {
     SimulationLoadModelTask = 4,
     GetConnectomeTask = 5,
     GetAbstractConnectomeTask = 6,
+    SimulationSaveCheckpointTask = 7,
+    SimulationLoadCheckpointTask = 8,
+    SimulationSweepTask = 9,
+    SimulationCloneTask = 10,
     NUMManagedTasks
 };
 
@@ -59,9 +66,17 @@ enum ManagedTasks {
  * 
  * Process:
  * 1. Prepare the data that the Task will need.
- * 2. Launch the specific Task function within a std::thread, giving it a pointer to this struct.
- * 3. Call AddManagerTask with this struct.
- * 4. Use the Task ID to refer to the status and results of the Task, as stored in this struct.
+ * 2. Call AddManagerTask with this struct and the specific Task function. The
+ *    function is queued on the managed task executor, which runs it with a
+ *    pointer to this struct once a worker is free.
+ * 3. Use the Task ID to refer to the status and results of the Task, as stored in this struct.
+ *
+ * Long running Task functions should check IsCancelled() where they can stop
+ * early and then set the Cancelled status.
+ *
+ * Tasks that read or write the whole InputSim off its engine thread call
+ * ClaimInputSim() before step 2. AddManagerTask releases the claim when the
+ * task ends, or it can be released earlier with ReleaseInputSim().
  */
 struct ManagerTaskData {
     // Must be set before launching Task:
@@ -72,15 +87,14 @@ struct ManagerTaskData {
     int InputInt; // optional, useful for something like Simulation ID
     Simulator::Simulation* InputSim = nullptr; // optional, quick pointer to Simulation object
     std::map<int, bool> InputFlags; // optional, map of options
-
-    // Must be set before calling AddManagerTask:
-    std::unique_ptr<std::thread> Task;
+    std::atomic<Simulator::Simulation*> ClaimedSim{nullptr}; // InputSim while claimed by this task, see Simulation::ClaimForTask()
 
     // Is set within AddManagerTask:
     int ID = -1; 
 
     // Results set by the Task thread:
-    ManagerTaskStatus Status = ManagerTaskStatus::Active;
+    std::atomic<ManagerTaskStatus> Status{ManagerTaskStatus::Active}; // Queued once submitted, see ManagedTaskExecutor::SubmitManagerTask()
+    std::atomic<bool> CancelRequested{false};
     nlohmann::json OutputData = nlohmann::json::object();
     int ReplaceSimulationID = -1;
 
@@ -88,7 +102,34 @@ struct ManagerTaskData {
 
     void SetStatus(ManagerTaskStatus _status) { Status = _status; }
 
-    void IncludeStatusInOutputData() { OutputData["TaskStatus"] = int(Status); }
+    void RequestCancel() { CancelRequested = true; }
+
+    bool IsCancelled() const { return CancelRequested; }
+
+    bool ClaimInputSim() {
+        if ((!InputSim) || (!InputSim->ClaimForTask())) {
+            return false;
+        }
+        ClaimedSim = InputSim;
+        return true;
+    }
+
+    void ReleaseInputSim() {
+        Simulator::Simulation* Sim = ClaimedSim.exchange(nullptr);
+        if (Sim) Sim->ReleaseTaskClaim();
+    }
+
+    static std::string StateName(ManagerTaskStatus _status) {
+        if (_status == ManagerTaskStatus::Queued) return "queued";
+        if (_status == ManagerTaskStatus::Active) return "running";
+        return "done";
+    }
+
+    void IncludeStatusInOutputData() {
+        ManagerTaskStatus CurrentStatus = Status;
+        OutputData["TaskStatus"] = int(CurrentStatus);
+        OutputData["TaskState"] = StateName(CurrentStatus);
+    }
 
     bool HasReplacementSimID() { return ReplaceSimulationID >= 0; }
 };
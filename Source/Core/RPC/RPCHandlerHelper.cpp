@@ -31,6 +31,22 @@ HandlerData::HandlerData(const std::string& _JSONRequest, BG::Common::Logger::Lo
     SimVec = _Simulations;
     RequestJSON = nlohmann::json::parse(_JSONRequest);
 
+    FindSimulation(PermitBusy, NoSimulation);
+}
+
+HandlerData::HandlerData(nlohmann::json&& _JSONRequest, BG::Common::Logger::LoggingSystem* _Logger, std::string _RoutePath, Simulations _Simulations, bool PermitBusy, bool NoSimulation) {
+
+    Logger_ = _Logger;
+    RoutePath_ = _RoutePath;
+
+    SimVec = _Simulations;
+    RequestJSON = std::move(_JSONRequest);
+
+    FindSimulation(PermitBusy, NoSimulation);
+}
+
+void HandlerData::FindSimulation(bool PermitBusy, bool NoSimulation) {
+
     // bool isloadingsim = (ManTaskData != nullptr); // Man.IsLoadingSim();
     // if (isloadingsim && (_Source == "SimulationLoad")) { // *** PERHAPS WE CAN ALLOW THIS (AS WE USE LOCAL PARAMS NOW)?
     //     Man.Logger()->Log("Recursive SimulationLoad attempted.", 8);
@@ -82,7 +98,7 @@ HandlerData::HandlerData(const std::string& _JSONRequest, BG::Common::Logger::Lo
         return;
     }
 
-    if (!PermitBusy && (ThisSimulation->IsProcessing || ThisSimulation->WorkRequested)) {
+    if (!PermitBusy && (ThisSimulation->IsProcessing || ThisSimulation->WorkRequested || ThisSimulation->IsTaskClaimed())) {
         Logger_->Log("Simulation Is Currently Busy, And Route Is Not Allowed To Run While Busy", 8);
         Status = BGStatusCode::BGStatusSimulationBusy;
         return;
@@ -123,17 +139,25 @@ std::string HandlerData::ResponseAndStoreRequest(nlohmann::json& ResponseJSON,
     //         ThisSimulation->StoreRequestHandled(Source, _RH.at(Source).Route, JSONRequestStr);
     //     }
     // }
+    if (store) {
+        StoreRequest();
+    }
+    return ResponseJSON.dump();
+}
+nlohmann::json HandlerData::ResponseAndStoreRequestJSON(nlohmann::json& ResponseJSON) {
+    StoreRequest();
+    return std::move(ResponseJSON);
+}
+void HandlerData::StoreRequest() {
     if (ThisSimulation != nullptr) {
+        if (JSONRequestStr.empty()) {
+            JSONRequestStr = RequestJSON.dump();
+        }
         ThisSimulation->StoreRequestHandled(RoutePath_, JSONRequestStr);
     }
-
-    return ResponseJSON.dump();
 }
 std::string HandlerData::ErrResponse(int _Status) {
-    Status = BGStatusCode(_Status);
-    nlohmann::json ResponseJSON;
-    ResponseJSON["StatusCode"] = _Status;
-    return ResponseAndStoreRequest(ResponseJSON);
+    return ErrResponseJSON(_Status).dump();
 }
 std::string HandlerData::ErrResponse(BGStatusCode _Status) {
     return ErrResponse(int(_Status));
@@ -141,12 +165,27 @@ std::string HandlerData::ErrResponse(BGStatusCode _Status) {
 std::string HandlerData::ErrResponse() {
     return ErrResponse(int(Status));
 }
+nlohmann::json HandlerData::ErrResponseJSON(int _Status) {
+    Status = BGStatusCode(_Status);
+    nlohmann::json ResponseJSON;
+    ResponseJSON["StatusCode"] = _Status;
+    return ResponseAndStoreRequestJSON(ResponseJSON);
+}
+nlohmann::json HandlerData::ErrResponseJSON(BGStatusCode _Status) {
+    return ErrResponseJSON(int(_Status));
+}
+nlohmann::json HandlerData::ErrResponseJSON() {
+    return ErrResponseJSON(int(Status));
+}
 
 std::string HandlerData::ResponseWithID(const std::string& IDName, int IDValue) {
+    return ResponseWithIDJSON(IDName, IDValue).dump();
+}
+nlohmann::json HandlerData::ResponseWithIDJSON(const std::string& IDName, int IDValue) {
     nlohmann::json ResponseJSON;
     ResponseJSON["StatusCode"] = int(Status);
     ResponseJSON[IDName] = IDValue;
-    return ResponseAndStoreRequest(ResponseJSON);
+    return ResponseAndStoreRequestJSON(ResponseJSON);
 }
 std::string HandlerData::ResponseWithID(const std::string& IDName, const std::string& IDValue) {
     nlohmann::json ResponseJSON;
@@ -176,6 +215,16 @@ const nlohmann::json& HandlerData::ReqJSON() const {
     return RequestJSON;
 }
 
+nlohmann::json& HandlerData::ReqJSON() {
+    return RequestJSON;
+}
+
+nlohmann::json HandlerData::TakeReqJSON() {
+    nlohmann::json Request = std::move(RequestJSON);
+    RequestJSON = nlohmann::json();
+    return Request;
+}
+
 // bool HandlerData::CheckCompatibility(Simulator::SimulationNeuronClass _NewObjectCategory) {
 //     if (ThisSimulation->SimNeuronClass == Simulator::UNDETERMINED) {
 //         ThisSimulation->SimNeuronClass = _NewObjectCategory;
@@ -207,9 +256,9 @@ bool HandlerData::FindPar(const std::string& ParName, nlohmann::json::iterator&
     return FindPar(ParName, Iterator, RequestJSON, _Optional);
 }
 
-bool HandlerData::GetParBool(const std::string& ParName, bool& Value, nlohmann::json& _JSON) {
+bool HandlerData::GetParBool(const std::string& ParName, bool& Value, nlohmann::json& _JSON, bool _Optional) {
     nlohmann::json::iterator it;
-    if (!FindPar(ParName, it, _JSON)) {
+    if (!FindPar(ParName, it, _JSON, _Optional)) {
         return false;
     }
     if (!it.value().is_boolean()) {
@@ -221,13 +270,13 @@ bool HandlerData::GetParBool(const std::string& ParName, bool& Value, nlohmann::
     return true;
 }
 
-bool HandlerData::GetParBool(const std::string& ParName, bool& Value) {
-    return GetParBool(ParName, Value, RequestJSON);
+bool HandlerData::GetParBool(const std::string& ParName, bool& Value, bool _Optional) {
+    return GetParBool(ParName, Value, RequestJSON, _Optional);
 }
 
-bool HandlerData::GetParInt(const std::string& ParName, int& Value, nlohmann::json& _JSON) {
+bool HandlerData::GetParInt(const std::string& ParName, int& Value, nlohmann::json& _JSON, bool _Optional) {
     nlohmann::json::iterator it;
-    if (!FindPar(ParName, it, _JSON)) {
+    if (!FindPar(ParName, it, _JSON, _Optional)) {
         return false;
     }
     if (!it.value().is_number()) {
@@ -239,8 +288,26 @@ bool HandlerData::GetParInt(const std::string& ParName, int& Value, nlohmann::js
     return true;
 }
 
-bool HandlerData::GetParInt(const std::string& ParName, int& Value) {
-    return GetParInt(ParName, Value, RequestJSON);
+bool HandlerData::GetParInt(const std::string& ParName, int& Value, bool _Optional) {
+    return GetParInt(ParName, Value, RequestJSON, _Optional);
+}
+
+bool HandlerData::GetParUInt64(const std::string& ParName, uint64_t& Value, nlohmann::json& _JSON, bool _Optional) {
+    nlohmann::json::iterator it;
+    if (!FindPar(ParName, it, _JSON, _Optional)) {
+        return false;
+    }
+    if (!it.value().is_number_integer() || (!it.value().is_number_unsigned() && (it.value().template get<int64_t>() < 0))) {
+        Logger_->Log("Error Parameter '" + ParName + "', Wrong Type (expected non-negative integer) Request Is: " + _JSON.dump(), 7);
+        Status = BGStatusCode::BGStatusInvalidParametersPassed;
+        return false;
+    }
+    Value = it.value().template get<uint64_t>();
+    return true;
+}
+
+bool HandlerData::GetParUInt64(const std::string& ParName, uint64_t& Value, bool _Optional) {
+    return GetParUInt64(ParName, Value, RequestJSON, _Optional);
 }
 
 bool HandlerData::GetParFloat(const std::string& ParName, float& Value, nlohmann::json& _JSON, bool _Optional) {
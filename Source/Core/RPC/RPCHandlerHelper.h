@@ -45,7 +45,7 @@ protected:
 
     BG::Common::Logger::LoggingSystem* Logger_ = nullptr; /**Pointer to the instance of the logging system*/
 
-    std::string JSONRequestStr;
+    std::string JSONRequestStr; /**Only set when constructed from a string, otherwise dumped when the request is stored*/
     std::string RoutePath_; /**Path that is this route*/
     nlohmann::json RequestJSON;
     BGStatusCode Status = BGStatusSuccess;
@@ -53,9 +53,16 @@ protected:
     int SimulationID = -1;
     Simulator::Simulation* ThisSimulation = nullptr;
 
+    void FindSimulation(bool PermitBusy, bool NoSimulation);
+    void StoreRequest();
+
 public:
     HandlerData(const std::string& _JSONRequest, BG::Common::Logger::LoggingSystem* _Logger, std::string _RoutePath, Simulations _Simulations, bool PermitBusy = false, bool NoSimulation = false);
 
+    // For handlers registered with RPCManager::AddJSONRoute(). The request
+    // is taken over as is, without a round trip through text.
+    HandlerData(nlohmann::json&& _JSONRequest, BG::Common::Logger::LoggingSystem* _Logger, std::string _RoutePath, Simulations _Simulations, bool PermitBusy = false, bool NoSimulation = false);
+
     // See how this is used in Manager::SimulationCreate().
     // Simulator::Simulation* NewSimulation();
 
@@ -82,12 +89,27 @@ public:
     std::string ResponseWithID(const std::string& IDName, const std::string& IDValue);
     std::string StringResponse(std::string _Key, std::string _Value);
 
+    // The same responses for handlers that return nlohmann::json.
+    nlohmann::json ResponseAndStoreRequestJSON(nlohmann::json& ResponseJSON);
+    nlohmann::json ErrResponseJSON(int _Status);
+    nlohmann::json ErrResponseJSON(BGStatusCode _Status);
+    nlohmann::json ErrResponseJSON();
+    nlohmann::json ResponseWithIDJSON(const std::string& IDName, int IDValue);
+
     int SimID() const;
     std::string SimIDStr() const;
 
     Simulator::Simulation* Sim() const;
 
     const nlohmann::json& ReqJSON() const;
+    // For the GetPar*() overloads that take the JSON to read from. Do not
+    // modify the request, it is stored as is for the replay log.
+    nlohmann::json& ReqJSON();
+    // Moves the request out, for handlers that hand its parts on, like
+    // RPCManager::NESRequest(). The request is empty afterwards, so this
+    // is only for handlers that do not store their request (see
+    // ResponseAndStoreRequest()) and do not read parameters afterwards.
+    nlohmann::json TakeReqJSON();
 
     //bool CheckCompatibility(Simulator::SimulationNeuronClass _NewObjectCategory);
 
@@ -96,11 +118,15 @@ public:
     bool FindPar(const std::string& ParName, nlohmann::json::iterator& Iterator, nlohmann::json& _JSON, bool _Optional = false);
     bool FindPar(const std::string& ParName, nlohmann::json::iterator& Iterator, bool _Optional = false);
 
-    bool GetParBool(const std::string& ParName, bool& Value, nlohmann::json& _JSON);
-    bool GetParBool(const std::string& ParName, bool& Value);
+    bool GetParBool(const std::string& ParName, bool& Value, nlohmann::json& _JSON, bool _Optional = false);
+    bool GetParBool(const std::string& ParName, bool& Value, bool _Optional = false);
+
+    bool GetParInt(const std::string& ParName, int& Value, nlohmann::json& _JSON, bool _Optional = false);
+    bool GetParInt(const std::string& ParName, int& Value, bool _Optional = false);
 
-    bool GetParInt(const std::string& ParName, int& Value, nlohmann::json& _JSON);
-    bool GetParInt(const std::string& ParName, int& Value);
+    //! For sizes and file offsets beyond the range of int.
+    bool GetParUInt64(const std::string& ParName, uint64_t& Value, nlohmann::json& _JSON, bool _Optional = false);
+    bool GetParUInt64(const std::string& ParName, uint64_t& Value, bool _Optional = false);
 
     bool GetParFloat(const std::string& ParName, float& Value, nlohmann::json& _JSON, bool _Optional = false);
     bool GetParFloat(const std::string& ParName, float& Value, bool _Optional = false);
@@ -87,14 +87,25 @@ bool RPCManager::UnRegisterBgAPIProcess(long _BGRequestID) {
 // }
 
 void RPCManager::AddRoute(std::string _RouteHandle, std::function<std::string(std::string _JSONRequest)> _Function) {
-    Logger_->Log("Registering Callback For Route '" + _RouteHandle + "'", 4);
-    RequestHandlers_.insert(std::pair<std::string, std::function<std::string(std::string _JSONRequest)>>(_RouteHandle, _Function));
+    if (!_Function) {
+        AddJSONRoute(_RouteHandle, nullptr);
+        return;
+    }
+    // Compatibility adapter, string handlers still pay for the text round trip.
+    AddJSONRoute(_RouteHandle, [_Function](nlohmann::json _Request) {
+        return nlohmann::json::parse(_Function(_Request.dump()));
+    });
     // RouteAndHandler Handler;
     // Handler.Route_ = _RouteHandle;
     // Handler.Handler_ = _Function;
     // AddRequestHandler(_RouteHandle, Handler);
 }
 
+void RPCManager::AddJSONRoute(std::string _RouteHandle, JSONRouteHandler _Function) {
+    Logger_->Log("Registering Callback For Route '" + _RouteHandle + "'", 4);
+    RequestHandlers_.insert(std::pair<std::string, JSONRouteHandler>(_RouteHandle, _Function));
+}
+
 
 bool BadReqID(int ReqID) {
     // *** TODO: Add some rules here for ReqIDs that should be refused.
@@ -122,7 +133,7 @@ bool BadReqID(int ReqID) {
  *   <more requests>
  * ]
  */
-std::string RPCManager::NESRequest(std::string _JSONRequest, int _SimulationIDOverride) { // Generic JSON-based NES requests.
+std::string RPCManager::NESRequest(std::string _JSONRequest, int _SimulationIDOverride, const std::atomic<bool>* _CancelRequested) { // Generic JSON-based NES requests.
 
     // Parse Request
     //Logger_->Log(_JSONRequest, 3);
@@ -139,8 +150,15 @@ std::string RPCManager::NESRequest(std::string _JSONRequest, int _SimulationIDOv
     // Build Response
     nlohmann::json ResponseJSON = nlohmann::json::array(); // Create empty array for the list of responses.
 
-    // For each request in the JSON list:
-    for (const auto& req : Handle.ReqJSON()) {
+    // For each request in the JSON list. The requests are moved on to their
+    // handlers, so the batch is taken over from the handler data.
+    nlohmann::json Batch = Handle.TakeReqJSON();
+    for (auto& req : Batch) {
+
+        if ((_CancelRequested != nullptr) && _CancelRequested->load()) {
+            Logger_->Log("NES request batch cancelled after " + std::to_string(ResponseJSON.size()) + " requests", 6);
+            break;
+        }
 
         int ReqID = -1;
         //int SimulationID = -1;
@@ -150,14 +168,14 @@ std::string RPCManager::NESRequest(std::string _JSONRequest, int _SimulationIDOv
         //std::string Response;
 
         // Get the mandatory components of a request:
-        for (const auto& [req_key, req_value]: req.items()) {
+        for (auto& [req_key, req_value]: req.items()) {
             if (req_key == "ReqID") {
                 ReqID = req_value.template get<int>();
             //} else if (req_key == "SimID") {
             //    SimulationID = req_value.template get<int>();
             } else {
                 ReqFunc = req_key;
-                ReqParams = req_value;
+                ReqParams = std::move(req_value);
             }
         }
         // if (BadReqID(ReqID)) { // e.g. < highest request ID already handled
@@ -182,20 +200,13 @@ std::string RPCManager::NESRequest(std::string _JSONRequest, int _SimulationIDOv
                 if (_SimulationIDOverride != -1) {
                     ReqParams["SimulationID"] = _SimulationIDOverride;
                 }
-                std::string Response = it->second(ReqParams.dump()); // Calls the handler.
-                // *** TODO: Either:
-                //     a) Convert handlers to return nlohmann::json objects so that we
-                //        can easily add ReqResponseJSON["ReqID"] = ReqID here, or,
-                //     b) Convert Response back to a ReqResponseJSON here in order to
-                //        add that... (This is more work, lower performance...)
-                //     Right now, we do b) (sadly...)
-                ReqResponseJSON = nlohmann::json::parse(Response);
+                ReqResponseJSON = it->second(std::move(ReqParams)); // Calls the handler.
                 ReqResponseJSON["ReqID"] = ReqID;
             }
         }
 
         // }
-        ResponseJSON.push_back(ReqResponseJSON);
+        ResponseJSON.push_back(std::move(ReqResponseJSON));
 
     }
 
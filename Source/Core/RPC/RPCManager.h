@@ -13,6 +13,7 @@
 // Standard Libraries (BG convention: use <> instead of "")
 #include <iostream>
 #include <memory>
+#include <atomic>
 
 // Third-Party Libraries (BG convention: use <> instead of "")
 #include <rpc/server.h>
@@ -35,6 +36,14 @@ namespace BG {
 namespace NES {
 namespace API {
 
+/**
+ * @brief Calling convention of NES request handlers. The request parameters
+ * are handed over as a parsed object and the response is returned as one,
+ * so requests in an NES batch never go through text. Handlers taking and
+ * returning strings are adapted to it, see RPCManager::AddRoute().
+ */
+typedef std::function<nlohmann::json(nlohmann::json _Request)> JSONRouteHandler;
+
 /**
  * @brief Manages the NES remote procedure call (RPC) host.
  *
@@ -52,7 +61,7 @@ private:
     std::unique_ptr<SafeClient> APIClient_; /**Instance of the smartclient, allows us to talk back to the API's RPC server */
 
 
-    std::map<std::string, std::function<std::string(std::string _JSONRequest)>> RequestHandlers_;
+    std::map<std::string, JSONRouteHandler> RequestHandlers_;
 
     long BgRequestID = 0; // The next ID to use for a background request.
     std::map<long, nlohmann::json*> BgStatusResultMap;
@@ -119,6 +128,17 @@ public:
      */
     void AddRoute(std::string _RouteHandle, std::function<std::string(std::string _JSONRequest)> _Function);
 
+    /**
+     * @brief Adds a route whose handler takes and returns nlohmann::json.
+     * Prefer this for routes that appear in large batches, e.g. model
+     * construction, it avoids serializing and parsing every request and
+     * response once more.
+     *
+     * @param _RouteHandle
+     * @param _Function
+     */
+    void AddJSONRoute(std::string _RouteHandle, JSONRouteHandler _Function);
+
 
     /**
      * @brief Makes a query to the upstream API Service
@@ -130,7 +150,12 @@ public:
 
 
 
-    std::string NESRequest(std::string _JSONRequest, int _SimulationIDOverride = -1); // Generic JSON-based NES requests.
+    /**
+     * @brief Generic JSON-based NES requests. If _CancelRequested is given and
+     * becomes true, the remaining requests of the batch are skipped, e.g. when
+     * a managed task that replays a save is cancelled.
+     */
+    std::string NESRequest(std::string _JSONRequest, int _SimulationIDOverride = -1, const std::atomic<bool>* _CancelRequested = nullptr);
 
 
     /**
@@ -163,8 +163,8 @@ bool SafeClient::MakeJSONQuery(std::string _Route, std::string _Query, std::stri
 
 void SafeClient::RPCManagerThread() {
 
-    // Wait Until Config Valid
-    while (RPCHost_ == "") {
+    // Wait Until Config Valid, or until the client is destroyed without one
+    while ((RPCHost_ == "") && (!RequestExit_)) {
         std::this_thread::sleep_for(std::chrono::milliseconds(500));
     }
 
@@ -83,7 +83,7 @@ void BSNeuron::SetSpontaneousActivity(float mean, float stdev, int Seed) {
 void BSNeuron::Record(float t_ms) {
     assert(t_ms >= 0.0);
     this->TRecorded_ms.emplace_back(t_ms);
-    this->VmRecorded_mV.emplace_back(this->Vm_mV);
+    this->VmRecorded_mV.emplace_back(this->Vm());
 };
 
 //! Returns the recorded membrane potentials.
@@ -219,16 +219,15 @@ void BSNeuron::UpdateVm(float t_ms, bool recording) {
     this->Vm_mV = this->VRest_mV + VSpikeT_mV + VAHPT_mV + VPSPT_mV;
 
     // 4. Add voltage elevation to FIFO buffer for phospherescence convolution
-    if (!this->FIFO.empty()) {
+    if (!this->FIFO.empty() || this->CaFilter.IsSet()) {
         // We replace [0], i.e. drop the one at the end and push to front.
         // this->FIFO.pop_back();
         // this->FIFO.push_front(this->Vm_mV - this->VRest_mV);
         // *** TESTING: Newest at back of FIFO (as in SignalFunctions.py demo)
-        this->FIFO.pop_front();
         // Flipping sign of Vdiff, clipping at 0, scaling by V_AHP (see SignalFunctions.py demo)
         float v = this->VRest_mV - this->Vm_mV;
         v = v < 0.0 ? 0.0 : v / (-this->VAHP_mV);
-        this->FIFO.push_back(v);
+        this->PushCaSignal(v);
     }
 
     if (recording)
@@ -305,12 +304,20 @@ void BSNeuron::Update(float t_ms, bool recording) {
     this->T_ms = t_ms;
 };
 
+//! Size of the FIFO made by SetFIFO().
+size_t BSNeuron::FIFOSize(float FIFO_ms, float FIFO_dt_ms) {
+    return FIFO_dt_ms == 0.0 ? 1 : FIFO_ms / FIFO_dt_ms + 1;
+}
+
 //! Sets the initial value of the FIFO and prepares a buffer for convolvedFIFO.
 //! FIFO_dt_ms == 0.0 means used a FIFO of size 1.
 void BSNeuron::SetFIFO(float FIFO_ms, float FIFO_dt_ms, size_t reversed_kernel_size) {
     assert(FIFO_ms >= 0.0 && FIFO_dt_ms >= 0.0);
 
-    size_t fifoSize = FIFO_dt_ms == 0.0 ? 1 : FIFO_ms / FIFO_dt_ms + 1;
+    this->CaFilter = SignalFunctions::ConvolvedFIFOTap();
+    this->CaFilterState = SignalFunctions::ConvolvedFIFOTapState();
+
+    size_t fifoSize = FIFOSize(FIFO_ms, FIFO_dt_ms);
 
     for (size_t i = 0; i < fifoSize; ++i) this->FIFO.emplace_back(0.0);
 
@@ -318,6 +325,28 @@ void BSNeuron::SetFIFO(float FIFO_ms, float FIFO_dt_ms, size_t reversed_kernel_s
     this->ConvolvedFIFO.resize(convolvedFIFO_size, 0.0);
 };
 
+void BSNeuron::SetCaFilter(const SignalFunctions::ConvolvedFIFOTap & _Filter) {
+    assert(_Filter.IsSet());
+    this->CaFilter = _Filter;
+    this->CaFilterState.Reset(this->CaFilter);
+    this->FIFO.clear();
+    this->ConvolvedFIFO.clear();
+}
+
+void BSNeuron::PushCaSignal(float v) {
+    if (this->CaFilter.IsSet()) {
+        this->CaFilterState.Update(v);
+    } else {
+        this->FIFO.pop_front();
+        this->FIFO.push_back(v);
+    }
+}
+
+void BSNeuron::RecordCaFilter() {
+    assert(this->CaFilter.IsSet());
+    this->CaSamples.emplace_back(this->CaFilterState.Value(this->CaFilter));
+}
+
 //! NOTE: SetFIFO must be called first, otherwise the FIFO is not
 //!       updated in UpdateVm.
 //! NOTE: We flip signal FIFO, because most recent is in [0] and kernel
@@ -341,7 +370,7 @@ void BSNeuron::UpdateConvolvedFIFO(const std::vector<float> & reversed_kernel) {
 
         // Record Ca value with offset and record time-point:
         // Convolution results applicable to recent Vdiff are at end of ConvolvedFIFO (see SignalFunctions.py)
-        this->CaSamples.emplace_back(ConvolvedFIFO[ConvolvedFIFO.size()-10]); //+1.0);
+        this->CaSamples.emplace_back(ConvolvedFIFO[ConvolvedFIFO.size()-CaSampleOffset]); //+1.0);
 // if (ID==0) {
 //     std::cout << "DEBUG --> New Convolved value: " << this->CaSamples.back() << '\n';
 //     std::cout << "Kernel: ";
@@ -372,6 +401,79 @@ void BSNeuron::OutputTransmitterAdded(CoreStructs::ReceptorData* RData) {
 
 }
 
+void BSNeuron::SaveState(Tools::CheckpointWriter& _Writer) const {
+    CoreStructs::Neuron::SaveState(_Writer);
+
+    _Writer.Put(this->Vm());
+    _Writer.Put(this->T_ms);
+    _Writer.Put(this->TSpontNext_ms);
+    _Writer.Put(this->_has_spiked);
+    _Writer.Put(this->in_absref);
+    _Writer.Put(this->_dt_act_ms);
+
+    _Writer.Put(this->TauSpont_ms);
+    _Writer.Put<uint8_t>(this->DtSpontDist ? 1 : 0);
+    if (this->DtSpontDist) {
+        _Writer.PutString(this->DtSpontDist->GetState());
+    }
+
+    _Writer.PutVector(this->CaSamples);
+    _Writer.PutVector(this->TCaSamples_ms);
+    _Writer.PutDeque(this->FIFO);
+    _Writer.PutVector(this->ConvolvedFIFO);
+    _Writer.Put<uint64_t>(this->CaFilter.window);
+    _Writer.PutVector(this->CaFilter.weights);
+    _Writer.PutVector(this->CaFilterState.samples);
+    _Writer.Put<uint64_t>(this->CaFilterState.next);
+
+    _Writer.PutVector(this->TRecorded_ms);
+    _Writer.PutVector(this->VmRecorded_mV);
+}
+
+bool BSNeuron::LoadState(Tools::CheckpointReader& _Reader) {
+    if (!CoreStructs::Neuron::LoadState(_Reader)) return false;
+
+    _Reader.Get(this->Vm());
+    _Reader.Get(this->T_ms);
+    _Reader.Get(this->TSpontNext_ms);
+    _Reader.Get(this->_has_spiked);
+    _Reader.Get(this->in_absref);
+    _Reader.Get(this->_dt_act_ms);
+
+    SpontaneousActivityPars Spont;
+    uint8_t HasSpontDist = 0;
+    _Reader.Get(Spont);
+    _Reader.Get(HasSpontDist);
+    if (HasSpontDist) {
+        std::string DistState;
+        if (!_Reader.GetString(DistState)) return false;
+        // Spontaneous activity may have been set or changed after the model
+        // was built, so the distribution is made anew from the saved settings.
+        this->DtSpontDist = std::make_shared<Distributions::TruncNorm>(0.0, 2.0*Spont.mean, Spont.mean, Spont.stdev);
+        if (!this->DtSpontDist->SetState(DistState)) return false;
+    } else {
+        this->DtSpontDist.reset();
+    }
+    this->TauSpont_ms = Spont;
+
+    _Reader.GetVector(this->CaSamples);
+    _Reader.GetVector(this->TCaSamples_ms);
+    _Reader.GetDeque(this->FIFO);
+    _Reader.GetVector(this->ConvolvedFIFO);
+    uint64_t CaWindow = 0, CaNext = 0;
+    _Reader.Get(CaWindow);
+    _Reader.GetVector(this->CaFilter.weights);
+    _Reader.GetVector(this->CaFilterState.samples);
+    _Reader.Get(CaNext);
+    if ((this->CaFilterState.samples.size() != CaWindow) || (CaNext >= std::max<uint64_t>(CaWindow, 1))) return false;
+    this->CaFilter.window = CaWindow;
+    this->CaFilterState.next = CaNext;
+
+    _Reader.GetVector(this->TRecorded_ms);
+    _Reader.GetVector(this->VmRecorded_mV);
+    return _Reader.Ok();
+}
+
 const std::map<std::string, int> Neurotransmitter2ConnectionType = {
     { "AMPA", 1 },
     { "GABA", 2 },
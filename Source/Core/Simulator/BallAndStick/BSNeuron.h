@@ -63,6 +63,12 @@ public:
     std::unordered_map<std::string, Geometries::Geometry*> Morphology; // Regular pointers, because the objects are maintained in Simulation.Collection.
 
     float Vm_mV = -60.0;    //! Membrane potential
+    float* Vm_bound_mV = nullptr; //! Element of LIFCStateArrays that holds Vm_mV during a run, if any
+
+    //! Membrane potential, wherever it currently lives. Use this instead of
+    //! Vm_mV in code that can run during a simulation.
+    float& Vm() { return Vm_bound_mV ? *Vm_bound_mV : Vm_mV; }
+    float Vm() const { return Vm_bound_mV ? *Vm_bound_mV : Vm_mV; }
     float VRest_mV = -60.0; //! Resting membrane potential
     float VAct_mV = -50.0;  //! Action potential firing threshold
 
@@ -87,8 +93,11 @@ public:
 
     std::vector<float> TRecorded_ms{};
     std::vector<float> VmRecorded_mV{};
+    static constexpr size_t CaSampleOffset = 10; //! Ca samples are ConvolvedFIFO[ConvolvedFIFO.size()-CaSampleOffset].
     std::deque<float> FIFO{};
     std::vector<float> ConvolvedFIFO{};
+    SignalFunctions::ConvolvedFIFOTap CaFilter{}; //! Used instead of FIFO when set, see SetCaFilter().
+    SignalFunctions::ConvolvedFIFOTapState CaFilterState{};
     std::vector<CoreStructs::ReceptorData*> ReceptorDataVec{};
     std::vector<CoreStructs::ReceptorData*> TransmitterDataVec{};
 
@@ -175,14 +184,35 @@ public:
     //!       that was reversed and stored during initialization.
     void UpdateConvolvedFIFO(const std::vector<float> & reversed_kernel);
 
+    //! Size of the FIFO made by SetFIFO().
+    static size_t FIFOSize(float FIFO_ms, float FIFO_dt_ms);
+
     //! Sets the initial value of the FIFO and prepares a buffer for convolvedFIFO.
     //! FIFO_dt_ms == 0.0 means used a FIFO of size 1.
     void SetFIFO(float FIFO_ms, float FIFO_dt_ms, size_t reversed_kernel_size);
 
+    //! Replaces the FIFO and its convolution by a copy of _Filter, which
+    //! must have been initialized for the FIFO size and kernel that SetFIFO()
+    //! would use and for CaSampleOffset. The recorded Ca samples are the same
+    //! as with the FIFO, at O(1) per update and O(CaSampleOffset) per sample.
+    void SetCaFilter(const SignalFunctions::ConvolvedFIFOTap & _Filter);
+
+    //! Adds the calcium indicator input of the current update to the FIFO
+    //! or the Ca filter.
+    void PushCaSignal(float v);
+
+    //! Records the current filter output as a Ca sample.
+    void RecordCaFilter();
+
     virtual void InputReceptorAdded(CoreStructs::ReceptorData* RData);
 
     virtual void OutputTransmitterAdded(CoreStructs::ReceptorData* RData);
 
+    //! Adds the membrane, spontaneous activity, calcium indicator and
+    //! recording state to that of CoreStructs::Neuron.
+    virtual void SaveState(Tools::CheckpointWriter& _Writer) const;
+    virtual bool LoadState(Tools::CheckpointReader& _Reader);
+
     // Used in Simulation::GetConnectomeJSON().
     virtual void GetConnectomeTargetsJSON(nlohmann::json& targetvec, nlohmann::json& typevec, nlohmann::json& weightvec);
 
@@ -1,5 +1,7 @@
 #include <Simulator/Distributions/Distribution.h>
 
+#include <sstream>
+
 namespace BG {
 namespace NES {
 namespace Simulator {
@@ -21,6 +23,18 @@ Distribution::Distribution() {
 //! Sets the random number generator seed.
 void Distribution::SetSeed(uint32_t _Seed) { this->_Gen.seed(_Seed); };
 
+std::string Distribution::GetState() const {
+    std::stringstream State;
+    State << this->_Gen;
+    return State.str();
+}
+
+bool Distribution::SetState(const std::string& _State) {
+    std::stringstream State(_State);
+    State >> this->_Gen;
+    return !State.fail();
+}
+
 }; // namespace Distributions
 }; // namespace Simulator
 }; // namespace NES
@@ -14,6 +14,7 @@
 #include <chrono>
 #include <cstdint>
 #include <random>
+#include <string>
 #include <tuple>
 #include <vector>
 
@@ -41,6 +42,11 @@ class Distribution {
     //! Sets the random number generator seed.
     void SetSeed(uint32_t _Seed);
 
+    //! Generator state as text, so that a sequence can be continued
+    //! exactly after a checkpoint restore.
+    virtual std::string GetState() const;
+    virtual bool SetState(const std::string& _State);
+
     //! Generates a random sample from the distribution of size numSamples.
     virtual std::vector<float> RandomSample(size_t numSamples) = 0;
 
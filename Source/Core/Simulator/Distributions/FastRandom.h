@@ -0,0 +1,91 @@
+//=================================================================//
+// This file is part of the BrainGenix-NES Neuron Emulation System //
+//=================================================================//
+
+/*
+    Description: This file provides the FastRandom generator, a small
+                 xoshiro128+ generator for per-timestep noise.
+    Additional Notes: None
+    Date Created: 2026-10-17
+*/
+
+#pragma once
+
+#include <cstdint>
+
+namespace BG {
+namespace NES {
+namespace Simulator {
+namespace Distributions {
+
+/**
+ * @brief xoshiro128+ generator seeded through splitmix64.
+ *
+ * Much cheaper than std::mt19937 with a std::uniform_real_distribution and,
+ * unlike rand(), it has per-instance state, so independent instances can be
+ * used from different threads and give reproducible sequences.
+ */
+class FastRandom {
+
+  private:
+    uint32_t State_[4]; //! Generator state, never all zero.
+
+    static uint32_t Rotl(uint32_t x, int k) { return (x << k) | (x >> (32 - k)); }
+
+  public:
+    //! Constructors
+    FastRandom(uint64_t Seed = 0) { SetSeed(Seed); }
+
+    /**
+     * @brief Restarts the sequence from a new seed.
+     */
+    void SetSeed(uint64_t Seed);
+
+    /**
+     * @brief Copies the generator state out or back in, e.g. for checkpoints.
+     */
+    void GetState(uint32_t State[4]) const { for (int i = 0; i < 4; i++) State[i] = State_[i]; }
+    void SetState(const uint32_t State[4]) { for (int i = 0; i < 4; i++) State_[i] = State[i]; }
+
+    /**
+     * @brief Returns the next 32 random bits.
+     */
+    uint32_t Next() {
+        uint32_t Result = State_[0] + State_[3];
+        uint32_t t = State_[1] << 9;
+        State_[2] ^= State_[0];
+        State_[3] ^= State_[1];
+        State_[1] ^= State_[2];
+        State_[0] ^= State_[3];
+        State_[2] ^= t;
+        State_[3] = Rotl(State_[3], 11);
+        return Result;
+    }
+
+    /**
+     * @brief Generates a random sample from the uniform distribution in [0, 1).
+     */
+    float UniformRandomFloat() {
+        // The upper 24 bits fill the float mantissa exactly.
+        return float(Next() >> 8) * (1.0f / 16777216.0f);
+    }
+
+};
+
+inline void FastRandom::SetSeed(uint64_t Seed) {
+    // splitmix64 spreads any seed, including 0, over the whole state.
+    for (int i = 0; i < 4; i += 2) {
+        Seed += 0x9E3779B97F4A7C15ull;
+        uint64_t z = Seed;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        z = z ^ (z >> 31);
+        State_[i] = uint32_t(z);
+        State_[i + 1] = uint32_t(z >> 32);
+    }
+}
+
+}; // namespace Distributions
+}; // namespace Simulator
+}; // namespace NES
+}; // namespace BG
@@ -0,0 +1,55 @@
+//=================================================================//
+// This file is part of the BrainGenix-NES Neuron Emulation System //
+//=================================================================//
+
+/*
+    Description: This file provides unit tests for the FastRandom generator.
+    Additional Notes: None
+    Date Created: 2026-10-17
+*/
+
+#include <gtest/gtest.h>
+
+#include <Simulator/Distributions/FastRandom.h>
+
+/**
+ * @brief Test class for unit tests for the FastRandom generator.
+ *
+ */
+
+struct FastRandomTest : testing::Test {
+    size_t numSamples = 100000;
+
+    void SetUp() {}
+
+    void TearDown() { return; }
+};
+
+TEST_F(FastRandomTest, test_UniformRandomFloat_range_and_mean) {
+    BG::NES::Simulator::Distributions::FastRandom gen(1);
+    double sum = 0.0;
+    for (size_t i = 0; i < numSamples; ++i) {
+        float x = gen.UniformRandomFloat();
+        ASSERT_GE(x, 0.0f);
+        ASSERT_LT(x, 1.0f);
+        sum += x;
+    }
+    ASSERT_NEAR(sum / numSamples, 0.5, 0.01);
+}
+
+TEST_F(FastRandomTest, test_SetSeed_reproducible) {
+    BG::NES::Simulator::Distributions::FastRandom genA(42), genB(42), genC(43);
+    bool differs = false;
+    for (size_t i = 0; i < 100; ++i) {
+        uint32_t a = genA.Next();
+        ASSERT_EQ(a, genB.Next());
+        differs |= (a != genC.Next());
+    }
+    ASSERT_TRUE(differs);
+
+    // Seed 0 is valid and restarting gives the same sequence.
+    genA.SetSeed(0);
+    uint32_t first = genA.Next();
+    genA.SetSeed(0);
+    ASSERT_EQ(genA.Next(), first);
+}
@@ -1,5 +1,7 @@
 #include <Simulator/Distributions/Generic.h>
 
+#include <sstream>
+
 
 
 namespace BG {
@@ -26,6 +28,18 @@ float Generic::NormalRandomFloat() {
     return NormalDistFloat_(Gen_);
 }
 
+std::string Generic::GetState() const {
+    std::stringstream State;
+    State << Gen_ << ' ' << UniformDistInt_ << ' ' << UniformDistFloat_ << ' ' << NormalDistFloat_;
+    return State.str();
+}
+
+bool Generic::SetState(const std::string& _State) {
+    std::stringstream State(_State);
+    State >> Gen_ >> UniformDistInt_ >> UniformDistFloat_ >> NormalDistFloat_;
+    return !State.fail();
+}
+
 }; // namespace Distributions
 }; // namespace Simulator
 }; // namespace NES
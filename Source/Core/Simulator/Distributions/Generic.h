@@ -16,6 +16,7 @@
 #include <cmath>
 
 #include <random>
+#include <string>
 
 namespace BG {
 namespace NES {
@@ -64,6 +65,13 @@ class Generic {
      */
     float NormalRandomFloat();
 
+    /**
+     * @brief Generator and distribution state as text, used by simulation
+     * checkpoints to continue the sequence exactly.
+     */
+    std::string GetState() const;
+    bool SetState(const std::string& _State);
+
 };
 
 }; // namespace Distributions
@@ -1,6 +1,7 @@
 #include <Simulator/Distributions/TruncNorm.h>
 
 #include <iostream>
+#include <sstream>
 
 namespace BG {
 namespace NES {
@@ -61,12 +62,12 @@ TruncNorm::TruncNorm(float _a, float _b, float _loc, float _scale) {
 
 //! Generates a random sample from the distribution of size numSamples.
 std::vector<float> TruncNorm::RandomSample(size_t numSamples) {
-    // Standard normal distribution
-    static std::normal_distribution<float> _stdNormalDist; // Note this is static! Created only once, initialized only on first call.
+    // Per instance, so that the sequence only depends on this distribution's
+    // own generator and can be checkpointed with it.
     std::vector<float> randomSample;
 
     while (randomSample.size() < numSamples) {
-        float val = this->loc + _stdNormalDist(this->_Gen) * this->scale;
+        float val = this->loc + this->_StdNormalDist(this->_Gen) * this->scale;
         if (val < this->a || val > this->b)
             continue;
         randomSample.emplace_back(val);
@@ -75,6 +76,18 @@ std::vector<float> TruncNorm::RandomSample(size_t numSamples) {
     return randomSample;
 };
 
+std::string TruncNorm::GetState() const {
+    std::stringstream State;
+    State << this->_Gen << ' ' << this->_StdNormalDist;
+    return State.str();
+}
+
+bool TruncNorm::SetState(const std::string& _State) {
+    std::stringstream State(_State);
+    State >> this->_Gen >> this->_StdNormalDist;
+    return !State.fail();
+}
+
 //! Probability distribution function
 std::vector<float> TruncNorm::PDF(std::vector<float> x) {
     std::vector<float> pdf;
@@ -26,6 +26,9 @@ namespace Distributions {
  *
  */
 class TruncNorm : public Distribution {
+  protected:
+    std::normal_distribution<float> _StdNormalDist; //! Standard normal distribution, caches every second sample.
+
   public:
     float a; //! Lower bound of the distribution.
     float b; //! Upper bound of the distribution.
@@ -37,6 +40,9 @@ class TruncNorm : public Distribution {
     //! Generates a random sample from the distribution of size numSamples.
     std::vector<float> RandomSample(size_t numSamples);
 
+    std::string GetState() const;
+    bool SetState(const std::string& _State);
+
     //! Probability distribution function
     std::vector<float> PDF(std::vector<float> x);
     float PDF(float x);
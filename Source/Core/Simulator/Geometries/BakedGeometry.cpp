@@ -0,0 +1,94 @@
+#include <Simulator/Geometries/BakedGeometry.h>
+
+#include <algorithm>
+#include <cmath>
+
+
+namespace BG {
+namespace NES {
+namespace Simulator {
+namespace Geometries {
+
+static Vec3D RotateToWorld(const Vec3D& _Vec, const VSDA::WorldInfo& _WorldInfo) {
+    return _Vec.rotate_around_xyz(_WorldInfo.WorldRotationOffsetX_rad, _WorldInfo.WorldRotationOffsetY_rad, _WorldInfo.WorldRotationOffsetZ_rad);
+}
+
+BakedSphere BakeSphere(const SphereBase& _Sphere, const VSDA::WorldInfo& _WorldInfo) {
+    BakedSphere Baked;
+    Baked.Center_um = RotateToWorld(_Sphere.Center_um, _WorldInfo);
+    Baked.Radius_um = _Sphere.Radius_um;
+
+    const float Center[3] = { Baked.Center_um.x, Baked.Center_um.y, Baked.Center_um.z };
+    for (int Axis = 0; Axis < 3; Axis++) {
+        Baked.BB.bb_point1[Axis] = Center[Axis] - Baked.Radius_um;
+        Baked.BB.bb_point2[Axis] = Center[Axis] + Baked.Radius_um;
+    }
+    return Baked;
+}
+
+BakedCylinder BakeCylinder(const CylinderBase& _Cylinder, const VSDA::WorldInfo& _WorldInfo) {
+    BakedCylinder Baked;
+    Baked.End0_um = RotateToWorld(_Cylinder.End0Pos_um, _WorldInfo);
+    Baked.End1_um = RotateToWorld(_Cylinder.End1Pos_um, _WorldInfo);
+    Baked.End0Radius_um = _Cylinder.End0Radius_um;
+    Baked.End1Radius_um = _Cylinder.End1Radius_um;
+
+    // The same angles the rasterizer used to find for every voxel: rotating
+    // around Y by theta and then around Z by phi turns the Z axis onto the
+    // cylinder axis. A zero-length cylinder keeps the unrotated frame.
+    Vec3D Spherical = (Baked.End1_um - Baked.End0_um).cartesianToSpherical();
+    float RotY_rad = Spherical.theta();
+    float RotZ_rad = Spherical.phi();
+    Baked.Length_um = Spherical.r();
+    Baked.Midpoint_um = Baked.End0_um + Vec3D(Baked.Length_um / 2.0, RotY_rad, RotZ_rad).sphericalToCartesian();
+    Baked.AxisFrame[0] = Vec3D(1.0, 0.0, 0.0).rotate_around_y(RotY_rad).rotate_around_z(RotZ_rad);
+    Baked.AxisFrame[1] = Vec3D(0.0, 1.0, 0.0).rotate_around_y(RotY_rad).rotate_around_z(RotZ_rad);
+    Baked.AxisFrame[2] = Vec3D(0.0, 0.0, 1.0).rotate_around_y(RotY_rad).rotate_around_z(RotZ_rad);
+
+    const float End0[3] = { Baked.End0_um.x, Baked.End0_um.y, Baked.End0_um.z };
+    const float End1[3] = { Baked.End1_um.x, Baked.End1_um.y, Baked.End1_um.z };
+    for (int Axis = 0; Axis < 3; Axis++) {
+        Baked.BB.bb_point1[Axis] = std::min(End0[Axis] - Baked.End0Radius_um, End1[Axis] - Baked.End1Radius_um);
+        Baked.BB.bb_point2[Axis] = std::max(End0[Axis] + Baked.End0Radius_um, End1[Axis] + Baked.End1Radius_um);
+    }
+    return Baked;
+}
+
+BakedBox BakeBox(const BoxBase& _Box, const VSDA::WorldInfo& _WorldInfo) {
+    BakedBox Baked;
+    Baked.Center_um = RotateToWorld(_Box.Center_um, _WorldInfo);
+    Baked.HalfDims_um = _Box.Dims_um / 2.0;
+
+    // Both rotations are about the origin, so a point of the box is the
+    // rotated center plus the rotated local offset.
+    const Vec3D Units[3] = { Vec3D(1.0, 0.0, 0.0), Vec3D(0.0, 1.0, 0.0), Vec3D(0.0, 0.0, 1.0) };
+    for (int Axis = 0; Axis < 3; Axis++) {
+        Baked.Axes[Axis] = RotateToWorld(Units[Axis].rotate_around_xyz(_Box.Rotations_rad.x, _Box.Rotations_rad.y, _Box.Rotations_rad.z), _WorldInfo);
+    }
+
+    // Extent along each world axis of the rotated box.
+    const float Center[3] = { Baked.Center_um.x, Baked.Center_um.y, Baked.Center_um.z };
+    const float Half[3] = { Baked.HalfDims_um.x, Baked.HalfDims_um.y, Baked.HalfDims_um.z };
+    for (int Axis = 0; Axis < 3; Axis++) {
+        float Extent_um = 0.0;
+        for (int BoxAxis = 0; BoxAxis < 3; BoxAxis++) {
+            const Vec3D& A = Baked.Axes[BoxAxis];
+            const float Component[3] = { A.x, A.y, A.z };
+            Extent_um += std::fabs(Component[Axis]) * std::fabs(Half[BoxAxis]);
+        }
+        Baked.BB.bb_point1[Axis] = Center[Axis] - Extent_um;
+        Baked.BB.bb_point2[Axis] = Center[Axis] + Extent_um;
+    }
+    return Baked;
+}
+
+bool BakedGeometry::IsFor(const VSDA::WorldInfo& _WorldInfo) const {
+    return (Rotation_rad[0] == _WorldInfo.WorldRotationOffsetX_rad)
+        && (Rotation_rad[1] == _WorldInfo.WorldRotationOffsetY_rad)
+        && (Rotation_rad[2] == _WorldInfo.WorldRotationOffsetZ_rad);
+}
+
+}; // namespace Geometries
+}; // namespace Simulator
+}; // namespace NES
+}; // namespace BG
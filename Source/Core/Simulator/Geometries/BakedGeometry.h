@@ -0,0 +1,95 @@
+//=================================================================//
+// This file is part of the BrainGenix-NES Neuron Emulation System //
+//=================================================================//
+
+/*
+    Description: This file provides world-space records of geometries, baked once per world rotation.
+    Additional Notes: None
+    Date Created: 2026-10-17
+*/
+
+#pragma once
+
+// Standard Libraries (BG convention: use <> instead of "")
+#include <variant>
+#include <vector>
+
+// Internal Libraries (BG convention: use <> instead of "")
+#include <Simulator/Geometries/Box.h>
+#include <Simulator/Geometries/Cylinder.h>
+#include <Simulator/Geometries/Sphere.h>
+#include <Simulator/Geometries/VecTools.h>
+#include <Simulator/Structs/BoundingBox.h>
+
+#include <VSDA/Common/Structs/WorldInfo.h>
+
+
+namespace BG {
+namespace NES {
+namespace Simulator {
+namespace Geometries {
+
+/**
+ * @brief Sphere in world space, with the world rotation already applied to its center.
+ */
+struct BakedSphere {
+    Vec3D Center_um;
+    float Radius_um = 0.0;
+    BoundingBox BB; /**Same as SphereBase::GetBoundingBox()*/
+};
+
+/**
+ * @brief Cylinder in world space. Besides the rotated ends, it holds the
+ * frame that the rasterizer places its discs in: Midpoint_um is the middle
+ * of the axis and AxisFrame[2] points along it from end 0 to end 1, so that
+ * the local point (x, y, z) is at Midpoint_um + x*AxisFrame[0] + y*AxisFrame[1] + z*AxisFrame[2].
+ */
+struct BakedCylinder {
+    Vec3D End0_um;
+    Vec3D End1_um;
+    float End0Radius_um = 0.0;
+    float End1Radius_um = 0.0;
+    float Length_um = 0.0;
+    Vec3D Midpoint_um;
+    Vec3D AxisFrame[3];
+    BoundingBox BB; /**Same as CylinderBase::GetBoundingBox()*/
+};
+
+/**
+ * @brief Box in world space, with its own and the world rotation combined:
+ * the local point (x, y, z) relative to the center is at
+ * Center_um + x*Axes[0] + y*Axes[1] + z*Axes[2].
+ */
+struct BakedBox {
+    Vec3D Center_um;
+    Vec3D HalfDims_um;
+    Vec3D Axes[3];
+    BoundingBox BB; /**Tight box around the rotated box*/
+};
+
+BakedSphere BakeSphere(const SphereBase& _Sphere, const VSDA::WorldInfo& _WorldInfo);
+BakedCylinder BakeCylinder(const CylinderBase& _Cylinder, const VSDA::WorldInfo& _WorldInfo);
+BakedBox BakeBox(const BoxBase& _Box, const VSDA::WorldInfo& _WorldInfo);
+
+/**
+ * @brief World-space records of all shapes of a GeometryCollection for one
+ * world rotation, indexed by shape ID. Only geometry is baked, ParentID and
+ * other attributes that change after a shape was added are read from the
+ * shapes themselves.
+ */
+struct BakedGeometry {
+    float Rotation_rad[3] = {0.0, 0.0, 0.0}; /**World rotation X, Y, Z the records were baked for*/
+    std::vector<std::variant<BakedSphere, BakedCylinder, BakedBox>> Shapes; /**Same order as GeometryCollection::Geometries*/
+
+    bool IsFor(const VSDA::WorldInfo& _WorldInfo) const;
+
+    size_t Size() const { return Shapes.size(); }
+    const BakedSphere& GetSphere(size_t idx) const { return std::get<BakedSphere>(Shapes.at(idx)); }
+    const BakedCylinder& GetCylinder(size_t idx) const { return std::get<BakedCylinder>(Shapes.at(idx)); }
+    const BakedBox& GetBox(size_t idx) const { return std::get<BakedBox>(Shapes.at(idx)); }
+};
+
+}; // namespace Geometries
+}; // namespace Simulator
+}; // namespace NES
+}; // namespace BG
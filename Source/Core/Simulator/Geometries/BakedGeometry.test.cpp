@@ -0,0 +1,122 @@
+//=================================================================//
+// This file is part of the BrainGenix-NES Neuron Emulation System //
+//=================================================================//
+
+/*
+    Description: This file provides unit tests for the baked world-space geometry of GeometryCollection.
+    Additional Notes: None
+    Date Created: 2026-10-17
+*/
+
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include <Simulator/Geometries/BakedGeometry.h>
+#include <Simulator/Geometries/GeometryCollection.h>
+
+
+/**
+ * @brief Test class for the baked geometry. Compares the records with the
+ * world rotation applied per point, as the rasterizers used to do.
+ */
+
+struct BakedGeometryTest : testing::Test {
+    std::mt19937 Generator{4321};
+    BG::NES::VSDA::WorldInfo Info;
+
+    void SetUp() {
+        Info.VoxelScale_um = 0.1;
+        Info.WorldRotationOffsetX_rad = 0.3;
+        Info.WorldRotationOffsetY_rad = -1.1;
+        Info.WorldRotationOffsetZ_rad = 2.0;
+    }
+
+    BG::NES::Simulator::Geometries::Vec3D RandomPoint(float _Extent_um) {
+        std::uniform_real_distribution<float> Position(-_Extent_um, _Extent_um);
+        return BG::NES::Simulator::Geometries::Vec3D(Position(Generator), Position(Generator), Position(Generator));
+    }
+
+    BG::NES::Simulator::Geometries::Vec3D ToWorld(const BG::NES::Simulator::Geometries::Vec3D& _Point) {
+        return _Point.rotate_around_xyz(Info.WorldRotationOffsetX_rad, Info.WorldRotationOffsetY_rad, Info.WorldRotationOffsetZ_rad);
+    }
+
+    void ExpectNear(const BG::NES::Simulator::Geometries::Vec3D& _A, const BG::NES::Simulator::Geometries::Vec3D& _B) {
+        EXPECT_NEAR(_A.x, _B.x, 1e-3);
+        EXPECT_NEAR(_A.y, _B.y, 1e-3);
+        EXPECT_NEAR(_A.z, _B.z, 1e-3);
+    }
+
+    void ExpectSameBox(const BG::NES::Simulator::BoundingBox& _A, const BG::NES::Simulator::BoundingBox& _B) {
+        for (int Axis = 0; Axis < 3; Axis++) {
+            EXPECT_NEAR(_A.bb_point1[Axis], _B.bb_point1[Axis], 1e-3);
+            EXPECT_NEAR(_A.bb_point2[Axis], _B.bb_point2[Axis], 1e-3);
+        }
+    }
+};
+
+TEST_F(BakedGeometryTest, test_Records_match_per_point_rotation) {
+    using namespace BG::NES::Simulator::Geometries;
+
+    for (int i = 0; i < 50; i++) {
+        Sphere S(RandomPoint(100.0), 3.0);
+        BakedSphere BS = BakeSphere(S, Info);
+        ExpectNear(BS.Center_um, ToWorld(S.Center_um));
+        ExpectSameBox(BS.BB, S.GetBoundingBox(Info));
+
+        Cylinder C(2.0, RandomPoint(100.0), 1.0, RandomPoint(100.0));
+        BakedCylinder BC = BakeCylinder(C, Info);
+        ExpectSameBox(BC.BB, C.GetBoundingBox(Info));
+        EXPECT_NEAR(BC.Length_um, C.End0Pos_um.Distance(C.End1Pos_um), 1e-3);
+
+        // The frame puts the ends on the axis, and the disc axes across it.
+        ExpectNear(BC.Midpoint_um + BC.AxisFrame[2] * (-0.5f * BC.Length_um), ToWorld(C.End0Pos_um));
+        ExpectNear(BC.Midpoint_um + BC.AxisFrame[2] * (0.5f * BC.Length_um), ToWorld(C.End1Pos_um));
+        EXPECT_NEAR(BC.AxisFrame[0].Dot(BC.AxisFrame[2]), 0.0, 1e-5);
+        EXPECT_NEAR(BC.AxisFrame[1].Dot(BC.AxisFrame[2]), 0.0, 1e-5);
+        EXPECT_NEAR(BC.AxisFrame[0].Dot(BC.AxisFrame[1]), 0.0, 1e-5);
+
+        Box B(RandomPoint(100.0), Vec3D(1.0, 2.0, 4.0), RandomPoint(3.0));
+        BakedBox BB = BakeBox(B, Info);
+        Vec3D Local(0.5, -1.0, 2.0);
+        Vec3D Expected = ToWorld(B.Center_um + Local.rotate_around_xyz(B.Rotations_rad.x, B.Rotations_rad.y, B.Rotations_rad.z));
+        ExpectNear(BB.Center_um + BB.Axes[0] * Local.x + BB.Axes[1] * Local.y + BB.Axes[2] * Local.z, Expected);
+        EXPECT_TRUE(BB.BB.IsIntersecting(B.GetConservativeBoundingBox(Info)));
+        for (int Axis = 0; Axis < 3; Axis++) {
+            EXPECT_LE(BB.BB.bb_point2[Axis] - BB.BB.bb_point1[Axis], 2.0 * 4.6);
+        }
+    }
+}
+
+TEST_F(BakedGeometryTest, test_GeometryCollection_bakes_once) {
+    using namespace BG::NES::Simulator::Geometries;
+    GeometryCollection Collection;
+    Collection.AddSphere(RandomPoint(10.0), 1.0);
+    Collection.AddCylinder(1.0, RandomPoint(10.0), 0.5, RandomPoint(10.0));
+    Collection.AddBox(RandomPoint(10.0), Vec3D(1.0, 1.0, 1.0));
+
+    std::shared_ptr<const BakedGeometry> First = Collection.GetBaked(Info);
+    ASSERT_EQ(First->Size(), 3);
+    EXPECT_EQ(Collection.GetBaked(Info), First);
+
+    // Appended shapes extend a copy, the records held so far stay valid.
+    Collection.AddSphere(RandomPoint(10.0), 2.0);
+    std::shared_ptr<const BakedGeometry> Extended = Collection.GetBaked(Info);
+    ASSERT_EQ(First->Size(), 3);
+    ASSERT_EQ(Extended->Size(), 4);
+    ExpectNear(Extended->GetSphere(3).Center_um, ToWorld(Collection.GetSphere(3).Center_um));
+    ExpectNear(Extended->GetCylinder(1).End0_um, First->GetCylinder(1).End0_um);
+
+    // Another rotation, or shapes changed in place, bake the records again.
+    Info.WorldRotationOffsetY_rad = 0.4;
+    std::shared_ptr<const BakedGeometry> Rotated = Collection.GetBaked(Info);
+    EXPECT_TRUE(Rotated->IsFor(Info));
+    ExpectNear(Rotated->GetBox(2).Center_um, ToWorld(Collection.GetBox(2).Center_um));
+
+    Collection.GetSphere(0).Center_um = Vec3D(1.0, 2.0, 3.0);
+    Collection.InvalidateIndex();
+    ExpectNear(Collection.GetBaked(Info)->GetSphere(0).Center_um, ToWorld(Vec3D(1.0, 2.0, 3.0)));
+
+    Collection.Clear();
+    EXPECT_EQ(Collection.GetBaked(Info)->Size(), 0);
+}
@@ -43,6 +43,9 @@ struct BoxBase: Geometry {
     virtual BoundingBox GetBoundingBox(VSDA::WorldInfo& _WorldInfo);
     virtual bool IsPointInShape(Vec3D _Position_um, VSDA::WorldInfo& _WorldInfo); // not used - bad don't use this it does not do rotation or work at all!!!
     virtual bool IsInsideRegion(BoundingBox _Region, VSDA::WorldInfo& _WorldInfo);
+
+    //! Box used by IsInsideRegion(), large enough for any rotation of the box.
+    BoundingBox GetConservativeBoundingBox(VSDA::WorldInfo& _WorldInfo);
 };
 
 /**
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <iostream>
 
 #include <Simulator/Geometries/Cylinder.h>
@@ -109,11 +110,19 @@ Vec3D Cylinder::GetRotation_rad() const {
 
 
 
-// I have no clude what I'm doing
+//! Box around both rotated ends, each extended by its own radius.
 BoundingBox CylinderBase::GetBoundingBox(VSDA::WorldInfo& _WorldInfo) {
-	BoundingBox bb;
+    // Rotate the cylinder's endpoints based on the world rotation offsets
+    Geometries::Vec3D End0Rot = End0Pos_um.rotate_around_xyz(_WorldInfo.WorldRotationOffsetX_rad, _WorldInfo.WorldRotationOffsetY_rad, _WorldInfo.WorldRotationOffsetZ_rad);
+    Geometries::Vec3D End1Rot = End1Pos_um.rotate_around_xyz(_WorldInfo.WorldRotationOffsetX_rad, _WorldInfo.WorldRotationOffsetY_rad, _WorldInfo.WorldRotationOffsetZ_rad);
 
-    bb.Singularity(); // !!!
+    BoundingBox bb;
+    bb.bb_point1[0] = std::min(End0Rot.x - End0Radius_um, End1Rot.x - End1Radius_um);
+    bb.bb_point1[1] = std::min(End0Rot.y - End0Radius_um, End1Rot.y - End1Radius_um);
+    bb.bb_point1[2] = std::min(End0Rot.z - End0Radius_um, End1Rot.z - End1Radius_um);
+    bb.bb_point2[0] = std::max(End0Rot.x + End0Radius_um, End1Rot.x + End1Radius_um);
+    bb.bb_point2[1] = std::max(End0Rot.y + End0Radius_um, End1Rot.y + End1Radius_um);
+    bb.bb_point2[2] = std::max(End0Rot.z + End0Radius_um, End1Rot.z + End1Radius_um);
 
 	return bb;
 }
@@ -329,30 +338,8 @@ bool CylinderBase::IsPointInShape(Vec3D _Position_um, VSDA::WorldInfo& _WorldInf
 
 
 bool CylinderBase::IsInsideRegion(BoundingBox _Region, VSDA::WorldInfo& _WorldInfo) {
-    // Rotate the cylinder's endpoints based on the world rotation offsets
-    Geometries::Vec3D End0Rot = End0Pos_um.rotate_around_xyz(_WorldInfo.WorldRotationOffsetX_rad, _WorldInfo.WorldRotationOffsetY_rad, _WorldInfo.WorldRotationOffsetZ_rad);
-    Geometries::Vec3D End1Rot = End1Pos_um.rotate_around_xyz(_WorldInfo.WorldRotationOffsetX_rad, _WorldInfo.WorldRotationOffsetY_rad, _WorldInfo.WorldRotationOffsetZ_rad);
-
-    // Calculate the minimum and maximum coordinates for the bounding box
-    double minX = std::min(End0Rot.x - End0Radius_um, End1Rot.x - End1Radius_um);
-    double minY = std::min(End0Rot.y - End0Radius_um, End1Rot.y - End1Radius_um);
-    double minZ = std::min(End0Rot.z - End0Radius_um, End1Rot.z - End1Radius_um);
-
-    double maxX = std::max(End0Rot.x + End0Radius_um, End1Rot.x + End1Radius_um);
-    double maxY = std::max(End0Rot.y + End0Radius_um, End1Rot.y + End1Radius_um);
-    double maxZ = std::max(End0Rot.z + End1Radius_um, End1Rot.z + End1Radius_um);
-
-    // Construct the bounding box for the cylinder
-    BoundingBox MyBB;
-    MyBB.bb_point1[0] = minX;
-    MyBB.bb_point1[1] = minY;
-    MyBB.bb_point1[2] = minZ;
-    MyBB.bb_point2[0] = maxX;
-    MyBB.bb_point2[1] = maxY;
-    MyBB.bb_point2[2] = maxZ;
-
     // Check if the cylinder's bounding box intersects with the given region
-    return MyBB.IsIntersecting(_Region);
+    return GetBoundingBox(_WorldInfo).IsIntersecting(_Region);
 }
 
 
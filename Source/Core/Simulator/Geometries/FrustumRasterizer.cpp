@@ -0,0 +1,213 @@
+#include <Simulator/Geometries/FrustumRasterizer.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+
+namespace BG {
+namespace NES {
+namespace Simulator {
+namespace Geometries {
+
+/**
+ * @brief The frustum in double precision: points at distance t along the
+ * unit axis from End0, 0 <= t <= Length, lie within Radius0 + Slope*t of it.
+ */
+struct Frustum {
+    double End0[3];
+    double Axis[3];
+    double Length = 0.0;
+    double Radius0 = 0.0;
+    double Slope = 0.0;
+};
+
+static Frustum MakeFrustum(const BakedCylinder& _Cylinder) {
+    Frustum F;
+    const double Diff[3] = { double(_Cylinder.End1_um.x) - _Cylinder.End0_um.x, double(_Cylinder.End1_um.y) - _Cylinder.End0_um.y, double(_Cylinder.End1_um.z) - _Cylinder.End0_um.z };
+    F.End0[0] = _Cylinder.End0_um.x;
+    F.End0[1] = _Cylinder.End0_um.y;
+    F.End0[2] = _Cylinder.End0_um.z;
+    F.Length = std::sqrt(Diff[0]*Diff[0] + Diff[1]*Diff[1] + Diff[2]*Diff[2]);
+    F.Radius0 = _Cylinder.End0Radius_um;
+    if (F.Length > 0.0) {
+        for (int Axis = 0; Axis < 3; Axis++) {
+            F.Axis[Axis] = Diff[Axis] / F.Length;
+        }
+        F.Slope = (double(_Cylinder.End1Radius_um) - _Cylinder.End0Radius_um) / F.Length;
+    } else {
+        F.Axis[0] = F.Axis[1] = F.Axis[2] = 0.0;
+    }
+    return F;
+}
+
+static bool Contains(const Frustum& _F, double _X, double _Y, double _Z) {
+    const double V[3] = { _X - _F.End0[0], _Y - _F.End0[1], _Z - _F.End0[2] };
+    double T = V[0]*_F.Axis[0] + V[1]*_F.Axis[1] + V[2]*_F.Axis[2];
+    if ((_F.Length <= 0.0) || (T < 0.0) || (T > _F.Length)) {
+        return false;
+    }
+    double DistanceToAxis2 = V[0]*V[0] + V[1]*V[1] + V[2]*V[2] - T*T;
+    double Radius = _F.Radius0 + _F.Slope * T;
+    return DistanceToAxis2 <= Radius * Radius;
+}
+
+bool IsPointInFrustum(const BakedCylinder& _Cylinder, const Vec3D& _Point_um) {
+    return Contains(MakeFrustum(_Cylinder), _Point_um.x, _Point_um.y, _Point_um.z);
+}
+
+float GetFrustumDistanceToEdge(const BakedCylinder& _Cylinder, const Vec3D& _Point_um) {
+    Frustum F = MakeFrustum(_Cylinder);
+    const double V[3] = { _Point_um.x - F.End0[0], _Point_um.y - F.End0[1], _Point_um.z - F.End0[2] };
+    double T = std::clamp(V[0]*F.Axis[0] + V[1]*F.Axis[1] + V[2]*F.Axis[2], 0.0, F.Length);
+    double DistanceToAxis2 = V[0]*V[0] + V[1]*V[1] + V[2]*V[2] - T*T;
+    return float(F.Radius0 + F.Slope * T - std::sqrt(std::max(0.0, DistanceToAxis2)));
+}
+
+//! Interval of world z along the row (_X, _Y, z) inside the frustum, false if there is none.
+static bool SolveRow(const Frustum& _F, double _X, double _Y, double& _ZLo, double& _ZHi) {
+    const double Inf = std::numeric_limits<double>::infinity();
+    const double W[3] = { _X - _F.End0[0], _Y - _F.End0[1], -_F.End0[2] };
+    const double AxisZ = _F.Axis[2];
+
+    // Along the row, t(z) = T0 + z*AxisZ, and both caps bound z.
+    double T0 = W[0]*_F.Axis[0] + W[1]*_F.Axis[1] + W[2]*AxisZ;
+    double SlabLo = -Inf, SlabHi = Inf;
+    if (std::fabs(AxisZ) > 1e-12) {
+        SlabLo = (0.0 - T0) / AxisZ;
+        SlabHi = (_F.Length - T0) / AxisZ;
+        if (SlabLo > SlabHi) {
+            std::swap(SlabLo, SlabHi);
+        }
+    } else if ((T0 < 0.0) || (T0 > _F.Length)) {
+        return false;
+    }
+
+    // Squared distance from the axis minus squared radius, A*z^2 + 2*B*z + C <= 0.
+    double RadiusT0 = _F.Radius0 + _F.Slope * T0;
+    double A = 1.0 - AxisZ*AxisZ * (1.0 + _F.Slope*_F.Slope);
+    double B = W[2] - T0*AxisZ - RadiusT0*_F.Slope*AxisZ;
+    double C = W[0]*W[0] + W[1]*W[1] + W[2]*W[2] - T0*T0 - RadiusT0*RadiusT0;
+
+    // Up to two pieces, as the row can run inside the cone's opening; at
+    // most one of them reaches between the caps.
+    double PieceLo[2] = { -Inf, Inf }, PieceHi[2] = { Inf, -Inf };
+    if (std::fabs(A) < 1e-12) {
+        if (std::fabs(B) < 1e-12) {
+            if (C > 0.0) {
+                return false;
+            }
+        } else if (B > 0.0) {
+            PieceHi[0] = -C / (2.0 * B);
+        } else {
+            PieceLo[0] = -C / (2.0 * B);
+        }
+    } else {
+        double Discriminant = B*B - A*C;
+        if (Discriminant < 0.0) {
+            if (A > 0.0) {
+                return false;
+            }
+        } else {
+            double Root0 = (-B - std::sqrt(Discriminant)) / A;
+            double Root1 = (-B + std::sqrt(Discriminant)) / A;
+            if (Root0 > Root1) {
+                std::swap(Root0, Root1);
+            }
+            if (A > 0.0) {
+                PieceLo[0] = Root0;
+                PieceHi[0] = Root1;
+            } else {
+                PieceHi[0] = Root0;
+                PieceLo[1] = Root1;
+                PieceHi[1] = Inf;
+            }
+        }
+    }
+
+    _ZLo = Inf;
+    _ZHi = -Inf;
+    for (int Piece = 0; Piece < 2; Piece++) {
+        double Lo = std::max(PieceLo[Piece], SlabLo);
+        double Hi = std::min(PieceHi[Piece], SlabHi);
+        if (Lo <= Hi) {
+            _ZLo = std::min(_ZLo, Lo);
+            _ZHi = std::max(_ZHi, Hi);
+        }
+    }
+    return _ZLo <= _ZHi;
+}
+
+void RasterizeFrustum(const BakedCylinder& _Cylinder, const VoxelGrid& _Grid, int _TotalThreads, int _ThisThread, const VoxelRunFunction& _Run) {
+    Frustum F = MakeFrustum(_Cylinder);
+    if ((F.Length <= 0.0) || (_Grid.VoxelScale_um <= 0.0)) {
+        return;
+    }
+    const double Scale = _Grid.VoxelScale_um;
+    const double Origin[3] = { _Grid.Origin_um.x, _Grid.Origin_um.y, _Grid.Origin_um.z };
+
+    // Rows through the bounding box, one voxel of margin against rounding.
+    int First[3], Last[3];
+    for (int Axis = 0; Axis < 3; Axis++) {
+        double Lo = std::floor((_Cylinder.BB.bb_point1[Axis] - Origin[Axis]) / Scale) - 1.0;
+        double Hi = std::ceil((_Cylinder.BB.bb_point2[Axis] - Origin[Axis]) / Scale) + 1.0;
+        First[Axis] = int(std::max(Lo, 0.0));
+        Last[Axis] = int(std::min(Hi, double(_Grid.Size[Axis] - 1)));
+    }
+
+    size_t Row = 0;
+    for (int X = First[0]; X <= Last[0]; X++) {
+        double XPos = Origin[0] + X * Scale;
+        for (int Y = First[1]; Y <= Last[1]; Y++) {
+            if (int(Row++ % _TotalThreads) != _ThisThread) {
+                continue;
+            }
+            double YPos = Origin[1] + Y * Scale;
+            double ZLo, ZHi;
+            if (!SolveRow(F, XPos, YPos, ZLo, ZHi)) {
+                continue;
+            }
+
+            auto IsInside = [&](int _Z) {
+                return (_Z >= 0) && (_Z < _Grid.Size[2]) && Contains(F, XPos, YPos, Origin[2] + _Z * Scale);
+            };
+
+            // Voxels within the interval, or the two around it if it falls between voxels.
+            double Lo = std::clamp(std::ceil((ZLo - Origin[2]) / Scale), double(First[2]) - 1.0, double(Last[2]) + 1.0);
+            double Hi = std::clamp(std::floor((ZHi - Origin[2]) / Scale), double(First[2]) - 1.0, double(Last[2]) + 1.0);
+            int Begin = int(Lo), End = int(Hi);
+            if (Begin > End) {
+                if (IsInside(End)) {
+                    Begin = End;
+                } else if (IsInside(Begin)) {
+                    End = Begin;
+                } else {
+                    continue;
+                }
+            }
+
+            // Settle the ends against the point test.
+            while ((Begin <= End) && !IsInside(Begin)) {
+                Begin++;
+            }
+            while ((End >= Begin) && !IsInside(End)) {
+                End--;
+            }
+            if (Begin > End) {
+                continue;
+            }
+            while (IsInside(Begin - 1)) {
+                Begin--;
+            }
+            while (IsInside(End + 1)) {
+                End++;
+            }
+            _Run(X, Y, Begin, End + 1);
+        }
+    }
+}
+
+}; // namespace Geometries
+}; // namespace Simulator
+}; // namespace NES
+}; // namespace BG
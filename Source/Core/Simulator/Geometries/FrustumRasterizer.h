@@ -0,0 +1,60 @@
+//=================================================================//
+// This file is part of the BrainGenix-NES Neuron Emulation System //
+//=================================================================//
+
+/*
+    Description: This file provides the exact scanline rasterizer of capped cone frustums (tapered cylinders).
+    Additional Notes: None
+    Date Created: 2026-10-17
+*/
+
+#pragma once
+
+// Standard Libraries (BG convention: use <> instead of "")
+#include <functional>
+
+// Internal Libraries (BG convention: use <> instead of "")
+#include <Simulator/Geometries/BakedGeometry.h>
+#include <Simulator/Geometries/VecTools.h>
+
+
+namespace BG {
+namespace NES {
+namespace Simulator {
+namespace Geometries {
+
+/**
+ * @brief Regular grid of voxel centers, the voxel at index (x, y, z) is at
+ * Origin_um + (x, y, z) * VoxelScale_um.
+ */
+struct VoxelGrid {
+    Vec3D Origin_um;           /**Position of the voxel at index (0, 0, 0)*/
+    float VoxelScale_um = 1.0; /**Distance between neighbouring voxels*/
+    int Size[3] = {0, 0, 0};   /**Number of voxels along x, y and z*/
+};
+
+//! Called for each run of voxels from (_X, _Y, _ZBegin) up to, not including, (_X, _Y, _ZEnd).
+using VoxelRunFunction = std::function<void(int _X, int _Y, int _ZBegin, int _ZEnd)>;
+
+//! True if the point is inside the capped cone frustum spanned by the ends and radii of the cylinder.
+bool IsPointInFrustum(const BakedCylinder& _Cylinder, const Vec3D& _Point_um);
+
+//! Radius of the frustum at the point's position along the axis, minus the point's distance from the axis.
+float GetFrustumDistanceToEdge(const BakedCylinder& _Cylinder, const Vec3D& _Point_um);
+
+/**
+ * @brief Visits exactly the voxels of _Grid whose centers pass IsPointInFrustum(),
+ * as one run along z per (x, y) row. The interval of each row is solved in
+ * closed form from the quadratic of the cone and the two cap planes, then its
+ * end voxels are checked against IsPointInFrustum() so that rounding cannot
+ * add or drop a voxel.
+ *
+ * Rows are dealt out round-robin, the part _ThisThread of _TotalThreads
+ * only visits its own rows.
+ */
+void RasterizeFrustum(const BakedCylinder& _Cylinder, const VoxelGrid& _Grid, int _TotalThreads, int _ThisThread, const VoxelRunFunction& _Run);
+
+}; // namespace Geometries
+}; // namespace Simulator
+}; // namespace NES
+}; // namespace BG
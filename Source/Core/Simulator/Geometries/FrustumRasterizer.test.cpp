@@ -0,0 +1,108 @@
+//=================================================================//
+// This file is part of the BrainGenix-NES Neuron Emulation System //
+//=================================================================//
+
+/*
+    Description: This file provides unit tests for the scanline cone frustum rasterizer.
+    Additional Notes: None
+    Date Created: 2026-10-17
+*/
+
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <Simulator/Geometries/BakedGeometry.h>
+#include <Simulator/Geometries/FrustumRasterizer.h>
+
+
+/**
+ * @brief Test class for the frustum rasterizer. Compares the runs with a
+ * brute-force voxelizer that tests every voxel center of the grid.
+ */
+
+struct FrustumRasterizerTest : testing::Test {
+    std::mt19937 Generator{2468};
+    BG::NES::Simulator::Geometries::VoxelGrid Grid;
+    BG::NES::VSDA::WorldInfo Info;
+
+    void SetUp() {
+        Grid.Origin_um = BG::NES::Simulator::Geometries::Vec3D(-10.13, -9.87, -10.05);
+        Grid.VoxelScale_um = 0.25;
+        Grid.Size[0] = 80;
+        Grid.Size[1] = 84;
+        Grid.Size[2] = 78;
+    }
+
+    size_t Index(int _X, int _Y, int _Z) {
+        return (size_t(_X) * Grid.Size[1] + _Y) * Grid.Size[2] + _Z;
+    }
+
+    std::vector<char> BruteForce(const BG::NES::Simulator::Geometries::BakedCylinder& _Cylinder) {
+        using BG::NES::Simulator::Geometries::Vec3D;
+        std::vector<char> Inside(size_t(Grid.Size[0]) * Grid.Size[1] * Grid.Size[2], 0);
+        for (int X = 0; X < Grid.Size[0]; X++) {
+            for (int Y = 0; Y < Grid.Size[1]; Y++) {
+                for (int Z = 0; Z < Grid.Size[2]; Z++) {
+                    Vec3D Point = Grid.Origin_um + Vec3D(X, Y, Z) * Grid.VoxelScale_um;
+                    Inside[Index(X, Y, Z)] = BG::NES::Simulator::Geometries::IsPointInFrustum(_Cylinder, Point);
+                }
+            }
+        }
+        return Inside;
+    }
+
+    std::vector<char> Rasterize(const BG::NES::Simulator::Geometries::BakedCylinder& _Cylinder, int _TotalThreads) {
+        std::vector<char> Visits(size_t(Grid.Size[0]) * Grid.Size[1] * Grid.Size[2], 0);
+        for (int Thread = 0; Thread < _TotalThreads; Thread++) {
+            BG::NES::Simulator::Geometries::RasterizeFrustum(_Cylinder, Grid, _TotalThreads, Thread, [&](int _X, int _Y, int _ZBegin, int _ZEnd) {
+                EXPECT_LT(_ZBegin, _ZEnd);
+                for (int Z = _ZBegin; Z < _ZEnd; Z++) {
+                    Visits[Index(_X, _Y, Z)]++;
+                }
+            });
+        }
+        return Visits;
+    }
+
+    void Check(float _End0Radius_um, const BG::NES::Simulator::Geometries::Vec3D& _End0_um, float _End1Radius_um, const BG::NES::Simulator::Geometries::Vec3D& _End1_um) {
+        BG::NES::Simulator::Geometries::Cylinder C(_End0Radius_um, _End0_um, _End1Radius_um, _End1_um);
+        BG::NES::Simulator::Geometries::BakedCylinder Baked = BG::NES::Simulator::Geometries::BakeCylinder(C, Info);
+        std::vector<char> Expected = BruteForce(Baked);
+        ASSERT_EQ(Rasterize(Baked, 1), Expected);
+        ASSERT_EQ(Rasterize(Baked, 3), Expected);
+    }
+};
+
+TEST_F(FrustumRasterizerTest, test_Matches_brute_force) {
+    using BG::NES::Simulator::Geometries::Vec3D;
+    std::uniform_real_distribution<float> Position(-9.0, 9.0);
+    std::uniform_real_distribution<float> Radius(0.05, 3.0);
+    for (int i = 0; i < 40; i++) {
+        Vec3D End0(Position(Generator), Position(Generator), Position(Generator));
+        Vec3D End1(Position(Generator), Position(Generator), Position(Generator));
+        Check(Radius(Generator), End0, Radius(Generator), End1);
+    }
+
+    // Cones, thin dendrites, steep segments and axis-aligned ones, some
+    // reaching past the grid.
+    Check(0.0, Vec3D(-3.0, 1.0, 2.0), 2.5, Vec3D(4.0, -2.0, -1.0));
+    Check(0.1, Vec3D(-8.0, -7.0, -6.0), 0.12, Vec3D(7.0, 6.5, 8.0));
+    Check(1.5, Vec3D(0.3, 0.2, -8.0), 0.2, Vec3D(0.5, 0.1, 8.0));
+    Check(2.0, Vec3D(0.0, 0.0, -4.0), 2.0, Vec3D(0.0, 0.0, 4.0));
+    Check(2.0, Vec3D(-4.0, 0.0, 0.0), 1.0, Vec3D(4.0, 0.0, 0.0));
+    Check(1.0, Vec3D(1.0, -4.0, 1.0), 3.0, Vec3D(1.0, 4.0, 1.0));
+    Check(3.0, Vec3D(-12.0, 5.0, 0.0), 3.0, Vec3D(12.0, 8.0, 11.0));
+}
+
+TEST_F(FrustumRasterizerTest, test_Rotated_world) {
+    using BG::NES::Simulator::Geometries::Vec3D;
+    Info.WorldRotationOffsetX_rad = 0.4;
+    Info.WorldRotationOffsetY_rad = 1.3;
+    Info.WorldRotationOffsetZ_rad = -0.6;
+    Check(1.2, Vec3D(-5.0, 2.0, 1.0), 0.6, Vec3D(6.0, -3.0, 4.0));
+
+    // A zero-length segment has no volume, its end sphere covers it.
+    Check(1.0, Vec3D(1.0, 1.0, 1.0), 1.0, Vec3D(1.0, 1.0, 1.0));
+}
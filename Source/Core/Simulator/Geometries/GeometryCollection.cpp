@@ -0,0 +1,113 @@
+#include <Simulator/Geometries/GeometryCollection.h>
+
+#include <algorithm>
+
+
+namespace BG {
+namespace NES {
+namespace Simulator {
+namespace Geometries {
+
+GeometryCollection::ShapeIndex& GeometryCollection::ShapeIndex::operator=(const ShapeIndex&) {
+    std::lock_guard<std::mutex> Lock(Mutex);
+    Tree.Clear();
+    Valid = false;
+    Baked.reset();
+    return *this;
+}
+
+BoundingBox GeometryCollection::GetRegionBox(size_t idx, VSDA::WorldInfo& _WorldInfo) {
+    switch (GetShapeType(idx)) {
+    case GeometryBox:
+        return GetBox(idx).GetConservativeBoundingBox(_WorldInfo);
+    case GeometryCylinder:
+        return GetCylinder(idx).GetBoundingBox(_WorldInfo);
+    default:
+        return GetSphere(idx).GetBoundingBox(_WorldInfo);
+    }
+}
+
+void GeometryCollection::UpdateIndex(VSDA::WorldInfo& _WorldInfo) {
+    const float Rotation_rad[3] = { _WorldInfo.WorldRotationOffsetX_rad, _WorldInfo.WorldRotationOffsetY_rad, _WorldInfo.WorldRotationOffsetZ_rad };
+    bool SameRotation = std::equal(Rotation_rad, Rotation_rad + 3, Index_.Rotation_rad);
+
+    // Shapes are only ever appended, fewer shapes than indexed means the
+    // collection was cleared and refilled without Clear().
+    if (!Index_.Valid || !SameRotation || (Index_.Tree.Size() > Size())) {
+        std::vector<BoundingBox> Boxes(Size());
+        for (size_t i = 0; i < Boxes.size(); i++) {
+            Boxes[i] = GetRegionBox(i, _WorldInfo);
+        }
+        Index_.Tree.Build(Boxes);
+        std::copy(Rotation_rad, Rotation_rad + 3, Index_.Rotation_rad);
+        Index_.Valid = true;
+        return;
+    }
+    for (size_t i = Index_.Tree.Size(); i < Size(); i++) {
+        Index_.Tree.Add(GetRegionBox(i, _WorldInfo));
+    }
+}
+
+void GeometryCollection::QueryRegion(const BoundingBox& _Region, VSDA::WorldInfo& _WorldInfo, std::vector<size_t>& _ShapeIDs) {
+    std::lock_guard<std::mutex> Lock(Index_.Mutex);
+    UpdateIndex(_WorldInfo);
+    Index_.Tree.QueryAABB(_Region, _ShapeIDs);
+}
+
+void GeometryCollection::QueryRadius(const Vec3D& _Center_um, float _Radius_um, VSDA::WorldInfo& _WorldInfo, std::vector<size_t>& _ShapeIDs) {
+    std::lock_guard<std::mutex> Lock(Index_.Mutex);
+    UpdateIndex(_WorldInfo);
+    Index_.Tree.QueryRadius(_Center_um, _Radius_um, _ShapeIDs);
+}
+
+void GeometryCollection::QueryNearest(const Vec3D& _Point_um, size_t _K, VSDA::WorldInfo& _WorldInfo, std::vector<size_t>& _ShapeIDs) {
+    std::lock_guard<std::mutex> Lock(Index_.Mutex);
+    UpdateIndex(_WorldInfo);
+    Index_.Tree.QueryNearest(_Point_um, _K, _ShapeIDs);
+}
+
+std::variant<BakedSphere, BakedCylinder, BakedBox> GeometryCollection::BakeShape(size_t idx, VSDA::WorldInfo& _WorldInfo) {
+    switch (GetShapeType(idx)) {
+    case GeometryBox:
+        return BakeBox(GetBox(idx), _WorldInfo);
+    case GeometryCylinder:
+        return BakeCylinder(GetCylinder(idx), _WorldInfo);
+    default:
+        return BakeSphere(GetSphere(idx), _WorldInfo);
+    }
+}
+
+std::shared_ptr<const BakedGeometry> GeometryCollection::GetBaked(VSDA::WorldInfo& _WorldInfo) {
+    std::lock_guard<std::mutex> Lock(Index_.Mutex);
+
+    // As for the index, fewer records than shapes means the collection was
+    // cleared and refilled without Clear().
+    std::shared_ptr<BakedGeometry>& Baked = Index_.Baked;
+    if (!Baked || !Baked->IsFor(_WorldInfo) || (Baked->Size() > Size())) {
+        Baked = std::make_shared<BakedGeometry>();
+        Baked->Rotation_rad[0] = _WorldInfo.WorldRotationOffsetX_rad;
+        Baked->Rotation_rad[1] = _WorldInfo.WorldRotationOffsetY_rad;
+        Baked->Rotation_rad[2] = _WorldInfo.WorldRotationOffsetZ_rad;
+    } else if ((Baked->Size() < Size()) && (Baked.use_count() > 1)) {
+        // Callers may still be reading the records, extend a copy instead.
+        Baked = std::make_shared<BakedGeometry>(*Baked);
+    }
+
+    Baked->Shapes.reserve(Size());
+    for (size_t i = Baked->Size(); i < Size(); i++) {
+        Baked->Shapes.push_back(BakeShape(i, _WorldInfo));
+    }
+    return Baked;
+}
+
+void GeometryCollection::InvalidateIndex() {
+    std::lock_guard<std::mutex> Lock(Index_.Mutex);
+    Index_.Tree.Clear();
+    Index_.Valid = false;
+    Index_.Baked.reset();
+}
+
+}; // Close Namespace Geometries
+}; // Close Namespace Simulator
+}; // Close Namespace NES
+}; // Close Namespace BG
@@ -11,6 +11,8 @@
 #pragma once
 
 // Standard Libraries (BG convention: use <> instead of "")
+#include <memory>
+#include <mutex>
 #include <vector>
 #include <variant>
 
@@ -18,6 +20,11 @@
 #include <Simulator/Geometries/Sphere.h>
 #include <Simulator/Geometries/Cylinder.h>
 #include <Simulator/Geometries/Box.h>
+#include <Simulator/Geometries/BakedGeometry.h>
+#include <Simulator/Geometries/SpatialIndex.h>
+#include <Simulator/Structs/BoundingBox.h>
+
+#include <VSDA/Common/Structs/WorldInfo.h>
 
 
 namespace BG {
@@ -35,6 +42,13 @@ enum GeometryVariantOrder {
 /**
  * @brief This struct contains the various geometries used in the simulation. It has a vector containing each of the geometries.
  * For now, the "id" of the geometry, is simply its index.
+ *
+ * Spatial queries go through a bounding volume hierarchy over the region
+ * boxes of the shapes (see GetRegionBox()), built for one world rotation.
+ * The rasterizers use the world-space records of GetBaked(), kept for one
+ * world rotation the same way. Shapes appended since the last call are added
+ * to both on the next one, shapes that are moved or resized in place need
+ * InvalidateIndex().
  * 
  */
 struct GeometryCollection {
@@ -64,7 +78,7 @@ struct GeometryCollection {
         }
     }
 
-    void Clear() { Geometries.clear(); }
+    void Clear() { Geometries.clear(); InvalidateIndex(); }
 
     size_t Size() const { return Geometries.size(); }
 
@@ -151,6 +165,51 @@ struct GeometryCollection {
         if (IsBox(idx)) return &GetBox(idx);
         return nullptr;
     }
+
+    //! Box that the shape's IsInsideRegion() tests against a region.
+    BoundingBox GetRegionBox(size_t idx, VSDA::WorldInfo& _WorldInfo);
+
+    //! IDs of the shapes whose IsInsideRegion() accepts _Region, in ascending order.
+    void QueryRegion(const BoundingBox& _Region, VSDA::WorldInfo& _WorldInfo, std::vector<size_t>& _ShapeIDs);
+
+    //! IDs of the shapes whose region box is within _Radius_um of _Center_um, in ascending order.
+    void QueryRadius(const Vec3D& _Center_um, float _Radius_um, VSDA::WorldInfo& _WorldInfo, std::vector<size_t>& _ShapeIDs);
+
+    //! IDs of the _K shapes whose region boxes are nearest to _Point_um, nearest first.
+    void QueryNearest(const Vec3D& _Point_um, size_t _K, VSDA::WorldInfo& _WorldInfo, std::vector<size_t>& _ShapeIDs);
+
+    //! World-space records of all shapes for the rotation of _WorldInfo, baked
+    //! once and shared until the rotation changes or the shapes are invalidated.
+    std::shared_ptr<const BakedGeometry> GetBaked(VSDA::WorldInfo& _WorldInfo);
+
+    //! Drops the spatial index and the baked geometry, both are rebuilt by the next call.
+    void InvalidateIndex();
+
+private:
+
+    /**
+     * @brief Spatial index with the world rotation it was built for, and the
+     * baked geometry. A copy of the collection starts without either.
+     */
+    struct ShapeIndex {
+        std::mutex Mutex;
+        BoundingVolumeHierarchy Tree;
+        bool Valid = false;
+        float Rotation_rad[3] = {0.0, 0.0, 0.0};
+        std::shared_ptr<BakedGeometry> Baked; /**Only changed in place while no caller holds it*/
+
+        ShapeIndex() = default;
+        ShapeIndex(const ShapeIndex&) {}
+        ShapeIndex& operator=(const ShapeIndex&);
+    };
+
+    ShapeIndex Index_;
+
+    //! Brings Index_ up to date for _WorldInfo, Index_.Mutex must be held.
+    void UpdateIndex(VSDA::WorldInfo& _WorldInfo);
+
+    //! Record of shape idx in world space.
+    std::variant<BakedSphere, BakedCylinder, BakedBox> BakeShape(size_t idx, VSDA::WorldInfo& _WorldInfo);
 };
 
 }; // Close Namespace Geometries
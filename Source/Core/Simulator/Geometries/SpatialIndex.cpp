@@ -0,0 +1,259 @@
+#include <Simulator/Geometries/SpatialIndex.h>
+
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <utility>
+
+
+namespace BG {
+namespace NES {
+namespace Simulator {
+namespace Geometries {
+
+void BoundingVolumeHierarchy::Build(const std::vector<BoundingBox>& _Boxes) {
+    Clear();
+    Min_.reserve(3 * _Boxes.size());
+    Max_.reserve(3 * _Boxes.size());
+    for (const BoundingBox& Box : _Boxes) {
+        for (int Axis = 0; Axis < 3; Axis++) {
+            Min_.push_back(std::min(Box.bb_point1[Axis], Box.bb_point2[Axis]));
+            Max_.push_back(std::max(Box.bb_point1[Axis], Box.bb_point2[Axis]));
+        }
+    }
+    Rebuild();
+}
+
+void BoundingVolumeHierarchy::Add(const BoundingBox& _Box) {
+    for (int Axis = 0; Axis < 3; Axis++) {
+        Min_.push_back(std::min(_Box.bb_point1[Axis], _Box.bb_point2[Axis]));
+        Max_.push_back(std::max(_Box.bb_point1[Axis], _Box.bb_point2[Axis]));
+    }
+    size_t NumPending = Size() - NumInTree_;
+    if (NumPending > std::max<size_t>(32, NumInTree_ / 4)) {
+        Rebuild();
+    }
+}
+
+void BoundingVolumeHierarchy::Rebuild() {
+    Nodes_.clear();
+    Order_.resize(Size());
+    for (uint32_t i = 0; i < Order_.size(); i++) {
+        Order_[i] = i;
+    }
+    NumInTree_ = Size();
+    if (NumInTree_ == 0) {
+        return;
+    }
+
+    std::vector<float> Centers(Min_.size());
+    for (size_t i = 0; i < Centers.size(); i++) {
+        Centers[i] = 0.5f * (Min_[i] + Max_[i]);
+    }
+    Nodes_.reserve(2 * (NumInTree_ / MaxLeafItems + 1));
+    BuildNode(0, uint32_t(NumInTree_), Centers);
+}
+
+void BoundingVolumeHierarchy::Clear() {
+    Min_.clear();
+    Max_.clear();
+    Order_.clear();
+    Nodes_.clear();
+    NumInTree_ = 0;
+}
+
+uint32_t BoundingVolumeHierarchy::BuildNode(uint32_t _First, uint32_t _Count, std::vector<float>& _Centers) {
+    uint32_t NodeIdx = uint32_t(Nodes_.size());
+    Nodes_.emplace_back();
+
+    // Bounds of the items and of their centers.
+    float Min[3], Max[3], CenterMin[3], CenterMax[3];
+    for (int Axis = 0; Axis < 3; Axis++) {
+        uint32_t Item = Order_[_First];
+        Min[Axis] = Min_[3*Item + Axis];
+        Max[Axis] = Max_[3*Item + Axis];
+        CenterMin[Axis] = CenterMax[Axis] = _Centers[3*Item + Axis];
+    }
+    for (uint32_t i = _First + 1; i < _First + _Count; i++) {
+        uint32_t Item = Order_[i];
+        for (int Axis = 0; Axis < 3; Axis++) {
+            Min[Axis] = std::min(Min[Axis], Min_[3*Item + Axis]);
+            Max[Axis] = std::max(Max[Axis], Max_[3*Item + Axis]);
+            CenterMin[Axis] = std::min(CenterMin[Axis], _Centers[3*Item + Axis]);
+            CenterMax[Axis] = std::max(CenterMax[Axis], _Centers[3*Item + Axis]);
+        }
+    }
+    std::copy(Min, Min + 3, Nodes_[NodeIdx].Min);
+    std::copy(Max, Max + 3, Nodes_[NodeIdx].Max);
+
+    if (_Count <= MaxLeafItems) {
+        Nodes_[NodeIdx].First = _First;
+        Nodes_[NodeIdx].Count = _Count;
+        return NodeIdx;
+    }
+
+    // Split at the median center along the axis in which the centers spread most.
+    int SplitAxis = 0;
+    for (int Axis = 1; Axis < 3; Axis++) {
+        if ((CenterMax[Axis] - CenterMin[Axis]) > (CenterMax[SplitAxis] - CenterMin[SplitAxis])) {
+            SplitAxis = Axis;
+        }
+    }
+    uint32_t Half = _Count / 2;
+    std::nth_element(Order_.begin() + _First, Order_.begin() + _First + Half, Order_.begin() + _First + _Count,
+        [&_Centers, SplitAxis](uint32_t _A, uint32_t _B) { return _Centers[3*_A + SplitAxis] < _Centers[3*_B + SplitAxis]; });
+
+    BuildNode(_First, Half, _Centers);
+    uint32_t Second = BuildNode(_First + Half, _Count - Half, _Centers);
+    Nodes_[NodeIdx].First = Second;
+    Nodes_[NodeIdx].Count = 0;
+    return NodeIdx;
+}
+
+float BoundingVolumeHierarchy::DistanceSquared(const float* _Min, const float* _Max, const Vec3D& _Point) const {
+    const float Point[3] = { _Point.x, _Point.y, _Point.z };
+    float Distance2 = 0.0;
+    for (int Axis = 0; Axis < 3; Axis++) {
+        float Outside = std::max({_Min[Axis] - Point[Axis], 0.0f, Point[Axis] - _Max[Axis]});
+        Distance2 += Outside * Outside;
+    }
+    return Distance2;
+}
+
+bool BoundingVolumeHierarchy::Overlaps(const float* _Min, const float* _Max, const float* _RegionMin, const float* _RegionMax) const {
+    return (_Max[0] >= _RegionMin[0]) && (_RegionMax[0] >= _Min[0]) &&
+           (_Max[1] >= _RegionMin[1]) && (_RegionMax[1] >= _Min[1]) &&
+           (_Max[2] >= _RegionMin[2]) && (_RegionMax[2] >= _Min[2]);
+}
+
+void BoundingVolumeHierarchy::QueryAABB(const BoundingBox& _Region, std::vector<size_t>& _Items) const {
+    _Items.clear();
+    float RegionMin[3], RegionMax[3];
+    for (int Axis = 0; Axis < 3; Axis++) {
+        RegionMin[Axis] = std::min(_Region.bb_point1[Axis], _Region.bb_point2[Axis]);
+        RegionMax[Axis] = std::max(_Region.bb_point1[Axis], _Region.bb_point2[Axis]);
+    }
+
+    if (!Nodes_.empty()) {
+        std::vector<uint32_t> Stack{0};
+        while (!Stack.empty()) {
+            uint32_t ThisIdx = Stack.back();
+            const Node& ThisNode = Nodes_[ThisIdx];
+            Stack.pop_back();
+            if (!Overlaps(ThisNode.Min, ThisNode.Max, RegionMin, RegionMax)) {
+                continue;
+            }
+            if (ThisNode.Count == 0) {
+                Stack.push_back(ThisNode.First);
+                Stack.push_back(ThisIdx + 1);
+                continue;
+            }
+            for (uint32_t i = ThisNode.First; i < ThisNode.First + ThisNode.Count; i++) {
+                uint32_t Item = Order_[i];
+                if (Overlaps(&Min_[3*Item], &Max_[3*Item], RegionMin, RegionMax)) {
+                    _Items.push_back(Item);
+                }
+            }
+        }
+    }
+    for (size_t Item = NumInTree_; Item < Size(); Item++) {
+        if (Overlaps(&Min_[3*Item], &Max_[3*Item], RegionMin, RegionMax)) {
+            _Items.push_back(Item);
+        }
+    }
+    std::sort(_Items.begin(), _Items.end());
+}
+
+void BoundingVolumeHierarchy::QueryRadius(const Vec3D& _Center_um, float _Radius_um, std::vector<size_t>& _Items) const {
+    _Items.clear();
+    float Radius2 = _Radius_um * _Radius_um;
+
+    if (!Nodes_.empty()) {
+        std::vector<uint32_t> Stack{0};
+        while (!Stack.empty()) {
+            uint32_t ThisIdx = Stack.back();
+            const Node& ThisNode = Nodes_[ThisIdx];
+            Stack.pop_back();
+            if (DistanceSquared(ThisNode.Min, ThisNode.Max, _Center_um) > Radius2) {
+                continue;
+            }
+            if (ThisNode.Count == 0) {
+                Stack.push_back(ThisNode.First);
+                Stack.push_back(ThisIdx + 1);
+                continue;
+            }
+            for (uint32_t i = ThisNode.First; i < ThisNode.First + ThisNode.Count; i++) {
+                uint32_t Item = Order_[i];
+                if (DistanceSquared(&Min_[3*Item], &Max_[3*Item], _Center_um) <= Radius2) {
+                    _Items.push_back(Item);
+                }
+            }
+        }
+    }
+    for (size_t Item = NumInTree_; Item < Size(); Item++) {
+        if (DistanceSquared(&Min_[3*Item], &Max_[3*Item], _Center_um) <= Radius2) {
+            _Items.push_back(Item);
+        }
+    }
+    std::sort(_Items.begin(), _Items.end());
+}
+
+void BoundingVolumeHierarchy::QueryNearest(const Vec3D& _Point_um, size_t _K, std::vector<size_t>& _Items) const {
+    _Items.clear();
+    if ((_K == 0) || (Size() == 0)) {
+        return;
+    }
+
+    // Best candidates so far, the worst on top.
+    using Candidate = std::pair<float, size_t>;
+    std::priority_queue<Candidate> Best;
+    auto Consider = [&Best, _K](float _Distance2, size_t _Item) {
+        Candidate C(_Distance2, _Item);
+        if (Best.size() < _K) {
+            Best.push(C);
+        } else if (C < Best.top()) {
+            Best.pop();
+            Best.push(C);
+        }
+    };
+
+    for (size_t Item = NumInTree_; Item < Size(); Item++) {
+        Consider(DistanceSquared(&Min_[3*Item], &Max_[3*Item], _Point_um), Item);
+    }
+
+    // Visit nodes nearest first, until no node can hold a better candidate.
+    if (!Nodes_.empty()) {
+        using Pending = std::pair<float, uint32_t>;
+        std::priority_queue<Pending, std::vector<Pending>, std::greater<Pending>> Nodes;
+        Nodes.emplace(DistanceSquared(Nodes_[0].Min, Nodes_[0].Max, _Point_um), 0);
+        while (!Nodes.empty()) {
+            auto [Distance2, ThisIdx] = Nodes.top();
+            Nodes.pop();
+            if ((Best.size() == _K) && (Distance2 > Best.top().first)) {
+                break;
+            }
+            const Node& ThisNode = Nodes_[ThisIdx];
+            if (ThisNode.Count == 0) {
+                for (uint32_t Child : { ThisIdx + 1, ThisNode.First }) {
+                    Nodes.emplace(DistanceSquared(Nodes_[Child].Min, Nodes_[Child].Max, _Point_um), Child);
+                }
+                continue;
+            }
+            for (uint32_t i = ThisNode.First; i < ThisNode.First + ThisNode.Count; i++) {
+                uint32_t Item = Order_[i];
+                Consider(DistanceSquared(&Min_[3*Item], &Max_[3*Item], _Point_um), Item);
+            }
+        }
+    }
+
+    _Items.resize(Best.size());
+    for (size_t i = Best.size(); i > 0; i--) {
+        _Items[i - 1] = Best.top().second;
+        Best.pop();
+    }
+}
+
+}; // namespace Geometries
+}; // namespace Simulator
+}; // namespace NES
+}; // namespace BG
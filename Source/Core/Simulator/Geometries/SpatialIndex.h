@@ -0,0 +1,95 @@
+//=================================================================//
+// This file is part of the BrainGenix-NES Neuron Emulation System //
+//=================================================================//
+
+/*
+    Description: This file provides a bounding volume hierarchy over axis aligned bounding boxes.
+    Additional Notes: None
+    Date Created: 2026-10-17
+*/
+
+#pragma once
+
+// Standard Libraries (BG convention: use <> instead of "")
+#include <cstdint>
+#include <vector>
+
+// Internal Libraries (BG convention: use <> instead of "")
+#include <Simulator/Geometries/VecTools.h>
+#include <Simulator/Structs/BoundingBox.h>
+
+
+namespace BG {
+namespace NES {
+namespace Simulator {
+namespace Geometries {
+
+/**
+ * @brief Bounding volume hierarchy over items that are described by their
+ * axis aligned bounding box. Items are identified by the order they were
+ * added in, so that a shape's ID can be used directly.
+ *
+ * The tree is built top-down by splitting at the median of the item centers
+ * along the longest axis. Items added after a build are kept in a short list
+ * that queries scan linearly, once that list holds more than a fraction of
+ * the tree the whole tree is rebuilt. Adding N items one by one thus costs
+ * O(N log N) overall.
+ *
+ * Point items (e.g. soma centers) are boxes with both corners at the point.
+ * Distances are measured to the nearest point of an item's box.
+ */
+class BoundingVolumeHierarchy {
+
+private:
+
+    struct Node {
+        float Min[3];
+        float Max[3];
+        uint32_t First = 0; /**Leaf: first entry in Order_, inner node: index of the second child (the first follows the node)*/
+        uint32_t Count = 0; /**Number of items of a leaf, 0 for inner nodes*/
+    };
+
+    static constexpr uint32_t MaxLeafItems = 4;
+
+    std::vector<float> Min_;        /**3 floats per item*/
+    std::vector<float> Max_;        /**3 floats per item*/
+    std::vector<uint32_t> Order_;   /**Items of the tree, leaves hold ranges of this*/
+    std::vector<Node> Nodes_;
+    size_t NumInTree_ = 0;          /**Items [0, NumInTree_) are in the tree, the rest is scanned linearly*/
+
+    uint32_t BuildNode(uint32_t _First, uint32_t _Count, std::vector<float>& _Centers);
+    float DistanceSquared(const float* _Min, const float* _Max, const Vec3D& _Point) const;
+    bool Overlaps(const float* _Min, const float* _Max, const float* _RegionMin, const float* _RegionMax) const;
+
+public:
+
+    //! Replaces all items with _Boxes and builds the tree.
+    void Build(const std::vector<BoundingBox>& _Boxes);
+
+    //! Adds one item, its ID is the previous Size().
+    void Add(const BoundingBox& _Box);
+
+    //! Builds the tree over all items, including the recently added ones.
+    void Rebuild();
+
+    void Clear();
+
+    size_t Size() const { return Min_.size() / 3; }
+
+    //! IDs of all items whose box overlaps _Region (boundaries touching
+    //! count, as in BoundingBox::IsIntersecting()), in ascending order.
+    void QueryAABB(const BoundingBox& _Region, std::vector<size_t>& _Items) const;
+
+    //! IDs of all items within _Radius_um of _Center_um, in ascending order.
+    void QueryRadius(const Vec3D& _Center_um, float _Radius_um, std::vector<size_t>& _Items) const;
+
+    //! IDs of the (at most) _K items nearest to _Point_um, nearest first.
+    //! Items at the same distance are ordered by ID.
+    void QueryNearest(const Vec3D& _Point_um, size_t _K, std::vector<size_t>& _Items) const;
+
+};
+
+}; // namespace Geometries
+}; // namespace Simulator
+}; // namespace NES
+}; // namespace BG
@@ -0,0 +1,167 @@
+//=================================================================//
+// This file is part of the BrainGenix-NES Neuron Emulation System //
+//=================================================================//
+
+/*
+    Description: This file provides unit tests for the bounding volume hierarchy and the shape index of GeometryCollection.
+    Additional Notes: None
+    Date Created: 2026-10-17
+*/
+
+#include <algorithm>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <Simulator/Geometries/GeometryCollection.h>
+#include <Simulator/Geometries/SpatialIndex.h>
+
+
+/**
+ * @brief Test class for the spatial index. Compares every query with a
+ * linear scan over randomly placed boxes and points.
+ */
+
+struct SpatialIndexTest : testing::Test {
+    std::mt19937 Generator{1234};
+
+    BG::NES::Simulator::BoundingBox RandomBox(float _Extent_um, float _MaxSize_um) {
+        std::uniform_real_distribution<float> Position(-_Extent_um, _Extent_um);
+        std::uniform_real_distribution<float> Size(0.0, _MaxSize_um);
+        BG::NES::Simulator::BoundingBox Box;
+        for (int Axis = 0; Axis < 3; Axis++) {
+            Box.bb_point1[Axis] = Position(Generator);
+            Box.bb_point2[Axis] = Box.bb_point1[Axis] + Size(Generator);
+        }
+        return Box;
+    }
+
+    float DistanceSquared(const BG::NES::Simulator::BoundingBox& _Box, const BG::NES::Simulator::Geometries::Vec3D& _Point) {
+        const float Point[3] = { _Point.x, _Point.y, _Point.z };
+        float Distance2 = 0.0;
+        for (int Axis = 0; Axis < 3; Axis++) {
+            float Outside = std::max({_Box.bb_point1[Axis] - Point[Axis], 0.0f, Point[Axis] - _Box.bb_point2[Axis]});
+            Distance2 += Outside * Outside;
+        }
+        return Distance2;
+    }
+
+    void CheckQueries(const BG::NES::Simulator::Geometries::BoundingVolumeHierarchy& _Tree, std::vector<BG::NES::Simulator::BoundingBox>& _Boxes) {
+        using BG::NES::Simulator::Geometries::Vec3D;
+        std::uniform_real_distribution<float> Position(-100.0, 100.0);
+        std::vector<size_t> Found;
+
+        for (int q = 0; q < 50; q++) {
+            BG::NES::Simulator::BoundingBox Region = RandomBox(100.0, 60.0);
+            std::vector<size_t> Expected;
+            for (size_t i = 0; i < _Boxes.size(); i++) {
+                if (_Boxes[i].IsIntersecting(Region)) Expected.push_back(i);
+            }
+            _Tree.QueryAABB(Region, Found);
+            ASSERT_EQ(Found, Expected);
+
+            Vec3D Center(Position(Generator), Position(Generator), Position(Generator));
+            float Radius_um = 25.0;
+            Expected.clear();
+            for (size_t i = 0; i < _Boxes.size(); i++) {
+                if (DistanceSquared(_Boxes[i], Center) <= Radius_um * Radius_um) Expected.push_back(i);
+            }
+            _Tree.QueryRadius(Center, Radius_um, Found);
+            ASSERT_EQ(Found, Expected);
+
+            std::vector<std::pair<float, size_t>> ByDistance;
+            for (size_t i = 0; i < _Boxes.size(); i++) {
+                ByDistance.emplace_back(DistanceSquared(_Boxes[i], Center), i);
+            }
+            std::sort(ByDistance.begin(), ByDistance.end());
+            Expected.clear();
+            for (size_t i = 0; i < std::min<size_t>(7, ByDistance.size()); i++) {
+                Expected.push_back(ByDistance[i].second);
+            }
+            _Tree.QueryNearest(Center, 7, Found);
+            ASSERT_EQ(Found, Expected);
+        }
+    }
+};
+
+TEST_F(SpatialIndexTest, test_Queries_match_linear_scan) {
+    std::vector<BG::NES::Simulator::BoundingBox> Boxes;
+    for (int i = 0; i < 2000; i++) {
+        Boxes.push_back(RandomBox(100.0, (i % 10 == 0) ? 40.0 : 4.0));
+    }
+    BG::NES::Simulator::Geometries::BoundingVolumeHierarchy Tree;
+    Tree.Build(Boxes);
+    ASSERT_EQ(Tree.Size(), Boxes.size());
+    CheckQueries(Tree, Boxes);
+
+    // Points, e.g. soma centers.
+    for (auto& Box : Boxes) {
+        std::copy(Box.bb_point1, Box.bb_point1 + 3, Box.bb_point2);
+    }
+    Tree.Build(Boxes);
+    CheckQueries(Tree, Boxes);
+}
+
+TEST_F(SpatialIndexTest, test_Added_items_are_found) {
+    std::vector<BG::NES::Simulator::BoundingBox> Boxes;
+    BG::NES::Simulator::Geometries::BoundingVolumeHierarchy Tree;
+    CheckQueries(Tree, Boxes);
+
+    // Query between additions, so that items are found both in the tree and
+    // in the list of recent additions.
+    for (int Batch = 0; Batch < 10; Batch++) {
+        for (int i = 0; i < 37 * (Batch + 1); i++) {
+            Boxes.push_back(RandomBox(100.0, 10.0));
+            Tree.Add(Boxes.back());
+        }
+        ASSERT_EQ(Tree.Size(), Boxes.size());
+        CheckQueries(Tree, Boxes);
+    }
+}
+
+TEST_F(SpatialIndexTest, test_GeometryCollection_region_query) {
+    using namespace BG::NES::Simulator::Geometries;
+    GeometryCollection Collection;
+    std::uniform_real_distribution<float> Position(-100.0, 100.0);
+    std::uniform_real_distribution<float> Size(0.5, 5.0);
+    auto AddShapes = [&](int _Count) {
+        for (int i = 0; i < _Count; i++) {
+            Vec3D Center(Position(Generator), Position(Generator), Position(Generator));
+            switch (i % 3) {
+            case 0: Collection.AddSphere(Center, Size(Generator)); break;
+            case 1: Collection.AddCylinder(Size(Generator), Center, Size(Generator), Center + Vec3D(Size(Generator), 4.0, -3.0)); break;
+            case 2: Collection.AddBox(Center, Vec3D(Size(Generator), Size(Generator), Size(Generator))); break;
+            }
+        }
+    };
+
+    BG::NES::VSDA::WorldInfo Info;
+    Info.VoxelScale_um = 0.1;
+    auto CheckRegions = [&]() {
+        std::vector<size_t> Found;
+        for (int q = 0; q < 20; q++) {
+            BG::NES::Simulator::BoundingBox Region = RandomBox(100.0, 50.0);
+            std::vector<size_t> Expected;
+            for (size_t i = 0; i < Collection.Size(); i++) {
+                if (Collection.GetGeometry(i)->IsInsideRegion(Region, Info)) Expected.push_back(i);
+            }
+            Collection.QueryRegion(Region, Info, Found);
+            ASSERT_EQ(Found, Expected);
+        }
+    };
+
+    AddShapes(600);
+    CheckRegions();
+
+    // Shapes added after the index was built, and another world rotation.
+    AddShapes(100);
+    CheckRegions();
+    Info.WorldRotationOffsetY_rad = 0.7;
+    CheckRegions();
+
+    Collection.Clear();
+    AddShapes(50);
+    CheckRegions();
+}
@@ -1,3 +1,5 @@
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 
 #include <Simulator/Geometries/Wedge.h>
@@ -12,6 +14,28 @@ Wedge::Wedge(){
     GeometryShape = GeometryWedge;
 };
 
+//! Box around both rotated ends, each extended by half the diagonal of its
+//! rectangle, which holds the rectangle whichever way it is turned.
+BoundingBox Wedge::GetBoundingBox(VSDA::WorldInfo& _WorldInfo) {
+    Geometries::Vec3D End0Rot = End0Pos_um.rotate_around_xyz(_WorldInfo.WorldRotationOffsetX_rad, _WorldInfo.WorldRotationOffsetY_rad, _WorldInfo.WorldRotationOffsetZ_rad);
+    Geometries::Vec3D End1Rot = End1Pos_um.rotate_around_xyz(_WorldInfo.WorldRotationOffsetX_rad, _WorldInfo.WorldRotationOffsetY_rad, _WorldInfo.WorldRotationOffsetZ_rad);
+    float End0HalfDiagonal_um = 0.5 * std::sqrt(End0Width_um * End0Width_um + End0Height_um * End0Height_um);
+    float End1HalfDiagonal_um = 0.5 * std::sqrt(End1Width_um * End1Width_um + End1Height_um * End1Height_um);
+
+    BoundingBox bb;
+    bb.bb_point1[0] = std::min(End0Rot.x - End0HalfDiagonal_um, End1Rot.x - End1HalfDiagonal_um);
+    bb.bb_point1[1] = std::min(End0Rot.y - End0HalfDiagonal_um, End1Rot.y - End1HalfDiagonal_um);
+    bb.bb_point1[2] = std::min(End0Rot.z - End0HalfDiagonal_um, End1Rot.z - End1HalfDiagonal_um);
+    bb.bb_point2[0] = std::max(End0Rot.x + End0HalfDiagonal_um, End1Rot.x + End1HalfDiagonal_um);
+    bb.bb_point2[1] = std::max(End0Rot.y + End0HalfDiagonal_um, End1Rot.y + End1HalfDiagonal_um);
+    bb.bb_point2[2] = std::max(End0Rot.z + End0HalfDiagonal_um, End1Rot.z + End1HalfDiagonal_um);
+    return bb;
+}
+
+bool Wedge::IsInsideRegion(BoundingBox _Region, VSDA::WorldInfo& _WorldInfo) {
+    return GetBoundingBox(_WorldInfo).IsIntersecting(_Region);
+}
+
 Wedge::Wedge(const Vec3D & _End0Pos_um, const Vec3D & _End1Pos_um, float _End0Width_um, float _End0Height_um, float _End1Width_um, float _End1Height_um):
 	End0Pos_um(_End0Pos_um), End1Pos_um(_End1Pos_um), End0Width_um(_End0Width_um), End1Width_um(_End1Width_um), End0Height_um(_End0Height_um), End1Height_um(_End1Height_um) {
 
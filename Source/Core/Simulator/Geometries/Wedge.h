@@ -62,9 +62,9 @@ struct Wedge : Geometry {
 
 
     //! Returns the bounding box
-    virtual BoundingBox GetBoundingBox(VSDA::WorldInfo& _WorldInfo) { return BoundingBox(); } // ** FIX THIS!
+    virtual BoundingBox GetBoundingBox(VSDA::WorldInfo& _WorldInfo);
     virtual bool IsPointInShape(Vec3D _Position_um, VSDA::WorldInfo& _WorldInfo) { return true; } // ***FIX THIS!
-    virtual bool IsInsideRegion(BoundingBox _Region, VSDA::WorldInfo& _WorldInfo) { return true; } // ***FIX THIS!
+    virtual bool IsInsideRegion(BoundingBox _Region, VSDA::WorldInfo& _WorldInfo);
 
     //! Returns a point cloud that can be used to fill voxels representing the cylinder.
     // std::vector<Vec3D> GetPointCloud(float _VoxelScale);
@@ -103,7 +103,7 @@ bool LIFCNeuron::Edit(const CoreStructs::LIFCNeuronStruct & lifcneuronstruct, co
     }
 
     // Updating variables dependent on edited parameters
-    Vm_mV = VRest_mV;
+    Vm() = VRest_mV;
     tau_m_ms = Rm_GOhm * Cm_pF;
     g_L_nS = 1.0 / Rm_GOhm;
 
@@ -176,40 +176,47 @@ void LIFCNeuron::spike(float tfire) {
     // Spike logging
     updates_since_spike = 0;
     t_last_spike = tfire;
-    TAct_ms.push_back(t_last_spike);
+    TActPending_ms.push_back(t_last_spike);
     
     // Membrane potential reset
     if (build_data.UpdateMethod == CoreStructs::CLASSICAL) {
-        Vm_mV = VReset_mV;
+        Vm() = VReset_mV;
     } else {
         if (build_data.ResetMethod == CoreStructs::TOVM) {
-            VReset_mV = std::min(Vm_mV, VAct_mV); // Remember value before AP
+            VReset_mV = std::min(Vm(), VAct_mV); // Remember value before AP
         }
-        Vm_mV = VSpike_mV;
+        Vm() = VSpike_mV;
     }
     reset_done = false;
     
     // Threshold effects
     // a. nonlinear hard-cap
     if (fatigue_threshold > 0) {
-        fatigue += 1.0;
+        fatigue_level() += 1.0;
     }
     // b. Adaptive threshold models sodium channel inactivation
-    h_spike -= dh_spike;
+    h() -= dh_spike;
     // c. Dynamic threshold floor
     if (delta_floor_per_spike_mV > 0) {
-        Vth_floor_mV += delta_floor_per_spike_mV;
+        Vth_floor() += delta_floor_per_spike_mV;
     }
     
     // ADP saturation
     if (build_data.AfterDepolarizationSaturationModel != CoreStructs::ADPCLIP) {
-        a_ADP -= ADP_depletion;
+        ADP_availability() -= ADP_depletion;
     }
     
     // STDP
     if (Sim.STDP) {
-        for (auto& RDataptr : LIFCReceptorDataVec) {
-            RDataptr->STDP_Update(tfire);
+        if (Sim.Connectome_.IsBuilt()) {
+            // Only the incoming receptors that actually use STDP.
+            for (auto& RDataptr : Sim.Connectome_.GetPlasticInputs(ID)) {
+                RDataptr->STDP_Update(tfire);
+            }
+        } else {
+            for (auto& RDataptr : LIFCReceptorDataVec) {
+                RDataptr->STDP_Update(tfire);
+            }
         }
     }
 }
@@ -225,7 +232,7 @@ void LIFCNeuron::check_spiking(float& t, float V_th_adaptive) {
         }
     }
     
-    if ((fatigue_threshold > 0) && (fatigue > fatigue_threshold)) {
+    if ((fatigue_threshold > 0) && (fatigue_level() > fatigue_threshold)) {
         return;
     }
 
@@ -240,25 +247,51 @@ void LIFCNeuron::check_spiking(float& t, float V_th_adaptive) {
         }
     }
     
-    if (Vm_mV >= V_th_adaptive) {
+    if (Vm() >= V_th_adaptive) {
         // Optional precision triangulation
-        if (Sim.triangulate_precise_spiketimes && (Vm_mV > Vm_prev_mV)) {
-            t = T_ms + tDiff_ms * (V_th_adaptive - Vm_prev_mV)/(Vm_mV - Vm_prev_mV);
-            Vm_mV = V_th_adaptive;
+        if (Sim.triangulate_precise_spiketimes && (Vm() > Vm_prev_mV)) {
+            t = T_ms + tDiff_ms * (V_th_adaptive - Vm_prev_mV)/(Vm() - Vm_prev_mV);
+            Vm() = V_th_adaptive;
         }
         spike(t);
     }
 }
 
-void LIFCNeuron::update_conductances(float t) {
+void LIFCNeuron::update_fatigue() {
+    // Hard-cap nonlinear spiking fatigue threshold.
+    if (fatigue_threshold > 0) {
+        fatigue_level() -= tDiff_ms / tau_fatigue_recovery_ms;
+        fatigue_level() = std::max(fatigue_level(), 0.0f);
+    }
+}
+
+void LIFCNeuron::update_receptor_conductances(float t) {
+    bool event_driven = Sim.EventDrivenActive_;
+    bool recursive = Sim.use_recursive_conductances || event_driven;
+
     // Update PSP conductances
     for (auto& RDataptr : LIFCReceptorDataVec) {
-        RDataptr->Update_Conductance(t, Vm_mV);
+        RDataptr->Update_Conductance(t, Vm(), recursive, event_driven);
     }
-    
+}
+
+// LIFCStateArrays does this with LIFCAfterPotentialKernel(), always in the
+// recursive form.
+void LIFCNeuron::update_afterpotential_conductances(float t) {
+    bool recursive = Sim.use_recursive_conductances || Sim.EventDrivenActive_;
+
     // Update fAHP, sAHP, ADP conductances
-    float g_fAHP_linear = g_peak_fAHP_nS * Connections::g_norm(t, TAct_ms, tau_rise_fAHP_ms, tau_decay_fAHP_ms, norm_fAHP, 0);
-    float g_sAHP_linear = g_peak_sAHP_nS * Connections::g_norm(t, TAct_ms, tau_rise_sAHP_ms, tau_decay_sAHP_ms, norm_sAHP, 0);
+    float g_fAHP_linear, g_sAHP_linear, g_ADP_linear;
+    if (recursive) {
+        g_fAHP_linear = g_peak_fAHP_nS * fAHP_state.Update(t, TAct_ms, tau_rise_fAHP_ms, tau_decay_fAHP_ms, norm_fAHP, 0);
+        g_sAHP_linear = g_peak_sAHP_nS * sAHP_state.Update(t, TAct_ms, tau_rise_sAHP_ms, tau_decay_sAHP_ms, norm_sAHP, 0);
+        g_ADP_linear = g_peak_ADP_nS * ADP_state.Update(t, TAct_ms, tau_rise_ADP_ms, tau_decay_ADP_ms, norm_ADP, 0);
+    } else {
+        g_fAHP_linear = g_peak_fAHP_nS * Connections::g_norm(t, TAct_ms, tau_rise_fAHP_ms, tau_decay_fAHP_ms, norm_fAHP, 0);
+        g_sAHP_linear = g_peak_sAHP_nS * Connections::g_norm(t, TAct_ms, tau_rise_sAHP_ms, tau_decay_sAHP_ms, norm_sAHP, 0);
+        g_ADP_linear = g_peak_ADP_nS * Connections::g_norm(t, TAct_ms, tau_rise_ADP_ms, tau_decay_ADP_ms, norm_ADP, 0);
+    }
+
     if (build_data.AfterHyperpolarizationSaturationModel == CoreStructs::AHPCLIP) {
         g_fAHP_nS = std::min(g_fAHP_linear, g_peak_fAHP_max_nS);
         g_sAHP_nS = std::min(g_sAHP_linear, g_peak_sAHP_max_nS);
@@ -267,32 +300,32 @@ void LIFCNeuron::update_conductances(float t) {
         g_sAHP_nS = g_peak_sAHP_max_nS * (g_sAHP_linear / (g_sAHP_linear + Kd_sAHP_nS));
     }
     
-    float g_ADP_linear = g_peak_ADP_nS * Connections::g_norm(t, TAct_ms, tau_rise_ADP_ms, tau_decay_ADP_ms, norm_ADP, 0);
     if (build_data.AfterDepolarizationSaturationModel == CoreStructs::ADPCLIP) {
         g_ADP_nS = std::min(g_ADP_linear, g_peak_ADP_max_nS);
     } else {
-        a_ADP = a_ADP + (1 - a_ADP) * tDiff_ms / tau_recovery_ADP_ms;
-        a_ADP = std::max(0.0f, std::min(1.0f, a_ADP));
-        g_ADP_nS = a_ADP * g_ADP_linear;
+        float& a = ADP_availability();
+        a = a + (1 - a) * tDiff_ms / tau_recovery_ADP_ms;
+        a = std::max(0.0f, std::min(1.0f, a));
+        g_ADP_nS = a * g_ADP_linear;
     }
 
 }
 
 float LIFCNeuron::update_currents() {
-    float I = g_fAHP_nS * (Vm_mV - E_AHP_mV) +
-              g_sAHP_nS * (Vm_mV - E_AHP_mV) +
-              g_ADP_nS * (Vm_mV - E_ADP_mV);
+    float I = g_fAHP_nS * (Vm() - E_AHP_mV) +
+              g_sAHP_nS * (Vm() - E_AHP_mV) +
+              g_ADP_nS * (Vm() - E_ADP_mV);
     
     for (auto& RDataptr : LIFCReceptorDataVec) {
-        I += RDataptr->Get_Current(Vm_mV); // p->g * (Vm_mV - p->E)
+        I += RDataptr->Get_Current(Vm()); // p->g * (Vm_mV - p->E)
     }
     
     return I;
 }
 
 float LIFCNeuron::update_membrane_potential_forward_Euler(float I) {
-    float dV = (-(Vm_mV - VRest_mV) + Rm_GOhm * (-I)) * tDiff_ms / tau_m_ms;
-    Vm_mV += dV;
+    float dV = (-(Vm() - VRest_mV) + Rm_GOhm * (-I)) * tDiff_ms / tau_m_ms;
+    Vm() += dV;
     return dV;
 }
 
@@ -309,37 +342,51 @@ void LIFCNeuron::update_membrane_potential_exponential_Euler_Rm() {
     float V_inf = (g_fAHP_nS * E_AHP_mV + g_sAHP_nS * E_AHP_mV + g_ADP_nS * E_ADP_mV + sum_gE + (1 / Rm_GOhm) * VRest_mV) /
                   (g_fAHP_nS + g_sAHP_nS + g_ADP_nS + sum_g + (1 / Rm_GOhm));
     
-    Vm_mV = V_inf + (Vm_mV - V_inf) * exp(-tDiff_ms / tau_eff);
+    Vm() = V_inf + (Vm() - V_inf) * exp(-tDiff_ms / tau_eff);
 }
 
-void LIFCNeuron::update_membrane_potential_exponential_Euler_Cm() {
-    float sum_g = 0.0;
-    float sum_gE = 0.0;
+// Sum of the receptor conductances and of their conductance * reversal
+// potential products. LIFCStateArrays adds the others in its kernels.
+void LIFCNeuron::receptor_conductance(float& sum_g, float& sum_gE) {
+    sum_g = 0.0;
+    sum_gE = 0.0;
     
     for (auto& RDataptr : LIFCReceptorDataVec) {
         sum_g += RDataptr->g();
         sum_gE += RDataptr->gE_k(); // p->g * p->E
     }
+}
+
+// Sum of all conductances and of conductance * reversal potential products.
+void LIFCNeuron::total_conductance(float& g_total, float& gE_total) {
+    float sum_g, sum_gE;
+    receptor_conductance(sum_g, sum_gE);
     
-    float g_total = g_L_nS + g_fAHP_nS + g_sAHP_nS + g_ADP_nS + sum_g;
-    float E_total = (g_L_nS * VRest_mV +
-                     g_fAHP_nS * E_AHP_mV +
-                     g_sAHP_nS * E_AHP_mV +
-                     g_ADP_nS * E_ADP_mV +
-                     sum_gE) / g_total;
+    g_total = g_L_nS + g_fAHP_nS + g_sAHP_nS + g_ADP_nS + sum_g;
+    gE_total = g_L_nS * VRest_mV +
+               g_fAHP_nS * E_AHP_mV +
+               g_sAHP_nS * E_AHP_mV +
+               g_ADP_nS * E_ADP_mV +
+               sum_gE;
+}
+
+void LIFCNeuron::update_membrane_potential_exponential_Euler_Cm() {
+    float g_total, gE_total;
+    total_conductance(g_total, gE_total);
+    float E_total = gE_total / g_total;
     
     float tau_eff = Cm_pF / g_total;
-    Vm_mV = E_total + (Vm_mV - E_total) * exp(-tDiff_ms / tau_eff);
+    Vm() = E_total + (Vm() - E_total) * exp(-tDiff_ms / tau_eff);
 }
 
 float LIFCNeuron::update_adaptive_threshold() {
-    h_spike += tDiff_ms * (1 - h_spike) / tau_h_ms;
+    h() += tDiff_ms * (1 - h()) / tau_h_ms;
     if (delta_floor_per_spike_mV > 0) {
-        Vth_floor_mV -= tDiff_ms * (Vth_floor_mV - VAct_mV) / tau_floor_decay_ms;
+        Vth_floor() -= tDiff_ms * (Vth_floor() - VAct_mV) / tau_floor_decay_ms;
     }
     float V_th_adaptive = std::max(
-        VAct_mV + dVth_mV * (1 - h_spike),
-        Vth_floor_mV
+        VAct_mV + dVth_mV * (1 - h()),
+        Vth_floor()
     );
     return V_th_adaptive;
 }
@@ -348,7 +395,7 @@ void LIFCNeuron::update_with_classical_reset_clamp(float& t) {
     float I = update_currents();
     
     if (t < (t_last_spike + tau_absref_ms)) {
-        Vm_mV = VReset_mV;
+        Vm() = VReset_mV;
         return;
     }
     
@@ -360,13 +407,30 @@ void LIFCNeuron::update_with_classical_reset_clamp(float& t) {
     check_spiking(t, V_th_adaptive);
 }
 
-void LIFCNeuron::update_with_reset_options(float& t) {
+void LIFCNeuron::reset_at_onset() {
     // (Option:) Spike onset drives membrane potential below threshold.
     if (build_data.ResetMethod == CoreStructs::ONSET) {
         if (updates_since_spike == 1) {
-            Vm_mV = VReset_mV;
+            Vm() = VReset_mV;
         }
     }
+}
+
+void LIFCNeuron::finish_with_reset_options(float& t, float dV, float V_th_adaptive) {
+    if (t >= (t_last_spike + tau_absref_ms)) {
+        // (Option:) Drive membrane potential below threshold after absolute refractory period.
+        if ((build_data.ResetMethod != CoreStructs::ONSET) && (!reset_done)) {
+            Vm() = VReset_mV + dV;
+            reset_done = true;
+        }
+        
+        // Check possible spiking:
+        check_spiking(t, V_th_adaptive);
+    }
+}
+
+void LIFCNeuron::update_with_reset_options(float& t) {
+    reset_at_onset();
     
     float dV = 0;
     if (build_data.UpdateMethod == CoreStructs::EXPEULER_CM) {
@@ -380,16 +444,7 @@ void LIFCNeuron::update_with_reset_options(float& t) {
     
     float V_th_adaptive = update_adaptive_threshold();
     
-    if (t >= (t_last_spike + tau_absref_ms)) {
-        // (Option:) Drive membrane potential below threshold after absolute refractory period.
-        if ((build_data.ResetMethod != CoreStructs::ONSET) && (!reset_done)) {
-            Vm_mV = VReset_mV + dV;
-            reset_done = true;
-        }
-        
-        // Check possible spiking:
-        check_spiking(t, V_th_adaptive);
-    }
+    finish_with_reset_options(t, dV, V_th_adaptive);
 }
 
 // Search for SrcNeuron-DstNeuron-ReceptorType triplet in LIFCReceptorDataVec.
@@ -461,12 +516,21 @@ void LIFCNeuron::Calculate_Abstracted_PSP_Medians() {
     if (Sim.ShowFunctionalParameters) Show_Functional_Parameters();
 }
 
-void LIFCNeuron::Update(float t_ms, bool recording) {
+// True if the membrane and threshold updates of this neuron can be done
+// by the LIFCStateArrays kernels instead of update_with_reset_options().
+bool LIFCNeuron::SupportsStateArrays() const {
+    return build_data.UpdateMethod == CoreStructs::EXPEULER_CM;
+}
+
+// Everything before the membrane potential integration, except for the
+// fatigue and after-potential updates, which LIFCStateArrays does in its
+// kernels. Returns false if the neuron is not updated at t_ms.
+bool LIFCNeuron::begin_update(float t_ms) {
     assert(t_ms >= 0.0);
 
     tDiff_ms = t_ms - T_ms;
-    if (tDiff_ms < 0) return;
-    Vm_prev_mV = Vm_mV; // Used for triangulate_precise_spiketimes.
+    if (tDiff_ms < 0) return false;
+    Vm_prev_mV = Vm(); // Used for triangulate_precise_spiketimes.
 
     if (is_first_update) { // Prepared once at the start of the simulation when build is complete
         if (!TDirectStim_ms.empty()) Sort_Direct_Stimulation();
@@ -474,26 +538,17 @@ void LIFCNeuron::Update(float t_ms, bool recording) {
         is_first_update = false;
     }
 
-    // Hard-cap nonlinear spiking fatigue threshold.
-    if (fatigue_threshold > 0) {
-        fatigue -= tDiff_ms / tau_fatigue_recovery_ms;
-        fatigue = std::max(fatigue, 0.0f);
-    }
-    
-    update_conductances(t_ms);
-    
-    if (build_data.UpdateMethod == CoreStructs::CLASSICAL) {
-        update_with_classical_reset_clamp(t_ms);
-    } else {
-        update_with_reset_options(t_ms);
-    }
+    update_receptor_conductances(t_ms);
+    return true;
+}
 
+// Everything after spike detection.
+void LIFCNeuron::end_update(float t_ms, bool recording) {
     // FIFO update if needed for something like Calcium imaging
-    if (!FIFO.empty()) {
-        FIFO.pop_front();
-        float v = VRest_mV - Vm_mV;
+    if (!FIFO.empty() || CaFilter.IsSet()) {
+        float v = VRest_mV - Vm();
         v = v < 0.0 ? 0.0 : v / 20.0; // *** Not clear to me what the sign and scaling should really be here.
-        FIFO.push_back(v);
+        PushCaSignal(v);
     }
 
     if (recording) {
@@ -502,8 +557,39 @@ void LIFCNeuron::Update(float t_ms, bool recording) {
 
     T_ms = t_ms; // Only update this here, because T_ms is used for triangulate_precise_spiketimes.
     updates_since_spike++; // *** Could add if (t_last_spike>=0.0) if it helps with overruns.
+}
+
+void LIFCNeuron::Update(float t_ms, bool recording) {
+    if (!begin_update(t_ms)) return;
+    update_fatigue();
+    update_afterpotential_conductances(t_ms);
+    
+    if (build_data.UpdateMethod == CoreStructs::CLASSICAL) {
+        update_with_classical_reset_clamp(t_ms);
+    } else {
+        update_with_reset_options(t_ms);
+    }
+
+    end_update(t_ms, recording);
 };
 
+void LIFCNeuron::CommitSpikes() {
+    if (TActPending_ms.empty()) return;
+
+    // Event-driven delivery, send the spikes to all postsynaptic receptors.
+    if (Sim.EventDrivenActive_) {
+        for (float tSpike_ms : TActPending_ms) {
+            for (auto& RDataptr : LIFCTransmitterDataVec) {
+                Sim.SpikeEvents_.Push(tSpike_ms + RDataptr->onset_delay_ms, RDataptr);
+            }
+        }
+    }
+
+    TAct_ms.insert(TAct_ms.end(), TActPending_ms.begin(), TActPending_ms.end());
+    TActPending_ms.clear();
+    t_last_spike_committed = t_last_spike;
+}
+
 void LIFCNeuron::InputReceptorAdded(CoreStructs::LIFCReceptorData* RData) {
     LIFCReceptorDataVec.emplace_back(RData);
 
@@ -514,6 +600,60 @@ void LIFCNeuron::OutputTransmitterAdded(CoreStructs::LIFCReceptorData* RData) {
 
 }
 
+void LIFCNeuron::SaveState(Tools::CheckpointWriter& _Writer) const {
+    BallAndStick::BSNeuron::SaveState(_Writer);
+
+    // Parameters that spikes modify.
+    _Writer.Put(VReset_mV);
+    _Writer.Put(Vth_floor());
+
+    fAHP_state.SaveState(_Writer);
+    sAHP_state.SaveState(_Writer);
+    ADP_state.SaveState(_Writer);
+    _Writer.Put(g_fAHP_nS);
+    _Writer.Put(g_sAHP_nS);
+    _Writer.Put(fatigue_level());
+    _Writer.Put(ADP_availability());
+    _Writer.Put(g_ADP_nS);
+    _Writer.Put(h());
+
+    _Writer.Put(reset_done);
+    _Writer.Put<uint64_t>(updates_since_spike);
+    _Writer.Put(t_last_spike);
+    _Writer.PutVector(TActPending_ms);
+    _Writer.Put(t_last_spike_committed);
+    _Writer.Put(tDiff_ms);
+    _Writer.Put(Vm_prev_mV);
+}
+
+bool LIFCNeuron::LoadState(Tools::CheckpointReader& _Reader) {
+    if (!BallAndStick::BSNeuron::LoadState(_Reader)) return false;
+
+    _Reader.Get(VReset_mV);
+    _Reader.Get(Vth_floor());
+
+    if (!fAHP_state.LoadState(_Reader)) return false;
+    if (!sAHP_state.LoadState(_Reader)) return false;
+    if (!ADP_state.LoadState(_Reader)) return false;
+    _Reader.Get(g_fAHP_nS);
+    _Reader.Get(g_sAHP_nS);
+    _Reader.Get(fatigue_level());
+    _Reader.Get(ADP_availability());
+    _Reader.Get(g_ADP_nS);
+    _Reader.Get(h());
+
+    uint64_t num_updates = 0;
+    _Reader.Get(reset_done);
+    if (!_Reader.Get(num_updates)) return false;
+    _Reader.Get(t_last_spike);
+    _Reader.GetVector(TActPending_ms);
+    _Reader.Get(t_last_spike_committed);
+    _Reader.Get(tDiff_ms);
+    _Reader.Get(Vm_prev_mV);
+    updates_since_spike = num_updates;
+    return _Reader.Ok();
+}
+
 const std::map<Connections::NeurotransmitterType, int> NeurotransmitterType2ConnectionType = {
     { Connections::AMPA, 1 },
     { Connections::GABA, 2 },
@@ -106,6 +106,11 @@ public:
     float norm_sAHP = 0.0;
     float norm_ADP = 0.0;
 
+    // Used instead of g_norm() with Simulation::use_recursive_conductances
+    Connections::DoubleExpState fAHP_state;
+    Connections::DoubleExpState sAHP_state;
+    Connections::DoubleExpState ADP_state;
+
     // Variables used during simulation but not initialized by parameters
     float g_fAHP_nS = 0.0;
     float g_sAHP_nS = 0.0;
@@ -117,10 +122,34 @@ public:
 
     float h_spike = 1.0; // Adaptive threshold factor
 
+    // Elements of LIFCStateArrays that hold h_spike, Vth_floor_mV, fatigue
+    // and a_ADP during a run (see also BSNeuron::Vm_bound_mV), nullptr
+    // otherwise. The fAHP, sAHP and ADP conductances are only used within
+    // the update, so the arrays keep them without binding.
+    float* h_spike_bound = nullptr;
+    float* Vth_floor_bound_mV = nullptr;
+    float* fatigue_bound = nullptr;
+    float* a_ADP_bound = nullptr;
+
+    float& h() { return h_spike_bound ? *h_spike_bound : h_spike; }
+    float h() const { return h_spike_bound ? *h_spike_bound : h_spike; }
+    float& Vth_floor() { return Vth_floor_bound_mV ? *Vth_floor_bound_mV : Vth_floor_mV; }
+    float Vth_floor() const { return Vth_floor_bound_mV ? *Vth_floor_bound_mV : Vth_floor_mV; }
+    float& fatigue_level() { return fatigue_bound ? *fatigue_bound : fatigue; }
+    float fatigue_level() const { return fatigue_bound ? *fatigue_bound : fatigue; }
+    float& ADP_availability() { return a_ADP_bound ? *a_ADP_bound : a_ADP; }
+    float ADP_availability() const { return a_ADP_bound ? *a_ADP_bound : a_ADP; }
+
     bool reset_done = true; // Only used for reset AFTER
     size_t updates_since_spike = 1000;
     float t_last_spike = -1000.0;
 
+    // Spikes of the current timestep are kept here until CommitSpikes(), so
+    // that other neurons only ever read spike state of completed timesteps
+    // from TAct_ms and t_last_spike_committed, independent of update order.
+    std::vector<float> TActPending_ms;
+    float t_last_spike_committed = -1000.0;
+
     float tDiff_ms = 0.0;
     float Vm_prev_mV = 0.0;
 
@@ -144,25 +173,43 @@ public:
 
     void spike(float t);
     void check_spiking(float& t, float V_th_adaptive);
-    void update_conductances(float t);
+    void update_fatigue();
+    void update_receptor_conductances(float t);
+    void update_afterpotential_conductances(float t);
     float update_currents();
     float update_membrane_potential_forward_Euler(float I);
     void update_membrane_potential_exponential_Euler_Rm();
+    void receptor_conductance(float& sum_g, float& sum_gE);
+    void total_conductance(float& g_total, float& gE_total);
     void update_membrane_potential_exponential_Euler_Cm();
     float update_adaptive_threshold();
     void update_with_classical_reset_clamp(float& t);
+    void reset_at_onset();
+    void finish_with_reset_options(float& t, float dV, float V_th_adaptive);
     void update_with_reset_options(float& t);
 
+    // Update() split into the phases used by LIFCStateArrays.
+    bool SupportsStateArrays() const;
+    bool begin_update(float t_ms);
+    void end_update(float t_ms, bool recording);
+
     CoreStructs::LIFCReceptorData* FindLIFCReceptorPairing(LIFCNeuron* SrcNeuronPtr, Connections::LIFCReceptor* RPtr);
     void Show_Functional_Parameters();
     void Calculate_Abstracted_PSP_Medians();
 
     virtual void Update(float t_ms, bool recording);
 
+    virtual void CommitSpikes();
+
     virtual void InputReceptorAdded(CoreStructs::LIFCReceptorData* RData);
 
     virtual void OutputTransmitterAdded(CoreStructs::LIFCReceptorData* RData);
 
+    //! Adds conductance, adaptation and pending spike state to that of
+    //! BSNeuron. Receptor state is saved by Simulation::SaveState().
+    virtual void SaveState(Tools::CheckpointWriter& _Writer) const;
+    virtual bool LoadState(Tools::CheckpointReader& _Reader);
+
     // Used in Simulation::GetConnectomeJSON().
     virtual void GetConnectomeTargetsJSON(
         nlohmann::json& targetvec, nlohmann::json& typevec,
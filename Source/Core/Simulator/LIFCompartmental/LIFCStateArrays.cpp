@@ -0,0 +1,626 @@
+#include <Simulator/LIFCompartmental/LIFCStateArrays.h>
+#include <Simulator/LIFCompartmental/LIFCNeuron.h>
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+namespace BG {
+namespace NES {
+namespace Simulator {
+
+// Constants of the Cephes expf() approximation used by the vector kernels.
+// Accurate to about 1-2 ulp over the range used here, the scalar tail and
+// the scalar build use std::exp() instead.
+namespace {
+constexpr float ExpMin = -87.3365447f; // Smallest argument with a normalized result
+constexpr float ExpMax = 88.3762626f;
+constexpr float Log2e = 1.44269504088896341f;
+constexpr float ExpC1 = 0.693359375f;
+constexpr float ExpC2 = -2.12194440e-4f;
+constexpr float ExpP0 = 1.9875691500e-4f;
+constexpr float ExpP1 = 1.3981999507e-3f;
+constexpr float ExpP2 = 8.3334519073e-3f;
+constexpr float ExpP3 = 4.1665795894e-2f;
+constexpr float ExpP4 = 1.6666665459e-1f;
+constexpr float ExpP5 = 5.0000001201e-1f;
+
+#if defined(__AVX512F__)
+inline __m512 Exp16(__m512 x) {
+    x = _mm512_min_ps(_mm512_max_ps(x, _mm512_set1_ps(ExpMin)), _mm512_set1_ps(ExpMax));
+    __m512 fx = _mm512_roundscale_ps(_mm512_add_ps(_mm512_mul_ps(x, _mm512_set1_ps(Log2e)), _mm512_set1_ps(0.5f)),
+                                     _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+    x = _mm512_sub_ps(x, _mm512_mul_ps(fx, _mm512_set1_ps(ExpC1)));
+    x = _mm512_sub_ps(x, _mm512_mul_ps(fx, _mm512_set1_ps(ExpC2)));
+    __m512 xx = _mm512_mul_ps(x, x);
+    __m512 y = _mm512_set1_ps(ExpP0);
+    y = _mm512_add_ps(_mm512_mul_ps(y, x), _mm512_set1_ps(ExpP1));
+    y = _mm512_add_ps(_mm512_mul_ps(y, x), _mm512_set1_ps(ExpP2));
+    y = _mm512_add_ps(_mm512_mul_ps(y, x), _mm512_set1_ps(ExpP3));
+    y = _mm512_add_ps(_mm512_mul_ps(y, x), _mm512_set1_ps(ExpP4));
+    y = _mm512_add_ps(_mm512_mul_ps(y, x), _mm512_set1_ps(ExpP5));
+    y = _mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(y, xx), x), _mm512_set1_ps(1.0f));
+    __m512i e = _mm512_slli_epi32(_mm512_add_epi32(_mm512_cvttps_epi32(fx), _mm512_set1_epi32(127)), 23);
+    return _mm512_mul_ps(y, _mm512_castsi512_ps(e));
+}
+
+// a * exp(-dt / tau), for one term of a DoubleExpState.
+inline __m512 Decay16(const float* _a, __m512 _neg_dt, const float* _tau) {
+    return _mm512_mul_ps(_mm512_loadu_ps(_a), Exp16(_mm512_div_ps(_neg_dt, _mm512_loadu_ps(_tau))));
+}
+
+// g_peak * ((a_decay - a_rise) / norm)
+inline __m512 Linear16(__m512 _a_rise, __m512 _a_decay, const float* _norm, const float* _g_peak) {
+    return _mm512_mul_ps(_mm512_loadu_ps(_g_peak), _mm512_div_ps(_mm512_sub_ps(_a_decay, _a_rise), _mm512_loadu_ps(_norm)));
+}
+
+// AHPCLIP or sigmoidal saturation of an AHP conductance.
+inline __m512 SaturateAHP16(__m512 _g_linear, const float* _g_max, const float* _Kd, __mmask16 _clip) {
+    __m512 g_max = _mm512_loadu_ps(_g_max);
+    __m512 sigmoid = _mm512_mul_ps(g_max, _mm512_div_ps(_g_linear, _mm512_add_ps(_g_linear, _mm512_loadu_ps(_Kd))));
+    return _mm512_mask_blend_ps(_clip, sigmoid, _mm512_min_ps(_g_linear, g_max));
+}
+#elif defined(__AVX2__)
+inline __m256 Exp8(__m256 x) {
+    x = _mm256_min_ps(_mm256_max_ps(x, _mm256_set1_ps(ExpMin)), _mm256_set1_ps(ExpMax));
+    __m256 fx = _mm256_floor_ps(_mm256_add_ps(_mm256_mul_ps(x, _mm256_set1_ps(Log2e)), _mm256_set1_ps(0.5f)));
+    x = _mm256_sub_ps(x, _mm256_mul_ps(fx, _mm256_set1_ps(ExpC1)));
+    x = _mm256_sub_ps(x, _mm256_mul_ps(fx, _mm256_set1_ps(ExpC2)));
+    __m256 xx = _mm256_mul_ps(x, x);
+    __m256 y = _mm256_set1_ps(ExpP0);
+    y = _mm256_add_ps(_mm256_mul_ps(y, x), _mm256_set1_ps(ExpP1));
+    y = _mm256_add_ps(_mm256_mul_ps(y, x), _mm256_set1_ps(ExpP2));
+    y = _mm256_add_ps(_mm256_mul_ps(y, x), _mm256_set1_ps(ExpP3));
+    y = _mm256_add_ps(_mm256_mul_ps(y, x), _mm256_set1_ps(ExpP4));
+    y = _mm256_add_ps(_mm256_mul_ps(y, x), _mm256_set1_ps(ExpP5));
+    y = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(y, xx), x), _mm256_set1_ps(1.0f));
+    __m256i e = _mm256_slli_epi32(_mm256_add_epi32(_mm256_cvttps_epi32(fx), _mm256_set1_epi32(127)), 23);
+    return _mm256_mul_ps(y, _mm256_castsi256_ps(e));
+}
+
+// a * exp(-dt / tau), for one term of a DoubleExpState.
+inline __m256 Decay8(const float* _a, __m256 _neg_dt, const float* _tau) {
+    return _mm256_mul_ps(_mm256_loadu_ps(_a), Exp8(_mm256_div_ps(_neg_dt, _mm256_loadu_ps(_tau))));
+}
+
+// g_peak * ((a_decay - a_rise) / norm)
+inline __m256 Linear8(__m256 _a_rise, __m256 _a_decay, const float* _norm, const float* _g_peak) {
+    return _mm256_mul_ps(_mm256_loadu_ps(_g_peak), _mm256_div_ps(_mm256_sub_ps(_a_decay, _a_rise), _mm256_loadu_ps(_norm)));
+}
+
+// AHPCLIP or sigmoidal saturation of an AHP conductance.
+inline __m256 SaturateAHP8(__m256 _g_linear, const float* _g_max, const float* _Kd, __m256 _clip) {
+    __m256 g_max = _mm256_loadu_ps(_g_max);
+    __m256 sigmoid = _mm256_mul_ps(g_max, _mm256_div_ps(_g_linear, _mm256_add_ps(_g_linear, _mm256_loadu_ps(_Kd))));
+    return _mm256_blendv_ps(sigmoid, _mm256_min_ps(_g_linear, g_max), _clip);
+}
+#endif
+
+// Leaves a DoubleExpState as LIFCNeuron::update_afterpotential_conductances()
+// would have, with the spikes from _NextSpikeIdx on still to be added.
+void StoreDoubleExpState(Connections::DoubleExpState& _State, float _a_rise, float _a_decay, float _t_ms, size_t _NextSpikeIdx) {
+    _State.a_rise = _a_rise;
+    _State.a_decay = _a_decay;
+    _State.t_last_ms = _t_ms;
+    _State.next_spike_idx = _NextSpikeIdx;
+    _State.arrivals_ms.clear();
+}
+} // namespace
+
+void LIFCExpEulerCmKernel(size_t _Start, size_t _End, float* _Vm_mV, const float* _g_total_nS,
+                          const float* _gE_total, const float* _Cm_pF, const float* _tDiff_ms) {
+    size_t i = _Start;
+
+    // Same operation order as the scalar update:
+    //   E_total = gE_total / g_total, tau_eff = Cm / g_total,
+    //   Vm = E_total + (Vm - E_total) * exp(-tDiff / tau_eff)
+#if defined(__AVX512F__)
+    for (; i + 16 <= _End; i += 16) {
+        __m512 g = _mm512_loadu_ps(_g_total_nS + i);
+        __m512 E = _mm512_div_ps(_mm512_loadu_ps(_gE_total + i), g);
+        __m512 tau_eff = _mm512_div_ps(_mm512_loadu_ps(_Cm_pF + i), g);
+        __m512 x = _mm512_div_ps(_mm512_sub_ps(_mm512_setzero_ps(), _mm512_loadu_ps(_tDiff_ms + i)), tau_eff);
+        __m512 Vm = _mm512_loadu_ps(_Vm_mV + i);
+        _mm512_storeu_ps(_Vm_mV + i, _mm512_add_ps(E, _mm512_mul_ps(_mm512_sub_ps(Vm, E), Exp16(x))));
+    }
+#elif defined(__AVX2__)
+    for (; i + 8 <= _End; i += 8) {
+        __m256 g = _mm256_loadu_ps(_g_total_nS + i);
+        __m256 E = _mm256_div_ps(_mm256_loadu_ps(_gE_total + i), g);
+        __m256 tau_eff = _mm256_div_ps(_mm256_loadu_ps(_Cm_pF + i), g);
+        __m256 x = _mm256_div_ps(_mm256_sub_ps(_mm256_setzero_ps(), _mm256_loadu_ps(_tDiff_ms + i)), tau_eff);
+        __m256 Vm = _mm256_loadu_ps(_Vm_mV + i);
+        _mm256_storeu_ps(_Vm_mV + i, _mm256_add_ps(E, _mm256_mul_ps(_mm256_sub_ps(Vm, E), Exp8(x))));
+    }
+#endif
+
+    for (; i < _End; i++) {
+        float E_total = _gE_total[i] / _g_total_nS[i];
+        float tau_eff = _Cm_pF[i] / _g_total_nS[i];
+        _Vm_mV[i] = E_total + (_Vm_mV[i] - E_total) * std::exp(-_tDiff_ms[i] / tau_eff);
+    }
+}
+
+void LIFCAdaptiveThresholdKernel(size_t _Start, size_t _End, float* _h_spike, float* _Vth_floor_mV,
+                                 float* _Vth_adaptive_mV, const float* _VAct_mV, const float* _dVth_mV, const float* _tau_h_ms,
+                                 const float* _delta_floor_per_spike_mV, const float* _tau_floor_decay_ms, const float* _tDiff_ms) {
+    size_t i = _Start;
+
+#if defined(__AVX512F__)
+    const __m512 one = _mm512_set1_ps(1.0f);
+    for (; i + 16 <= _End; i += 16) {
+        __m512 dt = _mm512_loadu_ps(_tDiff_ms + i);
+        __m512 VAct = _mm512_loadu_ps(_VAct_mV + i);
+        __m512 h = _mm512_loadu_ps(_h_spike + i);
+        h = _mm512_add_ps(h, _mm512_div_ps(_mm512_mul_ps(dt, _mm512_sub_ps(one, h)), _mm512_loadu_ps(_tau_h_ms + i)));
+        _mm512_storeu_ps(_h_spike + i, h);
+
+        __m512 floor = _mm512_loadu_ps(_Vth_floor_mV + i);
+        __m512 decayed = _mm512_sub_ps(floor, _mm512_div_ps(_mm512_mul_ps(dt, _mm512_sub_ps(floor, VAct)), _mm512_loadu_ps(_tau_floor_decay_ms + i)));
+        __mmask16 floor_on = _mm512_cmp_ps_mask(_mm512_loadu_ps(_delta_floor_per_spike_mV + i), _mm512_setzero_ps(), _CMP_GT_OQ);
+        floor = _mm512_mask_blend_ps(floor_on, floor, decayed);
+        _mm512_storeu_ps(_Vth_floor_mV + i, floor);
+
+        __m512 Vth = _mm512_add_ps(VAct, _mm512_mul_ps(_mm512_loadu_ps(_dVth_mV + i), _mm512_sub_ps(one, h)));
+        _mm512_storeu_ps(_Vth_adaptive_mV + i, _mm512_max_ps(Vth, floor));
+    }
+#elif defined(__AVX2__)
+    const __m256 one = _mm256_set1_ps(1.0f);
+    for (; i + 8 <= _End; i += 8) {
+        __m256 dt = _mm256_loadu_ps(_tDiff_ms + i);
+        __m256 VAct = _mm256_loadu_ps(_VAct_mV + i);
+        __m256 h = _mm256_loadu_ps(_h_spike + i);
+        h = _mm256_add_ps(h, _mm256_div_ps(_mm256_mul_ps(dt, _mm256_sub_ps(one, h)), _mm256_loadu_ps(_tau_h_ms + i)));
+        _mm256_storeu_ps(_h_spike + i, h);
+
+        __m256 floor = _mm256_loadu_ps(_Vth_floor_mV + i);
+        __m256 decayed = _mm256_sub_ps(floor, _mm256_div_ps(_mm256_mul_ps(dt, _mm256_sub_ps(floor, VAct)), _mm256_loadu_ps(_tau_floor_decay_ms + i)));
+        __m256 floor_on = _mm256_cmp_ps(_mm256_loadu_ps(_delta_floor_per_spike_mV + i), _mm256_setzero_ps(), _CMP_GT_OQ);
+        floor = _mm256_blendv_ps(floor, decayed, floor_on);
+        _mm256_storeu_ps(_Vth_floor_mV + i, floor);
+
+        __m256 Vth = _mm256_add_ps(VAct, _mm256_mul_ps(_mm256_loadu_ps(_dVth_mV + i), _mm256_sub_ps(one, h)));
+        _mm256_storeu_ps(_Vth_adaptive_mV + i, _mm256_max_ps(Vth, floor));
+    }
+#endif
+
+    for (; i < _End; i++) {
+        _h_spike[i] += _tDiff_ms[i] * (1 - _h_spike[i]) / _tau_h_ms[i];
+        if (_delta_floor_per_spike_mV[i] > 0) {
+            _Vth_floor_mV[i] -= _tDiff_ms[i] * (_Vth_floor_mV[i] - _VAct_mV[i]) / _tau_floor_decay_ms[i];
+        }
+        _Vth_adaptive_mV[i] = std::max(_VAct_mV[i] + _dVth_mV[i] * (1 - _h_spike[i]), _Vth_floor_mV[i]);
+    }
+}
+
+void LIFCAfterPotentialKernel(size_t _Start, size_t _End, const LIFCAfterPotentialArrays& _Arrays,
+                              float* _g_total_nS, float* _gE_total, const float* _dt_ms, const float* _tDiff_ms) {
+    const LIFCAfterPotentialArrays& A = _Arrays;
+    size_t i = _Start;
+
+#if defined(__AVX512F__)
+    const __m512 zero = _mm512_setzero_ps();
+    const __m512 one = _mm512_set1_ps(1.0f);
+    for (; i + 16 <= _End; i += 16) {
+        __m512 tDiff = _mm512_loadu_ps(_tDiff_ms + i);
+        __m512 neg_dt = _mm512_sub_ps(zero, _mm512_loadu_ps(_dt_ms + i));
+
+        __m512 fatigue = _mm512_loadu_ps(A.fatigue + i);
+        __m512 recovered = _mm512_max_ps(_mm512_sub_ps(fatigue, _mm512_div_ps(tDiff, _mm512_loadu_ps(A.tau_fatigue_recovery_ms + i))), zero);
+        __mmask16 fatigue_on = _mm512_cmp_ps_mask(_mm512_loadu_ps(A.fatigue_threshold + i), zero, _CMP_GT_OQ);
+        _mm512_storeu_ps(A.fatigue + i, _mm512_mask_blend_ps(fatigue_on, fatigue, recovered));
+
+        __m512 rise_fAHP = Decay16(A.a_rise_fAHP + i, neg_dt, A.tau_rise_fAHP_ms + i);
+        __m512 decay_fAHP = Decay16(A.a_decay_fAHP + i, neg_dt, A.tau_decay_fAHP_ms + i);
+        __m512 rise_sAHP = Decay16(A.a_rise_sAHP + i, neg_dt, A.tau_rise_sAHP_ms + i);
+        __m512 decay_sAHP = Decay16(A.a_decay_sAHP + i, neg_dt, A.tau_decay_sAHP_ms + i);
+        __m512 rise_ADP = Decay16(A.a_rise_ADP + i, neg_dt, A.tau_rise_ADP_ms + i);
+        __m512 decay_ADP = Decay16(A.a_decay_ADP + i, neg_dt, A.tau_decay_ADP_ms + i);
+        _mm512_storeu_ps(A.a_rise_fAHP + i, rise_fAHP);
+        _mm512_storeu_ps(A.a_decay_fAHP + i, decay_fAHP);
+        _mm512_storeu_ps(A.a_rise_sAHP + i, rise_sAHP);
+        _mm512_storeu_ps(A.a_decay_sAHP + i, decay_sAHP);
+        _mm512_storeu_ps(A.a_rise_ADP + i, rise_ADP);
+        _mm512_storeu_ps(A.a_decay_ADP + i, decay_ADP);
+
+        __mmask16 AHP_clip = _mm512_cmp_ps_mask(_mm512_loadu_ps(A.AHP_clip + i), zero, _CMP_GT_OQ);
+        __m512 g_fAHP = SaturateAHP16(Linear16(rise_fAHP, decay_fAHP, A.norm_fAHP + i, A.g_peak_fAHP_nS + i),
+                                      A.g_peak_fAHP_max_nS + i, A.Kd_fAHP_nS + i, AHP_clip);
+        __m512 g_sAHP = SaturateAHP16(Linear16(rise_sAHP, decay_sAHP, A.norm_sAHP + i, A.g_peak_sAHP_nS + i),
+                                      A.g_peak_sAHP_max_nS + i, A.Kd_sAHP_nS + i, AHP_clip);
+
+        __mmask16 ADP_clip = _mm512_cmp_ps_mask(_mm512_loadu_ps(A.ADP_clip + i), zero, _CMP_GT_OQ);
+        __m512 g_ADP_linear = Linear16(rise_ADP, decay_ADP, A.norm_ADP + i, A.g_peak_ADP_nS + i);
+        __m512 a = _mm512_loadu_ps(A.a_ADP + i);
+        __m512 a_recovered = _mm512_add_ps(a, _mm512_div_ps(_mm512_mul_ps(_mm512_sub_ps(one, a), tDiff), _mm512_loadu_ps(A.tau_recovery_ADP_ms + i)));
+        a_recovered = _mm512_max_ps(zero, _mm512_min_ps(one, a_recovered));
+        _mm512_storeu_ps(A.a_ADP + i, _mm512_mask_blend_ps(ADP_clip, a_recovered, a));
+        __m512 g_ADP = _mm512_mask_blend_ps(ADP_clip, _mm512_mul_ps(a_recovered, g_ADP_linear),
+                                            _mm512_min_ps(g_ADP_linear, _mm512_loadu_ps(A.g_peak_ADP_max_nS + i)));
+        _mm512_storeu_ps(A.g_fAHP_nS + i, g_fAHP);
+        _mm512_storeu_ps(A.g_sAHP_nS + i, g_sAHP);
+        _mm512_storeu_ps(A.g_ADP_nS + i, g_ADP);
+
+        __m512 g_L = _mm512_loadu_ps(A.g_L_nS + i);
+        __m512 E_AHP = _mm512_loadu_ps(A.E_AHP_mV + i);
+        __m512 g_total = _mm512_add_ps(_mm512_add_ps(_mm512_add_ps(_mm512_add_ps(g_L, g_fAHP), g_sAHP), g_ADP), _mm512_loadu_ps(_g_total_nS + i));
+        __m512 gE_total = _mm512_add_ps(_mm512_mul_ps(g_L, _mm512_loadu_ps(A.VRest_mV + i)), _mm512_mul_ps(g_fAHP, E_AHP));
+        gE_total = _mm512_add_ps(gE_total, _mm512_mul_ps(g_sAHP, E_AHP));
+        gE_total = _mm512_add_ps(gE_total, _mm512_mul_ps(g_ADP, _mm512_loadu_ps(A.E_ADP_mV + i)));
+        _mm512_storeu_ps(_g_total_nS + i, g_total);
+        _mm512_storeu_ps(_gE_total + i, _mm512_add_ps(gE_total, _mm512_loadu_ps(_gE_total + i)));
+    }
+#elif defined(__AVX2__)
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 one = _mm256_set1_ps(1.0f);
+    for (; i + 8 <= _End; i += 8) {
+        __m256 tDiff = _mm256_loadu_ps(_tDiff_ms + i);
+        __m256 neg_dt = _mm256_sub_ps(zero, _mm256_loadu_ps(_dt_ms + i));
+
+        __m256 fatigue = _mm256_loadu_ps(A.fatigue + i);
+        __m256 recovered = _mm256_max_ps(_mm256_sub_ps(fatigue, _mm256_div_ps(tDiff, _mm256_loadu_ps(A.tau_fatigue_recovery_ms + i))), zero);
+        __m256 fatigue_on = _mm256_cmp_ps(_mm256_loadu_ps(A.fatigue_threshold + i), zero, _CMP_GT_OQ);
+        _mm256_storeu_ps(A.fatigue + i, _mm256_blendv_ps(fatigue, recovered, fatigue_on));
+
+        __m256 rise_fAHP = Decay8(A.a_rise_fAHP + i, neg_dt, A.tau_rise_fAHP_ms + i);
+        __m256 decay_fAHP = Decay8(A.a_decay_fAHP + i, neg_dt, A.tau_decay_fAHP_ms + i);
+        __m256 rise_sAHP = Decay8(A.a_rise_sAHP + i, neg_dt, A.tau_rise_sAHP_ms + i);
+        __m256 decay_sAHP = Decay8(A.a_decay_sAHP + i, neg_dt, A.tau_decay_sAHP_ms + i);
+        __m256 rise_ADP = Decay8(A.a_rise_ADP + i, neg_dt, A.tau_rise_ADP_ms + i);
+        __m256 decay_ADP = Decay8(A.a_decay_ADP + i, neg_dt, A.tau_decay_ADP_ms + i);
+        _mm256_storeu_ps(A.a_rise_fAHP + i, rise_fAHP);
+        _mm256_storeu_ps(A.a_decay_fAHP + i, decay_fAHP);
+        _mm256_storeu_ps(A.a_rise_sAHP + i, rise_sAHP);
+        _mm256_storeu_ps(A.a_decay_sAHP + i, decay_sAHP);
+        _mm256_storeu_ps(A.a_rise_ADP + i, rise_ADP);
+        _mm256_storeu_ps(A.a_decay_ADP + i, decay_ADP);
+
+        __m256 AHP_clip = _mm256_cmp_ps(_mm256_loadu_ps(A.AHP_clip + i), zero, _CMP_GT_OQ);
+        __m256 g_fAHP = SaturateAHP8(Linear8(rise_fAHP, decay_fAHP, A.norm_fAHP + i, A.g_peak_fAHP_nS + i),
+                                     A.g_peak_fAHP_max_nS + i, A.Kd_fAHP_nS + i, AHP_clip);
+        __m256 g_sAHP = SaturateAHP8(Linear8(rise_sAHP, decay_sAHP, A.norm_sAHP + i, A.g_peak_sAHP_nS + i),
+                                     A.g_peak_sAHP_max_nS + i, A.Kd_sAHP_nS + i, AHP_clip);
+
+        __m256 ADP_clip = _mm256_cmp_ps(_mm256_loadu_ps(A.ADP_clip + i), zero, _CMP_GT_OQ);
+        __m256 g_ADP_linear = Linear8(rise_ADP, decay_ADP, A.norm_ADP + i, A.g_peak_ADP_nS + i);
+        __m256 a = _mm256_loadu_ps(A.a_ADP + i);
+        __m256 a_recovered = _mm256_add_ps(a, _mm256_div_ps(_mm256_mul_ps(_mm256_sub_ps(one, a), tDiff), _mm256_loadu_ps(A.tau_recovery_ADP_ms + i)));
+        a_recovered = _mm256_max_ps(zero, _mm256_min_ps(one, a_recovered));
+        _mm256_storeu_ps(A.a_ADP + i, _mm256_blendv_ps(a_recovered, a, ADP_clip));
+        __m256 g_ADP = _mm256_blendv_ps(_mm256_mul_ps(a_recovered, g_ADP_linear),
+                                        _mm256_min_ps(g_ADP_linear, _mm256_loadu_ps(A.g_peak_ADP_max_nS + i)), ADP_clip);
+        _mm256_storeu_ps(A.g_fAHP_nS + i, g_fAHP);
+        _mm256_storeu_ps(A.g_sAHP_nS + i, g_sAHP);
+        _mm256_storeu_ps(A.g_ADP_nS + i, g_ADP);
+
+        __m256 g_L = _mm256_loadu_ps(A.g_L_nS + i);
+        __m256 E_AHP = _mm256_loadu_ps(A.E_AHP_mV + i);
+        __m256 g_total = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_add_ps(g_L, g_fAHP), g_sAHP), g_ADP), _mm256_loadu_ps(_g_total_nS + i));
+        __m256 gE_total = _mm256_add_ps(_mm256_mul_ps(g_L, _mm256_loadu_ps(A.VRest_mV + i)), _mm256_mul_ps(g_fAHP, E_AHP));
+        gE_total = _mm256_add_ps(gE_total, _mm256_mul_ps(g_sAHP, E_AHP));
+        gE_total = _mm256_add_ps(gE_total, _mm256_mul_ps(g_ADP, _mm256_loadu_ps(A.E_ADP_mV + i)));
+        _mm256_storeu_ps(_g_total_nS + i, g_total);
+        _mm256_storeu_ps(_gE_total + i, _mm256_add_ps(gE_total, _mm256_loadu_ps(_gE_total + i)));
+    }
+#endif
+
+    for (; i < _End; i++) {
+        if (A.fatigue_threshold[i] > 0) {
+            A.fatigue[i] -= _tDiff_ms[i] / A.tau_fatigue_recovery_ms[i];
+            A.fatigue[i] = std::max(A.fatigue[i], 0.0f);
+        }
+
+        A.a_rise_fAHP[i] *= std::exp(-_dt_ms[i] / A.tau_rise_fAHP_ms[i]);
+        A.a_decay_fAHP[i] *= std::exp(-_dt_ms[i] / A.tau_decay_fAHP_ms[i]);
+        A.a_rise_sAHP[i] *= std::exp(-_dt_ms[i] / A.tau_rise_sAHP_ms[i]);
+        A.a_decay_sAHP[i] *= std::exp(-_dt_ms[i] / A.tau_decay_sAHP_ms[i]);
+        A.a_rise_ADP[i] *= std::exp(-_dt_ms[i] / A.tau_rise_ADP_ms[i]);
+        A.a_decay_ADP[i] *= std::exp(-_dt_ms[i] / A.tau_decay_ADP_ms[i]);
+
+        float g_fAHP_linear = A.g_peak_fAHP_nS[i] * ((A.a_decay_fAHP[i] - A.a_rise_fAHP[i]) / A.norm_fAHP[i]);
+        float g_sAHP_linear = A.g_peak_sAHP_nS[i] * ((A.a_decay_sAHP[i] - A.a_rise_sAHP[i]) / A.norm_sAHP[i]);
+        float g_ADP_linear = A.g_peak_ADP_nS[i] * ((A.a_decay_ADP[i] - A.a_rise_ADP[i]) / A.norm_ADP[i]);
+        if (A.AHP_clip[i] > 0) {
+            A.g_fAHP_nS[i] = std::min(g_fAHP_linear, A.g_peak_fAHP_max_nS[i]);
+            A.g_sAHP_nS[i] = std::min(g_sAHP_linear, A.g_peak_sAHP_max_nS[i]);
+        } else {
+            A.g_fAHP_nS[i] = A.g_peak_fAHP_max_nS[i] * (g_fAHP_linear / (g_fAHP_linear + A.Kd_fAHP_nS[i]));
+            A.g_sAHP_nS[i] = A.g_peak_sAHP_max_nS[i] * (g_sAHP_linear / (g_sAHP_linear + A.Kd_sAHP_nS[i]));
+        }
+        if (A.ADP_clip[i] > 0) {
+            A.g_ADP_nS[i] = std::min(g_ADP_linear, A.g_peak_ADP_max_nS[i]);
+        } else {
+            A.a_ADP[i] = A.a_ADP[i] + (1 - A.a_ADP[i]) * _tDiff_ms[i] / A.tau_recovery_ADP_ms[i];
+            A.a_ADP[i] = std::max(0.0f, std::min(1.0f, A.a_ADP[i]));
+            A.g_ADP_nS[i] = A.a_ADP[i] * g_ADP_linear;
+        }
+
+        _g_total_nS[i] = A.g_L_nS[i] + A.g_fAHP_nS[i] + A.g_sAHP_nS[i] + A.g_ADP_nS[i] + _g_total_nS[i];
+        _gE_total[i] = A.g_L_nS[i] * A.VRest_mV[i] +
+                       A.g_fAHP_nS[i] * A.E_AHP_mV[i] +
+                       A.g_sAHP_nS[i] * A.E_AHP_mV[i] +
+                       A.g_ADP_nS[i] * A.E_ADP_mV[i] +
+                       _gE_total[i];
+    }
+}
+
+
+
+void LIFCStateArrays::Build(const std::vector<std::shared_ptr<CoreStructs::Neuron>>& _Neurons) {
+    Release();
+    KernelNeurons_.clear();
+    OtherNeurons_.clear();
+
+    for (auto& NeuronPtr : _Neurons) {
+        if (!NeuronPtr) {
+            continue;
+        }
+        LIFCNeuron* LIFCNeuronPtr = dynamic_cast<LIFCNeuron*>(NeuronPtr.get());
+        if ((LIFCNeuronPtr != nullptr) && LIFCNeuronPtr->SupportsStateArrays()) {
+            KernelNeurons_.push_back(LIFCNeuronPtr);
+        } else {
+            OtherNeurons_.push_back(NeuronPtr.get());
+        }
+    }
+
+    // The arrays must not be reallocated while the neurons are bound.
+    size_t N = KernelNeurons_.size();
+    for (AlignedFloatVec* Array : { &Cm_pF_, &VAct_mV_, &dVth_mV_, &tau_h_ms_, &delta_floor_per_spike_mV_, &tau_floor_decay_ms_,
+                                    &tau_rise_fAHP_ms_, &tau_decay_fAHP_ms_, &norm_fAHP_, &g_peak_fAHP_nS_, &g_peak_fAHP_max_nS_, &Kd_fAHP_nS_,
+                                    &tau_rise_sAHP_ms_, &tau_decay_sAHP_ms_, &norm_sAHP_, &g_peak_sAHP_nS_, &g_peak_sAHP_max_nS_, &Kd_sAHP_nS_,
+                                    &tau_rise_ADP_ms_, &tau_decay_ADP_ms_, &norm_ADP_, &g_peak_ADP_nS_, &g_peak_ADP_max_nS_, &tau_recovery_ADP_ms_,
+                                    &AHP_clip_, &ADP_clip_, &fatigue_threshold_, &tau_fatigue_recovery_ms_,
+                                    &g_L_nS_, &VRest_mV_, &E_AHP_mV_, &E_ADP_mV_,
+                                    &Vm_mV_, &h_spike_, &Vth_floor_mV_, &fatigue_, &a_ADP_,
+                                    &a_rise_fAHP_, &a_decay_fAHP_, &a_rise_sAHP_, &a_decay_sAHP_, &a_rise_ADP_, &a_decay_ADP_,
+                                    &g_fAHP_nS_, &g_sAHP_nS_, &g_ADP_nS_, &tAfterPotential_ms_,
+                                    &tDiff_ms_, &dtAfterPotential_ms_, &g_total_nS_, &gE_total_, &Vth_adaptive_mV_ }) {
+        Array->assign(N, 0.0f);
+    }
+    NextSpikeIdx_.assign(N, 0);
+    Active_.assign(N, 0);
+
+    for (size_t i = 0; i < N; i++) {
+        LIFCNeuron* NeuronPtr = KernelNeurons_[i];
+        Cm_pF_[i] = NeuronPtr->Cm_pF;
+        VAct_mV_[i] = NeuronPtr->VAct_mV;
+        dVth_mV_[i] = NeuronPtr->dVth_mV;
+        tau_h_ms_[i] = NeuronPtr->tau_h_ms;
+        delta_floor_per_spike_mV_[i] = NeuronPtr->delta_floor_per_spike_mV;
+        tau_floor_decay_ms_[i] = NeuronPtr->tau_floor_decay_ms;
+        tau_rise_fAHP_ms_[i] = NeuronPtr->tau_rise_fAHP_ms;
+        tau_decay_fAHP_ms_[i] = NeuronPtr->tau_decay_fAHP_ms;
+        norm_fAHP_[i] = NeuronPtr->norm_fAHP;
+        g_peak_fAHP_nS_[i] = NeuronPtr->g_peak_fAHP_nS;
+        g_peak_fAHP_max_nS_[i] = NeuronPtr->g_peak_fAHP_max_nS;
+        Kd_fAHP_nS_[i] = NeuronPtr->Kd_fAHP_nS;
+        tau_rise_sAHP_ms_[i] = NeuronPtr->tau_rise_sAHP_ms;
+        tau_decay_sAHP_ms_[i] = NeuronPtr->tau_decay_sAHP_ms;
+        norm_sAHP_[i] = NeuronPtr->norm_sAHP;
+        g_peak_sAHP_nS_[i] = NeuronPtr->g_peak_sAHP_nS;
+        g_peak_sAHP_max_nS_[i] = NeuronPtr->g_peak_sAHP_max_nS;
+        Kd_sAHP_nS_[i] = NeuronPtr->Kd_sAHP_nS;
+        tau_rise_ADP_ms_[i] = NeuronPtr->tau_rise_ADP_ms;
+        tau_decay_ADP_ms_[i] = NeuronPtr->tau_decay_ADP_ms;
+        norm_ADP_[i] = NeuronPtr->norm_ADP;
+        g_peak_ADP_nS_[i] = NeuronPtr->g_peak_ADP_nS;
+        g_peak_ADP_max_nS_[i] = NeuronPtr->g_peak_ADP_max_nS;
+        tau_recovery_ADP_ms_[i] = NeuronPtr->tau_recovery_ADP_ms;
+        AHP_clip_[i] = (NeuronPtr->build_data.AfterHyperpolarizationSaturationModel == CoreStructs::AHPCLIP) ? 1.0f : 0.0f;
+        ADP_clip_[i] = (NeuronPtr->build_data.AfterDepolarizationSaturationModel == CoreStructs::ADPCLIP) ? 1.0f : 0.0f;
+        fatigue_threshold_[i] = NeuronPtr->fatigue_threshold;
+        tau_fatigue_recovery_ms_[i] = NeuronPtr->tau_fatigue_recovery_ms;
+        g_L_nS_[i] = NeuronPtr->g_L_nS;
+        VRest_mV_[i] = NeuronPtr->VRest_mV;
+        E_AHP_mV_[i] = NeuronPtr->E_AHP_mV;
+        E_ADP_mV_[i] = NeuronPtr->E_ADP_mV;
+
+        Vm_mV_[i] = NeuronPtr->Vm_mV;
+        h_spike_[i] = NeuronPtr->h_spike;
+        Vth_floor_mV_[i] = NeuronPtr->Vth_floor_mV;
+        fatigue_[i] = NeuronPtr->fatigue;
+        a_ADP_[i] = NeuronPtr->a_ADP;
+        g_fAHP_nS_[i] = NeuronPtr->g_fAHP_nS;
+        g_sAHP_nS_[i] = NeuronPtr->g_sAHP_nS;
+        g_ADP_nS_[i] = NeuronPtr->g_ADP_nS;
+        NeuronPtr->Vm_bound_mV = &Vm_mV_[i];
+        NeuronPtr->h_spike_bound = &h_spike_[i];
+        NeuronPtr->Vth_floor_bound_mV = &Vth_floor_mV_[i];
+        NeuronPtr->fatigue_bound = &fatigue_[i];
+        NeuronPtr->a_ADP_bound = &a_ADP_[i];
+
+        // Brings the after-potential terms up to date with all spikes so
+        // far, at a time no earlier than either their last update or the
+        // neuron's, so that BeginBlock() only has to add new spikes.
+        float t_ms = std::max({ NeuronPtr->T_ms, NeuronPtr->fAHP_state.t_last_ms,
+                                NeuronPtr->sAHP_state.t_last_ms, NeuronPtr->ADP_state.t_last_ms });
+        NeuronPtr->fAHP_state.Update(t_ms, NeuronPtr->TAct_ms, NeuronPtr->tau_rise_fAHP_ms, NeuronPtr->tau_decay_fAHP_ms, NeuronPtr->norm_fAHP, 0);
+        NeuronPtr->sAHP_state.Update(t_ms, NeuronPtr->TAct_ms, NeuronPtr->tau_rise_sAHP_ms, NeuronPtr->tau_decay_sAHP_ms, NeuronPtr->norm_sAHP, 0);
+        NeuronPtr->ADP_state.Update(t_ms, NeuronPtr->TAct_ms, NeuronPtr->tau_rise_ADP_ms, NeuronPtr->tau_decay_ADP_ms, NeuronPtr->norm_ADP, 0);
+        a_rise_fAHP_[i] = NeuronPtr->fAHP_state.a_rise;
+        a_decay_fAHP_[i] = NeuronPtr->fAHP_state.a_decay;
+        a_rise_sAHP_[i] = NeuronPtr->sAHP_state.a_rise;
+        a_decay_sAHP_[i] = NeuronPtr->sAHP_state.a_decay;
+        a_rise_ADP_[i] = NeuronPtr->ADP_state.a_rise;
+        a_decay_ADP_[i] = NeuronPtr->ADP_state.a_decay;
+        tAfterPotential_ms_[i] = t_ms;
+        NextSpikeIdx_[i] = NeuronPtr->TAct_ms.size();
+    }
+
+    AfterPotential_.a_rise_fAHP = a_rise_fAHP_.data();
+    AfterPotential_.a_decay_fAHP = a_decay_fAHP_.data();
+    AfterPotential_.a_rise_sAHP = a_rise_sAHP_.data();
+    AfterPotential_.a_decay_sAHP = a_decay_sAHP_.data();
+    AfterPotential_.a_rise_ADP = a_rise_ADP_.data();
+    AfterPotential_.a_decay_ADP = a_decay_ADP_.data();
+    AfterPotential_.fatigue = fatigue_.data();
+    AfterPotential_.a_ADP = a_ADP_.data();
+    AfterPotential_.g_fAHP_nS = g_fAHP_nS_.data();
+    AfterPotential_.g_sAHP_nS = g_sAHP_nS_.data();
+    AfterPotential_.g_ADP_nS = g_ADP_nS_.data();
+    AfterPotential_.tau_rise_fAHP_ms = tau_rise_fAHP_ms_.data();
+    AfterPotential_.tau_decay_fAHP_ms = tau_decay_fAHP_ms_.data();
+    AfterPotential_.norm_fAHP = norm_fAHP_.data();
+    AfterPotential_.g_peak_fAHP_nS = g_peak_fAHP_nS_.data();
+    AfterPotential_.g_peak_fAHP_max_nS = g_peak_fAHP_max_nS_.data();
+    AfterPotential_.Kd_fAHP_nS = Kd_fAHP_nS_.data();
+    AfterPotential_.tau_rise_sAHP_ms = tau_rise_sAHP_ms_.data();
+    AfterPotential_.tau_decay_sAHP_ms = tau_decay_sAHP_ms_.data();
+    AfterPotential_.norm_sAHP = norm_sAHP_.data();
+    AfterPotential_.g_peak_sAHP_nS = g_peak_sAHP_nS_.data();
+    AfterPotential_.g_peak_sAHP_max_nS = g_peak_sAHP_max_nS_.data();
+    AfterPotential_.Kd_sAHP_nS = Kd_sAHP_nS_.data();
+    AfterPotential_.tau_rise_ADP_ms = tau_rise_ADP_ms_.data();
+    AfterPotential_.tau_decay_ADP_ms = tau_decay_ADP_ms_.data();
+    AfterPotential_.norm_ADP = norm_ADP_.data();
+    AfterPotential_.g_peak_ADP_nS = g_peak_ADP_nS_.data();
+    AfterPotential_.g_peak_ADP_max_nS = g_peak_ADP_max_nS_.data();
+    AfterPotential_.tau_recovery_ADP_ms = tau_recovery_ADP_ms_.data();
+    AfterPotential_.AHP_clip = AHP_clip_.data();
+    AfterPotential_.ADP_clip = ADP_clip_.data();
+    AfterPotential_.fatigue_threshold = fatigue_threshold_.data();
+    AfterPotential_.tau_fatigue_recovery_ms = tau_fatigue_recovery_ms_.data();
+    AfterPotential_.g_L_nS = g_L_nS_.data();
+    AfterPotential_.VRest_mV = VRest_mV_.data();
+    AfterPotential_.E_AHP_mV = E_AHP_mV_.data();
+    AfterPotential_.E_ADP_mV = E_ADP_mV_.data();
+    Bound_ = true;
+}
+
+void LIFCStateArrays::Release() {
+    if (!Bound_) {
+        return;
+    }
+    for (size_t i = 0; i < KernelNeurons_.size(); i++) {
+        LIFCNeuron* NeuronPtr = KernelNeurons_[i];
+        NeuronPtr->Vm_bound_mV = nullptr;
+        NeuronPtr->h_spike_bound = nullptr;
+        NeuronPtr->Vth_floor_bound_mV = nullptr;
+        NeuronPtr->fatigue_bound = nullptr;
+        NeuronPtr->a_ADP_bound = nullptr;
+        NeuronPtr->Vm_mV = Vm_mV_[i];
+        NeuronPtr->h_spike = h_spike_[i];
+        NeuronPtr->Vth_floor_mV = Vth_floor_mV_[i];
+        NeuronPtr->fatigue = fatigue_[i];
+        NeuronPtr->a_ADP = a_ADP_[i];
+        NeuronPtr->g_fAHP_nS = g_fAHP_nS_[i];
+        NeuronPtr->g_sAHP_nS = g_sAHP_nS_[i];
+        NeuronPtr->g_ADP_nS = g_ADP_nS_[i];
+        StoreDoubleExpState(NeuronPtr->fAHP_state, a_rise_fAHP_[i], a_decay_fAHP_[i], tAfterPotential_ms_[i], NextSpikeIdx_[i]);
+        StoreDoubleExpState(NeuronPtr->sAHP_state, a_rise_sAHP_[i], a_decay_sAHP_[i], tAfterPotential_ms_[i], NextSpikeIdx_[i]);
+        StoreDoubleExpState(NeuronPtr->ADP_state, a_rise_ADP_[i], a_decay_ADP_[i], tAfterPotential_ms_[i], NextSpikeIdx_[i]);
+    }
+    Bound_ = false;
+}
+
+// Runs everything up to the membrane integration, which leaves the kernel
+// inputs in the arrays.
+void LIFCStateArrays::BeginBlock(size_t _Start, size_t _End, float _T_ms) {
+    for (size_t i = _Start; i < _End; i++) {
+        LIFCNeuron* NeuronPtr = KernelNeurons_[i];
+        if (!NeuronPtr->begin_update(_T_ms)) {
+            // With these inputs the kernels leave the state of the neuron
+            // exactly as it is, see also Integrate().
+            Active_[i] = 0;
+            tDiff_ms_[i] = 0.0f;
+            dtAfterPotential_ms_[i] = 0.0f;
+            g_total_nS_[i] = 0.0f;
+            gE_total_[i] = 0.0f;
+            continue;
+        }
+        Active_[i] = 1;
+        NeuronPtr->reset_at_onset();
+        NeuronPtr->receptor_conductance(g_total_nS_[i], gE_total_[i]);
+        tDiff_ms_[i] = NeuronPtr->tDiff_ms;
+
+        // New spikes are added at the time the terms were last decayed to,
+        // which is no earlier than the spikes, and decay with them to _T_ms
+        // in the kernel.
+        float tLast_ms = tAfterPotential_ms_[i];
+        const std::vector<float>& TAct_ms = NeuronPtr->TAct_ms;
+        for (; NextSpikeIdx_[i] < TAct_ms.size(); NextSpikeIdx_[i]++) {
+            float spike_dt = tLast_ms - TAct_ms[NextSpikeIdx_[i]];
+            a_rise_fAHP_[i] += std::exp(-spike_dt / NeuronPtr->tau_rise_fAHP_ms);
+            a_decay_fAHP_[i] += std::exp(-spike_dt / NeuronPtr->tau_decay_fAHP_ms);
+            a_rise_sAHP_[i] += std::exp(-spike_dt / NeuronPtr->tau_rise_sAHP_ms);
+            a_decay_sAHP_[i] += std::exp(-spike_dt / NeuronPtr->tau_decay_sAHP_ms);
+            a_rise_ADP_[i] += std::exp(-spike_dt / NeuronPtr->tau_rise_ADP_ms);
+            a_decay_ADP_[i] += std::exp(-spike_dt / NeuronPtr->tau_decay_ADP_ms);
+        }
+        dtAfterPotential_ms_[i] = _T_ms - tLast_ms;
+        tAfterPotential_ms_[i] = _T_ms;
+    }
+}
+
+void LIFCStateArrays::Integrate(size_t _Start, size_t _End) {
+    LIFCAfterPotentialKernel(_Start, _End, AfterPotential_, g_total_nS_.data(), gE_total_.data(),
+                             dtAfterPotential_ms_.data(), tDiff_ms_.data());
+
+    // With these inputs the membrane kernel leaves the potential of the
+    // neurons that begin_update() skipped exactly as it is.
+    for (size_t i = _Start; i < _End; i++) {
+        if (!Active_[i]) {
+            g_total_nS_[i] = 1.0f;
+            gE_total_[i] = 0.0f;
+        }
+    }
+    LIFCExpEulerCmKernel(_Start, _End, Vm_mV_.data(), g_total_nS_.data(), gE_total_.data(), Cm_pF_.data(), tDiff_ms_.data());
+    LIFCAdaptiveThresholdKernel(_Start, _End, h_spike_.data(), Vth_floor_mV_.data(), Vth_adaptive_mV_.data(),
+                                VAct_mV_.data(), dVth_mV_.data(), tau_h_ms_.data(),
+                                delta_floor_per_spike_mV_.data(), tau_floor_decay_ms_.data(), tDiff_ms_.data());
+}
+
+// Runs resets, spike detection and recording on the integrated state.
+void LIFCStateArrays::FinishBlock(size_t _Start, size_t _End, float _T_ms, bool _Recording) {
+    for (size_t i = _Start; i < _End; i++) {
+        if (!Active_[i]) {
+            continue;
+        }
+        LIFCNeuron* NeuronPtr = KernelNeurons_[i];
+        float t_ms = _T_ms; // May be modified by triangulate_precise_spiketimes
+        NeuronPtr->finish_with_reset_options(t_ms, 0.0f, Vth_adaptive_mV_[i]);
+        NeuronPtr->end_update(t_ms, _Recording);
+    }
+}
+
+void LIFCStateArrays::Update(float _T_ms, bool _Recording, Updater::NeuronUpdatePool* _Pool) {
+    size_t N = KernelNeurons_.size();
+
+    // Neurons do not depend on each other within a timestep, so every block
+    // runs all three phases on its own, while its slice of the arrays is
+    // still in cache. Blocks are multiples of 16 elements so that only the
+    // last one has a scalar tail in the kernels.
+    size_t BlockSize = 256;
+    if (_Pool != nullptr) {
+        BlockSize = std::max<size_t>(1, N / (size_t(_Pool->GetNumThreads()) * 8));
+        BlockSize = std::min<size_t>(((BlockSize + 15) / 16) * 16, 1024);
+    }
+
+    auto RunBlocks = [&](size_t _Count, const Updater::ChunkFunction& _Function) {
+        if (_Pool != nullptr) {
+            _Pool->ParallelFor(_Count, BlockSize, _Function);
+        } else {
+            for (size_t Start = 0; Start < _Count; Start += BlockSize) {
+                _Function(Start, std::min(Start + BlockSize, _Count));
+            }
+        }
+    };
+
+    RunBlocks(OtherNeurons_.size(), [&](size_t _Start, size_t _End) {
+        for (size_t i = _Start; i < _End; i++) {
+            OtherNeurons_[i]->Update(_T_ms, _Recording);
+        }
+    });
+    RunBlocks(N, [&](size_t _Start, size_t _End) {
+        BeginBlock(_Start, _End, _T_ms);
+        Integrate(_Start, _End);
+        FinishBlock(_Start, _End, _T_ms, _Recording);
+    });
+}
+
+}; // Close Namespace Simulator
+}; // Close Namespace NES
+}; // Close Namespace BG
@@ -0,0 +1,306 @@
+//=================================================================//
+// This file is part of the BrainGenix-NES Neuron Emulation System //
+//=================================================================//
+
+/*
+    Description: This file provides the structure-of-arrays LIFC update engine
+                 and its vectorized membrane and adaptive threshold kernels.
+    Additional Notes: None
+    Date Created: 2026-10-17
+*/
+
+#pragma once
+
+// Standard Libraries (BG convention: use <> instead of "")
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <vector>
+
+// Third-Party Libraries (BG convention: use <> instead of "")
+
+// Internal Libraries (BG convention: use <> instead of "")
+#include <Simulator/Structs/Neuron.h>
+#include <Simulator/Updaters/NeuronUpdatePool.h>
+
+namespace BG {
+namespace NES {
+namespace Simulator {
+
+class LIFCNeuron;
+
+//! Width in bytes that LIFC state arrays are aligned to (one AVX-512 register).
+constexpr size_t LIFCArrayAlignment = 64;
+
+/**
+ * @brief Minimal allocator that returns LIFCArrayAlignment aligned storage.
+ * Update() starts its blocks at multiples of 16 elements, so the vectors of
+ * the kernels never straddle a cache line. The kernels still use unaligned
+ * loads, since they accept arbitrary element ranges.
+ */
+template <typename T>
+struct AlignedAllocator {
+    using value_type = T;
+
+    AlignedAllocator() = default;
+    template <typename U> AlignedAllocator(const AlignedAllocator<U>&) {}
+
+    T* allocate(size_t _N) {
+        return static_cast<T*>(::operator new(_N * sizeof(T), std::align_val_t(LIFCArrayAlignment)));
+    }
+    void deallocate(T* _Ptr, size_t) {
+        ::operator delete(_Ptr, std::align_val_t(LIFCArrayAlignment));
+    }
+
+    template <typename U> bool operator==(const AlignedAllocator<U>&) const { return true; }
+    template <typename U> bool operator!=(const AlignedAllocator<U>&) const { return false; }
+};
+
+using AlignedFloatVec = std::vector<float, AlignedAllocator<float>>;
+
+/**
+ * @brief Exponential Euler update of the membrane potential (see
+ * LIFCNeuron::update_membrane_potential_exponential_Euler_Cm()) for the
+ * elements [_Start, _End) of the given arrays.
+ */
+void LIFCExpEulerCmKernel(size_t _Start, size_t _End, float* _Vm_mV, const float* _g_total_nS,
+    const float* _gE_total, const float* _Cm_pF, const float* _tDiff_ms);
+
+/**
+ * @brief Adaptive threshold update (see LIFCNeuron::update_adaptive_threshold())
+ * for the elements [_Start, _End) of the given arrays. Writes the resulting
+ * thresholds to _Vth_adaptive_mV.
+ */
+void LIFCAdaptiveThresholdKernel(size_t _Start, size_t _End, float* _h_spike, float* _Vth_floor_mV,
+    float* _Vth_adaptive_mV, const float* _VAct_mV, const float* _dVth_mV, const float* _tau_h_ms,
+    const float* _delta_floor_per_spike_mV, const float* _tau_floor_decay_ms, const float* _tDiff_ms);
+
+/**
+ * @brief Elements of the fatigue and after-potential (fAHP, sAHP, ADP) arrays
+ * that LIFCAfterPotentialKernel() works on. The a_rise and a_decay terms are
+ * those of Connections::DoubleExpState. The saturation models are given as
+ * 1 for AHPCLIP and ADPCLIP, 0 for the others.
+ */
+struct LIFCAfterPotentialArrays {
+    // State
+    float* a_rise_fAHP = nullptr;
+    float* a_decay_fAHP = nullptr;
+    float* a_rise_sAHP = nullptr;
+    float* a_decay_sAHP = nullptr;
+    float* a_rise_ADP = nullptr;
+    float* a_decay_ADP = nullptr;
+    float* fatigue = nullptr;
+    float* a_ADP = nullptr;
+
+    // Outputs
+    float* g_fAHP_nS = nullptr;
+    float* g_sAHP_nS = nullptr;
+    float* g_ADP_nS = nullptr;
+
+    // Parameters
+    const float* tau_rise_fAHP_ms = nullptr;
+    const float* tau_decay_fAHP_ms = nullptr;
+    const float* norm_fAHP = nullptr;
+    const float* g_peak_fAHP_nS = nullptr;
+    const float* g_peak_fAHP_max_nS = nullptr;
+    const float* Kd_fAHP_nS = nullptr;
+    const float* tau_rise_sAHP_ms = nullptr;
+    const float* tau_decay_sAHP_ms = nullptr;
+    const float* norm_sAHP = nullptr;
+    const float* g_peak_sAHP_nS = nullptr;
+    const float* g_peak_sAHP_max_nS = nullptr;
+    const float* Kd_sAHP_nS = nullptr;
+    const float* tau_rise_ADP_ms = nullptr;
+    const float* tau_decay_ADP_ms = nullptr;
+    const float* norm_ADP = nullptr;
+    const float* g_peak_ADP_nS = nullptr;
+    const float* g_peak_ADP_max_nS = nullptr;
+    const float* tau_recovery_ADP_ms = nullptr;
+    const float* AHP_clip = nullptr;
+    const float* ADP_clip = nullptr;
+    const float* fatigue_threshold = nullptr;
+    const float* tau_fatigue_recovery_ms = nullptr;
+    const float* g_L_nS = nullptr;
+    const float* VRest_mV = nullptr;
+    const float* E_AHP_mV = nullptr;
+    const float* E_ADP_mV = nullptr;
+};
+
+/**
+ * @brief Fatigue recovery and fAHP, sAHP and ADP conductances (see
+ * LIFCNeuron::update_fatigue() and the recursive form of
+ * LIFCNeuron::update_afterpotential_conductances()) for the elements
+ * [_Start, _End) of the given arrays. The after-potential terms decay over
+ * _dt_ms, fatigue and ADP resources recover over _tDiff_ms. Then adds the
+ * leak and after-potential conductances to the receptor sums in _g_total_nS
+ * and _gE_total, as in LIFCNeuron::total_conductance().
+ */
+void LIFCAfterPotentialKernel(size_t _Start, size_t _End, const LIFCAfterPotentialArrays& _Arrays,
+    float* _g_total_nS, float* _gE_total, const float* _dt_ms, const float* _tDiff_ms);
+
+/**
+ * @brief Structure-of-arrays engine for LIFC neurons.
+ *
+ * The LIFCNeuron objects remain the build-time and API view of the model.
+ * From Build() to Release(), i.e. for the duration of a RunFor, the arrays
+ * are the home of the membrane potential, adaptive threshold, fatigue and
+ * after-potential state of every kernel neuron. The neurons are bound to
+ * the elements that spike() and check_spiking() use and reach them through
+ * Vm(), h(), Vth_floor(), fatigue_level() and ADP_availability(), so no
+ * state is copied per timestep. The after-potentials are always updated in
+ * the recursive form, from the spikes the neurons add to TAct_ms.
+ * The parts of the update that depend on the receptors of a neuron or on
+ * other neurons (receptor conductances, resets, spike detection, recording)
+ * still run on the objects and write the receptor sums that the kernels
+ * take as inputs.
+ * Parameters are packed in Build(), since they can be edited between runs.
+ *
+ * Only neurons using the exponential Euler (Cm) update method are handled
+ * by the kernels, all others are updated through LIFCNeuron::Update().
+ */
+class LIFCStateArrays {
+
+private:
+
+    std::vector<LIFCNeuron*> KernelNeurons_;        /**Neurons updated through the kernels, in array order*/
+    std::vector<CoreStructs::Neuron*> OtherNeurons_; /**Neurons updated through their own Update()*/
+
+    // Parameters
+    AlignedFloatVec Cm_pF_;
+    AlignedFloatVec VAct_mV_;
+    AlignedFloatVec dVth_mV_;
+    AlignedFloatVec tau_h_ms_;
+    AlignedFloatVec delta_floor_per_spike_mV_;
+    AlignedFloatVec tau_floor_decay_ms_;
+    AlignedFloatVec tau_rise_fAHP_ms_;
+    AlignedFloatVec tau_decay_fAHP_ms_;
+    AlignedFloatVec norm_fAHP_;
+    AlignedFloatVec g_peak_fAHP_nS_;
+    AlignedFloatVec g_peak_fAHP_max_nS_;
+    AlignedFloatVec Kd_fAHP_nS_;
+    AlignedFloatVec tau_rise_sAHP_ms_;
+    AlignedFloatVec tau_decay_sAHP_ms_;
+    AlignedFloatVec norm_sAHP_;
+    AlignedFloatVec g_peak_sAHP_nS_;
+    AlignedFloatVec g_peak_sAHP_max_nS_;
+    AlignedFloatVec Kd_sAHP_nS_;
+    AlignedFloatVec tau_rise_ADP_ms_;
+    AlignedFloatVec tau_decay_ADP_ms_;
+    AlignedFloatVec norm_ADP_;
+    AlignedFloatVec g_peak_ADP_nS_;
+    AlignedFloatVec g_peak_ADP_max_nS_;
+    AlignedFloatVec tau_recovery_ADP_ms_;
+    AlignedFloatVec AHP_clip_;
+    AlignedFloatVec ADP_clip_;
+    AlignedFloatVec fatigue_threshold_;
+    AlignedFloatVec tau_fatigue_recovery_ms_;
+    AlignedFloatVec g_L_nS_;
+    AlignedFloatVec VRest_mV_;
+    AlignedFloatVec E_AHP_mV_;
+    AlignedFloatVec E_ADP_mV_;
+
+    // State, partly bound to the neurons between Build() and Release()
+    AlignedFloatVec Vm_mV_;
+    AlignedFloatVec h_spike_;
+    AlignedFloatVec Vth_floor_mV_;
+    AlignedFloatVec fatigue_;
+    AlignedFloatVec a_ADP_;
+    AlignedFloatVec a_rise_fAHP_;
+    AlignedFloatVec a_decay_fAHP_;
+    AlignedFloatVec a_rise_sAHP_;
+    AlignedFloatVec a_decay_sAHP_;
+    AlignedFloatVec a_rise_ADP_;
+    AlignedFloatVec a_decay_ADP_;
+    AlignedFloatVec g_fAHP_nS_;
+    AlignedFloatVec g_sAHP_nS_;
+    AlignedFloatVec g_ADP_nS_;
+    AlignedFloatVec tAfterPotential_ms_;            /**Time the after-potential terms were last decayed to*/
+    std::vector<size_t> NextSpikeIdx_;              /**First element of TAct_ms not yet added to the after-potentials*/
+    LIFCAfterPotentialArrays AfterPotential_;       /**Points into the arrays above*/
+
+    // Per-timestep kernel inputs and outputs
+    AlignedFloatVec tDiff_ms_;
+    AlignedFloatVec dtAfterPotential_ms_;
+    AlignedFloatVec g_total_nS_;
+    AlignedFloatVec gE_total_;
+    AlignedFloatVec Vth_adaptive_mV_;
+    std::vector<uint8_t> Active_;                   /**0 where begin_update() skipped the neuron*/
+    bool Bound_ = false;                            /**True from Build() to Release()*/
+
+    void BeginBlock(size_t _Start, size_t _End, float _T_ms);
+    void Integrate(size_t _Start, size_t _End);
+    void FinishBlock(size_t _Start, size_t _End, float _T_ms, bool _Recording);
+
+public:
+
+    /**
+     * @brief Packs the parameters of the LIFC neurons in _Neurons, moves
+     * their state into the arrays and binds them to it. Releases the
+     * neurons of a previous Build() first.
+     *
+     * @param _Neurons
+     */
+    void Build(const std::vector<std::shared_ptr<CoreStructs::Neuron>>& _Neurons);
+
+    /**
+     * @brief Moves the state back into the neurons and unbinds them. Called
+     * at the end of every RunFor, before the neurons can be edited or destroyed.
+     */
+    void Release();
+
+    /**
+     * @brief Updates all neurons for one timestep. Uses _Pool for all phases if given.
+     *
+     * @param _T_ms
+     * @param _Recording
+     * @param _Pool May be nullptr.
+     */
+    void Update(float _T_ms, bool _Recording, Updater::NeuronUpdatePool* _Pool);
+
+    /**
+     * @brief Returns the number of neurons handled by the kernels.
+     */
+    size_t GetNumKernelNeurons() const { return KernelNeurons_.size(); }
+
+    /**
+     * @brief Returns the total number of neurons updated per timestep.
+     */
+    size_t GetNumNeurons() const { return KernelNeurons_.size() + OtherNeurons_.size(); }
+
+};
+
+/**
+ * @brief Builds LIFCStateArrays for the length of a run and releases them
+ * when it goes out of scope, so that the neurons get their state back even
+ * if the run is left by an exception. A null _Arrays does nothing.
+ */
+class LIFCStateArraysBinding {
+
+private:
+
+    LIFCStateArrays* Arrays_;
+
+public:
+
+    LIFCStateArraysBinding(LIFCStateArrays* _Arrays, const std::vector<std::shared_ptr<CoreStructs::Neuron>>& _Neurons): Arrays_(_Arrays) {
+        if (Arrays_) Arrays_->Build(_Neurons);
+    }
+    ~LIFCStateArraysBinding() { Release(); }
+
+    LIFCStateArraysBinding(const LIFCStateArraysBinding&) = delete;
+    LIFCStateArraysBinding& operator=(const LIFCStateArraysBinding&) = delete;
+
+    /**
+     * @brief Releases the arrays now, e.g. before the run is reported done.
+     */
+    void Release() {
+        if (Arrays_) Arrays_->Release();
+        Arrays_ = nullptr;
+    }
+
+};
+
+}; // Close Namespace Simulator
+}; // Close Namespace NES
+}; // Close Namespace BG
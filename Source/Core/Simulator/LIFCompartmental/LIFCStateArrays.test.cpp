@@ -0,0 +1,446 @@
+//=================================================================//
+// This file is part of the BrainGenix-NES Neuron Emulation System //
+//=================================================================//
+
+/*
+    Description: This file provides unit tests for the LIFCStateArrays kernels and engine.
+    Additional Notes: None
+    Date Created: 2026-10-17
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <BG/Common/Logger/Logger.h>
+#include <Simulator/Geometries/Sphere.h>
+#include <Simulator/LIFCompartmental/LIFCNeuron.h>
+#include <Simulator/LIFCompartmental/LIFCStateArrays.h>
+#include <Simulator/Structs/Simulation.h>
+#include <Simulator/Structs/RecordingElectrode.h>
+
+/**
+ * @brief Test class comparing the vectorized LIFC kernels with the scalar
+ * equations of LIFCNeuron.
+ *
+ * The element count is not a multiple of any vector width and the range
+ * starts at 1, so that both the vector body and the scalar tail run.
+ */
+
+struct LIFCStateArraysTest : testing::Test {
+    size_t N = 1003;
+
+    BG::NES::Simulator::AlignedFloatVec Vm_mV, g_total_nS, gE_total, Cm_pF, tDiff_ms;
+    BG::NES::Simulator::AlignedFloatVec h_spike, Vth_floor_mV, Vth_adaptive_mV, VAct_mV, dVth_mV, tau_h_ms,
+        delta_floor_per_spike_mV, tau_floor_decay_ms;
+
+    void SetUp() {
+        std::mt19937 Gen(1);
+        std::uniform_real_distribution<float> U(0.0, 1.0);
+
+        for (auto* Array : { &Vm_mV, &g_total_nS, &gE_total, &Cm_pF, &tDiff_ms, &h_spike, &Vth_floor_mV,
+                             &Vth_adaptive_mV, &VAct_mV, &dVth_mV, &tau_h_ms, &delta_floor_per_spike_mV, &tau_floor_decay_ms }) {
+            Array->assign(N, 0.0);
+        }
+
+        for (size_t i = 0; i < N; i++) {
+            Vm_mV[i] = -80.0 + 40.0 * U(Gen);
+            g_total_nS[i] = 1.0 + 20.0 * U(Gen);
+            gE_total[i] = g_total_nS[i] * (-70.0 + 30.0 * U(Gen));
+            Cm_pF[i] = 100.0 + 200.0 * U(Gen);
+            tDiff_ms[i] = (i % 7 == 0) ? 0.0 : 0.05 + U(Gen);
+
+            h_spike[i] = U(Gen);
+            Vth_floor_mV[i] = -55.0 + 10.0 * U(Gen);
+            VAct_mV[i] = -50.0;
+            dVth_mV[i] = 10.0;
+            tau_h_ms[i] = 50.0 + 150.0 * U(Gen);
+            delta_floor_per_spike_mV[i] = (i % 3 == 0) ? 0.0 : 1.0;
+            tau_floor_decay_ms[i] = 500.0;
+        }
+    }
+
+    void TearDown() { return; }
+};
+
+TEST_F(LIFCStateArraysTest, test_ExpEulerCmKernel) {
+    auto Expected = Vm_mV;
+    for (size_t i = 1; i < N; i++) {
+        float E_total = gE_total[i] / g_total_nS[i];
+        float tau_eff = Cm_pF[i] / g_total_nS[i];
+        Expected[i] = E_total + (Expected[i] - E_total) * exp(-tDiff_ms[i] / tau_eff);
+    }
+
+    float Untouched = Vm_mV[0];
+    BG::NES::Simulator::LIFCExpEulerCmKernel(1, N, Vm_mV.data(), g_total_nS.data(), gE_total.data(),
+                                             Cm_pF.data(), tDiff_ms.data());
+
+    ASSERT_EQ(Vm_mV[0], Untouched);
+    for (size_t i = 1; i < N; i++) {
+        ASSERT_NEAR(Vm_mV[i], Expected[i], 1e-4);
+    }
+}
+
+TEST_F(LIFCStateArraysTest, test_AdaptiveThresholdKernel) {
+    auto Expected_h = h_spike;
+    auto Expected_floor = Vth_floor_mV;
+    auto Expected_Vth = Vth_adaptive_mV;
+    for (size_t i = 1; i < N; i++) {
+        Expected_h[i] += tDiff_ms[i] * (1 - Expected_h[i]) / tau_h_ms[i];
+        if (delta_floor_per_spike_mV[i] > 0) {
+            Expected_floor[i] -= tDiff_ms[i] * (Expected_floor[i] - VAct_mV[i]) / tau_floor_decay_ms[i];
+        }
+        Expected_Vth[i] = std::max(VAct_mV[i] + dVth_mV[i] * (1 - Expected_h[i]), Expected_floor[i]);
+    }
+
+    BG::NES::Simulator::LIFCAdaptiveThresholdKernel(1, N, h_spike.data(), Vth_floor_mV.data(), Vth_adaptive_mV.data(),
+                                                    VAct_mV.data(), dVth_mV.data(), tau_h_ms.data(),
+                                                    delta_floor_per_spike_mV.data(), tau_floor_decay_ms.data(), tDiff_ms.data());
+
+    // Only basic arithmetic, so the results are exact.
+    ASSERT_EQ(h_spike, Expected_h);
+    ASSERT_EQ(Vth_floor_mV, Expected_floor);
+    ASSERT_EQ(Vth_adaptive_mV, Expected_Vth);
+}
+
+TEST_F(LIFCStateArraysTest, test_AfterPotentialKernel) {
+    std::mt19937 Gen(2);
+    std::uniform_real_distribution<float> U(0.0, 1.0);
+
+    BG::NES::Simulator::AlignedFloatVec a_rise_fAHP, a_decay_fAHP, a_rise_sAHP, a_decay_sAHP, a_rise_ADP, a_decay_ADP,
+        fatigue, a_ADP, g_fAHP_nS, g_sAHP_nS, g_ADP_nS, tau_rise_ms, tau_decay_ms, norm, g_peak_nS, g_peak_max_nS, Kd_nS,
+        tau_recovery_ADP_ms, AHP_clip, ADP_clip, fatigue_threshold, tau_fatigue_recovery_ms, g_L_nS, VRest_mV, E_AHP_mV,
+        E_ADP_mV, dt_ms;
+    for (auto* Array : { &a_rise_fAHP, &a_decay_fAHP, &a_rise_sAHP, &a_decay_sAHP, &a_rise_ADP, &a_decay_ADP,
+                         &fatigue, &a_ADP, &g_fAHP_nS, &g_sAHP_nS, &g_ADP_nS, &tau_rise_ms, &tau_decay_ms, &norm,
+                         &g_peak_nS, &g_peak_max_nS, &Kd_nS, &tau_recovery_ADP_ms, &AHP_clip, &ADP_clip,
+                         &fatigue_threshold, &tau_fatigue_recovery_ms, &g_L_nS, &VRest_mV, &E_AHP_mV, &E_ADP_mV, &dt_ms }) {
+        Array->assign(N, 0.0);
+    }
+    for (size_t i = 0; i < N; i++) {
+        a_rise_fAHP[i] = 3.0 * U(Gen);
+        a_decay_fAHP[i] = a_rise_fAHP[i] + U(Gen);
+        a_rise_sAHP[i] = 3.0 * U(Gen);
+        a_decay_sAHP[i] = a_rise_sAHP[i] + U(Gen);
+        a_rise_ADP[i] = 3.0 * U(Gen);
+        a_decay_ADP[i] = a_rise_ADP[i] + U(Gen);
+        fatigue[i] = 2.0 * U(Gen);
+        a_ADP[i] = U(Gen);
+        tau_rise_ms[i] = 1.0 + 20.0 * U(Gen);
+        tau_decay_ms[i] = tau_rise_ms[i] + 200.0 * U(Gen);
+        norm[i] = 0.5 + 0.5 * U(Gen);
+        g_peak_nS[i] = 5.0 * U(Gen);
+        g_peak_max_nS[i] = 5.0 * U(Gen);
+        Kd_nS[i] = 0.5 + U(Gen);
+        tau_recovery_ADP_ms[i] = 100.0 + 200.0 * U(Gen);
+        AHP_clip[i] = (i % 2 == 0) ? 1.0 : 0.0;
+        ADP_clip[i] = (i % 3 == 0) ? 1.0 : 0.0;
+        fatigue_threshold[i] = (i % 5 == 0) ? 0.0 : 300.0;
+        tau_fatigue_recovery_ms[i] = 1000.0;
+        g_L_nS[i] = 10.0;
+        VRest_mV[i] = -60.0;
+        E_AHP_mV[i] = -90.0;
+        E_ADP_mV[i] = -20.0;
+        dt_ms[i] = (i % 11 == 0) ? 0.0 : tDiff_ms[i] + U(Gen);
+    }
+
+    BG::NES::Simulator::LIFCAfterPotentialArrays A;
+    A.a_rise_fAHP = a_rise_fAHP.data();
+    A.a_decay_fAHP = a_decay_fAHP.data();
+    A.a_rise_sAHP = a_rise_sAHP.data();
+    A.a_decay_sAHP = a_decay_sAHP.data();
+    A.a_rise_ADP = a_rise_ADP.data();
+    A.a_decay_ADP = a_decay_ADP.data();
+    A.fatigue = fatigue.data();
+    A.a_ADP = a_ADP.data();
+    A.g_fAHP_nS = g_fAHP_nS.data();
+    A.g_sAHP_nS = g_sAHP_nS.data();
+    A.g_ADP_nS = g_ADP_nS.data();
+    A.tau_rise_fAHP_ms = A.tau_rise_sAHP_ms = A.tau_rise_ADP_ms = tau_rise_ms.data();
+    A.tau_decay_fAHP_ms = A.tau_decay_sAHP_ms = A.tau_decay_ADP_ms = tau_decay_ms.data();
+    A.norm_fAHP = A.norm_sAHP = A.norm_ADP = norm.data();
+    A.g_peak_fAHP_nS = A.g_peak_sAHP_nS = A.g_peak_ADP_nS = g_peak_nS.data();
+    A.g_peak_fAHP_max_nS = A.g_peak_sAHP_max_nS = A.g_peak_ADP_max_nS = g_peak_max_nS.data();
+    A.Kd_fAHP_nS = A.Kd_sAHP_nS = Kd_nS.data();
+    A.tau_recovery_ADP_ms = tau_recovery_ADP_ms.data();
+    A.AHP_clip = AHP_clip.data();
+    A.ADP_clip = ADP_clip.data();
+    A.fatigue_threshold = fatigue_threshold.data();
+    A.tau_fatigue_recovery_ms = tau_fatigue_recovery_ms.data();
+    A.g_L_nS = g_L_nS.data();
+    A.VRest_mV = VRest_mV.data();
+    A.E_AHP_mV = E_AHP_mV.data();
+    A.E_ADP_mV = E_ADP_mV.data();
+
+    auto Expected_fatigue = fatigue;
+    auto Expected_a_ADP = a_ADP;
+    auto Expected_a_decay_sAHP = a_decay_sAHP;
+    auto Expected_g_fAHP = g_fAHP_nS;
+    auto Expected_g_sAHP = g_sAHP_nS;
+    auto Expected_g_ADP = g_ADP_nS;
+    auto Expected_g_total = g_total_nS;
+    auto Expected_gE_total = gE_total;
+    for (size_t i = 1; i < N; i++) {
+        if (fatigue_threshold[i] > 0) {
+            Expected_fatigue[i] = std::max(Expected_fatigue[i] - tDiff_ms[i] / tau_fatigue_recovery_ms[i], 0.0f);
+        }
+        float f_rise = exp(-dt_ms[i] / tau_rise_ms[i]);
+        float f_decay = exp(-dt_ms[i] / tau_decay_ms[i]);
+        Expected_a_decay_sAHP[i] *= f_decay;
+        float fAHP = g_peak_nS[i] * (a_decay_fAHP[i] * f_decay - a_rise_fAHP[i] * f_rise) / norm[i];
+        float sAHP = g_peak_nS[i] * (a_decay_sAHP[i] * f_decay - a_rise_sAHP[i] * f_rise) / norm[i];
+        float ADP = g_peak_nS[i] * (a_decay_ADP[i] * f_decay - a_rise_ADP[i] * f_rise) / norm[i];
+        if (AHP_clip[i] > 0) {
+            Expected_g_fAHP[i] = std::min(fAHP, g_peak_max_nS[i]);
+            Expected_g_sAHP[i] = std::min(sAHP, g_peak_max_nS[i]);
+        } else {
+            Expected_g_fAHP[i] = g_peak_max_nS[i] * fAHP / (fAHP + Kd_nS[i]);
+            Expected_g_sAHP[i] = g_peak_max_nS[i] * sAHP / (sAHP + Kd_nS[i]);
+        }
+        if (ADP_clip[i] > 0) {
+            Expected_g_ADP[i] = std::min(ADP, g_peak_max_nS[i]);
+        } else {
+            float a = Expected_a_ADP[i] + (1 - Expected_a_ADP[i]) * tDiff_ms[i] / tau_recovery_ADP_ms[i];
+            Expected_a_ADP[i] = std::max(0.0f, std::min(1.0f, a));
+            Expected_g_ADP[i] = Expected_a_ADP[i] * ADP;
+        }
+        Expected_g_total[i] += g_L_nS[i] + Expected_g_fAHP[i] + Expected_g_sAHP[i] + Expected_g_ADP[i];
+        Expected_gE_total[i] += g_L_nS[i] * VRest_mV[i] + (Expected_g_fAHP[i] + Expected_g_sAHP[i]) * E_AHP_mV[i] +
+                                Expected_g_ADP[i] * E_ADP_mV[i];
+    }
+
+    float Untouched = a_decay_sAHP[0];
+    BG::NES::Simulator::LIFCAfterPotentialKernel(1, N, A, g_total_nS.data(), gE_total.data(), dt_ms.data(), tDiff_ms.data());
+
+    ASSERT_EQ(a_decay_sAHP[0], Untouched);
+    for (size_t i = 1; i < N; i++) {
+        ASSERT_NEAR(fatigue[i], Expected_fatigue[i], 1e-6) << i;
+        ASSERT_NEAR(a_ADP[i], Expected_a_ADP[i], 1e-6) << i;
+        ASSERT_NEAR(a_decay_sAHP[i], Expected_a_decay_sAHP[i], 1e-5) << i;
+        ASSERT_NEAR(g_fAHP_nS[i], Expected_g_fAHP[i], 1e-4) << i;
+        ASSERT_NEAR(g_sAHP_nS[i], Expected_g_sAHP[i], 1e-4) << i;
+        ASSERT_NEAR(g_ADP_nS[i], Expected_g_ADP[i], 1e-4) << i;
+        ASSERT_NEAR(g_total_nS[i], Expected_g_total[i], 1e-3) << i;
+        ASSERT_NEAR(gE_total[i], Expected_gE_total[i], 1e-1) << i;
+    }
+}
+
+TEST_F(LIFCStateArraysTest, test_AlignedAllocator) {
+    ASSERT_EQ(reinterpret_cast<uintptr_t>(Vm_mV.data()) % BG::NES::Simulator::LIFCArrayAlignment, 0u);
+}
+
+
+/**
+ * @brief Test class comparing runs of a LIFC network with and without the
+ * state arrays, serially and in parallel. The network is randomly connected
+ * and spontaneously active, one neuron in four uses the forward Euler
+ * update, so that it is updated outside of the kernels.
+ */
+
+struct LIFCStateArraysNetworkTest : testing::Test {
+    BG::Common::Logger::LoggingSystem Logger;
+
+    static constexpr int NumNeurons = 40;
+    static constexpr int NumReceptors = 200;
+    static constexpr float T_ms = 150.0;
+
+    std::unique_ptr<BG::NES::Simulator::Simulation> MakeNetwork(bool _EventDriven) {
+        using namespace BG::NES::Simulator;
+
+        auto Sim = std::make_unique<Simulation>(&Logger);
+        Sim->SetRandomSeed(5);
+        Sim->Dt_ms = 0.25;
+        Sim->use_recursive_conductances = _EventDriven;
+        Sim->use_event_driven_delivery = _EventDriven;
+
+        std::vector<int> CompartmentIDs;
+        for (int i = 0; i < NumNeurons; i++) {
+            Geometries::Sphere S(Geometries::Vec3D(10.0*i, 0.0, 0.0), 2.0);
+            int ShapeID = Sim->AddSphere(S);
+
+            Compartments::LIFC C;
+            C.ShapeID = ShapeID;
+            C.RestingPotential_mV = -60.0;
+            C.ResetPotential_mV = -55.0;
+            C.SpikeThreshold_mV = -50.0;
+            C.MembraneResistance_MOhm = 100.0;
+            C.MembraneCapacitance_pF = 100.0;
+            C.AfterHyperpolarizationAmplitude_mV = 0.0;
+            CompartmentIDs.push_back(Sim->AddLIFCCompartment(C));
+
+            CoreStructs::LIFCNeuronStruct N;
+            N.RestingPotential_mV = -60.0;
+            N.ResetPotential_mV = -55.0;
+            N.SpikeThreshold_mV = -50.0;
+            N.MembraneResistance_MOhm = 100.0;
+            N.MembraneCapacitance_pF = 100.0;
+            N.RefractoryPeriod_ms = 2.0;
+            N.SpikeDepolarization_mV = 30.0;
+            N.UpdateMethod = (i % 4 == 3) ? CoreStructs::FORWARD_EULER : CoreStructs::EXPEULER_CM;
+            N.ResetMethod = (i % 2 == 0) ? CoreStructs::TOVM : CoreStructs::ONSET;
+            N.AfterHyperpolarizationReversalPotential_mV = -90.0;
+            N.FastAfterHyperpolarizationRise_ms = 2.5;
+            N.FastAfterHyperpolarizationDecay_ms = 30.0;
+            N.FastAfterHyperpolarizationPeakConductance_nS = 3.0;
+            N.FastAfterHyperpolarizationMaxPeakConductance_nS = 10.0;
+            N.FastAfterHyperpolarizationHalfActConstant = 0.5;
+            N.SlowAfterHyperpolarizationRise_ms = 30.0;
+            N.SlowAfterHyperpolarizationDecay_ms = 300.0;
+            N.SlowAfterHyperpolarizationPeakConductance_nS = 1.0;
+            N.SlowAfterHyperpolarizationMaxPeakConductance_nS = 5.0;
+            N.SlowAfterHyperpolarizationHalfActConstant = 0.5;
+            N.AfterHyperpolarizationSaturationModel = (i % 5 == 1) ? CoreStructs::AHPSIGMOID : CoreStructs::AHPCLIP;
+            N.FatigueThreshold = 300.0;
+            N.FatigueRecoveryTime_ms = 1000.0;
+            N.AfterDepolarizationReversalPotential_mV = -20.0;
+            N.AfterDepolarizationRise_ms = 20.0;
+            N.AfterDepolarizationDecay_ms = 200.0;
+            N.AfterDepolarizationPeakConductance_nS = 0.3;
+            N.AfterDepolarizationSaturationMultiplier = 2.0;
+            N.AfterDepolarizationRecoveryTime_ms = 300.0;
+            N.AfterDepolarizationDepletion = 0.3;
+            N.AfterDepolarizationSaturationModel = (i % 2 == 1) ? CoreStructs::ADPRESOURCE : CoreStructs::ADPCLIP;
+            N.AdaptiveThresholdDiffPerSpike = 0.2;
+            N.AdaptiveTresholdRecoveryTime_ms = 50.0;
+            N.AdaptiveThresholdDiffPotential_mV = 10.0;
+            N.AdaptiveThresholdFloor_mV = -50.0;
+            N.AdaptiveThresholdFloorDeltaPerSpike_mV = (i % 3 == 0) ? 0.0 : 1.0;
+            N.AdaptiveThresholdFloorRecoveryTime_ms = 500.0;
+            N.SomaCompartmentIDs.push_back(CompartmentIDs.back());
+            Sim->AddLIFCNeuron(N);
+        }
+
+        std::mt19937 Generator(3);
+        std::uniform_int_distribution<int> Neuron(0, NumNeurons - 1);
+        std::uniform_real_distribution<float> Delay(0.25, 3.0);
+        for (int i = 0; i < NumReceptors; i++) {
+            Connections::LIFCReceptor R;
+            R.SourceCompartmentID = CompartmentIDs[Neuron(Generator)];
+            R.DestinationCompartmentID = CompartmentIDs[Neuron(Generator)];
+            bool Inhibitory = (i % 4) == 0;
+            R.ReversalPotential_mV = Inhibitory ? -70.0 : 0.0;
+            R.PSPRise_ms = 0.5;
+            R.PSPDecay_ms = 3.0;
+            R.PeakConductance_nS = Inhibitory ? 20.0 : 10.0;
+            R.Weight = 1.0;
+            R.OnsetDelay_ms = Delay(Generator);
+            R.Neurotransmitter = Inhibitory ? Connections::GABA : Connections::AMPA;
+            R.STDP_Method = Connections::STDPHEBBIAN;
+            R.STDP_A_pos = 0.1;
+            R.STDP_A_neg = 0.1;
+            R.STDP_Tau_pos = 20.0;
+            R.STDP_Tau_neg = 20.0;
+            Sim->AddLIFCReceptor(R);
+        }
+
+        for (auto & Neuron : Sim->Neurons) {
+            Neuron->SetSpontaneousActivity(40.0, 10.0, Sim->MasterRandom_->UniformRandomInt());
+        }
+        Sim->SetRecordAll();
+
+        return Sim;
+    }
+
+    // The vector kernels approximate exp(), so the membrane potentials may
+    // differ from the per-object update in the last bits. Spikes must not.
+    void ExpectSameRun(BG::NES::Simulator::Simulation& _Expected, BG::NES::Simulator::Simulation& _Actual, float _Tolerance_mV) {
+        using BG::NES::Simulator::LIFCNeuron;
+        ASSERT_EQ(_Expected.T_ms, _Actual.T_ms);
+        for (int i = 0; i < NumNeurons; i++) {
+            auto ExpectedNeuron = std::dynamic_pointer_cast<LIFCNeuron>(_Expected.Neurons[i]);
+            auto ActualNeuron = std::dynamic_pointer_cast<LIFCNeuron>(_Actual.Neurons[i]);
+            ASSERT_TRUE(ExpectedNeuron && ActualNeuron);
+            ASSERT_EQ(ActualNeuron->Vm_bound_mV, nullptr) << "neuron " << i;
+            ASSERT_EQ(ActualNeuron->h_spike_bound, nullptr) << "neuron " << i;
+            ASSERT_EQ(ActualNeuron->fatigue_bound, nullptr) << "neuron " << i;
+            ASSERT_EQ(ActualNeuron->a_ADP_bound, nullptr) << "neuron " << i;
+            ASSERT_EQ(ExpectedNeuron->TAct_ms, ActualNeuron->TAct_ms) << "neuron " << i;
+            ASSERT_EQ(ExpectedNeuron->VmRecorded_mV.size(), ActualNeuron->VmRecorded_mV.size()) << "neuron " << i;
+            for (size_t t = 0; t < ExpectedNeuron->VmRecorded_mV.size(); t++) {
+                ASSERT_NEAR(ExpectedNeuron->VmRecorded_mV[t], ActualNeuron->VmRecorded_mV[t], _Tolerance_mV) << "neuron " << i << " sample " << t;
+            }
+            ASSERT_NEAR(ExpectedNeuron->Vm_mV, ActualNeuron->Vm_mV, _Tolerance_mV) << "neuron " << i;
+            ASSERT_NEAR(ExpectedNeuron->h_spike, ActualNeuron->h_spike, 1e-5) << "neuron " << i;
+            ASSERT_NEAR(ExpectedNeuron->Vth_floor_mV, ActualNeuron->Vth_floor_mV, 1e-4) << "neuron " << i;
+            ASSERT_NEAR(ExpectedNeuron->fatigue, ActualNeuron->fatigue, 1e-5) << "neuron " << i;
+            ASSERT_NEAR(ExpectedNeuron->a_ADP, ActualNeuron->a_ADP, 1e-5) << "neuron " << i;
+            ASSERT_NEAR(ExpectedNeuron->g_fAHP_nS, ActualNeuron->g_fAHP_nS, 1e-4) << "neuron " << i;
+            ASSERT_NEAR(ExpectedNeuron->g_sAHP_nS, ActualNeuron->g_sAHP_nS, 1e-4) << "neuron " << i;
+            ASSERT_NEAR(ExpectedNeuron->g_ADP_nS, ActualNeuron->g_ADP_nS, 1e-4) << "neuron " << i;
+        }
+    }
+
+    void TearDown() { return; }
+};
+
+TEST_F(LIFCStateArraysNetworkTest, test_State_arrays_match_per_object_update) {
+    for (bool EventDriven : {false, true}) {
+        auto Reference = MakeNetwork(EventDriven);
+        Reference->use_lifc_state_arrays = false;
+        Reference->RunFor(T_ms);
+        ASSERT_GT(Reference->TotalSpikes(), (unsigned long)NumNeurons) << "event driven " << EventDriven;
+
+        auto Arrays = MakeNetwork(EventDriven);
+        Arrays->use_lifc_state_arrays = true;
+        Arrays->RunFor(T_ms);
+        ASSERT_EQ(Arrays->LIFCArrays_->GetNumNeurons(), (size_t)NumNeurons);
+        ASSERT_EQ(Arrays->LIFCArrays_->GetNumKernelNeurons(), (size_t)(NumNeurons - NumNeurons / 4));
+        ExpectSameRun(*Reference, *Arrays, 1e-3);
+
+        auto ParallelArrays = MakeNetwork(EventDriven);
+        ParallelArrays->use_lifc_state_arrays = true;
+        ParallelArrays->SetParallelUpdate(true, 4);
+        ASSERT_TRUE(ParallelArrays->UsesParallelUpdate());
+        ParallelArrays->RunFor(T_ms);
+        ExpectSameRun(*Arrays, *ParallelArrays, 0.0);
+    }
+}
+
+TEST_F(LIFCStateArraysNetworkTest, test_Switching_state_arrays_between_runs) {
+    auto Arrays = MakeNetwork(false);
+    Arrays->use_lifc_state_arrays = true;
+    Arrays->RunFor(2*T_ms);
+
+    // The state moves out of the arrays and back between the runs.
+    auto Mixed = MakeNetwork(false);
+    Mixed->use_lifc_state_arrays = true;
+    Mixed->RunFor(0.5*T_ms);
+    Mixed->use_lifc_state_arrays = false;
+    Mixed->SetParallelUpdate(true, 3);
+    Mixed->RunFor(T_ms);
+    Mixed->use_lifc_state_arrays = true;
+    Mixed->RunFor(0.5*T_ms);
+
+    ExpectSameRun(*Arrays, *Mixed, 1e-3);
+}
+
+TEST_F(LIFCStateArraysNetworkTest, test_Binding_releases_state_on_exception) {
+    using BG::NES::Simulator::LIFCNeuron;
+    auto Sim = MakeNetwork(false);
+    Sim->use_lifc_state_arrays = true;
+    Sim->RunFor(0.5*T_ms);
+
+    // Change the state while it lives in the arrays, then leave by a throw.
+    std::vector<float> Vm_mV;
+    try {
+        BG::NES::Simulator::LIFCStateArraysBinding Binding(Sim->LIFCArrays_.get(), Sim->Neurons);
+        for (auto & Neuron : Sim->Neurons) {
+            auto N = std::dynamic_pointer_cast<LIFCNeuron>(Neuron);
+            N->Vm() -= 1.0;
+            Vm_mV.push_back(N->Vm());
+        }
+        throw std::runtime_error("run aborted");
+    } catch (const std::runtime_error&) {}
+
+    for (int i = 0; i < NumNeurons; i++) {
+        auto N = std::dynamic_pointer_cast<LIFCNeuron>(Sim->Neurons[i]);
+        ASSERT_EQ(N->Vm_bound_mV, nullptr) << "neuron " << i;
+        ASSERT_EQ(N->h_spike_bound, nullptr) << "neuron " << i;
+        ASSERT_EQ(N->Vm_mV, Vm_mV[i]) << "neuron " << i;
+    }
+}
@@ -1,5 +1,6 @@
 #include <Simulator/RPC/GeometryRPCInterface.h>
 #include <RPC/APIStatusCode.h>
+#include <RPC/BulkRequest.h>
 
 // Third-Party Libraries (BG convention: use <> instead of "")
 
@@ -24,9 +25,13 @@ GeometryRPCInterface::GeometryRPCInterface(BG::Common::Logger::LoggingSystem* _L
     Simulations_ = _Simulations;
 
     // Register Callbacks
-    _RPCManager->AddRoute("Simulation/Geometry/Sphere/Create",   std::bind(&GeometryRPCInterface::SphereCreate, this, std::placeholders::_1));
-    _RPCManager->AddRoute("Simulation/Geometry/Cylinder/Create", std::bind(&GeometryRPCInterface::CylinderCreate, this, std::placeholders::_1));
-    _RPCManager->AddRoute("Simulation/Geometry/Box/Create",      std::bind(&GeometryRPCInterface::BoxCreate, this, std::placeholders::_1));
+    _RPCManager->AddJSONRoute("Simulation/Geometry/Sphere/Create",   std::bind(&GeometryRPCInterface::SphereCreate, this, std::placeholders::_1));
+    _RPCManager->AddJSONRoute("Simulation/Geometry/Cylinder/Create", std::bind(&GeometryRPCInterface::CylinderCreate, this, std::placeholders::_1));
+    _RPCManager->AddJSONRoute("Simulation/Geometry/Box/Create",      std::bind(&GeometryRPCInterface::BoxCreate, this, std::placeholders::_1));
+
+    _RPCManager->AddJSONRoute("Simulation/Geometry/Sphere/BulkCreate",   std::bind(&GeometryRPCInterface::SphereBulkCreate, this, std::placeholders::_1));
+    _RPCManager->AddJSONRoute("Simulation/Geometry/Cylinder/BulkCreate", std::bind(&GeometryRPCInterface::CylinderBulkCreate, this, std::placeholders::_1));
+    _RPCManager->AddJSONRoute("Simulation/Geometry/Box/BulkCreate",      std::bind(&GeometryRPCInterface::BoxBulkCreate, this, std::placeholders::_1));
 
 }
 
@@ -34,70 +39,137 @@ GeometryRPCInterface::~GeometryRPCInterface() {
 
 }
 
-std::string GeometryRPCInterface::SphereCreate(std::string _JSONRequest) {
+// The parameter readers are shared by the single and the bulk create routes.
+bool SphereFromJSON(API::HandlerData& Handle, nlohmann::json& _Params, Geometries::Sphere& S) {
+    return Handle.GetParFloat("Radius_um", S.Radius_um, _Params)
+        && Handle.GetParVec3FromJSON("CenterPos", S.Center_um, _Params)
+        && Handle.GetParString("Name", S.Name, _Params);
+}
+
+bool CylinderFromJSON(API::HandlerData& Handle, nlohmann::json& _Params, Geometries::Cylinder& S) {
+    return Handle.GetParFloat("Point1Radius_um", S.End0Radius_um, _Params)
+        && Handle.GetParVec3FromJSON("Point1Pos", S.End0Pos_um, _Params)
+        && Handle.GetParFloat("Point2Radius_um", S.End1Radius_um, _Params)
+        && Handle.GetParVec3FromJSON("Point2Pos", S.End1Pos_um, _Params)
+        && Handle.GetParString("Name", S.Name, _Params);
+}
+
+bool BoxFromJSON(API::HandlerData& Handle, nlohmann::json& _Params, Geometries::Box& S) {
+    return Handle.GetParVec3FromJSON("CenterPos", S.Center_um, _Params)
+        && Handle.GetParVec3FromJSON("Scale", S.Dims_um, _Params)
+        && Handle.GetParVec3FromJSON("Rotation", S.Rotations_rad, _Params, "rad")
+        && Handle.GetParString("Name", S.Name, _Params);
+}
+
+nlohmann::json GeometryRPCInterface::SphereCreate(nlohmann::json _JSONRequest) {
  
-    API::HandlerData Handle(_JSONRequest, Logger_, "Simulation/Geometry/Sphere/Create", Simulations_);
+    API::HandlerData Handle(std::move(_JSONRequest), Logger_, "Simulation/Geometry/Sphere/Create", Simulations_);
     if (Handle.HasError()) {
-        return Handle.ErrResponse();
+        return Handle.ErrResponseJSON();
     }
     
     // Build New Sphere Object
     Geometries::Sphere S;
-    if ((!Handle.GetParFloat("Radius_um", S.Radius_um))
-        || (!Handle.GetParVec3("CenterPos", S.Center_um))
-        || (!Handle.GetParString("Name", S.Name))) {
-        return Handle.ErrResponse();
+    if (!SphereFromJSON(Handle, Handle.ReqJSON(), S)) {
+        return Handle.ErrResponseJSON();
     }
 
     S.ID = Handle.Sim()->AddSphere(S);
 
     // Return Result ID
-    return Handle.ResponseWithID("ShapeID", S.ID);
+    return Handle.ResponseWithIDJSON("ShapeID", S.ID);
 }
 
-std::string GeometryRPCInterface::CylinderCreate(std::string _JSONRequest) {
+nlohmann::json GeometryRPCInterface::CylinderCreate(nlohmann::json _JSONRequest) {
  
-    API::HandlerData Handle(_JSONRequest, Logger_, "Simulation/Geometry/Cylinder/Create", Simulations_);
+    API::HandlerData Handle(std::move(_JSONRequest), Logger_, "Simulation/Geometry/Cylinder/Create", Simulations_);
     if (Handle.HasError()) {
-        return Handle.ErrResponse();
+        return Handle.ErrResponseJSON();
     }
 
     // Build New Cylinder Object
     Geometries::Cylinder S;
-    if ((!Handle.GetParFloat("Point1Radius_um", S.End0Radius_um))
-        || (!Handle.GetParVec3("Point1Pos", S.End0Pos_um))
-        || (!Handle.GetParFloat("Point2Radius_um", S.End1Radius_um))
-        || (!Handle.GetParVec3("Point2Pos", S.End1Pos_um))
-        || (!Handle.GetParString("Name", S.Name))) {
-        return Handle.ErrResponse();
+    if (!CylinderFromJSON(Handle, Handle.ReqJSON(), S)) {
+        return Handle.ErrResponseJSON();
     }
 
     S.ID = Handle.Sim()->AddCylinder(S);
 
     // Return Result ID
-    return Handle.ResponseWithID("ShapeID", S.ID);
+    return Handle.ResponseWithIDJSON("ShapeID", S.ID);
 }
 
-std::string GeometryRPCInterface::BoxCreate(std::string _JSONRequest) {
+nlohmann::json GeometryRPCInterface::BoxCreate(nlohmann::json _JSONRequest) {
  
-    API::HandlerData Handle(_JSONRequest, Logger_, "Simulation/Geometry/Box/Create", Simulations_);
+    API::HandlerData Handle(std::move(_JSONRequest), Logger_, "Simulation/Geometry/Box/Create", Simulations_);
     if (Handle.HasError()) {
-        return Handle.ErrResponse();
+        return Handle.ErrResponseJSON();
     }
 
     // Build New Box Object
     Geometries::Box S;
-    if ((!Handle.GetParVec3("CenterPos", S.Center_um))
-        || (!Handle.GetParVec3("Scale", S.Dims_um))
-        || (!Handle.GetParVec3("Rotation", S.Rotations_rad, "rad"))
-        || (!Handle.GetParString("Name", S.Name))) {
-        return Handle.ErrResponse();
+    if (!BoxFromJSON(Handle, Handle.ReqJSON(), S)) {
+        return Handle.ErrResponseJSON();
     }
 
     S.ID = Handle.Sim()->AddBox(S);
 
     // Return Result ID
-    return Handle.ResponseWithID("ShapeID", S.ID);
+    return Handle.ResponseWithIDJSON("ShapeID", S.ID);
+}
+
+/**
+ * The bulk create routes take the parameters of the single create routes in
+ * the columnar form described at API::BulkRequest, e.g. for spheres:
+ * {
+ *   "SimulationID": <SimID>,
+ *   "Count": <N>,
+ *   "Columns": { "Radius_um": [...], "CenterPosX_um": [...], "CenterPosY_um": [...], "CenterPosZ_um": [...] },
+ *   "Name": <name>
+ * }
+ * and respond with the ID of the first shape created ("FirstID") and "Count".
+ * The shapes have consecutive IDs.
+ */
+nlohmann::json GeometryRPCInterface::SphereBulkCreate(nlohmann::json _JSONRequest) {
+
+    API::HandlerData Handle(std::move(_JSONRequest), Logger_, "Simulation/Geometry/Sphere/BulkCreate", Simulations_);
+    if (Handle.HasError()) {
+        return Handle.ErrResponseJSON();
+    }
+
+    Simulation* Sim = Handle.Sim();
+    return API::BulkCreate<Geometries::Sphere>(Handle, Logger_,
+        [&Handle](nlohmann::json& _Params, Geometries::Sphere& S) { return SphereFromJSON(Handle, _Params, S); },
+        [](const Geometries::Sphere&) { return true; },
+        [Sim](Geometries::Sphere& S) { return Sim->AddSphere(S); });
+}
+
+nlohmann::json GeometryRPCInterface::CylinderBulkCreate(nlohmann::json _JSONRequest) {
+
+    API::HandlerData Handle(std::move(_JSONRequest), Logger_, "Simulation/Geometry/Cylinder/BulkCreate", Simulations_);
+    if (Handle.HasError()) {
+        return Handle.ErrResponseJSON();
+    }
+
+    Simulation* Sim = Handle.Sim();
+    return API::BulkCreate<Geometries::Cylinder>(Handle, Logger_,
+        [&Handle](nlohmann::json& _Params, Geometries::Cylinder& S) { return CylinderFromJSON(Handle, _Params, S); },
+        [](const Geometries::Cylinder&) { return true; },
+        [Sim](Geometries::Cylinder& S) { return Sim->AddCylinder(S); });
+}
+
+nlohmann::json GeometryRPCInterface::BoxBulkCreate(nlohmann::json _JSONRequest) {
+
+    API::HandlerData Handle(std::move(_JSONRequest), Logger_, "Simulation/Geometry/Box/BulkCreate", Simulations_);
+    if (Handle.HasError()) {
+        return Handle.ErrResponseJSON();
+    }
+
+    Simulation* Sim = Handle.Sim();
+    return API::BulkCreate<Geometries::Box>(Handle, Logger_,
+        [&Handle](nlohmann::json& _Params, Geometries::Box& S) { return BoxFromJSON(Handle, _Params, S); },
+        [](const Geometries::Box&) { return true; },
+        [Sim](Geometries::Box& S) { return Sim->AddBox(S); });
 }
 
 
@@ -79,11 +79,15 @@ public:
      * See the relevant file in RPCInterface.(cpp/h) in various directories. 
      * 
      * @param _JSONRequest 
-     * @return std::string 
+     * @return nlohmann::json 
      */
-    std::string SphereCreate(std::string _JSONRequest);
-    std::string CylinderCreate(std::string _JSONRequest);
-    std::string BoxCreate(std::string _JSONRequest);
+    nlohmann::json SphereCreate(nlohmann::json _JSONRequest);
+    nlohmann::json CylinderCreate(nlohmann::json _JSONRequest);
+    nlohmann::json BoxCreate(nlohmann::json _JSONRequest);
+
+    nlohmann::json SphereBulkCreate(nlohmann::json _JSONRequest);
+    nlohmann::json CylinderBulkCreate(nlohmann::json _JSONRequest);
+    nlohmann::json BoxBulkCreate(nlohmann::json _JSONRequest);
 
 };
 
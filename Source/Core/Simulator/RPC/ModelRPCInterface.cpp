@@ -1,6 +1,7 @@
 #include <Simulator/RPC/ModelRPCInterface.h>
 #include <Simulator/Distributions/Generic.h>
 #include <RPC/APIStatusCode.h>
+#include <RPC/BulkRequest.h>
 #include <Simulator/SimpleCompartmental/SCNeuron.h>
 
 
@@ -38,33 +39,43 @@ ModelRPCInterface::ModelRPCInterface(BG::Common::Logger::LoggingSystem* _Logger,
     Simulations_ = _Simulations;
 
     // Register Callbacks
-    _RPCManager->AddRoute("Simulation/Staple/Create",                 std::bind(&ModelRPCInterface::StapleCreate, this, std::placeholders::_1));
-    _RPCManager->AddRoute("Simulation/Receptor/Create",               std::bind(&ModelRPCInterface::ReceptorCreate, this, std::placeholders::_1));
-    _RPCManager->AddRoute("Simulation/LIFCReceptor/Create",           std::bind(&ModelRPCInterface::LIFCReceptorCreate, this, std::placeholders::_1));
-    _RPCManager->AddRoute("Simulation/NetmorphLIFCReceptor/Create",   std::bind(&ModelRPCInterface::NetmorphLIFCReceptorCreate, this, std::placeholders::_1));
+    _RPCManager->AddJSONRoute("Simulation/Staple/Create",                 std::bind(&ModelRPCInterface::StapleCreate, this, std::placeholders::_1));
+    _RPCManager->AddJSONRoute("Simulation/Receptor/Create",               std::bind(&ModelRPCInterface::ReceptorCreate, this, std::placeholders::_1));
+    _RPCManager->AddJSONRoute("Simulation/LIFCReceptor/Create",           std::bind(&ModelRPCInterface::LIFCReceptorCreate, this, std::placeholders::_1));
+    _RPCManager->AddJSONRoute("Simulation/NetmorphLIFCReceptor/Create",   std::bind(&ModelRPCInterface::NetmorphLIFCReceptorCreate, this, std::placeholders::_1));
 
-    _RPCManager->AddRoute("Simulation/Compartments/BS/Create",        std::bind(&ModelRPCInterface::BSCreate, this, std::placeholders::_1));
-    _RPCManager->AddRoute("Simulation/Neuron/BS/Create",              std::bind(&ModelRPCInterface::BSNeuronCreate, this, std::placeholders::_1));
+    _RPCManager->AddJSONRoute("Simulation/Compartments/BS/Create",        std::bind(&ModelRPCInterface::BSCreate, this, std::placeholders::_1));
+    _RPCManager->AddJSONRoute("Simulation/Neuron/BS/Create",              std::bind(&ModelRPCInterface::BSNeuronCreate, this, std::placeholders::_1));
    
-    _RPCManager->AddRoute("Simulation/Compartments/SC/Create",        std::bind(&ModelRPCInterface::SCCreate, this, std::placeholders::_1));
-    _RPCManager->AddRoute("Simulation/Neuron/SC/Create",              std::bind(&ModelRPCInterface::SCNeuronCreate, this, std::placeholders::_1));
-    _RPCManager->AddRoute("Simulation/Neuron/SC/Edit",                std::bind(&ModelRPCInterface::SCNeuronEdit, this, std::placeholders::_1));
-
-    _RPCManager->AddRoute("Simulation/Compartments/LIFC/Create",      std::bind(&ModelRPCInterface::LIFCCreate, this, std::placeholders::_1));
-    _RPCManager->AddRoute("Simulation/Neuron/LIFC/Create",            std::bind(&ModelRPCInterface::LIFCNeuronCreate, this, std::placeholders::_1));
-    _RPCManager->AddRoute("Simulation/Neuron/LIFC/Edit",              std::bind(&ModelRPCInterface::LIFCNeuronEdit, this, std::placeholders::_1));
-
-    _RPCManager->AddRoute("Simulation/PatchClampDAC/Create",          std::bind(&ModelRPCInterface::PatchClampDACCreate, this, std::placeholders::_1));
-    _RPCManager->AddRoute("Simulation/PatchClampDAC/SetOutputList",   std::bind(&ModelRPCInterface::PatchClampDACSetOutputList, this, std::placeholders::_1));
-    _RPCManager->AddRoute("Simulation/PatchClampADC/Create",          std::bind(&ModelRPCInterface::PatchClampADCCreate, this, std::placeholders::_1));
-    _RPCManager->AddRoute("Simulation/PatchClampADC/SetSampleRate",   std::bind(&ModelRPCInterface::PatchClampADCSetSampleRate, this, std::placeholders::_1));
-    _RPCManager->AddRoute("Simulation/PatchClampADC/GetRecordedData", std::bind(&ModelRPCInterface::PatchClampADCGetRecordedData, this, std::placeholders::_1));
-
-    _RPCManager->AddRoute("Simulation/SetSpecificAPTimes",            std::bind(&ModelRPCInterface::SetSpecificAPTimes, this, std::placeholders::_1));
-    _RPCManager->AddRoute("Simulation/SetSpontaneousActivity",        std::bind(&ModelRPCInterface::SetSpontaneousActivity, this, std::placeholders::_1));
-
-    _RPCManager->AddRoute("Simulation/OptoModifyInjection",           std::bind(&ModelRPCInterface::OptoModifyInjection, this, std::placeholders::_1));
-    _RPCManager->AddRoute("Simulation/OptoActivation",                std::bind(&ModelRPCInterface::OptoActivation, this, std::placeholders::_1));
+    _RPCManager->AddJSONRoute("Simulation/Compartments/SC/Create",        std::bind(&ModelRPCInterface::SCCreate, this, std::placeholders::_1));
+    _RPCManager->AddJSONRoute("Simulation/Neuron/SC/Create",              std::bind(&ModelRPCInterface::SCNeuronCreate, this, std::placeholders::_1));
+    _RPCManager->AddJSONRoute("Simulation/Neuron/SC/Edit",                std::bind(&ModelRPCInterface::SCNeuronEdit, this, std::placeholders::_1));
+
+    _RPCManager->AddJSONRoute("Simulation/Compartments/LIFC/Create",      std::bind(&ModelRPCInterface::LIFCCreate, this, std::placeholders::_1));
+    _RPCManager->AddJSONRoute("Simulation/Neuron/LIFC/Create",            std::bind(&ModelRPCInterface::LIFCNeuronCreate, this, std::placeholders::_1));
+    _RPCManager->AddJSONRoute("Simulation/Neuron/LIFC/Edit",              std::bind(&ModelRPCInterface::LIFCNeuronEdit, this, std::placeholders::_1));
+
+    _RPCManager->AddJSONRoute("Simulation/PatchClampDAC/Create",          std::bind(&ModelRPCInterface::PatchClampDACCreate, this, std::placeholders::_1));
+    _RPCManager->AddJSONRoute("Simulation/PatchClampDAC/SetOutputList",   std::bind(&ModelRPCInterface::PatchClampDACSetOutputList, this, std::placeholders::_1));
+    _RPCManager->AddJSONRoute("Simulation/PatchClampADC/Create",          std::bind(&ModelRPCInterface::PatchClampADCCreate, this, std::placeholders::_1));
+    _RPCManager->AddJSONRoute("Simulation/PatchClampADC/SetSampleRate",   std::bind(&ModelRPCInterface::PatchClampADCSetSampleRate, this, std::placeholders::_1));
+    _RPCManager->AddJSONRoute("Simulation/PatchClampADC/GetRecordedData", std::bind(&ModelRPCInterface::PatchClampADCGetRecordedData, this, std::placeholders::_1));
+
+    _RPCManager->AddJSONRoute("Simulation/SetSpecificAPTimes",            std::bind(&ModelRPCInterface::SetSpecificAPTimes, this, std::placeholders::_1));
+    _RPCManager->AddJSONRoute("Simulation/SetSpontaneousActivity",        std::bind(&ModelRPCInterface::SetSpontaneousActivity, this, std::placeholders::_1));
+
+    _RPCManager->AddJSONRoute("Simulation/OptoModifyInjection",           std::bind(&ModelRPCInterface::OptoModifyInjection, this, std::placeholders::_1));
+    _RPCManager->AddJSONRoute("Simulation/OptoActivation",                std::bind(&ModelRPCInterface::OptoActivation, this, std::placeholders::_1));
+
+    _RPCManager->AddJSONRoute("Simulation/Receptor/BulkCreate",             std::bind(&ModelRPCInterface::ReceptorBulkCreate, this, std::placeholders::_1));
+    _RPCManager->AddJSONRoute("Simulation/LIFCReceptor/BulkCreate",         std::bind(&ModelRPCInterface::LIFCReceptorBulkCreate, this, std::placeholders::_1));
+    _RPCManager->AddJSONRoute("Simulation/NetmorphLIFCReceptor/BulkCreate", std::bind(&ModelRPCInterface::NetmorphLIFCReceptorBulkCreate, this, std::placeholders::_1));
+    _RPCManager->AddJSONRoute("Simulation/Compartments/BS/BulkCreate",      std::bind(&ModelRPCInterface::BSBulkCreate, this, std::placeholders::_1));
+    _RPCManager->AddJSONRoute("Simulation/Neuron/BS/BulkCreate",            std::bind(&ModelRPCInterface::BSNeuronBulkCreate, this, std::placeholders::_1));
+    _RPCManager->AddJSONRoute("Simulation/Compartments/SC/BulkCreate",      std::bind(&ModelRPCInterface::SCBulkCreate, this, std::placeholders::_1));
+    _RPCManager->AddJSONRoute("Simulation/Neuron/SC/BulkCreate",            std::bind(&ModelRPCInterface::SCNeuronBulkCreate, this, std::placeholders::_1));
+    _RPCManager->AddJSONRoute("Simulation/Compartments/LIFC/BulkCreate",    std::bind(&ModelRPCInterface::LIFCBulkCreate, this, std::placeholders::_1));
+    _RPCManager->AddJSONRoute("Simulation/Neuron/LIFC/BulkCreate",          std::bind(&ModelRPCInterface::LIFCNeuronBulkCreate, this, std::placeholders::_1));
 
 }
 
@@ -72,11 +83,11 @@ ModelRPCInterface::~ModelRPCInterface() {
 
 }
 
-std::string ModelRPCInterface::StapleCreate(std::string _JSONRequest) {
+nlohmann::json ModelRPCInterface::StapleCreate(nlohmann::json _JSONRequest) {
  
-    API::HandlerData Handle(_JSONRequest, Logger_, "Simulation/Staple/Create", Simulations_);
+    API::HandlerData Handle(std::move(_JSONRequest), Logger_, "Simulation/Staple/Create", Simulations_);
     if (Handle.HasError()) {
-        return Handle.ErrResponse();
+        return Handle.ErrResponseJSON();
     }
 
     // Build New Staple Object
@@ -84,14 +95,34 @@ std::string ModelRPCInterface::StapleCreate(std::string _JSONRequest) {
     if ((!Handle.GetParInt("SourceCompartmentID", C.SourceCompartmentID))
         || (!Handle.GetParInt("DestinationCompartmentID", C.DestinationCompartmentID))
         || (!Handle.GetParString("Name", C.Name))) {
-        return Handle.ErrResponse();
+        return Handle.ErrResponseJSON();
     }
 
     C.ID = Handle.Sim()->Staples.size();
     Handle.Sim()->Staples.push_back(C);
 
     // Return Result ID
-    return Handle.ResponseWithID("StapleID", C.ID);
+    return Handle.ResponseWithIDJSON("StapleID", C.ID);
+}
+
+// The parameter readers below are shared by the single and the bulk create
+// routes. They read from _Params, which is the request or one item of a bulk
+// request (see API::BulkRequest).
+bool ReceptorFromJSON(API::HandlerData& Handle, nlohmann::json& _Params, Connections::Receptor& C) {
+    std::string neurotransmitter_cache;
+    if ((!Handle.GetParInt("SourceCompartmentID", C.SourceCompartmentID, _Params))
+        || (!Handle.GetParInt("DestinationCompartmentID", C.DestinationCompartmentID, _Params))
+        || (!Handle.GetParFloat("Conductance_nS", C.Conductance_nS, _Params))
+        || (!Handle.GetParFloat("TimeConstantRise_ms", C.TimeConstantRise_ms, _Params))
+        || (!Handle.GetParFloat("TimeConstantDecay_ms", C.TimeConstantDecay_ms, _Params))
+        || (!Handle.GetParString("Neurotransmitter", neurotransmitter_cache, _Params))
+        || (!Handle.GetParInt("ReceptorMorphology", C.ShapeID, _Params))
+        //|| (!Handle.GetParVec3("ReceptorPos", C.ReceptorPos_um))
+        || (!Handle.GetParString("Name", C.Name, _Params))) {
+        return false;
+    }
+    C.safeset_Neurotransmitter(neurotransmitter_cache.c_str());
+    return true;
 }
 
 /**
@@ -116,36 +147,26 @@ std::string ModelRPCInterface::StapleCreate(std::string _JSONRequest) {
  * 3. Connect RData with the SrcNeuronPtr as well.
  * 4. Update the SrcNeuron type by receptor type.
  */
-std::string ModelRPCInterface::ReceptorCreate(std::string _JSONRequest) {
+nlohmann::json ModelRPCInterface::ReceptorCreate(nlohmann::json _JSONRequest) {
  
-    API::HandlerData Handle(_JSONRequest, Logger_, "Simulation/Receptor/Create", Simulations_);
+    API::HandlerData Handle(std::move(_JSONRequest), Logger_, "Simulation/Receptor/Create", Simulations_);
     if (Handle.HasError()) {
-        return Handle.ErrResponse();
+        return Handle.ErrResponseJSON();
     }
 
     // Build New Receptor Object
     Connections::Receptor C;
-    std::string neurotransmitter_cache;
-    if ((!Handle.GetParInt("SourceCompartmentID", C.SourceCompartmentID))
-        || (!Handle.GetParInt("DestinationCompartmentID", C.DestinationCompartmentID))
-        || (!Handle.GetParFloat("Conductance_nS", C.Conductance_nS))
-        || (!Handle.GetParFloat("TimeConstantRise_ms", C.TimeConstantRise_ms))
-        || (!Handle.GetParFloat("TimeConstantDecay_ms", C.TimeConstantDecay_ms))
-        || (!Handle.GetParString("Neurotransmitter", neurotransmitter_cache))
-        || (!Handle.GetParInt("ReceptorMorphology", C.ShapeID))
-        //|| (!Handle.GetParVec3("ReceptorPos", C.ReceptorPos_um))
-        || (!Handle.GetParString("Name", C.Name))) {
-        return Handle.ErrResponse();
+    if (!ReceptorFromJSON(Handle, Handle.ReqJSON(), C)) {
+        return Handle.ErrResponseJSON();
     }
-    C.safeset_Neurotransmitter(neurotransmitter_cache.c_str());
 
     C.ID = Handle.Sim()->AddReceptor(C);
     if (C.ID<0) {
-        return Handle.ErrResponse(API::BGStatusCode::BGStatusInvalidParametersPassed);
+        return Handle.ErrResponseJSON(API::BGStatusCode::BGStatusInvalidParametersPassed);
     }
 
     // Return Result ID
-    return Handle.ResponseWithID("ReceptorID", C.ID);
+    return Handle.ResponseWithIDJSON("ReceptorID", C.ID);
 }
 
 const std::map<std::string, Connections::LIFCSTDPMethodEnum> LIFCSTDPMethodStrToEnum = {
@@ -176,120 +197,147 @@ Connections::NeurotransmitterType LIFCNeurotransmitter(const std::string& neurot
     return it->second;
 }
 
-std::string ModelRPCInterface::LIFCReceptorCreate(std::string _JSONRequest) {
- 
-    API::HandlerData Handle(_JSONRequest, Logger_, "Simulation/LIFCReceptor/Create", Simulations_);
-    if (Handle.HasError()) {
-        return Handle.ErrResponse();
-    }
-
-    // Build New Receptor Object
-    Connections::LIFCReceptor C;
+bool LIFCReceptorFromJSON(API::HandlerData& Handle, nlohmann::json& _Params, Connections::LIFCReceptor& C) {
     std::string neurotransmitter_cache;
     std::string stdpmethod_cache;
-    if ((!Handle.GetParInt("SourceCompartmentID", C.SourceCompartmentID))
-        || (!Handle.GetParInt("DestinationCompartmentID", C.DestinationCompartmentID))
-
-        || (!Handle.GetParFloat("ReversalPotential_mV", C.ReversalPotential_mV))
-        || (!Handle.GetParFloat("PSPRise_ms", C.PSPRise_ms))
-        || (!Handle.GetParFloat("PSPDecay_ms", C.PSPDecay_ms))
-        || (!Handle.GetParFloat("PeakConductance_nS", C.PeakConductance_nS))
-        || (!Handle.GetParFloat("Weight", C.Weight))
-        || (!Handle.GetParFloat("OnsetDelay_ms", C.OnsetDelay_ms))
-        || (!Handle.GetParString("Neurotransmitter", neurotransmitter_cache))
-        || (!Handle.GetParBool("voltage_gated", C.voltage_gated))
-
-        || (!Handle.GetParString("STDP_Method", stdpmethod_cache))
-        || (!Handle.GetParFloat("STDP_A_pos", C.STDP_A_pos))
-        || (!Handle.GetParFloat("STDP_A_neg", C.STDP_A_neg))
-        || (!Handle.GetParFloat("STDP_Tau_pos", C.STDP_Tau_pos))
-        || (!Handle.GetParFloat("STDP_Tau_neg", C.STDP_Tau_neg))
-        || (!Handle.GetParFloat("STDP_Shift", C.STDP_Shift))
-
-        || (!Handle.GetParInt("ReceptorMorphology", C.ShapeID))
-        || (!Handle.GetParString("Name", C.Name))) {
-        return Handle.ErrResponse();
+    if ((!Handle.GetParInt("SourceCompartmentID", C.SourceCompartmentID, _Params))
+        || (!Handle.GetParInt("DestinationCompartmentID", C.DestinationCompartmentID, _Params))
+
+        || (!Handle.GetParFloat("ReversalPotential_mV", C.ReversalPotential_mV, _Params))
+        || (!Handle.GetParFloat("PSPRise_ms", C.PSPRise_ms, _Params))
+        || (!Handle.GetParFloat("PSPDecay_ms", C.PSPDecay_ms, _Params))
+        || (!Handle.GetParFloat("PeakConductance_nS", C.PeakConductance_nS, _Params))
+        || (!Handle.GetParFloat("Weight", C.Weight, _Params))
+        || (!Handle.GetParFloat("OnsetDelay_ms", C.OnsetDelay_ms, _Params))
+        || (!Handle.GetParString("Neurotransmitter", neurotransmitter_cache, _Params))
+        || (!Handle.GetParBool("voltage_gated", C.voltage_gated, _Params))
+
+        || (!Handle.GetParString("STDP_Method", stdpmethod_cache, _Params))
+        || (!Handle.GetParFloat("STDP_A_pos", C.STDP_A_pos, _Params))
+        || (!Handle.GetParFloat("STDP_A_neg", C.STDP_A_neg, _Params))
+        || (!Handle.GetParFloat("STDP_Tau_pos", C.STDP_Tau_pos, _Params))
+        || (!Handle.GetParFloat("STDP_Tau_neg", C.STDP_Tau_neg, _Params))
+        || (!Handle.GetParFloat("STDP_Shift", C.STDP_Shift, _Params))
+
+        || (!Handle.GetParInt("ReceptorMorphology", C.ShapeID, _Params))
+        || (!Handle.GetParString("Name", C.Name, _Params))) {
+        return false;
     }
     C.Neurotransmitter = LIFCNeurotransmitter(neurotransmitter_cache);
     if (C.Neurotransmitter >= Connections::NUMNeurotransmitterType) {
-        Logger_->Log("Error: Unrecognized LIFC Neurotransmitter type", 7);
-        return Handle.ErrResponse(API::BGStatusCode::BGStatusInvalidParametersPassed);
+        Handle.Sim()->Logger_->Log("Error: Unrecognized LIFC Neurotransmitter type", 7);
+        return false;
     }
 
     C.STDP_Method = LIFCSTDPMethod(stdpmethod_cache);
     if (C.STDP_Method >= Connections::NUMLIFCSTDPMethodEnum) {
-        Logger_->Log("Error: Unrecognized LIFC STDP Method", 7);
-        return Handle.ErrResponse(API::BGStatusCode::BGStatusInvalidParametersPassed);
+        Handle.Sim()->Logger_->Log("Error: Unrecognized LIFC STDP Method", 7);
+        return false;
     }
-
-    C.ID = Handle.Sim()->AddLIFCReceptor(C);
-    if (C.ID<0) {
-        return Handle.ErrResponse(API::BGStatusCode::BGStatusInvalidParametersPassed);
-    }
-
-    // Return Result ID
-    return Handle.ResponseWithID("ReceptorID", C.ID);
+    return true;
 }
 
-std::string ModelRPCInterface::NetmorphLIFCReceptorCreate(std::string _JSONRequest) {
+nlohmann::json ModelRPCInterface::LIFCReceptorCreate(nlohmann::json _JSONRequest) {
  
-    API::HandlerData Handle(_JSONRequest, Logger_, "Simulation/NetmorphLIFCReceptor/Create", Simulations_);
+    API::HandlerData Handle(std::move(_JSONRequest), Logger_, "Simulation/LIFCReceptor/Create", Simulations_);
     if (Handle.HasError()) {
-        return Handle.ErrResponse();
+        return Handle.ErrResponseJSON();
     }
 
     // Build New Receptor Object
     Connections::LIFCReceptor C;
-    Connections::NetmorphLIFCReceptorRaw CDataRaw; // additional data
-    std::string neurotransmitter_cache;
-    std::string stdpmethod_cache;
-    if ((!Handle.GetParInt("SourceCompartmentID", C.SourceCompartmentID))
-        || (!Handle.GetParInt("DestinationCompartmentID", C.DestinationCompartmentID))
-
-        || (!Handle.GetParFloat("ReversalPotential_mV", C.ReversalPotential_mV))
-        || (!Handle.GetParFloat("PSPRise_ms", C.PSPRise_ms))
-        || (!Handle.GetParFloat("PSPDecay_ms", C.PSPDecay_ms))
-
-        || (!Handle.GetParFloat("ReceptorPeakConductance_nS", CDataRaw.ReceptorPeakConductance_nS))
-        || (!Handle.GetParInt("ReceptorQuantity", CDataRaw.ReceptorQuantity))
+    if (!LIFCReceptorFromJSON(Handle, Handle.ReqJSON(), C)) {
+        return Handle.ErrResponseJSON(API::BGStatusCode::BGStatusInvalidParametersPassed);
+    }
 
-        || (!Handle.GetParFloat("HillocDistance_um", CDataRaw.HillocDistance_um))
-        || (!Handle.GetParFloat("Velocity_mps", CDataRaw.Velocity_mps))
-        || (!Handle.GetParFloat("SynapticDelay_ms", CDataRaw.SynapticDelay_ms))
-        || (!Handle.GetParString("Neurotransmitter", neurotransmitter_cache))
-        || (!Handle.GetParBool("voltage_gated", C.voltage_gated))
+    C.ID = Handle.Sim()->AddLIFCReceptor(C);
+    if (C.ID<0) {
+        return Handle.ErrResponseJSON(API::BGStatusCode::BGStatusInvalidParametersPassed);
+    }
 
-        || (!Handle.GetParFloat("Weight", C.Weight))
-        || (!Handle.GetParString("STDP_Method", stdpmethod_cache))
-        || (!Handle.GetParFloat("STDP_A_pos", C.STDP_A_pos))
-        || (!Handle.GetParFloat("STDP_A_neg", C.STDP_A_neg))
-        || (!Handle.GetParFloat("STDP_Tau_pos", C.STDP_Tau_pos))
-        || (!Handle.GetParFloat("STDP_Tau_neg", C.STDP_Tau_neg))
-        || (!Handle.GetParFloat("STDP_Shift", C.STDP_Shift))
+    // Return Result ID
+    return Handle.ResponseWithIDJSON("ReceptorID", C.ID);
+}
 
-        || (!Handle.GetParInt("ReceptorMorphology", C.ShapeID))
-        || (!Handle.GetParString("Name", C.Name))) {
-        return Handle.ErrResponse();
+bool NetmorphLIFCReceptorFromJSON(API::HandlerData& Handle, nlohmann::json& _Params, Connections::LIFCReceptor& C, Connections::NetmorphLIFCReceptorRaw& CDataRaw) {
+    std::string neurotransmitter_cache;
+    std::string stdpmethod_cache;
+    if ((!Handle.GetParInt("SourceCompartmentID", C.SourceCompartmentID, _Params))
+        || (!Handle.GetParInt("DestinationCompartmentID", C.DestinationCompartmentID, _Params))
+
+        || (!Handle.GetParFloat("ReversalPotential_mV", C.ReversalPotential_mV, _Params))
+        || (!Handle.GetParFloat("PSPRise_ms", C.PSPRise_ms, _Params))
+        || (!Handle.GetParFloat("PSPDecay_ms", C.PSPDecay_ms, _Params))
+
+        || (!Handle.GetParFloat("ReceptorPeakConductance_nS", CDataRaw.ReceptorPeakConductance_nS, _Params))
+        || (!Handle.GetParInt("ReceptorQuantity", CDataRaw.ReceptorQuantity, _Params))
+
+        || (!Handle.GetParFloat("HillocDistance_um", CDataRaw.HillocDistance_um, _Params))
+        || (!Handle.GetParFloat("Velocity_mps", CDataRaw.Velocity_mps, _Params))
+        || (!Handle.GetParFloat("SynapticDelay_ms", CDataRaw.SynapticDelay_ms, _Params))
+        || (!Handle.GetParString("Neurotransmitter", neurotransmitter_cache, _Params))
+        || (!Handle.GetParBool("voltage_gated", C.voltage_gated, _Params))
+
+        || (!Handle.GetParFloat("Weight", C.Weight, _Params))
+        || (!Handle.GetParString("STDP_Method", stdpmethod_cache, _Params))
+        || (!Handle.GetParFloat("STDP_A_pos", C.STDP_A_pos, _Params))
+        || (!Handle.GetParFloat("STDP_A_neg", C.STDP_A_neg, _Params))
+        || (!Handle.GetParFloat("STDP_Tau_pos", C.STDP_Tau_pos, _Params))
+        || (!Handle.GetParFloat("STDP_Tau_neg", C.STDP_Tau_neg, _Params))
+        || (!Handle.GetParFloat("STDP_Shift", C.STDP_Shift, _Params))
+
+        || (!Handle.GetParInt("ReceptorMorphology", C.ShapeID, _Params))
+        || (!Handle.GetParString("Name", C.Name, _Params))) {
+        return false;
     }
     C.Neurotransmitter = LIFCNeurotransmitter(neurotransmitter_cache);
     if (C.Neurotransmitter >= Connections::NUMNeurotransmitterType) {
-        Logger_->Log("Error: Unrecognized LIFC Neurotransmitter type", 7);
-        return Handle.ErrResponse(API::BGStatusCode::BGStatusInvalidParametersPassed);
+        Handle.Sim()->Logger_->Log("Error: Unrecognized LIFC Neurotransmitter type", 7);
+        return false;
     }
 
     C.STDP_Method = LIFCSTDPMethod(stdpmethod_cache);
     if (C.STDP_Method >= Connections::NUMLIFCSTDPMethodEnum) {
-        Logger_->Log("Error: Unrecognized LIFC STDP Method", 7);
-        return Handle.ErrResponse(API::BGStatusCode::BGStatusInvalidParametersPassed);
+        Handle.Sim()->Logger_->Log("Error: Unrecognized LIFC STDP Method", 7);
+        return false;
+    }
+    return true;
+}
+
+nlohmann::json ModelRPCInterface::NetmorphLIFCReceptorCreate(nlohmann::json _JSONRequest) {
+ 
+    API::HandlerData Handle(std::move(_JSONRequest), Logger_, "Simulation/NetmorphLIFCReceptor/Create", Simulations_);
+    if (Handle.HasError()) {
+        return Handle.ErrResponseJSON();
+    }
+
+    // Build New Receptor Object
+    Connections::LIFCReceptor C;
+    Connections::NetmorphLIFCReceptorRaw CDataRaw; // additional data
+    if (!NetmorphLIFCReceptorFromJSON(Handle, Handle.ReqJSON(), C, CDataRaw)) {
+        return Handle.ErrResponseJSON(API::BGStatusCode::BGStatusInvalidParametersPassed);
     }
 
     C.ID = Handle.Sim()->AddNetmorphLIFCReceptor(C, CDataRaw);
     if (C.ID<0) {
-        return Handle.ErrResponse(API::BGStatusCode::BGStatusInvalidParametersPassed);
+        return Handle.ErrResponseJSON(API::BGStatusCode::BGStatusInvalidParametersPassed);
     }
 
     // Return Result ID
-    return Handle.ResponseWithID("ReceptorID", C.ID);
+    return Handle.ResponseWithIDJSON("ReceptorID", C.ID);
+}
+
+bool BSCompartmentFromJSON(API::HandlerData& Handle, nlohmann::json& _Params, Compartments::BS& C) {
+    if ((!Handle.GetParInt("ShapeID", C.ShapeID, _Params))
+        || (!Handle.GetParFloat("MembranePotential_mV", C.MembranePotential_mV, _Params))
+        || (!Handle.GetParFloat("SpikeThreshold_mV", C.SpikeThreshold_mV, _Params))
+        || (!Handle.GetParFloat("DecayTime_ms", C.DecayTime_ms, _Params))
+        || (!Handle.GetParFloat("RestingPotential_mV", C.RestingPotential_mV, _Params))
+        || (!Handle.GetParFloat("AfterHyperpolarizationAmplitude_mV", C.AfterHyperpolarizationAmplitude_mV, _Params))
+        || (!Handle.GetParString("Name", C.Name, _Params))) {
+        return false;
+    }
+    return true;
 }
 
 /**
@@ -297,32 +345,43 @@ std::string ModelRPCInterface::NetmorphLIFCReceptorCreate(std::string _JSONReque
  * Form: A shape.
  * Function: Some parameters.
  */
-std::string ModelRPCInterface::BSCreate(std::string _JSONRequest) {
+nlohmann::json ModelRPCInterface::BSCreate(nlohmann::json _JSONRequest) {
  
-    API::HandlerData Handle(_JSONRequest, Logger_, "Simulation/Compartments/BS/Create", Simulations_);
+    API::HandlerData Handle(std::move(_JSONRequest), Logger_, "Simulation/Compartments/BS/Create", Simulations_);
     if (Handle.HasError()) {
-        return Handle.ErrResponse();
+        return Handle.ErrResponseJSON();
     }
 
     // Build New BS Object
     Compartments::BS C;
-    if ((!Handle.GetParInt("ShapeID", C.ShapeID))
-        || (!Handle.GetParFloat("MembranePotential_mV", C.MembranePotential_mV))
-        || (!Handle.GetParFloat("SpikeThreshold_mV", C.SpikeThreshold_mV))
-        || (!Handle.GetParFloat("DecayTime_ms", C.DecayTime_ms))
-        || (!Handle.GetParFloat("RestingPotential_mV", C.RestingPotential_mV))
-        || (!Handle.GetParFloat("AfterHyperpolarizationAmplitude_mV", C.AfterHyperpolarizationAmplitude_mV))
-        || (!Handle.GetParString("Name", C.Name))) {
-        return Handle.ErrResponse();
+    if (!BSCompartmentFromJSON(Handle, Handle.ReqJSON(), C)) {
+        return Handle.ErrResponseJSON(API::BGStatusCode::BGStatusInvalidParametersPassed);
     }
 
     C.ID = Handle.Sim()->AddSCCompartment(C, BSNEURONS);
     if (C.ID < 0) {
-        return Handle.ErrResponse(API::BGStatusCode::BGStatusInvalidParametersPassed);
+        return Handle.ErrResponseJSON(API::BGStatusCode::BGStatusInvalidParametersPassed);
     }
 
     // Return Result ID
-    return Handle.ResponseWithID("CompartmentID", C.ID);
+    return Handle.ResponseWithIDJSON("CompartmentID", C.ID);
+}
+
+bool BSNeuronFromJSON(API::HandlerData& Handle, nlohmann::json& _Params, CoreStructs::BSNeuronStruct& C) {
+    if ((!Handle.GetParInt("SomaID", C.SomaCompartmentID, _Params))
+        || (!Handle.GetParInt("AxonID", C.AxonCompartmentID, _Params))
+        || (!Handle.GetParFloat("MembranePotential_mV", C.MembranePotential_mV, _Params))
+        || (!Handle.GetParFloat("RestingPotential_mV", C.RestingPotential_mV, _Params))
+        || (!Handle.GetParFloat("SpikeThreshold_mV", C.SpikeThreshold_mV, _Params))
+        || (!Handle.GetParFloat("DecayTime_ms", C.DecayTime_ms, _Params))
+        || (!Handle.GetParFloat("AfterHyperpolarizationAmplitude_mV", C.AfterHyperpolarizationAmplitude_mV, _Params))
+        || (!Handle.GetParFloat("PostsynapticPotentialRiseTime_ms", C.PostsynapticPotentialRiseTime_ms, _Params))
+        || (!Handle.GetParFloat("PostsynapticPotentialDecayTime_ms", C.PostsynapticPotentialDecayTime_ms, _Params))
+        || (!Handle.GetParFloat("PostsynapticPotentialAmplitude_nA", C.PostsynapticPotentialAmplitude_nA, _Params))
+        || (!Handle.GetParString("Name", C.Name, _Params))) {
+        return false;
+    }
+    return true;
 }
 
 /*
@@ -336,27 +395,17 @@ OR
 1. Create a NeuralCircuit.
 2. Tell the NeuralCircuit to create a neuron.
 */
-std::string ModelRPCInterface::BSNeuronCreate(std::string _JSONRequest) {
+nlohmann::json ModelRPCInterface::BSNeuronCreate(nlohmann::json _JSONRequest) {
  
-    API::HandlerData Handle(_JSONRequest, Logger_, "Simulation/Neuron/BS/Create", Simulations_);
+    API::HandlerData Handle(std::move(_JSONRequest), Logger_, "Simulation/Neuron/BS/Create", Simulations_);
     if (Handle.HasError()) {
-        return Handle.ErrResponse();
+        return Handle.ErrResponseJSON();
     }
 
     // Build New BSNeuron Object
     CoreStructs::BSNeuronStruct C;
-    if ((!Handle.GetParInt("SomaID", C.SomaCompartmentID))
-        || (!Handle.GetParInt("AxonID", C.AxonCompartmentID))
-        || (!Handle.GetParFloat("MembranePotential_mV", C.MembranePotential_mV))
-        || (!Handle.GetParFloat("RestingPotential_mV", C.RestingPotential_mV))
-        || (!Handle.GetParFloat("SpikeThreshold_mV", C.SpikeThreshold_mV))
-        || (!Handle.GetParFloat("DecayTime_ms", C.DecayTime_ms))
-        || (!Handle.GetParFloat("AfterHyperpolarizationAmplitude_mV", C.AfterHyperpolarizationAmplitude_mV))
-        || (!Handle.GetParFloat("PostsynapticPotentialRiseTime_ms", C.PostsynapticPotentialRiseTime_ms))
-        || (!Handle.GetParFloat("PostsynapticPotentialDecayTime_ms", C.PostsynapticPotentialDecayTime_ms))
-        || (!Handle.GetParFloat("PostsynapticPotentialAmplitude_nA", C.PostsynapticPotentialAmplitude_nA))
-        || (!Handle.GetParString("Name", C.Name))) {
-        return Handle.ErrResponse();
+    if (!BSNeuronFromJSON(Handle, Handle.ReqJSON(), C)) {
+        return Handle.ErrResponseJSON(API::BGStatusCode::BGStatusInvalidParametersPassed);
     }
 
     // We cache the pointers to the compartments in the neuron data, so that it
@@ -364,21 +413,21 @@ std::string ModelRPCInterface::BSNeuronCreate(std::string _JSONRequest) {
     C.SomaCompartmentPtr = Handle.Sim()->FindBSCompartmentByID(C.SomaCompartmentID);
     if (!C.SomaCompartmentPtr) {
         Handle.Sim()->Logger_->Log("Soma compartment with ID "+std::to_string(C.SomaCompartmentID)+" not found", 7);
-        return Handle.ErrResponse(API::BGStatusCode::BGStatusInvalidParametersPassed);
+        return Handle.ErrResponseJSON(API::BGStatusCode::BGStatusInvalidParametersPassed);
     }
     C.AxonCompartmentPtr = Handle.Sim()->FindBSCompartmentByID(C.AxonCompartmentID);
     if (!C.AxonCompartmentPtr) {
         Handle.Sim()->Logger_->Log("Axon compartment with ID "+std::to_string(C.AxonCompartmentID)+" not found", 7);
-        return Handle.ErrResponse(API::BGStatusCode::BGStatusInvalidParametersPassed);
+        return Handle.ErrResponseJSON(API::BGStatusCode::BGStatusInvalidParametersPassed);
     }
 
     C.ID = Handle.Sim()->AddBSNeuron(C);
     if (C.ID < 0) {
-        return Handle.ErrResponse(API::BGStatusCode::BGStatusInvalidParametersPassed);
+        return Handle.ErrResponseJSON(API::BGStatusCode::BGStatusInvalidParametersPassed);
     }
 
     // Return Result ID
-    return Handle.ResponseWithID("NeuronID", C.ID);
+    return Handle.ResponseWithIDJSON("NeuronID", C.ID);
 }
 
 /**
@@ -386,86 +435,87 @@ std::string ModelRPCInterface::BSNeuronCreate(std::string _JSONRequest) {
  * Form: A shape.
  * Function: Some parameters.
  */
-std::string ModelRPCInterface::SCCreate(std::string _JSONRequest) {
+nlohmann::json ModelRPCInterface::SCCreate(nlohmann::json _JSONRequest) {
  
-    API::HandlerData Handle(_JSONRequest, Logger_, "Simulation/Compartments/SC/Create", Simulations_);
+    API::HandlerData Handle(std::move(_JSONRequest), Logger_, "Simulation/Compartments/SC/Create", Simulations_);
     if (Handle.HasError()) {
-        return Handle.ErrResponse();
+        return Handle.ErrResponseJSON();
     }
 
     // Build New SC Object
     Compartments::SC C;
-    if ((!Handle.GetParInt("ShapeID", C.ShapeID))
-        || (!Handle.GetParFloat("MembranePotential_mV", C.MembranePotential_mV))
-        || (!Handle.GetParFloat("SpikeThreshold_mV", C.SpikeThreshold_mV))
-        || (!Handle.GetParFloat("DecayTime_ms", C.DecayTime_ms))
-        || (!Handle.GetParFloat("RestingPotential_mV", C.RestingPotential_mV))
-        || (!Handle.GetParFloat("AfterHyperpolarizationAmplitude_mV", C.AfterHyperpolarizationAmplitude_mV))
-        || (!Handle.GetParString("Name", C.Name))) {
-        return Handle.ErrResponse();
+    if (!BSCompartmentFromJSON(Handle, Handle.ReqJSON(), C)) {
+        return Handle.ErrResponseJSON(API::BGStatusCode::BGStatusInvalidParametersPassed);
     }
 
     C.ID = Handle.Sim()->AddSCCompartment(C, SCNEURONS);
     if (C.ID < 0) {
-        return Handle.ErrResponse(API::BGStatusCode::BGStatusInvalidParametersPassed);
+        return Handle.ErrResponseJSON(API::BGStatusCode::BGStatusInvalidParametersPassed);
     }
 
     // Return Result ID
-    return Handle.ResponseWithID("CompartmentID", C.ID);
+    return Handle.ResponseWithIDJSON("CompartmentID", C.ID);
+}
+
+bool SCNeuronFromJSON(API::HandlerData& Handle, nlohmann::json& _Params, CoreStructs::SCNeuronStruct& C) {
+    if ((!Handle.GetParVecInt("SomaIDs", C.SomaCompartmentIDs, _Params))
+        || (!Handle.GetParVecInt("DendriteIDs", C.DendriteCompartmentIDs, _Params))
+        || (!Handle.GetParVecInt("AxonIDs", C.AxonCompartmentIDs, _Params))
+        || (!Handle.GetParFloat("MembranePotential_mV", C.MembranePotential_mV, _Params))
+        || (!Handle.GetParFloat("RestingPotential_mV", C.RestingPotential_mV, _Params))
+        || (!Handle.GetParFloat("SpikeThreshold_mV", C.SpikeThreshold_mV, _Params))
+        || (!Handle.GetParFloat("DecayTime_ms", C.DecayTime_ms, _Params))
+        || (!Handle.GetParFloat("AfterHyperpolarizationAmplitude_mV", C.AfterHyperpolarizationAmplitude_mV, _Params))
+        || (!Handle.GetParFloat("PostsynapticPotentialRiseTime_ms", C.PostsynapticPotentialRiseTime_ms, _Params))
+        || (!Handle.GetParFloat("PostsynapticPotentialDecayTime_ms", C.PostsynapticPotentialDecayTime_ms, _Params))
+        || (!Handle.GetParFloat("PostsynapticPotentialAmplitude_nA", C.PostsynapticPotentialAmplitude_nA, _Params))
+        || (!Handle.GetParString("Name", C.Name, _Params))) {
+        return false;
+    }
+    return true;
 }
 
-std::string ModelRPCInterface::SCNeuronCreate(std::string _JSONRequest) {
+nlohmann::json ModelRPCInterface::SCNeuronCreate(nlohmann::json _JSONRequest) {
  
-    API::HandlerData Handle(_JSONRequest, Logger_, "Simulation/Neuron/SC/Create", Simulations_);
+    API::HandlerData Handle(std::move(_JSONRequest), Logger_, "Simulation/Neuron/SC/Create", Simulations_);
     if (Handle.HasError()) {
-        return Handle.ErrResponse();
+        return Handle.ErrResponseJSON();
     }
 
     // Build New SCNeuron Object
     CoreStructs::SCNeuronStruct C;
-    if ((!Handle.GetParVecInt("SomaIDs", C.SomaCompartmentIDs))
-        || (!Handle.GetParVecInt("DendriteIDs", C.DendriteCompartmentIDs))
-        || (!Handle.GetParVecInt("AxonIDs", C.AxonCompartmentIDs))
-        || (!Handle.GetParFloat("MembranePotential_mV", C.MembranePotential_mV))
-        || (!Handle.GetParFloat("RestingPotential_mV", C.RestingPotential_mV))
-        || (!Handle.GetParFloat("SpikeThreshold_mV", C.SpikeThreshold_mV))
-        || (!Handle.GetParFloat("DecayTime_ms", C.DecayTime_ms))
-        || (!Handle.GetParFloat("AfterHyperpolarizationAmplitude_mV", C.AfterHyperpolarizationAmplitude_mV))
-        || (!Handle.GetParFloat("PostsynapticPotentialRiseTime_ms", C.PostsynapticPotentialRiseTime_ms))
-        || (!Handle.GetParFloat("PostsynapticPotentialDecayTime_ms", C.PostsynapticPotentialDecayTime_ms))
-        || (!Handle.GetParFloat("PostsynapticPotentialAmplitude_nA", C.PostsynapticPotentialAmplitude_nA))
-        || (!Handle.GetParString("Name", C.Name))) {
-        return Handle.ErrResponse();
+    if (!SCNeuronFromJSON(Handle, Handle.ReqJSON(), C)) {
+        return Handle.ErrResponseJSON(API::BGStatusCode::BGStatusInvalidParametersPassed);
     }
 
     C.ID = Handle.Sim()->AddSCNeuron(C);
     if (C.ID < 0) {
-        return Handle.ErrResponse(API::BGStatusCode::BGStatusInvalidParametersPassed);
+        return Handle.ErrResponseJSON(API::BGStatusCode::BGStatusInvalidParametersPassed);
     }
 
     // Return Result ID
-    return Handle.ResponseWithID("NeuronID", C.ID);
+    return Handle.ResponseWithIDJSON("NeuronID", C.ID);
 }
 
 // Takes a list of IDs of previously created neurons and edits parameters specified.
 // Empty list of neuron IDs means all neurons.
-std::string ModelRPCInterface::SCNeuronEdit(std::string _JSONRequest) {
+nlohmann::json ModelRPCInterface::SCNeuronEdit(nlohmann::json _JSONRequest) {
  
-    API::HandlerData Handle(_JSONRequest, Logger_, "Simulation/Neuron/SC/Edit", Simulations_);
+    API::HandlerData Handle(std::move(_JSONRequest), Logger_, "Simulation/Neuron/SC/Edit", Simulations_);
     if (Handle.HasError()) {
-        return Handle.ErrResponse();
+        return Handle.ErrResponseJSON();
     }
 
     // Collect and check neuron IDs
     std::vector<int> NeuronIDs;
     if (!Handle.GetParVecInt("NeuronIDs", NeuronIDs)) {
-        return Handle.ErrResponse();
+        return Handle.ErrResponseJSON();
     }
     int maxID = Handle.Sim()->GetTotalNumberOfNeurons()-1;
     for (auto& nID : NeuronIDs) {
         if ((nID < 0) || (nID > maxID)) {
             Logger_->Log("Error: Invalid Neuron ID '" + std::to_string(nID) + "'", 7);
-            return Handle.ErrResponse(API::BGStatusCode::BGStatusInvalidParametersPassed);
+            return Handle.ErrResponseJSON(API::BGStatusCode::BGStatusInvalidParametersPassed);
         }
     }
 
@@ -489,7 +539,21 @@ std::string ModelRPCInterface::SCNeuronEdit(std::string _JSONRequest) {
         } 
     }
 
-    return Handle.ErrResponse(); // ok
+    return Handle.ErrResponseJSON(); // ok
+}
+
+bool LIFCCompartmentFromJSON(API::HandlerData& Handle, nlohmann::json& _Params, Compartments::LIFC& C) {
+    if ((!Handle.GetParInt("ShapeID", C.ShapeID, _Params))
+        || (!Handle.GetParFloat("RestingPotential_mV", C.RestingPotential_mV, _Params))
+        || (!Handle.GetParFloat("ResetPotential_mV", C.ResetPotential_mV, _Params))
+        || (!Handle.GetParFloat("SpikeThreshold_mV", C.SpikeThreshold_mV, _Params))
+        || (!Handle.GetParFloat("MembraneResistance_MOhm", C.MembraneResistance_MOhm, _Params))
+        || (!Handle.GetParFloat("MembraneCapacitance_pF", C.MembraneCapacitance_pF, _Params))
+        || (!Handle.GetParFloat("AfterHyperpolarizationAmplitude_mV", C.AfterHyperpolarizationAmplitude_mV, _Params))
+        || (!Handle.GetParString("Name", C.Name, _Params))) {
+        return false;
+    }
+    return true;
 }
 
 /**
@@ -497,33 +561,26 @@ std::string ModelRPCInterface::SCNeuronEdit(std::string _JSONRequest) {
  * Form: A shape.
  * Function: Some parameters.
  */
-std::string ModelRPCInterface::LIFCCreate(std::string _JSONRequest) {
+nlohmann::json ModelRPCInterface::LIFCCreate(nlohmann::json _JSONRequest) {
  
-    API::HandlerData Handle(_JSONRequest, Logger_, "Simulation/Compartments/LIFC/Create", Simulations_);
+    API::HandlerData Handle(std::move(_JSONRequest), Logger_, "Simulation/Compartments/LIFC/Create", Simulations_);
     if (Handle.HasError()) {
-        return Handle.ErrResponse();
+        return Handle.ErrResponseJSON();
     }
 
     // Build New LIFC Object
     Compartments::LIFC C;
-    if ((!Handle.GetParInt("ShapeID", C.ShapeID))
-        || (!Handle.GetParFloat("RestingPotential_mV", C.RestingPotential_mV))
-        || (!Handle.GetParFloat("ResetPotential_mV", C.ResetPotential_mV))
-        || (!Handle.GetParFloat("SpikeThreshold_mV", C.SpikeThreshold_mV))
-        || (!Handle.GetParFloat("MembraneResistance_MOhm", C.MembraneResistance_MOhm))
-        || (!Handle.GetParFloat("MembraneCapacitance_pF", C.MembraneCapacitance_pF))
-        || (!Handle.GetParFloat("AfterHyperpolarizationAmplitude_mV", C.AfterHyperpolarizationAmplitude_mV))
-        || (!Handle.GetParString("Name", C.Name))) {
-        return Handle.ErrResponse();
+    if (!LIFCCompartmentFromJSON(Handle, Handle.ReqJSON(), C)) {
+        return Handle.ErrResponseJSON(API::BGStatusCode::BGStatusInvalidParametersPassed);
     }
 
     C.ID = Handle.Sim()->AddLIFCCompartment(C);
     if (C.ID < 0) {
-        return Handle.ErrResponse(API::BGStatusCode::BGStatusInvalidParametersPassed);
+        return Handle.ErrResponseJSON(API::BGStatusCode::BGStatusInvalidParametersPassed);
     }
 
     // Return Result ID
-    return Handle.ResponseWithID("CompartmentID", C.ID);
+    return Handle.ResponseWithIDJSON("CompartmentID", C.ID);
 }
 
 const std::map<std::string, CoreStructs::LIFCUpdateMethodEnum> UpdateMethodStrToEnum = {
@@ -581,122 +638,129 @@ CoreStructs::LIFCADPSaturationModelEnum LIFCADPSaturationModel(const std::string
     return it->second;
 }
 
-std::string ModelRPCInterface::LIFCNeuronCreate(std::string _JSONRequest) {
- 
-    API::HandlerData Handle(_JSONRequest, Logger_, "Simulation/Neuron/LIFC/Create", Simulations_);
-    if (Handle.HasError()) {
-        return Handle.ErrResponse();
-    }
-
-    // Build New LIFCNeuron Object
-    CoreStructs::LIFCNeuronStruct C;
+bool LIFCNeuronFromJSON(API::HandlerData& Handle, nlohmann::json& _Params, CoreStructs::LIFCNeuronStruct& C) {
     std::string UpdateMethodStr;
     std::string ResetMethodStr;
     std::string AHPSaturationModelStr;
     std::string ADPSaturationModelStr;
-    if ((!Handle.GetParVecInt("SomaIDs", C.SomaCompartmentIDs))
-        || (!Handle.GetParVecInt("DendriteIDs", C.DendriteCompartmentIDs))
-        || (!Handle.GetParVecInt("AxonIDs", C.AxonCompartmentIDs))
-
-        || (!Handle.GetParFloat("RestingPotential_mV", C.RestingPotential_mV))
-        || (!Handle.GetParFloat("ResetPotential_mV", C.ResetPotential_mV))
-        || (!Handle.GetParFloat("SpikeThreshold_mV", C.SpikeThreshold_mV))
-        || (!Handle.GetParFloat("MembraneResistance_MOhm", C.MembraneResistance_MOhm))
-        || (!Handle.GetParFloat("MembraneCapacitance_pF", C.MembraneCapacitance_pF))
-        || (!Handle.GetParFloat("RefractoryPeriod_ms", C.RefractoryPeriod_ms))
-        || (!Handle.GetParFloat("SpikeDepolarization_mV", C.SpikeDepolarization_mV))
-
-        || (!Handle.GetParString("UpdateMethod", UpdateMethodStr))
-        || (!Handle.GetParString("ResetMethod", ResetMethodStr))
-
-        || (!Handle.GetParFloat("AfterHyperpolarizationReversalPotential_mV", C.AfterHyperpolarizationReversalPotential_mV))
-
-        || (!Handle.GetParFloat("FastAfterHyperpolarizationRise_ms", C.FastAfterHyperpolarizationRise_ms))
-        || (!Handle.GetParFloat("FastAfterHyperpolarizationDecay_ms", C.FastAfterHyperpolarizationDecay_ms))
-        || (!Handle.GetParFloat("FastAfterHyperpolarizationPeakConductance_nS", C.FastAfterHyperpolarizationPeakConductance_nS))
-        || (!Handle.GetParFloat("FastAfterHyperpolarizationMaxPeakConductance_nS", C.FastAfterHyperpolarizationMaxPeakConductance_nS))
-        || (!Handle.GetParFloat("FastAfterHyperpolarizationHalfActConstant", C.FastAfterHyperpolarizationHalfActConstant))
-
-        || (!Handle.GetParFloat("SlowAfterHyperpolarizationRise_ms", C.SlowAfterHyperpolarizationRise_ms))
-        || (!Handle.GetParFloat("SlowAfterHyperpolarizationDecay_ms", C.SlowAfterHyperpolarizationDecay_ms))
-        || (!Handle.GetParFloat("SlowAfterHyperpolarizationPeakConductance_nS", C.SlowAfterHyperpolarizationPeakConductance_nS))
-        || (!Handle.GetParFloat("SlowAfterHyperpolarizationMaxPeakConductance_nS", C.SlowAfterHyperpolarizationMaxPeakConductance_nS))
-        || (!Handle.GetParFloat("SlowAfterHyperpolarizationHalfActConstant", C.SlowAfterHyperpolarizationHalfActConstant))
-
-        || (!Handle.GetParString("AfterHyperpolarizationSaturationModel", AHPSaturationModelStr))
-
-        || (!Handle.GetParFloat("FatigueThreshold", C.FatigueThreshold))
-        || (!Handle.GetParFloat("FatigueRecoveryTime_ms", C.FatigueRecoveryTime_ms))
-
-        || (!Handle.GetParFloat("AfterDepolarizationReversalPotential_mV", C.AfterDepolarizationReversalPotential_mV))
-        || (!Handle.GetParFloat("AfterDepolarizationRise_ms", C.AfterDepolarizationRise_ms))
-        || (!Handle.GetParFloat("AfterDepolarizationDecay_ms", C.AfterDepolarizationDecay_ms))
-        || (!Handle.GetParFloat("AfterDepolarizationPeakConductance_nS", C.AfterDepolarizationPeakConductance_nS))
-        || (!Handle.GetParFloat("AfterDepolarizationSaturationMultiplier", C.AfterDepolarizationSaturationMultiplier))
-        || (!Handle.GetParFloat("AfterDepolarizationRecoveryTime_ms", C.AfterDepolarizationRecoveryTime_ms))
-        || (!Handle.GetParFloat("AfterDepolarizationDepletion", C.AfterDepolarizationDepletion))
-        || (!Handle.GetParString("AfterDepolarizationSaturationModel", ADPSaturationModelStr))
-
-        || (!Handle.GetParFloat("AdaptiveThresholdDiffPerSpike", C.AdaptiveThresholdDiffPerSpike))
-        || (!Handle.GetParFloat("AdaptiveTresholdRecoveryTime_ms", C.AdaptiveTresholdRecoveryTime_ms))
-        || (!Handle.GetParFloat("AdaptiveThresholdDiffPotential_mV", C.AdaptiveThresholdDiffPotential_mV))
-        || (!Handle.GetParFloat("AdaptiveThresholdFloor_mV", C.AdaptiveThresholdFloor_mV))
-        || (!Handle.GetParFloat("AdaptiveThresholdFloorDeltaPerSpike_mV", C.AdaptiveThresholdFloorDeltaPerSpike_mV))
-        || (!Handle.GetParFloat("AdaptiveThresholdFloorRecoveryTime_ms", C.AdaptiveThresholdFloorRecoveryTime_ms))
-
-        || (!Handle.GetParString("Name", C.Name))) {
-        return Handle.ErrResponse();
+    if ((!Handle.GetParVecInt("SomaIDs", C.SomaCompartmentIDs, _Params))
+        || (!Handle.GetParVecInt("DendriteIDs", C.DendriteCompartmentIDs, _Params))
+        || (!Handle.GetParVecInt("AxonIDs", C.AxonCompartmentIDs, _Params))
+
+        || (!Handle.GetParFloat("RestingPotential_mV", C.RestingPotential_mV, _Params))
+        || (!Handle.GetParFloat("ResetPotential_mV", C.ResetPotential_mV, _Params))
+        || (!Handle.GetParFloat("SpikeThreshold_mV", C.SpikeThreshold_mV, _Params))
+        || (!Handle.GetParFloat("MembraneResistance_MOhm", C.MembraneResistance_MOhm, _Params))
+        || (!Handle.GetParFloat("MembraneCapacitance_pF", C.MembraneCapacitance_pF, _Params))
+        || (!Handle.GetParFloat("RefractoryPeriod_ms", C.RefractoryPeriod_ms, _Params))
+        || (!Handle.GetParFloat("SpikeDepolarization_mV", C.SpikeDepolarization_mV, _Params))
+
+        || (!Handle.GetParString("UpdateMethod", UpdateMethodStr, _Params))
+        || (!Handle.GetParString("ResetMethod", ResetMethodStr, _Params))
+
+        || (!Handle.GetParFloat("AfterHyperpolarizationReversalPotential_mV", C.AfterHyperpolarizationReversalPotential_mV, _Params))
+
+        || (!Handle.GetParFloat("FastAfterHyperpolarizationRise_ms", C.FastAfterHyperpolarizationRise_ms, _Params))
+        || (!Handle.GetParFloat("FastAfterHyperpolarizationDecay_ms", C.FastAfterHyperpolarizationDecay_ms, _Params))
+        || (!Handle.GetParFloat("FastAfterHyperpolarizationPeakConductance_nS", C.FastAfterHyperpolarizationPeakConductance_nS, _Params))
+        || (!Handle.GetParFloat("FastAfterHyperpolarizationMaxPeakConductance_nS", C.FastAfterHyperpolarizationMaxPeakConductance_nS, _Params))
+        || (!Handle.GetParFloat("FastAfterHyperpolarizationHalfActConstant", C.FastAfterHyperpolarizationHalfActConstant, _Params))
+
+        || (!Handle.GetParFloat("SlowAfterHyperpolarizationRise_ms", C.SlowAfterHyperpolarizationRise_ms, _Params))
+        || (!Handle.GetParFloat("SlowAfterHyperpolarizationDecay_ms", C.SlowAfterHyperpolarizationDecay_ms, _Params))
+        || (!Handle.GetParFloat("SlowAfterHyperpolarizationPeakConductance_nS", C.SlowAfterHyperpolarizationPeakConductance_nS, _Params))
+        || (!Handle.GetParFloat("SlowAfterHyperpolarizationMaxPeakConductance_nS", C.SlowAfterHyperpolarizationMaxPeakConductance_nS, _Params))
+        || (!Handle.GetParFloat("SlowAfterHyperpolarizationHalfActConstant", C.SlowAfterHyperpolarizationHalfActConstant, _Params))
+
+        || (!Handle.GetParString("AfterHyperpolarizationSaturationModel", AHPSaturationModelStr, _Params))
+
+        || (!Handle.GetParFloat("FatigueThreshold", C.FatigueThreshold, _Params))
+        || (!Handle.GetParFloat("FatigueRecoveryTime_ms", C.FatigueRecoveryTime_ms, _Params))
+
+        || (!Handle.GetParFloat("AfterDepolarizationReversalPotential_mV", C.AfterDepolarizationReversalPotential_mV, _Params))
+        || (!Handle.GetParFloat("AfterDepolarizationRise_ms", C.AfterDepolarizationRise_ms, _Params))
+        || (!Handle.GetParFloat("AfterDepolarizationDecay_ms", C.AfterDepolarizationDecay_ms, _Params))
+        || (!Handle.GetParFloat("AfterDepolarizationPeakConductance_nS", C.AfterDepolarizationPeakConductance_nS, _Params))
+        || (!Handle.GetParFloat("AfterDepolarizationSaturationMultiplier", C.AfterDepolarizationSaturationMultiplier, _Params))
+        || (!Handle.GetParFloat("AfterDepolarizationRecoveryTime_ms", C.AfterDepolarizationRecoveryTime_ms, _Params))
+        || (!Handle.GetParFloat("AfterDepolarizationDepletion", C.AfterDepolarizationDepletion, _Params))
+        || (!Handle.GetParString("AfterDepolarizationSaturationModel", ADPSaturationModelStr, _Params))
+
+        || (!Handle.GetParFloat("AdaptiveThresholdDiffPerSpike", C.AdaptiveThresholdDiffPerSpike, _Params))
+        || (!Handle.GetParFloat("AdaptiveTresholdRecoveryTime_ms", C.AdaptiveTresholdRecoveryTime_ms, _Params))
+        || (!Handle.GetParFloat("AdaptiveThresholdDiffPotential_mV", C.AdaptiveThresholdDiffPotential_mV, _Params))
+        || (!Handle.GetParFloat("AdaptiveThresholdFloor_mV", C.AdaptiveThresholdFloor_mV, _Params))
+        || (!Handle.GetParFloat("AdaptiveThresholdFloorDeltaPerSpike_mV", C.AdaptiveThresholdFloorDeltaPerSpike_mV, _Params))
+        || (!Handle.GetParFloat("AdaptiveThresholdFloorRecoveryTime_ms", C.AdaptiveThresholdFloorRecoveryTime_ms, _Params))
+
+        || (!Handle.GetParString("Name", C.Name, _Params))) {
+        return false;
     }
 
     C.UpdateMethod = LIFCUpdateMethod(UpdateMethodStr);
     if (C.UpdateMethod >= CoreStructs::NUMLIFCUpdateMethodEnum) {
-        Logger_->Log("Error: Unrecognized LIFC UpdateMethod", 7);
-        return Handle.ErrResponse(API::BGStatusCode::BGStatusInvalidParametersPassed);
+        Handle.Sim()->Logger_->Log("Error: Unrecognized LIFC UpdateMethod", 7);
+        return false;
     }
     C.ResetMethod = LIFCResetMethod(ResetMethodStr);
     if (C.ResetMethod >= CoreStructs::NUMLIFCResetMethodEnum) {
-        Logger_->Log("Error: Unrecognized LIFC ResetMethod", 7);
-        return Handle.ErrResponse(API::BGStatusCode::BGStatusInvalidParametersPassed);
+        Handle.Sim()->Logger_->Log("Error: Unrecognized LIFC ResetMethod", 7);
+        return false;
     }
     C.AfterHyperpolarizationSaturationModel = LIFCAHPSaturationModel(AHPSaturationModelStr);
     if (C.AfterHyperpolarizationSaturationModel >= CoreStructs::NUMLIFCAHPSaturationModelEnum) {
-        Logger_->Log("Error: Unrecognized LIFC AHP Saturation Model", 7);
-        return Handle.ErrResponse(API::BGStatusCode::BGStatusInvalidParametersPassed);
+        Handle.Sim()->Logger_->Log("Error: Unrecognized LIFC AHP Saturation Model", 7);
+        return false;
     }
     C.AfterDepolarizationSaturationModel = LIFCADPSaturationModel(ADPSaturationModelStr);
     if (C.AfterDepolarizationSaturationModel >= CoreStructs::NUMLIFCADPSaturationModelEnum) {
-        Logger_->Log("Error: Unrecognized LIFC ADP Saturation Model", 7);
-        return Handle.ErrResponse(API::BGStatusCode::BGStatusInvalidParametersPassed);
+        Handle.Sim()->Logger_->Log("Error: Unrecognized LIFC ADP Saturation Model", 7);
+        return false;
+    }
+    return true;
+}
+
+nlohmann::json ModelRPCInterface::LIFCNeuronCreate(nlohmann::json _JSONRequest) {
+ 
+    API::HandlerData Handle(std::move(_JSONRequest), Logger_, "Simulation/Neuron/LIFC/Create", Simulations_);
+    if (Handle.HasError()) {
+        return Handle.ErrResponseJSON();
+    }
+
+    // Build New LIFCNeuron Object
+    CoreStructs::LIFCNeuronStruct C;
+    if (!LIFCNeuronFromJSON(Handle, Handle.ReqJSON(), C)) {
+        return Handle.ErrResponseJSON(API::BGStatusCode::BGStatusInvalidParametersPassed);
     }
 
     C.ID = Handle.Sim()->AddLIFCNeuron(C);
     if (C.ID < 0) {
-        return Handle.ErrResponse(API::BGStatusCode::BGStatusInvalidParametersPassed);
+        return Handle.ErrResponseJSON(API::BGStatusCode::BGStatusInvalidParametersPassed);
     }
 
     // Return Result ID
-    return Handle.ResponseWithID("NeuronID", C.ID);
+    return Handle.ResponseWithIDJSON("NeuronID", C.ID);
 }
 
 // Takes a list of IDs of previously created neurons and edits parameters specified.
 // Empty list of neuron IDs means all neurons.
-std::string ModelRPCInterface::LIFCNeuronEdit(std::string _JSONRequest) {
+nlohmann::json ModelRPCInterface::LIFCNeuronEdit(nlohmann::json _JSONRequest) {
  
-    API::HandlerData Handle(_JSONRequest, Logger_, "Simulation/Neuron/LIFC/Edit", Simulations_);
+    API::HandlerData Handle(std::move(_JSONRequest), Logger_, "Simulation/Neuron/LIFC/Edit", Simulations_);
     if (Handle.HasError()) {
-        return Handle.ErrResponse();
+        return Handle.ErrResponseJSON();
     }
 
     // Collect and check neuron IDs
     std::vector<int> NeuronIDs;
     if (!Handle.GetParVecInt("NeuronIDs", NeuronIDs)) {
-        return Handle.ErrResponse();
+        return Handle.ErrResponseJSON();
     }
     int maxID = Handle.Sim()->GetTotalNumberOfNeurons()-1;
     for (auto& nID : NeuronIDs) {
         if ((nID < 0) || (nID > maxID)) {
             Logger_->Log("Error: Invalid Neuron ID '" + std::to_string(nID) + "'", 7);
-            return Handle.ErrResponse(API::BGStatusCode::BGStatusInvalidParametersPassed);
+            return Handle.ErrResponseJSON(API::BGStatusCode::BGStatusInvalidParametersPassed);
         }
     }
 
@@ -722,14 +786,14 @@ std::string ModelRPCInterface::LIFCNeuronEdit(std::string _JSONRequest) {
         } 
     }
 
-    return Handle.ErrResponse(); // ok
+    return Handle.ErrResponseJSON(); // ok
 }
 
-std::string ModelRPCInterface::PatchClampDACCreate(std::string _JSONRequest) {
+nlohmann::json ModelRPCInterface::PatchClampDACCreate(nlohmann::json _JSONRequest) {
  
-    API::HandlerData Handle(_JSONRequest, Logger_, "Simulation/OatchClampDAC/Create", Simulations_);
+    API::HandlerData Handle(std::move(_JSONRequest), Logger_, "Simulation/OatchClampDAC/Create", Simulations_);
     if (Handle.HasError()) {
-        return Handle.ErrResponse();
+        return Handle.ErrResponseJSON();
     }
 
     // Build New DAC Object
@@ -737,7 +801,7 @@ std::string ModelRPCInterface::PatchClampDACCreate(std::string _JSONRequest) {
     if ((!Handle.GetParInt("DestinationCompartmentID", T.DestinationCompartmentID))
         || (!Handle.GetParVec3("ClampPos", T.ClampPos_um))
         || (!Handle.GetParString("Name", T.Name))) {
-        return Handle.ErrResponse();
+        return Handle.ErrResponseJSON();
     }
 
     T.ID = Handle.Sim()->PatchClampDACs.size();
@@ -745,7 +809,7 @@ std::string ModelRPCInterface::PatchClampDACCreate(std::string _JSONRequest) {
 
 
     // Return Result ID
-    return Handle.ResponseWithID("PatchClampDACID", T.ID);
+    return Handle.ResponseWithIDJSON("PatchClampDACID", T.ID);
 }
 
 /**
@@ -759,37 +823,37 @@ std::string ModelRPCInterface::PatchClampDACCreate(std::string _JSONRequest) {
  *   ]
  * }
  */
-std::string ModelRPCInterface::PatchClampDACSetOutputList(std::string _JSONRequest) {
+nlohmann::json ModelRPCInterface::PatchClampDACSetOutputList(nlohmann::json _JSONRequest) {
  
-    API::HandlerData Handle(_JSONRequest, Logger_, "Simulation/PatchClampDAC/SetOutputList", Simulations_);
+    API::HandlerData Handle(std::move(_JSONRequest), Logger_, "Simulation/PatchClampDAC/SetOutputList", Simulations_);
     if (Handle.HasError()) {
-        return Handle.ErrResponse();
+        return Handle.ErrResponseJSON();
     }
 
     // Get/Check PatchClampdDACID
     int PatchClampDACID = -1;
     if (!Handle.GetParInt("PatchClampDACID", PatchClampDACID)) {
-        return Handle.ErrResponse();
+        return Handle.ErrResponseJSON();
     }
 
     if (PatchClampDACID >= Handle.Sim()->PatchClampDACs.size() || PatchClampDACID < 0) {
-        return Handle.ErrResponse(API::BGStatusCode::BGStatusInvalidParametersPassed);
+        return Handle.ErrResponseJSON(API::BGStatusCode::BGStatusInvalidParametersPassed);
     }
     Tools::PatchClampDAC* ThisDAC = &Handle.Sim()->PatchClampDACs[PatchClampDACID];
 
     // Set Params
     nlohmann::json::iterator ControlDataJSON_it;
     if (!Handle.FindPar("ControlData", ControlDataJSON_it)) {
-        return Handle.ErrResponse();
+        return Handle.ErrResponseJSON();
     }
 
     ThisDAC->ControlData.clear();
     for (const auto& value_pair: ControlDataJSON_it.value()) {
         if (value_pair.size() < 2) {
-            return Handle.ErrResponse(API::BGStatusCode::BGStatusInvalidParametersPassed);
+            return Handle.ErrResponseJSON(API::BGStatusCode::BGStatusInvalidParametersPassed);
         }
         if ((!value_pair[0].is_number()) || (!value_pair[1].is_number())) {
-            return Handle.ErrResponse(API::BGStatusCode::BGStatusInvalidParametersPassed);
+            return Handle.ErrResponseJSON(API::BGStatusCode::BGStatusInvalidParametersPassed);
         }
         float t_ms = value_pair[0].template get<float>();
         float v_mV = value_pair[1].template get<float>();
@@ -797,14 +861,14 @@ std::string ModelRPCInterface::PatchClampDACSetOutputList(std::string _JSONReque
     }
 
     // Return Result ID
-    return Handle.ErrResponse(); // ok
+    return Handle.ErrResponseJSON(); // ok
 }
 
-std::string ModelRPCInterface::PatchClampADCCreate(std::string _JSONRequest) {
+nlohmann::json ModelRPCInterface::PatchClampADCCreate(nlohmann::json _JSONRequest) {
  
-    API::HandlerData Handle(_JSONRequest, Logger_, "Simulation/PatchClampADC/Create", Simulations_);
+    API::HandlerData Handle(std::move(_JSONRequest), Logger_, "Simulation/PatchClampADC/Create", Simulations_);
     if (Handle.HasError()) {
-        return Handle.ErrResponse();
+        return Handle.ErrResponseJSON();
     }
 
     // Build New ADC Object
@@ -812,7 +876,7 @@ std::string ModelRPCInterface::PatchClampADCCreate(std::string _JSONRequest) {
     if ((!Handle.GetParInt("SourceCompartmentID", T.SourceCompartmentID))
         || (!Handle.GetParVec3("ClampPos", T.ClampPos_um))
         || (!Handle.GetParString("Name", T.Name))) {
-        return Handle.ErrResponse();
+        return Handle.ErrResponseJSON();
     }
     T.Timestep_ms = 0.0f;
 
@@ -820,50 +884,50 @@ std::string ModelRPCInterface::PatchClampADCCreate(std::string _JSONRequest) {
     Handle.Sim()->PatchClampADCs.push_back(T);
 
     // Return Result ID
-    return Handle.ResponseWithID("PatchClampADCID", T.ID);
+    return Handle.ResponseWithIDJSON("PatchClampADCID", T.ID);
 }
 
-std::string ModelRPCInterface::PatchClampADCSetSampleRate(std::string _JSONRequest) {
+nlohmann::json ModelRPCInterface::PatchClampADCSetSampleRate(nlohmann::json _JSONRequest) {
  
-    API::HandlerData Handle(_JSONRequest, Logger_, "Simulation/PatchClampADC/SetSampleRate", Simulations_);
+    API::HandlerData Handle(std::move(_JSONRequest), Logger_, "Simulation/PatchClampADC/SetSampleRate", Simulations_);
     if (Handle.HasError()) {
-        return Handle.ErrResponse();
+        return Handle.ErrResponseJSON();
     }
 
     // Get/Check PatchClampdADDCID
     int PatchClampADCID = -1;
     if (!Handle.GetParInt("PatchClampADCID", PatchClampADCID)) {
-        return Handle.ErrResponse();
+        return Handle.ErrResponseJSON();
     }
     if (PatchClampADCID >= Handle.Sim()->PatchClampADCs.size() || PatchClampADCID < 0) {
-        return Handle.ErrResponse(API::BGStatusCode::BGStatusInvalidParametersPassed);
+        return Handle.ErrResponseJSON(API::BGStatusCode::BGStatusInvalidParametersPassed);
     }
     Tools::PatchClampADC* ThisADC = &Handle.Sim()->PatchClampADCs[PatchClampADCID];
     
     // Set Params
     if (!Handle.GetParFloat("Timestep_ms", ThisADC->Timestep_ms)) {
-        return Handle.ErrResponse();
+        return Handle.ErrResponseJSON();
     }
     ThisADC->RecordedData_mV.clear(); // clear recorded data as it is now invalid (the timestep is not the same anymore)
 
     // Return Result ID
-    return Handle.ErrResponse(); // ok
+    return Handle.ErrResponseJSON(); // ok
 }
 
-std::string ModelRPCInterface::PatchClampADCGetRecordedData(std::string _JSONRequest) {
+nlohmann::json ModelRPCInterface::PatchClampADCGetRecordedData(nlohmann::json _JSONRequest) {
  
-    API::HandlerData Handle(_JSONRequest, Logger_, "Simulation/PatchClampADC/GetRecordedData", Simulations_);
+    API::HandlerData Handle(std::move(_JSONRequest), Logger_, "Simulation/PatchClampADC/GetRecordedData", Simulations_);
     if (Handle.HasError()) {
-        return Handle.ErrResponse();
+        return Handle.ErrResponseJSON();
     }
 
     // Get/Check PatchClampdADDCID
     int PatchClampADCID = -1;
     if (!Handle.GetParInt("PatchClampADCID", PatchClampADCID)) {
-        return Handle.ErrResponse();
+        return Handle.ErrResponseJSON();
     }
     if (PatchClampADCID >= Handle.Sim()->PatchClampADCs.size() || PatchClampADCID < 0) {
-        return Handle.ErrResponse(API::BGStatusCode::BGStatusInvalidParametersPassed);
+        return Handle.ErrResponseJSON(API::BGStatusCode::BGStatusInvalidParametersPassed);
     }
     Tools::PatchClampADC* ThisADC = &Handle.Sim()->PatchClampADCs[PatchClampADCID];
     
@@ -872,7 +936,7 @@ std::string ModelRPCInterface::PatchClampADCGetRecordedData(std::string _JSONReq
     ResponseJSON["StatusCode"] = 0; // ok
     ResponseJSON["Timestep_ms"] = ThisADC->Timestep_ms;
     ResponseJSON["RecordedData_mV"] = ThisADC->RecordedData_mV;
-    return Handle.ResponseAndStoreRequest(ResponseJSON);
+    return Handle.ResponseAndStoreRequestJSON(ResponseJSON);
 }
 
 /**
@@ -885,36 +949,36 @@ std::string ModelRPCInterface::PatchClampADCGetRecordedData(std::string _JSONReq
  *   ]
  * }
  */
-std::string ModelRPCInterface::SetSpecificAPTimes(std::string _JSONRequest) {
+nlohmann::json ModelRPCInterface::SetSpecificAPTimes(nlohmann::json _JSONRequest) {
  
-    API::HandlerData Handle(_JSONRequest, Logger_, "Simulation/SetSpecificAPTimes", Simulations_);
+    API::HandlerData Handle(std::move(_JSONRequest), Logger_, "Simulation/SetSpecificAPTimes", Simulations_);
     if (Handle.HasError()) {
-        return Handle.ErrResponse();
+        return Handle.ErrResponseJSON();
     }
   
     // Set Params
     nlohmann::json::iterator TimeNeuronPairJSON_it;
     if (!Handle.FindPar("TimeNeuronPairs", TimeNeuronPairJSON_it)) {
-        return Handle.ErrResponse();
+        return Handle.ErrResponseJSON();
     }
     for (const auto& time_neuron_pair: TimeNeuronPairJSON_it.value()) {
         if (time_neuron_pair.size() < 2) {
-            return Handle.ErrResponse(API::BGStatusCode::BGStatusInvalidParametersPassed);
+            return Handle.ErrResponseJSON(API::BGStatusCode::BGStatusInvalidParametersPassed);
         }
         if ((!time_neuron_pair[0].is_number()) || (!time_neuron_pair[1].is_number())) {
-            return Handle.ErrResponse(API::BGStatusCode::BGStatusInvalidParametersPassed);
+            return Handle.ErrResponseJSON(API::BGStatusCode::BGStatusInvalidParametersPassed);
         }
         float t_ms = time_neuron_pair[0].template get<float>();
         unsigned int NeuronID = time_neuron_pair[1].template get<unsigned int>();
         if (NeuronID >= Handle.Sim()->Neurons.size()) {
-            return Handle.ErrResponse(API::BGStatusCode::BGStatusInvalidParametersPassed);
+            return Handle.ErrResponseJSON(API::BGStatusCode::BGStatusInvalidParametersPassed);
         }
 
         Handle.Sim()->Neurons.at(NeuronID)->AddSpecificAPTime(t_ms);
     }
 
     // Return Result ID
-    return Handle.ErrResponse(); // ok
+    return Handle.ErrResponseJSON(); // ok
 }
 
 /**
@@ -935,28 +999,28 @@ std::string ModelRPCInterface::SetSpecificAPTimes(std::string _JSONRequest) {
  *   "StatusCode": <status-code>,
  * }
  */
-std::string ModelRPCInterface::SetSpontaneousActivity(std::string _JSONRequest) {
+nlohmann::json ModelRPCInterface::SetSpontaneousActivity(nlohmann::json _JSONRequest) {
  
-    API::HandlerData Handle(_JSONRequest, Logger_, "Simulation/SetSpontaneousActivity", Simulations_);
+    API::HandlerData Handle(std::move(_JSONRequest), Logger_, "Simulation/SetSpontaneousActivity", Simulations_);
     if (Handle.HasError()) {
-        return Handle.ErrResponse();
+        return Handle.ErrResponseJSON();
     }
   
     // Set Params
     float SpikeIntervalMean_ms = -1.0;
     if (!Handle.GetParFloat("SpikeIntervalMean_ms", SpikeIntervalMean_ms)) {
-        return Handle.ErrResponse();
+        return Handle.ErrResponseJSON();
     }
     float SpikeIntervalStDev_ms = -1.0;
     if (!Handle.GetParFloat("SpikeIntervalStDev_ms", SpikeIntervalStDev_ms)) {
-        return Handle.ErrResponse();
+        return Handle.ErrResponseJSON();
     }
     if ((SpikeIntervalMean_ms <= 0.0) || (SpikeIntervalStDev_ms < 0.0)) {
-        return Handle.ErrResponse(API::BGStatusCode::BGStatusInvalidParametersPassed);
+        return Handle.ErrResponseJSON(API::BGStatusCode::BGStatusInvalidParametersPassed);
     }
     std::vector<int> NeuronIDs; // Empty list means all neurons.
     if (!Handle.GetParVecInt("NeuronIDs", NeuronIDs)) {
-        return Handle.ErrResponse();
+        return Handle.ErrResponseJSON();
     }
 
     // Modify spontaneous activity settings of specified neurons
@@ -971,33 +1035,33 @@ std::string ModelRPCInterface::SetSpontaneousActivity(std::string _JSONRequest)
     }
 
     // Return Result ID
-    return Handle.ErrResponse(); // ok
+    return Handle.ErrResponseJSON(); // ok
 }
 
-std::string ModelRPCInterface::OptoModifyInjection(std::string _JSONRequest) {
-    API::HandlerData Handle(_JSONRequest, Logger_, "Simulation/OptoModifyInjection", Simulations_);
+nlohmann::json ModelRPCInterface::OptoModifyInjection(nlohmann::json _JSONRequest) {
+    API::HandlerData Handle(std::move(_JSONRequest), Logger_, "Simulation/OptoModifyInjection", Simulations_);
     if (Handle.HasError()) {
-        return Handle.ErrResponse();
+        return Handle.ErrResponseJSON();
     }
   
     Geometries::Vec3D inject_pos;
     if (!Handle.GetParVec3("InjectLocation", inject_pos)) {
-        return Handle.ErrResponse();
+        return Handle.ErrResponseJSON();
     }
 
     float radius = -1.f;
     if (!Handle.GetParFloat("Radius", radius)) {
-        return Handle.ErrResponse();
+        return Handle.ErrResponseJSON();
     }
 
     int desired_wavelength = 0;
     if (!Handle.GetParInt("Wavelength", desired_wavelength)) {
-        return Handle.ErrResponse();
+        return Handle.ErrResponseJSON();
     }
 
     int type = CoreStructs::UnknownNeuron;
     if (!Handle.GetParInt("Type", type)) {
-        return Handle.ErrResponse();
+        return Handle.ErrResponseJSON();
     }
 
     for (auto& neuron : Handle.Sim()->Neurons) {
@@ -1010,23 +1074,23 @@ std::string ModelRPCInterface::OptoModifyInjection(std::string _JSONRequest) {
         }
     }
 
-    return Handle.ErrResponse(); // ok
+    return Handle.ErrResponseJSON(); // ok
 }
 
-std::string ModelRPCInterface::OptoActivation(std::string _JSONRequest) {
-    API::HandlerData Handle(_JSONRequest, Logger_, "Simulation/OptoActivation", Simulations_);
+nlohmann::json ModelRPCInterface::OptoActivation(nlohmann::json _JSONRequest) {
+    API::HandlerData Handle(std::move(_JSONRequest), Logger_, "Simulation/OptoActivation", Simulations_);
     if (Handle.HasError()) {
-        return Handle.ErrResponse();
+        return Handle.ErrResponseJSON();
     }
 
     std::vector<float> laser_activation_times;
     if (!Handle.GetParVecFloat("LaserActivationTimes", laser_activation_times)) {
-        return Handle.ErrResponse();
+        return Handle.ErrResponseJSON();
     }
 
     int target_wavelength = 0;
     if (!Handle.GetParInt("TargetWavelength", target_wavelength)) {
-        return Handle.ErrResponse();
+        return Handle.ErrResponseJSON();
     }
 
     for (float time : laser_activation_times) {
@@ -1037,7 +1101,215 @@ std::string ModelRPCInterface::OptoActivation(std::string _JSONRequest) {
         }
     }
 
-    return Handle.ErrResponse(); // ok
+    return Handle.ErrResponseJSON(); // ok
+}
+
+/*
+Bulk create routes
+
+These take the parameters of the matching single create routes in the
+columnar form described at API::BulkRequest: "Count" items, per-item values
+in "Columns" and shared values as usual, e.g.
+{
+  "SimulationID": <SimID>,
+  "Count": 3,
+  "Columns": { "ShapeID": [ 4, 5, 6 ] },
+  "RestingPotential_mV": -60.0,
+  ...
+}
+They respond with the ID of the first object created ("FirstID") and
+"Count", the objects have consecutive IDs. All items are checked before the
+first one is created, the checks below mirror the conditions under which the
+Simulation::Add*() functions fail.
+*/
+
+bool CompartmentCanBeAdded(Simulation* Sim, SimulationNeuronClass _Class, int _ShapeID) {
+    if (!Sim->IsCompatible(_Class)) {
+        Sim->Logger_->Log("Error attempted mixing of neuron or compartment classes", 7);
+        return false;
+    }
+    if (!Sim->Collection.GetGeometry(_ShapeID)) {
+        Sim->Logger_->Log("Error: Shape with ID "+std::to_string(_ShapeID)+" not found", 7);
+        return false;
+    }
+    return true;
+}
+
+bool NeuronCanBeAdded(Simulation* Sim, SimulationNeuronClass _Class, const std::vector<int>& _SomaCompartmentIDs) {
+    if (!Sim->IsCompatible(_Class)) {
+        Sim->Logger_->Log("Error attempted mixing of neuron or compartment classes", 7);
+        return false;
+    }
+    if (_SomaCompartmentIDs.empty()) {
+        Sim->Logger_->Log("Error: Missing soma campartments", 7);
+        return false;
+    }
+    return true;
+}
+
+bool ReceptorCanBeAdded(Simulation* Sim, int _SourceCompartmentID, int _DestinationCompartmentID) {
+    if (Sim->FindNeuronByCompartment(_SourceCompartmentID) == nullptr) {
+        Sim->Logger_->Log("Error: No source neuron associated with compartment "+std::to_string(_SourceCompartmentID), 7);
+        return false;
+    }
+    if (Sim->FindNeuronByCompartment(_DestinationCompartmentID) == nullptr) {
+        Sim->Logger_->Log("Error: No target neuron associated with compartment "+std::to_string(_DestinationCompartmentID), 7);
+        return false;
+    }
+    return true;
+}
+
+bool LIFCReceptorCanBeAdded(Simulation* Sim, int _SourceCompartmentID, int _DestinationCompartmentID) {
+    if (Sim->SimNeuronClass != LIFCNEURONS) {
+        Sim->Logger_->Log("Error: LIFC receptors require LIFC neurons", 7);
+        return false;
+    }
+    return ReceptorCanBeAdded(Sim, _SourceCompartmentID, _DestinationCompartmentID);
+}
+
+nlohmann::json ModelRPCInterface::ReceptorBulkCreate(nlohmann::json _JSONRequest) {
+
+    API::HandlerData Handle(std::move(_JSONRequest), Logger_, "Simulation/Receptor/BulkCreate", Simulations_);
+    if (Handle.HasError()) {
+        return Handle.ErrResponseJSON();
+    }
+
+    Simulation* Sim = Handle.Sim();
+    return API::BulkCreate<Connections::Receptor>(Handle, Logger_,
+        [&Handle](nlohmann::json& _Params, Connections::Receptor& C) { return ReceptorFromJSON(Handle, _Params, C); },
+        [Sim](const Connections::Receptor& C) { return ReceptorCanBeAdded(Sim, C.SourceCompartmentID, C.DestinationCompartmentID); },
+        [Sim](Connections::Receptor& C) { return Sim->AddReceptor(C); });
+}
+
+nlohmann::json ModelRPCInterface::LIFCReceptorBulkCreate(nlohmann::json _JSONRequest) {
+
+    API::HandlerData Handle(std::move(_JSONRequest), Logger_, "Simulation/LIFCReceptor/BulkCreate", Simulations_);
+    if (Handle.HasError()) {
+        return Handle.ErrResponseJSON();
+    }
+
+    Simulation* Sim = Handle.Sim();
+    return API::BulkCreate<Connections::LIFCReceptor>(Handle, Logger_,
+        [&Handle](nlohmann::json& _Params, Connections::LIFCReceptor& C) { return LIFCReceptorFromJSON(Handle, _Params, C); },
+        [Sim](const Connections::LIFCReceptor& C) { return LIFCReceptorCanBeAdded(Sim, C.SourceCompartmentID, C.DestinationCompartmentID); },
+        [Sim](Connections::LIFCReceptor& C) { return Sim->AddLIFCReceptor(C); });
+}
+
+nlohmann::json ModelRPCInterface::NetmorphLIFCReceptorBulkCreate(nlohmann::json _JSONRequest) {
+
+    API::HandlerData Handle(std::move(_JSONRequest), Logger_, "Simulation/NetmorphLIFCReceptor/BulkCreate", Simulations_);
+    if (Handle.HasError()) {
+        return Handle.ErrResponseJSON();
+    }
+
+    typedef std::pair<Connections::LIFCReceptor, Connections::NetmorphLIFCReceptorRaw> NetmorphReceptor;
+    Simulation* Sim = Handle.Sim();
+    return API::BulkCreate<NetmorphReceptor>(Handle, Logger_,
+        [&Handle](nlohmann::json& _Params, NetmorphReceptor& C) { return NetmorphLIFCReceptorFromJSON(Handle, _Params, C.first, C.second); },
+        [Sim](const NetmorphReceptor& C) { return LIFCReceptorCanBeAdded(Sim, C.first.SourceCompartmentID, C.first.DestinationCompartmentID); },
+        [Sim](NetmorphReceptor& C) { return Sim->AddNetmorphLIFCReceptor(C.first, C.second); });
+}
+
+nlohmann::json ModelRPCInterface::BSBulkCreate(nlohmann::json _JSONRequest) {
+
+    API::HandlerData Handle(std::move(_JSONRequest), Logger_, "Simulation/Compartments/BS/BulkCreate", Simulations_);
+    if (Handle.HasError()) {
+        return Handle.ErrResponseJSON();
+    }
+
+    Simulation* Sim = Handle.Sim();
+    return API::BulkCreate<Compartments::BS>(Handle, Logger_,
+        [&Handle](nlohmann::json& _Params, Compartments::BS& C) { return BSCompartmentFromJSON(Handle, _Params, C); },
+        [Sim](const Compartments::BS& C) { return CompartmentCanBeAdded(Sim, BSNEURONS, C.ShapeID); },
+        [Sim](Compartments::BS& C) { return Sim->AddSCCompartment(C, BSNEURONS); });
+}
+
+nlohmann::json ModelRPCInterface::BSNeuronBulkCreate(nlohmann::json _JSONRequest) {
+
+    API::HandlerData Handle(std::move(_JSONRequest), Logger_, "Simulation/Neuron/BS/BulkCreate", Simulations_);
+    if (Handle.HasError()) {
+        return Handle.ErrResponseJSON();
+    }
+
+    Simulation* Sim = Handle.Sim();
+    return API::BulkCreate<CoreStructs::BSNeuronStruct>(Handle, Logger_,
+        [&Handle](nlohmann::json& _Params, CoreStructs::BSNeuronStruct& C) { return BSNeuronFromJSON(Handle, _Params, C); },
+        [Sim](const CoreStructs::BSNeuronStruct& C) {
+            if (!Sim->IsCompatible(BSNEURONS)) {
+                Sim->Logger_->Log("Error attempted mixing of neuron or compartment classes", 7);
+                return false;
+            }
+            if (!Sim->FindBSCompartmentByID(C.SomaCompartmentID)) {
+                Sim->Logger_->Log("Soma compartment with ID "+std::to_string(C.SomaCompartmentID)+" not found", 7);
+                return false;
+            }
+            if (!Sim->FindBSCompartmentByID(C.AxonCompartmentID)) {
+                Sim->Logger_->Log("Axon compartment with ID "+std::to_string(C.AxonCompartmentID)+" not found", 7);
+                return false;
+            }
+            return true;
+        },
+        [Sim](CoreStructs::BSNeuronStruct& C) {
+            C.SomaCompartmentPtr = Sim->FindBSCompartmentByID(C.SomaCompartmentID);
+            C.AxonCompartmentPtr = Sim->FindBSCompartmentByID(C.AxonCompartmentID);
+            return Sim->AddBSNeuron(C);
+        });
+}
+
+nlohmann::json ModelRPCInterface::SCBulkCreate(nlohmann::json _JSONRequest) {
+
+    API::HandlerData Handle(std::move(_JSONRequest), Logger_, "Simulation/Compartments/SC/BulkCreate", Simulations_);
+    if (Handle.HasError()) {
+        return Handle.ErrResponseJSON();
+    }
+
+    Simulation* Sim = Handle.Sim();
+    return API::BulkCreate<Compartments::SC>(Handle, Logger_,
+        [&Handle](nlohmann::json& _Params, Compartments::SC& C) { return BSCompartmentFromJSON(Handle, _Params, C); },
+        [Sim](const Compartments::SC& C) { return CompartmentCanBeAdded(Sim, SCNEURONS, C.ShapeID); },
+        [Sim](Compartments::SC& C) { return Sim->AddSCCompartment(C, SCNEURONS); });
+}
+
+nlohmann::json ModelRPCInterface::SCNeuronBulkCreate(nlohmann::json _JSONRequest) {
+
+    API::HandlerData Handle(std::move(_JSONRequest), Logger_, "Simulation/Neuron/SC/BulkCreate", Simulations_);
+    if (Handle.HasError()) {
+        return Handle.ErrResponseJSON();
+    }
+
+    Simulation* Sim = Handle.Sim();
+    return API::BulkCreate<CoreStructs::SCNeuronStruct>(Handle, Logger_,
+        [&Handle](nlohmann::json& _Params, CoreStructs::SCNeuronStruct& C) { return SCNeuronFromJSON(Handle, _Params, C); },
+        [Sim](const CoreStructs::SCNeuronStruct& C) { return NeuronCanBeAdded(Sim, SCNEURONS, C.SomaCompartmentIDs); },
+        [Sim](CoreStructs::SCNeuronStruct& C) { return Sim->AddSCNeuron(C); });
+}
+
+nlohmann::json ModelRPCInterface::LIFCBulkCreate(nlohmann::json _JSONRequest) {
+
+    API::HandlerData Handle(std::move(_JSONRequest), Logger_, "Simulation/Compartments/LIFC/BulkCreate", Simulations_);
+    if (Handle.HasError()) {
+        return Handle.ErrResponseJSON();
+    }
+
+    Simulation* Sim = Handle.Sim();
+    return API::BulkCreate<Compartments::LIFC>(Handle, Logger_,
+        [&Handle](nlohmann::json& _Params, Compartments::LIFC& C) { return LIFCCompartmentFromJSON(Handle, _Params, C); },
+        [Sim](const Compartments::LIFC& C) { return CompartmentCanBeAdded(Sim, LIFCNEURONS, C.ShapeID); },
+        [Sim](Compartments::LIFC& C) { return Sim->AddLIFCCompartment(C); });
+}
+
+nlohmann::json ModelRPCInterface::LIFCNeuronBulkCreate(nlohmann::json _JSONRequest) {
+
+    API::HandlerData Handle(std::move(_JSONRequest), Logger_, "Simulation/Neuron/LIFC/BulkCreate", Simulations_);
+    if (Handle.HasError()) {
+        return Handle.ErrResponseJSON();
+    }
+
+    Simulation* Sim = Handle.Sim();
+    return API::BulkCreate<CoreStructs::LIFCNeuronStruct>(Handle, Logger_,
+        [&Handle](nlohmann::json& _Params, CoreStructs::LIFCNeuronStruct& C) { return LIFCNeuronFromJSON(Handle, _Params, C); },
+        [Sim](const CoreStructs::LIFCNeuronStruct& C) { return NeuronCanBeAdded(Sim, LIFCNEURONS, C.SomaCompartmentIDs); },
+        [Sim](CoreStructs::LIFCNeuronStruct& C) { return Sim->AddLIFCNeuron(C); });
 }
 
 }; // Close Namespace Simulator
@@ -79,36 +79,47 @@ public:
      * See the relevant file in RPCInterface.(cpp/h) in various directories. 
      * 
      * @param _JSONRequest 
-     * @return std::string 
+     * @return nlohmann::json 
      */
-    std::string StapleCreate(std::string _JSONRequest);
-    std::string ReceptorCreate(std::string _JSONRequest);
-    std::string LIFCReceptorCreate(std::string _JSONRequest);
-    std::string NetmorphLIFCReceptorCreate(std::string _JSONRequest);
-
-    std::string BSCreate(std::string _JSONRequest);
-    std::string BSNeuronCreate(std::string _JSONRequest);
-
-    std::string SCCreate(std::string _JSONRequest);
-    std::string SCNeuronCreate(std::string _JSONRequest);
-    std::string SCNeuronEdit(std::string _JSONRequest);
-
-    std::string LIFCCreate(std::string _JSONRequest);
-    std::string LIFCNeuronCreate(std::string _JSONRequest);
-    std::string LIFCNeuronEdit(std::string _JSONRequest);
-
-    std::string PatchClampDACCreate(std::string _JSONRequest);
-    std::string PatchClampDACSetOutputList(std::string _JSONRequest);
-
-    std::string PatchClampADCCreate(std::string _JSONRequest);
-    std::string PatchClampADCSetSampleRate(std::string _JSONRequest);
-    std::string PatchClampADCGetRecordedData(std::string _JSONRequest);
-
-    std::string SetSpecificAPTimes(std::string _JSONRequest);
-    std::string SetSpontaneousActivity(std::string _JSONRequest);
-
-    std::string OptoModifyInjection(std::string _JSONRequest);
-    std::string OptoActivation(std::string _JSONRequest);
+    nlohmann::json StapleCreate(nlohmann::json _JSONRequest);
+    nlohmann::json ReceptorCreate(nlohmann::json _JSONRequest);
+    nlohmann::json LIFCReceptorCreate(nlohmann::json _JSONRequest);
+    nlohmann::json NetmorphLIFCReceptorCreate(nlohmann::json _JSONRequest);
+
+    nlohmann::json BSCreate(nlohmann::json _JSONRequest);
+    nlohmann::json BSNeuronCreate(nlohmann::json _JSONRequest);
+
+    nlohmann::json SCCreate(nlohmann::json _JSONRequest);
+    nlohmann::json SCNeuronCreate(nlohmann::json _JSONRequest);
+    nlohmann::json SCNeuronEdit(nlohmann::json _JSONRequest);
+
+    nlohmann::json LIFCCreate(nlohmann::json _JSONRequest);
+    nlohmann::json LIFCNeuronCreate(nlohmann::json _JSONRequest);
+    nlohmann::json LIFCNeuronEdit(nlohmann::json _JSONRequest);
+
+    nlohmann::json PatchClampDACCreate(nlohmann::json _JSONRequest);
+    nlohmann::json PatchClampDACSetOutputList(nlohmann::json _JSONRequest);
+
+    nlohmann::json PatchClampADCCreate(nlohmann::json _JSONRequest);
+    nlohmann::json PatchClampADCSetSampleRate(nlohmann::json _JSONRequest);
+    nlohmann::json PatchClampADCGetRecordedData(nlohmann::json _JSONRequest);
+
+    nlohmann::json SetSpecificAPTimes(nlohmann::json _JSONRequest);
+    nlohmann::json SetSpontaneousActivity(nlohmann::json _JSONRequest);
+
+    nlohmann::json OptoModifyInjection(nlohmann::json _JSONRequest);
+    nlohmann::json OptoActivation(nlohmann::json _JSONRequest);
+
+    // Bulk create routes, see API::BulkRequest.
+    nlohmann::json ReceptorBulkCreate(nlohmann::json _JSONRequest);
+    nlohmann::json LIFCReceptorBulkCreate(nlohmann::json _JSONRequest);
+    nlohmann::json NetmorphLIFCReceptorBulkCreate(nlohmann::json _JSONRequest);
+    nlohmann::json BSBulkCreate(nlohmann::json _JSONRequest);
+    nlohmann::json BSNeuronBulkCreate(nlohmann::json _JSONRequest);
+    nlohmann::json SCBulkCreate(nlohmann::json _JSONRequest);
+    nlohmann::json SCNeuronBulkCreate(nlohmann::json _JSONRequest);
+    nlohmann::json LIFCBulkCreate(nlohmann::json _JSONRequest);
+    nlohmann::json LIFCNeuronBulkCreate(nlohmann::json _JSONRequest);
 };
 
 }; // Close Namespace Simulator
@@ -4,12 +4,16 @@
 #include <Simulator/Geometries/VecTools.h>
 #include <Simulator/Structs/RecordingElectrode.h>
 #include <Simulator/Structs/CalciumImaging.h>
+#include <Simulator/Structs/RecordingSink.h>
 
 // Third-Party Libraries (BG convention: use <> instead of "")
 #include <cpp-base64/base64.h>
 
 #include <iostream>
 #include <fstream>
+#include <cstring>
+#include <limits>
+#include <filesystem>
 #include <thread>
 #include <mutex>
 #include <chrono>
@@ -50,6 +54,11 @@ SimulationRPCInterface::SimulationRPCInterface(BG::Common::Logger::LoggingSystem
     VisualizerPool_ = _VisualizerPool;
     RPCManager_ = _RPCManager;
 
+    std::array<int, API::NUMManagedTaskPriority> MaxRunning;
+    MaxRunning[API::TaskPriorityInteractive] = 0;
+    MaxRunning[API::TaskPriorityRender] = Config_->ManagedTaskMaxRunningRender;
+    MaxRunning[API::TaskPrioritySaveLoad] = Config_->ManagedTaskMaxRunningSaveLoad;
+    TaskExecutor_ = std::make_unique<API::ManagedTaskExecutor>(Logger_, Config_->ManagedTaskWorkers, Config_->ManagedTaskQueueLimit, MaxRunning);
 
 
     // Register Callback For CreateSim
@@ -64,16 +73,26 @@ SimulationRPCInterface::SimulationRPCInterface(BG::Common::Logger::LoggingSystem
     _RPCManager->AddRoute("Simulation/SetRandomSeed",             std::bind(&SimulationRPCInterface::SimulationSetSeed, this, std::placeholders::_1));
     _RPCManager->AddRoute("Simulation/LIFCAbstractedFunctional",  std::bind(&SimulationRPCInterface::LIFCAbstractedFunctional, this, std::placeholders::_1));
     _RPCManager->AddRoute("Simulation/LIFCPreciseSpikeTimes",     std::bind(&SimulationRPCInterface::LIFCPreciseSpikeTimes, this, std::placeholders::_1));
+    _RPCManager->AddRoute("Simulation/LIFCRecursiveConductances", std::bind(&SimulationRPCInterface::LIFCRecursiveConductances, this, std::placeholders::_1));
+    _RPCManager->AddRoute("Simulation/LIFCStateArrays",           std::bind(&SimulationRPCInterface::SetLIFCStateArrays, this, std::placeholders::_1));
+    _RPCManager->AddRoute("Simulation/LIFCEventDrivenDelivery",   std::bind(&SimulationRPCInterface::LIFCEventDrivenDelivery, this, std::placeholders::_1));
     _RPCManager->AddRoute("Simulation/SetSTDP",                   std::bind(&SimulationRPCInterface::SetSTDP, this, std::placeholders::_1));
+    _RPCManager->AddRoute("Simulation/SetParallelUpdate",         std::bind(&SimulationRPCInterface::SetParallelUpdate, this, std::placeholders::_1));
 
     _RPCManager->AddRoute("Simulation/RunFor",                    std::bind(&SimulationRPCInterface::SimulationRunFor, this, std::placeholders::_1));
+    _RPCManager->AddRoute("Simulation/RunProgress",               std::bind(&SimulationRPCInterface::SimulationRunProgress, this, std::placeholders::_1));
+    _RPCManager->AddRoute("Simulation/RunPause",                  std::bind(&SimulationRPCInterface::SimulationRunPause, this, std::placeholders::_1));
+    _RPCManager->AddRoute("Simulation/RunResume",                 std::bind(&SimulationRPCInterface::SimulationRunResume, this, std::placeholders::_1));
+    _RPCManager->AddRoute("Simulation/RunAbort",                  std::bind(&SimulationRPCInterface::SimulationRunAbort, this, std::placeholders::_1));
     _RPCManager->AddRoute("Simulation/RecordAll",                 std::bind(&SimulationRPCInterface::SimulationRecordAll, this, std::placeholders::_1));
+    _RPCManager->AddRoute("Simulation/SetRecordingRetention",     std::bind(&SimulationRPCInterface::SetRecordingRetention, this, std::placeholders::_1));
 
     _RPCManager->AddRoute("Simulation/SetPrePostStrength",        std::bind(&SimulationRPCInterface::SetPrePostStrength, this, std::placeholders::_1));
     _RPCManager->AddRoute("Simulation/SetAllStrength",            std::bind(&SimulationRPCInterface::SetAllStrength, this, std::placeholders::_1));
     _RPCManager->AddRoute("Simulation/BatchSetPrePostStrength",   std::bind(&SimulationRPCInterface::BatchSetPrePostStrength, this, std::placeholders::_1));
 
     _RPCManager->AddRoute("Simulation/GetSpikeTimes",             std::bind(&SimulationRPCInterface::SimulationGetSpikeTimes, this, std::placeholders::_1));
+    _RPCManager->AddRoute("Simulation/GetSpikeRaster",            std::bind(&SimulationRPCInterface::SimulationGetSpikeRaster, this, std::placeholders::_1));
     _RPCManager->AddRoute("Simulation/GetRecording",              std::bind(&SimulationRPCInterface::SimulationGetRecording, this, std::placeholders::_1));
     _RPCManager->AddRoute("Simulation/GetStatus",                 std::bind(&SimulationRPCInterface::SimulationGetStatus, this, std::placeholders::_1));
     _RPCManager->AddRoute("Simulation/GetGeoCenter",              std::bind(&SimulationRPCInterface::SimulationGetGeoCenter, this, std::placeholders::_1));
@@ -82,19 +101,34 @@ SimulationRPCInterface::SimulationRPCInterface(BG::Common::Logger::LoggingSystem
     _RPCManager->AddRoute("Simulation/AttachRecordingElectrodes", std::bind(&SimulationRPCInterface::AttachRecordingElectrodes, this, std::placeholders::_1));
     _RPCManager->AddRoute("Simulation/SetRecordInstruments",      std::bind(&SimulationRPCInterface::SetRecordInstruments, this, std::placeholders::_1));
     _RPCManager->AddRoute("Simulation/GetInstrumentRecordings",   std::bind(&SimulationRPCInterface::GetInstrumentRecordings, this, std::placeholders::_1));
+    _RPCManager->AddRoute("Simulation/AddRecordingSink",          std::bind(&SimulationRPCInterface::AddRecordingSink, this, std::placeholders::_1));
+    _RPCManager->AddRoute("Simulation/GetRecordingSinks",         std::bind(&SimulationRPCInterface::GetRecordingSinks, this, std::placeholders::_1));
+    _RPCManager->AddRoute("Simulation/GetRecordingSinkData",      std::bind(&SimulationRPCInterface::GetRecordingSinkData, this, std::placeholders::_1));
 
     _RPCManager->AddRoute("Simulation/Save",                      std::bind(&SimulationRPCInterface::SimulationSave, this, std::placeholders::_1));
     _RPCManager->AddRoute("Simulation/GetSave",                   std::bind(&SimulationRPCInterface::SimulationGetSave, this, std::placeholders::_1));
+    if (Config_->ChunkedSaveTransfer) {
+        _RPCManager->AddRoute("Simulation/GetSaveInfo",           std::bind(&SimulationRPCInterface::SimulationGetSaveInfo, this, std::placeholders::_1));
+        _RPCManager->AddRoute("Simulation/GetSaveChunk",          std::bind(&SimulationRPCInterface::SimulationGetSaveChunk, this, std::placeholders::_1));
+        _RPCManager->AddRoute("Simulation/PutSaveChunk",          std::bind(&SimulationRPCInterface::SimulationPutSaveChunk, this, std::placeholders::_1));
+        _RPCManager->AddRoute("Simulation/GetSaveUpload",         std::bind(&SimulationRPCInterface::SimulationGetSaveUpload, this, std::placeholders::_1));
+        _RPCManager->AddRoute("Simulation/FinishSaveUpload",      std::bind(&SimulationRPCInterface::SimulationFinishSaveUpload, this, std::placeholders::_1));
+    }
     _RPCManager->AddRoute("Simulation/Load",                      std::bind(&SimulationRPCInterface::SimulationLoad, this, std::placeholders::_1));
 
     _RPCManager->AddRoute("Simulation/SaveModel",                 std::bind(&SimulationRPCInterface::SimulationSaveModel, this, std::placeholders::_1));
     _RPCManager->AddRoute("Simulation/LoadModel",                 std::bind(&SimulationRPCInterface::SimulationLoadModel, this, std::placeholders::_1));
+    _RPCManager->AddRoute("Simulation/SaveCheckpoint",            std::bind(&SimulationRPCInterface::SimulationSaveCheckpoint, this, std::placeholders::_1));
+    _RPCManager->AddRoute("Simulation/LoadCheckpoint",            std::bind(&SimulationRPCInterface::SimulationLoadCheckpoint, this, std::placeholders::_1));
+    _RPCManager->AddRoute("Simulation/Sweep",                     std::bind(&SimulationRPCInterface::SimulationRunSweep, this, std::placeholders::_1));
+    _RPCManager->AddRoute("Simulation/Clone",                     std::bind(&SimulationRPCInterface::SimulationClone, this, std::placeholders::_1));
 
     _RPCManager->AddRoute("Simulation/GetSomaPositions",          std::bind(&SimulationRPCInterface::GetSomaPositions, this, std::placeholders::_1));
     _RPCManager->AddRoute("Simulation/GetConnectome",             std::bind(&SimulationRPCInterface::GetConnectome, this, std::placeholders::_1));
     _RPCManager->AddRoute("Simulation/GetAbstractConnectome",     std::bind(&SimulationRPCInterface::GetAbstractConnectome, this, std::placeholders::_1));
 
     _RPCManager->AddRoute("ManTaskStatus",                        std::bind(&SimulationRPCInterface::ManTaskStatus, this, std::placeholders::_1));
+    _RPCManager->AddRoute("ManTaskCancel",                        std::bind(&SimulationRPCInterface::ManTaskCancel, this, std::placeholders::_1));
 
     // *** WHY IS THE FOLLOWING COMMENTED OUT?
     // _RPCManager->AddRoute("CalciumImagingAttach", std::bind(&SimulationRPCInterface::CalciumImagingAttach, this, std::placeholders::_1));
@@ -108,8 +142,20 @@ SimulationRPCInterface::SimulationRPCInterface(BG::Common::Logger::LoggingSystem
 
 SimulationRPCInterface::~SimulationRPCInterface() {
 
+    // Managed tasks use the simulations and their threads, so they are
+    // cancelled and joined first.
+    Logger_->Log("Stopping Managed Tasks", 1);
+    TaskExecutor_.reset();
+
     Logger_->Log("Signaling To Worker Threads To Stop", 1);
     StopThreads_ = true;
+    for (unsigned int i = 0; i < Simulations_.size(); i++) {
+        Simulation* Sim = Simulations_.read(i);
+        if (Sim) {
+            Sim->AbortRun(); // Also ends paused runs
+            Sim->WakeEngine(); // Engine threads sleep until woken
+        }
+    }
 
     Logger_->Log("Joining Simulation Worker Threads", 2);
     for (unsigned int i = 0; i < SimulationThreads_.size(); i++) {
@@ -132,21 +178,41 @@ bool LoadFileIntoString(const std::string& FilePath, std::string& FileContents)
     return true;    
 }
 
-// A API::ManagerTaskData struct must have been prepared and the thread already launched.
+// A API::ManagerTaskData struct must have been prepared. TaskThread is queued
+// on the managed task executor, returns -1 if the executor refused the task.
 int SimulationRPCInterface::AddManagerTask(std::unique_ptr<API::ManagerTaskData>& TaskData, TaskFunctionPtr TaskThread) {
     std::lock_guard<std::mutex> lock(ManTaskMtx); 
 
-    if (TaskData->InputSim) TaskData->InputSim->IncRunningManagedTasksCounter();
-    TaskData->Task = std::make_unique<std::thread>(TaskThread, this, TaskData.get());
-
     // Get Task ID
     int TaskID = NextManTaskID;
     NextManTaskID++;
     TaskData->ID = TaskID;
 
-    // Place task data into ManagerTasks
+    // Place task data into ManagerTasks before the task can start, so that
+    // it is listed with its ID from the moment it runs.
+    API::ManagerTaskData* Data = TaskData.get();
     ManagerTasks[TaskID].reset(TaskData.release()); // Release task data object pointer into unique pointer in map.
 
+    if (Data->InputSim) Data->InputSim->IncRunningManagedTasksCounter();
+
+    // Tasks cancelled while queued never reach TaskThread, so the counter is
+    // decremented and a claim on InputSim released here for them.
+    Simulation* InputSim = Data->InputSim;
+    auto NotStarted = [InputSim, Data]() {
+        Data->ReleaseInputSim();
+        if (InputSim) InputSim->DecRunningManagedTasksCounter();
+    };
+    auto Task = [this, TaskThread](API::ManagerTaskData* _Data) {
+        TaskThread(this, _Data);
+        _Data->ReleaseInputSim();
+    };
+    if (!TaskExecutor_->SubmitManagerTask(Data, Task, NotStarted)) {
+        Data->ReleaseInputSim();
+        if (InputSim) InputSim->DecRunningManagedTasksCounter();
+        ManagerTasks.erase(TaskID);
+        return -1;
+    }
+
     return TaskID;
 }
 
@@ -199,6 +265,62 @@ std::string SimulationRPCInterface::ManTaskStatus(std::string _JSONRequest) {
     return Handle.ResponseAndStoreRequest(taskdata_ptr->OutputData);
 }
 
+/**
+ * Expects _JSONRequest:
+ * {
+ *   "TaskID": <Manager-Task-ID>
+ * }
+ * 
+ * Responds:
+ * {
+ *   "StatusCode": <status-code>,
+ *   "TaskStatus": <task-status-code>,
+ *   "TaskState": <"queued"|"running"|"done">
+ * }
+ * 
+ * A queued task is cancelled right away (TaskStatus Cancelled). A running
+ * task is asked to stop, poll ManTaskStatus to see when it has. Tasks that
+ * are already done are not affected.
+ */
+std::string SimulationRPCInterface::ManTaskCancel(std::string _JSONRequest) {
+    API::HandlerData Handle(_JSONRequest, Logger_, "ManTaskCancel", &Simulations_, true, true); // Not Sim specific.
+    if (Handle.HasError()) {
+        return Handle.ErrResponse();
+    }
+
+    int ManTaskID = -1;
+    if (!Handle.GetParInt("TaskID", ManTaskID)) {
+        return Handle.ErrResponse();
+    }
+
+    // Task data is never removed from ManagerTasks, so the pointer stays valid
+    // after the lock is released. Cancelling a queued task runs its job here.
+    API::ManagerTaskData* taskdata_ptr = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(ManTaskMtx);
+        auto it = ManagerTasks.find(ManTaskID);
+        if (it != ManagerTasks.end()) {
+            taskdata_ptr = it->second.get();
+        }
+    }
+    if (!taskdata_ptr) {
+        return Handle.ErrResponse(API::BGStatusCode::BGStatusInvalidParametersPassed);
+    }
+
+    if (TaskExecutor_->Cancel(taskdata_ptr)) {
+        Logger_->Log("Cancelled Queued Managed Task " + std::to_string(ManTaskID), 3);
+    } else {
+        Logger_->Log("Requested Cancellation Of Managed Task " + std::to_string(ManTaskID), 3);
+    }
+
+    nlohmann::json ResponseJSON;
+    ResponseJSON["StatusCode"] = int(Handle.GetStatus());
+    API::ManagerTaskStatus CurrentStatus = taskdata_ptr->Status;
+    ResponseJSON["TaskStatus"] = int(CurrentStatus);
+    ResponseJSON["TaskState"] = API::ManagerTaskData::StateName(CurrentStatus);
+    return Handle.ResponseAndStoreRequest(ResponseJSON);
+}
+
 /**
  * Expects "Name" and "Seed" parameters.
  */
@@ -243,8 +365,9 @@ std::string SimulationRPCInterface::SimulationReset(std::string _JSONRequest) {
         return Handle.ErrResponse();
     }
 
-    Handle.Sim()->CurrentTask = SIMULATION_RESET; // request a reset be done
-    Handle.Sim()->WorkRequested = true;
+    if (!Handle.Sim()->RequestWork(SIMULATION_RESET)) { // request a reset be done
+        return Handle.ErrResponse(API::BGStatusCode::BGStatusSimulationBusy);
+    }
 
     // Return Result ID
     return Handle.ErrResponse(); // ok
@@ -292,6 +415,7 @@ void SimulationRPCInterface::DeleteResidentByIDTask(API::ManagerTaskData & TaskD
 
     // 5. Terminate and remove the Simulation Thread.
     SimToDelete->KeepResident = false; // Stop thread for this specific simulation
+    SimToDelete->WakeEngine();
     std::thread* SimThread = SimulationThreads_.read(SimToDelete->ID);
     if (SimThread->get_id() != std::thread::id()) {
         SimThread->join(); // Wait to ensure stopped
@@ -521,6 +645,67 @@ std::string SimulationRPCInterface::LIFCPreciseSpikeTimes(std::string _JSONReque
 
 
 
+std::string SimulationRPCInterface::LIFCRecursiveConductances(std::string _JSONRequest) {
+
+    API::HandlerData Handle(_JSONRequest, Logger_, "Simulation/LIFCRecursiveConductances", &Simulations_);
+    if (Handle.HasError()) {
+        return Handle.ErrResponse();
+    }
+
+    bool userecursiveconductances;
+    Handle.GetParBool("UseRecursiveConductances", userecursiveconductances);
+
+    if (Handle.HasError()) {
+        return Handle.ErrResponse();
+    }
+
+    Handle.Sim()->use_recursive_conductances = userecursiveconductances;
+
+    // Return Result ID
+    return Handle.ErrResponse(); // ok
+}
+
+std::string SimulationRPCInterface::SetLIFCStateArrays(std::string _JSONRequest) {
+
+    API::HandlerData Handle(_JSONRequest, Logger_, "Simulation/LIFCStateArrays", &Simulations_);
+    if (Handle.HasError()) {
+        return Handle.ErrResponse();
+    }
+
+    bool usestatearrays;
+    Handle.GetParBool("UseStateArrays", usestatearrays);
+
+    if (Handle.HasError()) {
+        return Handle.ErrResponse();
+    }
+
+    Handle.Sim()->use_lifc_state_arrays = usestatearrays;
+
+    // Return Result ID
+    return Handle.ErrResponse(); // ok
+}
+
+std::string SimulationRPCInterface::LIFCEventDrivenDelivery(std::string _JSONRequest) {
+
+    API::HandlerData Handle(_JSONRequest, Logger_, "Simulation/LIFCEventDrivenDelivery", &Simulations_);
+    if (Handle.HasError()) {
+        return Handle.ErrResponse();
+    }
+
+    bool useeventdrivendelivery;
+    Handle.GetParBool("UseEventDrivenDelivery", useeventdrivendelivery);
+
+    if (Handle.HasError()) {
+        return Handle.ErrResponse();
+    }
+
+    // Takes effect at the start of the next RunFor, see Simulation::PrepareConductanceStates().
+    Handle.Sim()->use_event_driven_delivery = useeventdrivendelivery;
+
+    // Return Result ID
+    return Handle.ErrResponse(); // ok
+}
+
 std::string SimulationRPCInterface::SetSTDP(std::string _JSONRequest) {
 
     API::HandlerData Handle(_JSONRequest, Logger_, "Simulation/SetSTDP", &Simulations_);
@@ -541,6 +726,33 @@ std::string SimulationRPCInterface::SetSTDP(std::string _JSONRequest) {
     return Handle.ErrResponse(); // ok
 }
 
+std::string SimulationRPCInterface::SetParallelUpdate(std::string _JSONRequest) {
+
+    API::HandlerData Handle(_JSONRequest, Logger_, "Simulation/SetParallelUpdate", &Simulations_);
+    if (Handle.HasError()) {
+        return Handle.ErrResponse();
+    }
+
+    bool UseParallelUpdate;
+    int NumThreads = 0;
+    Handle.GetParBool("UseParallelUpdate", UseParallelUpdate);
+    Handle.GetParInt("NumThreads", NumThreads); // 0 uses all hardware threads
+
+    if (Handle.HasError()) {
+        return Handle.ErrResponse();
+    }
+
+    if (Handle.Sim()->IsProcessing) {
+        Logger_->Log("Cannot change update mode while the simulation is running", 7);
+        return Handle.ErrResponse(API::BGStatusCode::BGStatusSimulationBusy);
+    }
+
+    Handle.Sim()->SetParallelUpdate(UseParallelUpdate, NumThreads);
+
+    // Return Result ID
+    return Handle.ErrResponse(); // ok
+}
+
 // This request starts at Simulation Task.
 std::string SimulationRPCInterface::SimulationRunFor(std::string _JSONRequest) {
 
@@ -563,13 +775,100 @@ std::string SimulationRPCInterface::SimulationRunFor(std::string _JSONRequest) {
         Logger_->Log("Parameter error, Dt_ms must be >= 0", 7);
         return Handle.ErrResponse(API::BGStatusCode::BGStatusInvalidParametersPassed);
     }
-    Handle.Sim()->RunTimes_ms = RunTime;
-    Handle.Sim()->Dt_ms = Dt;
-    Handle.Sim()->CurrentTask = SIMULATION_RUNFOR; // request work be done
-    Handle.Sim()->WorkRequested = true;
+    // Return Result ID, an aborted run rewrites the request stored here. It
+    // is stored before the engine thread is woken, so even an immediate
+    // abort finds it.
+    std::string Response;
+    int RunID = Handle.Sim()->RequestRun(RunTime, Dt, [&](int _RunID) { // request work be done
+        Response = Handle.ResponseWithID("RunID", _RunID);
+        Handle.Sim()->SetRunRequest(_RunID);
+    });
+    if (RunID < 0) {
+        Logger_->Log("Simulation was claimed by a task, cannot run", 8);
+        return Handle.ErrResponse(API::BGStatusCode::BGStatusSimulationBusy);
+    }
+    return Response;
+}
 
-    // Return Result ID
-    return Handle.ErrResponse(); // ok
+/**
+ * Expects _JSONRequest:
+ * {
+ *   "SimulationID": <SimID>
+ * }
+ * 
+ * Responds with the progress of the last RunFor, see Simulation::GetRunProgressJSON():
+ * {
+ *   "StatusCode": <status-code>,
+ *   "RunID": <RunID>,
+ *   "State": <"idle"|"queued"|"running"|"paused"|"done"|"aborted">,
+ *   "Done_ms": <simulated-ms-done>,
+ *   "Remaining_ms": <simulated-ms-remaining>,
+ *   "PercentComplete": <percent>,
+ *   "WallElapsed_s": <wall-clock-seconds-running>,
+ *   "Rate_ms_per_s": <simulated-ms-per-wall-clock-second>,
+ *   "ETA_s": <estimated-wall-clock-seconds-remaining, -1 if unknown>
+ * }
+ */
+std::string SimulationRPCInterface::SimulationRunProgress(std::string _JSONRequest) {
+
+    API::HandlerData Handle(_JSONRequest, Logger_, "Simulation/RunProgress", &Simulations_, true);
+    if (Handle.HasError()) {
+        return Handle.ErrResponse();
+    }
+
+    nlohmann::json ResponseJSON = Handle.Sim()->GetRunProgressJSON();
+    ResponseJSON["StatusCode"] = 0; // ok
+    return Handle.ResponseAndStoreRequest(ResponseJSON, false); // Queries are not part of the model.
+}
+
+/**
+ * Pause, resume and abort of the running RunFor, with an optional "RunID"
+ * that has to match the current run. Responds with the run progress.
+ * These control a run in progress and are not stored with the model.
+ */
+std::string SimulationRPCInterface::RunControl(std::string _JSONRequest, const std::string& _Route, bool (Simulation::*_Action)()) {
+
+    API::HandlerData Handle(_JSONRequest, Logger_, _Route, &Simulations_, true);
+    if (Handle.HasError()) {
+        return Handle.ErrResponse();
+    }
+
+    // Error responses are not stored either (ErrResponse() would).
+    nlohmann::json ResponseJSON;
+    int RunID = Handle.Sim()->GetRunID();
+    Handle.GetParInt("RunID", RunID, true);
+    if (Handle.HasError()) {
+        ResponseJSON["StatusCode"] = int(Handle.GetStatus());
+        return Handle.ResponseAndStoreRequest(ResponseJSON, false);
+    }
+    if (RunID != Handle.Sim()->GetRunID()) {
+        Logger_->Log("Error: RunID " + std::to_string(RunID) + " is not the current run of simulation " + Handle.SimIDStr(), 7);
+        ResponseJSON["StatusCode"] = int(API::BGStatusCode::BGStatusInvalidParametersPassed);
+        return Handle.ResponseAndStoreRequest(ResponseJSON, false);
+    }
+
+    if (!(Handle.Sim()->*_Action)()) {
+        Logger_->Log("Error: " + _Route + " called without an active run", 7);
+        ResponseJSON = Handle.Sim()->GetRunProgressJSON();
+        ResponseJSON["StatusCode"] = int(API::BGStatusCode::BGStatusInvalidParametersPassed);
+        return Handle.ResponseAndStoreRequest(ResponseJSON, false);
+    }
+
+    ResponseJSON = Handle.Sim()->GetRunProgressJSON();
+    ResponseJSON["StatusCode"] = 0; // ok
+    return Handle.ResponseAndStoreRequest(ResponseJSON, false);
+}
+
+std::string SimulationRPCInterface::SimulationRunPause(std::string _JSONRequest) {
+    return RunControl(_JSONRequest, "Simulation/RunPause", &Simulation::PauseRun);
+}
+
+std::string SimulationRPCInterface::SimulationRunResume(std::string _JSONRequest) {
+    return RunControl(_JSONRequest, "Simulation/RunResume", &Simulation::ResumeRun);
+}
+
+std::string SimulationRPCInterface::SimulationRunAbort(std::string _JSONRequest) {
+    return RunControl(_JSONRequest, "Simulation/RunAbort", &Simulation::AbortRun);
 }
 
 std::string SimulationRPCInterface::SimulationRecordAll(std::string _JSONRequest) {
@@ -589,6 +888,27 @@ std::string SimulationRPCInterface::SimulationRecordAll(std::string _JSONRequest
     return Handle.ErrResponse(); // ok
 }
 
+std::string SimulationRPCInterface::SetRecordingRetention(std::string _JSONRequest) {
+
+    API::HandlerData Handle(_JSONRequest, Logger_, "Simulation/SetRecordingRetention", &Simulations_);
+    if (Handle.HasError()) {
+        return Handle.ErrResponse();
+    }
+
+    int MaxSamples = 0; // 0 keeps everything
+    if (!Handle.GetParInt("MaxSamples", MaxSamples)) {
+        return Handle.ErrResponse();
+    }
+    if (MaxSamples < 0) {
+        return Handle.ErrResponse(API::BGStatusCode::BGStatusInvalidParametersPassed);
+    }
+    Handle.Sim()->RecordingMaxSamples = MaxSamples;
+    Handle.Sim()->ApplyRecordingRetention();
+
+    // Return Result ID
+    return Handle.ErrResponse(); // ok
+}
+
 std::string SimulationRPCInterface::SetPrePostStrength(std::string _JSONRequest) {
     API::HandlerData Handle(_JSONRequest, Logger_, "Simulation/SetPrePostStrength", &Simulations_);
     if (Handle.HasError()) {
@@ -657,10 +977,58 @@ std::string SimulationRPCInterface::SimulationGetSpikeTimes(std::string _JSONReq
         return Handle.ErrResponse();
     }
 
+    // Polling clients pass the Cursor_ms of the previous response.
+    float Cursor_ms = 0.0;
+    Handle.GetParFloat("Cursor_ms", Cursor_ms, true);
+    if (Handle.HasError()) {
+        return Handle.ErrResponse();
+    }
+
+    // Return JSON
+    nlohmann::json ResponseJSON;
+    ResponseJSON["StatusCode"] = 0; // ok
+    ResponseJSON["SpikeTimes"] = Handle.Sim()->GetSpikeTimesJSON(Cursor_ms);
+    ResponseJSON["Cursor_ms"] = Handle.Sim()->T_ms;
+    return Handle.ResponseAndStoreRequest(ResponseJSON);
+}
+
+std::string SimulationRPCInterface::SimulationGetSpikeRaster(std::string _JSONRequest) {
+ 
+    API::HandlerData Handle(_JSONRequest, Logger_, "Simulation/GetSpikeRaster", &Simulations_);
+    if (Handle.HasError()) {
+        return Handle.ErrResponse();
+    }
+
+    // All parameters are optional. Polling clients pass the Cursor_ms of the
+    // previous response as TStart_ms to only receive new spikes.
+    float TStart_ms = 0.0;
+    float TEnd_ms = std::numeric_limits<float>::max();
+    float Resolution_ms = 0.001;
+    std::vector<int> NeuronIDs;
+    Handle.GetParFloat("TStart_ms", TStart_ms, true);
+    Handle.GetParFloat("TEnd_ms", TEnd_ms, true);
+    Handle.GetParFloat("Resolution_ms", Resolution_ms, true);
+    Handle.GetParVecInt("NeuronIDs", NeuronIDs, true);
+    if (Handle.HasError()) {
+        return Handle.ErrResponse();
+    }
+    if (Resolution_ms <= 0.0) {
+        return Handle.ErrResponse(API::BGStatusCode::BGStatusInvalidParametersPassed);
+    }
+
+    std::string Raster;
+    if (!Handle.Sim()->GetSpikeRaster(TStart_ms, TEnd_ms, NeuronIDs, Resolution_ms, Raster)) {
+        return Handle.ErrResponse(API::BGStatusCode::BGStatusInvalidParametersPassed);
+    }
+    Tools::SpikeRasterHeader Header;
+    std::memcpy(&Header, Raster.data(), sizeof(Header));
+
     // Return JSON
     nlohmann::json ResponseJSON;
     ResponseJSON["StatusCode"] = 0; // ok
-    ResponseJSON["SpikeTimes"] = Handle.Sim()->GetSpikeTimesJSON();
+    ResponseJSON["Cursor_ms"] = Header.TEnd_ms;
+    ResponseJSON["NumSpikes"] = Header.NumSpikes;
+    ResponseJSON["SpikeRaster"] = base64_encode(reinterpret_cast<const unsigned char*>(Raster.c_str()), Raster.length());
     return Handle.ResponseAndStoreRequest(ResponseJSON);
 }
 
@@ -671,10 +1039,17 @@ std::string SimulationRPCInterface::SimulationGetRecording(std::string _JSONRequ
         return Handle.ErrResponse();
     }
 
+    // Polling clients pass the "cursor" of the previous recording.
+    int Cursor = 0;
+    Handle.GetParInt("Cursor", Cursor, true);
+    if (Handle.HasError()) {
+        return Handle.ErrResponse();
+    }
+
     // Return JSON
     nlohmann::json ResponseJSON;
     ResponseJSON["StatusCode"] = 0; // ok
-    ResponseJSON["Recording"] = Handle.Sim()->GetRecordingJSON(); //Handle.Sim()->RecordingBlob;
+    ResponseJSON["Recording"] = Handle.Sim()->GetRecordingJSON(std::max(Cursor, 0)); //Handle.Sim()->RecordingBlob;
     return Handle.ResponseAndStoreRequest(ResponseJSON);
 }
 
@@ -689,11 +1064,16 @@ std::string SimulationRPCInterface::SimulationGetStatus(std::string _JSONRequest
     nlohmann::json ResponseJSON;
     ResponseJSON["StatusCode"] = 0; // ok
     ResponseJSON["IsSimulating"] = (bool)(Handle.Sim()->IsProcessing || Handle.Sim()->WorkRequested || Handle.Sim()->IsRendering);
-    ResponseJSON["RealWorldTimeRemaining_ms"] = 0.0;
-    ResponseJSON["RealWorldTimeElapsed_ms"] = 0.0;
+    nlohmann::json Progress = Handle.Sim()->GetRunProgressJSON();
+    double ETA_s = Progress["ETA_s"].get<double>();
+    ResponseJSON["RealWorldTimeRemaining_ms"] = (ETA_s > 0.0) ? (1000.0 * ETA_s) : 0.0;
+    ResponseJSON["RealWorldTimeElapsed_ms"] = 1000.0 * Progress["WallElapsed_s"].get<double>();
     ResponseJSON["InSimulationTime_ms"] = Handle.Sim()->T_ms;
-    ResponseJSON["InSimulationTimeRemaining_ms"] = 0.0;
-    ResponseJSON["PercentComplete"] = 0.0;
+    ResponseJSON["InSimulationTimeRemaining_ms"] = Progress["Remaining_ms"];
+    ResponseJSON["PercentComplete"] = Progress["PercentComplete"];
+    ResponseJSON["RunID"] = Progress["RunID"];
+    ResponseJSON["RunState"] = Progress["State"];
+    ResponseJSON["Engine"] = Handle.Sim()->GetEngineStatsJSON();
     return Handle.ResponseAndStoreRequest(ResponseJSON);
 }
 
@@ -718,6 +1098,11 @@ std::string SimulationRPCInterface::SimulationSave(std::string _JSONRequest) {
     return Handle.ResponseWithID("SavedSimName", SavedSimName);
 }
 
+/**
+ * Returns a whole save file, of any size. It is read in chunks, clients
+ * that want to download it in chunks too can enable the chunked transfer
+ * routes (Simulation/GetSaveInfo, Simulation/GetSaveChunk, ...).
+ */
 std::string SimulationRPCInterface::SimulationGetSave(std::string _JSONRequest) {
 
     API::HandlerData Handle(_JSONRequest, Logger_, "Simulation/GetSave", &Simulations_, true, true);
@@ -725,40 +1110,17 @@ std::string SimulationRPCInterface::SimulationGetSave(std::string _JSONRequest)
         return Handle.ErrResponse();
     }
 
-    //std::cout << "Number of stored requests: " << Handle.Sim()->NumStoredRequests() << "\n\n";
-    //std::cout << Handle.Sim()->StoredRequestsToString() << '\n';
-
     std::string SaveName;
     Handle.GetParString("SaveHandle", SaveName);
-
-    // Minor security feature (probably still exploitable, so be warned!)
-    // We just remove .. from the incoming handle for the image, since they're just files right now
-    // as such, if we didnt strip that, then people could read any files on the server!
-    // Also, we prepend a '.' so people can't try and get to the root
-    std::string Pattern = "..";
-    std::string::size_type i = SaveName.find(Pattern);
-    while (i != std::string::npos) {
-        Logger_->Log("Detected '..' In SaveName, It's Possible That Someone Is Trying To Do Something Nasty", 8);
-        SaveName.erase(i, Pattern.length());
-        i = SaveName.find(Pattern, i);
+    if (!Tools::SaveTransfer::IsSafeHandle(SaveName)) {
+        Logger_->Log("Rejected SaveHandle '" + SaveName + "', It's Possible That Someone Is Trying To Do Something Nasty", 8);
+        return Handle.ErrResponse(API::BGStatusCode::BGStatusInvalidParametersPassed);
     }
-    std::string SafeHandle = "SavedSimulations/" + SaveName + ".NES";
 
-
-    // Now Check If The Handle Is Valid, If So, Load It
-    std::ifstream DataStream(SafeHandle.c_str(), std::ios::binary);
     std::string RawData;
-    if (DataStream.good()) {
-        std::stringstream Buffer;
-        Buffer << DataStream.rdbuf();
-        RawData = Buffer.str();
-        DataStream.close();
-
-    } else {
-        Logger_->Log("An Invalid SaveHandle Was Provided " + SafeHandle, 6);
-        nlohmann::json ResponseJSON;
-        ResponseJSON["StatusCode"] = 2; // error
-        return ResponseJSON.dump();
+    if (!SavedSimulationFiles_.ReadFile(SaveName, RawData)) {
+        Logger_->Log("An Invalid SaveHandle Was Provided " + SaveName, 6);
+        return Handle.ErrResponse(API::BGStatusCode::BGStatusGeneralFailure);
     }
 
     // Now, Convert It To Base64
@@ -768,63 +1130,226 @@ std::string SimulationRPCInterface::SimulationGetSave(std::string _JSONRequest)
     return Handle.StringResponse("SaveData", Base64Data);
 }
 
-void SimulationRPCInterface::SimLoadingTask(API::ManagerTaskData& TaskData) {
-    //std::lock_guard<std::mutex> lock(ManTaskMtx);
-
-    // *** Not sure if we should prepend with "std::string loadresponse = " to keep the full
-    //     record of the loading requests in the task output JSON.
-
-    // Build New Simulation Object
-    //Simulations_.push_back(std::make_unique<Simulation>(Logger_));
-    size_t idx = Simulations_.append(std::make_unique<Simulation>(Logger_));
-    //Simulation* Sim = Simulations_[Simulations_.size() - 1].get();
-    Simulation* Sim = Simulations_.read(idx);
-    assert(Sim != nullptr);
-    Sim->Name = "Loaded Simulation";
-    Sim->CurrentTask = SIMULATION_NONE;
-    Sim->ID = idx;
-    Sim->SetRandomSeed(0);
-
-    // Start Thread
-    //SimulationThreads_.push_back(std::thread(&SimulationEngineThread, Logger_, Sim, RenderPool_, VisualizerPool_, &StopThreads_));
-    SimulationThreads_.append(std::make_unique<std::thread>(&SimulationEngineThread, Logger_, Sim, RenderPool_, VisualizerPool_, &StopThreads_));
-
+/**
+ * Size and SHA-256 of a save file, for chunked downloads with
+ * Simulation/GetSaveChunk. The hash is cached per file version.
+ */
+std::string SimulationRPCInterface::SimulationGetSaveInfo(std::string _JSONRequest) {
 
-    // Get New SimID
-    size_t NewSimID = Sim->ID;
-    TaskData.ReplaceSimulationID = NewSimID;
+    API::HandlerData Handle(_JSONRequest, Logger_, "Simulation/GetSaveInfo", &Simulations_, true, true);
+    if (Handle.HasError()) {
+        return Handle.ErrResponse();
+    }
 
-    RPCManager_->NESRequest(TaskData.InputData, NewSimID);
-    TaskData.OutputData["SimulationID"] = TaskData.ReplaceSimulationID;
-    TaskData.SetStatus(API::ManagerTaskStatus::Success);
-    Logger_->Log("Loading Simulation " + std::to_string(TaskData.ReplaceSimulationID) + " Completed", 2);
-}
+    std::string SaveName;
+    if (!Handle.GetParString("SaveHandle", SaveName)) {
+        return Handle.ErrResponse();
+    }
+    uint64_t Size = 0;
+    std::string HexDigest;
+    if (!SavedSimulationFiles_.GetInfo(SaveName, Size, HexDigest)) {
+        Logger_->Log("An Invalid SaveHandle Was Provided " + SaveName, 6);
+        return Handle.ErrResponse(API::BGStatusCode::BGStatusInvalidParametersPassed);
+    }
 
-void SimLoadingTaskThread(SimulationRPCInterface* _Manager, API::ManagerTaskData* TaskData) {
-    if (!TaskData) return;
-    _Manager->SimLoadingTask(*TaskData); // Run the rest back in the Manager for full context.
-    if (TaskData->InputSim) TaskData->InputSim->DecRunningManagedTasksCounter();
+    nlohmann::json ResponseJSON;
+    ResponseJSON["StatusCode"] = 0; // ok
+    ResponseJSON["Size"] = Size;
+    ResponseJSON["SHA256"] = HexDigest;
+    ResponseJSON["MaxChunkBytes"] = Tools::SaveTransfer::MaxChunkBytes;
+    return Handle.ResponseAndStoreRequest(ResponseJSON, false);
 }
 
 /**
- * This can be a long task (from a computer's perspective) and can lead to
- * connection closing without a response if the handler response does not
- * come for a while.
- * 
- * Do the actual loading within a task, here just launch the task and
- * return the response that it was launched, and return the task ID.
- * 
+ * Reads Length bytes at Offset of a save file. Fewer bytes are returned at
+ * the end of the file and for Length above MaxChunkBytes. JSON carries
+ * the bytes as base64.
  */
-// This request starts a Manager Task.
-std::string SimulationRPCInterface::SimulationLoad(std::string _JSONRequest) {
-    API::HandlerData Handle(_JSONRequest, Logger_, "Simulation/Load", &Simulations_, true, true);
+std::string SimulationRPCInterface::SimulationGetSaveChunk(std::string _JSONRequest) {
+
+    API::HandlerData Handle(_JSONRequest, Logger_, "Simulation/GetSaveChunk", &Simulations_, true, true);
     if (Handle.HasError()) {
         return Handle.ErrResponse();
     }
 
-    // Get the Simulation File Name
-    std::string SavedSimName;
-    if (!Handle.GetParString("SavedSimName", SavedSimName)) {
+    std::string SaveName;
+    uint64_t Offset = 0;
+    uint64_t Length = 0;
+    if ((!Handle.GetParString("SaveHandle", SaveName)) || (!Handle.GetParUInt64("Offset", Offset)) || (!Handle.GetParUInt64("Length", Length))) {
+        return Handle.ErrResponse();
+    }
+    std::string RawData;
+    if (!SavedSimulationFiles_.ReadChunk(SaveName, Offset, Length, RawData)) {
+        Logger_->Log("Unable to read chunk of save " + SaveName, 6);
+        return Handle.ErrResponse(API::BGStatusCode::BGStatusInvalidParametersPassed);
+    }
+
+    nlohmann::json ResponseJSON;
+    ResponseJSON["StatusCode"] = 0; // ok
+    ResponseJSON["Offset"] = Offset;
+    ResponseJSON["Length"] = RawData.size();
+    ResponseJSON["Data"] = base64_encode(reinterpret_cast<const unsigned char*>(RawData.c_str()), RawData.length());
+    return Handle.ResponseAndStoreRequest(ResponseJSON, false);
+}
+
+/**
+ * Receives one base64 chunk of a save file upload at Offset, which must not
+ * lie beyond the bytes received so far. Returns the bytes received, from
+ * which an interrupted upload continues.
+ */
+std::string SimulationRPCInterface::SimulationPutSaveChunk(std::string _JSONRequest) {
+
+    API::HandlerData Handle(_JSONRequest, Logger_, "Simulation/PutSaveChunk", &Simulations_, true, true);
+    if (Handle.HasError()) {
+        return Handle.ErrResponse();
+    }
+
+    std::string SaveName;
+    uint64_t Offset = 0;
+    std::string Base64Data;
+    if ((!Handle.GetParString("SaveHandle", SaveName)) || (!Handle.GetParUInt64("Offset", Offset)) || (!Handle.GetParString("Data", Base64Data))) {
+        return Handle.ErrResponse();
+    }
+    uint64_t Received = 0;
+    if (!SavedSimulationFiles_.WriteChunk(SaveName, Offset, base64_decode(Base64Data), Received)) {
+        Logger_->Log("Unable to write chunk of save upload " + SaveName, 6);
+        return Handle.ErrResponse(API::BGStatusCode::BGStatusInvalidParametersPassed);
+    }
+
+    nlohmann::json ResponseJSON;
+    ResponseJSON["StatusCode"] = 0; // ok
+    ResponseJSON["Received"] = Received;
+    return Handle.ResponseAndStoreRequest(ResponseJSON, false);
+}
+
+/**
+ * Bytes of a save file upload received so far, to resume it.
+ */
+std::string SimulationRPCInterface::SimulationGetSaveUpload(std::string _JSONRequest) {
+
+    API::HandlerData Handle(_JSONRequest, Logger_, "Simulation/GetSaveUpload", &Simulations_, true, true);
+    if (Handle.HasError()) {
+        return Handle.ErrResponse();
+    }
+
+    std::string SaveName;
+    if (!Handle.GetParString("SaveHandle", SaveName)) {
+        return Handle.ErrResponse();
+    }
+    uint64_t Received = 0;
+    if (!SavedSimulationFiles_.GetReceived(SaveName, Received)) {
+        return Handle.ErrResponse(API::BGStatusCode::BGStatusInvalidParametersPassed);
+    }
+
+    nlohmann::json ResponseJSON;
+    ResponseJSON["StatusCode"] = 0; // ok
+    ResponseJSON["Received"] = Received;
+    ResponseJSON["MaxChunkBytes"] = Tools::SaveTransfer::MaxChunkBytes;
+    return Handle.ResponseAndStoreRequest(ResponseJSON, false);
+}
+
+/**
+ * Completes a save file upload if the received bytes match the SHA256
+ * given by the client, after which it loads with Simulation/Load. With
+ * "Abort": true the upload is dropped instead.
+ */
+std::string SimulationRPCInterface::SimulationFinishSaveUpload(std::string _JSONRequest) {
+
+    API::HandlerData Handle(_JSONRequest, Logger_, "Simulation/FinishSaveUpload", &Simulations_, true, true);
+    if (Handle.HasError()) {
+        return Handle.ErrResponse();
+    }
+
+    std::string SaveName;
+    bool Abort = false;
+    if (!Handle.GetParString("SaveHandle", SaveName)) {
+        return Handle.ErrResponse();
+    }
+    Handle.GetParBool("Abort", Abort, true);
+    if (Abort) {
+        if (!SavedSimulationFiles_.AbortUpload(SaveName)) {
+            return Handle.ErrResponse(API::BGStatusCode::BGStatusInvalidParametersPassed);
+        }
+        return Handle.ResponseWithID("SavedSimName", "");
+    }
+
+    std::string HexDigest;
+    if (!Handle.GetParString("SHA256", HexDigest)) {
+        return Handle.ErrResponse();
+    }
+    std::string Error;
+    if (!SavedSimulationFiles_.FinishUpload(SaveName, HexDigest, Error)) {
+        Logger_->Log("Unable to finish save upload " + SaveName + ": " + Error, 6);
+        return Handle.ErrResponse(API::BGStatusCode::BGStatusInvalidParametersPassed);
+    }
+    Logger_->Log("Received save upload " + SaveName, 3);
+
+    return Handle.ResponseWithID("SavedSimName", SaveName);
+}
+
+void SimulationRPCInterface::SimLoadingTask(API::ManagerTaskData& TaskData) {
+    //std::lock_guard<std::mutex> lock(ManTaskMtx);
+
+    // *** Not sure if we should prepend with "std::string loadresponse = " to keep the full
+    //     record of the loading requests in the task output JSON.
+
+    // Build New Simulation Object
+    //Simulations_.push_back(std::make_unique<Simulation>(Logger_));
+    size_t idx = Simulations_.append(std::make_unique<Simulation>(Logger_));
+    //Simulation* Sim = Simulations_[Simulations_.size() - 1].get();
+    Simulation* Sim = Simulations_.read(idx);
+    assert(Sim != nullptr);
+    Sim->Name = "Loaded Simulation";
+    Sim->CurrentTask = SIMULATION_NONE;
+    Sim->ID = idx;
+    Sim->SetRandomSeed(0);
+
+    // Start Thread
+    //SimulationThreads_.push_back(std::thread(&SimulationEngineThread, Logger_, Sim, RenderPool_, VisualizerPool_, &StopThreads_));
+    SimulationThreads_.append(std::make_unique<std::thread>(&SimulationEngineThread, Logger_, Sim, RenderPool_, VisualizerPool_, &StopThreads_));
+
+
+    // Get New SimID
+    size_t NewSimID = Sim->ID;
+    TaskData.ReplaceSimulationID = NewSimID;
+
+    RPCManager_->NESRequest(TaskData.InputData, NewSimID, &TaskData.CancelRequested);
+    TaskData.OutputData["SimulationID"] = TaskData.ReplaceSimulationID;
+    if (TaskData.IsCancelled()) {
+        // The simulation keeps what was loaded up to this point.
+        Logger_->Log("Loading Simulation " + std::to_string(TaskData.ReplaceSimulationID) + " Cancelled", 6);
+        TaskData.SetStatus(API::ManagerTaskStatus::Cancelled);
+        return;
+    }
+    TaskData.SetStatus(API::ManagerTaskStatus::Success);
+    Logger_->Log("Loading Simulation " + std::to_string(TaskData.ReplaceSimulationID) + " Completed", 2);
+}
+
+void SimLoadingTaskThread(SimulationRPCInterface* _Manager, API::ManagerTaskData* TaskData) {
+    if (!TaskData) return;
+    _Manager->SimLoadingTask(*TaskData); // Run the rest back in the Manager for full context.
+    if (TaskData->InputSim) TaskData->InputSim->DecRunningManagedTasksCounter();
+}
+
+/**
+ * This can be a long task (from a computer's perspective) and can lead to
+ * connection closing without a response if the handler response does not
+ * come for a while.
+ * 
+ * Do the actual loading within a task, here just launch the task and
+ * return the response that it was launched, and return the task ID.
+ * 
+ */
+// This request starts a Manager Task.
+std::string SimulationRPCInterface::SimulationLoad(std::string _JSONRequest) {
+    API::HandlerData Handle(_JSONRequest, Logger_, "Simulation/Load", &Simulations_, true, true);
+    if (Handle.HasError()) {
+        return Handle.ErrResponse();
+    }
+
+    // Get the Simulation File Name
+    std::string SavedSimName;
+    if (!Handle.GetParString("SavedSimName", SavedSimName)) {
         return Handle.ErrResponse();
     }
 
@@ -963,6 +1488,379 @@ std::string SimulationRPCInterface::SimulationLoadModel(std::string _JSONRequest
     return Handle.ResponseWithID("TaskID", TaskID);
 }
 
+// The function that handles the request.
+void SimulationRPCInterface::SimulationSaveCheckpointTask(API::ManagerTaskData & TaskData) {
+
+    Logger_->Log("Saving Simulation Checkpoint " + TaskData.InputData, 2);
+
+    if (!TaskData.InputSim->SaveCheckpoint(TaskData.InputData)) {
+        Logger_->Log("Failed to save simulation checkpoint as "+TaskData.InputData, 8);
+        TaskData.SetStatus(API::ManagerTaskStatus::GeneralFailure);
+        return;
+    }
+
+    Logger_->Log("Saved simulation checkpoint to "+TaskData.InputData, 3);
+
+    TaskData.SetStatus(API::ManagerTaskStatus::Success); // Signal task done
+}
+
+// The threadable function that calls the task handler above.
+void SimulationSaveCheckpointTaskThread(SimulationRPCInterface* _Manager, API::ManagerTaskData* TaskData) {
+    if (!TaskData) return;
+    _Manager->SimulationSaveCheckpointTask(*TaskData); // Run the rest back in the Manager for full context.
+    if (TaskData->InputSim) TaskData->InputSim->DecRunningManagedTasksCounter();
+}
+
+/**
+ * This saves the dynamic state of a Simulation, i.e. membrane potentials,
+ * conductance states, spike histories, spikes in flight, random generator
+ * states and recordings. The checkpoint does not contain the model, save
+ * that with SaveModel.
+ */
+std::string SimulationRPCInterface::SimulationSaveCheckpoint(std::string _JSONRequest) {
+    API::HandlerData Handle(_JSONRequest, Logger_, "Simulation/SaveCheckpoint", &Simulations_, false, false); // false, false if applied to Simulation object
+    if (Handle.HasError()) {
+        return Handle.ErrResponse();
+    }
+
+    // Prepare data structure for task
+    std::unique_ptr<API::ManagerTaskData> SimulationSaveCheckpointTaskData = std::make_unique<API::ManagerTaskData>(API::SimulationSaveCheckpointTask);
+
+    // Get the Checkpoint File Name
+    std::string CheckpointName;
+    if (!Handle.GetParString("Name", CheckpointName)) {
+        return Handle.ErrResponse();
+    }
+    SimulationSaveCheckpointTaskData->InputData = CheckpointName;
+    SimulationSaveCheckpointTaskData->InputSim = Handle.Sim();
+
+    // Keep runs off the simulation until the task is done
+    if (!SimulationSaveCheckpointTaskData->ClaimInputSim()) {
+        return Handle.ErrResponse(API::BGStatusCode::BGStatusSimulationBusy);
+    }
+
+    // Add task with fresh task status and get task ID to be returned to requestor
+    int TaskID = AddManagerTask(SimulationSaveCheckpointTaskData, SimulationSaveCheckpointTaskThread);
+    if (TaskID<0) {
+        Logger_->Log("Unable to launch SimulationSaveCheckpoint Task", 8);
+        return Handle.ErrResponse(API::BGStatusCode::BGStatusGeneralFailure);
+    }
+
+    // Return Result ID
+    return Handle.ResponseWithID("TaskID", TaskID);
+}
+
+// The function that handles the request.
+void SimulationRPCInterface::SimulationLoadCheckpointTask(API::ManagerTaskData & TaskData) {
+
+    Logger_->Log("Loading Simulation Checkpoint " + TaskData.InputData, 2);
+
+    if (!TaskData.InputSim->LoadCheckpoint(TaskData.InputData)) {
+        Logger_->Log("Failed to load simulation checkpoint "+TaskData.InputData, 8);
+        TaskData.SetStatus(API::ManagerTaskStatus::GeneralFailure);
+        return;
+    }
+
+    Logger_->Log("Loaded simulation checkpoint "+TaskData.InputData, 3);
+
+    TaskData.SetStatus(API::ManagerTaskStatus::Success); // Signal task done
+}
+
+// The threadable function that calls the task handler above.
+void SimulationLoadCheckpointTaskThread(SimulationRPCInterface* _Manager, API::ManagerTaskData* TaskData) {
+    if (!TaskData) return;
+    _Manager->SimulationLoadCheckpointTask(*TaskData); // Run the rest back in the Manager for full context.
+    if (TaskData->InputSim) TaskData->InputSim->DecRunningManagedTasksCounter();
+}
+
+/**
+ * This restores the dynamic state saved by SaveCheckpoint onto a Simulation
+ * with the same model, e.g. one rebuilt with LoadModel. Continuing with RunFor
+ * then gives the same results as the Simulation the checkpoint was saved from.
+ */
+std::string SimulationRPCInterface::SimulationLoadCheckpoint(std::string _JSONRequest) {
+    API::HandlerData Handle(_JSONRequest, Logger_, "Simulation/LoadCheckpoint", &Simulations_, false, false); // false, false if applied to Simulation object
+    if (Handle.HasError()) {
+        return Handle.ErrResponse();
+    }
+
+    // Prepare data structure for task
+    std::unique_ptr<API::ManagerTaskData> SimulationLoadCheckpointTaskData = std::make_unique<API::ManagerTaskData>(API::SimulationLoadCheckpointTask);
+
+    // Get the Checkpoint File Name
+    std::string CheckpointName;
+    if (!Handle.GetParString("Name", CheckpointName)) {
+        return Handle.ErrResponse();
+    }
+    SimulationLoadCheckpointTaskData->InputData = CheckpointName;
+    SimulationLoadCheckpointTaskData->InputSim = Handle.Sim();
+
+    // Keep runs off the simulation until the task is done
+    if (!SimulationLoadCheckpointTaskData->ClaimInputSim()) {
+        return Handle.ErrResponse(API::BGStatusCode::BGStatusSimulationBusy);
+    }
+
+    // Add task with fresh task status and get task ID to be returned to requestor
+    int TaskID = AddManagerTask(SimulationLoadCheckpointTaskData, SimulationLoadCheckpointTaskThread);
+    if (TaskID<0) {
+        Logger_->Log("Unable to launch SimulationLoadCheckpoint Task", 8);
+        return Handle.ErrResponse(API::BGStatusCode::BGStatusGeneralFailure);
+    }
+
+    // Return Result ID
+    return Handle.ResponseWithID("TaskID", TaskID);
+}
+
+// Reads the replicas and options of a Simulation/Sweep request.
+static bool SweepFromRequest(API::HandlerData& Handle, std::vector<SweepReplica>& _Replicas, SweepOptions& _Options) {
+
+    if (!Handle.GetParFloat("Runtime_ms", _Options.Runtime_ms)) {
+        return false;
+    }
+    Handle.GetParInt("NumThreads", _Options.NumThreads, true);
+    Handle.GetParBool("IncludeSpikeTimes", _Options.IncludeSpikeTimes, true);
+    Handle.GetParBool("IncludeRecording", _Options.IncludeRecording, true);
+    if (Handle.HasError() || (_Options.Runtime_ms < 0.0) || (_Options.NumThreads < 0)) {
+        return false;
+    }
+
+    nlohmann::json::iterator ReplicasJSON_it;
+    if ((!Handle.FindPar("Replicas", ReplicasJSON_it)) || (!ReplicasJSON_it.value().is_array())) {
+        return false;
+    }
+    for (nlohmann::json& ReplicaJSON : ReplicasJSON_it.value()) {
+        if (!ReplicaJSON.is_object()) {
+            return false;
+        }
+        SweepReplica Replica;
+        Handle.GetParInt("RandomSeed", Replica.RandomSeed, ReplicaJSON, true);
+
+        nlohmann::json::iterator PairsJSON_it;
+        if (Handle.FindPar("TimeNeuronPairs", PairsJSON_it, ReplicaJSON, true)) {
+            for (const auto& time_neuron_pair : PairsJSON_it.value()) {
+                if ((time_neuron_pair.size() < 2) || (!time_neuron_pair[0].is_number()) || (!time_neuron_pair[1].is_number())) {
+                    return false;
+                }
+                Replica.SpikeTimes.emplace_back(time_neuron_pair[0].template get<float>(), time_neuron_pair[1].template get<int>());
+            }
+        }
+
+        if (Handle.GetParFloat("SpikeIntervalMean_ms", Replica.SpontaneousMean_ms, ReplicaJSON, true)) {
+            if ((!Handle.GetParFloat("SpikeIntervalStDev_ms", Replica.SpontaneousStDev_ms, ReplicaJSON)) || (Replica.SpontaneousMean_ms < 0.0)) {
+                return false;
+            }
+            Handle.GetParVecInt("NeuronIDs", Replica.SpontaneousNeuronIDs, ReplicaJSON, true);
+        }
+
+        nlohmann::json::iterator StrengthsJSON_it;
+        if (Handle.FindPar("Strengths", StrengthsJSON_it, ReplicaJSON, true)) {
+            for (nlohmann::json& StrengthJSON : StrengthsJSON_it.value()) {
+                SweepStrength Strength;
+                Handle.GetParInt("PreSyn", Strength.PresynapticID, StrengthJSON, true);
+                Handle.GetParInt("PostSyn", Strength.PostsynapticID, StrengthJSON, true);
+                if (!Handle.GetParFloat("Conductance_nS", Strength.Conductance_nS, StrengthJSON)) {
+                    return false;
+                }
+                Replica.Strengths.push_back(Strength);
+            }
+        }
+
+        nlohmann::json::iterator EditsJSON_it;
+        if (Handle.FindPar("NeuronEdits", EditsJSON_it, ReplicaJSON, true)) {
+            for (nlohmann::json& EditJSON : EditsJSON_it.value()) {
+                SweepNeuronEdit NeuronEdit;
+                CoreStructs::LIFCNeuronStruct& C = NeuronEdit.Values;
+                CoreStructs::LIFCEdit& Edit = NeuronEdit.Edit;
+                Handle.GetParVecInt("NeuronIDs", NeuronEdit.NeuronIDs, EditJSON, true);
+                Edit.RestingPotential_mV = Handle.GetParFloat("RestingPotential_mV", C.RestingPotential_mV, EditJSON, true);
+                Edit.ResetPotential_mV = Handle.GetParFloat("ResetPotential_mV", C.ResetPotential_mV, EditJSON, true);
+                Edit.SpikeThreshold_mV = Handle.GetParFloat("SpikeThreshold_mV", C.SpikeThreshold_mV, EditJSON, true);
+                Edit.MembraneResistance_MOhm = Handle.GetParFloat("MembraneResistance_MOhm", C.MembraneResistance_MOhm, EditJSON, true);
+                Edit.MembraneCapacitance_pF = Handle.GetParFloat("MembraneCapacitance_pF", C.MembraneCapacitance_pF, EditJSON, true);
+                Edit.RefractoryPeriod_ms = Handle.GetParFloat("RefractoryPeriod_ms", C.RefractoryPeriod_ms, EditJSON, true);
+                Edit.SpikeDepolarization_mV = Handle.GetParFloat("SpikeDepolarization_mV", C.SpikeDepolarization_mV, EditJSON, true);
+                Replica.NeuronEdits.push_back(NeuronEdit);
+            }
+        }
+
+        if (Handle.HasError()) {
+            return false;
+        }
+        _Replicas.push_back(std::move(Replica));
+    }
+
+    return !Handle.HasError();
+}
+
+// The function that handles the request.
+void SimulationRPCInterface::SimulationRunSweepTask(API::ManagerTaskData & TaskData) {
+
+    API::HandlerData Handle(TaskData.InputData, Logger_, "Simulation/Sweep", &Simulations_, true, true);
+    std::vector<SweepReplica> Replicas;
+    SweepOptions Options;
+    if (!SweepFromRequest(Handle, Replicas, Options)) {
+        TaskData.SetStatus(API::ManagerTaskStatus::GeneralFailure);
+        return;
+    }
+
+    Logger_->Log("Running sweep of " + std::to_string(Replicas.size()) + " replicas of Simulation " + std::to_string(TaskData.InputSim->ID), 2);
+
+    SimulationSweep Sweep(Logger_);
+    std::string Error;
+    bool Prepared = Sweep.Prepare(*TaskData.InputSim, Error);
+
+    // The replicas run on their own copies, the simulation is free again.
+    TaskData.ReleaseInputSim();
+    if (!Prepared) {
+        Logger_->Log("Unable to prepare sweep: " + Error, 8);
+        TaskData.SetStatus(API::ManagerTaskStatus::GeneralFailure);
+        return;
+    }
+
+    std::vector<SweepSummary> Summaries = Sweep.Run(Replicas, Options, &TaskData.CancelRequested);
+
+    nlohmann::json ReplicasJSON = nlohmann::json::array();
+    for (const SweepSummary& Summary : Summaries) {
+        ReplicasJSON.push_back(Summary.GetJSON());
+    }
+    TaskData.OutputData["Replicas"] = std::move(ReplicasJSON);
+    TaskData.OutputData["NumWorkers"] = Sweep.GetNumWorkers();
+
+    if (TaskData.IsCancelled()) {
+        TaskData.SetStatus(API::ManagerTaskStatus::Cancelled);
+        return;
+    }
+    TaskData.SetStatus(API::ManagerTaskStatus::Success); // Signal task done
+}
+
+// The threadable function that calls the task handler above.
+void SimulationRunSweepTaskThread(SimulationRPCInterface* _Manager, API::ManagerTaskData* TaskData) {
+    if (!TaskData) return;
+    _Manager->SimulationRunSweepTask(*TaskData); // Run the rest back in the Manager for full context.
+    if (TaskData->InputSim) TaskData->InputSim->DecRunningManagedTasksCounter();
+}
+
+/**
+ * This runs replicas of a Simulation that differ in random seed, stimuli,
+ * spontaneous activity, connection strengths and LIFC neuron parameters.
+ * All replicas start from the current state of the Simulation, which is
+ * not changed. See SimulationSweep.h.
+ */
+std::string SimulationRPCInterface::SimulationRunSweep(std::string _JSONRequest) {
+    API::HandlerData Handle(_JSONRequest, Logger_, "Simulation/Sweep", &Simulations_, false, false); // false, false if applied to Simulation object
+    if (Handle.HasError()) {
+        return Handle.ErrResponse();
+    }
+
+    // Check the request now, so that mistakes are reported right away
+    std::vector<SweepReplica> Replicas;
+    SweepOptions Options;
+    if (!SweepFromRequest(Handle, Replicas, Options)) {
+        return Handle.ErrResponse(API::BGStatusCode::BGStatusInvalidParametersPassed);
+    }
+
+    // Prepare data structure for task
+    std::unique_ptr<API::ManagerTaskData> SimulationSweepTaskData = std::make_unique<API::ManagerTaskData>(API::SimulationSweepTask);
+    SimulationSweepTaskData->InputData = _JSONRequest;
+    SimulationSweepTaskData->InputSim = Handle.Sim();
+
+    // Keep runs off the simulation until the sweep has copied it
+    if (!SimulationSweepTaskData->ClaimInputSim()) {
+        return Handle.ErrResponse(API::BGStatusCode::BGStatusSimulationBusy);
+    }
+
+    // Add task with fresh task status and get task ID to be returned to requestor
+    int TaskID = AddManagerTask(SimulationSweepTaskData, SimulationRunSweepTaskThread);
+    if (TaskID<0) {
+        Logger_->Log("Unable to launch SimulationSweep Task", 8);
+        return Handle.ErrResponse(API::BGStatusCode::BGStatusGeneralFailure);
+    }
+
+    // Return Result ID
+    return Handle.ResponseWithID("TaskID", TaskID);
+}
+
+// The function that handles the request.
+void SimulationRPCInterface::SimulationCloneTask(API::ManagerTaskData & TaskData) {
+
+    Logger_->Log("Cloning Simulation " + std::to_string(TaskData.InputSim->ID), 2);
+
+    // Build the clone before it is added, so that no request sees it half done.
+    std::unique_ptr<Simulation> Clone = std::make_unique<Simulation>(Logger_);
+    Clone->Name = TaskData.InputData.empty() ? TaskData.InputSim->Name + " (clone)" : TaskData.InputData;
+    Clone->ID = -1;
+    Clone->CurrentTask = SIMULATION_NONE;
+    bool Cloned = TaskData.InputSim->CloneTo(*Clone);
+
+    // The clone has its own copy, the source is free again.
+    TaskData.ReleaseInputSim();
+    if (!Cloned) {
+        Logger_->Log("Failed to clone Simulation " + std::to_string(TaskData.InputSim->ID), 8);
+        TaskData.SetStatus(API::ManagerTaskStatus::GeneralFailure);
+        return;
+    }
+
+    size_t idx = Simulations_.append(std::move(Clone));
+    Simulation* Sim = Simulations_.read(idx);
+    assert(Sim != nullptr);
+    Sim->ID = idx;
+
+    // Start Thread
+    SimulationThreads_.append(std::make_unique<std::thread>(&SimulationEngineThread, Logger_, Sim, RenderPool_, VisualizerPool_, &StopThreads_));
+
+    TaskData.OutputData["SimulationID"] = Sim->ID;
+    Logger_->Log("Cloned Simulation " + std::to_string(TaskData.InputSim->ID) + " as " + std::to_string(Sim->ID), 3);
+
+    TaskData.SetStatus(API::ManagerTaskStatus::Success); // Signal task done
+}
+
+// The threadable function that calls the task handler above.
+void SimulationCloneTaskThread(SimulationRPCInterface* _Manager, API::ManagerTaskData* TaskData) {
+    if (!TaskData) return;
+    _Manager->SimulationCloneTask(*TaskData); // Run the rest back in the Manager for full context.
+    if (TaskData->InputSim) TaskData->InputSim->DecRunningManagedTasksCounter();
+}
+
+/**
+ * This makes an independent copy of a Simulation in memory, with its model,
+ * instruments and dynamic state, e.g. to branch a run into several stimulus
+ * conditions. The new SimulationID is in the output of the task.
+ */
+std::string SimulationRPCInterface::SimulationClone(std::string _JSONRequest) {
+    API::HandlerData Handle(_JSONRequest, Logger_, "Simulation/Clone", &Simulations_, false, false); // false, false if applied to Simulation object
+    if (Handle.HasError()) {
+        return Handle.ErrResponse();
+    }
+
+    // Prepare data structure for task
+    std::unique_ptr<API::ManagerTaskData> SimulationCloneTaskData = std::make_unique<API::ManagerTaskData>(API::SimulationCloneTask);
+
+    // Get the optional name of the clone
+    nlohmann::json::iterator NameIterator;
+    if (Handle.FindPar("Name", NameIterator, true)) {
+        if (!NameIterator.value().is_string()) {
+            return Handle.ErrResponse(API::BGStatusCode::BGStatusInvalidParametersPassed);
+        }
+        SimulationCloneTaskData->InputData = NameIterator.value().template get<std::string>();
+    }
+    SimulationCloneTaskData->InputSim = Handle.Sim();
+
+    // Keep runs off the simulation until it is copied
+    if (!SimulationCloneTaskData->ClaimInputSim()) {
+        return Handle.ErrResponse(API::BGStatusCode::BGStatusSimulationBusy);
+    }
+
+    // Add task with fresh task status and get task ID to be returned to requestor
+    int TaskID = AddManagerTask(SimulationCloneTaskData, SimulationCloneTaskThread);
+    if (TaskID<0) {
+        Logger_->Log("Unable to launch SimulationClone Task", 8);
+        return Handle.ErrResponse(API::BGStatusCode::BGStatusGeneralFailure);
+    }
+
+    // Return Result ID
+    return Handle.ResponseWithID("TaskID", TaskID);
+}
+
 std::string SimulationRPCInterface::SimulationGetGeoCenter(std::string _JSONRequest) {
  
     API::HandlerData Handle(_JSONRequest, Logger_, "Simulation/GetGeoCenter", &Simulations_);
@@ -1121,6 +2019,7 @@ std::string SimulationRPCInterface::AttachRecordingElectrodes(std::string _JSONR
         if (!Handle.GetParFloat("noise_level", E.NoiseLevel, ElectodeData)) {
             Handle.ErrResponse();
         }
+        Handle.GetParFloat("cutoff_distance_um", E.CutoffDistance_um, ElectodeData, true);
         nlohmann::json::iterator SitesIterator;
         if (!Handle.FindPar("sites", SitesIterator, ElectodeData)) {
             Handle.ErrResponse();
@@ -1304,9 +2203,140 @@ std::string SimulationRPCInterface::GetInstrumentRecordings(std::string _JSONReq
         return Handle.ErrResponse();
     }
 
+    // Polling clients pass the "cursor" and "Ca_cursor" of the previous response.
+    int Cursor = 0;
+    int CaCursor = 0;
+    Handle.GetParInt("Cursor", Cursor, true);
+    Handle.GetParInt("CaCursor", CaCursor, true);
+    if (Handle.HasError()) {
+        return Handle.ErrResponse();
+    }
+
+    // Return JSON
+    nlohmann::json ResponseJSON = Handle.Sim()->GetInstrumentsRecordingJSON(std::max(Cursor, 0), std::max(CaCursor, 0));
+    ResponseJSON["StatusCode"] = 0; // ok
+    return Handle.ResponseAndStoreRequest(ResponseJSON);
+}
+
+std::string SimulationRPCInterface::AddRecordingSink(std::string _JSONRequest) {
+ 
+    API::HandlerData Handle(_JSONRequest, Logger_, "Simulation/AddRecordingSink", &Simulations_);
+    if (Handle.HasError()) {
+        return Handle.ErrResponse();
+    }
+
+    std::string SinkName;
+    std::string VariableName;
+    if ((!Handle.GetParString("Name", SinkName)) || (!Handle.GetParString("Variable", VariableName))) {
+        return Handle.ErrResponse();
+    }
+    Tools::RecordingSinkVariable Variable;
+    if (!Tools::RecordingSinkVariableFromString(VariableName, Variable)) {
+        return Handle.ErrResponse(API::BGStatusCode::BGStatusInvalidParametersPassed);
+    }
+    std::vector<int> NeuronIDs; // empty means all neurons
+    int Decimation = 1;
+    int ChunkRows = 1024;
+    Handle.GetParVecInt("NeuronIDs", NeuronIDs, true);
+    Handle.GetParInt("Decimation", Decimation, true);
+    Handle.GetParInt("ChunkRows", ChunkRows, true);
+    if (Handle.HasError()) {
+        return Handle.ErrResponse();
+    }
+    if ((Decimation < 1) || (ChunkRows < 1)) {
+        return Handle.ErrResponse(API::BGStatusCode::BGStatusInvalidParametersPassed);
+    }
+
+    // Sink files are named by simulation ID, sink ID and creation time, the
+    // name is only a label. IDs restart after a server restart or reset, the
+    // time keeps earlier recordings from being reused.
+    Simulation* Sim = Handle.Sim();
+    std::string DirName = "Recordings/" + std::to_string(Sim->ID);
+    std::error_code Err;
+    std::filesystem::create_directories(DirName, Err);
+    int SinkID = Sim->RecordingSinks.size();
+    int64_t Created_ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+    std::string SinkHandle = std::to_string(Sim->ID) + "/Sink" + std::to_string(SinkID) + "-" + std::to_string(Created_ms) + ".bin";
+
+    std::unique_ptr<Tools::RecordingSink> Sink = std::make_unique<Tools::RecordingSink>(Variable, NeuronIDs, Decimation, ChunkRows);
+    Sink->ID = SinkID;
+    Sink->Name = SinkName;
+    if (!Sink->Open("Recordings/" + SinkHandle, Sim)) {
+        Logger_->Log("Unable to open recording sink " + SinkHandle + ", it exists or cannot be created", 6);
+        return Handle.ErrResponse(API::BGStatusCode::BGStatusInvalidParametersPassed);
+    }
+    Sim->RecordingSinks.emplace_back(std::move(Sink));
+
+    // Return Result ID
+    nlohmann::json ResponseJSON;
+    ResponseJSON["StatusCode"] = 0; // ok
+    ResponseJSON["SinkID"] = SinkID;
+    ResponseJSON["SinkHandle"] = SinkHandle;
+    return Handle.ResponseAndStoreRequest(ResponseJSON);
+}
+
+std::string SimulationRPCInterface::GetRecordingSinks(std::string _JSONRequest) {
+ 
+    API::HandlerData Handle(_JSONRequest, Logger_, "Simulation/GetRecordingSinks", &Simulations_, true);
+    if (Handle.HasError()) {
+        return Handle.ErrResponse();
+    }
+
+    nlohmann::json SinksJSON = nlohmann::json::array();
+    for (auto& Sink : Handle.Sim()->RecordingSinks) {
+        nlohmann::json SinkJSON;
+        SinkJSON["SinkID"] = Sink->ID;
+        SinkJSON["Name"] = Sink->Name;
+        SinkJSON["Variable"] = int(Sink->GetVariable());
+        SinkJSON["Decimation"] = Sink->GetDecimation();
+        SinkJSON["NeuronIDs"] = Sink->GetNeuronIDs();
+        SinkJSON["BytesWritten"] = Sink->GetBytesWritten();
+        nlohmann::json ChunksJSON = nlohmann::json::array();
+        for (const Tools::RecordingSinkChunk& Chunk : Sink->GetChunks()) {
+            ChunksJSON.push_back({ Chunk.Offset, Chunk.Bytes, Chunk.NumRows, Chunk.TFirst_ms, Chunk.TLast_ms });
+        }
+        SinkJSON["Chunks"] = ChunksJSON; // [offset, bytes, rows, t_first_ms, t_last_ms]
+        SinksJSON.push_back(SinkJSON);
+    }
+
     // Return JSON
-    nlohmann::json ResponseJSON = Handle.Sim()->GetInstrumentsRecordingJSON();
+    nlohmann::json ResponseJSON;
     ResponseJSON["StatusCode"] = 0; // ok
+    ResponseJSON["RecordingSinks"] = SinksJSON;
+    return Handle.ResponseAndStoreRequest(ResponseJSON);
+}
+
+std::string SimulationRPCInterface::GetRecordingSinkData(std::string _JSONRequest) {
+ 
+    API::HandlerData Handle(_JSONRequest, Logger_, "Simulation/GetRecordingSinkData", &Simulations_, true);
+    if (Handle.HasError()) {
+        return Handle.ErrResponse();
+    }
+
+    int SinkID = -1;
+    uint64_t Offset = 0;
+    uint64_t Length = 0;
+    if ((!Handle.GetParInt("SinkID", SinkID)) || (!Handle.GetParUInt64("Offset", Offset)) || (!Handle.GetParUInt64("Length", Length))) {
+        return Handle.ErrResponse();
+    }
+    if ((SinkID < 0) || (size_t(SinkID) >= Handle.Sim()->RecordingSinks.size())) {
+        return Handle.ErrResponse(API::BGStatusCode::BGStatusInvalidParametersPassed);
+    }
+
+    // Only flushed bytes can be read, this is safe while the simulation runs.
+    // Reads are limited to RecordingSink::MaxReadBytes, the response says how
+    // many bytes were returned.
+    std::string RawData;
+    if (!Handle.Sim()->RecordingSinks[SinkID]->ReadBytes(Offset, Length, RawData)) {
+        return Handle.ErrResponse(API::BGStatusCode::BGStatusInvalidParametersPassed);
+    }
+    std::string Base64Data = base64_encode(reinterpret_cast<const unsigned char*>(RawData.c_str()), RawData.length());
+
+    nlohmann::json ResponseJSON;
+    ResponseJSON["StatusCode"] = 0; // ok
+    ResponseJSON["Offset"] = Offset;
+    ResponseJSON["Length"] = RawData.size();
+    ResponseJSON["Data"] = Base64Data;
     return Handle.ResponseAndStoreRequest(ResponseJSON);
 }
 
@@ -1440,6 +2470,9 @@ void SimulationRPCInterface::SomethingTask(API::ManagerTaskData & TaskData) {
     // --> If there are outcomes that can be an error, incomplete, or undoable
     //     then use TaskData.SetStatus(API::ManagerTaskStatus::GeneralFailure);
     //     and return.
+
+    // --> In long loops, check TaskData.IsCancelled() and if it is set use
+    //     TaskData.SetStatus(API::ManagerTaskStatus::Cancelled); and return.
     Logger_->Log("Indicate something in the Log as needed", 3);
 
     TaskData.SetStatus(API::ManagerTaskStatus::Success); // Signal task done
@@ -34,6 +34,8 @@
 #include <Simulator/Structs/Neuron.h>
 #include <Simulator/Structs/PatchClampDAC.h>
 #include <Simulator/Structs/PatchClampADC.h>
+#include <Simulator/Structs/SaveTransfer.h>
+#include <Simulator/Structs/SimulationSweep.h>
 
 #include <VSDA/DebugHelpers/MeshBuilder.h>
 #include <VSDA/RenderPool.h>
@@ -43,6 +45,7 @@
 
 #include <RPC/RPCManager.h>
 #include <RPC/ManagerTaskData.h>
+#include <RPC/ManagedTaskExecutor.h>
 #include <RPC/RPCHandlerHelper.h>
 #include <RPC/RouteAndHandler.h>
 
@@ -84,9 +87,14 @@ private:
     int NextManTaskID = 0; /**Use this, because we use a map not a vector, so that we can expire some to shed old cached stuff*/
     std::mutex ManTaskMtx; // guards the dynamically allocated object holding ManagerTasks
     std::map<int, std::unique_ptr<API::ManagerTaskData>> ManagerTasks; /**Status data of launched tasks by Task ID*/
+    std::unique_ptr<API::ManagedTaskExecutor> TaskExecutor_; /**Worker pool that runs the tasks in ManagerTasks, stopped first on destruction*/
+
+    Tools::SaveTransfer SavedSimulationFiles_{"SavedSimulations/", ".NES"}; /**Chunked downloads and uploads of simulation saves*/
 
     bool ResourceChecksIncludeHeap = false; // See how this applies in GetResourceStatus().
 
+    std::string RunControl(std::string _JSONRequest, const std::string& _Route, bool (Simulation::*_Action)());
+
 
 public:
 
@@ -122,6 +130,10 @@ public:
     void DeleteResidentByIDTask(API::ManagerTaskData & TaskData);
     void SimulationSaveModelTask(API::ManagerTaskData & TaskData);
     void SimulationLoadModelTask(API::ManagerTaskData & TaskData);
+    void SimulationSaveCheckpointTask(API::ManagerTaskData & TaskData);
+    void SimulationLoadCheckpointTask(API::ManagerTaskData & TaskData);
+    void SimulationRunSweepTask(API::ManagerTaskData & TaskData);
+    void SimulationCloneTask(API::ManagerTaskData & TaskData);
     void GetConnectomeTask(API::ManagerTaskData & TaskData);
     void GetAbstractConnectomeTask(API::ManagerTaskData & TaskData);
 
@@ -144,16 +156,26 @@ public:
     std::string SimulationSetSeed(std::string _JSONRequest);
     std::string LIFCAbstractedFunctional(std::string _JSONRequest);
     std::string LIFCPreciseSpikeTimes(std::string _JSONRequest);
+    std::string LIFCRecursiveConductances(std::string _JSONRequest);
+    std::string SetLIFCStateArrays(std::string _JSONRequest);
+    std::string LIFCEventDrivenDelivery(std::string _JSONRequest);
     std::string SetSTDP(std::string _JSONRequest);
+    std::string SetParallelUpdate(std::string _JSONRequest);
 
     std::string SimulationRunFor(std::string _JSONRequest);
+    std::string SimulationRunProgress(std::string _JSONRequest);
+    std::string SimulationRunPause(std::string _JSONRequest);
+    std::string SimulationRunResume(std::string _JSONRequest);
+    std::string SimulationRunAbort(std::string _JSONRequest);
     std::string SimulationRecordAll(std::string _JSONRequest);
+    std::string SetRecordingRetention(std::string _JSONRequest);
 
     std::string SetPrePostStrength(std::string _JSONRequest);
     std::string SetAllStrength(std::string _JSONRequest);
     std::string BatchSetPrePostStrength(std::string _JSONRequest);
 
     std::string SimulationGetSpikeTimes(std::string _JSONRequest);
+    std::string SimulationGetSpikeRaster(std::string _JSONRequest);
     std::string SimulationGetRecording(std::string _JSONRequest);
     std::string SimulationGetStatus(std::string _JSONRequest);
     std::string SimulationGetGeoCenter(std::string _JSONRequest);
@@ -162,19 +184,32 @@ public:
     std::string AttachRecordingElectrodes(std::string _JSONRequest);
     std::string SetRecordInstruments(std::string _JSONRequest);
     std::string GetInstrumentRecordings(std::string _JSONRequest);
+    std::string AddRecordingSink(std::string _JSONRequest);
+    std::string GetRecordingSinks(std::string _JSONRequest);
+    std::string GetRecordingSinkData(std::string _JSONRequest);
 
     std::string SimulationSave(std::string _JSONRequest);
     std::string SimulationGetSave(std::string _JSONRequest);
+    std::string SimulationGetSaveInfo(std::string _JSONRequest);
+    std::string SimulationGetSaveChunk(std::string _JSONRequest);
+    std::string SimulationPutSaveChunk(std::string _JSONRequest);
+    std::string SimulationGetSaveUpload(std::string _JSONRequest);
+    std::string SimulationFinishSaveUpload(std::string _JSONRequest);
     std::string SimulationLoad(std::string _JSONRequest);
 
     std::string SimulationSaveModel(std::string _JSONRequest);
     std::string SimulationLoadModel(std::string _JSONRequest);
+    std::string SimulationSaveCheckpoint(std::string _JSONRequest);
+    std::string SimulationLoadCheckpoint(std::string _JSONRequest);
+    std::string SimulationRunSweep(std::string _JSONRequest);
+    std::string SimulationClone(std::string _JSONRequest);
 
     std::string GetSomaPositions(std::string _JSONRequest);
     std::string GetConnectome(std::string _JSONRequest);
     std::string GetAbstractConnectome(std::string _JSONRequest);
 
     std::string ManTaskStatus(std::string _JSONRequest);
+    std::string ManTaskCancel(std::string _JSONRequest);
 
     std::string CalciumImagingAttach(std::string _JSONRequest);
     std::string CalciumImagingShowVoxels(std::string _JSONRequest);
@@ -0,0 +1,108 @@
+//=================================================================//
+// This file is part of the BrainGenix-NES Neuron Emulation System //
+//=================================================================//
+
+/*
+    Description: This file provides unit tests comparing the recursive DoubleExpState with g_norm.
+    Additional Notes: None
+    Date Created: 2026-10-17
+*/
+
+#include <cmath>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <Simulator/Structs/Receptor.h>
+
+/**
+ * @brief Test class for unit tests for struct DoubleExpState.
+ *
+ * Spikes are appended to spike_times while stepping through time, the same
+ * way TAct_ms grows during a simulation, and the recursive state is compared
+ * against g_norm() at every step.
+ */
+
+struct DoubleExpStateTest : testing::Test {
+    BG::NES::Simulator::Connections::DoubleExpState testState;
+
+    float tau_rise = 0.5;
+    float tau_decay = 3.0;
+    float norm = 0.0;
+
+    float tol = 1e-3;
+
+    void SetUp() {
+        norm = BG::NES::Simulator::Connections::compute_normalization(tau_rise, tau_decay);
+    }
+
+    void TearDown() { return; }
+
+    // Steps from t_start to t_end with dt, adding spikes at the given times
+    // once they are reached, and returns the largest deviation from g_norm.
+    float MaxDeviation(std::vector<float> & spike_times, const std::vector<float> & spikes_to_add,
+                       float t_start, float t_end, float dt, float onset_delay) {
+        float max_dev = 0.0;
+        size_t next = 0;
+        for (float t = t_start; t < t_end; t += dt) {
+            while ((next < spikes_to_add.size()) && (spikes_to_add[next] <= t)) {
+                spike_times.push_back(spikes_to_add[next]);
+                next++;
+            }
+            float expected = BG::NES::Simulator::Connections::g_norm(t, spike_times, tau_rise, tau_decay, norm, onset_delay);
+            float got = testState.Update(t, spike_times, tau_rise, tau_decay, norm, onset_delay);
+            max_dev = std::max(max_dev, std::fabs(got - expected));
+        }
+        return max_dev;
+    }
+};
+
+TEST_F(DoubleExpStateTest, test_NoSpikes) {
+    std::vector<float> spike_times;
+    ASSERT_EQ(MaxDeviation(spike_times, {}, 0.0, 50.0, 0.1, 0.0), 0.0);
+    ASSERT_EQ(testState.Update(50.0, spike_times, tau_rise, tau_decay, norm, 0.0), 0.0);
+}
+
+TEST_F(DoubleExpStateTest, test_SingleSpike_PeakIsNormalized) {
+    std::vector<float> spike_times;
+    ASSERT_LT(MaxDeviation(spike_times, {2.0}, 0.0, 40.0, 0.05, 0.0), tol);
+
+    // The normalized conductance peaks at 1.0.
+    testState.Reset();
+    spike_times = {0.0};
+    float t_peak = (tau_rise * tau_decay) / (tau_decay - tau_rise) * log(tau_decay / tau_rise);
+    ASSERT_NEAR(testState.Update(t_peak, spike_times, tau_rise, tau_decay, norm, 0.0), 1.0, tol);
+}
+
+TEST_F(DoubleExpStateTest, test_Burst_OnsetDelay) {
+    std::vector<float> spike_times;
+    std::vector<float> burst = {1.0, 1.7, 2.3, 3.1, 3.6, 4.0, 20.0, 20.4, 35.25};
+    ASSERT_LT(MaxDeviation(spike_times, burst, 0.0, 100.0, 0.1, 1.3), tol);
+}
+
+TEST_F(DoubleExpStateTest, test_OffGridSpikeTimes) {
+    // Triangulated precise spike times do not fall on the time grid.
+    std::vector<float> spike_times;
+    std::vector<float> spikes = {0.37, 5.91, 6.02, 12.123, 12.999, 40.5};
+    ASSERT_LT(MaxDeviation(spike_times, spikes, 0.0, 80.0, 1.0, 0.45), tol);
+}
+
+TEST_F(DoubleExpStateTest, test_ChangingDt) {
+    std::vector<float> spike_times;
+    ASSERT_LT(MaxDeviation(spike_times, {1.0, 3.0}, 0.0, 10.0, 0.1, 0.5), tol);
+    ASSERT_LT(MaxDeviation(spike_times, {12.0, 12.5}, 10.0, 30.0, 0.25, 0.5), tol);
+}
+
+TEST_F(DoubleExpStateTest, test_RebuildFromHistory) {
+    std::vector<float> spike_times;
+    ASSERT_LT(MaxDeviation(spike_times, {1.0, 2.0, 8.0}, 0.0, 20.0, 0.1, 0.0), tol);
+
+    // Going back in time rebuilds the state from the full spike history.
+    std::vector<float> history = {1.0, 2.0, 8.0};
+    float expected = BG::NES::Simulator::Connections::g_norm(9.0, history, tau_rise, tau_decay, norm, 0.0);
+    ASSERT_NEAR(testState.Update(9.0, history, tau_rise, tau_decay, norm, 0.0), expected, tol);
+
+    // So does a spike history that was cleared.
+    std::vector<float> cleared;
+    ASSERT_EQ(testState.Update(10.0, cleared, tau_rise, tau_decay, norm, 0.0), 0.0);
+}
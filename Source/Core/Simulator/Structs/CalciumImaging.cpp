@@ -38,8 +38,13 @@ void CalciumImaging::Init(Simulation* _Sim, NES::VSDA::Calcium::CaMicroscopePara
     // InstantiateVoxelSpace();
     // InitializeDepthDimming();
     // InitializeProjectionCircles();
+    UseIncrementalFilter = _Params.UseIncrementalIndicatorFilter;
     InitializeFluorescenceKernel(_Sim, _Params);
-    InitializeFluorescingNeuronFIFOs(_Sim, _Params);
+    if (UseIncrementalFilter) {
+        InitializeFluorescingNeuronFilters(_Sim, _Params);
+    } else {
+        InitializeFluorescingNeuronFIFOs(_Sim, _Params);
+    }
     ImagingInterval_ms = _Params.ImagingInterval_ms;
 }
 
@@ -104,9 +109,13 @@ void CalciumImaging::InitializeFluorescenceKernel(Simulation* _Sim, NES::VSDA::C
 
 }
 
+// *** TODO: Set different FIFO sizes for different GCaMP types.
+float IndicatorFIFO_ms(NES::VSDA::Calcium::CaMicroscopeParameters & _Params) {
+    return 4.0 * (_Params.IndicatorRiseTime_ms + _Params.IndicatorDecayTime_ms);
+}
+
 void CalciumImaging::InitializeFluorescingNeuronFIFOs(Simulation* _Sim, NES::VSDA::Calcium::CaMicroscopeParameters & _Params) {
-    // *** TODO: Set different FIFO sizes for different GCaMP types.
-    float FIFO_ms = 4.0 * (_Params.IndicatorRiseTime_ms + _Params.IndicatorDecayTime_ms);
+    float FIFO_ms = IndicatorFIFO_ms(_Params);
     float FIFO_dt_ms = _Sim->Dt_ms;
     if (_Params.FlourescingNeuronIDs_.empty()) {
         // All neurons.
@@ -116,13 +125,36 @@ void CalciumImaging::InitializeFluorescingNeuronFIFOs(Simulation* _Sim, NES::VSD
 
     } else {
         // Specified neurons subset.
-        for (auto & neuron_id : _Params.FlourescingNeuronIDs_) if (neuron_id < _Sim->Neurons.size()) {
+        for (auto & neuron_id : _Params.FlourescingNeuronIDs_) if (static_cast<size_t>(neuron_id) < _Sim->Neurons.size()) {
             static_cast<BallAndStick::BSNeuron*>(_Sim->Neurons.at(neuron_id).get())->SetFIFO(FIFO_ms, FIFO_dt_ms, FluorescenceKernel.size());
         }
     }
 
 }
 
+/**
+ * Takes from the kernel of InitializeFluorescenceKernel() the entries that
+ * UpdateConvolvedFIFO() combines with the FIFO of InitializeFluorescingNeuronFIFOs()
+ * for a Ca sample, so that the filtered neurons record the same samples.
+ */
+void CalciumImaging::InitializeFluorescingNeuronFilters(Simulation* _Sim, NES::VSDA::Calcium::CaMicroscopeParameters & _Params) {
+    size_t FIFO_size = BallAndStick::BSNeuron::FIFOSize(IndicatorFIFO_ms(_Params), _Sim->Dt_ms);
+    IndicatorFilter.Init(FIFO_size, ReversedFluorescenceKernel, BallAndStick::BSNeuron::CaSampleOffset);
+    if (_Params.FlourescingNeuronIDs_.empty()) {
+        // All neurons.
+        for (auto & neuron_ptr : _Sim->Neurons) {
+            static_cast<BallAndStick::BSNeuron*>(neuron_ptr.get())->SetCaFilter(IndicatorFilter);
+        }
+
+    } else {
+        // Specified neurons subset.
+        for (auto & neuron_id : _Params.FlourescingNeuronIDs_) if (static_cast<size_t>(neuron_id) < _Sim->Neurons.size()) {
+            static_cast<BallAndStick::BSNeuron*>(_Sim->Neurons.at(neuron_id).get())->SetCaFilter(IndicatorFilter);
+        }
+    }
+
+}
+
 void CalciumImaging::Record(float t_ms, Simulation* Sim, NES::VSDA::Calcium::CaMicroscopeParameters& _Params) {
     assert(t_ms >= 0.0);
     // Check if we have reached the next sample time:
@@ -138,13 +170,22 @@ void CalciumImaging::Record(float t_ms, Simulation* Sim, NES::VSDA::Calcium::CaM
         for (size_t i = 0; i < Sim->Neurons.size(); i++) {
             std::shared_ptr<Simulator::CoreStructs::Neuron> ThisNeuron = Sim->Neurons[i];
             assert(ThisNeuron != nullptr);
-            static_cast<BallAndStick::BSNeuron*>(ThisNeuron.get())->UpdateConvolvedFIFO(ReversedFluorescenceKernel);
+            if (UseIncrementalFilter) {
+                static_cast<BallAndStick::BSNeuron*>(ThisNeuron.get())->RecordCaFilter();
+            } else {
+                static_cast<BallAndStick::BSNeuron*>(ThisNeuron.get())->UpdateConvolvedFIFO(ReversedFluorescenceKernel);
+            }
         }
 
     } else {
         // For specified fluorescing neurons set.
-        for (auto & neuron_id : _Params.FlourescingNeuronIDs_) if (neuron_id < Sim->Neurons.size()) {
-            static_cast<BallAndStick::BSNeuron*>(Sim->Neurons.at(neuron_id).get())->UpdateConvolvedFIFO(ReversedFluorescenceKernel);
+        for (auto & neuron_id : _Params.FlourescingNeuronIDs_) if (static_cast<size_t>(neuron_id) < Sim->Neurons.size()) {
+            BallAndStick::BSNeuron* ThisNeuron = static_cast<BallAndStick::BSNeuron*>(Sim->Neurons.at(neuron_id).get());
+            if (UseIncrementalFilter) {
+                ThisNeuron->RecordCaFilter();
+            } else {
+                ThisNeuron->UpdateConvolvedFIFO(ReversedFluorescenceKernel);
+            }
         }
     }
 
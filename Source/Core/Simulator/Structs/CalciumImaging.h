@@ -17,6 +17,7 @@
 
 // Internal Libraries (BG convention: use <> instead of "")
 #include <Simulator/Geometries/VecTools.h>
+#include <Simulator/Structs/SignalFunctions.h>
 
 #include <VSDA/Ca/VoxelSubsystem/Structs/CaMicroscopeParameters.h>
 
@@ -58,6 +59,14 @@ struct CalciumImaging {
     std::vector<float> FluorescenceKernel;
     std::vector<float> ReversedFluorescenceKernel;
     float max_pixel_contributions = 0.0;
+
+    // With CaMicroscopeParameters::UseIncrementalIndicatorFilter the neurons
+    // keep only the newest indicator inputs that enter a Ca sample and copy
+    // this filter, instead of keeping a FIFO that is convolved with the
+    // kernel at every sample. The samples are identical, at O(1) per update
+    // and BSNeuron::CaSampleOffset per sample instead of O(FIFO*kernel).
+    bool UseIncrementalFilter = false;
+    SignalFunctions::ConvolvedFIFOTap IndicatorFilter;
     // std::vector<float> image_dims_px; // *** or unsigned int?
     //??? image_t; // Image taken at time t.
     //std::vector<???> images;
@@ -67,6 +76,7 @@ struct CalciumImaging {
     // *** (in prototype:) voxelspace = []
 
     std::vector<float> TRecorded_ms{};
+    size_t NumDropped = 0; // Samples dropped from the front of TRecorded_ms and the neurons' CaSamples by the retention limit
     // size_t num_samples = 0;
 
     //! Constructors
@@ -82,6 +92,7 @@ struct CalciumImaging {
 
     void InitializeFluorescenceKernel(Simulation* _Sim, NES::VSDA::Calcium::CaMicroscopeParameters & _Params);
     void InitializeFluorescingNeuronFIFOs(Simulation* _Sim, NES::VSDA::Calcium::CaMicroscopeParameters & _Params);
+    void InitializeFluorescingNeuronFilters(Simulation* _Sim, NES::VSDA::Calcium::CaMicroscopeParameters & _Params);
 
     void Record(float t_ms, Simulation* Sim, NES::VSDA::Calcium::CaMicroscopeParameters& _Params);
 
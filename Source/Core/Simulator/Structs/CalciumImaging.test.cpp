@@ -0,0 +1,219 @@
+//=================================================================//
+// This file is part of the BrainGenix-NES Neuron Emulation System //
+//=================================================================//
+
+/*
+    Description: This file provides unit tests for the calcium imaging of neurons.
+    Additional Notes: None
+    Date Created: 2026-10-17
+*/
+
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <BG/Common/Logger/Logger.h>
+#include <Simulator/Geometries/Sphere.h>
+#include <Simulator/Structs/Simulation.h>
+#include <Simulator/Structs/RecordingElectrode.h>
+#include <Simulator/Structs/CalciumImaging.h>
+#include <Simulator/Structs/Checkpoint.h>
+#include <Simulator/BallAndStick/BSNeuron.h>
+
+#include <VSDA/Ca/VoxelSubsystem/Structs/CaData.h>
+
+
+/**
+ * @brief Test class for calcium imaging. Builds a randomly connected LIFC
+ * network with spontaneously active neurons, whose afterhyperpolarizations
+ * drive the calcium indicator.
+ */
+
+struct CalciumImagingTest : testing::Test {
+    BG::Common::Logger::LoggingSystem Logger;
+
+    static constexpr int NumNeurons = 12;
+    static constexpr int NumReceptors = 48;
+    static constexpr float T_ms = 200.0;
+
+    std::unique_ptr<BG::NES::Simulator::Simulation> MakeNetwork() {
+        using namespace BG::NES::Simulator;
+
+        auto Sim = std::make_unique<Simulation>(&Logger);
+        Sim->SetRandomSeed(3);
+        Sim->Dt_ms = 0.25;
+
+        std::vector<int> CompartmentIDs;
+        for (int i = 0; i < NumNeurons; i++) {
+            Geometries::Sphere S(Geometries::Vec3D(10.0*i, 0.0, 0.0), 2.0);
+            int ShapeID = Sim->AddSphere(S);
+
+            Compartments::LIFC C;
+            C.ShapeID = ShapeID;
+            C.RestingPotential_mV = -60.0;
+            C.ResetPotential_mV = -55.0;
+            C.SpikeThreshold_mV = -50.0;
+            C.MembraneResistance_MOhm = 100.0;
+            C.MembraneCapacitance_pF = 100.0;
+            C.AfterHyperpolarizationAmplitude_mV = 0.0;
+            CompartmentIDs.push_back(Sim->AddLIFCCompartment(C));
+
+            CoreStructs::LIFCNeuronStruct N;
+            N.RestingPotential_mV = -60.0;
+            N.ResetPotential_mV = -55.0;
+            N.SpikeThreshold_mV = -50.0;
+            N.MembraneResistance_MOhm = 100.0;
+            N.MembraneCapacitance_pF = 100.0;
+            N.RefractoryPeriod_ms = 2.0;
+            N.SpikeDepolarization_mV = 30.0;
+            N.UpdateMethod = CoreStructs::EXPEULER_CM;
+            N.ResetMethod = CoreStructs::TOVM;
+            N.AfterHyperpolarizationReversalPotential_mV = -90.0;
+            N.FastAfterHyperpolarizationRise_ms = 2.5;
+            N.FastAfterHyperpolarizationDecay_ms = 30.0;
+            N.FastAfterHyperpolarizationPeakConductance_nS = 3.0;
+            N.FastAfterHyperpolarizationMaxPeakConductance_nS = 10.0;
+            N.FastAfterHyperpolarizationHalfActConstant = 0.5;
+            N.SlowAfterHyperpolarizationRise_ms = 30.0;
+            N.SlowAfterHyperpolarizationDecay_ms = 300.0;
+            N.SlowAfterHyperpolarizationPeakConductance_nS = 1.0;
+            N.SlowAfterHyperpolarizationMaxPeakConductance_nS = 5.0;
+            N.SlowAfterHyperpolarizationHalfActConstant = 0.5;
+            N.AfterHyperpolarizationSaturationModel = CoreStructs::AHPCLIP;
+            N.FatigueThreshold = 300.0;
+            N.FatigueRecoveryTime_ms = 1000.0;
+            N.AfterDepolarizationReversalPotential_mV = -20.0;
+            N.AfterDepolarizationRise_ms = 20.0;
+            N.AfterDepolarizationDecay_ms = 200.0;
+            N.AfterDepolarizationPeakConductance_nS = 0.3;
+            N.AfterDepolarizationSaturationMultiplier = 2.0;
+            N.AfterDepolarizationRecoveryTime_ms = 300.0;
+            N.AfterDepolarizationDepletion = 0.3;
+            N.AfterDepolarizationSaturationModel = CoreStructs::ADPCLIP;
+            N.AdaptiveThresholdDiffPerSpike = 0.2;
+            N.AdaptiveTresholdRecoveryTime_ms = 50.0;
+            N.AdaptiveThresholdDiffPotential_mV = 10.0;
+            N.AdaptiveThresholdFloor_mV = -50.0;
+            N.AdaptiveThresholdFloorDeltaPerSpike_mV = 1.0;
+            N.AdaptiveThresholdFloorRecoveryTime_ms = 500.0;
+            N.SomaCompartmentIDs.push_back(CompartmentIDs.back());
+            Sim->AddLIFCNeuron(N);
+        }
+
+        std::mt19937 Generator(13);
+        std::uniform_int_distribution<int> Neuron(0, NumNeurons - 1);
+        for (int i = 0; i < NumReceptors; i++) {
+            Connections::LIFCReceptor R;
+            R.SourceCompartmentID = CompartmentIDs[Neuron(Generator)];
+            R.DestinationCompartmentID = CompartmentIDs[Neuron(Generator)];
+            bool Inhibitory = (i % 3) == 0;
+            R.ReversalPotential_mV = Inhibitory ? -70.0 : 0.0;
+            R.PSPRise_ms = 0.5;
+            R.PSPDecay_ms = 3.0;
+            R.PeakConductance_nS = Inhibitory ? 20.0 : 10.0;
+            R.Weight = 1.0;
+            R.OnsetDelay_ms = 1.0;
+            R.Neurotransmitter = Inhibitory ? Connections::GABA : Connections::AMPA;
+            R.STDP_Method = Connections::STDPNONE;
+            Sim->AddLIFCReceptor(R);
+        }
+
+        for (auto & Neuron : Sim->Neurons) {
+            Neuron->SetSpontaneousActivity(30.0, 10.0, Sim->MasterRandom_->UniformRandomInt());
+        }
+
+        return Sim;
+    }
+
+    void SetupMicroscope(BG::NES::Simulator::Simulation& _Sim, bool _Incremental, std::vector<int> _NeuronIDs) {
+        BG::NES::VSDA::Calcium::CaMicroscopeParameters& Params = _Sim.CaData_->Params_;
+        Params.FlourescingNeuronIDs_ = _NeuronIDs;
+        Params.IndicatorRiseTime_ms = 2.0;
+        Params.IndicatorDecayTime_ms = 10.0;
+        Params.IndicatorInterval_ms = 1.0;
+        Params.ImagingInterval_ms = 1.0;
+        Params.UseIncrementalIndicatorFilter = _Incremental;
+        _Sim.CaData_->State_ = BG::NES::VSDA::Calcium::CA_INIT_DONE;
+        _Sim.CaData_->CaImaging.Init(&_Sim, Params);
+        _Sim.SetRecordInstruments();
+    }
+
+    void ExpectSameCaSamples(BG::NES::Simulator::Simulation& _Convolved, BG::NES::Simulator::Simulation& _Incremental) {
+        using BG::NES::Simulator::BallAndStick::BSNeuron;
+        ASSERT_EQ(_Convolved.CaData_->CaImaging.TRecorded_ms, _Incremental.CaData_->CaImaging.TRecorded_ms);
+        for (int i = 0; i < NumNeurons; i++) {
+            auto ConvolvedNeuron = std::dynamic_pointer_cast<BSNeuron>(_Convolved.Neurons[i]);
+            auto IncrementalNeuron = std::dynamic_pointer_cast<BSNeuron>(_Incremental.Neurons[i]);
+            ASSERT_TRUE(ConvolvedNeuron && IncrementalNeuron);
+            ASSERT_EQ(ConvolvedNeuron->CaSamples, IncrementalNeuron->CaSamples) << "neuron " << i;
+        }
+    }
+
+    void TearDown() { return; }
+};
+
+TEST_F(CalciumImagingTest, test_Incremental_filter_matches_convolved_FIFO) {
+    for (std::vector<int> NeuronIDs : {std::vector<int>{}, std::vector<int>{1, 4, 5, 11}}) {
+        auto Convolved = MakeNetwork();
+        SetupMicroscope(*Convolved, false, NeuronIDs);
+        Convolved->RunFor(T_ms);
+
+        auto Incremental = MakeNetwork();
+        SetupMicroscope(*Incremental, true, NeuronIDs);
+        ASSERT_TRUE(std::dynamic_pointer_cast<BG::NES::Simulator::BallAndStick::BSNeuron>(Incremental->Neurons[1])->FIFO.empty());
+        Incremental->RunFor(T_ms);
+
+        ASSERT_GT(Convolved->TotalSpikes(), (unsigned long)NumNeurons);
+        ExpectSameCaSamples(*Convolved, *Incremental);
+
+        // The samples are not trivially zero.
+        size_t NumNonZero = 0;
+        for (auto & Neuron : Convolved->Neurons) {
+            for (float Sample : std::dynamic_pointer_cast<BG::NES::Simulator::BallAndStick::BSNeuron>(Neuron)->CaSamples) {
+                NumNonZero += (Sample != 0.0);
+            }
+        }
+        ASSERT_GT(NumNonZero, 100);
+    }
+}
+
+TEST_F(CalciumImagingTest, test_Incremental_filter_restores_from_checkpoint) {
+    auto Convolved = MakeNetwork();
+    SetupMicroscope(*Convolved, false, {});
+    Convolved->RunFor(2*T_ms);
+
+    auto First = MakeNetwork();
+    SetupMicroscope(*First, true, {});
+    First->RunFor(T_ms);
+    BG::NES::Simulator::Tools::CheckpointWriter Writer;
+    First->SaveState(Writer);
+
+    auto Restored = MakeNetwork();
+    SetupMicroscope(*Restored, true, {});
+    BG::NES::Simulator::Tools::CheckpointReader Reader(Writer.GetBuffer());
+    ASSERT_TRUE(Restored->LoadState(Reader));
+    Restored->RunFor(T_ms);
+
+    ExpectSameCaSamples(*Convolved, *Restored);
+}
+
+TEST_F(CalciumImagingTest, test_Clone_continues_imaging) {
+    for (bool Incremental : {false, true}) {
+        auto Source = MakeNetwork();
+        SetupMicroscope(*Source, Incremental, {0, 2, 3});
+        Source->RunFor(T_ms);
+
+        BG::NES::Simulator::Simulation Clone(&Logger);
+        ASSERT_TRUE(Source->CloneTo(Clone));
+        ASSERT_NE(Clone.CaData_->State_, BG::NES::VSDA::Calcium::CA_NOT_INITIALIZED);
+        ASSERT_EQ(Clone.CaData_->Params_.FlourescingNeuronIDs_, Source->CaData_->Params_.FlourescingNeuronIDs_);
+        ASSERT_EQ(Clone.CaData_->CaImaging.UseIncrementalFilter, Incremental);
+
+        Source->RunFor(T_ms);
+        Clone.RunFor(T_ms);
+        ExpectSameCaSamples(*Source, Clone);
+        ASSERT_GT(Clone.CaData_->CaImaging.TRecorded_ms.size(), size_t(T_ms));
+    }
+}
@@ -0,0 +1,66 @@
+#include <Simulator/Structs/Checkpoint.h>
+
+#include <fstream>
+
+
+namespace BG {
+namespace NES {
+namespace Simulator {
+namespace Tools {
+
+uint64_t CheckpointHash(const char* _Data, size_t _Size) {
+    uint64_t Hash = 0xCBF29CE484222325ull;
+    for (size_t i = 0; i < _Size; i++) {
+        Hash ^= uint8_t(_Data[i]);
+        Hash *= 0x100000001B3ull;
+    }
+    return Hash;
+}
+
+bool WriteCheckpointFile(const std::string& _Path, CheckpointHeader& _Header, const std::string& _Payload) {
+    _Header.PayloadBytes = _Payload.size();
+    _Header.PayloadHash = CheckpointHash(_Payload.data(), _Payload.size());
+
+    std::ofstream File(_Path, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!File.is_open()) {
+        return false;
+    }
+    File.write(reinterpret_cast<const char*>(&_Header), sizeof(CheckpointHeader));
+    File.write(_Payload.data(), _Payload.size());
+    File.close();
+    return File.good();
+}
+
+bool ReadCheckpointFile(const std::string& _Path, CheckpointHeader& _Header, std::string& _Payload) {
+    std::ifstream File(_Path, std::ios::in | std::ios::binary);
+    if (!File.is_open()) {
+        return false;
+    }
+
+    CheckpointHeader Expected;
+    File.read(reinterpret_cast<char*>(&_Header), sizeof(CheckpointHeader));
+    if ((!File.good()) || (std::memcmp(_Header.Magic, Expected.Magic, sizeof(Expected.Magic)) != 0) || (_Header.Version != Expected.Version)) {
+        return false;
+    }
+
+    // A corrupt or truncated header must not make us allocate more than the file holds.
+    std::streampos PayloadStart = File.tellg();
+    File.seekg(0, std::ios::end);
+    std::streamoff Remaining = File.tellg() - PayloadStart;
+    File.seekg(PayloadStart);
+    if ((!File.good()) || (Remaining < 0) || (_Header.PayloadBytes > uint64_t(Remaining))) {
+        return false;
+    }
+
+    _Payload.resize(_Header.PayloadBytes);
+    File.read(_Payload.data(), _Header.PayloadBytes);
+    if (!File.good()) {
+        return false;
+    }
+    return CheckpointHash(_Payload.data(), _Payload.size()) == _Header.PayloadHash;
+}
+
+}; // namespace Tools
+}; // namespace Simulator
+}; // namespace NES
+}; // namespace BG
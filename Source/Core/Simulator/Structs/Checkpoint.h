@@ -0,0 +1,181 @@
+//=================================================================//
+// This file is part of the BrainGenix-NES Neuron Emulation System //
+//=================================================================//
+
+/*
+    Description: This file provides the binary stream and file format of dynamic state checkpoints.
+    Additional Notes: None
+    Date Created: 2026-10-17
+*/
+
+#pragma once
+
+// Standard Libraries (BG convention: use <> instead of "")
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// Third-Party Libraries (BG convention: use <> instead of "")
+
+// Internal Libraries (BG convention: use <> instead of "")
+
+
+namespace BG {
+namespace NES {
+namespace Simulator {
+namespace Tools {
+
+/**
+ * @brief File layout of a checkpoint: CheckpointHeader followed by
+ * PayloadBytes of state written by Simulation::SaveState().
+ *
+ * The checkpoint only holds dynamic state. It is restored onto a simulation
+ * with the same model, e.g. one rebuilt with Simulation/Load or LoadModel,
+ * and the neuron and receptor counts are checked against the header.
+ */
+struct CheckpointHeader {
+    char Magic[8] = {'N', 'E', 'S', 'C', 'K', 'P', 'T', '\0'};
+    uint32_t Version = 2;     /**2: neuron classes ahead of the neuron states*/
+    int32_t SimNeuronClass = -1;
+    uint64_t NumNeurons = 0;
+    uint64_t NumLIFCReceptorData = 0;
+    uint64_t PayloadBytes = 0;
+    uint64_t PayloadHash = 0;   /**FNV-1a of the payload*/
+};
+
+uint64_t CheckpointHash(const char* _Data, size_t _Size);
+
+bool WriteCheckpointFile(const std::string& _Path, CheckpointHeader& _Header, const std::string& _Payload);
+bool ReadCheckpointFile(const std::string& _Path, CheckpointHeader& _Header, std::string& _Payload);
+
+/**
+ * @brief Appends values to a binary state buffer in native byte order.
+ *
+ * Only trivially copyable values are written directly. Containers are
+ * written as a uint64_t element count followed by their elements.
+ */
+class CheckpointWriter {
+
+private:
+
+    std::string Buffer_;
+
+public:
+
+    template <typename T>
+    void Put(const T& _Value) {
+        static_assert(std::is_trivially_copyable<T>::value, "Checkpoint values must be trivially copyable");
+        Buffer_.append(reinterpret_cast<const char*>(&_Value), sizeof(T));
+    }
+
+    template <typename T>
+    void PutVector(const std::vector<T>& _Values) {
+        static_assert(std::is_trivially_copyable<T>::value, "Checkpoint values must be trivially copyable");
+        Put<uint64_t>(_Values.size());
+        Buffer_.append(reinterpret_cast<const char*>(_Values.data()), sizeof(T) * _Values.size());
+    }
+
+    template <typename T>
+    void PutDeque(const std::deque<T>& _Values) {
+        Put<uint64_t>(_Values.size());
+        for (const T& Value : _Values) {
+            Put(Value);
+        }
+    }
+
+    void PutString(const std::string& _Value) {
+        Put<uint64_t>(_Value.size());
+        Buffer_.append(_Value);
+    }
+
+    const std::string& GetBuffer() const { return Buffer_; }
+    size_t Size() const { return Buffer_.size(); }
+
+};
+
+/**
+ * @brief Reads values written by CheckpointWriter from a buffer it does not
+ * own. Every Get returns false once the data ran out, after which Ok() stays
+ * false.
+ */
+class CheckpointReader {
+
+private:
+
+    const char* Data_ = nullptr;
+    size_t Size_ = 0;
+    size_t Pos_ = 0;
+    bool Ok_ = true;
+
+    bool Take(void* _Dst, size_t _Bytes) {
+        if ((!Ok_) || (_Bytes > (Size_ - Pos_))) {
+            Ok_ = false;
+            return false;
+        }
+        if (_Bytes > 0) {
+            std::memcpy(_Dst, Data_ + Pos_, _Bytes);
+        }
+        Pos_ += _Bytes;
+        return true;
+    }
+
+    bool GetCount(uint64_t& _Count, size_t _ElementSize) {
+        if (!Get(_Count)) return false;
+        if ((_ElementSize > 0) && (_Count > (Size_ - Pos_) / _ElementSize)) {
+            Ok_ = false;
+            return false;
+        }
+        return true;
+    }
+
+public:
+
+    CheckpointReader(const char* _Data, size_t _Size): Data_(_Data), Size_(_Size) {}
+    CheckpointReader(const std::string& _Buffer): Data_(_Buffer.data()), Size_(_Buffer.size()) {}
+
+    template <typename T>
+    bool Get(T& _Value) {
+        static_assert(std::is_trivially_copyable<T>::value, "Checkpoint values must be trivially copyable");
+        return Take(&_Value, sizeof(T));
+    }
+
+    template <typename T>
+    bool GetVector(std::vector<T>& _Values) {
+        static_assert(std::is_trivially_copyable<T>::value, "Checkpoint values must be trivially copyable");
+        uint64_t Count;
+        if (!GetCount(Count, sizeof(T))) return false;
+        _Values.resize(Count);
+        return Take(_Values.data(), sizeof(T) * Count);
+    }
+
+    template <typename T>
+    bool GetDeque(std::deque<T>& _Values) {
+        uint64_t Count;
+        if (!GetCount(Count, sizeof(T))) return false;
+        _Values.resize(Count);
+        for (T& Value : _Values) {
+            if (!Get(Value)) return false;
+        }
+        return true;
+    }
+
+    bool GetString(std::string& _Value) {
+        uint64_t Count;
+        if (!GetCount(Count, 1)) return false;
+        _Value.assign(Data_ + Pos_, Count);
+        Pos_ += Count;
+        return true;
+    }
+
+    bool Ok() const { return Ok_; }
+    bool AtEnd() const { return Pos_ == Size_; }
+
+};
+
+}; // namespace Tools
+}; // namespace Simulator
+}; // namespace NES
+}; // namespace BG
@@ -0,0 +1,379 @@
+//=================================================================//
+// This file is part of the BrainGenix-NES Neuron Emulation System //
+//=================================================================//
+
+/*
+    Description: This file provides unit tests for dynamic state checkpoints.
+    Additional Notes: None
+    Date Created: 2026-10-17
+*/
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <BG/Common/Logger/Logger.h>
+#include <Simulator/Geometries/Sphere.h>
+#include <Simulator/LIFCompartmental/LIFCNeuron.h>
+#include <Simulator/Structs/Checkpoint.h>
+#include <Simulator/Structs/Simulation.h>
+#include <Simulator/Structs/RecordingElectrode.h>
+#include <Simulator/Structs/CalciumImaging.h>
+#include <VSDA/Ca/VoxelSubsystem/Structs/CaData.h>
+
+
+/**
+ * @brief Test class for checkpoints. Builds a small LIFC network with
+ * spontaneously active neurons, so that the random generators, spike
+ * histories, conductance states and spikes in flight all carry state across
+ * the checkpoint. Optionally with STDP and with calcium imaging of all
+ * neurons, so that the weights and the Ca filters do too.
+ */
+
+struct CheckpointTest : testing::Test {
+    BG::Common::Logger::LoggingSystem Logger;
+
+    static constexpr int NumNeurons = 6;
+    static constexpr float T_ms = 200.0;
+    static constexpr float STDPInitialWeight = 0.5;
+
+    std::unique_ptr<BG::NES::Simulator::Simulation> MakeNetwork(bool _EventDriven) {
+        return MakeNetwork(_EventDriven, _EventDriven, false, false);
+    }
+
+    std::unique_ptr<BG::NES::Simulator::Simulation> MakeNetwork(bool _Recursive, bool _EventDriven, bool _STDP, bool _Calcium) {
+        using namespace BG::NES::Simulator;
+
+        auto Sim = std::make_unique<Simulation>(&Logger);
+        Sim->SetRandomSeed(42);
+        Sim->Dt_ms = 0.25; // Exact in binary, so that RunFor(T) twice takes the same steps as RunFor(2T)
+        Sim->use_recursive_conductances = _Recursive;
+        Sim->use_event_driven_delivery = _EventDriven;
+        Sim->STDP = _STDP;
+
+        std::vector<int> CompartmentIDs;
+        for (int i = 0; i < NumNeurons; i++) {
+            Geometries::Sphere S(Geometries::Vec3D(10.0*i, 0.0, 0.0), 2.0);
+            int ShapeID = Sim->AddSphere(S);
+
+            Compartments::LIFC C;
+            C.ShapeID = ShapeID;
+            C.RestingPotential_mV = -60.0;
+            C.ResetPotential_mV = -55.0;
+            C.SpikeThreshold_mV = -50.0;
+            C.MembraneResistance_MOhm = 100.0;
+            C.MembraneCapacitance_pF = 100.0;
+            C.AfterHyperpolarizationAmplitude_mV = 0.0;
+            CompartmentIDs.push_back(Sim->AddLIFCCompartment(C));
+
+            CoreStructs::LIFCNeuronStruct N;
+            N.RestingPotential_mV = -60.0;
+            N.ResetPotential_mV = -55.0;
+            N.SpikeThreshold_mV = -50.0;
+            N.MembraneResistance_MOhm = 100.0;
+            N.MembraneCapacitance_pF = 100.0;
+            N.RefractoryPeriod_ms = 2.0;
+            N.SpikeDepolarization_mV = 30.0;
+            N.UpdateMethod = CoreStructs::EXPEULER_CM;
+            N.ResetMethod = CoreStructs::TOVM;
+            N.AfterHyperpolarizationReversalPotential_mV = -90.0;
+            N.FastAfterHyperpolarizationRise_ms = 2.5;
+            N.FastAfterHyperpolarizationDecay_ms = 30.0;
+            N.FastAfterHyperpolarizationPeakConductance_nS = 3.0;
+            N.FastAfterHyperpolarizationMaxPeakConductance_nS = 10.0;
+            N.FastAfterHyperpolarizationHalfActConstant = 0.5;
+            N.SlowAfterHyperpolarizationRise_ms = 30.0;
+            N.SlowAfterHyperpolarizationDecay_ms = 300.0;
+            N.SlowAfterHyperpolarizationPeakConductance_nS = 1.0;
+            N.SlowAfterHyperpolarizationMaxPeakConductance_nS = 5.0;
+            N.SlowAfterHyperpolarizationHalfActConstant = 0.5;
+            N.AfterHyperpolarizationSaturationModel = CoreStructs::AHPCLIP;
+            N.FatigueThreshold = 300.0;
+            N.FatigueRecoveryTime_ms = 1000.0;
+            N.AfterDepolarizationReversalPotential_mV = -20.0;
+            N.AfterDepolarizationRise_ms = 20.0;
+            N.AfterDepolarizationDecay_ms = 200.0;
+            N.AfterDepolarizationPeakConductance_nS = 0.3;
+            N.AfterDepolarizationSaturationMultiplier = 2.0;
+            N.AfterDepolarizationRecoveryTime_ms = 300.0;
+            N.AfterDepolarizationDepletion = 0.3;
+            N.AfterDepolarizationSaturationModel = CoreStructs::ADPCLIP;
+            N.AdaptiveThresholdDiffPerSpike = 0.2;
+            N.AdaptiveTresholdRecoveryTime_ms = 50.0;
+            N.AdaptiveThresholdDiffPotential_mV = 10.0;
+            N.AdaptiveThresholdFloor_mV = -50.0;
+            N.AdaptiveThresholdFloorDeltaPerSpike_mV = 1.0;
+            N.AdaptiveThresholdFloorRecoveryTime_ms = 500.0;
+            N.SomaCompartmentIDs.push_back(CompartmentIDs.back());
+            Sim->AddLIFCNeuron(N);
+        }
+
+        // A ring with one strong synapse per neuron.
+        for (int i = 0; i < NumNeurons; i++) {
+            Connections::LIFCReceptor R;
+            R.SourceCompartmentID = CompartmentIDs[i];
+            R.DestinationCompartmentID = CompartmentIDs[(i+1) % NumNeurons];
+            R.ReversalPotential_mV = 0.0;
+            R.PSPRise_ms = 0.5;
+            R.PSPDecay_ms = 3.0;
+            R.PeakConductance_nS = 40.0;
+            R.Weight = 1.0;
+            R.OnsetDelay_ms = 1.5;
+            R.Neurotransmitter = Connections::AMPA;
+            if (_STDP) {
+                R.Weight = STDPInitialWeight; // STDP clamps the weights to [0, 1]
+                R.STDP_Method = Connections::STDPHEBBIAN;
+                R.STDP_A_pos = 0.1;
+                R.STDP_A_neg = 0.1;
+                R.STDP_Tau_pos = 20.0;
+                R.STDP_Tau_neg = 20.0;
+            }
+            Sim->AddLIFCReceptor(R);
+        }
+
+        for (auto & Neuron : Sim->Neurons) {
+            Neuron->SetSpontaneousActivity(20.0, 10.0, Sim->MasterRandom_->UniformRandomInt());
+        }
+
+        if (_Calcium) {
+            BG::NES::VSDA::Calcium::CaMicroscopeParameters& Params = Sim->CaData_->Params_;
+            for (int i = 0; i < NumNeurons; i++) {
+                Params.FlourescingNeuronIDs_.push_back(i);
+            }
+            Params.IndicatorRiseTime_ms = 2.0;
+            Params.IndicatorDecayTime_ms = 10.0;
+            Params.IndicatorInterval_ms = 1.0;
+            Params.ImagingInterval_ms = 1.0;
+            Sim->CaData_->State_ = BG::NES::VSDA::Calcium::CA_INIT_DONE;
+            Sim->CaData_->CaImaging.Init(Sim.get(), Params);
+            Sim->SetRecordInstruments();
+        }
+
+        return Sim;
+    }
+
+    void TearDown() { return; }
+};
+
+TEST_F(CheckpointTest, test_ReaderWriter_roundtrip) {
+    BG::NES::Simulator::Tools::CheckpointWriter Writer;
+    Writer.Put<float>(1.5);
+    Writer.PutVector(std::vector<float>{1.0, 2.0, 3.0});
+    Writer.PutDeque(std::deque<float>{4.0, 5.0});
+    Writer.PutString("state");
+
+    BG::NES::Simulator::Tools::CheckpointReader Reader(Writer.GetBuffer());
+    float Value;
+    std::vector<float> Vector;
+    std::deque<float> Deque;
+    std::string String;
+    ASSERT_TRUE(Reader.Get(Value));
+    ASSERT_TRUE(Reader.GetVector(Vector));
+    ASSERT_TRUE(Reader.GetDeque(Deque));
+    ASSERT_TRUE(Reader.GetString(String));
+    ASSERT_TRUE(Reader.AtEnd());
+    ASSERT_EQ(Value, 1.5);
+    ASSERT_EQ(Vector, (std::vector<float>{1.0, 2.0, 3.0}));
+    ASSERT_EQ(Deque, (std::deque<float>{4.0, 5.0}));
+    ASSERT_EQ(String, "state");
+
+    // Reading past the end fails and keeps failing.
+    ASSERT_FALSE(Reader.Get(Value));
+    ASSERT_FALSE(Reader.Ok());
+
+    // A truncated buffer cannot claim more elements than it holds.
+    std::string Truncated = Writer.GetBuffer().substr(0, sizeof(float) + sizeof(uint64_t) + sizeof(float));
+    BG::NES::Simulator::Tools::CheckpointReader Short(Truncated);
+    ASSERT_TRUE(Short.Get(Value));
+    ASSERT_FALSE(Short.GetVector(Vector));
+    ASSERT_FALSE(Short.Ok());
+}
+
+TEST_F(CheckpointTest, test_Restore_continues_exactly) {
+    struct Variant { bool Recursive; bool EventDriven; bool STDP; bool Calcium; };
+    std::vector<Variant> Variants;
+    for (int Conductances = 0; Conductances < 3; Conductances++) {
+        for (bool STDP : {false, true}) {
+            for (bool Calcium : {false, true}) {
+                Variants.push_back({Conductances > 0, Conductances > 1, STDP, Calcium});
+            }
+        }
+    }
+
+    for (auto & V : Variants) {
+        std::string Name = "recursive " + std::to_string(V.Recursive) + ", event driven " + std::to_string(V.EventDriven)
+                         + ", STDP " + std::to_string(V.STDP) + ", calcium " + std::to_string(V.Calcium);
+
+        // Reference: run 2T without interruption.
+        auto Reference = MakeNetwork(V.Recursive, V.EventDriven, V.STDP, V.Calcium);
+        Reference->RunFor(2*T_ms);
+
+        // Run T, checkpoint, restore onto a fresh copy of the model, run T.
+        auto First = MakeNetwork(V.Recursive, V.EventDriven, V.STDP, V.Calcium);
+        First->RunFor(T_ms);
+        BG::NES::Simulator::Tools::CheckpointWriter Writer;
+        First->SaveState(Writer);
+
+        auto Restored = MakeNetwork(V.Recursive, V.EventDriven, V.STDP, V.Calcium);
+        BG::NES::Simulator::Tools::CheckpointReader Reader(Writer.GetBuffer());
+        ASSERT_TRUE(Restored->LoadState(Reader)) << Name;
+        ASSERT_TRUE(Reader.AtEnd()) << Name;
+        ASSERT_EQ(Restored->T_ms, First->T_ms) << Name;
+        Restored->RunFor(T_ms);
+
+        ASSERT_EQ(Reference->T_ms, Restored->T_ms) << Name;
+        ASSERT_GT(Reference->TotalSpikes(), First->TotalSpikes()) << Name;
+        for (int i = 0; i < NumNeurons; i++) {
+            auto & RefNeuron = *static_cast<BG::NES::Simulator::LIFCNeuron*>(Reference->Neurons[i].get());
+            auto & RestoredNeuron = *static_cast<BG::NES::Simulator::LIFCNeuron*>(Restored->Neurons[i].get());
+            ASSERT_EQ(RefNeuron.TAct_ms, RestoredNeuron.TAct_ms) << "neuron " << i << ", " << Name;
+            ASSERT_EQ(RefNeuron.Vm_mV, RestoredNeuron.Vm_mV) << "neuron " << i << ", " << Name;
+            ASSERT_EQ(RefNeuron.CaSamples, RestoredNeuron.CaSamples) << "neuron " << i << ", " << Name;
+            if (V.Calcium) {
+                ASSERT_FALSE(RestoredNeuron.CaSamples.empty()) << "neuron " << i << ", " << Name;
+            }
+        }
+        ASSERT_EQ(Reference->CaData_->CaImaging.TRecorded_ms, Restored->CaData_->CaImaging.TRecorded_ms) << Name;
+
+        bool WeightsChanged = false;
+        for (size_t r = 0; r < Reference->LIFCReceptorDataVec.size(); r++) {
+            float RefWeight = Reference->LIFCReceptorDataVec[r]->weight;
+            ASSERT_EQ(RefWeight, Restored->LIFCReceptorDataVec[r]->weight) << "receptor " << r << ", " << Name;
+            WeightsChanged = WeightsChanged || (RefWeight != (V.STDP ? STDPInitialWeight : 1.0f));
+        }
+        ASSERT_EQ(WeightsChanged, V.STDP) << Name;
+    }
+}
+
+TEST_F(CheckpointTest, test_LoadState_rejects_other_model) {
+    auto Source = MakeNetwork(false);
+    Source->RunFor(10.0);
+    BG::NES::Simulator::Tools::CheckpointWriter Writer;
+    Source->SaveState(Writer);
+
+    BG::NES::Simulator::Simulation Empty(&Logger);
+    BG::NES::Simulator::Tools::CheckpointReader Reader(Writer.GetBuffer());
+    ASSERT_FALSE(Empty.LoadState(Reader));
+    ASSERT_EQ(Empty.T_ms, 0.0);
+}
+
+TEST_F(CheckpointTest, test_LoadState_rejected_leaves_simulation_unchanged) {
+    auto Source = MakeNetwork(true);
+    Source->RunFor(20.0);
+    BG::NES::Simulator::Tools::CheckpointWriter Writer;
+    Source->SaveState(Writer);
+
+    // The class of the last neuron follows the four counts and the other classes.
+    std::string Buffer = Writer.GetBuffer();
+    size_t ClassOffset = 4*sizeof(uint64_t) + (NumNeurons-1)*sizeof(int32_t);
+    int32_t OtherClass = -1;
+    std::memcpy(&Buffer[ClassOffset], &OtherClass, sizeof(int32_t));
+
+    auto Target = MakeNetwork(false);
+    Target->RunFor(5.0);
+    std::vector<float> Vm_mV;
+    for (auto & Neuron : Target->Neurons) Vm_mV.push_back(static_cast<BG::NES::Simulator::LIFCNeuron*>(Neuron.get())->Vm_mV);
+    std::string RandomState = Target->MasterRandom_->GetState();
+
+    BG::NES::Simulator::Tools::CheckpointReader Reader(Buffer);
+    ASSERT_FALSE(Target->LoadState(Reader));
+    ASSERT_EQ(Target->T_ms, 5.0);
+    ASSERT_FALSE(Target->use_recursive_conductances);
+    ASSERT_FALSE(Target->use_event_driven_delivery);
+    ASSERT_EQ(Target->MasterRandom_->GetState(), RandomState);
+    for (int i = 0; i < NumNeurons; i++) {
+        ASSERT_EQ(static_cast<BG::NES::Simulator::LIFCNeuron*>(Target->Neurons[i].get())->Vm_mV, Vm_mV[i]) << "neuron " << i;
+    }
+}
+
+TEST_F(CheckpointTest, test_ReadCheckpointFile_rejects_oversized_payload) {
+    std::string Path = testing::TempDir() + "CheckpointTest_oversized.ckpt";
+    BG::NES::Simulator::Tools::CheckpointHeader Header;
+    ASSERT_TRUE(BG::NES::Simulator::Tools::WriteCheckpointFile(Path, Header, std::string(64, 'x')));
+
+    // Truncated: the header claims more than the file holds.
+    std::filesystem::resize_file(Path, sizeof(Header) + 32);
+    std::string Payload;
+    ASSERT_FALSE(BG::NES::Simulator::Tools::ReadCheckpointFile(Path, Header, Payload));
+    ASSERT_TRUE(Payload.empty());
+
+    // Corrupt: the header claims far more than any file holds.
+    Header.PayloadBytes = uint64_t(1) << 62;
+    {
+        std::ofstream File(Path, std::ios::out | std::ios::binary | std::ios::trunc);
+        File.write(reinterpret_cast<const char*>(&Header), sizeof(Header));
+    }
+    ASSERT_FALSE(BG::NES::Simulator::Tools::ReadCheckpointFile(Path, Header, Payload));
+    ASSERT_TRUE(Payload.empty());
+    std::filesystem::remove(Path);
+}
+
+TEST_F(CheckpointTest, test_Clone_continues_like_the_source) {
+    auto Source = MakeNetwork(true);
+    Source->RunFor(T_ms);
+
+    BG::NES::Simulator::Simulation Clone(&Logger);
+    ASSERT_TRUE(Source->CloneTo(Clone));
+    ASSERT_EQ(Clone.T_ms, Source->T_ms);
+    ASSERT_EQ(Clone.Neurons.size(), Source->Neurons.size());
+    ASSERT_EQ(Clone.LIFCReceptorDataVec.size(), Source->LIFCReceptorDataVec.size());
+
+    // Receptor data of the clone points at the clone's own neurons and receptors.
+    for (size_t i = 0; i < Clone.LIFCReceptorDataVec.size(); i++) {
+        auto & RData = *Clone.LIFCReceptorDataVec[i];
+        ASSERT_EQ(RData.SrcNeuronPtr, Clone.Neurons.at(RData.SrcNeuronID).get());
+        ASSERT_EQ(RData.DstNeuronPtr, Clone.Neurons.at(RData.DstNeuronID).get());
+        ASSERT_NE(RData.SrcNeuronPtr, Source->LIFCReceptorDataVec[i]->SrcNeuronPtr);
+        for (size_t r = 0; r < RData.ReceptorIDs.size(); r++) {
+            ASSERT_EQ(RData.ReceptorPtrs[r], Clone.LIFCReceptors.at(RData.ReceptorIDs[r]).get());
+        }
+    }
+
+    // Same inputs, same spikes.
+    Source->RunFor(T_ms);
+    Clone.RunFor(T_ms);
+    ASSERT_EQ(Clone.T_ms, Source->T_ms);
+    for (int i = 0; i < NumNeurons; i++) {
+        ASSERT_EQ(Clone.Neurons[i]->TAct_ms, Source->Neurons[i]->TAct_ms) << "neuron " << i;
+    }
+}
+
+TEST_F(CheckpointTest, test_Clone_diverges_only_with_other_inputs) {
+    auto Reference = MakeNetwork(false);
+    Reference->RunFor(2*T_ms);
+
+    auto Source = MakeNetwork(false);
+    Source->RunFor(T_ms);
+    BG::NES::Simulator::Simulation Clone(&Logger);
+    ASSERT_TRUE(Source->CloneTo(Clone));
+
+    // A stimulus given to the clone only changes the clone.
+    Clone.Neurons[0]->AddSpecificAPTime(T_ms + 3.0);
+    Clone.RunFor(T_ms);
+    Source->RunFor(T_ms);
+
+    bool Diverged = false;
+    for (int i = 0; i < NumNeurons; i++) {
+        ASSERT_EQ(Source->Neurons[i]->TAct_ms, Reference->Neurons[i]->TAct_ms) << "neuron " << i;
+        Diverged = Diverged || (Clone.Neurons[i]->TAct_ms != Source->Neurons[i]->TAct_ms);
+    }
+    ASSERT_TRUE(Diverged);
+}
+
+TEST_F(CheckpointTest, test_Clone_rejects_BS_model) {
+    using namespace BG::NES::Simulator;
+
+    Simulation Source(&Logger);
+    Geometries::Sphere S(Geometries::Vec3D(0.0, 0.0, 0.0), 2.0);
+    Compartments::BS C;
+    C.ShapeID = Source.AddSphere(S);
+    ASSERT_EQ(Source.AddSCCompartment(C, BSNEURONS), 0);
+
+    Simulation Clone(&Logger);
+    ASSERT_FALSE(Source.CloneTo(Clone));
+}
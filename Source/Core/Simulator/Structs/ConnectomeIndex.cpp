@@ -0,0 +1,102 @@
+#include <Simulator/Structs/ConnectomeIndex.h>
+
+#include <algorithm>
+
+
+namespace BG {
+namespace NES {
+namespace Simulator {
+namespace CoreStructs {
+
+
+
+void ConnectomeIndex::Build(const std::vector<std::unique_ptr<LIFCReceptorData>>& _ReceptorData, size_t _NumNeurons) {
+    std::lock_guard<std::mutex> Lock(BuildMutex_);
+    if (Built_) return;
+
+    // Two stable counting sorts, first by postsynaptic and then by presynaptic
+    // neuron, give (pre, post) order while keeping the creation order of
+    // entries within a pair.
+    std::vector<size_t> PostStart(_NumNeurons + 1, 0);
+    for (auto& RData : _ReceptorData) {
+        PostStart[RData->DstNeuronID + 1]++;
+    }
+    for (size_t i = 0; i < _NumNeurons; i++) {
+        PostStart[i + 1] += PostStart[i];
+    }
+    std::vector<LIFCReceptorData*> ByPost(_ReceptorData.size());
+    {
+        std::vector<size_t> Next(PostStart.begin(), PostStart.end() - 1);
+        for (auto& RData : _ReceptorData) {
+            ByPost[Next[RData->DstNeuronID]++] = RData.get();
+        }
+    }
+
+    RowStart_.assign(_NumNeurons + 1, 0);
+    for (auto* RData : ByPost) {
+        RowStart_[RData->SrcNeuronID + 1]++;
+    }
+    for (size_t i = 0; i < _NumNeurons; i++) {
+        RowStart_[i + 1] += RowStart_[i];
+    }
+    Entries_.resize(ByPost.size());
+    {
+        std::vector<size_t> Next(RowStart_.begin(), RowStart_.end() - 1);
+        for (auto* RData : ByPost) {
+            ConnectomeEntry& Entry = Entries_[Next[RData->SrcNeuronID]++];
+            Entry.PreID = RData->SrcNeuronID;
+            Entry.PostID = RData->DstNeuronID;
+            Entry.Type = RData->Type();
+            Entry.g_peak_sum_nS = RData->g_peak_sum_nS;
+            Entry.NumReceptors = RData->ReceptorPtrs.size();
+            Entry.Receptor = RData;
+        }
+    }
+
+    // The postsynaptic order above also orders the plastic inputs.
+    PlasticInputs_.clear();
+    PlasticStart_.assign(_NumNeurons + 1, 0);
+    for (auto* RData : ByPost) {
+        if (RData->STDP_Method() != Connections::STDPNONE) {
+            PlasticInputs_.push_back(RData);
+            PlasticStart_[RData->DstNeuronID + 1]++;
+        }
+    }
+    for (size_t i = 0; i < _NumNeurons; i++) {
+        PlasticStart_[i + 1] += PlasticStart_[i];
+    }
+
+    Built_ = true;
+}
+
+ConnectomeRange<const ConnectomeEntry> ConnectomeIndex::GetEntries() const {
+    return { Entries_.data(), Entries_.data() + Entries_.size() };
+}
+
+ConnectomeRange<const ConnectomeEntry> ConnectomeIndex::GetOutgoing(int _PreID) const {
+    if ((_PreID < 0) || (size_t(_PreID) >= GetNumNeurons())) return {};
+    return { Entries_.data() + RowStart_[_PreID], Entries_.data() + RowStart_[_PreID + 1] };
+}
+
+ConnectomeRange<const ConnectomeEntry> ConnectomeIndex::GetPair(int _PreID, int _PostID) const {
+    ConnectomeRange<const ConnectomeEntry> Row = GetOutgoing(_PreID);
+    const ConnectomeEntry* First = std::lower_bound(Row.begin(), Row.end(), _PostID, [](const ConnectomeEntry& _Entry, int _ID) {
+        return _Entry.PostID < _ID;
+    });
+    const ConnectomeEntry* Last = std::upper_bound(First, Row.end(), _PostID, [](int _ID, const ConnectomeEntry& _Entry) {
+        return _ID < _Entry.PostID;
+    });
+    return { First, Last };
+}
+
+ConnectomeRange<LIFCReceptorData* const> ConnectomeIndex::GetPlasticInputs(int _PostID) const {
+    if ((_PostID < 0) || (size_t(_PostID) >= GetNumNeurons())) return {};
+    return { PlasticInputs_.data() + PlasticStart_[_PostID], PlasticInputs_.data() + PlasticStart_[_PostID + 1] };
+}
+
+
+
+}; // Close Namespace CoreStructs
+}; // Close Namespace Simulator
+}; // Close Namespace NES
+}; // Close Namespace BG
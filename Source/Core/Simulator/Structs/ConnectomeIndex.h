@@ -0,0 +1,147 @@
+//=================================================================//
+// This file is part of the BrainGenix-NES Neuron Emulation System //
+//=================================================================//
+
+/*
+    Description: This file provides the CSR/CSC index over the abstracted LIFC receptor connectome.
+    Additional Notes: None
+    Date Created: 2026-10-17
+*/
+
+#pragma once
+
+// Standard Libraries (BG convention: use <> instead of "")
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Third-Party Libraries (BG convention: use <> instead of "")
+
+// Internal Libraries (BG convention: use <> instead of "")
+#include <Simulator/Structs/Neuron.h>
+
+
+namespace BG {
+namespace NES {
+namespace Simulator {
+namespace CoreStructs {
+
+
+/**
+ * @brief One abstracted functional receptor connection in the index.
+ *
+ * Weights change during simulation (STDP, strength updates), so they are
+ * read through Receptor and are never stale. Everything else only changes
+ * while the model is built, which invalidates the index.
+ */
+struct ConnectomeEntry {
+    int PreID = -1;                                    /**Presynaptic neuron index*/
+    int PostID = -1;                                   /**Postsynaptic neuron index*/
+    Connections::NeurotransmitterType Type;            /**Neurotransmitter of the receptors*/
+    float g_peak_sum_nS = 0.0;                         /**Sum of the peak conductances*/
+    size_t NumReceptors = 0;                           /**Number of receptors abstracted by Receptor*/
+    LIFCReceptorData* Receptor = nullptr;
+
+    float Weight() const { return Receptor->weight; }
+};
+
+
+/**
+ * @brief Contiguous view of a range of index entries.
+ */
+template <typename T>
+struct ConnectomeRange {
+    T* First = nullptr;
+    T* Last = nullptr;
+
+    T* begin() const { return First; }
+    T* end() const { return Last; }
+    size_t size() const { return size_t(Last - First); }
+    bool empty() const { return First == Last; }
+};
+
+
+/**
+ * @brief Compressed sparse row/column index of Simulation::LIFCReceptorDataVec.
+ *
+ * Entries are stored in CSR order, sorted by presynaptic and then by
+ * postsynaptic neuron. Entries of the same pair keep their creation order,
+ * which is also their order in LIFCNeuron::LIFCReceptorDataVec. The CSC
+ * side lists the receptors with STDP of every postsynaptic neuron, which
+ * is all that the STDP update on a postsynaptic spike needs.
+ *
+ * The index is built on first use after the model was changed, so building
+ * a model stays O(1) per receptor. Queries on a stale index are not
+ * allowed, call Build() (or Simulation::GetConnectomeIndex()) first.
+ */
+class ConnectomeIndex {
+
+private:
+
+    std::vector<ConnectomeEntry> Entries_;              /**CSR ordered entries*/
+    std::vector<size_t> RowStart_;                      /**Offset of the first entry of every presynaptic neuron, size N+1*/
+    std::vector<LIFCReceptorData*> PlasticInputs_;      /**CSC ordered receptors with STDP*/
+    std::vector<size_t> PlasticStart_;                  /**Offset of the first plastic receptor of every postsynaptic neuron, size N+1*/
+
+    std::atomic<bool> Built_ = false;
+    std::mutex BuildMutex_;
+
+public:
+
+    /**
+     * @brief Marks the index as stale. Call this whenever receptors or
+     * neurons are added.
+     */
+    void Invalidate() { Built_ = false; }
+
+    bool IsBuilt() const { return Built_; }
+
+    /**
+     * @brief Rebuilds the index from the given receptor data if it is stale.
+     * Safe to call from several threads.
+     *
+     * @param _ReceptorData
+     * @param _NumNeurons
+     */
+    void Build(const std::vector<std::unique_ptr<LIFCReceptorData>>& _ReceptorData, size_t _NumNeurons);
+
+    size_t GetNumNeurons() const { return RowStart_.empty() ? 0 : RowStart_.size() - 1; }
+    size_t GetNumEntries() const { return Entries_.size(); }
+
+    /**
+     * @brief Returns all entries in CSR order.
+     */
+    ConnectomeRange<const ConnectomeEntry> GetEntries() const;
+
+    /**
+     * @brief Returns the outgoing connections of a presynaptic neuron,
+     * sorted by postsynaptic neuron.
+     *
+     * @param _PreID
+     */
+    ConnectomeRange<const ConnectomeEntry> GetOutgoing(int _PreID) const;
+
+    /**
+     * @brief Returns the entries between a pair of neurons, in creation order.
+     *
+     * @param _PreID
+     * @param _PostID
+     */
+    ConnectomeRange<const ConnectomeEntry> GetPair(int _PreID, int _PostID) const;
+
+    /**
+     * @brief Returns the incoming receptors with STDP of a postsynaptic neuron.
+     *
+     * @param _PostID
+     */
+    ConnectomeRange<LIFCReceptorData* const> GetPlasticInputs(int _PostID) const;
+
+};
+
+
+}; // Close Namespace CoreStructs
+}; // Close Namespace Simulator
+}; // Close Namespace NES
+}; // Close Namespace BG
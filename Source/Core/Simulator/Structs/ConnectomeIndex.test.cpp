@@ -0,0 +1,277 @@
+//=================================================================//
+// This file is part of the BrainGenix-NES Neuron Emulation System //
+//=================================================================//
+
+/*
+    Description: This file provides unit tests for the connectome index.
+    Additional Notes: Index lookups are compared against linear scans of LIFCReceptorDataVec.
+    Date Created: 2026-10-17
+*/
+
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <BG/Common/Logger/Logger.h>
+#include <Simulator/Geometries/Sphere.h>
+#include <Simulator/Structs/Simulation.h>
+#include <Simulator/Structs/RecordingElectrode.h>
+#include <Simulator/Structs/CalciumImaging.h>
+#include <Simulator/Structs/ConnectomeIndex.h>
+
+
+/**
+ * @brief Test class for the connectome index. Builds LIFC networks with
+ * random receptors, including repeated pairs, self connections and a mix
+ * of plastic and static receptors.
+ */
+
+struct ConnectomeIndexTest : testing::Test {
+    BG::Common::Logger::LoggingSystem Logger;
+
+    static constexpr int NumNeurons = 16;
+    static constexpr int NumReceptors = 200;
+
+    std::vector<int> CompartmentIDs;
+    std::mt19937 Generator{5};
+
+    std::unique_ptr<BG::NES::Simulator::Simulation> MakeSimulation(bool _Abstracted) {
+        auto Sim = std::make_unique<BG::NES::Simulator::Simulation>(&Logger);
+        Sim->use_abstracted_LIF_receptors = _Abstracted;
+        CompartmentIDs.clear();
+        return Sim;
+    }
+
+    void AddNeuron(BG::NES::Simulator::Simulation& _Sim) {
+        using namespace BG::NES::Simulator;
+
+        Geometries::Sphere S(Geometries::Vec3D(10.0*CompartmentIDs.size(), 0.0, 0.0), 2.0);
+        Compartments::LIFC C;
+        C.ShapeID = _Sim.AddSphere(S);
+        C.RestingPotential_mV = -60.0;
+        C.ResetPotential_mV = -55.0;
+        C.SpikeThreshold_mV = -50.0;
+        C.MembraneResistance_MOhm = 100.0;
+        C.MembraneCapacitance_pF = 100.0;
+        C.AfterHyperpolarizationAmplitude_mV = 0.0;
+        CompartmentIDs.push_back(_Sim.AddLIFCCompartment(C));
+
+        CoreStructs::LIFCNeuronStruct N;
+        N.RestingPotential_mV = -60.0;
+        N.ResetPotential_mV = -55.0;
+        N.SpikeThreshold_mV = -50.0;
+        N.MembraneResistance_MOhm = 100.0;
+        N.MembraneCapacitance_pF = 100.0;
+        N.RefractoryPeriod_ms = 2.0;
+        N.SpikeDepolarization_mV = 30.0;
+        N.UpdateMethod = CoreStructs::EXPEULER_CM;
+        N.ResetMethod = CoreStructs::TOVM;
+        N.AfterHyperpolarizationReversalPotential_mV = -90.0;
+        N.FastAfterHyperpolarizationRise_ms = 2.5;
+        N.FastAfterHyperpolarizationDecay_ms = 30.0;
+        N.FastAfterHyperpolarizationPeakConductance_nS = 3.0;
+        N.FastAfterHyperpolarizationMaxPeakConductance_nS = 10.0;
+        N.FastAfterHyperpolarizationHalfActConstant = 0.5;
+        N.SlowAfterHyperpolarizationRise_ms = 30.0;
+        N.SlowAfterHyperpolarizationDecay_ms = 300.0;
+        N.SlowAfterHyperpolarizationPeakConductance_nS = 1.0;
+        N.SlowAfterHyperpolarizationMaxPeakConductance_nS = 5.0;
+        N.SlowAfterHyperpolarizationHalfActConstant = 0.5;
+        N.AfterHyperpolarizationSaturationModel = CoreStructs::AHPCLIP;
+        N.FatigueThreshold = 300.0;
+        N.FatigueRecoveryTime_ms = 1000.0;
+        N.AfterDepolarizationReversalPotential_mV = -20.0;
+        N.AfterDepolarizationRise_ms = 20.0;
+        N.AfterDepolarizationDecay_ms = 200.0;
+        N.AfterDepolarizationPeakConductance_nS = 0.3;
+        N.AfterDepolarizationSaturationMultiplier = 2.0;
+        N.AfterDepolarizationRecoveryTime_ms = 300.0;
+        N.AfterDepolarizationDepletion = 0.3;
+        N.AfterDepolarizationSaturationModel = CoreStructs::ADPCLIP;
+        N.AdaptiveThresholdDiffPerSpike = 0.2;
+        N.AdaptiveTresholdRecoveryTime_ms = 50.0;
+        N.AdaptiveThresholdDiffPotential_mV = 10.0;
+        N.AdaptiveThresholdFloor_mV = -50.0;
+        N.AdaptiveThresholdFloorDeltaPerSpike_mV = 1.0;
+        N.AdaptiveThresholdFloorRecoveryTime_ms = 500.0;
+        N.SomaCompartmentIDs.push_back(CompartmentIDs.back());
+        _Sim.AddLIFCNeuron(N);
+    }
+
+    void AddReceptor(BG::NES::Simulator::Simulation& _Sim, int _Src, int _Dst, bool _Inhibitory, bool _Plastic) {
+        using namespace BG::NES::Simulator;
+
+        Connections::LIFCReceptor R;
+        R.SourceCompartmentID = CompartmentIDs[_Src];
+        R.DestinationCompartmentID = CompartmentIDs[_Dst];
+        R.ReversalPotential_mV = _Inhibitory ? -70.0 : 0.0;
+        R.PSPRise_ms = 0.5;
+        R.PSPDecay_ms = 3.0;
+        R.PeakConductance_nS = 1.0 + (Generator() % 10);
+        R.Weight = 1.0;
+        R.OnsetDelay_ms = 1.0;
+        R.Neurotransmitter = _Inhibitory ? Connections::GABA : Connections::AMPA;
+        R.STDP_Method = _Plastic ? Connections::STDPHEBBIAN : Connections::STDPNONE;
+        R.STDP_A_pos = 0.1;
+        R.STDP_A_neg = 0.1;
+        R.STDP_Tau_pos = 20.0;
+        R.STDP_Tau_neg = 20.0;
+        _Sim.AddLIFCReceptor(R);
+    }
+
+    void AddRandomReceptors(BG::NES::Simulator::Simulation& _Sim, int _Count) {
+        // Only a few presynaptic neurons per row, so that pairs repeat.
+        std::uniform_int_distribution<int> Neuron(0, NumNeurons - 1);
+        for (int i = 0; i < _Count; i++) {
+            int Src = Neuron(Generator);
+            int Dst = (i % 7 == 0) ? Src : Neuron(Generator) % 5;
+            AddReceptor(_Sim, Src, Dst, (Generator() % 4) == 0, (Generator() % 3) != 0);
+        }
+    }
+
+    std::unique_ptr<BG::NES::Simulator::Simulation> MakeNetwork(bool _Abstracted) {
+        auto Sim = MakeSimulation(_Abstracted);
+        for (int i = 0; i < NumNeurons; i++) {
+            AddNeuron(*Sim);
+        }
+        AddRandomReceptors(*Sim, NumReceptors);
+        return Sim;
+    }
+
+    /**
+     * @brief Checks every lookup of the index against a linear scan of the
+     * receptor data of the simulation.
+     */
+    void ExpectMatchesScan(const BG::NES::Simulator::Simulation& _Sim) {
+        using namespace BG::NES::Simulator;
+
+        const CoreStructs::ConnectomeIndex& Index = _Sim.GetConnectomeIndex();
+        ASSERT_TRUE(Index.IsBuilt());
+        ASSERT_EQ(Index.GetNumNeurons(), _Sim.Neurons.size());
+        ASSERT_EQ(Index.GetNumEntries(), _Sim.LIFCReceptorDataVec.size());
+        ASSERT_EQ(Index.GetEntries().size(), _Sim.LIFCReceptorDataVec.size());
+
+        // CSR order, first by presynaptic and then by postsynaptic neuron.
+        const CoreStructs::ConnectomeEntry* Previous = nullptr;
+        for (auto& Entry : Index.GetEntries()) {
+            if (Previous != nullptr) {
+                ASSERT_TRUE((Previous->PreID < Entry.PreID) || ((Previous->PreID == Entry.PreID) && (Previous->PostID <= Entry.PostID)));
+            }
+            ASSERT_EQ(Entry.PreID, Entry.Receptor->SrcNeuronID);
+            ASSERT_EQ(Entry.PostID, Entry.Receptor->DstNeuronID);
+            ASSERT_EQ(Entry.Type, Entry.Receptor->Type());
+            ASSERT_EQ(Entry.g_peak_sum_nS, Entry.Receptor->g_peak_sum_nS);
+            ASSERT_EQ(Entry.NumReceptors, Entry.Receptor->ReceptorPtrs.size());
+            Previous = &Entry;
+        }
+
+        for (int Pre = 0; Pre < int(_Sim.Neurons.size()); Pre++) {
+            // Outgoing connections are the scan of the row, sorted by
+            // postsynaptic neuron, in creation order within a pair.
+            std::vector<CoreStructs::LIFCReceptorData*> Expected;
+            for (int Post = 0; Post < int(_Sim.Neurons.size()); Post++) {
+                std::vector<CoreStructs::LIFCReceptorData*> Pair;
+                for (auto& RData : _Sim.LIFCReceptorDataVec) {
+                    if ((RData->SrcNeuronID == Pre) && (RData->DstNeuronID == Post)) {
+                        Pair.push_back(RData.get());
+                    }
+                }
+                std::vector<CoreStructs::LIFCReceptorData*> Found;
+                for (auto& Entry : Index.GetPair(Pre, Post)) {
+                    Found.push_back(Entry.Receptor);
+                }
+                ASSERT_EQ(Found, Pair) << "pair " << Pre << " -> " << Post;
+                Expected.insert(Expected.end(), Pair.begin(), Pair.end());
+            }
+            std::vector<CoreStructs::LIFCReceptorData*> Found;
+            for (auto& Entry : Index.GetOutgoing(Pre)) {
+                Found.push_back(Entry.Receptor);
+            }
+            ASSERT_EQ(Found, Expected) << "presynaptic neuron " << Pre;
+        }
+
+        for (int Post = 0; Post < int(_Sim.Neurons.size()); Post++) {
+            std::vector<CoreStructs::LIFCReceptorData*> Expected;
+            for (auto& RData : _Sim.LIFCReceptorDataVec) {
+                if ((RData->DstNeuronID == Post) && (RData->STDP_Method() != Connections::STDPNONE)) {
+                    Expected.push_back(RData.get());
+                }
+            }
+            std::vector<CoreStructs::LIFCReceptorData*> Found(Index.GetPlasticInputs(Post).begin(), Index.GetPlasticInputs(Post).end());
+            ASSERT_EQ(Found, Expected) << "postsynaptic neuron " << Post;
+        }
+
+        // Out of range lookups are empty.
+        ASSERT_TRUE(Index.GetOutgoing(-1).empty());
+        ASSERT_TRUE(Index.GetOutgoing(_Sim.Neurons.size()).empty());
+        ASSERT_TRUE(Index.GetPair(0, _Sim.Neurons.size()).empty());
+        ASSERT_TRUE(Index.GetPlasticInputs(_Sim.Neurons.size()).empty());
+    }
+
+    void TearDown() { return; }
+};
+
+TEST_F(ConnectomeIndexTest, test_Lookups_match_linear_scan) {
+    for (bool Abstracted : {true, false}) {
+        auto Sim = MakeNetwork(Abstracted);
+        ASSERT_FALSE(Sim->LIFCReceptorDataVec.empty());
+        ExpectMatchesScan(*Sim);
+    }
+}
+
+TEST_F(ConnectomeIndexTest, test_Empty_model) {
+    auto Sim = MakeSimulation(true);
+    ASSERT_EQ(Sim->GetConnectomeIndex().GetNumEntries(), 0);
+    ASSERT_TRUE(Sim->GetConnectomeIndex().GetOutgoing(0).empty());
+
+    AddNeuron(*Sim);
+    AddNeuron(*Sim);
+    ExpectMatchesScan(*Sim);
+}
+
+TEST_F(ConnectomeIndexTest, test_Invalidated_by_model_changes) {
+    for (bool Abstracted : {true, false}) {
+        auto Sim = MakeNetwork(Abstracted);
+        ExpectMatchesScan(*Sim);
+
+        // A new receptor on an existing pair and one on a new pair.
+        const auto& Index = Sim->GetConnectomeIndex();
+        AddReceptor(*Sim, 0, 1, false, true);
+        ASSERT_FALSE(Index.IsBuilt());
+        ExpectMatchesScan(*Sim);
+        AddReceptor(*Sim, NumNeurons - 1, NumNeurons - 2, true, false);
+        ASSERT_FALSE(Index.IsBuilt());
+        ExpectMatchesScan(*Sim);
+
+        // A new neuron grows the rows, then gets connections of its own.
+        AddNeuron(*Sim);
+        ASSERT_FALSE(Index.IsBuilt());
+        ExpectMatchesScan(*Sim);
+        ASSERT_TRUE(Index.GetOutgoing(NumNeurons).empty());
+        AddReceptor(*Sim, NumNeurons, 3, false, true);
+        AddReceptor(*Sim, 2, NumNeurons, false, true);
+        ExpectMatchesScan(*Sim);
+        ASSERT_EQ(Index.GetOutgoing(NumNeurons).size(), 1);
+        ASSERT_EQ(Index.GetPlasticInputs(NumNeurons).size(), 1);
+
+        // Clearing the model leaves an empty index, and a rebuilt model is
+        // indexed from scratch.
+        Sim->ClearModel();
+        ASSERT_FALSE(Index.IsBuilt());
+        ASSERT_EQ(Sim->GetConnectomeIndex().GetNumEntries(), 0);
+        ASSERT_EQ(Sim->GetConnectomeIndex().GetNumNeurons(), 0);
+
+        CompartmentIDs.clear();
+        for (int i = 0; i < NumNeurons / 2; i++) {
+            AddNeuron(*Sim);
+        }
+        ASSERT_FALSE(Index.IsBuilt());
+        std::uniform_int_distribution<int> Neuron(0, NumNeurons / 2 - 1);
+        for (int i = 0; i < 50; i++) {
+            AddReceptor(*Sim, Neuron(Generator), Neuron(Generator), i % 5 == 0, i % 2 == 0);
+        }
+        ExpectMatchesScan(*Sim);
+    }
+}
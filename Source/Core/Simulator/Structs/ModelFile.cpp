@@ -0,0 +1,301 @@
+#include <Simulator/Structs/ModelFile.h>
+
+#include <array>
+#include <fstream>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+
+namespace BG {
+namespace NES {
+namespace Simulator {
+namespace Tools {
+
+static std::array<uint32_t, 256> MakeCRC32Table() {
+    std::array<uint32_t, 256> Table;
+    for (uint32_t i = 0; i < 256; i++) {
+        uint32_t C = i;
+        for (int k = 0; k < 8; k++) {
+            C = (C & 1) ? (0xEDB88320u ^ (C >> 1)) : (C >> 1);
+        }
+        Table[i] = C;
+    }
+    return Table;
+}
+
+uint32_t CRC32(const uint8_t* _Data, size_t _Size, uint32_t _CRC) {
+    static const std::array<uint32_t, 256> Table = MakeCRC32Table();
+    uint32_t C = ~_CRC;
+    for (size_t i = 0; i < _Size; i++) {
+        C = Table[(C ^ _Data[i]) & 0xFF] ^ (C >> 8);
+    }
+    return ~C;
+}
+
+bool IsModelFile(const std::string& _Path) {
+    std::ifstream File(_Path, std::ios::in | std::ios::binary);
+    char Magic[sizeof(ModelFileMagic)];
+    File.read(Magic, sizeof(Magic));
+    return File.good() && (std::memcmp(Magic, ModelFileMagic, sizeof(Magic)) == 0);
+}
+
+static uint64_t AlignUp(uint64_t _Value) {
+    return (_Value + ModelFileAlignment - 1) / ModelFileAlignment * ModelFileAlignment;
+}
+
+void ModelFileWriter::BeginSection(uint32_t _Type, uint64_t _Count) {
+    Sections_.push_back(Section{_Type, _Count, {}});
+}
+
+void ModelFileWriter::AddColumn(ModelFileColumnKind _Kind, uint32_t _Width, std::vector<uint8_t>&& _Data) {
+    if (Sections_.empty() || (_Data.size() != Sections_.back().Count * _Width)) {
+        Ok_ = false;
+        return;
+    }
+    Sections_.back().Columns.push_back(Column{uint32_t(_Kind), _Width, std::move(_Data)});
+}
+
+bool ModelFileWriter::Emit(int _NumThreads, const std::function<void(const uint8_t*, uint64_t)>& _Append) {
+    if (!Ok_) {
+        return false;
+    }
+
+    // Lay out the sections and their columns.
+    std::vector<std::vector<uint8_t>> Bodies(Sections_.size());
+    std::vector<uint64_t> Offsets(Sections_.size());
+    uint64_t Offset = AlignUp(ModelFileHeaderBytes);
+    for (size_t s = 0; s < Sections_.size(); s++) {
+        const Section & Sec = Sections_[s];
+        uint64_t ColumnOffset = AlignUp(Sec.Columns.size() * ModelFileColumnBytes);
+        std::vector<uint64_t> ColumnOffsets;
+        for (const Column & Col : Sec.Columns) {
+            ColumnOffsets.push_back(ColumnOffset);
+            ColumnOffset = AlignUp(ColumnOffset + Col.Data.size());
+        }
+
+        std::vector<uint8_t> & Body = Bodies[s];
+        Body.assign(ColumnOffset, 0);
+        for (size_t c = 0; c < Sec.Columns.size(); c++) {
+            uint8_t* Desc = Body.data() + c*ModelFileColumnBytes;
+            StoreLE<uint32_t>(Desc, Sec.Columns[c].Kind);
+            StoreLE<uint32_t>(Desc + 4, Sec.Columns[c].Width);
+            StoreLE<uint64_t>(Desc + 8, ColumnOffsets[c]);
+            std::copy(Sec.Columns[c].Data.begin(), Sec.Columns[c].Data.end(), Body.begin() + ColumnOffsets[c]);
+        }
+        Offsets[s] = Offset;
+        Offset = AlignUp(Offset + Body.size());
+    }
+
+    std::vector<uint32_t> CRCs(Sections_.size());
+    ParallelFor(Sections_.size(), _NumThreads, [&](size_t s) {
+        CRCs[s] = CRC32(Bodies[s].data(), Bodies[s].size());
+    });
+
+    std::vector<uint8_t> Table(Sections_.size() * ModelFileSectionBytes, 0);
+    for (size_t s = 0; s < Sections_.size(); s++) {
+        uint8_t* Entry = Table.data() + s*ModelFileSectionBytes;
+        StoreLE<uint32_t>(Entry, Sections_[s].Type);
+        StoreLE<uint32_t>(Entry + 4, uint32_t(Sections_[s].Columns.size()));
+        StoreLE<uint64_t>(Entry + 8, Sections_[s].Count);
+        StoreLE<uint64_t>(Entry + 16, Offsets[s]);
+        StoreLE<uint64_t>(Entry + 24, Bodies[s].size());
+        StoreLE<uint32_t>(Entry + 32, CRCs[s]);
+    }
+
+    uint8_t Header[ModelFileHeaderBytes] = { 0 };
+    std::memcpy(Header, ModelFileMagic, sizeof(ModelFileMagic));
+    StoreLE<uint32_t>(Header + 8, ModelFileVersion);
+    StoreLE<uint32_t>(Header + 12, ModelFileEndianMarker);
+    StoreLE<int32_t>(Header + 16, SimNeuronClass_);
+    StoreLE<uint32_t>(Header + 20, uint32_t(Sections_.size()));
+    StoreLE<uint64_t>(Header + 24, Offset);
+    StoreLE<uint32_t>(Header + 32, CRC32(Table.data(), Table.size()));
+    StoreLE<uint32_t>(Header + 60, CRC32(Header, 60));
+
+    const uint8_t Padding[ModelFileAlignment] = { 0 };
+    uint64_t Written = 0;
+    auto Append = [&](const uint8_t* _Data, uint64_t _Bytes, uint64_t _At) {
+        _Append(Padding, _At - Written);
+        _Append(_Data, _Bytes);
+        Written = _At + _Bytes;
+    };
+    Append(Header, sizeof(Header), 0);
+    for (size_t s = 0; s < Sections_.size(); s++) {
+        Append(Bodies[s].data(), Bodies[s].size(), Offsets[s]);
+    }
+    Append(Table.data(), Table.size(), Offset);
+    return true;
+}
+
+bool ModelFileWriter::Write(const std::string& _Path, int _NumThreads) {
+    std::ofstream File(_Path, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!File.is_open()) {
+        return false;
+    }
+    bool Ok = Emit(_NumThreads, [&](const uint8_t* _Data, uint64_t _Bytes) {
+        File.write(reinterpret_cast<const char*>(_Data), _Bytes);
+    });
+    File.close();
+    return Ok && File.good();
+}
+
+bool ModelFileWriter::WriteImage(std::vector<uint8_t>& _Image, int _NumThreads) {
+    _Image.clear();
+    return Emit(_NumThreads, [&](const uint8_t* _Data, uint64_t _Bytes) {
+        _Image.insert(_Image.end(), _Data, _Data + _Bytes);
+    });
+}
+
+
+ModelFileReader::~ModelFileReader() {
+#if !defined(_WIN32)
+    if (Mapping_) {
+        munmap(Mapping_, Size_);
+    }
+#endif
+}
+
+bool ModelFileReader::Fail(const std::string& _Error) {
+    Error_ = _Error;
+    return false;
+}
+
+bool ModelFileReader::Open(const std::string& _Path) {
+#if !defined(_WIN32)
+    int FD = open(_Path.c_str(), O_RDONLY);
+    if (FD < 0) {
+        return Fail("Unable to open " + _Path);
+    }
+    struct stat Stat;
+    if ((fstat(FD, &Stat) == 0) && (Stat.st_size > 0)) {
+        void* Mapping = mmap(nullptr, Stat.st_size, PROT_READ, MAP_PRIVATE, FD, 0);
+        if (Mapping != MAP_FAILED) {
+            Mapping_ = Mapping;
+            Data_ = static_cast<const uint8_t*>(Mapping);
+            Size_ = Stat.st_size;
+        }
+    }
+    close(FD);
+#endif
+    if (!Data_) {
+        std::ifstream File(_Path, std::ios::in | std::ios::binary | std::ios::ate);
+        if (!File.is_open()) {
+            return Fail("Unable to open " + _Path);
+        }
+        Buffer_.resize(File.tellg());
+        File.seekg(0);
+        File.read(reinterpret_cast<char*>(Buffer_.data()), Buffer_.size());
+        if (!File.good()) {
+            return Fail("Unable to read " + _Path);
+        }
+        Data_ = Buffer_.data();
+        Size_ = Buffer_.size();
+    }
+    return ParseHeader(_Path);
+}
+
+bool ModelFileReader::OpenImage(std::vector<uint8_t>&& _Image) {
+    Buffer_ = std::move(_Image);
+    Data_ = Buffer_.data();
+    Size_ = Buffer_.size();
+    return ParseHeader("model image");
+}
+
+bool ModelFileReader::ParseHeader(const std::string& _Source) {
+    if ((Size_ < ModelFileHeaderBytes) || (std::memcmp(Data_, ModelFileMagic, sizeof(ModelFileMagic)) != 0)) {
+        return Fail(_Source + " is not a model file");
+    }
+    if (LoadLE<uint32_t>(Data_ + 60) != CRC32(Data_, 60)) {
+        return Fail("Damaged header in " + _Source);
+    }
+    Version_ = LoadLE<uint32_t>(Data_ + 8);
+    if ((Version_ == 0) || (Version_ > ModelFileVersion)) {
+        return Fail(_Source + " has unsupported model file version " + std::to_string(Version_));
+    }
+    if (LoadLE<uint32_t>(Data_ + 12) != ModelFileEndianMarker) {
+        return Fail("Bad byte order marker in " + _Source);
+    }
+    SimNeuronClass_ = LoadLE<int32_t>(Data_ + 16);
+    return ParseSections();
+}
+
+bool ModelFileReader::ParseSections() {
+    uint64_t NumSections = LoadLE<uint32_t>(Data_ + 20);
+    uint64_t TableOffset = LoadLE<uint64_t>(Data_ + 24);
+    if ((TableOffset > Size_) || (NumSections > (Size_ - TableOffset) / ModelFileSectionBytes)) {
+        return Fail("Truncated section table");
+    }
+    if (LoadLE<uint32_t>(Data_ + 32) != CRC32(Data_ + TableOffset, NumSections * ModelFileSectionBytes)) {
+        return Fail("Damaged section table");
+    }
+
+    for (uint64_t s = 0; s < NumSections; s++) {
+        const uint8_t* Entry = Data_ + TableOffset + s*ModelFileSectionBytes;
+        SectionInfo Sec;
+        Sec.Type = LoadLE<uint32_t>(Entry);
+        uint64_t NumColumns = LoadLE<uint32_t>(Entry + 4);
+        Sec.Count = LoadLE<uint64_t>(Entry + 8);
+        Sec.Offset = LoadLE<uint64_t>(Entry + 16);
+        Sec.Size = LoadLE<uint64_t>(Entry + 24);
+        Sec.CRC = LoadLE<uint32_t>(Entry + 32);
+        if ((Sec.Offset > Size_) || (Sec.Size > Size_ - Sec.Offset) || (NumColumns > Sec.Size / ModelFileColumnBytes)) {
+            return Fail("Section " + std::to_string(Sec.Type) + " lies outside the file");
+        }
+
+        const uint8_t* Body = Data_ + Sec.Offset;
+        for (uint64_t c = 0; c < NumColumns; c++) {
+            const uint8_t* Desc = Body + c*ModelFileColumnBytes;
+            ColumnInfo Col;
+            Col.Kind = LoadLE<uint32_t>(Desc);
+            Col.Width = LoadLE<uint32_t>(Desc + 4);
+            uint64_t ColumnOffset = LoadLE<uint64_t>(Desc + 8);
+            if ((ColumnOffset > Sec.Size) || ((Col.Width > 0) && (Sec.Count > (Sec.Size - ColumnOffset) / Col.Width))) {
+                return Fail("Column " + std::to_string(c) + " of section " + std::to_string(Sec.Type) + " lies outside its section");
+            }
+            Col.Data = Body + ColumnOffset;
+            Sec.Columns.push_back(Col);
+        }
+        Sections_.push_back(std::move(Sec));
+    }
+    return true;
+}
+
+bool ModelFileReader::VerifySections(int _NumThreads) {
+    std::vector<uint8_t> Good(Sections_.size(), 0);
+    ParallelFor(Sections_.size(), _NumThreads, [&](size_t s) {
+        Good[s] = CRC32(Data_ + Sections_[s].Offset, Sections_[s].Size) == Sections_[s].CRC;
+    });
+    for (size_t s = 0; s < Sections_.size(); s++) {
+        if (!Good[s]) {
+            return Fail("CRC mismatch in section " + std::to_string(Sections_[s].Type));
+        }
+    }
+    return true;
+}
+
+const ModelFileReader::SectionInfo* ModelFileReader::FindSection(uint32_t _Type) const {
+    for (const SectionInfo & Sec : Sections_) {
+        if (Sec.Type == _Type) {
+            return &Sec;
+        }
+    }
+    return nullptr;
+}
+
+bool ModelFileReader::GetBytesColumn(const SectionInfo& _Section, size_t _Col, uint32_t _Width, const uint8_t*& _Data) const {
+    if ((_Col >= _Section.Columns.size()) || (_Section.Columns[_Col].Kind != ColumnBytes) || (_Section.Columns[_Col].Width != _Width)) {
+        return false;
+    }
+    _Data = _Section.Columns[_Col].Data;
+    return true;
+}
+
+}; // namespace Tools
+}; // namespace Simulator
+}; // namespace NES
+}; // namespace BG
@@ -0,0 +1,303 @@
+//=================================================================//
+// This file is part of the BrainGenix-NES Neuron Emulation System //
+//=================================================================//
+
+/*
+    Description: This file provides the versioned, sectioned container of saved neuronal circuit models.
+    Additional Notes: None
+    Date Created: 2026-10-17
+*/
+
+#pragma once
+
+// Standard Libraries (BG convention: use <> instead of "")
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// Third-Party Libraries (BG convention: use <> instead of "")
+
+// Internal Libraries (BG convention: use <> instead of "")
+
+
+namespace BG {
+namespace NES {
+namespace Simulator {
+namespace Tools {
+
+/**
+ * File layout (every number little-endian):
+ *
+ *   ModelFileHeader                       ModelFileHeaderBytes at offset 0
+ *   section data                          each section starts on ModelFileAlignment
+ *   section table                         NumSections x ModelFileSectionBytes
+ *
+ * A section is a table of Count rows stored column by column. It starts with
+ * NumColumns column descriptors (ModelFileColumnBytes each), followed by the
+ * columns, each aligned to ModelFileAlignment. A column holds Count values of
+ * Width bytes, either little-endian numbers or raw bytes such as fixed-length
+ * strings. Variable-length per-row data is stored as a length column plus a
+ * separate section holding the concatenated values.
+ *
+ * The header has a CRC32 of itself and of the section table, and the section
+ * table has a CRC32 of every section, so damage is found before anything is
+ * constructed. Readers look up sections by type and columns by index, so
+ * later versions can append sections and columns without breaking them.
+ */
+constexpr char ModelFileMagic[8] = {'N', 'E', 'S', 'M', 'O', 'D', 'L', '\0'};
+constexpr uint32_t ModelFileVersion = 1;
+constexpr uint32_t ModelFileEndianMarker = 0x01020304;
+constexpr uint64_t ModelFileAlignment = 64;
+constexpr size_t ModelFileHeaderBytes = 64;
+constexpr size_t ModelFileSectionBytes = 40;
+constexpr size_t ModelFileColumnBytes = 16;
+
+/**
+ * Sections of a version 1 model file. The columns of each section are listed
+ * with the schema functions in Simulation.cpp. Variable-length lists follow
+ * the rows of their owner in order, see the length columns of the owner.
+ */
+enum ModelFileSection : uint32_t {
+    SectionGeometryMap = 1,       // Shape type of every geometry, in Collection order
+    SectionSpheres = 2,
+    SectionCylinders = 3,
+    SectionBoxes = 4,
+    SectionBSCompartments = 5,
+    SectionLIFCCompartments = 6,
+    SectionReceptors = 7,
+    SectionLIFCReceptors = 8,
+    SectionSCNeurons = 9,
+    SectionLIFCNeurons = 10,
+    SectionNeuronLists = 11,      // Soma, dendrite and axon list lengths and name length of every neuron
+    SectionNeuronListValues = 12, // Concatenated compartment IDs of all neurons
+    SectionNeuronNames = 13,      // Concatenated name characters of all neurons
+    SectionRegions = 14,
+    SectionCircuits = 15,
+    SectionCircuitNeuronIDs = 16, // Concatenated neuron IDs of all circuits
+};
+
+enum ModelFileColumnKind : uint32_t {
+    ColumnNumber = 0, // Little-endian integer or IEEE float
+    ColumnBytes = 1,  // Raw bytes, e.g. fixed-length strings
+};
+
+uint32_t CRC32(const uint8_t* _Data, size_t _Size, uint32_t _CRC = 0);
+
+bool IsModelFile(const std::string& _Path);
+
+//! Runs _Func(i) for i in [0, _NumItems) on up to _NumThreads threads (0: all hardware threads).
+template <typename F>
+void ParallelFor(size_t _NumItems, int _NumThreads, F _Func) {
+    if (_NumThreads <= 0) {
+        _NumThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    size_t NumThreads = std::min<size_t>(_NumThreads, _NumItems);
+    if (NumThreads <= 1) {
+        for (size_t i = 0; i < _NumItems; i++) _Func(i);
+        return;
+    }
+    std::atomic<size_t> Next{0};
+    std::vector<std::thread> Threads;
+    for (size_t t = 0; t < NumThreads; t++) {
+        Threads.emplace_back([&]() {
+            for (size_t i = Next++; i < _NumItems; i = Next++) _Func(i);
+        });
+    }
+    for (auto & Thread : Threads) Thread.join();
+}
+
+template <typename T>
+void StoreLE(uint8_t* _Dst, T _Value) {
+    static_assert(std::is_arithmetic<T>::value, "Model file numbers must be arithmetic");
+    typename std::conditional<sizeof(T) == 8, uint64_t, typename std::conditional<sizeof(T) == 4, uint32_t,
+        typename std::conditional<sizeof(T) == 2, uint16_t, uint8_t>::type>::type>::type Bits;
+    std::memcpy(&Bits, &_Value, sizeof(T));
+    for (size_t i = 0; i < sizeof(T); i++) {
+        _Dst[i] = uint8_t(Bits >> (8*i));
+    }
+}
+
+template <typename T>
+T LoadLE(const uint8_t* _Src) {
+    static_assert(std::is_arithmetic<T>::value, "Model file numbers must be arithmetic");
+    typename std::conditional<sizeof(T) == 8, uint64_t, typename std::conditional<sizeof(T) == 4, uint32_t,
+        typename std::conditional<sizeof(T) == 2, uint16_t, uint8_t>::type>::type>::type Bits = 0;
+    for (size_t i = 0; i < sizeof(T); i++) {
+        Bits |= decltype(Bits)(_Src[i]) << (8*i);
+    }
+    T Value;
+    std::memcpy(&Value, &Bits, sizeof(T));
+    return Value;
+}
+
+
+/**
+ * @brief Collects sections and their columns in memory and writes them as a
+ * model file.
+ *
+ * Usage: BeginSection(), one Add...Column() per column in schema order, and
+ * EndSection() for every section, then Write().
+ */
+class ModelFileWriter {
+
+private:
+
+    struct Column {
+        uint32_t Kind;
+        uint32_t Width;
+        std::vector<uint8_t> Data;
+    };
+
+    struct Section {
+        uint32_t Type;
+        uint64_t Count;
+        std::vector<Column> Columns;
+    };
+
+    int32_t SimNeuronClass_;
+    std::vector<Section> Sections_;
+    bool Ok_ = true;
+
+    //! Lays out the file and hands its bytes to _Append in order.
+    bool Emit(int _NumThreads, const std::function<void(const uint8_t*, uint64_t)>& _Append);
+
+public:
+
+    ModelFileWriter(int32_t _SimNeuronClass): SimNeuronClass_(_SimNeuronClass) {}
+
+    void BeginSection(uint32_t _Type, uint64_t _Count);
+
+    //! Adds a column of the open section. _Data must hold Count*_Width bytes,
+    //! numbers already in little-endian order.
+    void AddColumn(ModelFileColumnKind _Kind, uint32_t _Width, std::vector<uint8_t>&& _Data);
+
+    template <typename T>
+    void AddNumberColumn(const std::vector<T>& _Values) {
+        std::vector<uint8_t> Data(_Values.size() * sizeof(T));
+        for (size_t i = 0; i < _Values.size(); i++) {
+            StoreLE<T>(Data.data() + i*sizeof(T), _Values[i]);
+        }
+        AddColumn(ColumnNumber, sizeof(T), std::move(Data));
+    }
+
+    void EndSection() {}
+
+    //! Computes the section CRCs on up to _NumThreads threads and writes the file.
+    bool Write(const std::string& _Path, int _NumThreads = 0);
+
+    //! Same as Write(), into memory instead of a file.
+    bool WriteImage(std::vector<uint8_t>& _Image, int _NumThreads = 0);
+
+};
+
+
+/**
+ * @brief Typed read-only view of a model file column. Values are decoded
+ * from the mapped file on access, so nothing is copied up front.
+ */
+template <typename T>
+class ModelFileColumnView {
+
+private:
+
+    const uint8_t* Data_ = nullptr;
+    uint64_t Count_ = 0;
+
+public:
+
+    ModelFileColumnView() {}
+    ModelFileColumnView(const uint8_t* _Data, uint64_t _Count): Data_(_Data), Count_(_Count) {}
+
+    T operator[](uint64_t _Idx) const { return LoadLE<T>(Data_ + _Idx*sizeof(T)); }
+    uint64_t Size() const { return Count_; }
+
+};
+
+
+/**
+ * @brief Maps a model file into memory and gives access to its sections and
+ * columns without copying them.
+ *
+ * Open() checks the header and the section table. VerifySections() checks
+ * the CRC of every section in parallel and should be called before the
+ * columns are used.
+ */
+class ModelFileReader {
+
+public:
+
+    struct ColumnInfo {
+        uint32_t Kind = 0;
+        uint32_t Width = 0;
+        const uint8_t* Data = nullptr;
+    };
+
+    struct SectionInfo {
+        uint32_t Type = 0;
+        uint32_t CRC = 0;
+        uint64_t Count = 0;
+        uint64_t Offset = 0;
+        uint64_t Size = 0;
+        std::vector<ColumnInfo> Columns;
+    };
+
+private:
+
+    const uint8_t* Data_ = nullptr;
+    uint64_t Size_ = 0;
+    void* Mapping_ = nullptr;           /**Start of the mmap, nullptr if Buffer_ is used*/
+    std::vector<uint8_t> Buffer_;       /**Model image, or the file where mmap is not available*/
+
+    uint32_t Version_ = 0;
+    int32_t SimNeuronClass_ = -1;
+    std::vector<SectionInfo> Sections_;
+    std::string Error_;
+
+    bool Fail(const std::string& _Error);
+    bool ParseHeader(const std::string& _Source);
+    bool ParseSections();
+
+public:
+
+    ModelFileReader() {}
+    ~ModelFileReader();
+    ModelFileReader(const ModelFileReader&) = delete;
+    ModelFileReader& operator=(const ModelFileReader&) = delete;
+
+    bool Open(const std::string& _Path);
+    //! Takes over a model image, e.g. from ModelFileWriter::WriteImage().
+    bool OpenImage(std::vector<uint8_t>&& _Image);
+    bool VerifySections(int _NumThreads = 0);
+
+    uint32_t GetVersion() const { return Version_; }
+    int32_t GetSimNeuronClass() const { return SimNeuronClass_; }
+    const std::string& GetError() const { return Error_; }
+
+    //! Returns nullptr if the file has no section of this type.
+    const SectionInfo* FindSection(uint32_t _Type) const;
+
+    //! Checks that the section has a number column _Col of sizeof(T) bytes.
+    template <typename T>
+    bool GetColumn(const SectionInfo& _Section, size_t _Col, ModelFileColumnView<T>& _View) const {
+        if ((_Col >= _Section.Columns.size()) || (_Section.Columns[_Col].Kind != ColumnNumber) || (_Section.Columns[_Col].Width != sizeof(T))) {
+            return false;
+        }
+        _View = ModelFileColumnView<T>(_Section.Columns[_Col].Data, _Section.Count);
+        return true;
+    }
+
+    //! Checks that the section has a bytes column _Col of _Width bytes per row.
+    bool GetBytesColumn(const SectionInfo& _Section, size_t _Col, uint32_t _Width, const uint8_t*& _Data) const;
+
+};
+
+}; // namespace Tools
+}; // namespace Simulator
+}; // namespace NES
+}; // namespace BG
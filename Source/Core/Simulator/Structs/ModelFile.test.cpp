@@ -0,0 +1,357 @@
+//=================================================================//
+// This file is part of the BrainGenix-NES Neuron Emulation System //
+//=================================================================//
+
+/*
+    Description: This file provides unit tests for the columnar model file format.
+    Additional Notes: None
+    Date Created: 2026-10-17
+*/
+
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <BG/Common/Logger/Logger.h>
+#include <Simulator/Geometries/Sphere.h>
+#include <Simulator/Geometries/Cylinder.h>
+#include <Simulator/Geometries/Box.h>
+#include <Simulator/LIFCompartmental/LIFCNeuron.h>
+#include <Simulator/Structs/ModelFile.h>
+#include <Simulator/Structs/Simulation.h>
+#include <Simulator/Structs/RecordingElectrode.h>
+#include <Simulator/Structs/CalciumImaging.h>
+
+
+/**
+ * @brief Test class for model files. Builds a small LIFC model with all
+ * shape types, multi-compartment neurons, a region and its circuit.
+ */
+
+struct ModelFileTest : testing::Test {
+    BG::Common::Logger::LoggingSystem Logger;
+
+    static constexpr int NumNeurons = 5;
+
+    std::string Path(const std::string& _Name) {
+        return (std::filesystem::temp_directory_path() / ("nes-modelfile-test-" + _Name)).string();
+    }
+
+    std::unique_ptr<BG::NES::Simulator::Simulation> MakeModel() {
+        using namespace BG::NES::Simulator;
+
+        auto Sim = std::make_unique<Simulation>(&Logger);
+
+        std::vector<int> SomaIDs, AxonIDs;
+        for (int i = 0; i < NumNeurons; i++) {
+            Geometries::Sphere S(Geometries::Vec3D(10.0*i, 1.0, -2.0), 2.0 + i);
+            Geometries::Cylinder C(0.5, Geometries::Vec3D(10.0*i, 0.0, 0.0), 0.25, Geometries::Vec3D(10.0*i, 20.0, 0.0));
+            int SomaShapeID = Sim->AddSphere(S);
+            int AxonShapeID = Sim->AddCylinder(C);
+
+            for (int ShapeID : {SomaShapeID, AxonShapeID}) {
+                Compartments::LIFC Comp;
+                Comp.ShapeID = ShapeID;
+                Comp.RestingPotential_mV = -60.0 - i;
+                Comp.ResetPotential_mV = -55.0;
+                Comp.SpikeThreshold_mV = -50.0;
+                Comp.MembraneResistance_MOhm = 100.0;
+                Comp.MembraneCapacitance_pF = 100.0;
+                Comp.AfterHyperpolarizationAmplitude_mV = 0.0;
+                (ShapeID == SomaShapeID ? SomaIDs : AxonIDs).push_back(Sim->AddLIFCCompartment(Comp));
+            }
+
+            CoreStructs::LIFCNeuronStruct N;
+            N.Name = "neuron-" + std::to_string(i);
+            N.RestingPotential_mV = -60.0 - i;
+            N.ResetPotential_mV = -55.0;
+            N.SpikeThreshold_mV = -50.0;
+            N.MembraneResistance_MOhm = 100.0;
+            N.MembraneCapacitance_pF = 100.0;
+            N.RefractoryPeriod_ms = 2.0;
+            N.SpikeDepolarization_mV = 30.0;
+            N.UpdateMethod = CoreStructs::EXPEULER_CM;
+            N.ResetMethod = CoreStructs::TOVM;
+            N.AfterHyperpolarizationReversalPotential_mV = -90.0;
+            N.FastAfterHyperpolarizationRise_ms = 2.5;
+            N.FastAfterHyperpolarizationDecay_ms = 30.0;
+            N.FastAfterHyperpolarizationPeakConductance_nS = 3.0;
+            N.FastAfterHyperpolarizationMaxPeakConductance_nS = 10.0;
+            N.FastAfterHyperpolarizationHalfActConstant = 0.5;
+            N.SlowAfterHyperpolarizationRise_ms = 30.0;
+            N.SlowAfterHyperpolarizationDecay_ms = 300.0;
+            N.SlowAfterHyperpolarizationPeakConductance_nS = 1.0;
+            N.SlowAfterHyperpolarizationMaxPeakConductance_nS = 5.0;
+            N.SlowAfterHyperpolarizationHalfActConstant = 0.5;
+            N.AfterHyperpolarizationSaturationModel = CoreStructs::AHPCLIP;
+            N.FatigueThreshold = 300.0;
+            N.FatigueRecoveryTime_ms = 1000.0;
+            N.AfterDepolarizationReversalPotential_mV = -20.0;
+            N.AfterDepolarizationRise_ms = 20.0;
+            N.AfterDepolarizationDecay_ms = 200.0;
+            N.AfterDepolarizationPeakConductance_nS = 0.3;
+            N.AfterDepolarizationSaturationMultiplier = 2.0;
+            N.AfterDepolarizationRecoveryTime_ms = 300.0;
+            N.AfterDepolarizationDepletion = 0.3;
+            N.AfterDepolarizationSaturationModel = CoreStructs::ADPCLIP;
+            N.AdaptiveThresholdDiffPerSpike = 0.2;
+            N.AdaptiveTresholdRecoveryTime_ms = 50.0;
+            N.AdaptiveThresholdDiffPotential_mV = 10.0;
+            N.AdaptiveThresholdFloor_mV = -50.0;
+            N.AdaptiveThresholdFloorDeltaPerSpike_mV = 1.0;
+            N.AdaptiveThresholdFloorRecoveryTime_ms = 500.0;
+            N.SomaCompartmentIDs.push_back(SomaIDs.back());
+            N.AxonCompartmentIDs.push_back(AxonIDs.back());
+            Sim->AddLIFCNeuron(N);
+        }
+
+        Geometries::Box B(Geometries::Vec3D(0.0, 0.0, 5.0), Geometries::Vec3D(1.0, 2.0, 3.0), Geometries::Vec3D(0.1, 0.2, 0.3));
+        int BoxID = Sim->AddBox(B);
+
+        for (int i = 0; i < NumNeurons; i++) {
+            Connections::LIFCReceptor R;
+            R.ShapeID = BoxID;
+            R.SourceCompartmentID = AxonIDs[i];
+            R.DestinationCompartmentID = SomaIDs[(i+1) % NumNeurons];
+            R.ReversalPotential_mV = 0.0;
+            R.PSPRise_ms = 0.5;
+            R.PSPDecay_ms = 3.0;
+            R.PeakConductance_nS = 40.0 + i;
+            R.Weight = 1.0;
+            R.OnsetDelay_ms = 1.5;
+            R.voltage_gated = (i % 2) == 1;
+            R.STDP_Method = Connections::STDPHEBBIAN;
+            R.STDP_A_pos = 0.1;
+            R.Neurotransmitter = (i % 2) ? Connections::GABA : Connections::AMPA;
+            Sim->AddLIFCReceptor(R);
+        }
+
+        BrainRegions::BrainRegion Region;
+        Region.SetName("cortex");
+        int RegionID = Sim->AddRegion(Region);
+        for (int i = 0; i < NumNeurons; i += 2) {
+            Sim->NeuralCircuits.at(Sim->Regions.at(RegionID)->CircuitID)->AddNeuronByID(i);
+        }
+
+        return Sim;
+    }
+
+    void ExpectSameModel(const BG::NES::Simulator::Simulation& _A, const BG::NES::Simulator::Simulation& _B) {
+        using namespace BG::NES::Simulator;
+
+        ASSERT_EQ(_A.SimNeuronClass, _B.SimNeuronClass);
+        ASSERT_EQ(_A.Collection.Geometries.size(), _B.Collection.Geometries.size());
+        auto& CA = const_cast<Geometries::GeometryCollection&>(_A.Collection);
+        auto& CB = const_cast<Geometries::GeometryCollection&>(_B.Collection);
+        for (size_t i = 0; i < CA.Size(); i++) {
+            ASSERT_EQ(CA.GetShapeType(i), CB.GetShapeType(i));
+            Geometries::Geometry* GA = CA.GetGeometry(i);
+            Geometries::Geometry* GB = CB.GetGeometry(i);
+            EXPECT_EQ(GA->Center_um.x, GB->Center_um.x);
+            EXPECT_EQ(GA->Center_um.y, GB->Center_um.y);
+            EXPECT_EQ(GA->Center_um.z, GB->Center_um.z);
+            if (CA.GetShapeType(i) == Geometries::GeometrySphere) {
+                EXPECT_EQ(CA.GetSphere(i).Radius_um, CB.GetSphere(i).Radius_um);
+                EXPECT_EQ(CA.GetSphere(i).ParentID, CB.GetSphere(i).ParentID);
+            } else if (CA.GetShapeType(i) == Geometries::GeometryCylinder) {
+                EXPECT_EQ(CA.GetCylinder(i).End0Radius_um, CB.GetCylinder(i).End0Radius_um);
+                EXPECT_EQ(CA.GetCylinder(i).End1Pos_um.y, CB.GetCylinder(i).End1Pos_um.y);
+            } else {
+                EXPECT_EQ(CA.GetBox(i).Dims_um.z, CB.GetBox(i).Dims_um.z);
+                EXPECT_EQ(CA.GetBox(i).Rotations_rad.y, CB.GetBox(i).Rotations_rad.y);
+            }
+        }
+
+        ASSERT_EQ(_A.LIFCCompartments.size(), _B.LIFCCompartments.size());
+        for (size_t i = 0; i < _A.LIFCCompartments.size(); i++) {
+            EXPECT_EQ(_A.LIFCCompartments[i].ShapeID, _B.LIFCCompartments[i].ShapeID);
+            EXPECT_EQ(_A.LIFCCompartments[i].RestingPotential_mV, _B.LIFCCompartments[i].RestingPotential_mV);
+        }
+
+        ASSERT_EQ(_A.Neurons.size(), _B.Neurons.size());
+        for (size_t i = 0; i < _A.Neurons.size(); i++) {
+            const auto& NA = static_cast<LIFCNeuron*>(_A.Neurons[i].get())->build_data;
+            const auto& NB = static_cast<LIFCNeuron*>(_B.Neurons[i].get())->build_data;
+            EXPECT_EQ(NA.Name, NB.Name);
+            EXPECT_EQ(NA.RestingPotential_mV, NB.RestingPotential_mV);
+            EXPECT_EQ(NA.UpdateMethod, NB.UpdateMethod);
+            EXPECT_EQ(NA.AfterDepolarizationSaturationModel, NB.AfterDepolarizationSaturationModel);
+            EXPECT_EQ(NA.AdaptiveThresholdFloorRecoveryTime_ms, NB.AdaptiveThresholdFloorRecoveryTime_ms);
+            EXPECT_EQ(NA.SomaCompartmentIDs, NB.SomaCompartmentIDs);
+            EXPECT_EQ(NA.DendriteCompartmentIDs, NB.DendriteCompartmentIDs);
+            EXPECT_EQ(NA.AxonCompartmentIDs, NB.AxonCompartmentIDs);
+        }
+        EXPECT_EQ(_A.NeuronByCompartment, _B.NeuronByCompartment);
+
+        ASSERT_EQ(_A.LIFCReceptors.size(), _B.LIFCReceptors.size());
+        for (size_t i = 0; i < _A.LIFCReceptors.size(); i++) {
+            EXPECT_EQ(_A.LIFCReceptors[i]->SourceCompartmentID, _B.LIFCReceptors[i]->SourceCompartmentID);
+            EXPECT_EQ(_A.LIFCReceptors[i]->DestinationCompartmentID, _B.LIFCReceptors[i]->DestinationCompartmentID);
+            EXPECT_EQ(_A.LIFCReceptors[i]->PeakConductance_nS, _B.LIFCReceptors[i]->PeakConductance_nS);
+            EXPECT_EQ(_A.LIFCReceptors[i]->voltage_gated, _B.LIFCReceptors[i]->voltage_gated);
+            EXPECT_EQ(_A.LIFCReceptors[i]->STDP_Method, _B.LIFCReceptors[i]->STDP_Method);
+            EXPECT_EQ(_A.LIFCReceptors[i]->Neurotransmitter, _B.LIFCReceptors[i]->Neurotransmitter);
+        }
+
+        ASSERT_EQ(_A.Regions.size(), _B.Regions.size());
+        for (size_t i = 0; i < _A.Regions.size(); i++) {
+            EXPECT_EQ(_A.Regions[i]->Name(), _B.Regions[i]->Name());
+            EXPECT_EQ(_A.Regions[i]->CircuitID, _B.Regions[i]->CircuitID);
+        }
+        ASSERT_EQ(_A.NeuralCircuits.size(), _B.NeuralCircuits.size());
+        for (size_t i = 0; i < _A.NeuralCircuits.size(); i++) {
+            EXPECT_EQ(_A.NeuralCircuits[i]->RegionID, _B.NeuralCircuits[i]->RegionID);
+            EXPECT_EQ(_A.NeuralCircuits[i]->NeuronIDs, _B.NeuralCircuits[i]->NeuronIDs);
+        }
+    }
+
+    void TearDown() { return; }
+};
+
+TEST_F(ModelFileTest, test_WriterReader_roundtrip) {
+    using namespace BG::NES::Simulator::Tools;
+
+    ModelFileWriter Writer(2);
+    Writer.BeginSection(SectionSpheres, 3);
+    Writer.AddNumberColumn(std::vector<int32_t>{-1, 0, 0x12345678});
+    Writer.AddNumberColumn(std::vector<double>{0.5, -2.25, 1e300});
+    Writer.AddColumn(ColumnBytes, 2, std::vector<uint8_t>{'a', 'b', 'c', 'd', 'e', 'f'});
+    Writer.EndSection();
+    ASSERT_TRUE(Writer.Write(Path("raw"), 2));
+
+    // Numbers are little-endian in the file regardless of the host.
+    std::ifstream File(Path("raw"), std::ios::binary);
+    char Header[24];
+    File.read(Header, sizeof(Header));
+    ASSERT_EQ(std::memcmp(Header, ModelFileMagic, sizeof(ModelFileMagic)), 0);
+    ASSERT_EQ(uint8_t(Header[8]), ModelFileVersion);
+    ASSERT_EQ(uint8_t(Header[12]), 0x04);
+    ASSERT_EQ(uint8_t(Header[15]), 0x01);
+
+    ModelFileReader Reader;
+    ASSERT_TRUE(Reader.Open(Path("raw"))) << Reader.GetError();
+    ASSERT_TRUE(Reader.VerifySections(2)) << Reader.GetError();
+    ASSERT_EQ(Reader.GetVersion(), ModelFileVersion);
+    ASSERT_EQ(Reader.GetSimNeuronClass(), 2);
+    ASSERT_EQ(Reader.FindSection(SectionBoxes), nullptr);
+    const ModelFileReader::SectionInfo* Section = Reader.FindSection(SectionSpheres);
+    ASSERT_NE(Section, nullptr);
+    ASSERT_EQ(Section->Count, 3);
+
+    ModelFileColumnView<int32_t> Ints;
+    ModelFileColumnView<double> Doubles;
+    ModelFileColumnView<float> WrongWidth;
+    const uint8_t* Bytes = nullptr;
+    ASSERT_TRUE(Reader.GetColumn(*Section, 0, Ints));
+    ASSERT_TRUE(Reader.GetColumn(*Section, 1, Doubles));
+    ASSERT_FALSE(Reader.GetColumn(*Section, 1, WrongWidth));
+    ASSERT_TRUE(Reader.GetBytesColumn(*Section, 2, 2, Bytes));
+    ASSERT_FALSE(Reader.GetColumn(*Section, 3, Ints));
+    ASSERT_EQ(Ints[0], -1);
+    ASSERT_EQ(Ints[2], 0x12345678);
+    ASSERT_EQ(Doubles[1], -2.25);
+    ASSERT_EQ(Doubles[2], 1e300);
+    ASSERT_EQ(std::string(reinterpret_cast<const char*>(Bytes), 6), "abcdef");
+}
+
+TEST_F(ModelFileTest, test_SaveLoad_roundtrip) {
+    auto Source = MakeModel();
+    ASSERT_TRUE(Source->SaveModel(Path("model")));
+    ASSERT_TRUE(BG::NES::Simulator::Tools::IsModelFile(Path("model")));
+
+    // Loading replaces whatever the simulation held before.
+    auto Loaded = MakeModel();
+    ASSERT_TRUE(Loaded->LoadModel(Path("model")));
+    ExpectSameModel(*Source, *Loaded);
+
+    // Saving the loaded model gives the same file.
+    ASSERT_TRUE(Loaded->SaveModel(Path("model2")));
+    std::ifstream A(Path("model"), std::ios::binary), B(Path("model2"), std::ios::binary);
+    std::string DataA((std::istreambuf_iterator<char>(A)), std::istreambuf_iterator<char>());
+    std::string DataB((std::istreambuf_iterator<char>(B)), std::istreambuf_iterator<char>());
+    ASSERT_EQ(DataA, DataB);
+}
+
+TEST_F(ModelFileTest, test_Load_rejects_damaged_file) {
+    auto Source = MakeModel();
+    ASSERT_TRUE(Source->SaveModel(Path("damaged")));
+
+    // Flip one byte inside the section data.
+    {
+        std::fstream File(Path("damaged"), std::ios::in | std::ios::out | std::ios::binary);
+        File.seekg(BG::NES::Simulator::Tools::ModelFileAlignment + 100);
+        char Byte;
+        File.read(&Byte, 1);
+        Byte ^= 0x40;
+        File.seekp(BG::NES::Simulator::Tools::ModelFileAlignment + 100);
+        File.write(&Byte, 1);
+    }
+
+    BG::NES::Simulator::Tools::ModelFileReader Reader;
+    ASSERT_TRUE(Reader.Open(Path("damaged")));
+    ASSERT_FALSE(Reader.VerifySections());
+
+    // A failed load leaves the model alone.
+    auto Loaded = MakeModel();
+    ASSERT_FALSE(Loaded->LoadModel(Path("damaged")));
+    ExpectSameModel(*Source, *Loaded);
+}
+
+TEST_F(ModelFileTest, test_Load_migrates_legacy_file) {
+    auto Source = MakeModel();
+    ASSERT_TRUE(Source->SaveLegacyModel(Path("legacy")));
+    ASSERT_FALSE(BG::NES::Simulator::Tools::IsModelFile(Path("legacy")));
+
+    BG::NES::Simulator::Simulation Loaded(&Logger);
+    ASSERT_TRUE(Loaded.LoadModel(Path("legacy")));
+    ExpectSameModel(*Source, Loaded);
+
+    ASSERT_TRUE(Loaded.SaveModel(Path("migrated")));
+    BG::NES::Simulator::Simulation Migrated(&Logger);
+    ASSERT_TRUE(Migrated.LoadModel(Path("migrated")));
+    ExpectSameModel(*Source, Migrated);
+}
+
+TEST_F(ModelFileTest, test_Load_legacy_SC_file_replaces_model) {
+    using namespace BG::NES::Simulator;
+
+    Simulation Source(&Logger);
+    for (int i = 0; i < 3; i++) {
+        Geometries::Sphere S(Geometries::Vec3D(5.0*i, 0.0, 0.0), 1.0 + i);
+        Compartments::BS C;
+        C.ShapeID = Source.AddSphere(S);
+        C.RestingPotential_mV = -60.0 - i;
+        ASSERT_EQ(Source.AddSCCompartment(C, SCNEURONS), i);
+    }
+    ASSERT_TRUE(Source.SaveLegacyModel(Path("legacy-sc")));
+
+    // The LIFC model held before must be gone, not mixed with the loaded one.
+    auto Loaded = MakeModel();
+    ASSERT_TRUE(Loaded->LoadModel(Path("legacy-sc")));
+    ASSERT_EQ(Loaded->SimNeuronClass, SCNEURONS);
+    ASSERT_EQ(Loaded->Collection.Size(), 3u);
+    ASSERT_TRUE(Loaded->LIFCCompartments.empty());
+    ASSERT_TRUE(Loaded->LIFCReceptors.empty());
+    ASSERT_TRUE(Loaded->Neurons.empty());
+    ASSERT_TRUE(Loaded->Regions.empty());
+    ASSERT_EQ(Loaded->BSCompartments.size(), 3u);
+    ASSERT_EQ(Loaded->BSCompartments[2].RestingPotential_mV, -62.0);
+}
+
+TEST_F(ModelFileTest, test_Save_rejects_BS_model) {
+    using namespace BG::NES::Simulator;
+
+    Simulation Sim(&Logger);
+    Geometries::Sphere S(Geometries::Vec3D(0.0, 0.0, 0.0), 1.0);
+    Compartments::BS C;
+    C.ShapeID = Sim.AddSphere(S);
+    ASSERT_EQ(Sim.AddSCCompartment(C, BSNEURONS), 0);
+
+    std::vector<uint8_t> Image;
+    ASSERT_FALSE(Sim.SaveModel(Image));
+    ASSERT_FALSE(Sim.SaveModel(Path("bs")));
+}
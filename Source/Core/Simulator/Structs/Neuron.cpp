@@ -146,14 +146,25 @@ float B_NMDA(float V, float Mg = 1.0) {
     return 1.0 / (1.0 + gamma * Mg * exp(-beta * V));
 }
 
-void LIFCReceptorData::Update_Conductance(float t, float Vm) {
-    auto& syn_times = SrcNeuronPtr->TAct_ms;
+// With event_driven, spikes are delivered into g_state by the simulation's
+// SpikeEventQueue and the presynaptic spike history is not read at all.
+void LIFCReceptorData::Update_Conductance(float t, float Vm, bool recursive, bool event_driven) {
+    float gnorm;
+    if (event_driven) {
+        gnorm = g_state.Advance(t, tau_rise_ms, tau_decay_ms, norm);
+        if (gnorm == 0.0) { // Quiescent, skip the Mg2+ block
+            g_k = 0.0;
+            return;
+        }
+    } else {
+        auto& syn_times = SrcNeuronPtr->TAct_ms;
+        gnorm = recursive ? g_state.Update(t, syn_times, tau_rise_ms, tau_decay_ms, norm, onset_delay_ms)
+                          : Connections::g_norm(t, syn_times, tau_rise_ms, tau_decay_ms, norm, onset_delay_ms);
+    }
     if (voltage_gated()) {
-        g_k = std::min(g_peak_sum_nS, B_NMDA(Vm) * weight * g_peak_sum_nS * 
-                     Connections::g_norm(t, syn_times, tau_rise_ms, tau_decay_ms, norm, onset_delay_ms));
+        g_k = std::min(g_peak_sum_nS, B_NMDA(Vm) * weight * g_peak_sum_nS * gnorm);
     } else {
-        g_k = std::min(g_peak_sum_nS, weight * g_peak_sum_nS * 
-                     Connections::g_norm(t, syn_times, tau_rise_ms, tau_decay_ms, norm, onset_delay_ms));
+        g_k = std::min(g_peak_sum_nS, weight * g_peak_sum_nS * gnorm);
     }
 }
 
@@ -162,7 +173,7 @@ void LIFCReceptorData::Update_Conductance(float t, float Vm) {
 void LIFCReceptorData::STDP_Update(float tfire) {
     if (STDP_Method() == Connections::STDPNONE) return;
 
-    float t_pre = static_cast<LIFCNeuron*>(SrcNeuronPtr)->t_last_spike;
+    float t_pre = static_cast<LIFCNeuron*>(SrcNeuronPtr)->t_last_spike_committed;
     if (t_pre < 0) return;
     
     float dt_spikes;
@@ -188,6 +199,40 @@ void LIFCReceptorData::STDP_Update(float tfire) {
     weight = std::max(0.0f, std::min(1.0f, weight));
 }
 
+void LIFCReceptorData::SaveState(Tools::CheckpointWriter& _Writer) const {
+    _Writer.Put(g_peak_sum_nS);
+    _Writer.Put(weight_g_peak_sum);
+    _Writer.Put(weight);
+    _Writer.Put(tau_rise_ms);
+    _Writer.Put(tau_decay_ms);
+    _Writer.Put(onset_delay_ms);
+    _Writer.Put(STDP_A_pos);
+    _Writer.Put(STDP_A_neg);
+    _Writer.Put(STDP_Tau_pos);
+    _Writer.Put(STDP_Tau_neg);
+    _Writer.Put(STDP_Shift);
+    _Writer.Put(norm);
+    _Writer.Put(g_k);
+    g_state.SaveState(_Writer);
+}
+
+bool LIFCReceptorData::LoadState(Tools::CheckpointReader& _Reader) {
+    _Reader.Get(g_peak_sum_nS);
+    _Reader.Get(weight_g_peak_sum);
+    _Reader.Get(weight);
+    _Reader.Get(tau_rise_ms);
+    _Reader.Get(tau_decay_ms);
+    _Reader.Get(onset_delay_ms);
+    _Reader.Get(STDP_A_pos);
+    _Reader.Get(STDP_A_neg);
+    _Reader.Get(STDP_Tau_pos);
+    _Reader.Get(STDP_Tau_neg);
+    _Reader.Get(STDP_Shift);
+    _Reader.Get(norm);
+    _Reader.Get(g_k);
+    return g_state.LoadState(_Reader);
+}
+
 std::string LIFCReceptorData::Show_Functional_Parameters() {
     std::stringstream paramstr;
 
@@ -268,6 +313,11 @@ void Neuron::Update(float t_ms, bool recording) {
     WARNWRONGOOPLEVEL();
 }
 
+// Neuron classes that do not double-buffer their spikes write directly
+// into TAct_ms, so there is nothing to commit.
+void Neuron::CommitSpikes() {
+}
+
 nlohmann::json Neuron::GetSpikeTimesJSON() const {
     nlohmann::json spiketimes;
     spiketimes["tSpike_ms"] = nlohmann::json(this->TAct_ms);
@@ -293,6 +343,23 @@ void Neuron::OutputTransmitterAdded(ReceptorData* RData) {
     WARNWRONGOOPLEVEL();
 }
 
+void Neuron::SaveState(Tools::CheckpointWriter& _Writer) const {
+    _Writer.PutVector(TAct_ms);
+    _Writer.PutVector(TDirectStim_ms);
+    _Writer.Put<uint64_t>(next_directstim_idx);
+    _Writer.Put(is_first_update);
+}
+
+bool Neuron::LoadState(Tools::CheckpointReader& _Reader) {
+    uint64_t next_idx = 0;
+    _Reader.GetVector(TAct_ms);
+    _Reader.GetVector(TDirectStim_ms);
+    if (!_Reader.Get(next_idx)) return false;
+    _Reader.Get(is_first_update);
+    next_directstim_idx = next_idx;
+    return _Reader.Ok();
+}
+
 std::string SCNeuronBase::str() const {
     std::stringstream ss;
     ss << "ID: " << ID;
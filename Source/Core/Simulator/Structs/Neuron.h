@@ -74,6 +74,7 @@ struct LIFCReceptorData: public ReceptorDataBase {
 
     float norm = 0.0; // Calculated once abstracted tau_rise_ms and tau_decay_ms are available
     float g_k = 0.0; // Calculated in Update_Conductance
+    Connections::DoubleExpState g_state; // Used instead of g_norm() with Simulation::use_recursive_conductances
 
     // A new LIFCReceptorData is created only where the data cannot be
     // added to an existing abstracted functional receptor connection.
@@ -95,10 +96,15 @@ struct LIFCReceptorData: public ReceptorDataBase {
 
     Connections::LIFCSTDPMethodEnum STDP_Method();
 
-    void Update_Conductance(float t, float Vm);
+    void Update_Conductance(float t, float Vm, bool recursive = false, bool event_driven = false);
 
     void STDP_Update(float tfire);
 
+    //! Checkpoint of the abstracted parameters, the STDP modified weight
+    //! and the conductance state.
+    void SaveState(Tools::CheckpointWriter& _Writer) const;
+    bool LoadState(Tools::CheckpointReader& _Reader);
+
     std::string Show_Functional_Parameters();
 
 };
@@ -173,6 +179,10 @@ struct Neuron {
 
     virtual void Update(float t_ms, bool recording);
 
+    //! Publishes spikes generated during the last Update() call in TAct_ms.
+    //! Called once all neurons have been updated for a timestep.
+    virtual void CommitSpikes();
+
     virtual nlohmann::json GetSpikeTimesJSON() const;
 
     virtual nlohmann::json GetRecordingJSON() const;
@@ -182,6 +192,11 @@ struct Neuron {
     virtual void InputReceptorAdded(ReceptorData* RData);
 
     virtual void OutputTransmitterAdded(ReceptorData* RData);
+
+    //! Writes and restores the dynamic state, see Simulation::SaveState().
+    //! Derived classes call these of their base class first.
+    virtual void SaveState(Tools::CheckpointWriter& _Writer) const;
+    virtual bool LoadState(Tools::CheckpointReader& _Reader);
 };
 
 //! NeuronRecording is an unordered map containing data from simulation in a
@@ -36,6 +36,92 @@ float g_norm(float t, const std::vector<float>& spike_times, float tau_rise, flo
     return gnorm / norm;
 }
 
+void DoubleExpState::Reset() {
+    a_rise = 0.0;
+    a_decay = 0.0;
+    t_last_ms = -1.0;
+    next_spike_idx = 0;
+    arrivals_ms.clear();
+}
+
+float DoubleExpState::Update(float t, const std::vector<float>& spike_times, float tau_rise, float tau_decay,
+                             float norm, float onset_delay) {
+    if ((t < t_last_ms) || (next_spike_idx > spike_times.size())) {
+        Reset();
+    }
+
+    // Queue spikes added since the last update. Spike times are increasing
+    // and the delay is constant, so the queue stays sorted.
+    for (; next_spike_idx < spike_times.size(); next_spike_idx++) {
+        arrivals_ms.push_back(spike_times[next_spike_idx] + onset_delay);
+    }
+
+    return Advance(t, tau_rise, tau_decay, norm, 0.0);
+}
+
+float DoubleExpState::Advance(float t, float tau_rise, float tau_decay, float norm, float quiescent_level) {
+    if (arrivals_ms.empty() && (std::fabs(a_rise) <= quiescent_level) && (std::fabs(a_decay) <= quiescent_level)) {
+        a_rise = 0.0;
+        a_decay = 0.0;
+        t_last_ms = t;
+        return 0.0;
+    }
+
+    // Decay the state of spikes that already arrived.
+    if (t_last_ms >= 0.0) {
+        float dt = t - t_last_ms;
+        if ((dt != cached_dt_ms) || (tau_rise != cached_tau_rise) || (tau_decay != cached_tau_decay)) {
+            cached_dt_ms = dt;
+            cached_tau_rise = tau_rise;
+            cached_tau_decay = tau_decay;
+            f_rise = exp(-dt / tau_rise);
+            f_decay = exp(-dt / tau_decay);
+        }
+        a_rise *= f_rise;
+        a_decay *= f_decay;
+    }
+    t_last_ms = t;
+
+    // Add spikes that arrived since the last update.
+    while ((!arrivals_ms.empty()) && (arrivals_ms.front() <= t)) {
+        float spike_dt = t - arrivals_ms.front();
+        a_rise += exp(-spike_dt / tau_rise);
+        a_decay += exp(-spike_dt / tau_decay);
+        arrivals_ms.pop_front();
+    }
+
+    return (a_decay - a_rise) / norm;
+}
+
+void DoubleExpState::SaveState(Tools::CheckpointWriter& _Writer) const {
+    _Writer.Put(a_rise);
+    _Writer.Put(a_decay);
+    _Writer.Put(t_last_ms);
+    _Writer.Put<uint64_t>(next_spike_idx);
+    _Writer.PutDeque(arrivals_ms);
+    _Writer.Put(cached_dt_ms);
+    _Writer.Put(cached_tau_rise);
+    _Writer.Put(cached_tau_decay);
+    _Writer.Put(f_rise);
+    _Writer.Put(f_decay);
+}
+
+bool DoubleExpState::LoadState(Tools::CheckpointReader& _Reader) {
+    uint64_t next_idx = 0;
+    _Reader.Get(a_rise);
+    _Reader.Get(a_decay);
+    _Reader.Get(t_last_ms);
+    if (!_Reader.Get(next_idx)) return false;
+    _Reader.GetDeque(arrivals_ms);
+    _Reader.Get(cached_dt_ms);
+    _Reader.Get(cached_tau_rise);
+    _Reader.Get(cached_tau_decay);
+    _Reader.Get(f_rise);
+    _Reader.Get(f_decay);
+    next_spike_idx = next_idx;
+    return _Reader.Ok();
+}
+
 std::string ReceptorBase::str() const {
     std::stringstream ss;
     ss << "ID: " << ID;
@@ -14,11 +14,14 @@
 #include <string>
 #include <sstream>
 #include <cstring>
+#include <deque>
+#include <vector>
 
 // Third-Party Libraries (BG convention: use <> instead of "")
 
 // Internal Libraries (BG convention: use <> instead of "")
 #include <Simulator/Geometries/VecTools.h>
+#include <Simulator/Structs/Checkpoint.h>
 
 namespace BG {
 namespace NES {
@@ -78,6 +81,51 @@ extern float compute_normalization(float tau_rise, float tau_decay);
 extern float g_norm(float t, const std::vector<float>& spike_times, float tau_rise, float tau_decay,
     float norm, float onset_delay, float spike_dt_delta = 1000, float history_delta = 0.001);
 
+/**
+ * @brief Recursive alternative to g_norm() for one spike train.
+ *
+ * Instead of summing over the spike history every timestep, the rise and
+ * decay terms of the double-exponential are kept as state variables that
+ * are multiplied by exp(-dt/tau) each update. The decay factors are cached
+ * and only recomputed when dt or a time constant changes. Spikes are picked
+ * up from the end of the spike_times vector and wait in an onset-delay queue
+ * until they arrive, at which point they are added with the exact partial
+ * decay since arrival. Each update is therefore O(1) plus the cost of the
+ * spikes that arrive during it.
+ *
+ * The state is rebuilt from the full spike history if time moves backwards
+ * or the spike_times vector shrinks, so it can be enabled at any time.
+ */
+struct DoubleExpState {
+    float a_rise = 0.0;              // Sum of exp(-(t-t_arrival)/tau_rise) over arrived spikes
+    float a_decay = 0.0;             // Sum of exp(-(t-t_arrival)/tau_decay) over arrived spikes
+    float t_last_ms = -1.0;          // Time of the last update, < 0 before the first one
+    size_t next_spike_idx = 0;       // Next element of spike_times not yet queued
+    std::deque<float> arrivals_ms;   // Onset-delay queue of spike arrival times
+
+    float cached_dt_ms = -1.0;
+    float cached_tau_rise = 0.0;
+    float cached_tau_decay = 0.0;
+    float f_rise = 1.0;              // exp(-cached_dt_ms/cached_tau_rise)
+    float f_decay = 1.0;             // exp(-cached_dt_ms/cached_tau_decay)
+
+    void Reset();
+
+    // Advances the state to t and returns the same value as
+    // g_norm(t, spike_times, tau_rise, tau_decay, norm, onset_delay).
+    float Update(float t, const std::vector<float>& spike_times, float tau_rise, float tau_decay,
+        float norm, float onset_delay);
+
+    // Same as Update(), but only uses arrivals that were added to
+    // arrivals_ms by the caller (see Updater::SpikeEventQueue). While no
+    // spikes are in flight and the conductance has decayed below
+    // quiescent_level the state is zeroed and no work is done.
+    float Advance(float t, float tau_rise, float tau_decay, float norm, float quiescent_level = 1e-6);
+
+    void SaveState(Tools::CheckpointWriter& _Writer) const;
+    bool LoadState(Tools::CheckpointReader& _Reader);
+};
+
 enum LIFCSTDPMethodEnum: int {
     STDPNONE = 0,
     STDPHEBBIAN = 1,
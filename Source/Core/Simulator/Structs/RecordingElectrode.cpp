@@ -1,5 +1,10 @@
 #include <Simulator/Structs/RecordingElectrode.h>
 
+#include <algorithm>
+#include <limits>
+
+#include <Simulator/Geometries/SpatialIndex.h>
+
 namespace BG {
 namespace NES {
 namespace Simulator {
@@ -10,11 +15,26 @@ RecordingElectrode::RecordingElectrode(RecordingElectrode & _Electrode
     ): Name(_Electrode.Name), ID(_Electrode.ID), TipPosition_um(_Electrode.TipPosition_um),
        EndPosition_um(_Electrode.EndPosition_um),
        Sites(_Electrode.Sites), SiteLocations_um(_Electrode.SiteLocations_um), NoiseLevel(_Electrode.NoiseLevel),
-       SensitivityDampening(_Electrode.SensitivityDampening), Sim(_Electrode.Sim) {
+       SensitivityDampening(_Electrode.SensitivityDampening), CutoffDistance_um(_Electrode.CutoffDistance_um),
+       Sim(_Electrode.Sim) {
     assert(Sim != nullptr);
     this->InitSystemCoordSiteLocations();
     this->InitNeuronReferencesAndDistances();
     this->InitRecords();
+    this->InitNoise();
+}
+
+RecordingElectrode::RecordingElectrode(const RecordingElectrode & _Electrode, Simulator::Simulation* _Sim
+    ): Name(_Electrode.Name), ID(_Electrode.ID), TipPosition_um(_Electrode.TipPosition_um),
+       EndPosition_um(_Electrode.EndPosition_um),
+       Sites(_Electrode.Sites), SiteLocations_um(_Electrode.SiteLocations_um), NoiseLevel(_Electrode.NoiseLevel),
+       SensitivityDampening(_Electrode.SensitivityDampening), CutoffDistance_um(_Electrode.CutoffDistance_um),
+       Sim(_Sim) {
+    assert(Sim != nullptr);
+    this->InitSystemCoordSiteLocations();
+    this->InitNeuronReferencesAndDistances();
+    this->InitRecords();
+    this->InitNoise();
 }
 
 RecordingElectrode::RecordingElectrode(Simulator::Simulation* _Sim): Sim(_Sim) {
@@ -23,6 +43,7 @@ RecordingElectrode::RecordingElectrode(Simulator::Simulation* _Sim): Sim(_Sim) {
     this->InitSystemCoordSiteLocations();
     this->InitNeuronReferencesAndDistances();
     this->InitRecords();
+    this->InitNoise();
 };
 
 RecordingElectrode::RecordingElectrode(
@@ -40,6 +61,7 @@ RecordingElectrode::RecordingElectrode(
     this->InitSystemCoordSiteLocations();
     this->InitNeuronReferencesAndDistances();
     this->InitRecords();
+    this->InitNoise();
 };
 
 //! 1. Get a vector from tip to end.
@@ -55,6 +77,7 @@ Geometries::Vec3D RecordingElectrode::CoordsElectrodeToSystem(Geometries::Vec3D
 };
 
 void RecordingElectrode::InitSystemCoordSiteLocations() {
+    this->SiteLocations_um.clear();
     for (auto &site : this->Sites) {
         Geometries::Vec3D coords = this->CoordsElectrodeToSystem(site);
         this->SiteLocations_um.emplace_back(coords);
@@ -63,20 +86,86 @@ void RecordingElectrode::InitSystemCoordSiteLocations() {
 
 void RecordingElectrode::InitNeuronReferencesAndDistances() {
     this->Neurons = this->Sim->GetAllNeurons();
+    this->SomaCenters_um.clear();
+    for (const auto & neuronPtr : this->Neurons) {
+        auto neuron = std::dynamic_pointer_cast<BallAndStick::BSNeuron>(neuronPtr);
+        assert(neuron);
+        this->SomaCenters_um.emplace_back(neuron->GetCellCenter());
+    }
+    this->ComputeSiteDistances(this->CutoffDistance_um);
+    this->BuildLeadField();
+};
+
+void RecordingElectrode::ComputeSiteDistances(float _Cutoff_um) {
+    this->NeuronSomaToSiteDistances_um2.clear();
+    this->DistancesCutoff_um = std::max(_Cutoff_um, 0.0f);
+
+    if (this->DistancesCutoff_um == 0.0) {
+        for (const auto &siteLocation_um : this->SiteLocations_um) {
+            std::vector<float> siteDistancesSq_um2{};
+            for (const auto &somaCoord_um : this->SomaCenters_um) {
+                float dist = somaCoord_um.Distance(siteLocation_um);
+                siteDistancesSq_um2.emplace_back(dist * dist);
+            }
+            this->NeuronSomaToSiteDistances_um2.emplace_back(siteDistancesSq_um2);
+        }
+        return;
+    }
+
+    std::vector<BoundingBox> somaPoints(this->SomaCenters_um.size());
+    for (size_t i = 0; i < somaPoints.size(); ++i) {
+        const Geometries::Vec3D &c = this->SomaCenters_um[i];
+        somaPoints[i] = BoundingBox{{c.x, c.y, c.z}, {c.x, c.y, c.z}};
+    }
+    Geometries::BoundingVolumeHierarchy somaIndex;
+    somaIndex.Build(somaPoints);
+
+    std::vector<size_t> nearby;
     for (const auto &siteLocation_um : this->SiteLocations_um) {
-        std::vector<float> siteDistancesSq_um2{};
-        for (const auto neuronPtr : this->Neurons) {
-            auto neuron = std::dynamic_pointer_cast<BallAndStick::BSNeuron>(neuronPtr);
-            assert(neuron);
-
-            auto somaCoord_um = neuron->GetCellCenter();
-            float dist = somaCoord_um.Distance(siteLocation_um);
-            siteDistancesSq_um2.emplace_back(dist * dist);
+        std::vector<float> siteDistancesSq_um2(this->SomaCenters_um.size(), std::numeric_limits<float>::infinity());
+        somaIndex.QueryRadius(siteLocation_um, this->DistancesCutoff_um, nearby);
+        for (size_t i : nearby) {
+            float dist = this->SomaCenters_um[i].Distance(siteLocation_um);
+            siteDistancesSq_um2[i] = dist * dist;
         }
         this->NeuronSomaToSiteDistances_um2.emplace_back(siteDistancesSq_um2);
     }
 };
 
+void RecordingElectrode::BuildLeadField() {
+    this->LeadField.clear();
+    this->LeadFieldNeuronIdx.clear();
+    this->LeadFieldRowStart.clear();
+    this->LeadFieldDampening = this->SensitivityDampening;
+    if (this->SensitivityDampening == 0.0) return; // See ElectricFieldPotential().
+
+    // Neurons beyond the cutoff the distances were measured with are needed now.
+    if ((this->DistancesCutoff_um > 0.0) && (!this->IsSparse() || (this->CutoffDistance_um > this->DistancesCutoff_um))) {
+        this->ComputeSiteDistances(this->CutoffDistance_um);
+    }
+
+    float cutoff_um2 = this->CutoffDistance_um * this->CutoffDistance_um;
+    if (this->IsSparse()) this->LeadFieldRowStart.emplace_back(0);
+    for (const auto &siteDistancesSq_um2 : this->NeuronSomaToSiteDistances_um2) {
+        for (size_t i = 0; i < siteDistancesSq_um2.size(); ++i) {
+            float d2 = siteDistancesSq_um2[i];
+            float weight = 1.0 / (std::max(d2, 1.0f) * this->SensitivityDampening);
+            if (!this->IsSparse()) {
+                this->LeadField.emplace_back(weight);
+            } else if (d2 <= cutoff_um2) {
+                this->LeadField.emplace_back(weight);
+                this->LeadFieldNeuronIdx.emplace_back(uint32_t(i));
+            }
+        }
+        if (this->IsSparse()) this->LeadFieldRowStart.emplace_back(this->LeadField.size());
+    }
+};
+
+//! Each electrode gets its own reproducible noise sequence.
+void RecordingElectrode::InitNoise() {
+    this->NoiseGen.SetSeed((uint64_t(uint32_t(this->Sim->RandomSeed)) << 32) | uint32_t(this->ID));
+};
+
 void RecordingElectrode::InitRecords() {
     this->E_mV.clear();
     for (size_t i = 0; i < this->Sites.size(); ++i)
@@ -84,27 +173,57 @@ void RecordingElectrode::InitRecords() {
 };
 
 float RecordingElectrode::AddNoise() {
-    return this->NoiseLevel * ((rand() % 100) / 100.0 - 0.5);
+    return this->NoiseLevel * (this->NoiseGen.UniformRandomFloat() - 0.5f);
 };
 
+void RecordingElectrode::GatherMembranePotentials(const std::vector<std::shared_ptr<CoreStructs::Neuron>>& _Neurons, std::vector<float>& _Vm_mV) {
+    _Vm_mV.resize(_Neurons.size());
+    for (size_t i = 0; i < _Neurons.size(); ++i) {
+        // All neuron classes derive from BSNeuron (see InitNeuronReferencesAndDistances).
+        _Vm_mV[i] = static_cast<BallAndStick::BSNeuron*>(_Neurons[i].get())->Vm();
+    }
+};
+
+// Eight independent partial sums, so that the compiler can vectorize
+// without reassociating a single sum.
+static float DotProduct(const float* a, const float* b, size_t n) {
+    float partial[8] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        for (size_t j = 0; j < 8; ++j) partial[j] += a[i + j] * b[i + j];
+    }
+    float sum = 0.0;
+    for (; i < n; ++i) sum += a[i] * b[i];
+    for (size_t j = 0; j < 8; ++j) sum += partial[j];
+    return sum;
+}
+
 //! Calculate the electric field potential at the electrode site as
 //! a combination of the effects of nearby neurons.
 float RecordingElectrode::ElectricFieldPotential(size_t siteIdx) {
+    GatherMembranePotentials(this->Neurons, this->Vm_mV);
+    return this->ElectricFieldPotential(siteIdx, this->Vm_mV.data());
+};
+
+//! _Vm_mV must hold at least the membrane potentials of Neurons.
+float RecordingElectrode::ElectricFieldPotential(size_t siteIdx, const float* _Vm_mV) {
     if (this->SensitivityDampening == 0.0)
         throw std::overflow_error(
             "Cannot divide by zero. (SensitivityDampening)");
     if (siteIdx >= this->NeuronSomaToSiteDistances_um2.size())
         throw std::out_of_range("Out of bounds. (siteIdx)");
+    if (this->SensitivityDampening != this->LeadFieldDampening)
+        this->BuildLeadField();
 
-    float Ei_mV = 0.0;
-    auto siteDistances_um = this->NeuronSomaToSiteDistances_um2[siteIdx];
-
-    for (size_t i = 0; i < this->Neurons.size(); ++i) {
-        float Vm_mV = std::dynamic_pointer_cast<BG::NES::Simulator::BallAndStick::BSNeuron>
-            (this->Neurons[i])->Vm_mV;
-
-        float Ei_n_mV = (siteDistances_um[i] <= 1.0) ? Vm_mV : Vm_mV / siteDistances_um[i];
-        Ei_mV += (Ei_n_mV / this->SensitivityDampening);
+    float Ei_mV;
+    if (this->IsSparse()) {
+        Ei_mV = 0.0;
+        for (size_t k = this->LeadFieldRowStart[siteIdx]; k < this->LeadFieldRowStart[siteIdx + 1]; ++k) {
+            Ei_mV += this->LeadField[k] * _Vm_mV[this->LeadFieldNeuronIdx[k]];
+        }
+    } else {
+        size_t numNeurons = this->Neurons.size();
+        Ei_mV = DotProduct(this->LeadField.data() + siteIdx * numNeurons, _Vm_mV, numNeurons);
     }
 
     Ei_mV += this->AddNoise();
@@ -113,10 +232,16 @@ float RecordingElectrode::ElectricFieldPotential(size_t siteIdx) {
 };
 
 void RecordingElectrode::Record(float t_ms) {
+    GatherMembranePotentials(this->Neurons, this->Vm_mV);
+    this->Record(t_ms, this->Vm_mV);
+};
+
+void RecordingElectrode::Record(float t_ms, const std::vector<float>& _Vm_mV) {
     assert(t_ms >= 0.0);
+    assert(_Vm_mV.size() >= this->Neurons.size());
     this->TRecorded_ms.emplace_back(t_ms);
     for (size_t i = 0; i < this->SiteLocations_um.size(); ++i) {
-        float Ei_mV = this->ElectricFieldPotential(i);
+        float Ei_mV = this->ElectricFieldPotential(i, _Vm_mV.data());
         (this->E_mV[i]).emplace_back(Ei_mV);
     }
 };
@@ -140,6 +265,17 @@ nlohmann::json RecordingElectrode::GetRecordingJSON() const {
     return data;
 }
 
+nlohmann::json RecordingElectrode::GetRecordingJSON(size_t _NumLatest) const {
+    nlohmann::json data;
+
+    data["E_mV"] = nlohmann::json::array();
+    for (unsigned int i = 0; i < this->E_mV.size(); i++) {
+        data["E_mV"][i] = LatestJSON(this->E_mV[i], _NumLatest);
+    }
+
+    return data;
+}
+
 }; // namespace Tools
 }; // namespace Simulator
 }; // namespace NES
@@ -12,6 +12,7 @@
 
 // Standard Libraries (BG convention: use <> instead of "")
 #include <cassert>
+#include <cstdint>
 #include <memory>
 #include <random>
 #include <string>
@@ -21,8 +22,10 @@
 
 // Internal Libraries (BG convention: use <> instead of "")
 #include <Simulator/BallAndStick/BSNeuron.h>
+#include <Simulator/Distributions/FastRandom.h>
 #include <Simulator/Geometries/VecTools.h>
 #include <Simulator/Structs/Neuron.h>
+#include <Simulator/Structs/RecordingRetention.h>
 #include <Simulator/Structs/Simulation.h>
 
 namespace BG {
@@ -41,7 +44,7 @@ namespace Tools {
 struct RecordingElectrode {
 
     std::string Name;
-    int ID;
+    int ID = 0;
 
     Geometries::Vec3D TipPosition_um{0.0, 0.0, 0.0};
     Geometries::Vec3D EndPosition_um{0.0, 0.0, 5.0f};
@@ -50,16 +53,33 @@ struct RecordingElectrode {
 
     float NoiseLevel = 1.0;
     float SensitivityDampening = 2.0;
+    float CutoffDistance_um = 0.0; //! Neurons further from a site are ignored, 0 means no cutoff.
 
     Simulator::Simulation* Sim;
     std::vector<Geometries::Vec3D> SiteLocations{}; //! In Simulation coordinate system
     std::vector<std::shared_ptr<CoreStructs::Neuron>> Neurons{};
     std::vector<std::vector<float>> NeuronSomaToSiteDistances_um2{}; //!  [ (d_s1n1, d_s1n2, ...), (d_s2n1, d_s2n2, ...), ...]
+    std::vector<Geometries::Vec3D> SomaCenters_um{}; //! GetCellCenter() of every neuron in Neurons
+    float DistancesCutoff_um = 0.0; //! Distances beyond this are +infinity instead of exact, 0 means all are exact
     std::vector<float> TRecorded_ms{};   //! [ t0, t1, ... ]
+    size_t NumDropped = 0;               //! Samples dropped from the front of TRecorded_ms and E_mV by the retention limit
     std::vector<std::vector<float>> E_mV{}; //! [ [E1(t0), E1(t1), ...], [E2(t0), E2(t1), ...], ...]
 
+    // Lead field: weight of each neuron's Vm at each site, 1/(max(d^2, 1)*SensitivityDampening).
+    // Dense row-major [site][neuron] without a cutoff, otherwise sparse rows
+    // holding only the neurons within CutoffDistance_um.
+    std::vector<float> LeadField{};
+    std::vector<uint32_t> LeadFieldNeuronIdx{}; //! Sparse only: neuron index of every weight
+    std::vector<size_t> LeadFieldRowStart{};    //! Sparse only: first weight of every site, size sites+1
+    float LeadFieldDampening = 0.0;             //! SensitivityDampening that LeadField was built with
+    std::vector<float> Vm_mV{};                 //! Scratch for Record(t_ms)
+
+    Distributions::FastRandom NoiseGen;
+
     //! Constructors
     RecordingElectrode(RecordingElectrode & _Electrode);
+    //! Same configuration as _Electrode, placed in _Sim (e.g. a clone).
+    RecordingElectrode(const RecordingElectrode & _Electrode, Simulator::Simulation* _Sim);
     RecordingElectrode(Simulator::Simulation* _Sim);
     RecordingElectrode(
         int _ID,
@@ -76,15 +96,38 @@ struct RecordingElectrode {
 
     void InitSystemCoordSiteLocations();
     void InitNeuronReferencesAndDistances();
+
+    //! Fills NeuronSomaToSiteDistances_um2 from SomaCenters_um. With a cutoff
+    //! only neurons within it of a site are found (through a spatial index of
+    //! the somas) and measured, the others are set to +infinity.
+    void ComputeSiteDistances(float _Cutoff_um);
     void InitRecords();
+    void InitNoise();
     float AddNoise();
 
+    //! Folds distances and SensitivityDampening into LeadField. Called by
+    //! InitNeuronReferencesAndDistances() and again if SensitivityDampening
+    //! was changed. Distances are measured again if CutoffDistance_um was
+    //! raised or removed since.
+    void BuildLeadField();
+    bool IsSparse() const { return CutoffDistance_um > 0.0; }
+
+    //! Copies the membrane potentials of _Neurons into a contiguous array.
+    static void GatherMembranePotentials(const std::vector<std::shared_ptr<CoreStructs::Neuron>>& _Neurons, std::vector<float>& _Vm_mV);
+
     //! Calculate the electric field potential at the electrode site as
     //! a combination of the effects of nearby neurons.
     float ElectricFieldPotential(size_t siteIdx);
+    float ElectricFieldPotential(size_t siteIdx, const float* _Vm_mV);
     void Record(float t_ms);
+
+    //! Records all sites from membrane potentials gathered with
+    //! GatherMembranePotentials() for all neurons of the simulation, so that
+    //! several electrodes can share one gathered array.
+    void Record(float t_ms, const std::vector<float>& _Vm_mV);
     std::unordered_map<std::string, std::vector<std::vector<float>>> GetRecording();
     nlohmann::json GetRecordingJSON() const;
+    nlohmann::json GetRecordingJSON(size_t _NumLatest) const; //! Only the last _NumLatest samples
 };
 
 }; // namespace Tools
@@ -7,45 +7,74 @@
    struct. Additional Notes: None Date Created: 2023-10-13
 */
 
-#include <Simulator/BallAndStick/BSAlignedBrainRegion.h>
-#include <Simulator/BallAndStick/BSAlignedNC.h>
-#include <Simulator/Geometries/Box.h>
+#include <BG/Common/Logger/Logger.h>
+#include <Simulator/Geometries/Sphere.h>
 #include <Simulator/Geometries/VecTools.h>
 #include <Simulator/Structs/RecordingElectrode.h>
 #include <Simulator/Structs/CalciumImaging.h>
 #include <Simulator/Structs/Simulation.h>
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <cmath>
+#include <limits>
 #include <memory>
 #include <tuple>
 #include <vector>
 
 /**
- * @brief Test class for unit tests for the RecordingElectrode struct.
+ * @brief Test class for unit tests for the RecordingElectrode struct. Builds
+ * BS neurons at increasing distances from an electrode with three sites.
  *
  */
 
 struct RecordingElectrodeTest : testing::Test {
-    BG::NES::Simulator::Geometries::GeometryCollection Collection;
+    BG::Common::Logger::LoggingSystem Logger;
 
     std::unique_ptr<BG::NES::Simulator::Tools::RecordingElectrode> testElectrode{};
-    std::shared_ptr<BG::NES::Simulator::CoreStructs::NeuralCircuit> testNC{};
-    std::shared_ptr<BG::NES::Simulator::BallAndStick::BSAlignedBrainRegion> testRegion{};
-    std::shared_ptr<BG::NES::Simulator::Simulation> testSim{};
+    std::unique_ptr<BG::NES::Simulator::Simulation> testSim{};
+
+    static constexpr int NumNeurons = 8;
 
     float tol = 1e-3;
 
-    void SetUp() {
-        testSim = std::make_shared<BG::NES::Simulator::Simulation>(nullptr);  // this will fail an assert when we try and use the logger fyi
-        testNC = std::make_shared<BG::NES::Simulator::BallAndStick::BSAlignedNC>(4000, 2, &Collection);
-        auto testBSAlignedNC = std::dynamic_pointer_cast<BG::NES::Simulator::BallAndStick::BSAlignedNC>(testNC);
-        testRegion = std::make_shared<BG::NES::Simulator::BallAndStick::BSAlignedBrainRegion>(3000, &Collection.AddBox(BG::NES::Simulator::Geometries::Vec3D(0.0, 0.0, 0.0), BG::NES::Simulator::Geometries::Vec3D(20.0, 20.0, 20.0)), testBSAlignedNC);
+    void AddBSNeuron(BG::NES::Simulator::Geometries::Vec3D _Center_um, float _Vm_mV) {
+        using namespace BG::NES::Simulator;
+        Geometries::Sphere S(_Center_um, 2.0);
+        Compartments::BS C;
+        C.ShapeID = testSim->AddSphere(S);
+        C.MembranePotential_mV = _Vm_mV;
+        C.SpikeThreshold_mV = -50.0;
+        C.DecayTime_ms = 30.0;
+        C.RestingPotential_mV = -60.0;
+        C.AfterHyperpolarizationAmplitude_mV = -10.0;
+        int SomaID = testSim->AddSCCompartment(C, BSNEURONS);
+
+        CoreStructs::BSNeuronStruct N;
+        N.SomaCompartmentID = SomaID;
+        N.AxonCompartmentID = SomaID;
+        N.MembranePotential_mV = _Vm_mV;
+        N.RestingPotential_mV = -60.0;
+        N.SpikeThreshold_mV = -50.0;
+        N.DecayTime_ms = 30.0;
+        N.AfterHyperpolarizationAmplitude_mV = -10.0;
+        N.PostsynapticPotentialRiseTime_ms = 5.0;
+        N.PostsynapticPotentialDecayTime_ms = 25.0;
+        N.PostsynapticPotentialAmplitude_nA = 1.0;
+        N.SomaCompartmentPtr = testSim->FindBSCompartmentByID(SomaID);
+        N.AxonCompartmentPtr = N.SomaCompartmentPtr;
+        testSim->AddBSNeuron(N);
+    }
 
-        testSim->AddCircuit(testNC);
-        testSim->AddRegion(testRegion);
+    void SetUp() {
+        using namespace BG::NES::Simulator;
+        testSim = std::make_unique<Simulation>(&Logger);
+        for (int i = 0; i < NumNeurons; i++) {
+            AddBSNeuron(Geometries::Vec3D(3.0 + 5.0 * i, 1.0 * i, -2.0), -60.0 + i);
+        }
 
-        testElectrode = std::make_unique<BG::NES::Simulator::Tools::RecordingElectrode>(testSim.get());
+        std::vector<Geometries::Vec3D> Sites{{0.0, 0.0, 0.0}, {0.0, 0.0, 0.5}, {0.0, 0.0, 1.0}};
+        testElectrode = std::make_unique<Tools::RecordingElectrode>(0, Geometries::Vec3D(0.0, 0.0, 0.0), Geometries::Vec3D(0.0, 0.0, 5.0), Sites, 1.0, 2.0, testSim.get());
     }
 
     void TearDown() { return; }
@@ -118,12 +147,8 @@ TEST_F(RecordingElectrodeTest, test_ElectricFieldPotential_default) {
     for (size_t i = 0; i < testElectrode->Neurons.size(); ++i) {
         float Vm_mV = std::dynamic_pointer_cast<BG::NES::Simulator::BallAndStick::BSNeuron>(testElectrode->Neurons[i])->Vm_mV;
 
-        if (siteDistances_um[i] <= 1.0)
-            expectedE_mV = Vm_mV;
-        else {
-            expectedE_mV = Vm_mV / siteDistances_um[i];
-            expectedE_mV += (expectedE_mV / testElectrode->SensitivityDampening);
-        }
+        float expectedE_n_mV = (siteDistances_um[i] <= 1.0) ? Vm_mV : Vm_mV / siteDistances_um[i];
+        expectedE_mV += expectedE_n_mV / testElectrode->SensitivityDampening;
     }
     float lowerLim = expectedE_mV - 0.5 * testElectrode->NoiseLevel;
     float upperLim = expectedE_mV + 0.5 * testElectrode->NoiseLevel;
@@ -163,3 +188,82 @@ TEST_F(RecordingElectrodeTest, test_GetRecording_default) {
         ASSERT_EQ(E_mVVec.size(), 3);
     }
 }
+
+TEST_F(RecordingElectrodeTest, test_LeadField_sparse_matches_dense) {
+    testElectrode->NoiseLevel = 0.0;
+    size_t numSites = testElectrode->SiteLocations_um.size();
+    ASSERT_EQ(testElectrode->LeadField.size(), numSites * testElectrode->Neurons.size());
+
+    std::vector<float> denseE_mV;
+    for (size_t i = 0; i < numSites; ++i) denseE_mV.emplace_back(testElectrode->ElectricFieldPotential(i));
+
+    // A cutoff beyond all neurons keeps every weight.
+    testElectrode->CutoffDistance_um = 1e6;
+    testElectrode->BuildLeadField();
+    ASSERT_EQ(testElectrode->LeadFieldRowStart.size(), numSites + 1);
+    for (size_t i = 0; i < numSites; ++i)
+        ASSERT_NEAR(testElectrode->ElectricFieldPotential(i), denseE_mV[i], tol);
+
+    // A cutoff below all distances leaves no weights.
+    testElectrode->CutoffDistance_um = 1e-6;
+    testElectrode->BuildLeadField();
+    for (size_t i = 0; i < numSites; ++i) {
+        float d2_min = *std::min_element(testElectrode->NeuronSomaToSiteDistances_um2[i].begin(), testElectrode->NeuronSomaToSiteDistances_um2[i].end());
+        if (d2_min > 1e-12) ASSERT_EQ(testElectrode->ElectricFieldPotential(i), 0.0);
+    }
+}
+
+TEST_F(RecordingElectrodeTest, test_Cutoff_at_init_measures_only_nearby_neurons) {
+    testElectrode->NoiseLevel = 0.0;
+    size_t numSites = testElectrode->SiteLocations_um.size();
+    auto denseDistances_um2 = testElectrode->NeuronSomaToSiteDistances_um2;
+
+    // A cutoff between the nearest and the furthest neuron.
+    float d2_min = std::numeric_limits<float>::infinity(), d2_max = 0.0;
+    for (const auto &row : denseDistances_um2) {
+        d2_min = std::min(d2_min, *std::min_element(row.begin(), row.end()));
+        d2_max = std::max(d2_max, *std::max_element(row.begin(), row.end()));
+    }
+    float cutoff_um = std::sqrt(0.5 * (d2_min + d2_max));
+    size_t numNear = 0, numFar = 0;
+    for (const auto &row : denseDistances_um2) {
+        for (float d2 : row) (d2 <= cutoff_um * cutoff_um) ? ++numNear : ++numFar;
+    }
+    ASSERT_GT(numNear, 0);
+    ASSERT_GT(numFar, 0);
+
+    testElectrode->CutoffDistance_um = cutoff_um;
+    testElectrode->BuildLeadField();
+    std::vector<float> sparseE_mV;
+    for (size_t i = 0; i < numSites; ++i) sparseE_mV.emplace_back(testElectrode->ElectricFieldPotential(i));
+
+    // Measured through the soma index, neurons beyond the cutoff are not measured.
+    testElectrode->InitNeuronReferencesAndDistances();
+    for (size_t i = 0; i < numSites; ++i) {
+        for (size_t n = 0; n < testElectrode->Neurons.size(); ++n) {
+            if (denseDistances_um2[i][n] <= cutoff_um * cutoff_um) {
+                ASSERT_NEAR(testElectrode->NeuronSomaToSiteDistances_um2[i][n], denseDistances_um2[i][n], tol);
+            } else {
+                ASSERT_TRUE(std::isinf(testElectrode->NeuronSomaToSiteDistances_um2[i][n]));
+            }
+        }
+        ASSERT_NEAR(testElectrode->ElectricFieldPotential(i), sparseE_mV[i], tol);
+    }
+
+    // An electrode built with the cutoff, e.g. in a clone, measures the same.
+    BG::NES::Simulator::Tools::RecordingElectrode builtWithCutoff(*testElectrode, testSim.get());
+    ASSERT_EQ(builtWithCutoff.DistancesCutoff_um, cutoff_um);
+    for (size_t i = 0; i < numSites; ++i) {
+        ASSERT_EQ(builtWithCutoff.NeuronSomaToSiteDistances_um2[i], testElectrode->NeuronSomaToSiteDistances_um2[i]);
+        ASSERT_NEAR(builtWithCutoff.ElectricFieldPotential(i), sparseE_mV[i], tol);
+    }
+
+    // Removing the cutoff measures all neurons again.
+    testElectrode->CutoffDistance_um = 0.0;
+    testElectrode->BuildLeadField();
+    for (size_t i = 0; i < numSites; ++i) {
+        for (size_t n = 0; n < testElectrode->Neurons.size(); ++n) {
+            ASSERT_NEAR(testElectrode->NeuronSomaToSiteDistances_um2[i][n], denseDistances_um2[i][n], tol);
+        }
+    }
+}
@@ -0,0 +1,77 @@
+//=================================================================//
+// This file is part of the BrainGenix-NES Neuron Emulation System //
+//=================================================================//
+
+/*
+    Description: This file provides helpers for bounded recording histories and cursor based polling.
+    Additional Notes: None
+    Date Created: 2026-10-17
+*/
+
+#pragma once
+
+// Standard Libraries (BG convention: use <> instead of "")
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+// Third-Party Libraries (BG convention: use <> instead of "")
+#include <nlohmann/json.hpp>
+
+// Internal Libraries (BG convention: use <> instead of "")
+
+
+namespace BG {
+namespace NES {
+namespace Simulator {
+namespace Tools {
+
+/**
+ * @brief Returns how many of the oldest samples of a series of _Size samples
+ * to drop under a retention limit of _MaxSamples (0 means no limit).
+ *
+ * Samples are only dropped once the series holds twice the limit, so that
+ * erasing from the front of a vector costs O(1) amortized per sample while
+ * the series stays contiguous. Between _MaxSamples and 2*_MaxSamples
+ * samples are retained.
+ */
+inline size_t RetentionExcess(size_t _Size, size_t _MaxSamples) {
+    if ((_MaxSamples == 0) || (_Size < 2 * _MaxSamples)) return 0;
+    return _Size - _MaxSamples;
+}
+
+/**
+ * @brief Erases up to _Num samples from the front of _Series.
+ */
+template <typename T>
+void DropOldest(std::vector<T>& _Series, size_t _Num) {
+    _Series.erase(_Series.begin(), _Series.begin() + std::min(_Num, _Series.size()));
+}
+
+/**
+ * @brief Returns the last _Num samples of _Series (or all of them if there
+ * are fewer) as a JSON array.
+ *
+ * Series recorded alongside a time series end at the same sample, so taking
+ * the same number of latest samples keeps them aligned even if one of them
+ * started later.
+ */
+template <typename T>
+nlohmann::json LatestJSON(const std::vector<T>& _Series, size_t _Num) {
+    return nlohmann::json(std::vector<T>(_Series.end() - std::min(_Num, _Series.size()), _Series.end()));
+}
+
+/**
+ * @brief Number of samples recorded after sample index _Cursor, given the
+ * total number ever recorded and the number still retained. Samples that
+ * were already dropped are skipped.
+ */
+inline size_t SamplesSinceCursor(size_t _Cursor, size_t _NumTotal, size_t _NumRetained) {
+    if (_Cursor >= _NumTotal) return 0;
+    return std::min(_NumTotal - _Cursor, _NumRetained);
+}
+
+}; // namespace Tools
+}; // namespace Simulator
+}; // namespace NES
+}; // namespace BG
@@ -0,0 +1,312 @@
+//=================================================================//
+// This file is part of the BrainGenix-NES Neuron Emulation System //
+//=================================================================//
+
+/*
+    Description: This file provides unit tests for recording retention and cursor based polling.
+    Additional Notes: None
+    Date Created: 2026-10-17
+*/
+
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <BG/Common/Logger/Logger.h>
+#include <Simulator/Geometries/Sphere.h>
+#include <Simulator/Structs/Simulation.h>
+#include <Simulator/Structs/RecordingElectrode.h>
+#include <Simulator/Structs/CalciumImaging.h>
+#include <Simulator/Structs/RecordingRetention.h>
+#include <Simulator/BallAndStick/BSNeuron.h>
+
+
+TEST(RecordingRetentionTest, test_RetentionExcess) {
+    using BG::NES::Simulator::Tools::RetentionExcess;
+
+    // No limit.
+    ASSERT_EQ(RetentionExcess(0, 0), 0);
+    ASSERT_EQ(RetentionExcess(1000000, 0), 0);
+
+    // Nothing is dropped below twice the limit, then back down to the limit.
+    ASSERT_EQ(RetentionExcess(0, 10), 0);
+    ASSERT_EQ(RetentionExcess(10, 10), 0);
+    ASSERT_EQ(RetentionExcess(19, 10), 0);
+    ASSERT_EQ(RetentionExcess(20, 10), 10);
+    ASSERT_EQ(RetentionExcess(25, 10), 15);
+    ASSERT_EQ(RetentionExcess(2, 1), 1);
+}
+
+TEST(RecordingRetentionTest, test_DropOldest) {
+    using BG::NES::Simulator::Tools::DropOldest;
+
+    std::vector<int> Series = {1, 2, 3, 4, 5};
+    DropOldest(Series, 0);
+    ASSERT_EQ(Series, std::vector<int>({1, 2, 3, 4, 5}));
+    DropOldest(Series, 2);
+    ASSERT_EQ(Series, std::vector<int>({3, 4, 5}));
+    DropOldest(Series, 10);
+    ASSERT_TRUE(Series.empty());
+    DropOldest(Series, 1);
+    ASSERT_TRUE(Series.empty());
+}
+
+TEST(RecordingRetentionTest, test_LatestJSON) {
+    using BG::NES::Simulator::Tools::LatestJSON;
+
+    std::vector<float> Series = {0.5, 1.5, 2.5};
+    ASSERT_EQ(LatestJSON(Series, 0), nlohmann::json::array());
+    ASSERT_EQ(LatestJSON(Series, 2), nlohmann::json({1.5, 2.5}));
+    ASSERT_EQ(LatestJSON(Series, 3), nlohmann::json({0.5, 1.5, 2.5}));
+    ASSERT_EQ(LatestJSON(Series, 7), nlohmann::json({0.5, 1.5, 2.5}));
+    ASSERT_EQ(LatestJSON(std::vector<float>(), 3), nlohmann::json::array());
+}
+
+TEST(RecordingRetentionTest, test_SamplesSinceCursor) {
+    using BG::NES::Simulator::Tools::SamplesSinceCursor;
+
+    // Nothing dropped.
+    ASSERT_EQ(SamplesSinceCursor(0, 10, 10), 10);
+    ASSERT_EQ(SamplesSinceCursor(7, 10, 10), 3);
+
+    // 30 recorded, 12 retained: the samples from index 18 on.
+    ASSERT_EQ(SamplesSinceCursor(25, 30, 12), 5);
+    ASSERT_EQ(SamplesSinceCursor(18, 30, 12), 12);
+    ASSERT_EQ(SamplesSinceCursor(10, 30, 12), 12); // Dropped samples are skipped.
+    ASSERT_EQ(SamplesSinceCursor(0, 30, 12), 12);
+
+    // At or beyond the end.
+    ASSERT_EQ(SamplesSinceCursor(30, 30, 12), 0);
+    ASSERT_EQ(SamplesSinceCursor(31, 30, 12), 0);
+    ASSERT_EQ(SamplesSinceCursor(0, 0, 0), 0);
+}
+
+
+/**
+ * @brief Test class for the cursor variants of Simulation::GetRecordingJSON()
+ * and Simulation::GetSpikeTimesJSON(). Compares polled recordings of a
+ * network under a retention limit with a complete recording of the same
+ * network.
+ */
+
+struct RecordingCursorTest : testing::Test {
+    BG::Common::Logger::LoggingSystem Logger;
+
+    static constexpr int NumNeurons = 12;
+    static constexpr int NumReceptors = 48;
+    static constexpr size_t MaxSamples = 40;
+
+    std::unique_ptr<BG::NES::Simulator::Simulation> MakeNetwork() {
+        using namespace BG::NES::Simulator;
+
+        auto Sim = std::make_unique<Simulation>(&Logger);
+        Sim->SetRandomSeed(21);
+        Sim->Dt_ms = 0.25;
+
+        std::vector<int> CompartmentIDs;
+        for (int i = 0; i < NumNeurons; i++) {
+            Geometries::Sphere S(Geometries::Vec3D(10.0*i, 0.0, 0.0), 2.0);
+            int ShapeID = Sim->AddSphere(S);
+
+            Compartments::LIFC C;
+            C.ShapeID = ShapeID;
+            C.RestingPotential_mV = -60.0;
+            C.ResetPotential_mV = -55.0;
+            C.SpikeThreshold_mV = -50.0;
+            C.MembraneResistance_MOhm = 100.0;
+            C.MembraneCapacitance_pF = 100.0;
+            C.AfterHyperpolarizationAmplitude_mV = 0.0;
+            CompartmentIDs.push_back(Sim->AddLIFCCompartment(C));
+
+            CoreStructs::LIFCNeuronStruct N;
+            N.RestingPotential_mV = -60.0;
+            N.ResetPotential_mV = -55.0;
+            N.SpikeThreshold_mV = -50.0;
+            N.MembraneResistance_MOhm = 100.0;
+            N.MembraneCapacitance_pF = 100.0;
+            N.RefractoryPeriod_ms = 2.0;
+            N.SpikeDepolarization_mV = 30.0;
+            N.UpdateMethod = CoreStructs::EXPEULER_CM;
+            N.ResetMethod = CoreStructs::TOVM;
+            N.AfterHyperpolarizationReversalPotential_mV = -90.0;
+            N.FastAfterHyperpolarizationRise_ms = 2.5;
+            N.FastAfterHyperpolarizationDecay_ms = 30.0;
+            N.FastAfterHyperpolarizationPeakConductance_nS = 3.0;
+            N.FastAfterHyperpolarizationMaxPeakConductance_nS = 10.0;
+            N.FastAfterHyperpolarizationHalfActConstant = 0.5;
+            N.SlowAfterHyperpolarizationRise_ms = 30.0;
+            N.SlowAfterHyperpolarizationDecay_ms = 300.0;
+            N.SlowAfterHyperpolarizationPeakConductance_nS = 1.0;
+            N.SlowAfterHyperpolarizationMaxPeakConductance_nS = 5.0;
+            N.SlowAfterHyperpolarizationHalfActConstant = 0.5;
+            N.AfterHyperpolarizationSaturationModel = CoreStructs::AHPCLIP;
+            N.FatigueThreshold = 300.0;
+            N.FatigueRecoveryTime_ms = 1000.0;
+            N.AfterDepolarizationReversalPotential_mV = -20.0;
+            N.AfterDepolarizationRise_ms = 20.0;
+            N.AfterDepolarizationDecay_ms = 200.0;
+            N.AfterDepolarizationPeakConductance_nS = 0.3;
+            N.AfterDepolarizationSaturationMultiplier = 2.0;
+            N.AfterDepolarizationRecoveryTime_ms = 300.0;
+            N.AfterDepolarizationDepletion = 0.3;
+            N.AfterDepolarizationSaturationModel = CoreStructs::ADPCLIP;
+            N.AdaptiveThresholdDiffPerSpike = 0.2;
+            N.AdaptiveTresholdRecoveryTime_ms = 50.0;
+            N.AdaptiveThresholdDiffPotential_mV = 10.0;
+            N.AdaptiveThresholdFloor_mV = -50.0;
+            N.AdaptiveThresholdFloorDeltaPerSpike_mV = 1.0;
+            N.AdaptiveThresholdFloorRecoveryTime_ms = 500.0;
+            N.SomaCompartmentIDs.push_back(CompartmentIDs.back());
+            Sim->AddLIFCNeuron(N);
+        }
+
+        std::mt19937 Generator(13);
+        std::uniform_int_distribution<int> Neuron(0, NumNeurons - 1);
+        for (int i = 0; i < NumReceptors; i++) {
+            Connections::LIFCReceptor R;
+            R.SourceCompartmentID = CompartmentIDs[Neuron(Generator)];
+            R.DestinationCompartmentID = CompartmentIDs[Neuron(Generator)];
+            bool Inhibitory = (i % 3) == 0;
+            R.ReversalPotential_mV = Inhibitory ? -70.0 : 0.0;
+            R.PSPRise_ms = 0.5;
+            R.PSPDecay_ms = 3.0;
+            R.PeakConductance_nS = Inhibitory ? 20.0 : 10.0;
+            R.Weight = 1.0;
+            R.OnsetDelay_ms = 1.0;
+            R.Neurotransmitter = Inhibitory ? Connections::GABA : Connections::AMPA;
+            R.STDP_Method = Connections::STDPNONE;
+            Sim->AddLIFCReceptor(R);
+        }
+
+        for (auto & Neuron : Sim->Neurons) {
+            Neuron->SetSpontaneousActivity(30.0, 10.0, Sim->MasterRandom_->UniformRandomInt());
+        }
+
+        return Sim;
+    }
+
+    std::unique_ptr<BG::NES::Simulator::Simulation> Reference;
+
+    void SetUp() {
+        Reference = MakeNetwork();
+        Reference->SetRecordAll();
+        Reference->RunFor(300.0);
+    }
+
+    //! Checks a polled recording against samples [_First, _First + size)
+    //! of the reference.
+    void ExpectReferenceSamples(const nlohmann::json& _Recording, size_t _First) {
+        std::vector<float> T_ms = _Recording["t_ms"];
+        for (size_t i = 0; i < T_ms.size(); i++) {
+            ASSERT_EQ(T_ms[i], Reference->TRecorded_ms[_First + i]) << "sample " << _First + i;
+        }
+        for (auto& Neuron : Reference->Neurons) {
+            auto* BSNeuron = static_cast<BG::NES::Simulator::BallAndStick::BSNeuron*>(Neuron.get());
+            std::vector<float> Vm_mV = _Recording["neurons"][std::to_string(Neuron->ID)]["Vm_mV"];
+            ASSERT_EQ(Vm_mV.size(), T_ms.size());
+            for (size_t i = 0; i < Vm_mV.size(); i++) {
+                ASSERT_EQ(Vm_mV[i], BSNeuron->VmRecorded_mV[_First + i]) << "neuron " << Neuron->ID << " sample " << _First + i;
+            }
+        }
+    }
+
+    void TearDown() { return; }
+};
+
+TEST_F(RecordingCursorTest, test_Polling_recovers_the_complete_recording) {
+    auto Sim = MakeNetwork();
+    Sim->SetRecordAll();
+    Sim->RecordingMaxSamples = MaxSamples;
+
+    // Polls that come more often than the retention limit lose nothing,
+    // although samples keep being dropped in between.
+    size_t Cursor = 0;
+    std::vector<float> Streamed;
+    while (Sim->T_ms < 300.0 - 0.5 * Sim->Dt_ms) {
+        Sim->RunFor(7.5);
+        nlohmann::json Recording = Sim->GetRecordingJSON(Cursor);
+        ExpectReferenceSamples(Recording, Cursor);
+        std::vector<float> T_ms = Recording["t_ms"];
+        Streamed.insert(Streamed.end(), T_ms.begin(), T_ms.end());
+        Cursor = Recording["cursor"];
+        ASSERT_LT(Sim->TRecorded_ms.size(), 2 * MaxSamples);
+    }
+    ASSERT_GT(Sim->NumTRecordedDropped, 0);
+    ASSERT_EQ(Cursor, Reference->TRecorded_ms.size());
+    ASSERT_EQ(Streamed, Reference->TRecorded_ms);
+}
+
+TEST_F(RecordingCursorTest, test_Cursors_across_drops_and_beyond_the_end) {
+    auto Sim = MakeNetwork();
+    Sim->SetRecordAll();
+    Sim->RecordingMaxSamples = MaxSamples;
+    Sim->RunFor(300.0);
+
+    size_t NumTotal = Reference->TRecorded_ms.size();
+    size_t NumRetained = Sim->TRecorded_ms.size();
+    ASSERT_EQ(Sim->NumTRecordedDropped + NumRetained, NumTotal);
+    ASSERT_GE(NumRetained, MaxSamples);
+    ASSERT_LT(NumRetained, 2 * MaxSamples);
+    size_t FirstRetained = Sim->NumTRecordedDropped;
+
+    // A cursor in the dropped range returns what is retained.
+    for (size_t Cursor : {size_t(0), FirstRetained - 1}) {
+        nlohmann::json Recording = Sim->GetRecordingJSON(Cursor);
+        ASSERT_EQ(Recording["cursor"], NumTotal);
+        ASSERT_EQ(Recording["t_ms"].size(), NumRetained);
+        ExpectReferenceSamples(Recording, FirstRetained);
+    }
+
+    // A cursor within the retained samples returns the samples from there.
+    for (size_t Cursor : {FirstRetained, FirstRetained + 5, NumTotal - 1}) {
+        nlohmann::json Recording = Sim->GetRecordingJSON(Cursor);
+        ASSERT_EQ(Recording["cursor"], NumTotal);
+        ASSERT_EQ(Recording["t_ms"].size(), NumTotal - Cursor);
+        ExpectReferenceSamples(Recording, Cursor);
+    }
+
+    // A cursor at or beyond the end returns nothing, and the same cursor.
+    for (size_t Cursor : {NumTotal, NumTotal + 100}) {
+        nlohmann::json Recording = Sim->GetRecordingJSON(Cursor);
+        ASSERT_EQ(Recording["cursor"], NumTotal);
+        ASSERT_TRUE(Recording["t_ms"].empty());
+        ASSERT_TRUE(Recording["neurons"]["0"]["Vm_mV"].empty());
+    }
+}
+
+TEST_F(RecordingCursorTest, test_Spike_time_cursor) {
+    auto Sim = MakeNetwork();
+    Sim->SetRecordAll();
+
+    // Every spike is returned by exactly one poll.
+    float Cursor_ms = 0.0;
+    std::vector<std::vector<float>> Streamed(NumNeurons);
+    while (Sim->T_ms < 300.0 - 0.5 * Sim->Dt_ms) {
+        Sim->RunFor(12.5);
+        nlohmann::json SpikeTimes = Sim->GetSpikeTimesJSON(Cursor_ms);
+        for (int i = 0; i < NumNeurons; i++) {
+            std::vector<float> TSpike_ms = SpikeTimes[std::to_string(i)]["tSpike_ms"];
+            for (float t : TSpike_ms) {
+                ASSERT_GE(t, Cursor_ms);
+                ASSERT_LT(t, Sim->T_ms);
+            }
+            Streamed[i].insert(Streamed[i].end(), TSpike_ms.begin(), TSpike_ms.end());
+        }
+        Cursor_ms = Sim->T_ms;
+    }
+    for (int i = 0; i < NumNeurons; i++) {
+        ASSERT_EQ(Streamed[i], Reference->Neurons[i]->TAct_ms) << "neuron " << i;
+    }
+    ASSERT_GT(Reference->TotalSpikes(), (unsigned long)NumNeurons);
+
+    // No cursor returns all spikes, a cursor beyond the end none.
+    nlohmann::json All = Sim->GetSpikeTimesJSON();
+    nlohmann::json None = Sim->GetSpikeTimesJSON(Sim->T_ms + 100.0);
+    for (int i = 0; i < NumNeurons; i++) {
+        ASSERT_EQ(All[std::to_string(i)]["tSpike_ms"], nlohmann::json(Reference->Neurons[i]->TAct_ms));
+        ASSERT_TRUE(None[std::to_string(i)]["tSpike_ms"].empty());
+    }
+}
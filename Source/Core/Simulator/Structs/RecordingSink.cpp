@@ -0,0 +1,227 @@
+#include <Simulator/Structs/RecordingSink.h>
+#include <Simulator/Structs/Simulation.h>
+#include <Simulator/BallAndStick/BSNeuron.h>
+#include <Simulator/LIFCompartmental/LIFCNeuron.h>
+
+#include <algorithm>
+#include <cassert>
+#include <fstream>
+#include <map>
+
+namespace BG {
+namespace NES {
+namespace Simulator {
+namespace Tools {
+
+const std::map<std::string, RecordingSinkVariable> RecordingSinkVariableNames = {
+    { "Vm", SinkVm },
+    { "Spikes", SinkSpikes },
+    { "SynapticConductance", SinkSynapticConductance },
+    { "Calcium", SinkCalcium },
+};
+
+bool RecordingSinkVariableFromString(const std::string& _Name, RecordingSinkVariable& _Variable) {
+    auto it = RecordingSinkVariableNames.find(_Name);
+    if (it == RecordingSinkVariableNames.end()) return false;
+    _Variable = it->second;
+    return true;
+}
+
+RecordingSink::RecordingSink(RecordingSinkVariable _Variable, const std::vector<int>& _NeuronIDs, uint32_t _Decimation, size_t _ChunkRows):
+    Variable_(_Variable), NeuronIDs_(_NeuronIDs), Decimation_(std::max<uint32_t>(_Decimation, 1)), ChunkRows_(std::max<size_t>(_ChunkRows, 1)) {
+}
+
+RecordingSink::~RecordingSink() {
+    Flush();
+    if (File_ != nullptr) std::fclose(File_);
+    if (IndexFile_ != nullptr) std::fclose(IndexFile_);
+}
+
+bool RecordingSink::Open(const std::string& _Path, Simulation* _Sim) {
+    assert(_Sim != nullptr);
+
+    if (NeuronIDs_.empty()) {
+        for (auto& neuron_ptr : _Sim->Neurons) NeuronIDs_.emplace_back(neuron_ptr->ID);
+    }
+    // Unknown neurons would only fail later, during a run.
+    for (int NeuronID : NeuronIDs_) {
+        if ((NeuronID < 0) || (size_t(NeuronID) >= _Sim->Neurons.size())) return false;
+        if ((Variable_ == SinkSynapticConductance) && (_Sim->Neurons[NeuronID]->Class_ != CoreStructs::_LIFCNeuron)) return false;
+    }
+
+    // Exclusive create ("x"), an existing recording is never overwritten.
+    File_ = std::fopen(_Path.c_str(), "wbx");
+    if (File_ == nullptr) return false;
+    IndexFile_ = std::fopen((_Path + ".idx").c_str(), "wbx");
+    if (IndexFile_ == nullptr) {
+        std::fclose(File_);
+        File_ = nullptr;
+        std::remove(_Path.c_str());
+        return false;
+    }
+
+    RecordingSinkHeader Header;
+    Header.Variable = Variable_;
+    Header.NumColumns = NeuronIDs_.size();
+    Header.Decimation = Decimation_;
+    Header.Dt_ms = _Sim->Dt_ms;
+    std::vector<int32_t> Columns(NeuronIDs_.begin(), NeuronIDs_.end());
+    if ((std::fwrite(&Header, sizeof(Header), 1, File_) != 1)
+        || (std::fwrite(Columns.data(), sizeof(int32_t), Columns.size(), File_) != Columns.size())
+        || (std::fflush(File_) != 0)) {
+        std::fclose(File_);
+        std::fclose(IndexFile_);
+        File_ = nullptr;
+        IndexFile_ = nullptr;
+        std::remove(_Path.c_str());
+        std::remove((_Path + ".idx").c_str());
+        return false;
+    }
+    Path_ = _Path;
+
+    std::lock_guard<std::mutex> Lock(Mutex_);
+    BytesWritten_ = sizeof(Header) + Columns.size() * sizeof(int32_t);
+
+    // Spikes and Ca samples from before the sink was opened are not streamed.
+    NumSpikesSeen_.clear();
+    for (int NeuronID : NeuronIDs_) NumSpikesSeen_.emplace_back(_Sim->Neurons[NeuronID]->TAct_ms.size());
+    NumCaSamplesSeen_ = _Sim->CaData_->CaImaging.NumDropped + _Sim->CaData_->CaImaging.TRecorded_ms.size();
+    return true;
+}
+
+void RecordingSink::AddRow(float _T_ms, Simulation* _Sim) {
+    TBuffer_.emplace_back(_T_ms);
+    for (int NeuronID : NeuronIDs_) {
+        BallAndStick::BSNeuron* Neuron = static_cast<BallAndStick::BSNeuron*>(_Sim->Neurons[NeuronID].get());
+        float Value = 0.0;
+        switch (Variable_) {
+        case SinkVm:
+            Value = Neuron->Vm();
+            break;
+        case SinkSynapticConductance:
+            for (auto& RDataptr : static_cast<LIFCNeuron*>(Neuron)->LIFCReceptorDataVec) Value += RDataptr->g();
+            break;
+        case SinkCalcium:
+            Value = Neuron->CaSamples.empty() ? 0.0 : Neuron->CaSamples.back();
+            break;
+        default:
+            break;
+        }
+        ValueBuffer_.emplace_back(Value);
+    }
+}
+
+void RecordingSink::Sample(Simulation* _Sim) {
+    if (File_ == nullptr) return;
+
+    switch (Variable_) {
+    case SinkVm:
+    case SinkSynapticConductance:
+        if ((NumSteps_ % Decimation_) == 0) AddRow(_Sim->T_ms, _Sim);
+        break;
+    case SinkSpikes:
+        for (size_t Col = 0; Col < NeuronIDs_.size(); Col++) {
+            const std::vector<float>& TAct_ms = _Sim->Neurons[NeuronIDs_[Col]]->TAct_ms;
+            for (size_t i = NumSpikesSeen_[Col]; i < TAct_ms.size(); i++) {
+                TBuffer_.emplace_back(TAct_ms[i]);
+                IDBuffer_.emplace_back(NeuronIDs_[Col]);
+            }
+            NumSpikesSeen_[Col] = TAct_ms.size();
+        }
+        break;
+    case SinkCalcium: {
+        // Ca samples follow the imaging interval instead of the timestep.
+        const Tools::CalciumImaging& CaImaging = _Sim->CaData_->CaImaging;
+        size_t NumCaSamples = CaImaging.NumDropped + CaImaging.TRecorded_ms.size();
+        if (NumCaSamples > NumCaSamplesSeen_) {
+            AddRow(CaImaging.TRecorded_ms.back(), _Sim);
+            NumCaSamplesSeen_ = NumCaSamples;
+        }
+        break;
+    }
+    default:
+        break;
+    }
+    NumSteps_++;
+
+    if (NumBufferedRows() >= ChunkRows_) Flush();
+}
+
+bool RecordingSink::Flush() {
+    if ((File_ == nullptr) || (NumBufferedRows() == 0)) return true;
+
+    size_t NumRows = NumBufferedRows();
+    RecordingSinkChunkHeader ChunkHeader;
+    ChunkHeader.NumRows = NumRows;
+    ChunkHeader.TFirst_ms = *std::min_element(TBuffer_.begin(), TBuffer_.end());
+    ChunkHeader.TLast_ms = *std::max_element(TBuffer_.begin(), TBuffer_.end());
+
+    // Transpose the row-major buffer into columns.
+    std::vector<float> Columns;
+    if (Variable_ != SinkSpikes) {
+        size_t NumColumns = NeuronIDs_.size();
+        Columns.resize(ValueBuffer_.size());
+        for (size_t Row = 0; Row < NumRows; Row++) {
+            for (size_t Col = 0; Col < NumColumns; Col++) {
+                Columns[Col * NumRows + Row] = ValueBuffer_[Row * NumColumns + Col];
+            }
+        }
+    }
+
+    bool Ok = (std::fwrite(&ChunkHeader, sizeof(ChunkHeader), 1, File_) == 1)
+        && (std::fwrite(TBuffer_.data(), sizeof(float), NumRows, File_) == NumRows);
+    uint64_t Bytes = sizeof(ChunkHeader) + NumRows * sizeof(float);
+    if (Variable_ == SinkSpikes) {
+        Ok = Ok && (std::fwrite(IDBuffer_.data(), sizeof(int32_t), IDBuffer_.size(), File_) == IDBuffer_.size());
+        Bytes += IDBuffer_.size() * sizeof(int32_t);
+    } else {
+        Ok = Ok && (std::fwrite(Columns.data(), sizeof(float), Columns.size(), File_) == Columns.size());
+        Bytes += Columns.size() * sizeof(float);
+    }
+    Ok = Ok && (std::fflush(File_) == 0);
+
+    TBuffer_.clear();
+    ValueBuffer_.clear();
+    IDBuffer_.clear();
+    if (!Ok) return false;
+
+    std::lock_guard<std::mutex> Lock(Mutex_);
+    RecordingSinkChunk Chunk;
+    Chunk.Offset = BytesWritten_;
+    Chunk.Bytes = Bytes;
+    Chunk.NumRows = NumRows;
+    Chunk.TFirst_ms = ChunkHeader.TFirst_ms;
+    Chunk.TLast_ms = ChunkHeader.TLast_ms;
+    Chunks_.emplace_back(Chunk);
+    BytesWritten_ += Bytes;
+    return (std::fwrite(&Chunk, sizeof(Chunk), 1, IndexFile_) == 1) && (std::fflush(IndexFile_) == 0);
+}
+
+uint64_t RecordingSink::GetBytesWritten() const {
+    std::lock_guard<std::mutex> Lock(Mutex_);
+    return BytesWritten_;
+}
+
+std::vector<RecordingSinkChunk> RecordingSink::GetChunks() const {
+    std::lock_guard<std::mutex> Lock(Mutex_);
+    return Chunks_;
+}
+
+bool RecordingSink::ReadBytes(uint64_t _Offset, uint64_t _Length, std::string& _Data) const {
+    uint64_t Available = GetBytesWritten();
+    if (Path_.empty() || (_Offset >= Available)) return false;
+    _Length = std::min({_Length, MaxReadBytes, Available - _Offset});
+
+    // Sink files can grow beyond 2 GiB, so seek with 64-bit stream offsets.
+    std::ifstream ReadFile(Path_, std::ios::in | std::ios::binary);
+    if (!ReadFile.is_open()) return false;
+    _Data.resize(_Length);
+    ReadFile.seekg(std::streamoff(_Offset));
+    ReadFile.read(_Data.data(), std::streamsize(_Length));
+    return ReadFile.good();
+}
+
+}; // namespace Tools
+}; // namespace Simulator
+}; // namespace NES
+}; // namespace BG
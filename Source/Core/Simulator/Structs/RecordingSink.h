@@ -0,0 +1,183 @@
+//=================================================================//
+// This file is part of the BrainGenix-NES Neuron Emulation System //
+//=================================================================//
+
+/*
+    Description: This file provides the RecordingSink class, which streams
+                 recorded variables to chunked column-oriented binary files.
+    Additional Notes: None
+    Date Created: 2026-10-17
+*/
+
+#pragma once
+
+// Standard Libraries (BG convention: use <> instead of "")
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Third-Party Libraries (BG convention: use <> instead of "")
+
+// Internal Libraries (BG convention: use <> instead of "")
+
+
+namespace BG {
+namespace NES {
+namespace Simulator {
+
+// Forward declarations:
+struct Simulation;
+
+namespace Tools {
+
+enum RecordingSinkVariable: uint32_t {
+    SinkVm = 0,                     /**Membrane potential (mV) of every neuron*/
+    SinkSpikes = 1,                 /**Spike events as (t_ms, neuron ID) pairs*/
+    SinkSynapticConductance = 2,    /**Summed receptor conductance (nS) of every LIFC neuron*/
+    SinkCalcium = 3,                /**Ca sample of every neuron at every calcium imaging sample*/
+    NUMRecordingSinkVariable
+};
+
+bool RecordingSinkVariableFromString(const std::string& _Name, RecordingSinkVariable& _Variable);
+
+/**
+ * @brief File layout of a sink (all little-endian, no padding):
+ *
+ * RecordingSinkHeader, then Header.NumColumns int32 neuron IDs, followed
+ * by chunks. Every chunk is a RecordingSinkChunkHeader followed by a float
+ * time column of NumRows values and then by the data columns:
+ *  - sampled variables: NumColumns float columns of NumRows values each,
+ *    in the order of the neuron IDs,
+ *  - spikes: one int32 column of NumRows neuron IDs.
+ *
+ * Alongside, "<file>.idx" holds one RecordingSinkChunk per completed chunk,
+ * so that clients can fetch byte ranges by time without scanning the data.
+ */
+struct RecordingSinkHeader {
+    char Magic[8] = {'N', 'E', 'S', 'S', 'I', 'N', 'K', '\0'};
+    uint32_t Version = 1;
+    uint32_t Variable = 0;
+    uint32_t NumColumns = 0;
+    uint32_t Decimation = 1;
+    float Dt_ms = 0.0;
+    uint32_t Reserved = 0;
+};
+
+struct RecordingSinkChunkHeader {
+    uint32_t Magic = 0x4B4E4843; // "CHNK"
+    uint32_t NumRows = 0;
+    float TFirst_ms = 0.0;
+    float TLast_ms = 0.0;
+};
+
+//! Index entry of a completed chunk.
+struct RecordingSinkChunk {
+    uint64_t Offset = 0;   /**Byte offset of the chunk header in the data file*/
+    uint64_t Bytes = 0;    /**Size of the chunk including its header*/
+    uint32_t NumRows = 0;
+    float TFirst_ms = 0.0;
+    float TLast_ms = 0.0;
+};
+
+/**
+ * @brief Streams one variable of a subset of neurons to disk while the
+ * simulation runs.
+ *
+ * Samples are buffered for ChunkRows rows and then appended to the data
+ * file as one column-oriented chunk, so memory use is bounded regardless
+ * of the length of the run. Sinks are independent of SetRecordAll(), which
+ * can stay off for long runs.
+ */
+class RecordingSink {
+
+private:
+
+    std::string Path_;
+    std::FILE* File_ = nullptr;
+    std::FILE* IndexFile_ = nullptr;
+
+    RecordingSinkVariable Variable_;
+    std::vector<int> NeuronIDs_;            /**Columns, in file order*/
+    uint32_t Decimation_ = 1;               /**Sampled variables are recorded every Decimation_ timesteps*/
+    size_t ChunkRows_ = 1024;               /**Rows buffered before a chunk is written*/
+
+    uint64_t NumSteps_ = 0;
+    std::vector<size_t> NumSpikesSeen_;     /**Spikes already streamed, per column*/
+    size_t NumCaSamplesSeen_ = 0;
+
+    std::vector<float> TBuffer_;
+    std::vector<float> ValueBuffer_;        /**Row-major, NumColumns values per row*/
+    std::vector<int32_t> IDBuffer_;         /**Spikes only*/
+
+    uint64_t BytesWritten_ = 0;
+    std::vector<RecordingSinkChunk> Chunks_;
+    mutable std::mutex Mutex_;              /**Protects the file and chunk list against concurrent readers*/
+
+    void AddRow(float _T_ms, Simulation* _Sim);
+    size_t NumBufferedRows() const { return TBuffer_.size(); }
+
+public:
+
+    static constexpr uint64_t MaxReadBytes = 8*1024*1024; /**Upper limit of the bytes returned by one ReadBytes()*/
+
+    int ID = -1;
+    std::string Name;
+
+    RecordingSink(RecordingSinkVariable _Variable, const std::vector<int>& _NeuronIDs, uint32_t _Decimation, size_t _ChunkRows);
+    ~RecordingSink();
+
+    RecordingSink(const RecordingSink&) = delete;
+    RecordingSink& operator=(const RecordingSink&) = delete;
+
+    /**
+     * @brief Creates the data and index files and writes the header. An empty
+     * neuron list selects all neurons of _Sim. Existing files are not
+     * overwritten, Open() fails instead.
+     *
+     * @param _Path
+     * @param _Sim
+     * @return false if the files exist or could not be created.
+     */
+    bool Open(const std::string& _Path, Simulation* _Sim);
+
+    /**
+     * @brief Called by Simulation::RunFor() once per timestep, after the
+     * neurons and instruments were updated.
+     *
+     * @param _Sim
+     */
+    void Sample(Simulation* _Sim);
+
+    /**
+     * @brief Writes buffered rows as a chunk, even if it is not full.
+     */
+    bool Flush();
+
+    const std::string& GetPath() const { return Path_; }
+    RecordingSinkVariable GetVariable() const { return Variable_; }
+    const std::vector<int>& GetNeuronIDs() const { return NeuronIDs_; }
+    uint32_t GetDecimation() const { return Decimation_; }
+
+    uint64_t GetBytesWritten() const;
+    std::vector<RecordingSinkChunk> GetChunks() const;
+
+    /**
+     * @brief Reads a byte range of the data file. Only flushed data is
+     * available, the range is clipped to GetBytesWritten() and to at most
+     * MaxReadBytes.
+     *
+     * @param _Offset
+     * @param _Length
+     * @param _Data
+     * @return false if the range starts beyond the written data or reading failed.
+     */
+    bool ReadBytes(uint64_t _Offset, uint64_t _Length, std::string& _Data) const;
+
+};
+
+}; // namespace Tools
+}; // namespace Simulator
+}; // namespace NES
+}; // namespace BG
@@ -0,0 +1,427 @@
+//=================================================================//
+// This file is part of the BrainGenix-NES Neuron Emulation System //
+//=================================================================//
+
+/*
+    Description: This file provides unit tests for recording sinks.
+    Additional Notes: Sinks are written to and read back from a fresh
+    directory below the system's temporary directory.
+    Date Created: 2026-10-17
+*/
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <BG/Common/Logger/Logger.h>
+#include <Simulator/Geometries/Sphere.h>
+#include <Simulator/Structs/Simulation.h>
+#include <Simulator/Structs/RecordingElectrode.h>
+#include <Simulator/Structs/CalciumImaging.h>
+#include <Simulator/Structs/RecordingSink.h>
+#include <Simulator/BallAndStick/BSNeuron.h>
+#include <Simulator/LIFCompartmental/LIFCNeuron.h>
+
+#include <VSDA/Ca/VoxelSubsystem/Structs/CaData.h>
+
+
+using BG::NES::Simulator::Tools::RecordingSink;
+
+
+/**
+ * @brief Contents of a sink file, read back through RecordingSink::ReadBytes()
+ * and checked against its chunk index on the way.
+ */
+struct SinkContent {
+    BG::NES::Simulator::Tools::RecordingSinkHeader Header;
+    std::vector<int32_t> Columns;
+    std::vector<float> T_ms;
+    std::vector<std::vector<float>> Values; /**Per column*/
+    std::vector<int32_t> IDs;               /**Spikes only*/
+};
+
+/**
+ * @brief Test class for recording sinks. Builds a randomly connected LIFC
+ * network with spontaneously active neurons and calcium imaging, and
+ * records everything in memory as the reference.
+ */
+
+struct RecordingSinkTest : testing::Test {
+    BG::Common::Logger::LoggingSystem Logger;
+    std::string Directory;
+
+    static constexpr int NumNeurons = 12;
+    static constexpr int NumReceptors = 48;
+    static constexpr float T_ms = 100.0;
+
+    void SetUp() {
+        Directory = (std::filesystem::temp_directory_path() / "nes-recordingsink-test/").string();
+        std::filesystem::remove_all(Directory);
+        std::filesystem::create_directories(Directory);
+    }
+
+    void TearDown() {
+        std::filesystem::remove_all(Directory);
+    }
+
+    std::unique_ptr<BG::NES::Simulator::Simulation> MakeNetwork() {
+        using namespace BG::NES::Simulator;
+
+        auto Sim = std::make_unique<Simulation>(&Logger);
+        Sim->SetRandomSeed(9);
+        Sim->Dt_ms = 0.25;
+
+        std::vector<int> CompartmentIDs;
+        for (int i = 0; i < NumNeurons; i++) {
+            Geometries::Sphere S(Geometries::Vec3D(10.0*i, 0.0, 0.0), 2.0);
+            int ShapeID = Sim->AddSphere(S);
+
+            Compartments::LIFC C;
+            C.ShapeID = ShapeID;
+            C.RestingPotential_mV = -60.0;
+            C.ResetPotential_mV = -55.0;
+            C.SpikeThreshold_mV = -50.0;
+            C.MembraneResistance_MOhm = 100.0;
+            C.MembraneCapacitance_pF = 100.0;
+            C.AfterHyperpolarizationAmplitude_mV = 0.0;
+            CompartmentIDs.push_back(Sim->AddLIFCCompartment(C));
+
+            CoreStructs::LIFCNeuronStruct N;
+            N.RestingPotential_mV = -60.0;
+            N.ResetPotential_mV = -55.0;
+            N.SpikeThreshold_mV = -50.0;
+            N.MembraneResistance_MOhm = 100.0;
+            N.MembraneCapacitance_pF = 100.0;
+            N.RefractoryPeriod_ms = 2.0;
+            N.SpikeDepolarization_mV = 30.0;
+            N.UpdateMethod = CoreStructs::EXPEULER_CM;
+            N.ResetMethod = CoreStructs::TOVM;
+            N.AfterHyperpolarizationReversalPotential_mV = -90.0;
+            N.FastAfterHyperpolarizationRise_ms = 2.5;
+            N.FastAfterHyperpolarizationDecay_ms = 30.0;
+            N.FastAfterHyperpolarizationPeakConductance_nS = 3.0;
+            N.FastAfterHyperpolarizationMaxPeakConductance_nS = 10.0;
+            N.FastAfterHyperpolarizationHalfActConstant = 0.5;
+            N.SlowAfterHyperpolarizationRise_ms = 30.0;
+            N.SlowAfterHyperpolarizationDecay_ms = 300.0;
+            N.SlowAfterHyperpolarizationPeakConductance_nS = 1.0;
+            N.SlowAfterHyperpolarizationMaxPeakConductance_nS = 5.0;
+            N.SlowAfterHyperpolarizationHalfActConstant = 0.5;
+            N.AfterHyperpolarizationSaturationModel = CoreStructs::AHPCLIP;
+            N.FatigueThreshold = 300.0;
+            N.FatigueRecoveryTime_ms = 1000.0;
+            N.AfterDepolarizationReversalPotential_mV = -20.0;
+            N.AfterDepolarizationRise_ms = 20.0;
+            N.AfterDepolarizationDecay_ms = 200.0;
+            N.AfterDepolarizationPeakConductance_nS = 0.3;
+            N.AfterDepolarizationSaturationMultiplier = 2.0;
+            N.AfterDepolarizationRecoveryTime_ms = 300.0;
+            N.AfterDepolarizationDepletion = 0.3;
+            N.AfterDepolarizationSaturationModel = CoreStructs::ADPCLIP;
+            N.AdaptiveThresholdDiffPerSpike = 0.2;
+            N.AdaptiveTresholdRecoveryTime_ms = 50.0;
+            N.AdaptiveThresholdDiffPotential_mV = 10.0;
+            N.AdaptiveThresholdFloor_mV = -50.0;
+            N.AdaptiveThresholdFloorDeltaPerSpike_mV = 1.0;
+            N.AdaptiveThresholdFloorRecoveryTime_ms = 500.0;
+            N.SomaCompartmentIDs.push_back(CompartmentIDs.back());
+            Sim->AddLIFCNeuron(N);
+        }
+
+        std::mt19937 Generator(13);
+        std::uniform_int_distribution<int> Neuron(0, NumNeurons - 1);
+        for (int i = 0; i < NumReceptors; i++) {
+            Connections::LIFCReceptor R;
+            R.SourceCompartmentID = CompartmentIDs[Neuron(Generator)];
+            R.DestinationCompartmentID = CompartmentIDs[Neuron(Generator)];
+            bool Inhibitory = (i % 3) == 0;
+            R.ReversalPotential_mV = Inhibitory ? -70.0 : 0.0;
+            R.PSPRise_ms = 0.5;
+            R.PSPDecay_ms = 3.0;
+            R.PeakConductance_nS = Inhibitory ? 20.0 : 10.0;
+            R.Weight = 1.0;
+            R.OnsetDelay_ms = 1.0;
+            R.Neurotransmitter = Inhibitory ? Connections::GABA : Connections::AMPA;
+            R.STDP_Method = Connections::STDPNONE;
+            Sim->AddLIFCReceptor(R);
+        }
+
+        for (auto & Neuron : Sim->Neurons) {
+            Neuron->SetSpontaneousActivity(30.0, 10.0, Sim->MasterRandom_->UniformRandomInt());
+        }
+
+        return Sim;
+    }
+
+    void SetupMicroscope(BG::NES::Simulator::Simulation& _Sim, bool _Incremental, std::vector<int> _NeuronIDs) {
+        BG::NES::VSDA::Calcium::CaMicroscopeParameters& Params = _Sim.CaData_->Params_;
+        Params.FlourescingNeuronIDs_ = _NeuronIDs;
+        Params.IndicatorRiseTime_ms = 2.0;
+        Params.IndicatorDecayTime_ms = 10.0;
+        Params.IndicatorInterval_ms = 1.0;
+        Params.ImagingInterval_ms = 1.0;
+        Params.UseIncrementalIndicatorFilter = _Incremental;
+        _Sim.CaData_->State_ = BG::NES::VSDA::Calcium::CA_INIT_DONE;
+        _Sim.CaData_->CaImaging.Init(&_Sim, Params);
+        _Sim.SetRecordInstruments();
+    }
+
+    RecordingSink* AddSink(BG::NES::Simulator::Simulation& _Sim, BG::NES::Simulator::Tools::RecordingSinkVariable _Variable, std::vector<int> _NeuronIDs, uint32_t _Decimation, size_t _ChunkRows) {
+        auto Sink = std::make_unique<RecordingSink>(_Variable, _NeuronIDs, _Decimation, _ChunkRows);
+        Sink->ID = _Sim.RecordingSinks.size();
+        if (!Sink->Open(Directory + "Sink" + std::to_string(Sink->ID) + ".bin", &_Sim)) return nullptr;
+        _Sim.RecordingSinks.emplace_back(std::move(Sink));
+        return _Sim.RecordingSinks.back().get();
+    }
+
+    template <typename T>
+    static T Take(const std::string& _Data, size_t& _Pos) {
+        T Value;
+        std::memcpy(&Value, _Data.data() + _Pos, sizeof(T));
+        _Pos += sizeof(T);
+        return Value;
+    }
+
+    void ReadSink(const RecordingSink& _Sink, SinkContent& _Content) {
+        using namespace BG::NES::Simulator::Tools;
+
+        std::string Data;
+        ASSERT_TRUE(_Sink.ReadBytes(0, _Sink.GetBytesWritten() + 100, Data));
+        ASSERT_EQ(Data.size(), _Sink.GetBytesWritten());
+        std::string Tail;
+        ASSERT_FALSE(_Sink.ReadBytes(_Sink.GetBytesWritten(), 1, Tail));
+
+        size_t Pos = 0;
+        _Content.Header = Take<RecordingSinkHeader>(Data, Pos);
+        ASSERT_EQ(std::memcmp(_Content.Header.Magic, "NESSINK", 8), 0);
+        ASSERT_EQ(_Content.Header.Variable, uint32_t(_Sink.GetVariable()));
+        ASSERT_EQ(_Content.Header.Decimation, _Sink.GetDecimation());
+        for (uint32_t Col = 0; Col < _Content.Header.NumColumns; Col++) {
+            _Content.Columns.emplace_back(Take<int32_t>(Data, Pos));
+        }
+        ASSERT_EQ(std::vector<int>(_Content.Columns.begin(), _Content.Columns.end()), _Sink.GetNeuronIDs());
+        _Content.Values.resize(_Content.Columns.size());
+
+        // The index file lists the same chunks as GetChunks().
+        std::vector<RecordingSinkChunk> Chunks = _Sink.GetChunks();
+        std::ifstream IndexFile(_Sink.GetPath() + ".idx", std::ios::binary);
+        std::string Index((std::istreambuf_iterator<char>(IndexFile)), std::istreambuf_iterator<char>());
+        ASSERT_EQ(Index.size(), Chunks.size() * sizeof(RecordingSinkChunk));
+        ASSERT_EQ(std::memcmp(Index.data(), Chunks.data(), Index.size()), 0);
+
+        // Chunks follow each other without gaps up to the end of the data.
+        for (const RecordingSinkChunk& Chunk : Chunks) {
+            ASSERT_EQ(Chunk.Offset, Pos);
+            std::string ChunkData;
+            ASSERT_TRUE(_Sink.ReadBytes(Chunk.Offset, Chunk.Bytes, ChunkData));
+            ASSERT_EQ(ChunkData, Data.substr(Chunk.Offset, Chunk.Bytes));
+
+            RecordingSinkChunkHeader ChunkHeader = Take<RecordingSinkChunkHeader>(Data, Pos);
+            ASSERT_EQ(ChunkHeader.Magic, 0x4B4E4843u);
+            ASSERT_EQ(ChunkHeader.NumRows, Chunk.NumRows);
+            ASSERT_EQ(ChunkHeader.TFirst_ms, Chunk.TFirst_ms);
+            ASSERT_EQ(ChunkHeader.TLast_ms, Chunk.TLast_ms);
+            ASSERT_GT(Chunk.NumRows, 0u);
+
+            std::vector<float> T;
+            for (uint32_t Row = 0; Row < Chunk.NumRows; Row++) {
+                T.emplace_back(Take<float>(Data, Pos));
+            }
+            ASSERT_EQ(*std::min_element(T.begin(), T.end()), Chunk.TFirst_ms);
+            ASSERT_EQ(*std::max_element(T.begin(), T.end()), Chunk.TLast_ms);
+            _Content.T_ms.insert(_Content.T_ms.end(), T.begin(), T.end());
+            if (_Sink.GetVariable() == SinkSpikes) {
+                for (uint32_t Row = 0; Row < Chunk.NumRows; Row++) {
+                    _Content.IDs.emplace_back(Take<int32_t>(Data, Pos));
+                }
+            } else {
+                for (auto& Column : _Content.Values) {
+                    for (uint32_t Row = 0; Row < Chunk.NumRows; Row++) {
+                        Column.emplace_back(Take<float>(Data, Pos));
+                    }
+                }
+            }
+            ASSERT_EQ(Pos, Chunk.Offset + Chunk.Bytes);
+        }
+        ASSERT_EQ(Pos, Data.size());
+    }
+
+    static BG::NES::Simulator::BallAndStick::BSNeuron* Neuron(BG::NES::Simulator::Simulation& _Sim, int _ID) {
+        return static_cast<BG::NES::Simulator::BallAndStick::BSNeuron*>(_Sim.Neurons[_ID].get());
+    }
+};
+
+TEST_F(RecordingSinkTest, test_Sampled_variables_round_trip) {
+    using namespace BG::NES::Simulator::Tools;
+
+    auto Sim = MakeNetwork();
+    Sim->SetRecordAll();
+    SetupMicroscope(*Sim, false, {});
+    std::vector<int> Subset = {7, 2, 9};
+    RecordingSink* VmSink = AddSink(*Sim, SinkVm, Subset, 3, 7);
+    RecordingSink* AllVmSink = AddSink(*Sim, SinkVm, {}, 1, 1000);
+    RecordingSink* GSink = AddSink(*Sim, SinkSynapticConductance, Subset, 2, 5);
+    RecordingSink* CaSink = AddSink(*Sim, SinkCalcium, {3, 0}, 1, 9);
+    ASSERT_TRUE(VmSink && AllVmSink && GSink && CaSink);
+    ASSERT_EQ(AllVmSink->GetNeuronIDs().size(), NumNeurons);
+
+    // Two runs, each ends with a partial chunk.
+    Sim->RunFor(T_ms);
+    Sim->RunFor(T_ms);
+    ASSERT_GT(Sim->TotalSpikes(), (unsigned long)NumNeurons);
+
+    // Every Decimation-th timestep, compared with the in-memory recording.
+    for (RecordingSink* Sink : {VmSink, AllVmSink}) {
+        SinkContent Content;
+        ReadSink(*Sink, Content);
+        ASSERT_EQ(Content.Header.Dt_ms, Sim->Dt_ms);
+        size_t NumSteps = Neuron(*Sim, 0)->VmRecorded_mV.size();
+        ASSERT_EQ(Content.T_ms.size(), (NumSteps + Sink->GetDecimation() - 1) / Sink->GetDecimation());
+        for (size_t Row = 0; Row < Content.T_ms.size(); Row++) {
+            size_t Step = Row * Sink->GetDecimation();
+            for (size_t Col = 0; Col < Content.Columns.size(); Col++) {
+                auto* N = Neuron(*Sim, Content.Columns[Col]);
+                ASSERT_EQ(Content.T_ms[Row], N->TRecorded_ms[Step]);
+                ASSERT_EQ(Content.Values[Col][Row], N->VmRecorded_mV[Step]) << "neuron " << Content.Columns[Col] << " step " << Step;
+            }
+        }
+    }
+
+    // Conductances, compared with the same network run one timestep at a time.
+    {
+        SinkContent Content;
+        ReadSink(*GSink, Content);
+        auto Reference = MakeNetwork();
+        size_t NumSteps = Neuron(*Sim, 0)->VmRecorded_mV.size();
+        ASSERT_EQ(Content.T_ms.size(), NumSteps / 2);
+        float Total = 0.0;
+        for (size_t Step = 0; Step < NumSteps; Step++) {
+            Reference->RunFor(Reference->Dt_ms);
+            if ((Step % 2) != 0) continue;
+            for (size_t Col = 0; Col < Subset.size(); Col++) {
+                float g = 0.0;
+                for (auto& RData : static_cast<BG::NES::Simulator::LIFCNeuron*>(Reference->Neurons[Subset[Col]].get())->LIFCReceptorDataVec) {
+                    g += RData->g();
+                }
+                ASSERT_EQ(Content.Values[Col][Step / 2], g) << "neuron " << Subset[Col] << " step " << Step;
+                Total += g;
+            }
+        }
+        ASSERT_GT(Total, 0.0);
+    }
+
+    // One row per Ca sample.
+    {
+        SinkContent Content;
+        ReadSink(*CaSink, Content);
+        ASSERT_FALSE(Content.T_ms.empty());
+        ASSERT_EQ(Content.T_ms, Sim->CaData_->CaImaging.TRecorded_ms);
+        for (size_t Col = 0; Col < Content.Columns.size(); Col++) {
+            ASSERT_EQ(Content.Values[Col], Neuron(*Sim, Content.Columns[Col])->CaSamples);
+        }
+    }
+}
+
+TEST_F(RecordingSinkTest, test_Spikes_round_trip) {
+    using namespace BG::NES::Simulator::Tools;
+
+    auto Sim = MakeNetwork();
+    RecordingSink* AllSink = AddSink(*Sim, SinkSpikes, {}, 1, 4);
+    ASSERT_TRUE(AllSink != nullptr);
+    Sim->RunFor(T_ms);
+
+    // A sink opened later only streams the spikes that follow.
+    std::vector<size_t> SpikesBefore;
+    for (auto& N : Sim->Neurons) SpikesBefore.emplace_back(N->TAct_ms.size());
+    RecordingSink* LateSink = AddSink(*Sim, SinkSpikes, {5, 1}, 1, 3);
+    ASSERT_TRUE(LateSink != nullptr);
+    Sim->RunFor(T_ms);
+
+    SinkContent All;
+    ReadSink(*AllSink, All);
+    std::vector<std::pair<float, int>> Streamed, Expected;
+    for (size_t i = 0; i < All.T_ms.size(); i++) Streamed.emplace_back(All.T_ms[i], All.IDs[i]);
+    for (auto& N : Sim->Neurons) {
+        for (float t : N->TAct_ms) Expected.emplace_back(t, N->ID);
+    }
+    ASSERT_GT(Expected.size(), NumNeurons);
+    std::sort(Streamed.begin(), Streamed.end());
+    std::sort(Expected.begin(), Expected.end());
+    ASSERT_EQ(Streamed, Expected);
+
+    SinkContent Late;
+    ReadSink(*LateSink, Late);
+    Streamed.clear();
+    Expected.clear();
+    for (size_t i = 0; i < Late.T_ms.size(); i++) Streamed.emplace_back(Late.T_ms[i], Late.IDs[i]);
+    for (int ID : {5, 1}) {
+        const std::vector<float>& TAct_ms = Sim->Neurons[ID]->TAct_ms;
+        for (size_t i = SpikesBefore[ID]; i < TAct_ms.size(); i++) Expected.emplace_back(TAct_ms[i], ID);
+    }
+    std::sort(Streamed.begin(), Streamed.end());
+    std::sort(Expected.begin(), Expected.end());
+    ASSERT_EQ(Streamed, Expected);
+}
+
+TEST_F(RecordingSinkTest, test_Open_rejects_unknown_neurons) {
+    using namespace BG::NES::Simulator::Tools;
+
+    auto Sim = MakeNetwork();
+    ASSERT_EQ(AddSink(*Sim, SinkVm, {0, NumNeurons}, 1, 10), nullptr);
+    ASSERT_EQ(AddSink(*Sim, SinkVm, {-1}, 1, 10), nullptr);
+
+    // Nothing was written, so there is nothing to read.
+    RecordingSink Unopened(SinkVm, {0}, 1, 10);
+    std::string Data;
+    ASSERT_FALSE(Unopened.ReadBytes(0, 10, Data));
+    ASSERT_TRUE(Unopened.GetChunks().empty());
+}
+
+TEST_F(RecordingSinkTest, test_Open_fails_without_index_file) {
+    using namespace BG::NES::Simulator::Tools;
+
+    // A directory in place of the index file makes creating it fail.
+    auto Sim = MakeNetwork();
+    std::filesystem::create_directories(Directory + "NoIndex.bin.idx");
+    RecordingSink Sink(SinkVm, {0}, 1, 10);
+    ASSERT_FALSE(Sink.Open(Directory + "NoIndex.bin", Sim.get()));
+    ASSERT_TRUE(Sink.GetPath().empty());
+
+    std::string Data;
+    ASSERT_FALSE(Sink.ReadBytes(0, 10, Data));
+    ASSERT_TRUE(Sink.Flush());
+}
+
+TEST_F(RecordingSinkTest, test_Open_does_not_overwrite_existing_recording) {
+    using namespace BG::NES::Simulator::Tools;
+
+    // A sink with the path of an earlier recording, e.g. after a restart.
+    auto Sim = MakeNetwork();
+    std::string Path = Directory + "Existing.bin";
+    {
+        std::ofstream Earlier(Path, std::ios::binary);
+        Earlier << "earlier recording";
+    }
+    RecordingSink Sink(SinkVm, {0}, 1, 10);
+    ASSERT_FALSE(Sink.Open(Path, Sim.get()));
+    ASSERT_TRUE(Sink.GetPath().empty());
+    ASSERT_EQ(std::filesystem::file_size(Path), std::string("earlier recording").size());
+    ASSERT_FALSE(std::filesystem::exists(Path + ".idx"));
+
+    // An existing index file is kept as well, and the new data file is removed again.
+    std::filesystem::remove(Path);
+    {
+        std::ofstream EarlierIndex(Path + ".idx", std::ios::binary);
+        EarlierIndex << "earlier index";
+    }
+    ASSERT_FALSE(Sink.Open(Path, Sim.get()));
+    ASSERT_FALSE(std::filesystem::exists(Path));
+    ASSERT_EQ(std::filesystem::file_size(Path + ".idx"), std::string("earlier index").size());
+}
@@ -0,0 +1,325 @@
+//=================================================================//
+// This file is part of the BrainGenix-NES Neuron Emulation System //
+//=================================================================//
+
+/*
+    Description: This file provides unit tests for RunFor job control: progress, pause,
+                 resume and abort, and what they leave in the stored requests.
+    Additional Notes: Runs are handed to an engine thread with RequestRun(), like the
+                      Simulation/RunFor route does. Requests are stored through
+                      API::HandlerData, like the routes store them.
+    Date Created: 2026-10-17
+*/
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+
+#include <BG/Common/Logger/Logger.h>
+#include <RPC/RPCHandlerHelper.h>
+#include <Simulator/Engine.h>
+#include <Simulator/Geometries/Sphere.h>
+#include <Simulator/Structs/Simulation.h>
+#include <Simulator/Structs/RecordingElectrode.h>
+#include <Util/SafeContainers.h>
+
+
+using namespace BG::NES::Simulator;
+
+/**
+ * @brief Test class for RunFor job control. Builds a small BS network in
+ * simulation 0 and runs the RunFor part of SimulationEngineThread() for it.
+ */
+struct RunControlTest : testing::Test {
+    BG::Common::Logger::LoggingSystem Logger;
+
+    BG::NES::ConcurrentUniquePtrRegistry<Simulation> Simulations;
+    Simulation* Sim = nullptr;
+
+    std::atomic<bool> StopThreads{false};
+    std::thread EngineThread;
+
+    static constexpr int NumNeurons = 20;
+
+    std::unique_ptr<Simulation> MakeNetwork() {
+        auto NewSim = std::make_unique<Simulation>(&Logger);
+        for (int i = 0; i < NumNeurons; i++) {
+            Geometries::Sphere S(Geometries::Vec3D(10.0 * i, 0.0, 0.0), 2.0);
+            Compartments::BS C;
+            C.ShapeID = NewSim->AddSphere(S);
+            C.MembranePotential_mV = -60.0;
+            C.SpikeThreshold_mV = -50.0;
+            C.DecayTime_ms = 30.0;
+            C.RestingPotential_mV = -60.0;
+            C.AfterHyperpolarizationAmplitude_mV = -10.0;
+            int SomaID = NewSim->AddSCCompartment(C, BSNEURONS);
+
+            CoreStructs::BSNeuronStruct N;
+            N.SomaCompartmentID = SomaID;
+            N.AxonCompartmentID = SomaID;
+            N.MembranePotential_mV = -60.0;
+            N.RestingPotential_mV = -60.0;
+            N.SpikeThreshold_mV = -50.0;
+            N.DecayTime_ms = 30.0;
+            N.AfterHyperpolarizationAmplitude_mV = -10.0;
+            N.PostsynapticPotentialRiseTime_ms = 5.0;
+            N.PostsynapticPotentialDecayTime_ms = 25.0;
+            N.PostsynapticPotentialAmplitude_nA = 1.0;
+            N.SomaCompartmentPtr = NewSim->FindBSCompartmentByID(SomaID);
+            N.AxonCompartmentPtr = N.SomaCompartmentPtr;
+            NewSim->AddBSNeuron(N);
+        }
+        return NewSim;
+    }
+
+    void SetUp() {
+        Sim = Simulations.read(Simulations.append(MakeNetwork()));
+    }
+
+    void TearDown() {
+        StopThreads = true;
+        Sim->AbortRun();
+        Sim->WakeEngine();
+        if (EngineThread.joinable()) {
+            EngineThread.join();
+        }
+    }
+
+    void StartEngine() {
+        EngineThread = std::thread([this]() {
+            Engine SE;
+            while (Sim->WaitForWork(StopThreads)) {
+                Sim->IsProcessing = true;
+                SE.RunFor(Sim);
+                Sim->CurrentTask = SIMULATION_NONE;
+                Sim->WorkRequested = false;
+                Sim->IsProcessing = false;
+            }
+        });
+    }
+
+    // What the Simulation/RunFor route does.
+    int RunFor(float _Runtime_ms, float _Dt_ms) {
+        nlohmann::json Request;
+        Request["SimulationID"] = 0;
+        Request["Runtime_ms"] = _Runtime_ms;
+        Request["Dt_ms"] = _Dt_ms;
+        BG::NES::API::HandlerData Handle(Request.dump(), &Logger, "Simulation/RunFor", &Simulations);
+        EXPECT_FALSE(Handle.HasError());
+        return Sim->RequestRun(_Runtime_ms, _Dt_ms, [&](int _RunID) {
+            Handle.ResponseWithID("RunID", _RunID);
+            Sim->SetRunRequest(_RunID);
+        });
+    }
+
+    // Polls the progress until it is in _State, false after a generous time-out.
+    bool WaitForState(const std::string& _State) {
+        auto Deadline = std::chrono::steady_clock::now() + std::chrono::seconds(20);
+        while (Sim->GetRunProgressJSON()["State"] != _State) {
+            if (std::chrono::steady_clock::now() > Deadline) return false;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return true;
+    }
+
+    nlohmann::json StoredRequests() {
+        return nlohmann::json::parse(Sim->StoredRequestsToNESRequestArray());
+    }
+};
+
+TEST_F(RunControlTest, test_ProgressOfQueuedAndDoneRuns) {
+    nlohmann::json Progress = Sim->GetRunProgressJSON();
+    EXPECT_EQ(Progress["State"], "idle");
+    EXPECT_EQ(Progress["RunID"], 0);
+
+    // Without an engine thread the run stays queued.
+    int RunID = RunFor(20.0, 0.5);
+    Progress = Sim->GetRunProgressJSON();
+    EXPECT_EQ(Progress["State"], "queued");
+    EXPECT_EQ(Progress["RunID"], RunID);
+    EXPECT_FLOAT_EQ(Progress["Remaining_ms"].get<float>(), 20.0);
+    EXPECT_FLOAT_EQ(Progress["Done_ms"].get<float>(), 0.0);
+
+    StartEngine();
+    ASSERT_TRUE(WaitForState("done"));
+    Progress = Sim->GetRunProgressJSON();
+    EXPECT_FLOAT_EQ(Progress["Done_ms"].get<float>(), 20.0);
+    EXPECT_FLOAT_EQ(Progress["Remaining_ms"].get<float>(), 0.0);
+    EXPECT_FLOAT_EQ(Progress["PercentComplete"].get<float>(), 100.0);
+    EXPECT_EQ(Progress["ETA_s"], 0.0);
+    EXPECT_FLOAT_EQ(Sim->T_ms, 20.0);
+
+    // Finished runs keep their request as it was.
+    nlohmann::json Stored = StoredRequests();
+    ASSERT_EQ(Stored.size(), 1);
+    EXPECT_EQ(Stored[0]["Simulation/RunFor"]["Runtime_ms"], 20.0);
+
+    // Nothing to control any more.
+    EXPECT_FALSE(Sim->PauseRun());
+    EXPECT_FALSE(Sim->ResumeRun());
+    EXPECT_FALSE(Sim->AbortRun());
+}
+
+TEST_F(RunControlTest, test_PauseAndResume) {
+    // Paused while queued, the run pauses at its first timestep.
+    RunFor(100000.0, 0.1);
+    ASSERT_TRUE(Sim->PauseRun());
+    StartEngine();
+    ASSERT_TRUE(WaitForState("paused"));
+
+    // Nothing advances while paused.
+    nlohmann::json Paused = Sim->GetRunProgressJSON();
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    nlohmann::json StillPaused = Sim->GetRunProgressJSON();
+    EXPECT_EQ(StillPaused["State"], "paused");
+    EXPECT_EQ(StillPaused["T_ms"], Paused["T_ms"]);
+    EXPECT_EQ(StillPaused["WallElapsed_s"], Paused["WallElapsed_s"]);
+    EXPECT_TRUE(Sim->IsProcessing);
+
+    // Resumed runs advance again.
+    ASSERT_TRUE(Sim->ResumeRun());
+    auto Deadline = std::chrono::steady_clock::now() + std::chrono::seconds(20);
+    while (Sim->GetRunProgressJSON()["T_ms"] == Paused["T_ms"]) {
+        ASSERT_LT(std::chrono::steady_clock::now(), Deadline);
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_EQ(Sim->GetRunProgressJSON()["State"], "running");
+    ASSERT_TRUE(Sim->AbortRun());
+    ASSERT_TRUE(WaitForState("aborted"));
+}
+
+TEST_F(RunControlTest, test_ResumedRunCompletes) {
+    RunFor(50.0, 0.5);
+    ASSERT_TRUE(Sim->PauseRun());
+    StartEngine();
+    ASSERT_TRUE(WaitForState("paused"));
+    ASSERT_TRUE(Sim->ResumeRun());
+    ASSERT_TRUE(WaitForState("done"));
+
+    EXPECT_FLOAT_EQ(Sim->GetRunProgressJSON()["Done_ms"].get<float>(), 50.0);
+    EXPECT_FLOAT_EQ(Sim->T_ms, 50.0);
+    EXPECT_EQ(StoredRequests()[0]["Simulation/RunFor"]["Runtime_ms"], 50.0);
+}
+
+TEST_F(RunControlTest, test_AbortRewritesStoredRequest) {
+    StartEngine();
+    RunFor(100000.0, 0.5);
+
+    // Let part of the run happen, then stop it in a known place.
+    auto Deadline = std::chrono::steady_clock::now() + std::chrono::seconds(20);
+    while (Sim->GetRunProgressJSON()["Done_ms"].get<float>() < 10.0) {
+        ASSERT_LT(std::chrono::steady_clock::now(), Deadline);
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    ASSERT_TRUE(Sim->PauseRun());
+    ASSERT_TRUE(WaitForState("paused"));
+    ASSERT_TRUE(Sim->AbortRun());
+    ASSERT_TRUE(WaitForState("aborted"));
+
+    nlohmann::json Progress = Sim->GetRunProgressJSON();
+    float Done_ms = Progress["Done_ms"];
+    EXPECT_GE(Done_ms, 10.0);
+    EXPECT_LT(Done_ms, 100000.0);
+    EXPECT_FLOAT_EQ(Progress["Remaining_ms"].get<float>(), 0.0);
+    EXPECT_FLOAT_EQ(Sim->T_ms, Done_ms);
+    EXPECT_FALSE(Sim->AbortRun());
+
+    // The stored request now runs as far as the aborted run got.
+    nlohmann::json Stored = StoredRequests();
+    ASSERT_EQ(Stored.size(), 1);
+    EXPECT_FLOAT_EQ(Stored[0]["Simulation/RunFor"]["Runtime_ms"].get<float>(), Done_ms);
+    EXPECT_EQ(Stored[0]["Simulation/RunFor"]["Dt_ms"], 0.5);
+
+    std::unique_ptr<Simulation> Replay = MakeNetwork();
+    Replay->Dt_ms = Stored[0]["Simulation/RunFor"]["Dt_ms"];
+    Replay->RunFor(Stored[0]["Simulation/RunFor"]["Runtime_ms"]);
+    EXPECT_FLOAT_EQ(Replay->T_ms, Sim->T_ms);
+}
+
+TEST_F(RunControlTest, test_AbortBeforeStartRemovesStoredRequest) {
+    int RunID = RunFor(20.0, 0.5);
+    ASSERT_TRUE(Sim->AbortRun());
+    StartEngine();
+    ASSERT_TRUE(WaitForState("aborted"));
+
+    EXPECT_EQ(Sim->GetRunProgressJSON()["RunID"], RunID);
+    EXPECT_FLOAT_EQ(Sim->T_ms, 0.0);
+    EXPECT_EQ(Sim->NumStoredRequests(), 0);
+}
+
+TEST_F(RunControlTest, test_RequestIsStoredBeforeEngineWakes) {
+    // The engine is already waiting, so the run may end right after the
+    // wake-up. The request must be stored by then, or the abort would
+    // leave it in place.
+    StartEngine();
+    nlohmann::json Request;
+    Request["SimulationID"] = 0;
+    Request["Runtime_ms"] = 20.0;
+    Request["Dt_ms"] = 0.5;
+    BG::NES::API::HandlerData Handle(Request.dump(), &Logger, "Simulation/RunFor", &Simulations);
+    int RunID = Sim->RequestRun(20.0, 0.5, [&](int _RunID) {
+        EXPECT_FALSE(Sim->WorkRequested);
+        EXPECT_EQ(Sim->GetRunProgressJSON()["State"], "queued");
+        Handle.ResponseWithID("RunID", _RunID);
+        Sim->SetRunRequest(_RunID);
+        Sim->AbortRun();
+    });
+    ASSERT_TRUE(WaitForState("aborted"));
+
+    EXPECT_EQ(Sim->GetRunProgressJSON()["RunID"], RunID);
+    EXPECT_FLOAT_EQ(Sim->T_ms, 0.0);
+    EXPECT_EQ(Sim->NumStoredRequests(), 0);
+}
+
+TEST_F(RunControlTest, test_QueriesAndControlsAreNotStored) {
+    nlohmann::json Request;
+    Request["SimulationID"] = 0;
+    for (const char* Route : { "Simulation/RunProgress", "Simulation/RunPause", "Simulation/RunResume", "Simulation/RunAbort" }) {
+        BG::NES::API::HandlerData Handle(Request.dump(), &Logger, Route, &Simulations, true);
+        ASSERT_FALSE(Handle.HasError());
+        nlohmann::json Response = Sim->GetRunProgressJSON();
+        Handle.ResponseAndStoreRequest(Response, false);
+    }
+    EXPECT_EQ(Sim->NumStoredRequests(), 0);
+
+    BG::NES::API::HandlerData Handle(Request.dump(), &Logger, "Simulation/RecordAll", &Simulations);
+    nlohmann::json Response;
+    Handle.ResponseAndStoreRequest(Response);
+    EXPECT_EQ(Sim->NumStoredRequests(), 1);
+}
+
+TEST_F(RunControlTest, test_ClaimedSimulationRefusesRuns) {
+    nlohmann::json Request;
+    Request["SimulationID"] = 0;
+
+    // A task claims the simulation, e.g. to save a checkpoint.
+    ASSERT_TRUE(Sim->ClaimForTask());
+    EXPECT_FALSE(Sim->ClaimForTask());
+    BG::NES::API::HandlerData Busy(Request.dump(), &Logger, "Simulation/RunFor", &Simulations);
+    EXPECT_TRUE(Busy.HasError());
+    EXPECT_EQ(Sim->RequestRun(20.0, 0.5), -1);
+    EXPECT_FALSE(Sim->RequestWork(SIMULATION_RESET));
+    EXPECT_EQ(Sim->GetRunProgressJSON()["State"], "idle");
+    EXPECT_FALSE(Sim->WorkRequested);
+
+    // Released, runs are accepted and a queued run cannot be claimed.
+    Sim->ReleaseTaskClaim();
+    int RunID = RunFor(20.0, 0.5);
+    EXPECT_GT(RunID, 0);
+    EXPECT_FALSE(Sim->ClaimForTask());
+
+    StartEngine();
+    ASSERT_TRUE(WaitForState("done"));
+    auto Deadline = std::chrono::steady_clock::now() + std::chrono::seconds(20);
+    while (Sim->IsProcessing || Sim->WorkRequested) {
+        ASSERT_LT(std::chrono::steady_clock::now(), Deadline);
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_TRUE(Sim->ClaimForTask());
+    Sim->ReleaseTaskClaim();
+}
@@ -0,0 +1,276 @@
+#include <Simulator/Structs/SaveTransfer.h>
+
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+
+namespace BG {
+namespace NES {
+namespace Simulator {
+namespace Tools {
+
+static const uint32_t SHA256RoundConstants[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+static inline uint32_t RotateRight(uint32_t _X, int _N) {
+    return (_X >> _N) | (_X << (32 - _N));
+}
+
+SHA256::SHA256() {
+    const uint32_t Initial[8] = {0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+    std::copy(Initial, Initial + 8, State_);
+}
+
+void SHA256::Compress(const uint8_t* _Block) {
+    uint32_t W[64];
+    for (int i = 0; i < 16; i++) {
+        W[i] = (uint32_t(_Block[4*i]) << 24) | (uint32_t(_Block[4*i+1]) << 16) | (uint32_t(_Block[4*i+2]) << 8) | uint32_t(_Block[4*i+3]);
+    }
+    for (int i = 16; i < 64; i++) {
+        uint32_t S0 = RotateRight(W[i-15], 7) ^ RotateRight(W[i-15], 18) ^ (W[i-15] >> 3);
+        uint32_t S1 = RotateRight(W[i-2], 17) ^ RotateRight(W[i-2], 19) ^ (W[i-2] >> 10);
+        W[i] = W[i-16] + S0 + W[i-7] + S1;
+    }
+
+    uint32_t A = State_[0], B = State_[1], C = State_[2], D = State_[3];
+    uint32_t E = State_[4], F = State_[5], G = State_[6], H = State_[7];
+    for (int i = 0; i < 64; i++) {
+        uint32_t S1 = RotateRight(E, 6) ^ RotateRight(E, 11) ^ RotateRight(E, 25);
+        uint32_t Choice = (E & F) ^ (~E & G);
+        uint32_t T1 = H + S1 + Choice + SHA256RoundConstants[i] + W[i];
+        uint32_t S0 = RotateRight(A, 2) ^ RotateRight(A, 13) ^ RotateRight(A, 22);
+        uint32_t Majority = (A & B) ^ (A & C) ^ (B & C);
+        uint32_t T2 = S0 + Majority;
+        H = G; G = F; F = E; E = D + T1;
+        D = C; C = B; B = A; A = T1 + T2;
+    }
+    State_[0] += A; State_[1] += B; State_[2] += C; State_[3] += D;
+    State_[4] += E; State_[5] += F; State_[6] += G; State_[7] += H;
+}
+
+void SHA256::Update(const uint8_t* _Data, size_t _Size) {
+    TotalBytes_ += _Size;
+    while (_Size > 0) {
+        size_t Take = std::min(_Size, sizeof(Block_) - BlockBytes_);
+        std::copy(_Data, _Data + Take, Block_ + BlockBytes_);
+        BlockBytes_ += Take;
+        _Data += Take;
+        _Size -= Take;
+        if (BlockBytes_ == sizeof(Block_)) {
+            Compress(Block_);
+            BlockBytes_ = 0;
+        }
+    }
+}
+
+std::string SHA256::HexDigest() {
+    uint64_t TotalBits = TotalBytes_ * 8;
+    uint8_t Padding[72] = { 0x80 };
+    size_t PaddingBytes = (BlockBytes_ < 56) ? (56 - BlockBytes_) : (120 - BlockBytes_);
+    for (int i = 0; i < 8; i++) {
+        Padding[PaddingBytes + i] = uint8_t(TotalBits >> (56 - 8*i));
+    }
+    Update(Padding, PaddingBytes + 8);
+
+    static const char Digits[] = "0123456789abcdef";
+    std::string Hex;
+    for (uint32_t Word : State_) {
+        for (int Shift = 28; Shift >= 0; Shift -= 4) {
+            Hex += Digits[(Word >> Shift) & 0xF];
+        }
+    }
+    return Hex;
+}
+
+bool FileSHA256(const std::string& _Path, std::string& _HexDigest) {
+    std::ifstream File(_Path, std::ios::in | std::ios::binary);
+    if (!File.is_open()) {
+        return false;
+    }
+    SHA256 Hash;
+    std::vector<char> Buffer(1024*1024);
+    while (File) {
+        File.read(Buffer.data(), Buffer.size());
+        Hash.Update(reinterpret_cast<const uint8_t*>(Buffer.data()), File.gcount());
+    }
+    if (File.bad()) {
+        return false;
+    }
+    _HexDigest = Hash.HexDigest();
+    return true;
+}
+
+
+bool SaveTransfer::IsSafeHandle(const std::string& _Handle) {
+    if (_Handle.empty() || (_Handle.find("..") != std::string::npos)) {
+        return false;
+    }
+    for (char C : _Handle) {
+        if ((C == '/') || (C == '\\') || (C == ':') || (std::iscntrl(static_cast<unsigned char>(C)))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool SaveTransfer::GetInfo(const std::string& _Handle, uint64_t& _Size, std::string& _HexDigest) {
+    if (!IsSafeHandle(_Handle)) {
+        return false;
+    }
+    std::error_code Error;
+    std::string Path = FilePath(_Handle);
+    _Size = std::filesystem::file_size(Path, Error);
+    if (Error) {
+        return false;
+    }
+    int64_t ModifiedTime = std::filesystem::last_write_time(Path, Error).time_since_epoch().count();
+    if (Error) {
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> Lock(Mutex_);
+        auto It = Hashes_.find(_Handle);
+        if ((It != Hashes_.end()) && (It->second.Size == _Size) && (It->second.ModifiedTime == ModifiedTime)) {
+            _HexDigest = It->second.HexDigest;
+            return true;
+        }
+    }
+
+    // Hash without holding the lock, this can take a while for large files.
+    if (!FileSHA256(Path, _HexDigest)) {
+        return false;
+    }
+    std::lock_guard<std::mutex> Lock(Mutex_);
+    Hashes_[_Handle] = CachedHash{_Size, ModifiedTime, _HexDigest};
+    return true;
+}
+
+bool SaveTransfer::ReadChunk(const std::string& _Handle, uint64_t _Offset, uint64_t _Length, std::string& _Data) const {
+    if (!IsSafeHandle(_Handle)) {
+        return false;
+    }
+    std::ifstream File(FilePath(_Handle), std::ios::in | std::ios::binary | std::ios::ate);
+    if (!File.is_open()) {
+        return false;
+    }
+    uint64_t Size = File.tellg();
+    _Data.clear();
+    if (_Offset >= Size) {
+        return true;
+    }
+    _Data.resize(std::min({_Length, MaxChunkBytes, Size - _Offset}));
+    File.seekg(_Offset);
+    File.read(_Data.data(), _Data.size());
+    return File.good();
+}
+
+bool SaveTransfer::ReadFile(const std::string& _Handle, std::string& _Data) const {
+    _Data.clear();
+    std::string Chunk;
+    do {
+        if (!ReadChunk(_Handle, _Data.size(), MaxChunkBytes, Chunk)) {
+            return false;
+        }
+        _Data += Chunk;
+    } while (!Chunk.empty());
+    return true;
+}
+
+bool SaveTransfer::WriteChunk(const std::string& _Handle, uint64_t _Offset, const std::string& _Data, uint64_t& _Received) {
+    if (!IsSafeHandle(_Handle) || (_Data.size() > MaxChunkBytes)) {
+        return false;
+    }
+    std::lock_guard<std::mutex> Lock(Mutex_);
+    std::error_code Error;
+    std::string Path = PartPath(_Handle);
+    std::filesystem::create_directories(Directory_, Error);
+    uint64_t Received = std::filesystem::exists(Path, Error) ? std::filesystem::file_size(Path, Error) : 0;
+    if (Error || (_Offset > Received)) {
+        return false;
+    }
+
+    // Open for update without truncating, creating the file first if needed.
+    if (!std::filesystem::exists(Path, Error)) {
+        std::ofstream Create(Path, std::ios::out | std::ios::binary);
+    }
+    std::fstream File(Path, std::ios::in | std::ios::out | std::ios::binary);
+    if (!File.is_open()) {
+        return false;
+    }
+    File.seekp(_Offset);
+    File.write(_Data.data(), _Data.size());
+    File.close();
+    if (!File.good()) {
+        return false;
+    }
+    _Received = std::max<uint64_t>(Received, _Offset + _Data.size());
+    return true;
+}
+
+bool SaveTransfer::GetReceived(const std::string& _Handle, uint64_t& _Received) {
+    if (!IsSafeHandle(_Handle)) {
+        return false;
+    }
+    std::lock_guard<std::mutex> Lock(Mutex_);
+    std::error_code Error;
+    std::string Path = PartPath(_Handle);
+    _Received = std::filesystem::exists(Path, Error) ? std::filesystem::file_size(Path, Error) : 0;
+    return !Error;
+}
+
+bool SaveTransfer::FinishUpload(const std::string& _Handle, const std::string& _HexDigest, std::string& _Error) {
+    if (!IsSafeHandle(_Handle)) {
+        _Error = "Invalid handle";
+        return false;
+    }
+    std::lock_guard<std::mutex> Lock(Mutex_);
+    std::error_code Error;
+    if (std::filesystem::exists(FilePath(_Handle), Error)) {
+        _Error = "A file with this handle already exists";
+        return false;
+    }
+    std::string HexDigest;
+    if (!FileSHA256(PartPath(_Handle), HexDigest)) {
+        _Error = "No upload was started for this handle";
+        return false;
+    }
+    std::string Expected = _HexDigest;
+    std::transform(Expected.begin(), Expected.end(), Expected.begin(), [](unsigned char C) { return std::tolower(C); });
+    if (HexDigest != Expected) {
+        _Error = "Content hash mismatch, received data hashes to " + HexDigest;
+        return false;
+    }
+    std::filesystem::rename(PartPath(_Handle), FilePath(_Handle), Error);
+    if (Error) {
+        _Error = "Unable to move upload into place: " + Error.message();
+        return false;
+    }
+    return true;
+}
+
+bool SaveTransfer::AbortUpload(const std::string& _Handle) {
+    if (!IsSafeHandle(_Handle)) {
+        return false;
+    }
+    std::lock_guard<std::mutex> Lock(Mutex_);
+    std::error_code Error;
+    std::filesystem::remove(PartPath(_Handle), Error);
+    return !Error;
+}
+
+}; // namespace Tools
+}; // namespace Simulator
+}; // namespace NES
+}; // namespace BG
@@ -0,0 +1,136 @@
+//=================================================================//
+// This file is part of the BrainGenix-NES Neuron Emulation System //
+//=================================================================//
+
+/*
+    Description: This file provides chunked, resumable transfers of save files with content hashes.
+    Additional Notes: None
+    Date Created: 2026-10-17
+*/
+
+#pragma once
+
+// Standard Libraries (BG convention: use <> instead of "")
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+
+// Third-Party Libraries (BG convention: use <> instead of "")
+
+// Internal Libraries (BG convention: use <> instead of "")
+
+
+namespace BG {
+namespace NES {
+namespace Simulator {
+namespace Tools {
+
+/**
+ * @brief Incremental SHA-256 (FIPS 180-4), used as the content hash of
+ * transferred files.
+ */
+class SHA256 {
+
+private:
+
+    uint32_t State_[8];
+    uint8_t Block_[64];
+    size_t BlockBytes_ = 0;
+    uint64_t TotalBytes_ = 0;
+
+    void Compress(const uint8_t* _Block);
+
+public:
+
+    SHA256();
+
+    void Update(const uint8_t* _Data, size_t _Size);
+
+    //! Finishes the hash and returns it as 64 lowercase hex digits.
+    std::string HexDigest();
+
+};
+
+//! SHA-256 of a whole file, read in chunks. Returns false if it cannot be read.
+bool FileSHA256(const std::string& _Path, std::string& _HexDigest);
+
+
+/**
+ * @brief Serves the files of one directory in chunks, and receives files
+ * into it in chunks, so that no request holds a whole file in memory.
+ *
+ * Files are named by handle, Directory + Handle + Extension. Downloads
+ * read any byte range of a file, so an interrupted transfer continues at
+ * the first missing byte. Uploads are written to Handle + Extension +
+ * ".part", chunk by chunk at the offsets given by the client, and become
+ * visible under the handle only once the client's content hash matches.
+ *
+ * Hashes of served files are cached by size and modification time, so the
+ * file is only hashed once per version.
+ */
+class SaveTransfer {
+
+public:
+
+    static constexpr uint64_t MaxChunkBytes = 8*1024*1024; /**Upper limit of the bytes of one chunk*/
+
+private:
+
+    struct CachedHash {
+        uint64_t Size = 0;
+        int64_t ModifiedTime = 0;
+        std::string HexDigest;
+    };
+
+    std::string Directory_;
+    std::string Extension_;
+
+    std::mutex Mutex_; // guards Hashes_ and the upload files
+    std::map<std::string, CachedHash> Hashes_;
+
+    std::string PartPath(const std::string& _Handle) const { return FilePath(_Handle) + ".part"; }
+
+public:
+
+    SaveTransfer(const std::string& _Directory, const std::string& _Extension): Directory_(_Directory), Extension_(_Extension) {}
+
+    //! Handles are file names without directories, so that no file outside
+    //! the directory can be reached.
+    static bool IsSafeHandle(const std::string& _Handle);
+
+    std::string FilePath(const std::string& _Handle) const { return Directory_ + _Handle + Extension_; }
+
+    //! Size and content hash of a file.
+    bool GetInfo(const std::string& _Handle, uint64_t& _Size, std::string& _HexDigest);
+
+    //! Reads up to _Length (at most MaxChunkBytes) bytes at _Offset. Reads
+    //! at or past the end of the file return no bytes.
+    bool ReadChunk(const std::string& _Handle, uint64_t _Offset, uint64_t _Length, std::string& _Data) const;
+
+    //! Reads the whole file, chunk by chunk, for clients that take it in
+    //! one response.
+    bool ReadFile(const std::string& _Handle, std::string& _Data) const;
+
+    //! Writes an uploaded chunk at _Offset, which must not lie beyond the
+    //! bytes received so far. Chunks may be sent again, e.g. after a lost
+    //! response. _Received is the number of contiguous bytes received.
+    bool WriteChunk(const std::string& _Handle, uint64_t _Offset, const std::string& _Data, uint64_t& _Received);
+
+    //! Bytes of an upload received so far, 0 if none was started.
+    bool GetReceived(const std::string& _Handle, uint64_t& _Received);
+
+    //! Checks the received bytes against the client's hash and, if they
+    //! match, moves them to the file of the handle. Existing files are not
+    //! replaced. A failed check keeps the upload, so it can be resent.
+    bool FinishUpload(const std::string& _Handle, const std::string& _HexDigest, std::string& _Error);
+
+    //! Drops a started upload.
+    bool AbortUpload(const std::string& _Handle);
+
+};
+
+}; // namespace Tools
+}; // namespace Simulator
+}; // namespace NES
+}; // namespace BG
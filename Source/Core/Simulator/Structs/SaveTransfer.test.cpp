@@ -0,0 +1,153 @@
+//=================================================================//
+// This file is part of the BrainGenix-NES Neuron Emulation System //
+//=================================================================//
+
+/*
+    Description: This file provides unit tests for chunked save file transfers.
+    Additional Notes: None
+    Date Created: 2026-10-17
+*/
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <Simulator/Structs/SaveTransfer.h>
+
+
+/**
+ * @brief Test class for save transfers. Works in a fresh directory below
+ * the system's temporary directory.
+ */
+
+struct SaveTransferTest : testing::Test {
+    std::string Directory;
+    std::string Content;
+
+    void SetUp() {
+        Directory = (std::filesystem::temp_directory_path() / "nes-savetransfer-test/").string();
+        std::filesystem::remove_all(Directory);
+        std::filesystem::create_directories(Directory);
+
+        for (int i = 0; i < 100000; i++) {
+            Content += char((i * 7919) % 251);
+        }
+        std::ofstream File(Directory + "sim.NES", std::ios::binary);
+        File.write(Content.data(), Content.size());
+    }
+
+    void TearDown() {
+        std::filesystem::remove_all(Directory);
+    }
+};
+
+TEST_F(SaveTransferTest, test_SHA256_known_digests) {
+    using BG::NES::Simulator::Tools::SHA256;
+
+    SHA256 Empty;
+    ASSERT_EQ(Empty.HexDigest(), "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+
+    SHA256 ABC;
+    ABC.Update(reinterpret_cast<const uint8_t*>("abc"), 3);
+    ASSERT_EQ(ABC.HexDigest(), "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+
+    // Two blocks, fed in uneven pieces.
+    std::string Message = "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
+    SHA256 Pieces;
+    Pieces.Update(reinterpret_cast<const uint8_t*>(Message.data()), 5);
+    Pieces.Update(reinterpret_cast<const uint8_t*>(Message.data()) + 5, Message.size() - 5);
+    ASSERT_EQ(Pieces.HexDigest(), "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1");
+}
+
+TEST_F(SaveTransferTest, test_Download_in_chunks) {
+    BG::NES::Simulator::Tools::SaveTransfer Transfer(Directory, ".NES");
+
+    uint64_t Size = 0;
+    std::string Hash;
+    ASSERT_TRUE(Transfer.GetInfo("sim", Size, Hash));
+    ASSERT_EQ(Size, Content.size());
+
+    std::string Received, Chunk;
+    while (Received.size() < Size) {
+        ASSERT_TRUE(Transfer.ReadChunk("sim", Received.size(), 30000, Chunk));
+        ASSERT_FALSE(Chunk.empty());
+        Received += Chunk;
+    }
+    ASSERT_EQ(Received, Content);
+    ASSERT_TRUE(Transfer.ReadChunk("sim", Size, 10, Chunk));
+    ASSERT_TRUE(Chunk.empty());
+
+    BG::NES::Simulator::Tools::SHA256 Check;
+    Check.Update(reinterpret_cast<const uint8_t*>(Received.data()), Received.size());
+    ASSERT_EQ(Check.HexDigest(), Hash);
+
+    // Handles cannot reach outside the directory.
+    ASSERT_FALSE(Transfer.GetInfo("../sim", Size, Hash));
+    ASSERT_FALSE(Transfer.ReadChunk("sub/sim", 0, 10, Chunk));
+    ASSERT_FALSE(Transfer.GetInfo("missing", Size, Hash));
+}
+
+TEST_F(SaveTransferTest, test_ReadFile_beyond_one_chunk) {
+    using BG::NES::Simulator::Tools::SaveTransfer;
+    SaveTransfer Transfer(Directory, ".NES");
+
+    std::string Large;
+    while (Large.size() < SaveTransfer::MaxChunkBytes + 12345) {
+        Large += Content;
+    }
+    {
+        std::ofstream File(Directory + "large.NES", std::ios::binary);
+        File.write(Large.data(), Large.size());
+    }
+
+    std::string Data;
+    ASSERT_TRUE(Transfer.ReadFile("large", Data));
+    ASSERT_EQ(Data, Large);
+    ASSERT_TRUE(Transfer.ReadFile("sim", Data));
+    ASSERT_EQ(Data, Content);
+    ASSERT_FALSE(Transfer.ReadFile("missing", Data));
+    ASSERT_FALSE(Transfer.ReadFile("../sim", Data));
+}
+
+TEST_F(SaveTransferTest, test_Upload_resumes_and_checks_hash) {
+    BG::NES::Simulator::Tools::SaveTransfer Transfer(Directory, ".NES");
+    std::string Hash;
+    ASSERT_TRUE(BG::NES::Simulator::Tools::FileSHA256(Directory + "sim.NES", Hash));
+
+    uint64_t Received = 0;
+    ASSERT_TRUE(Transfer.GetReceived("copy", Received));
+    ASSERT_EQ(Received, 0);
+
+    // Send the first two chunks, then resend the second after a "lost" response.
+    ASSERT_TRUE(Transfer.WriteChunk("copy", 0, Content.substr(0, 40000), Received));
+    ASSERT_TRUE(Transfer.WriteChunk("copy", 40000, Content.substr(40000, 40000), Received));
+    ASSERT_TRUE(Transfer.WriteChunk("copy", 40000, Content.substr(40000, 40000), Received));
+    ASSERT_EQ(Received, 80000);
+
+    // Gaps are refused, the client resumes from the received count.
+    ASSERT_FALSE(Transfer.WriteChunk("copy", 90000, Content.substr(90000), Received));
+    ASSERT_TRUE(Transfer.GetReceived("copy", Received));
+    ASSERT_EQ(Received, 80000);
+
+    // Not complete yet, so the hash does not match and nothing is published.
+    std::string Error;
+    ASSERT_FALSE(Transfer.FinishUpload("copy", Hash, Error));
+    ASSERT_FALSE(std::filesystem::exists(Directory + "copy.NES"));
+
+    ASSERT_TRUE(Transfer.WriteChunk("copy", Received, Content.substr(Received), Received));
+    ASSERT_EQ(Received, Content.size());
+    ASSERT_TRUE(Transfer.FinishUpload("copy", Hash, Error)) << Error;
+
+    std::ifstream File(Directory + "copy.NES", std::ios::binary);
+    std::string Copy((std::istreambuf_iterator<char>(File)), std::istreambuf_iterator<char>());
+    ASSERT_EQ(Copy, Content);
+
+    // Existing saves are not replaced.
+    ASSERT_TRUE(Transfer.WriteChunk("sim", 0, "x", Received));
+    ASSERT_FALSE(Transfer.FinishUpload("sim", Hash, Error));
+    ASSERT_TRUE(Transfer.AbortUpload("sim"));
+    ASSERT_TRUE(Transfer.GetReceived("sim", Received));
+    ASSERT_EQ(Received, 0);
+}
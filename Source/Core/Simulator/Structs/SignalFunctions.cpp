@@ -33,7 +33,7 @@ bool Convolve1D(const std::deque<float> & signal, const std::vector<float> & rev
         int jEnd = std::min(i + reversed_kernel.size(), signal.size());
         int kBegin = std::max(-i, 0);
         int kEnd = signal.size() + 1;
-        if (i > (signal.size() - reversed_kernel.size())) kEnd -= i;
+        if (static_cast<size_t>(i) > (signal.size() - reversed_kernel.size())) kEnd -= i;
 
         // Dot product
         float sum = 0.0;
@@ -49,6 +49,29 @@ bool Convolve1D(const std::deque<float> & signal, const std::vector<float> & rev
     return true;
 }
 
+void ConvolvedFIFOTap::Init(size_t signal_size, const std::vector<float> & reversed_kernel, size_t offset) {
+    assert(offset >= 1 && offset < signal_size + reversed_kernel.size());
+
+    // Same bounds as in Convolve1D(), for i = convolved index + 1 - kernel size.
+    int i = static_cast<int>(signal_size) - static_cast<int>(offset);
+
+    int jBegin = std::max(0, i);
+    int jEnd = std::min(i + reversed_kernel.size(), signal_size);
+    int kBegin = std::max(-i, 0);
+    int kEnd = signal_size + 1;
+    if (static_cast<size_t>(i) > (signal_size - reversed_kernel.size())) kEnd -= i;
+
+    // The window holds signal[jBegin] to the newest sample.
+    window = signal_size - jBegin;
+    weights.clear();
+    int j = jBegin, k = kBegin;
+    while ((j < jEnd) && (k < kEnd)) {
+        weights.emplace_back(reversed_kernel[k]);
+        j++;
+        k++;
+    }
+}
+
 }; // namespace SignalFunctions
 }; // namespace Simulator
 }; // namespace NES
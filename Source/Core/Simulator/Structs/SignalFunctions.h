@@ -37,6 +37,52 @@ float DoubleExponentExpr(float amp, float tauRise, float tauDecay, float tDiff);
 //! kernel instead of reversing it here each time.
 bool Convolve1D(const std::deque<float> & signal, const std::vector<float> & reversed_kernel, std::vector<float> & convolved);
 
+//! The single output convolved[convolved.size() - offset] of
+//! Convolve1D(signal, reversed_kernel, convolved) for a signal of signal_size
+//! samples. Only the newest samples enter that output, so a
+//! ConvolvedFIFOTapState keeps just those and updates in O(1) per sample.
+//! Value() sums the same products in the same order as Convolve1D(), so it
+//! returns exactly the convolved value.
+struct ConvolvedFIFOTap {
+    size_t window = 0;          //! Newest samples kept, 0 when not initialized.
+    std::vector<float> weights; //! Kernel entries for the oldest samples of the window, oldest first.
+
+    //! Takes the kernel entries used by the iteration of Convolve1D() that
+    //! writes convolved[convolved.size() - offset].
+    void Init(size_t signal_size, const std::vector<float> & reversed_kernel, size_t offset);
+
+    bool IsSet() const { return window > 0; }
+};
+
+//! The newest samples of one signal passing through a ConvolvedFIFOTap.
+struct ConvolvedFIFOTapState {
+    std::vector<float> samples{}; //! Ring buffer of the window, samples[next] is the oldest.
+    size_t next = 0;
+
+    //! Clears the window to zero signal, like a new FIFO.
+    void Reset(const ConvolvedFIFOTap & tap) {
+        samples.assign(tap.window, 0.0);
+        next = 0;
+    }
+
+    //! Adds the next input sample, dropping the oldest.
+    void Update(float x) {
+        samples[next] = x;
+        next = (next + 1 == samples.size()) ? 0 : next + 1;
+    }
+
+    //! Convolution output for the samples added so far.
+    float Value(const ConvolvedFIFOTap & tap) const {
+        float sum = 0.0;
+        size_t idx = next;
+        for (float weight : tap.weights) {
+            sum += samples[idx] * weight;
+            idx = (idx + 1 == samples.size()) ? 0 : idx + 1;
+        }
+        return sum;
+    }
+};
+
 }; // namespace SignalFunctions
 }; // namespace Simulator
 }; // namespace NES
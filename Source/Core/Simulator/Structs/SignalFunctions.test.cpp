@@ -9,6 +9,7 @@
     Date Created: 2023-10-13
 */
 #include <cmath>
+#include <deque>
 #include <memory>
 #include <vector>
 
@@ -67,3 +68,35 @@ TEST_F(SignalFunctionsTest, test_Convolve1D_default) {
         ASSERT_NEAR(result[i], expected[i], tol)
             << "i = " << i << " result[i] = " << result[i];
 }
+
+TEST_F(SignalFunctionsTest, test_ConvolvedFIFOTap_matches_Convolve1D) {
+    // FIFO and kernel sizes and offsets like those of CalciumImaging, and
+    // with the kernel longer than the FIFO or the offset beyond the FIFO.
+    struct Case { size_t fifo_size, kernel_size, offset; };
+    for (Case c : std::vector<Case>{{193, 96, 10}, {25, 12, 10}, {12, 12, 10}, {7, 12, 10},
+                                    {5, 30, 20}, {40, 3, 10}, {1, 5, 3}, {5, 8, 9}, {16, 16, 1}, {16, 16, 31}}) {
+        std::vector<float> reversed_kernel;
+        for (size_t i = 0; i < c.kernel_size; ++i) {
+            reversed_kernel.push_back(0.01 * BG::NES::Simulator::SignalFunctions::DoubleExponentExpr(1.0, 2.0, 10.0, 0.25 * i));
+        }
+        BG::NES::Simulator::SignalFunctions::ConvolvedFIFOTap tap;
+        tap.Init(c.fifo_size, reversed_kernel, c.offset);
+        ASSERT_TRUE(tap.IsSet());
+        BG::NES::Simulator::SignalFunctions::ConvolvedFIFOTapState state;
+        state.Reset(tap);
+
+        std::deque<float> fifo(c.fifo_size, 0.0);
+        std::vector<float> convolved(fifo.size() + reversed_kernel.size() - 1, 0.0);
+        for (size_t i = 0; i < 400; ++i) {
+            // Isolated impulses, then a noisy signal.
+            float v = (i < 200) ? ((i % 37) == 20 ? 1.0 : 0.0) : 0.05 * ((i * 7919) % 23);
+            fifo.pop_front();
+            fifo.push_back(v);
+            state.Update(v);
+
+            BG::NES::Simulator::SignalFunctions::Convolve1D(fifo, reversed_kernel, convolved);
+            ASSERT_EQ(state.Value(tap), convolved[convolved.size() - c.offset])
+                << "fifo " << c.fifo_size << " kernel " << c.kernel_size << " offset " << c.offset << " i = " << i;
+        }
+    }
+}
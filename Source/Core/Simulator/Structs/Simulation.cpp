@@ -2,6 +2,7 @@
 
 #include <Simulator/Structs/RecordingElectrode.h>
 #include <Simulator/Structs/CalciumImaging.h>
+#include <Simulator/Structs/ModelFile.h>
 #include <Simulator/SimpleCompartmental/SCNeuron.h>
 #include <Simulator/LIFCompartmental/LIFCNeuron.h>
 #include <Simulator/Geometries/GeometryCollection.h>
@@ -19,6 +20,9 @@
 #include <iomanip>
 #include <fstream>
 #include <memory>
+#include <algorithm>
+#include <functional>
+#include <type_traits>
 
 #include <iostream>
 
@@ -102,6 +106,10 @@ bool Simulation::CheckCompatibility(SimulationNeuronClass _NewObjectCategory) {
     return true;
 }
 
+bool Simulation::IsCompatible(SimulationNeuronClass _NewObjectCategory) const {
+    return (SimNeuronClass == Simulator::UNDETERMINED) || (SimNeuronClass == _NewObjectCategory);
+}
+
 /**
  * Note: We cache the pointer to the shape in the compartment data, so that it
  *       does not need to reach back to the Simulation to search for it.
@@ -201,6 +209,7 @@ int Simulation::AddLIFCNeuron(CoreStructs::LIFCNeuronStruct& _N) {
     _N.ID = Neurons.size();
     
     Neurons.push_back(std::make_shared<LIFCNeuron>(_N, *this));
+    Connectome_.Invalidate();
     for (const auto & SomaID : _N.SomaCompartmentIDs) {
         NeuronByCompartment.emplace(SomaID, _N.ID);
     }
@@ -227,11 +236,7 @@ bool Simulation::EditLIFCNeuron(int _ID, CoreStructs::LIFCNeuronStruct& _N, Core
 
 int Simulation::AddReceptor(Connections::Receptor& _C) {
 
-    _C.ID = Receptors.size();
-
-    Receptors.push_back(std::make_unique<Connections::Receptor>(_C));
-
-    // Inform destination neuron of its new input receptor.
+    // Find the neurons first, so that a rejected receptor is not kept.
     CoreStructs::Neuron* SrcNeuronPtr = FindNeuronByCompartment(_C.SourceCompartmentID);
     if (SrcNeuronPtr==nullptr) {
         Logger_->Log("Error: No source neuron associated with compartment "+std::to_string(_C.SourceCompartmentID), 7);
@@ -243,6 +248,12 @@ int Simulation::AddReceptor(Connections::Receptor& _C) {
         return -1;
     }
 
+    _C.ID = Receptors.size();
+
+    Receptors.push_back(std::make_unique<Connections::Receptor>(_C));
+
+    // Inform destination neuron of its new input receptor.
+
     //CoreStructs::ReceptorData RData(_C.ID, Receptors.back().get(), SrcNeuronPtr, DstNeuronPtr);
     std::unique_ptr<CoreStructs::ReceptorData> RData = std::make_unique<CoreStructs::ReceptorData>(_C.ID, Receptors.back().get(), SrcNeuronPtr, DstNeuronPtr);
     SrcNeuronPtr->OutputTransmitterAdded(RData.get());
@@ -255,11 +266,7 @@ int Simulation::AddReceptor(Connections::Receptor& _C) {
 
 int Simulation::AddLIFCReceptor(Connections::LIFCReceptor& _C) {
 
-    _C.ID = LIFCReceptors.size();
-
-    LIFCReceptors.push_back(std::make_unique<Connections::LIFCReceptor>(_C));
-
-    // Inform destination neuron of its new input receptor.
+    // Find the neurons first, so that a rejected receptor is not kept.
     CoreStructs::Neuron* SrcNeuronPtr = FindNeuronByCompartment(_C.SourceCompartmentID);
     if (SrcNeuronPtr==nullptr) {
         Logger_->Log("Error: No source neuron associated with compartment "+std::to_string(_C.SourceCompartmentID), 7);
@@ -271,6 +278,12 @@ int Simulation::AddLIFCReceptor(Connections::LIFCReceptor& _C) {
         return -1;
     }
 
+    _C.ID = LIFCReceptors.size();
+
+    LIFCReceptors.push_back(std::make_unique<Connections::LIFCReceptor>(_C));
+
+    // Inform destination neuron of its new input receptor.
+
     if (use_abstracted_LIF_receptors) {
         CoreStructs::LIFCReceptorData* RDataFunctional = dynamic_cast<LIFCNeuron*>(DstNeuronPtr)->FindLIFCReceptorPairing(dynamic_cast<LIFCNeuron*>(SrcNeuronPtr), LIFCReceptors.back().get());
         if (RDataFunctional==nullptr) {
@@ -289,6 +302,7 @@ int Simulation::AddLIFCReceptor(Connections::LIFCReceptor& _C) {
         dynamic_cast<LIFCNeuron*>(SrcNeuronPtr)->UpdateType(_C.Neurotransmitter);
         LIFCReceptorDataVec.emplace_back(RData.release());
     }
+    Connectome_.Invalidate();
 
     return _C.ID;
 }
@@ -907,9 +921,730 @@ public:
 };
 
 /**
- * Save neuronal circuit specifications to file.
+ * Columnar model file schema.
+ *
+ * Each section of a model file (see ModelFile.h) is written from a list of
+ * fixed-size base structs. A schema lists the columns of such a section as
+ * a stored type and the struct member it maps to. Columns are appended at
+ * the end only, so older readers skip the new ones.
+ */
+template <typename S>
+struct ModelColumn {
+    Tools::ModelFileColumnKind Kind;
+    uint32_t Width;
+    std::function<void(const S&, uint8_t*)> Store;
+    std::function<void(S&, const uint8_t*)> Load;
+};
+
+//! Column of a number member, stored as T. Enums and bools are cast.
+template <typename T, typename S, typename F>
+ModelColumn<S> NumberColumn(F _Member) {
+    return ModelColumn<S>{Tools::ColumnNumber, sizeof(T),
+        [_Member](const S& _S, uint8_t* _Dst) {
+            Tools::StoreLE<T>(_Dst, static_cast<T>(_Member(const_cast<S&>(_S))));
+        },
+        [_Member](S& _S, const uint8_t* _Src) {
+            auto& Value = _Member(_S);
+            Value = static_cast<std::remove_reference_t<decltype(Value)>>(Tools::LoadLE<T>(_Src));
+        }};
+}
+
+//! Column of a fixed-length char array member.
+template <size_t N, typename S, typename F>
+ModelColumn<S> BytesColumn(F _Member) {
+    return ModelColumn<S>{Tools::ColumnBytes, N,
+        [_Member](const S& _S, uint8_t* _Dst) { std::memcpy(_Dst, _Member(const_cast<S&>(_S)), N); },
+        [_Member](S& _S, const uint8_t* _Src) { std::memcpy(_Member(_S), _Src, N); }};
+}
+
+#define MODEL_COLUMN(T, S, Member) NumberColumn<T, S>([](S& _S) -> auto& { return _S.Member; })
+#define MODEL_VEC3D_COLUMNS(S, Member) MODEL_COLUMN(float, S, Member.x), MODEL_COLUMN(float, S, Member.y), MODEL_COLUMN(float, S, Member.z)
+
+static const std::vector<ModelColumn<Geometries::SphereBase>>& SphereSchema() {
+    using S = Geometries::SphereBase;
+    static const std::vector<ModelColumn<S>> Schema = {
+        MODEL_COLUMN(int32_t, S, ID),
+        MODEL_VEC3D_COLUMNS(S, Center_um),
+        MODEL_COLUMN(float, S, Radius_um),
+    };
+    return Schema;
+}
+
+static const std::vector<ModelColumn<Geometries::CylinderBase>>& CylinderSchema() {
+    using S = Geometries::CylinderBase;
+    static const std::vector<ModelColumn<S>> Schema = {
+        MODEL_COLUMN(int32_t, S, ID),
+        MODEL_VEC3D_COLUMNS(S, Center_um),
+        MODEL_COLUMN(float, S, End0Radius_um),
+        MODEL_VEC3D_COLUMNS(S, End0Pos_um),
+        MODEL_COLUMN(float, S, End1Radius_um),
+        MODEL_VEC3D_COLUMNS(S, End1Pos_um),
+    };
+    return Schema;
+}
+
+static const std::vector<ModelColumn<Geometries::BoxBase>>& BoxSchema() {
+    using S = Geometries::BoxBase;
+    static const std::vector<ModelColumn<S>> Schema = {
+        MODEL_COLUMN(int32_t, S, ID),
+        MODEL_VEC3D_COLUMNS(S, Center_um),
+        MODEL_VEC3D_COLUMNS(S, Dims_um),
+        MODEL_VEC3D_COLUMNS(S, Rotations_rad),
+    };
+    return Schema;
+}
+
+static const std::vector<ModelColumn<Compartments::BSBaseData>>& BSCompartmentSchema() {
+    using S = Compartments::BSBaseData;
+    static const std::vector<ModelColumn<S>> Schema = {
+        MODEL_COLUMN(int32_t, S, ID),
+        MODEL_COLUMN(int32_t, S, ShapeID),
+        MODEL_COLUMN(float, S, MembranePotential_mV),
+        MODEL_COLUMN(float, S, SpikeThreshold_mV),
+        MODEL_COLUMN(float, S, DecayTime_ms),
+        MODEL_COLUMN(float, S, RestingPotential_mV),
+        MODEL_COLUMN(float, S, AfterHyperpolarizationAmplitude_mV),
+    };
+    return Schema;
+}
+
+static const std::vector<ModelColumn<Compartments::LIFCBaseData>>& LIFCCompartmentSchema() {
+    using S = Compartments::LIFCBaseData;
+    static const std::vector<ModelColumn<S>> Schema = {
+        MODEL_COLUMN(int32_t, S, ID),
+        MODEL_COLUMN(int32_t, S, ShapeID),
+        MODEL_COLUMN(float, S, RestingPotential_mV),
+        MODEL_COLUMN(float, S, ResetPotential_mV),
+        MODEL_COLUMN(float, S, SpikeThreshold_mV),
+        MODEL_COLUMN(float, S, MembraneResistance_MOhm),
+        MODEL_COLUMN(float, S, MembraneCapacitance_pF),
+        MODEL_COLUMN(float, S, AfterHyperpolarizationAmplitude_mV),
+    };
+    return Schema;
+}
+
+static const std::vector<ModelColumn<Connections::ReceptorBase>>& ReceptorSchema() {
+    using S = Connections::ReceptorBase;
+    static const std::vector<ModelColumn<S>> Schema = {
+        MODEL_COLUMN(int32_t, S, ID),
+        MODEL_COLUMN(int32_t, S, ShapeID),
+        MODEL_COLUMN(int32_t, S, SourceCompartmentID),
+        MODEL_COLUMN(int32_t, S, DestinationCompartmentID),
+        MODEL_COLUMN(float, S, Conductance_nS),
+        MODEL_COLUMN(float, S, TimeConstantRise_ms),
+        MODEL_COLUMN(float, S, TimeConstantDecay_ms),
+        BytesColumn<NeurotransmitterLEN, S>([](S& _S) { return _S.Neurotransmitter; }),
+    };
+    return Schema;
+}
+
+static const std::vector<ModelColumn<Connections::LIFCReceptorBase>>& LIFCReceptorSchema() {
+    using S = Connections::LIFCReceptorBase;
+    static const std::vector<ModelColumn<S>> Schema = {
+        MODEL_COLUMN(int32_t, S, ID),
+        MODEL_COLUMN(int32_t, S, ShapeID),
+        MODEL_COLUMN(int32_t, S, SourceCompartmentID),
+        MODEL_COLUMN(int32_t, S, DestinationCompartmentID),
+        MODEL_COLUMN(float, S, ReversalPotential_mV),
+        MODEL_COLUMN(float, S, PSPRise_ms),
+        MODEL_COLUMN(float, S, PSPDecay_ms),
+        MODEL_COLUMN(float, S, PeakConductance_nS),
+        MODEL_COLUMN(float, S, Weight),
+        MODEL_COLUMN(float, S, OnsetDelay_ms),
+        MODEL_COLUMN(uint8_t, S, voltage_gated),
+        MODEL_COLUMN(int32_t, S, STDP_Method),
+        MODEL_COLUMN(float, S, STDP_A_pos),
+        MODEL_COLUMN(float, S, STDP_A_neg),
+        MODEL_COLUMN(float, S, STDP_Tau_pos),
+        MODEL_COLUMN(float, S, STDP_Tau_neg),
+        MODEL_COLUMN(float, S, STDP_Shift),
+        MODEL_COLUMN(int32_t, S, Neurotransmitter),
+    };
+    return Schema;
+}
+
+static const std::vector<ModelColumn<CoreStructs::SCNeuronBase>>& SCNeuronSchema() {
+    using S = CoreStructs::SCNeuronBase;
+    static const std::vector<ModelColumn<S>> Schema = {
+        MODEL_COLUMN(int32_t, S, ID),
+        MODEL_COLUMN(float, S, MembranePotential_mV),
+        MODEL_COLUMN(float, S, RestingPotential_mV),
+        MODEL_COLUMN(float, S, SpikeThreshold_mV),
+        MODEL_COLUMN(float, S, DecayTime_ms),
+        MODEL_COLUMN(float, S, AfterHyperpolarizationAmplitude_mV),
+        MODEL_COLUMN(float, S, PostsynapticPotentialRiseTime_ms),
+        MODEL_COLUMN(float, S, PostsynapticPotentialDecayTime_ms),
+        MODEL_COLUMN(float, S, PostsynapticPotentialAmplitude_nA),
+    };
+    return Schema;
+}
+
+static const std::vector<ModelColumn<CoreStructs::LIFCNeuronBase>>& LIFCNeuronSchema() {
+    using S = CoreStructs::LIFCNeuronBase;
+    static const std::vector<ModelColumn<S>> Schema = {
+        MODEL_COLUMN(int32_t, S, ID),
+        MODEL_COLUMN(float, S, RestingPotential_mV),
+        MODEL_COLUMN(float, S, ResetPotential_mV),
+        MODEL_COLUMN(float, S, SpikeThreshold_mV),
+        MODEL_COLUMN(float, S, MembraneResistance_MOhm),
+        MODEL_COLUMN(float, S, MembraneCapacitance_pF),
+        MODEL_COLUMN(float, S, RefractoryPeriod_ms),
+        MODEL_COLUMN(float, S, SpikeDepolarization_mV),
+        MODEL_COLUMN(int32_t, S, UpdateMethod),
+        MODEL_COLUMN(int32_t, S, ResetMethod),
+        MODEL_COLUMN(float, S, AfterHyperpolarizationReversalPotential_mV),
+        MODEL_COLUMN(float, S, FastAfterHyperpolarizationRise_ms),
+        MODEL_COLUMN(float, S, FastAfterHyperpolarizationDecay_ms),
+        MODEL_COLUMN(float, S, FastAfterHyperpolarizationPeakConductance_nS),
+        MODEL_COLUMN(float, S, FastAfterHyperpolarizationMaxPeakConductance_nS),
+        MODEL_COLUMN(float, S, FastAfterHyperpolarizationHalfActConstant),
+        MODEL_COLUMN(float, S, SlowAfterHyperpolarizationRise_ms),
+        MODEL_COLUMN(float, S, SlowAfterHyperpolarizationDecay_ms),
+        MODEL_COLUMN(float, S, SlowAfterHyperpolarizationPeakConductance_nS),
+        MODEL_COLUMN(float, S, SlowAfterHyperpolarizationMaxPeakConductance_nS),
+        MODEL_COLUMN(float, S, SlowAfterHyperpolarizationHalfActConstant),
+        MODEL_COLUMN(int32_t, S, AfterHyperpolarizationSaturationModel),
+        MODEL_COLUMN(float, S, FatigueThreshold),
+        MODEL_COLUMN(float, S, FatigueRecoveryTime_ms),
+        MODEL_COLUMN(float, S, AfterDepolarizationReversalPotential_mV),
+        MODEL_COLUMN(float, S, AfterDepolarizationRise_ms),
+        MODEL_COLUMN(float, S, AfterDepolarizationDecay_ms),
+        MODEL_COLUMN(float, S, AfterDepolarizationPeakConductance_nS),
+        MODEL_COLUMN(float, S, AfterDepolarizationSaturationMultiplier),
+        MODEL_COLUMN(float, S, AfterDepolarizationRecoveryTime_ms),
+        MODEL_COLUMN(float, S, AfterDepolarizationDepletion),
+        MODEL_COLUMN(int32_t, S, AfterDepolarizationSaturationModel),
+        MODEL_COLUMN(float, S, AdaptiveThresholdDiffPerSpike),
+        MODEL_COLUMN(float, S, AdaptiveTresholdRecoveryTime_ms),
+        MODEL_COLUMN(float, S, AdaptiveThresholdDiffPotential_mV),
+        MODEL_COLUMN(float, S, AdaptiveThresholdFloor_mV),
+        MODEL_COLUMN(float, S, AdaptiveThresholdFloorDeltaPerSpike_mV),
+        MODEL_COLUMN(float, S, AdaptiveThresholdFloorRecoveryTime_ms),
+    };
+    return Schema;
+}
+
+static const std::vector<ModelColumn<BrainRegions::RegionBase>>& RegionSchema() {
+    using S = BrainRegions::RegionBase;
+    static const std::vector<ModelColumn<S>> Schema = {
+        MODEL_COLUMN(int32_t, S, ID),
+        MODEL_COLUMN(int32_t, S, CircuitID),
+        BytesColumn<RegionLabelLEN, S>([](S& _S) { return _S.RegionLabel; }),
+    };
+    return Schema;
+}
+
+//! The neuron IDs of a circuit follow in SectionCircuitNeuronIDs.
+struct ModelCircuitRow: public CoreStructs::CircuitBase {
+    uint32_t NumNeuronIDs = 0;
+};
+
+static const std::vector<ModelColumn<ModelCircuitRow>>& CircuitSchema() {
+    using S = ModelCircuitRow;
+    static const std::vector<ModelColumn<S>> Schema = {
+        MODEL_COLUMN(int32_t, S, ID),
+        MODEL_COLUMN(int32_t, S, RegionID),
+        MODEL_COLUMN(uint32_t, S, NumNeuronIDs),
+    };
+    return Schema;
+}
+
+//! The compartment IDs and the name of a neuron follow in
+//! SectionNeuronListValues and SectionNeuronNames.
+struct ModelNeuronListRow {
+    uint32_t NumSoma = 0;
+    uint32_t NumDendrite = 0;
+    uint32_t NumAxon = 0;
+    uint32_t NameLength = 0;
+};
+
+static const std::vector<ModelColumn<ModelNeuronListRow>>& NeuronListSchema() {
+    using S = ModelNeuronListRow;
+    static const std::vector<ModelColumn<S>> Schema = {
+        MODEL_COLUMN(uint32_t, S, NumSoma),
+        MODEL_COLUMN(uint32_t, S, NumDendrite),
+        MODEL_COLUMN(uint32_t, S, NumAxon),
+        MODEL_COLUMN(uint32_t, S, NameLength),
+    };
+    return Schema;
+}
+
+#undef MODEL_VEC3D_COLUMNS
+#undef MODEL_COLUMN
+
+/**
+ * Writes a model in the columnar model file format. Columns are encoded on
+ * parallel threads, one column per task.
+ */
+class ModelFileSaver {
+protected:
+    Tools::ModelFileWriter Writer_;
+    int NumThreads_;
+
+public:
+    ModelFileSaver(SimulationNeuronClass _SimNeuronClass, int _NumThreads): Writer_(_SimNeuronClass), NumThreads_(_NumThreads) {}
+
+    template <typename S, typename R>
+    void AddSection(Tools::ModelFileSection _Type, const std::vector<ModelColumn<S>>& _Schema, const std::vector<R*>& _Rows) {
+        std::vector<std::vector<uint8_t>> Columns(_Schema.size());
+        Tools::ParallelFor(_Schema.size(), NumThreads_, [&](size_t c) {
+            Columns[c].resize(_Rows.size() * _Schema[c].Width);
+            for (size_t i = 0; i < _Rows.size(); i++) {
+                _Schema[c].Store(*_Rows[i], Columns[c].data() + i*_Schema[c].Width);
+            }
+        });
+        Writer_.BeginSection(_Type, _Rows.size());
+        for (size_t c = 0; c < _Schema.size(); c++) {
+            Writer_.AddColumn(_Schema[c].Kind, _Schema[c].Width, std::move(Columns[c]));
+        }
+        Writer_.EndSection();
+    }
+
+    template <typename T>
+    void AddValueSection(Tools::ModelFileSection _Type, const std::vector<T>& _Values) {
+        Writer_.BeginSection(_Type, _Values.size());
+        Writer_.AddNumberColumn(_Values);
+        Writer_.EndSection();
+    }
+
+    void AddBytesSection(Tools::ModelFileSection _Type, const std::string& _Bytes) {
+        Writer_.BeginSection(_Type, _Bytes.size());
+        Writer_.AddColumn(Tools::ColumnBytes, 1, std::vector<uint8_t>(_Bytes.begin(), _Bytes.end()));
+        Writer_.EndSection();
+    }
+
+    //! Neuron structs with Name and Soma/Dendrite/AxonCompartmentIDs.
+    template <typename N>
+    void AddNeuronLists(const std::vector<const N*>& _Neurons) {
+        std::vector<ModelNeuronListRow> Rows(_Neurons.size());
+        std::vector<const ModelNeuronListRow*> RowPtrs;
+        std::vector<int32_t> Values;
+        std::string Names;
+        for (size_t i = 0; i < _Neurons.size(); i++) {
+            const N& Neuron = *_Neurons[i];
+            Rows[i].NumSoma = Neuron.SomaCompartmentIDs.size();
+            Rows[i].NumDendrite = Neuron.DendriteCompartmentIDs.size();
+            Rows[i].NumAxon = Neuron.AxonCompartmentIDs.size();
+            Rows[i].NameLength = Neuron.Name.size();
+            Values.insert(Values.end(), Neuron.SomaCompartmentIDs.begin(), Neuron.SomaCompartmentIDs.end());
+            Values.insert(Values.end(), Neuron.DendriteCompartmentIDs.begin(), Neuron.DendriteCompartmentIDs.end());
+            Values.insert(Values.end(), Neuron.AxonCompartmentIDs.begin(), Neuron.AxonCompartmentIDs.end());
+            Names += Neuron.Name;
+            RowPtrs.push_back(&Rows[i]);
+        }
+        AddSection(Tools::SectionNeuronLists, NeuronListSchema(), RowPtrs);
+        AddValueSection(Tools::SectionNeuronListValues, Values);
+        AddBytesSection(Tools::SectionNeuronNames, Names);
+    }
+
+    bool Prepare(Simulation* Sim) {
+        // Shapes, by type, with a map that restores their order.
+        std::vector<int32_t> GeometryMap;
+        std::vector<const Geometries::SphereBase*> Spheres;
+        std::vector<const Geometries::CylinderBase*> Cylinders;
+        std::vector<const Geometries::BoxBase*> Boxes;
+        for (size_t i = 0; i < Sim->Collection.Size(); i++) {
+            Geometries::GeometryShapeEnum Type = Sim->Collection.GetShapeType(i);
+            switch (Type) {
+            case Geometries::GeometrySphere: Spheres.push_back(&Sim->Collection.GetSphere(i)); break;
+            case Geometries::GeometryCylinder: Cylinders.push_back(&Sim->Collection.GetCylinder(i)); break;
+            case Geometries::GeometryBox: Boxes.push_back(&Sim->Collection.GetBox(i)); break;
+            default: {
+                Sim->Logger_->Log("Encountered a geometric shape for which model saving is not implemented!", 7);
+                return false;
+            }
+            }
+            GeometryMap.push_back(Type);
+        }
+        AddValueSection(Tools::SectionGeometryMap, GeometryMap);
+        AddSection(Tools::SectionSpheres, SphereSchema(), Spheres);
+        AddSection(Tools::SectionCylinders, CylinderSchema(), Cylinders);
+        AddSection(Tools::SectionBoxes, BoxSchema(), Boxes);
+
+        // Compartments, receptors and neurons of the simulation's neuron class.
+        if (Sim->SimNeuronClass == LIFCNEURONS) {
+            std::vector<const Compartments::LIFCBaseData*> Compartments;
+            for (const auto & C : Sim->LIFCCompartments) Compartments.push_back(&C);
+            AddSection(Tools::SectionLIFCCompartments, LIFCCompartmentSchema(), Compartments);
+
+            std::vector<const Connections::LIFCReceptorBase*> Receptors;
+            for (const auto & R : Sim->LIFCReceptors) Receptors.push_back(R.get());
+            AddSection(Tools::SectionLIFCReceptors, LIFCReceptorSchema(), Receptors);
+
+            std::vector<const CoreStructs::LIFCNeuronStruct*> Neurons;
+            for (const auto & N : Sim->Neurons) Neurons.push_back(&static_cast<LIFCNeuron*>(N.get())->build_data);
+            AddSection(Tools::SectionLIFCNeurons, LIFCNeuronSchema(), Neurons);
+            AddNeuronLists(Neurons);
+        } else if ((Sim->SimNeuronClass == SCNEURONS) || (Sim->SimNeuronClass == UNDETERMINED)) {
+            std::vector<const Compartments::BSBaseData*> Compartments;
+            for (const auto & C : Sim->BSCompartments) Compartments.push_back(&C);
+            AddSection(Tools::SectionBSCompartments, BSCompartmentSchema(), Compartments);
+
+            std::vector<const Connections::ReceptorBase*> Receptors;
+            for (const auto & R : Sim->Receptors) Receptors.push_back(R.get());
+            AddSection(Tools::SectionReceptors, ReceptorSchema(), Receptors);
+
+            std::vector<const CoreStructs::SCNeuronStruct*> Neurons;
+            for (const auto & N : Sim->Neurons) Neurons.push_back(&static_cast<SCNeuron*>(N.get())->build_data);
+            AddSection(Tools::SectionSCNeurons, SCNeuronSchema(), Neurons);
+            AddNeuronLists(Neurons);
+        } else if (Sim->SimNeuronClass == BSNEURONS) {
+            // BS neurons keep their parameters in BSNeuron objects that have no
+            // file schema, writing the compartments alone would lose the neurons.
+            Sim->Logger_->Log("Model saving is not supported for BS neurons, use Simulation/Save to keep the requests that built the model", 7);
+            return false;
+        } else {
+            Sim->Logger_->Log("Model saving is not implemented for this neuron class", 7);
+            return false;
+        }
+
+        // Regions and circuits.
+        std::vector<const BrainRegions::RegionBase*> Regions;
+        for (const auto & R : Sim->Regions) Regions.push_back(R.get());
+        AddSection(Tools::SectionRegions, RegionSchema(), Regions);
+
+        std::vector<ModelCircuitRow> Circuits(Sim->NeuralCircuits.size());
+        std::vector<const ModelCircuitRow*> CircuitPtrs;
+        std::vector<int32_t> CircuitNeuronIDs;
+        for (size_t i = 0; i < Circuits.size(); i++) {
+            const CoreStructs::NeuralCircuit & C = *Sim->NeuralCircuits[i];
+            static_cast<CoreStructs::CircuitBase&>(Circuits[i]) = C;
+            Circuits[i].NumNeuronIDs = C.NeuronIDs.size();
+            CircuitNeuronIDs.insert(CircuitNeuronIDs.end(), C.NeuronIDs.begin(), C.NeuronIDs.end());
+            CircuitPtrs.push_back(&Circuits[i]);
+        }
+        AddSection(Tools::SectionCircuits, CircuitSchema(), CircuitPtrs);
+        AddValueSection(Tools::SectionCircuitNeuronIDs, CircuitNeuronIDs);
+        return true;
+    }
+
+    bool Save(const std::string& _Name) {
+        return Writer_.Write(_Name, NumThreads_);
+    }
+
+    bool SaveImage(std::vector<uint8_t>& _Image) {
+        return Writer_.WriteImage(_Image, NumThreads_);
+    }
+};
+
+/**
+ * Reads a model file. The file is mapped, all section CRCs are checked in
+ * parallel, and the columns of a section are decoded on parallel threads
+ * into base structs, before anything in the simulation is replaced.
+ */
+class ModelFileLoader {
+public:
+    Tools::ModelFileReader Reader;
+    int NumThreads_;
+    std::string Error;
+
+    std::vector<int32_t> GeometryMap;
+    std::vector<Geometries::SphereBase> SphereData;
+    std::vector<Geometries::CylinderBase> CylinderData;
+    std::vector<Geometries::BoxBase> BoxData;
+    std::vector<Compartments::BSBaseData> BSCompartmentData;
+    std::vector<Compartments::LIFCBaseData> LIFCCompartmentData;
+    std::vector<Connections::ReceptorBase> ReceptorData;
+    std::vector<Connections::LIFCReceptorBase> LIFCReceptorData;
+    std::vector<CoreStructs::SCNeuronStruct> SCNeuronData;
+    std::vector<CoreStructs::LIFCNeuronStruct> LIFCNeuronData;
+    std::vector<BrainRegions::RegionBase> RegionData;
+    std::vector<ModelCircuitRow> CircuitData;
+    std::vector<int32_t> CircuitNeuronIDs;
+
+public:
+    ModelFileLoader(int _NumThreads): NumThreads_(_NumThreads) {}
+
+    //! Missing sections load as empty, so that sections of the other
+    //! neuron class need not be present.
+    template <typename S, typename R>
+    bool LoadSection(Tools::ModelFileSection _Type, const std::vector<ModelColumn<S>>& _Schema, std::vector<R>& _Rows) {
+        const Tools::ModelFileReader::SectionInfo* Section = Reader.FindSection(_Type);
+        _Rows.clear();
+        if (!Section) {
+            return true;
+        }
+        for (size_t c = 0; c < _Schema.size(); c++) {
+            if ((c >= Section->Columns.size()) || (Section->Columns[c].Kind != uint32_t(_Schema[c].Kind)) || (Section->Columns[c].Width != _Schema[c].Width)) {
+                Error = "Column " + std::to_string(c) + " of section " + std::to_string(_Type) + " does not match the schema";
+                return false;
+            }
+        }
+        _Rows.resize(Section->Count);
+        Tools::ParallelFor(_Schema.size(), NumThreads_, [&](size_t c) {
+            const uint8_t* Data = Section->Columns[c].Data;
+            for (size_t i = 0; i < _Rows.size(); i++) {
+                _Schema[c].Load(_Rows[i], Data + i*_Schema[c].Width);
+            }
+        });
+        return true;
+    }
+
+    template <typename T>
+    bool LoadValueSection(Tools::ModelFileSection _Type, std::vector<T>& _Values) {
+        const Tools::ModelFileReader::SectionInfo* Section = Reader.FindSection(_Type);
+        _Values.clear();
+        if (!Section) {
+            return true;
+        }
+        Tools::ModelFileColumnView<T> View;
+        if (!Reader.GetColumn(*Section, 0, View)) {
+            Error = "Bad values in section " + std::to_string(_Type);
+            return false;
+        }
+        _Values.resize(View.Size());
+        for (size_t i = 0; i < _Values.size(); i++) _Values[i] = View[i];
+        return true;
+    }
+
+    template <typename N>
+    bool LoadNeuronLists(std::vector<N>& _Neurons) {
+        std::vector<ModelNeuronListRow> Rows;
+        std::vector<int32_t> Values;
+        const uint8_t* Names = nullptr;
+        const Tools::ModelFileReader::SectionInfo* NameSection = Reader.FindSection(Tools::SectionNeuronNames);
+        if (!LoadSection(Tools::SectionNeuronLists, NeuronListSchema(), Rows) || !LoadValueSection(Tools::SectionNeuronListValues, Values)) {
+            return false;
+        }
+        if ((Rows.size() != _Neurons.size()) || (NameSection && !Reader.GetBytesColumn(*NameSection, 0, 1, Names))) {
+            Error = "Neuron lists do not match the neurons";
+            return false;
+        }
+        uint64_t NumNames = NameSection ? NameSection->Count : 0;
+        uint64_t ValueOffset = 0;
+        uint64_t NameOffset = 0;
+        for (size_t i = 0; i < Rows.size(); i++) {
+            uint64_t NumValues = uint64_t(Rows[i].NumSoma) + Rows[i].NumDendrite + Rows[i].NumAxon;
+            if ((NumValues > Values.size() - ValueOffset) || (Rows[i].NameLength > NumNames - NameOffset)) {
+                Error = "Neuron lists are truncated";
+                return false;
+            }
+            auto Next = Values.begin() + ValueOffset;
+            _Neurons[i].SomaCompartmentIDs.assign(Next, Next + Rows[i].NumSoma);
+            Next += Rows[i].NumSoma;
+            _Neurons[i].DendriteCompartmentIDs.assign(Next, Next + Rows[i].NumDendrite);
+            Next += Rows[i].NumDendrite;
+            _Neurons[i].AxonCompartmentIDs.assign(Next, Next + Rows[i].NumAxon);
+            ValueOffset += NumValues;
+            if (Rows[i].NameLength > 0) {
+                _Neurons[i].Name.assign(reinterpret_cast<const char*>(Names + NameOffset), Rows[i].NameLength);
+            }
+            NameOffset += Rows[i].NameLength;
+        }
+        return true;
+    }
+
+    bool Load(const std::string& _Name) {
+        if (!Reader.Open(_Name)) {
+            Error = Reader.GetError();
+            return false;
+        }
+        return Decode();
+    }
+
+    bool Load(std::vector<uint8_t>&& _Image) {
+        if (!Reader.OpenImage(std::move(_Image))) {
+            Error = Reader.GetError();
+            return false;
+        }
+        return Decode();
+    }
+
+    bool Decode() {
+        if (!Reader.VerifySections(NumThreads_)) {
+            Error = Reader.GetError();
+            return false;
+        }
+        bool Ok = LoadValueSection(Tools::SectionGeometryMap, GeometryMap)
+            && LoadSection(Tools::SectionSpheres, SphereSchema(), SphereData)
+            && LoadSection(Tools::SectionCylinders, CylinderSchema(), CylinderData)
+            && LoadSection(Tools::SectionBoxes, BoxSchema(), BoxData)
+            && LoadSection(Tools::SectionBSCompartments, BSCompartmentSchema(), BSCompartmentData)
+            && LoadSection(Tools::SectionLIFCCompartments, LIFCCompartmentSchema(), LIFCCompartmentData)
+            && LoadSection(Tools::SectionReceptors, ReceptorSchema(), ReceptorData)
+            && LoadSection(Tools::SectionLIFCReceptors, LIFCReceptorSchema(), LIFCReceptorData)
+            && LoadSection(Tools::SectionRegions, RegionSchema(), RegionData)
+            && LoadSection(Tools::SectionCircuits, CircuitSchema(), CircuitData)
+            && LoadValueSection(Tools::SectionCircuitNeuronIDs, CircuitNeuronIDs);
+        if (!Ok) {
+            return false;
+        }
+        if (Reader.GetSimNeuronClass() == LIFCNEURONS) {
+            return LoadSection(Tools::SectionLIFCNeurons, LIFCNeuronSchema(), LIFCNeuronData) && LoadNeuronLists(LIFCNeuronData);
+        }
+        return LoadSection(Tools::SectionSCNeurons, SCNeuronSchema(), SCNeuronData) && LoadNeuronLists(SCNeuronData);
+    }
+};
+
+/**
+ * Save neuronal circuit specifications to file, in the columnar model file
+ * format (see ModelFile.h).
  */
 bool Simulation::SaveModel(const std::string& Name) {
+    ModelFileSaver _Saver(SimNeuronClass, NumUpdateThreads);
+    if (!_Saver.Prepare(this)) return false;
+    return _Saver.Save(Name);
+}
+
+bool Simulation::SaveModel(std::vector<uint8_t>& _Image) {
+    ModelFileSaver _Saver(SimNeuronClass, NumUpdateThreads);
+    if (!_Saver.Prepare(this)) return false;
+    return _Saver.SaveImage(_Image);
+}
+
+/**
+ * Load neuronal circuit specifications from file, replacing any
+ * previous specifications in this simulation object. Files in the
+ * legacy format are read by LoadLegacyModel and are migrated by saving
+ * them again.
+ */
+bool Simulation::LoadModel(const std::string& Name) {
+    if (!Tools::IsModelFile(Name)) {
+        Logger_->Log("Reading legacy model file " + Name + ", save the model again to migrate it", 3);
+        return LoadLegacyModel(Name);
+    }
+
+    ModelFileLoader _Loader(NumUpdateThreads);
+    if (!_Loader.Load(Name)) {
+        Logger_->Log("Unable to load model file " + Name + ": " + _Loader.Error, 7);
+        return false;
+    }
+    return BuildModel(_Loader);
+}
+
+bool Simulation::LoadModel(std::vector<uint8_t>&& _Image) {
+    ModelFileLoader _Loader(NumUpdateThreads);
+    if (!_Loader.Load(std::move(_Image))) {
+        Logger_->Log("Unable to load model image: " + _Loader.Error, 7);
+        return false;
+    }
+    return BuildModel(_Loader);
+}
+
+/**
+ * Replaces the model of this simulation with the one decoded by _Loader.
+ */
+bool Simulation::BuildModel(ModelFileLoader& _Loader) {
+    ClearModel();
+    SimNeuronClass = SimulationNeuronClass(_Loader.Reader.GetSimNeuronClass());
+
+    // Instantiate shapes in their original order.
+    size_t NumSpheres = 0, NumCylinders = 0, NumBoxes = 0;
+    for (size_t i = 0; i < _Loader.GeometryMap.size(); i++) {
+        switch (_Loader.GeometryMap[i]) {
+        case Geometries::GeometrySphere: {
+            if (NumSpheres >= _Loader.SphereData.size()) break;
+            Geometries::Sphere _S(_Loader.SphereData[NumSpheres++]);
+            _S.GeometryShape = Geometries::GeometrySphere;
+            _S.Name = "sphere-"+std::to_string(i);
+            AddSphere(_S);
+            continue;
+        }
+        case Geometries::GeometryCylinder: {
+            if (NumCylinders >= _Loader.CylinderData.size()) break;
+            Geometries::Cylinder _S(_Loader.CylinderData[NumCylinders++]);
+            _S.GeometryShape = Geometries::GeometryCylinder;
+            _S.Name = "cylinder-"+std::to_string(i);
+            AddCylinder(_S);
+            continue;
+        }
+        case Geometries::GeometryBox: {
+            if (NumBoxes >= _Loader.BoxData.size()) break;
+            Geometries::Box _S(_Loader.BoxData[NumBoxes++]);
+            _S.GeometryShape = Geometries::GeometryBox;
+            _S.Name = "box-"+std::to_string(i);
+            AddBox(_S);
+            continue;
+        }
+        default: break;
+        }
+        Logger_->Log("Loaded unknown or missing shape " + std::to_string(i), 7);
+        return false;
+    }
+
+    // Instantiate compartments, neurons and receptors.
+    if (SimNeuronClass == LIFCNEURONS) {
+        for (size_t i = 0; i < _Loader.LIFCCompartmentData.size(); i++) {
+            Compartments::LIFC _C(_Loader.LIFCCompartmentData[i]);
+            _C.Name = "compartment-"+std::to_string(i);
+            if (AddLIFCCompartment(_C) < 0) return false;
+        }
+        for (auto & _N : _Loader.LIFCNeuronData) {
+            if (AddLIFCNeuron(_N) < 0) return false;
+        }
+        for (size_t i = 0; i < _Loader.LIFCReceptorData.size(); i++) {
+            Connections::LIFCReceptor _R(_Loader.LIFCReceptorData[i]);
+            _R.Name = "syn-"+std::to_string(i);
+            if (AddLIFCReceptor(_R) < 0) return false;
+        }
+    } else {
+        for (size_t i = 0; i < _Loader.BSCompartmentData.size(); i++) {
+            Compartments::BS _C(_Loader.BSCompartmentData[i]);
+            _C.Name = "compartment-"+std::to_string(i);
+            if (AddSCCompartment(_C, SimNeuronClass) < 0) return false;
+        }
+        for (auto & _N : _Loader.SCNeuronData) {
+            if (AddSCNeuron(_N) < 0) return false;
+        }
+        for (size_t i = 0; i < _Loader.ReceptorData.size(); i++) {
+            Connections::Receptor _R(_Loader.ReceptorData[i]);
+            _R.Name = "syn-"+std::to_string(i);
+            if (AddReceptor(_R) < 0) return false;
+        }
+    }
+
+    // Instantiate regions, which add their circuits, then the circuits'
+    // neuron lists and any circuits without a region.
+    for (const auto & Base : _Loader.RegionData) {
+        BrainRegions::BrainRegion _R(Base);
+        AddRegion(_R);
+    }
+    size_t Offset = 0;
+    for (size_t i = 0; i < _Loader.CircuitData.size(); i++) {
+        const ModelCircuitRow & Row = _Loader.CircuitData[i];
+        if (Row.NumNeuronIDs > _Loader.CircuitNeuronIDs.size() - Offset) {
+            Logger_->Log("Neuron IDs of circuit " + std::to_string(i) + " are truncated", 7);
+            return false;
+        }
+        if (i >= NeuralCircuits.size()) {
+            CoreStructs::NeuralCircuit _C(&Collection);
+            AddCircuit(_C);
+        }
+        NeuralCircuits[i]->RegionID = Row.RegionID;
+        NeuralCircuits[i]->NeuronIDs.assign(_Loader.CircuitNeuronIDs.begin() + Offset, _Loader.CircuitNeuronIDs.begin() + Offset + Row.NumNeuronIDs);
+        Offset += Row.NumNeuronIDs;
+    }
+
+    Show();
+    return true;
+}
+
+/**
+ * Removes all model objects, so that a loaded model does not mix with the
+ * previous one.
+ */
+void Simulation::ClearModel() {
+    Collection.Clear();
+    BSCompartments.clear();
+    LIFCCompartments.clear();
+    Neurons.clear();
+    NeuronByCompartment.clear();
+    Receptors.clear();
+    LIFCReceptors.clear();
+    ReceptorDataVec.clear();
+    LIFCReceptorDataVec.clear();
+    NeuralCircuits.clear();
+    Regions.clear();
+    SpikeEvents_.Clear();
+    Connectome_.Invalidate();
+    SimNeuronClass = UNDETERMINED;
+}
+
+/**
+ * Save neuronal circuit specifications to file in the legacy format of
+ * raw struct copies. Only kept to produce legacy files for migration tests.
+ */
+bool Simulation::SaveLegacyModel(const std::string& Name) {
     if (SimNeuronClass == LIFCNEURONS) {
         LIFCSaver _Saver(Name, SimNeuronClass);
         if (!_Saver.Prepare(this)) return false;
@@ -922,10 +1657,10 @@ bool Simulation::SaveModel(const std::string& Name) {
 }
 
 /**
- * Load neuronal circuit specifications from file, replacing any
- * previous specifications in this simulation object.
+ * Load neuronal circuit specifications from a file in the legacy format,
+ * replacing any previous specifications in this simulation object.
  */
-bool Simulation::LoadModel(const std::string& Name) {
+bool Simulation::LoadLegacyModel(const std::string& Name) {
     SaveLoadPrior _SaveLoadPrior;
     std::fstream LoadFile = std::fstream(Name, std::ios::in | std::ios::binary);
     // 0. SaveLoadPrior
@@ -934,9 +1669,10 @@ bool Simulation::LoadModel(const std::string& Name) {
     if (_SaveLoadPrior.SimNeuronClass == LIFCNEURONS) {
         LIFCLoader _Loader(LoadFile, Name, _SaveLoadPrior);
         if (!_Loader.Load()) return false;
+        ClearModel();
 
         // Reset and instantiate shapes.
-        Collection.Geometries.clear();
+        Collection.Clear();
 
         int ID;
         for (size_t i = 0; i < _Loader._SaverInfo.SGMapSize; i++) {
@@ -1010,9 +1746,10 @@ bool Simulation::LoadModel(const std::string& Name) {
     } else {
         Loader _Loader(LoadFile, Name, _SaveLoadPrior);
         if (!_Loader.Load()) return false;
+        ClearModel();
 
         // Reset and instantiate shapes.
-        Collection.Geometries.clear();
+        Collection.Clear();
 
         int ID;
         for (size_t i = 0; i < _Loader._SaverInfo.SGMapSize; i++) {
@@ -1221,6 +1958,324 @@ void Simulation::InspectSavedModel(const std::string& Name, SaveLoadPrior& _Save
 
 }
 
+/**
+ * Writes the dynamic state of the simulation, i.e. everything that RunFor()
+ * changes, but not the model itself. The counts and neuron classes at the
+ * start let LoadState() check that the state fits before anything is
+ * modified.
+ * Recording sinks stream to their own files and are not included.
+ */
+void Simulation::SaveState(Tools::CheckpointWriter& _Writer) const {
+    _Writer.Put<uint64_t>(Neurons.size());
+    _Writer.Put<uint64_t>(LIFCReceptorDataVec.size());
+    _Writer.Put<uint64_t>(RecordingElectrodes.size());
+    _Writer.Put<uint64_t>(PatchClampADCs.size());
+    for (auto & neuron_ptr : Neurons) {
+        _Writer.Put<int32_t>(neuron_ptr ? int32_t(neuron_ptr->Class_) : -1);
+    }
+
+    _Writer.Put(T_ms);
+    _Writer.Put(Dt_ms);
+    _Writer.Put(STDP);
+    _Writer.Put(triangulate_precise_spiketimes);
+    _Writer.Put(use_recursive_conductances);
+    _Writer.Put(use_lifc_state_arrays);
+    _Writer.Put(use_event_driven_delivery);
+    _Writer.Put(EventDrivenActive_);
+
+    _Writer.Put(RandomSeed);
+    _Writer.Put<uint8_t>(MasterRandom_ ? 1 : 0);
+    if (MasterRandom_) {
+        _Writer.PutString(MasterRandom_->GetState());
+    }
+
+    _Writer.PutVector(TRecorded_ms);
+    _Writer.Put(StartRecordTime_ms);
+    _Writer.Put(MaxRecordTime_ms);
+    _Writer.PutVector(TInstruments_ms);
+    _Writer.Put(InstrumentsStartRecordTime_ms);
+    _Writer.Put(InstrumentsMaxRecordTime_ms);
+    _Writer.Put<uint64_t>(RecordingMaxSamples);
+    _Writer.Put<uint64_t>(NumTRecordedDropped);
+    _Writer.Put<uint64_t>(NumTInstrumentsDropped);
+
+    for (auto & neuron_ptr : Neurons) {
+        if (neuron_ptr) neuron_ptr->SaveState(_Writer);
+    }
+
+    for (auto & RData : LIFCReceptorDataVec) {
+        RData->SaveState(_Writer);
+    }
+
+    // Spikes in flight refer to their receptor by index.
+    std::unordered_map<const CoreStructs::LIFCReceptorData*, uint64_t> RDataIdx;
+    for (size_t i = 0; i < LIFCReceptorDataVec.size(); i++) {
+        RDataIdx.emplace(LIFCReceptorDataVec[i].get(), i);
+    }
+    std::vector<Updater::SpikeEvent> Pending = SpikeEvents_.GetPending();
+    _Writer.Put(SpikeEvents_.GetDt_ms());
+    _Writer.Put(SpikeEvents_.GetNextStep());
+    _Writer.Put<uint64_t>(Pending.size());
+    for (auto & Event : Pending) {
+        _Writer.Put(Event.Arrival_ms);
+        _Writer.Put(RDataIdx.at(Event.Receptor));
+    }
+
+    for (auto & Electrode : RecordingElectrodes) {
+        uint32_t NoiseState[4];
+        Electrode->NoiseGen.GetState(NoiseState);
+        _Writer.Put(NoiseState);
+        _Writer.PutVector(Electrode->TRecorded_ms);
+        _Writer.Put<uint64_t>(Electrode->NumDropped);
+        _Writer.Put<uint64_t>(Electrode->E_mV.size());
+        for (auto & E_mV : Electrode->E_mV) {
+            _Writer.PutVector(E_mV);
+        }
+    }
+
+    _Writer.PutVector(CaData_->CaImaging.TRecorded_ms);
+    _Writer.Put<uint64_t>(CaData_->CaImaging.NumDropped);
+
+    for (auto & ADC : PatchClampADCs) {
+        _Writer.PutVector(ADC.RecordedData_mV);
+    }
+}
+
+/**
+ * Restores state written by SaveState() onto a simulation with the same
+ * model. Returns false without changes if the model or neuron classes do
+ * not match or the settings cannot be read. A false return after that
+ * means the data was corrupt, and the simulation should be reset.
+ */
+bool Simulation::LoadState(Tools::CheckpointReader& _Reader) {
+    uint64_t NumNeurons = 0, NumLIFCReceptorData = 0, NumElectrodes = 0, NumADCs = 0;
+    _Reader.Get(NumNeurons);
+    _Reader.Get(NumLIFCReceptorData);
+    _Reader.Get(NumElectrodes);
+    _Reader.Get(NumADCs);
+    if ((!_Reader.Ok()) || (NumNeurons != Neurons.size()) || (NumLIFCReceptorData != LIFCReceptorDataVec.size()) ||
+        (NumElectrodes != RecordingElectrodes.size()) || (NumADCs != PatchClampADCs.size())) {
+        Logger_->Log("Checkpoint does not match the model of simulation " + std::to_string(ID), 7);
+        return false;
+    }
+
+    for (auto & neuron_ptr : Neurons) {
+        int32_t Class;
+        if (!_Reader.Get(Class)) return false;
+        if (Class != (neuron_ptr ? int32_t(neuron_ptr->Class_) : -1)) {
+            Logger_->Log("Checkpoint neuron class does not match the model of simulation " + std::to_string(ID), 7);
+            return false;
+        }
+    }
+
+    // Settings, random generator and recording times are read into
+    // temporaries, so that a checkpoint rejected here leaves no trace.
+    float New_T_ms, New_Dt_ms;
+    bool NewSTDP, NewTriangulate, NewRecursive, NewStateArrays, NewEventDriven, NewEventDrivenActive;
+    _Reader.Get(New_T_ms);
+    _Reader.Get(New_Dt_ms);
+    _Reader.Get(NewSTDP);
+    _Reader.Get(NewTriangulate);
+    _Reader.Get(NewRecursive);
+    _Reader.Get(NewStateArrays);
+    _Reader.Get(NewEventDriven);
+    _Reader.Get(NewEventDrivenActive);
+
+    int NewRandomSeed;
+    uint8_t HasMasterRandom = 0;
+    _Reader.Get(NewRandomSeed);
+    _Reader.Get(HasMasterRandom);
+    std::unique_ptr<Distributions::Generic> NewMasterRandom;
+    if (HasMasterRandom) {
+        std::string RandomState;
+        if (!_Reader.GetString(RandomState)) return false;
+        NewMasterRandom = std::make_unique<Distributions::Generic>(NewRandomSeed);
+        if (!NewMasterRandom->SetState(RandomState)) return false;
+    }
+
+    std::vector<float> NewTRecorded_ms, NewTInstruments_ms;
+    float NewStartRecordTime_ms, NewMaxRecordTime_ms, NewInstrumentsStartRecordTime_ms, NewInstrumentsMaxRecordTime_ms;
+    uint64_t MaxSamples, NumDropped, NumInstrumentsDropped;
+    _Reader.GetVector(NewTRecorded_ms);
+    _Reader.Get(NewStartRecordTime_ms);
+    _Reader.Get(NewMaxRecordTime_ms);
+    _Reader.GetVector(NewTInstruments_ms);
+    _Reader.Get(NewInstrumentsStartRecordTime_ms);
+    _Reader.Get(NewInstrumentsMaxRecordTime_ms);
+    _Reader.Get(MaxSamples);
+    _Reader.Get(NumDropped);
+    _Reader.Get(NumInstrumentsDropped);
+    if (!_Reader.Ok()) return false;
+
+    T_ms = New_T_ms;
+    Dt_ms = New_Dt_ms;
+    STDP = NewSTDP;
+    triangulate_precise_spiketimes = NewTriangulate;
+    use_recursive_conductances = NewRecursive;
+    use_lifc_state_arrays = NewStateArrays;
+    use_event_driven_delivery = NewEventDriven;
+    EventDrivenActive_ = NewEventDrivenActive;
+    RandomSeed = NewRandomSeed;
+    if (NewMasterRandom) {
+        MasterRandom_ = std::move(NewMasterRandom);
+    }
+    TRecorded_ms = std::move(NewTRecorded_ms);
+    StartRecordTime_ms = NewStartRecordTime_ms;
+    MaxRecordTime_ms = NewMaxRecordTime_ms;
+    TInstruments_ms = std::move(NewTInstruments_ms);
+    InstrumentsStartRecordTime_ms = NewInstrumentsStartRecordTime_ms;
+    InstrumentsMaxRecordTime_ms = NewInstrumentsMaxRecordTime_ms;
+    RecordingMaxSamples = MaxSamples;
+    NumTRecordedDropped = NumDropped;
+    NumTInstrumentsDropped = NumInstrumentsDropped;
+
+    for (auto & neuron_ptr : Neurons) {
+        if (neuron_ptr && !neuron_ptr->LoadState(_Reader)) return false;
+    }
+
+    for (auto & RData : LIFCReceptorDataVec) {
+        if (!RData->LoadState(_Reader)) return false;
+    }
+
+    float QueueDt_ms;
+    int64_t QueueNextStep;
+    uint64_t NumPending = 0;
+    _Reader.Get(QueueDt_ms);
+    _Reader.Get(QueueNextStep);
+    _Reader.Get(NumPending);
+    std::vector<Updater::SpikeEvent> Pending;
+    for (uint64_t i = 0; (i < NumPending) && _Reader.Ok(); i++) {
+        float Arrival_ms;
+        uint64_t Idx;
+        _Reader.Get(Arrival_ms);
+        if ((!_Reader.Get(Idx)) || (Idx >= LIFCReceptorDataVec.size())) return false;
+        Pending.push_back(Updater::SpikeEvent{Arrival_ms, LIFCReceptorDataVec[Idx].get()});
+    }
+    if (!_Reader.Ok()) return false;
+    SpikeEvents_.Restore(QueueDt_ms, QueueNextStep, Pending);
+
+    for (auto & Electrode : RecordingElectrodes) {
+        uint32_t NoiseState[4];
+        uint64_t NumElectrodeDropped, NumSites;
+        _Reader.Get(NoiseState);
+        _Reader.GetVector(Electrode->TRecorded_ms);
+        _Reader.Get(NumElectrodeDropped);
+        if (!_Reader.Get(NumSites)) return false;
+        Electrode->NoiseGen.SetState(NoiseState);
+        Electrode->NumDropped = NumElectrodeDropped;
+        Electrode->E_mV.clear();
+        for (uint64_t i = 0; (i < NumSites) && _Reader.Ok(); i++) {
+            Electrode->E_mV.emplace_back();
+            _Reader.GetVector(Electrode->E_mV.back());
+        }
+    }
+
+    uint64_t NumCaDropped;
+    _Reader.GetVector(CaData_->CaImaging.TRecorded_ms);
+    _Reader.Get(NumCaDropped);
+    CaData_->CaImaging.NumDropped = NumCaDropped;
+
+    for (auto & ADC : PatchClampADCs) {
+        _Reader.GetVector(ADC.RecordedData_mV);
+    }
+
+    return _Reader.Ok();
+}
+
+bool Simulation::SaveCheckpoint(const std::string& Name) const {
+    Tools::CheckpointWriter Writer;
+    SaveState(Writer);
+
+    Tools::CheckpointHeader Header;
+    Header.SimNeuronClass = int32_t(SimNeuronClass);
+    Header.NumNeurons = Neurons.size();
+    Header.NumLIFCReceptorData = LIFCReceptorDataVec.size();
+    return Tools::WriteCheckpointFile(Name, Header, Writer.GetBuffer());
+}
+
+bool Simulation::LoadCheckpoint(const std::string& Name) {
+    Tools::CheckpointHeader Header;
+    std::string Payload;
+    if (!Tools::ReadCheckpointFile(Name, Header, Payload)) {
+        Logger_->Log("Unable to read checkpoint " + Name + ", missing, damaged or of an unknown version", 7);
+        return false;
+    }
+    if ((Header.SimNeuronClass != int32_t(SimNeuronClass)) || (Header.NumNeurons != Neurons.size()) ||
+        (Header.NumLIFCReceptorData != LIFCReceptorDataVec.size())) {
+        Logger_->Log("Checkpoint " + Name + " does not match the model of simulation " + std::to_string(ID), 7);
+        return false;
+    }
+
+    Tools::CheckpointReader Reader(Payload);
+    if ((!LoadState(Reader)) || (!Reader.AtEnd())) {
+        Logger_->Log("Checkpoint " + Name + " is damaged, the simulation should be reset", 8);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * The model travels as an in-memory model image and the dynamic state as a
+ * checkpoint buffer, so that the clone builds its own neurons, receptors
+ * and receptor data. Every pointer between them, e.g. SrcNeuronPtr and
+ * DstNeuronPtr, then refers to the clone's own objects, and the cost is
+ * proportional to the size of the model and its state.
+ */
+bool Simulation::CloneTo(Simulation& _Clone) {
+    if (SimNeuronClass == BSNEURONS) {
+        Logger_->Log("Simulation " + std::to_string(ID) + " cannot be cloned, models of BS neurons cannot be copied", 7);
+        return false;
+    }
+
+    std::vector<uint8_t> Image;
+    if (!SaveModel(Image)) {
+        Logger_->Log("Unable to copy the model of simulation " + std::to_string(ID), 7);
+        return false;
+    }
+
+    // Settings that decide how the model is built or updated.
+    _Clone.use_abstracted_LIF_receptors = use_abstracted_LIF_receptors;
+    _Clone.ShowFunctionalParameters = ShowFunctionalParameters;
+    _Clone.ParallelUpdate = ParallelUpdate;
+    _Clone.NumUpdateThreads = NumUpdateThreads;
+    if (!_Clone.LoadModel(std::move(Image))) {
+        return false;
+    }
+
+    // Instruments refer to the neurons and compartments of the clone.
+    _Clone.RecordingElectrodes.clear();
+    for (auto & Electrode : RecordingElectrodes) {
+        _Clone.RecordingElectrodes.push_back(std::make_unique<Tools::RecordingElectrode>(*Electrode, &_Clone));
+    }
+    _Clone.PatchClampDACs = PatchClampDACs;
+    _Clone.PatchClampADCs = PatchClampADCs;
+
+    // Calcium imaging setup: microscope, scan regions and indicator kernels.
+    // The neurons' indicator FIFOs and filters are part of their state.
+    // Renders are not copied, the clone can be rendered once it ran.
+    if (CaData_->State_ != BG::NES::VSDA::Calcium::CA_NOT_INITIALIZED) {
+        _Clone.CaData_->State_ = BG::NES::VSDA::Calcium::CA_INIT_BEGIN;
+        _Clone.CaData_->Params_ = CaData_->Params_;
+        _Clone.CaData_->Regions_ = CaData_->Regions_;
+        _Clone.CaData_->RenderedImagePaths_.assign(CaData_->Regions_.size(), std::vector<std::string>());
+        _Clone.CaData_->CaImaging = CaData_->CaImaging;
+    }
+
+    Tools::CheckpointWriter Writer;
+    SaveState(Writer);
+    Tools::CheckpointReader Reader(Writer.GetBuffer());
+    if ((!_Clone.LoadState(Reader)) || (!Reader.AtEnd())) {
+        Logger_->Log("Unable to copy the state of simulation " + std::to_string(ID), 7);
+        return false;
+    }
+
+    // Saving the clone replays the requests that built this simulation.
+    std::lock_guard<std::mutex> Lock(StoredRequestsMutex_);
+    _Clone.StoredRequests = StoredRequests;
+    _Clone.StoredReqID = StoredReqID;
+    return true;
+}
+
 size_t Simulation::GetNumCompartments() {
     if (SimNeuronClass == LIFCNEURONS) return LIFCCompartments.size();
     return BSCompartments.size();
@@ -1333,6 +2388,26 @@ Geometries::Vec3D Simulation::GetGeoCenter() const {
     return geoCenter_um;
 };
 
+/**
+ * Same as LIFCNeuron::UpdatePrePostStrength(), but for the entries of
+ * one pair in the connectome index.
+ */
+static bool UpdateLIFCPairStrength(CoreStructs::ConnectomeRange<const CoreStructs::ConnectomeEntry> _Pair, float NewConductance_nS) {
+    bool AMPA_found = false;
+    for (auto& Entry : _Pair) {
+        if ((!AMPA_found) && (Entry.Type==Connections::AMPA)) {
+            // The first one found is modified.
+            Entry.Receptor->weight = NewConductance_nS/Entry.g_peak_sum_nS;
+            AMPA_found = true;
+        } else {
+            // Others are cleared to zero.
+            Entry.Receptor->weight = 0.0;
+        }
+    }
+
+    return AMPA_found;
+}
+
 /**
  * Update the abstract strength of a connection between a specific
  * presynaptic neuron and postsynaptic neuron pair.
@@ -1348,7 +2423,7 @@ bool Simulation::UpdatePrePostStrength(int PresynapticID, int PostsynapticID, fl
     if (PostsynapticPtr->Class_<CoreStructs::_BSNeuron) return false;
 
     if (SimNeuronClass == LIFCNEURONS) {
-        return static_cast<LIFCNeuron*>(PostsynapticPtr)->UpdatePrePostStrength(PresynapticID, NewConductance_nS);
+        return UpdateLIFCPairStrength(GetConnectomeIndex().GetPair(PresynapticID, PostsynapticID), NewConductance_nS);
     } else {
         return static_cast<BallAndStick::BSNeuron*>(PostsynapticPtr)->UpdatePrePostStrength(PresynapticID, NewConductance_nS);
     }
@@ -1359,6 +2434,20 @@ bool Simulation::UpdatePrePostStrength(int PresynapticID, int PostsynapticID, fl
  * strengths before setting specific ones.
  */
 void Simulation::UpdateAllStrength(float NewConductance_nS) {
+    if (SimNeuronClass == LIFCNEURONS) {
+        // Only pairs that are connected can change.
+        auto Entries = GetConnectomeIndex().GetEntries();
+        for (auto* PairFirst = Entries.begin(); PairFirst != Entries.end(); ) {
+            auto* PairLast = PairFirst;
+            while ((PairLast != Entries.end()) && (PairLast->PreID == PairFirst->PreID) && (PairLast->PostID == PairFirst->PostID)) {
+                PairLast++;
+            }
+            UpdateLIFCPairStrength({ PairFirst, PairLast }, NewConductance_nS);
+            PairFirst = PairLast;
+        }
+        return;
+    }
+
     for (int PostSynIdx = 0; PostSynIdx < Neurons.size(); PostSynIdx++) {
         for (int PreSynIdx = 0; PreSynIdx < Neurons.size(); PreSynIdx++) {
             UpdatePrePostStrength(PreSynIdx, PostSynIdx, NewConductance_nS);
@@ -1439,21 +2528,51 @@ std::unordered_map<std::string, CoreStructs::CircuitRecording> Simulation::GetRe
     return recording;
 };
 
-nlohmann::json Simulation::GetSpikeTimesJSON() const {
+nlohmann::json Simulation::GetSpikeTimesJSON(float _Cursor_ms) const {
     nlohmann::json spiketimes;
 
     for (const auto & neuron_ptr : this->Neurons) {
         assert(neuron_ptr);
-        spiketimes[std::to_string(neuron_ptr->ID)] = neuron_ptr->GetSpikeTimesJSON();
+        if (_Cursor_ms <= 0.0) {
+            spiketimes[std::to_string(neuron_ptr->ID)] = neuron_ptr->GetSpikeTimesJSON();
+        } else {
+            // Spike times are ascending, so the new ones are a tail of TAct_ms.
+            const std::vector<float> & TAct_ms = neuron_ptr->TAct_ms;
+            auto First = std::lower_bound(TAct_ms.begin(), TAct_ms.end(), _Cursor_ms);
+            spiketimes[std::to_string(neuron_ptr->ID)]["tSpike_ms"] = Tools::LatestJSON(TAct_ms, TAct_ms.end() - First);
+        }
     }
     
     return spiketimes;
 }
 
-nlohmann::json Simulation::GetRecordingJSON() const {
+bool Simulation::GetSpikeRaster(float _TStart_ms, float _TEnd_ms, std::vector<int> _NeuronIDs, float _Resolution_ms, std::string& _Raster) const {
+    if (_NeuronIDs.empty()) {
+        for (const auto & neuron_ptr : this->Neurons) _NeuronIDs.emplace_back(neuron_ptr->ID);
+    }
+    std::sort(_NeuronIDs.begin(), _NeuronIDs.end());
+    _NeuronIDs.erase(std::unique(_NeuronIDs.begin(), _NeuronIDs.end()), _NeuronIDs.end());
+    if ((!_NeuronIDs.empty()) && ((_NeuronIDs.front() < 0) || (size_t(_NeuronIDs.back()) >= this->Neurons.size()))) {
+        return false;
+    }
+
+    // Spikes of the current step are published at its end, so every spike
+    // before T_ms is final and T_ms can serve as the cursor of the next call.
+    Tools::SpikeRasterEncoder Encoder(_TStart_ms, std::min(_TEnd_ms, this->T_ms), _Resolution_ms);
+    for (int NeuronID : _NeuronIDs) {
+        Encoder.AddNeuron(NeuronID, this->Neurons[NeuronID]->TAct_ms);
+    }
+    _Raster = Encoder.Finish();
+    return true;
+}
+
+nlohmann::json Simulation::GetRecordingJSON(size_t _Cursor) const {
     nlohmann::json recording;
 
-    recording["t_ms"] = nlohmann::json(this->TRecorded_ms);
+    size_t NumTotal = NumTRecordedDropped + this->TRecorded_ms.size();
+    size_t NumNew = Tools::SamplesSinceCursor(_Cursor, NumTotal, this->TRecorded_ms.size());
+    recording["t_ms"] = Tools::LatestJSON(this->TRecorded_ms, NumNew);
+    recording["cursor"] = NumTotal;
 
     // *** The by-neural-circuit version is presently not being used.
     // if (!this->NeuralCircuits.empty()) {
@@ -1471,7 +2590,8 @@ nlohmann::json Simulation::GetRecordingJSON() const {
         nlohmann::json & neuron_recordings = recording.at("neurons");
         for (const auto & neuron_ptr : this->Neurons) {
             assert(neuron_ptr);
-            neuron_recordings[std::to_string(neuron_ptr->ID)] = neuron_ptr->GetRecordingJSON();
+            const BallAndStick::BSNeuron* bsneuron_ptr = static_cast<const BallAndStick::BSNeuron*>(neuron_ptr.get());
+            neuron_recordings[std::to_string(neuron_ptr->ID)]["Vm_mV"] = Tools::LatestJSON(bsneuron_ptr->VmRecorded_mV, NumNew);
         }
 
     // }
@@ -1504,35 +2624,42 @@ bool Simulation::InstrumentsAreRecording() const {
     return T_ms < (InstrumentsStartRecordTime_ms + InstrumentsMaxRecordTime_ms);
 }
 
-nlohmann::json Simulation::GetInstrumentsRecordingJSON() const {
+nlohmann::json Simulation::GetInstrumentsRecordingJSON(size_t _Cursor, size_t _CaCursor) const {
     nlohmann::json recording;
 
-    recording["t_ms"] = nlohmann::json(this->TInstruments_ms);
+    size_t NumTotal = NumTInstrumentsDropped + this->TInstruments_ms.size();
+    size_t NumNew = Tools::SamplesSinceCursor(_Cursor, NumTotal, this->TInstruments_ms.size());
+    recording["t_ms"] = Tools::LatestJSON(this->TInstruments_ms, NumNew);
+    recording["cursor"] = NumTotal;
 
     // Virtual experimental functional data from recording electrodes
     if (!RecordingElectrodes.empty()) {
         recording["Electrodes"] = nlohmann::json::object();
         for (const auto & Electrode : RecordingElectrodes) {
-            recording["Electrodes"][Electrode->Name] = Electrode->GetRecordingJSON();
+            recording["Electrodes"][Electrode->Name] = Electrode->GetRecordingJSON(NumNew);
         }
     }
 
     // God's eye functional data about neuron calcium concentrations
     if (CaData_->State_ != BG::NES::VSDA::Calcium::CA_NOT_INITIALIZED) {
+        const std::vector<float> & TCa_ms = CaData_->CaImaging.TRecorded_ms;
+        size_t NumCaTotal = CaData_->CaImaging.NumDropped + TCa_ms.size();
+        size_t NumCaNew = Tools::SamplesSinceCursor(_CaCursor, NumCaTotal, TCa_ms.size());
+        recording["Ca_cursor"] = NumCaTotal;
         recording["Calcium"] = nlohmann::json::object();
-        recording["Calcium"]["Ca_t_ms"] = CaData_->CaImaging.TRecorded_ms;
+        recording["Calcium"]["Ca_t_ms"] = Tools::LatestJSON(TCa_ms, NumCaNew);
         if (CaData_->Params_.FlourescingNeuronIDs_.empty()) {
             // All neurons fluoresce.
             for (auto & neuron_ptr : Neurons) {
                 BallAndStick::BSNeuron* bsneuron_ptr = static_cast<BallAndStick::BSNeuron*>(neuron_ptr.get());
-                recording["Calcium"][std::to_string(bsneuron_ptr->ID)] = bsneuron_ptr->CaSamples;
+                recording["Calcium"][std::to_string(bsneuron_ptr->ID)] = Tools::LatestJSON(bsneuron_ptr->CaSamples, NumCaNew);
             }
 
         } else {
             // For specified fluorescing neurons set.
             for (auto & neuron_id : CaData_->Params_.FlourescingNeuronIDs_) if (neuron_id < Neurons.size()) {
                 BallAndStick::BSNeuron* bsneuron_ptr = static_cast<BallAndStick::BSNeuron*>(Neurons.at(neuron_id).get());
-                recording["Calcium"][std::to_string(bsneuron_ptr->ID)] = bsneuron_ptr->CaSamples;
+                recording["Calcium"][std::to_string(bsneuron_ptr->ID)] = Tools::LatestJSON(bsneuron_ptr->CaSamples, NumCaNew);
             }
         }
     }
@@ -1540,6 +2667,49 @@ nlohmann::json Simulation::GetInstrumentsRecordingJSON() const {
     return recording;
 }
 
+void Simulation::ApplyRecordingRetention() {
+    if (RecordingMaxSamples == 0) return;
+
+    // Series recorded together are trimmed together, so they stay aligned
+    // at their ends.
+    size_t NumDrop = Tools::RetentionExcess(TRecorded_ms.size(), RecordingMaxSamples);
+    if (NumDrop > 0) {
+        Tools::DropOldest(TRecorded_ms, NumDrop);
+        for (auto & neuron_ptr : Neurons) {
+            BallAndStick::BSNeuron* bsneuron_ptr = static_cast<BallAndStick::BSNeuron*>(neuron_ptr.get());
+            Tools::DropOldest(bsneuron_ptr->TRecorded_ms, NumDrop);
+            Tools::DropOldest(bsneuron_ptr->VmRecorded_mV, NumDrop);
+        }
+        NumTRecordedDropped += NumDrop;
+    }
+
+    NumDrop = Tools::RetentionExcess(TInstruments_ms.size(), RecordingMaxSamples);
+    if (NumDrop > 0) {
+        Tools::DropOldest(TInstruments_ms, NumDrop);
+        NumTInstrumentsDropped += NumDrop;
+    }
+    for (auto & Electrode : RecordingElectrodes) {
+        NumDrop = Tools::RetentionExcess(Electrode->TRecorded_ms.size(), RecordingMaxSamples);
+        if (NumDrop > 0) {
+            Tools::DropOldest(Electrode->TRecorded_ms, NumDrop);
+            for (auto & E_mV : Electrode->E_mV) Tools::DropOldest(E_mV, NumDrop);
+            Electrode->NumDropped += NumDrop;
+        }
+    }
+
+    Tools::CalciumImaging & CaImaging = CaData_->CaImaging;
+    NumDrop = Tools::RetentionExcess(CaImaging.TRecorded_ms.size(), RecordingMaxSamples);
+    if (NumDrop > 0) {
+        Tools::DropOldest(CaImaging.TRecorded_ms, NumDrop);
+        for (auto & neuron_ptr : Neurons) {
+            BallAndStick::BSNeuron* bsneuron_ptr = static_cast<BallAndStick::BSNeuron*>(neuron_ptr.get());
+            Tools::DropOldest(bsneuron_ptr->CaSamples, NumDrop);
+            Tools::DropOldest(bsneuron_ptr->TCaSamples_ms, NumDrop);
+        }
+        CaImaging.NumDropped += NumDrop;
+    }
+}
+
 nlohmann::json Simulation::GetSomaPositionsJSON() const {
     nlohmann::json somapositions;
     somapositions["SomaCenters"] = nlohmann::json::array();
@@ -1562,6 +2732,15 @@ nlohmann::json Simulation::GetSomaPositionsJSON() const {
     return somapositions;
 }
 
+/**
+ * Returns the CSR/CSC index of the abstracted LIFC receptors. It is
+ * rebuilt here if neurons or receptors were added since it was last used.
+ */
+const CoreStructs::ConnectomeIndex& Simulation::GetConnectomeIndex() const {
+    Connectome_.Build(LIFCReceptorDataVec, Neurons.size());
+    return Connectome_;
+}
+
 nlohmann::json Simulation::GetConnectomeJSON() const {
     nlohmann::json connectome;
     connectome["ConnectionTargets"] = nlohmann::json::array();
@@ -1603,6 +2782,17 @@ nlohmann::json Simulation::GetConnectomeJSON() const {
     return connectome;
 }
 
+/**
+ * Same count as LIFCNeuron::GetAbstractConnection(), but for one entry
+ * of the connectome index.
+ */
+static size_t LIFCAbstractReceptorCount(const CoreStructs::ConnectomeEntry& _Entry, bool NonZero) {
+    // In order to not double-count, this counts AMPA and GABA but not NMDA.
+    if (_Entry.Type == Connections::NMDA) return 0;
+    if (NonZero && (_Entry.Weight() == 0.0)) return 0;
+    return _Entry.NumReceptors;
+}
+
 /**
  * Count the number of receptors involved in a connection
  * between a pair of presynaptic neuron and postsynaptic neuron.
@@ -1616,7 +2806,11 @@ size_t Simulation::GetAbstractConnection(int PreSynID, int PostSynID, bool NonZe
     if (PostsynapticPtr->Class_<CoreStructs::_BSNeuron) return 0;
 
     if (SimNeuronClass == LIFCNEURONS) {
-        return static_cast<LIFCNeuron*>(PostsynapticPtr)->GetAbstractConnection(PreSynID, NonZero);
+        size_t NumReceptors = 0;
+        for (auto& Entry : GetConnectomeIndex().GetPair(PreSynID, PostSynID)) {
+            NumReceptors += LIFCAbstractReceptorCount(Entry, NonZero);
+        }
+        return NumReceptors;
     } else {
         return static_cast<BallAndStick::BSNeuron*>(PostsynapticPtr)->GetAbstractConnection(PreSynID, NonZero);
     }
@@ -1635,6 +2829,12 @@ std::vector<std::vector<size_t>> Simulation::GetAbstractConnectome(bool NonZero)
     std::vector<std::vector<size_t>> PrePostReceptorCounts(
         Neurons.size(),
         std::vector<size_t>(Neurons.size(), 0));
+    if (SimNeuronClass == LIFCNEURONS) {
+        for (auto& Entry : GetConnectomeIndex().GetEntries()) {
+            PrePostReceptorCounts[Entry.PostID][Entry.PreID] += LIFCAbstractReceptorCount(Entry, NonZero);
+        }
+        return PrePostReceptorCounts;
+    }
     for (int PostSynIdx = 0; PostSynIdx < Neurons.size(); PostSynIdx++) {
         for (int PreSynIdx = 0; PreSynIdx < Neurons.size(); PreSynIdx++) {
             size_t NumReceptors = GetAbstractConnection(PreSynIdx, PostSynIdx, NonZero);
@@ -1651,7 +2851,6 @@ std::vector<std::vector<size_t>> Simulation::GetAbstractConnectome(bool NonZero)
  * index is the presynaptic index: data[PreSynIdx][PostSynIdx].
  */
 nlohmann::json Simulation::GetAbstractConnectomeJSON(bool Sparse, bool NonZero) const {
-    auto PrePostReceptorCounts = GetAbstractConnectome(NonZero);
     nlohmann::json connectome;
     connectome["PrePostNumReceptors"] = nlohmann::json::array();
     nlohmann::json& reccntlist(connectome["PrePostNumReceptors"]);
@@ -1660,29 +2859,55 @@ nlohmann::json Simulation::GetAbstractConnectomeJSON(bool Sparse, bool NonZero)
     connectome["Types"] = nlohmann::json::array();
     nlohmann::json& typeslist(connectome["Types"]);
 
-    for (size_t PreSynIdx = 0; PreSynIdx<PrePostReceptorCounts.size(); PreSynIdx++) {
-        nlohmann::json frompresynreccntvec(nlohmann::json::value_t::array);
-        for (size_t PostSynIdx = 0; PostSynIdx<PrePostReceptorCounts.size(); PostSynIdx++) {
+    if (Sparse && (SimNeuronClass == LIFCNEURONS)) {
+
+        // The index is in the same (pre, post) order as the dense loop below,
+        // but only visits connected pairs.
+        auto Entries = GetConnectomeIndex().GetEntries();
+        for (auto* PairFirst = Entries.begin(); PairFirst != Entries.end(); ) {
+            size_t ReceptorCount = 0;
+            auto* PairLast = PairFirst;
+            while ((PairLast != Entries.end()) && (PairLast->PreID == PairFirst->PreID) && (PairLast->PostID == PairFirst->PostID)) {
+                ReceptorCount += LIFCAbstractReceptorCount(*PairLast, NonZero);
+                PairLast++;
+            }
+            if (ReceptorCount>0) {
+                nlohmann::json connectiondata(nlohmann::json::value_t::array);
+                connectiondata.push_back(size_t(PairFirst->PreID));
+                connectiondata.push_back(size_t(PairFirst->PostID));
+                connectiondata.push_back(ReceptorCount);
+                reccntlist.push_back(connectiondata);
+            }
+            PairFirst = PairLast;
+        }
+
+    } else {
 
-            size_t ReceptorCount = PrePostReceptorCounts[PostSynIdx][PreSynIdx];
+        auto PrePostReceptorCounts = GetAbstractConnectome(NonZero);
+        for (size_t PreSynIdx = 0; PreSynIdx<PrePostReceptorCounts.size(); PreSynIdx++) {
+            nlohmann::json frompresynreccntvec(nlohmann::json::value_t::array);
+            for (size_t PostSynIdx = 0; PostSynIdx<PrePostReceptorCounts.size(); PostSynIdx++) {
 
-            if (Sparse) {
+                size_t ReceptorCount = PrePostReceptorCounts[PostSynIdx][PreSynIdx];
 
-                if (ReceptorCount>0) {
-                    nlohmann::json connectiondata(nlohmann::json::value_t::array);
-                    connectiondata.push_back(PreSynIdx);
-                    connectiondata.push_back(PostSynIdx);
-                    connectiondata.push_back(ReceptorCount);
-                    reccntlist.push_back(connectiondata);
-                }
+                if (Sparse) {
 
-            } else {
+                    if (ReceptorCount>0) {
+                        nlohmann::json connectiondata(nlohmann::json::value_t::array);
+                        connectiondata.push_back(PreSynIdx);
+                        connectiondata.push_back(PostSynIdx);
+                        connectiondata.push_back(ReceptorCount);
+                        reccntlist.push_back(connectiondata);
+                    }
 
-                frompresynreccntvec.push_back(ReceptorCount);
-            }
+                } else {
+
+                    frompresynreccntvec.push_back(ReceptorCount);
+                }
 
+            }
+            if (!Sparse) reccntlist.push_back(frompresynreccntvec);
         }
-        if (!Sparse) reccntlist.push_back(frompresynreccntvec);
     }
 
     for (auto& RegionPtr : Regions) {
@@ -1701,6 +2926,48 @@ nlohmann::json Simulation::GetAbstractConnectomeJSON(bool Sparse, bool NonZero)
     return connectome;
 }
 
+/**
+ * Select serial or parallel neuron updates for RunFor. The thread pool is
+ * (re)created lazily at the start of the next run, so changing the number
+ * of threads is cheap until then.
+ */
+void Simulation::SetParallelUpdate(bool _ParallelUpdate, int _NumThreads) {
+    ParallelUpdate = _ParallelUpdate;
+    if (NumUpdateThreads != _NumThreads) {
+        NumUpdateThreads = _NumThreads;
+        UpdatePool_.reset();
+    }
+}
+
+/**
+ * Parallel updates are only safe where neurons do not modify each other
+ * during Update(). LIFCNeuron double-buffers its spikes and only reads
+ * committed presynaptic state, while BSNeuron/SCNeuron write cached spike
+ * data of their source neurons, so those keep using the serial path.
+ */
+bool Simulation::UsesParallelUpdate() const {
+    return ParallelUpdate && (SimNeuronClass == LIFCNEURONS);
+}
+
+/**
+ * Switches the receptor conductance states between history polling and
+ * event-driven delivery. In both cases the states are rebuilt from the
+ * full spike histories, so spikes in flight are neither lost nor counted
+ * twice when switching.
+ */
+void Simulation::PrepareConductanceStates(bool _EventDriven) {
+    SpikeEvents_.Clear();
+    for (auto& RData : LIFCReceptorDataVec) {
+        RData->g_state.Reset();
+        if (_EventDriven) {
+            for (float tSpike_ms : RData->SrcNeuronPtr->TAct_ms) {
+                RData->g_state.arrivals_ms.push_back(tSpike_ms + RData->onset_delay_ms);
+            }
+        }
+    }
+    EventDrivenActive_ = _EventDriven;
+}
+
 enum sim_methods {
     simmethod_list_of_neurons,
     simmethod_circuits,
@@ -1731,9 +2998,58 @@ void Simulation::RunFor(float tRun_ms) {
     // *** TODO: obtain this from an API call...
     sim_methods simmethod = simmethod_list_of_neurons;
 
+    bool parallel = UsesParallelUpdate();
+    if (parallel) {
+        if (!UpdatePool_) {
+            UpdatePool_ = std::make_unique<Updater::NeuronUpdatePool>(NumUpdateThreads);
+        }
+        Logger_->Log("Updating neurons in parallel on "+std::to_string(UpdatePool_->GetNumThreads())+" threads.", 3);
+    } else if (ParallelUpdate) {
+        Logger_->Log("Parallel updates are only supported for LIFC neurons, updating serially.", 6);
+    }
+
+    size_t num_neurons = 0;
+    for (auto & neuron_ptr : this->Neurons) {
+        if (neuron_ptr) num_neurons++;
+    }
+
+    // Parameters may have been edited since the last run, so repack them.
+    // The state of the kernel neurons lives in the arrays until they are
+    // released, which the binding also does if the run throws.
+    bool state_arrays = use_lifc_state_arrays && (SimNeuronClass == LIFCNEURONS);
+    if (state_arrays && !LIFCArrays_) {
+        LIFCArrays_ = std::make_unique<LIFCStateArrays>();
+    }
+    LIFCStateArraysBinding state_arrays_binding(state_arrays ? LIFCArrays_.get() : nullptr, this->Neurons);
+    if (state_arrays) {
+        Logger_->Log("Updating "+std::to_string(LIFCArrays_->GetNumKernelNeurons())+" LIFC neurons with state array kernels.", 3);
+    }
+
+    // STDP reads the index from the neuron updates, which may run in parallel.
+    if (SimNeuronClass == LIFCNEURONS) {
+        GetConnectomeIndex();
+    }
+
+    bool event_driven = use_event_driven_delivery && (SimNeuronClass == LIFCNEURONS);
+    if (event_driven != EventDrivenActive_) {
+        PrepareConductanceStates(event_driven);
+    }
+    if (event_driven) {
+        SpikeEvents_.Configure(Dt_ms, T_ms);
+    }
+
     unsigned long num_updates_called = 0;
+    bool aborted = false;
+    RunStarted(tEnd_ms);
     while (this->T_ms < tEnd_ms) {
 
+        // Pause and abort take effect here, between timesteps.
+        if (!RunStepBoundary()) {
+            aborted = true;
+            Logger_->Log("Simulation " + std::to_string(ID) + " Run Aborted At " + std::to_string(T_ms) + " ms", 4);
+            break;
+        }
+
         // Track time-points for God's eye recording
         bool recording = this->IsRecording();
         if (recording) {
@@ -1741,19 +3057,44 @@ void Simulation::RunFor(float tRun_ms) {
             this->TRecorded_ms.emplace_back(this->T_ms);
         }
 
+        if (event_driven) {
+            SpikeEvents_.Deliver(this->T_ms);
+        }
+
         // Call update in circuits (neurons, etc)
         switch (simmethod) {
             case simmethod_circuits: // *** For now, use the same method
             case simmethod_list_of_neurons: {
-                //std::cout << "DEBUG --> "; std::cout.flush();
-                for (auto & neuron_ptr : this->Neurons) {
-                    if (neuron_ptr) {
-                        //std::cout << "."; std::cout.flush();
-                        neuron_ptr->Update(this->T_ms, recording);
-                        num_updates_called++;
+                if (state_arrays) {
+                    LIFCArrays_->Update(this->T_ms, recording, parallel ? UpdatePool_.get() : nullptr);
+                    num_updates_called += LIFCArrays_->GetNumNeurons();
+                } else if (parallel) {
+                    float t_ms = this->T_ms;
+                    UpdatePool_->ParallelFor(this->Neurons.size(), 0, [&](size_t _Start, size_t _End) {
+                        for (size_t i = _Start; i < _End; i++) {
+                            auto & neuron_ptr = this->Neurons[i];
+                            if (neuron_ptr) neuron_ptr->Update(t_ms, recording);
+                        }
+                    });
+                    num_updates_called += num_neurons;
+                } else {
+                    //std::cout << "DEBUG --> "; std::cout.flush();
+                    for (auto & neuron_ptr : this->Neurons) {
+                        if (neuron_ptr) {
+                            //std::cout << "."; std::cout.flush();
+                            neuron_ptr->Update(this->T_ms, recording);
+                            num_updates_called++;
+                        }
                     }
+                    //std::cout << '\n'; std::cout.flush();
+                }
+
+                // Publish the spikes of this timestep only after all neurons
+                // were updated, so that every neuron saw the same presynaptic
+                // state. This keeps serial and parallel results identical.
+                for (auto & neuron_ptr : this->Neurons) {
+                    if (neuron_ptr) neuron_ptr->CommitSpikes();
                 }
-                //std::cout << '\n'; std::cout.flush();
                 break;
             }
             // case simmethod_circuits: {
@@ -1771,9 +3112,12 @@ void Simulation::RunFor(float tRun_ms) {
         if (InstrumentsAreRecording()) {
             this->TInstruments_ms.emplace_back(this->T_ms);
 
-            // Electrodes
-            for (auto & Electrode : RecordingElectrodes) {
-                Electrode->Record(this->T_ms);
+            // Electrodes, all share one gathered array of membrane potentials.
+            if (!RecordingElectrodes.empty()) {
+                Tools::RecordingElectrode::GatherMembranePotentials(this->Neurons, ElectrodeVm_mV_);
+                for (auto & Electrode : RecordingElectrodes) {
+                    Electrode->Record(this->T_ms, ElectrodeVm_mV_);
+                }
             }
 
             // Calcium Imaging
@@ -1782,8 +3126,19 @@ void Simulation::RunFor(float tRun_ms) {
             }
         }
 
+        // Streamed recordings
+        for (auto & Sink : RecordingSinks) {
+            Sink->Sample(this);
+        }
+        ApplyRecordingRetention();
+
         this->T_ms += this->Dt_ms;
     }
+    state_arrays_binding.Release();
+    for (auto & Sink : RecordingSinks) {
+        if (!Sink->Flush()) Logger_->Log("Failed to write to recording sink file " + Sink->GetPath(), 7);
+    }
+    RunEnded(aborted);
     Logger_->Log("Number of top-level Update() calls: "+std::to_string(num_updates_called), 3);
     Logger_->Log("Total number of spikes on all neurons: "+std::to_string(TotalSpikes()), 3);
 };
@@ -1877,11 +3232,13 @@ std::string Simulation::WrapAsNESRequest( const std::string & _RequestJSON, cons
 // }
 
 void Simulation::StoreRequestHandled(const std::string & _Route, const std::string & _RequestJSON) {
+    std::lock_guard<std::mutex> Lock(StoredRequestsMutex_);
     // We store everything as a Request within a NESRequest block:
     StoredRequests.emplace_back(_Route, WrapAsNESRequest(_RequestJSON, _Route));
 }
 
 std::string Simulation::StoredRequestsToString() const {
+    std::lock_guard<std::mutex> Lock(StoredRequestsMutex_);
     std::stringstream ss;
     for (const auto & storedreq: StoredRequests) {
         ss << storedreq.Str() << '\n';
@@ -1890,6 +3247,7 @@ std::string Simulation::StoredRequestsToString() const {
 }
 
 std::string Simulation::StoredRequestsToNESRequestArray() const {
+    std::lock_guard<std::mutex> Lock(StoredRequestsMutex_);
     std::stringstream ss;
     ss << "[\n";
     for (size_t i = 0; i < StoredRequests.size(); i++) {
@@ -1927,6 +3285,269 @@ std::string TimeStamp() {
     return ss.str();
 }
 
+bool Simulation::RequestWork(SimulationActions _Task) {
+    {
+        std::lock_guard<std::mutex> Lock(EngineMutex_);
+        if (TaskClaimed_) {
+            return false;
+        }
+        CurrentTask = _Task;
+        WorkRequestedAt_ = std::chrono::steady_clock::now();
+        WorkRequested = true;
+    }
+    EngineWake_.notify_all();
+    return true;
+}
+
+void Simulation::WakeEngine() {
+    // Taking the lock orders the flag change before the waiter's predicate
+    // check, so the notification cannot fall between check and wait.
+    {
+        std::lock_guard<std::mutex> Lock(EngineMutex_);
+    }
+    EngineWake_.notify_all();
+}
+
+void Simulation::RenderingDone() {
+    {
+        std::lock_guard<std::mutex> Lock(EngineMutex_);
+        IsRendering = false;
+    }
+    EngineWake_.notify_all();
+}
+
+bool Simulation::WaitForWork(const std::atomic<bool>& _StopThreads) {
+    std::unique_lock<std::mutex> Lock(EngineMutex_);
+    EngineWake_.wait(Lock, [&]() { return _StopThreads || (!KeepResident) || WorkRequested; });
+    if (_StopThreads || (!KeepResident)) {
+        return false;
+    }
+
+    std::chrono::duration<double, std::milli> Wait = std::chrono::steady_clock::now() - WorkRequestedAt_;
+    EngineStats_.NumCommands++;
+    EngineStats_.LastWait_ms = Wait.count();
+    EngineStats_.MaxWait_ms = std::max(EngineStats_.MaxWait_ms, Wait.count());
+    EngineStats_.TotalWait_ms += Wait.count();
+    return true;
+}
+
+void Simulation::WaitWhileRendering() {
+    std::unique_lock<std::mutex> Lock(EngineMutex_);
+    EngineWake_.wait(Lock, [this]() { return !IsRendering; });
+}
+
+bool Simulation::ClaimForTask() {
+    std::lock_guard<std::mutex> Lock(EngineMutex_);
+    // A queued run has not set WorkRequested yet, see RequestRun().
+    if (TaskClaimed_ || IsProcessing || WorkRequested || IsRendering || (RunState_ == RUN_QUEUED)) {
+        return false;
+    }
+    TaskClaimed_ = true;
+    return true;
+}
+
+void Simulation::ReleaseTaskClaim() {
+    std::lock_guard<std::mutex> Lock(EngineMutex_);
+    TaskClaimed_ = false;
+}
+
+bool Simulation::IsTaskClaimed() {
+    std::lock_guard<std::mutex> Lock(EngineMutex_);
+    return TaskClaimed_;
+}
+
+nlohmann::json Simulation::GetEngineStatsJSON() {
+    std::lock_guard<std::mutex> Lock(EngineMutex_);
+    nlohmann::json StatsJSON;
+    // Work is requested one command at a time (routes refuse busy
+    // simulations), so at most one command waits for the engine thread.
+    StatsJSON["QueueDepth"] = (WorkRequested && (!IsProcessing)) ? 1 : 0;
+    StatsJSON["NumCommands"] = EngineStats_.NumCommands;
+    StatsJSON["LastWait_ms"] = EngineStats_.LastWait_ms;
+    StatsJSON["MaxWait_ms"] = EngineStats_.MaxWait_ms;
+    StatsJSON["MeanWait_ms"] = (EngineStats_.NumCommands > 0) ? (EngineStats_.TotalWait_ms / EngineStats_.NumCommands) : 0.0;
+    return StatsJSON;
+}
+
+int Simulation::RequestRun(float _Runtime_ms, float _Dt_ms, const std::function<void(int)>& _Queued) {
+    int RunID = -1;
+    {
+        std::lock_guard<std::mutex> Lock(EngineMutex_);
+        if (TaskClaimed_) {
+            return -1;
+        }
+        RunTimes_ms = _Runtime_ms;
+        Dt_ms = _Dt_ms;
+        RunPauseRequested_ = false;
+        RunAbortRequested_ = false;
+        RunState_ = RUN_QUEUED;
+        RunID = ++RunID_;
+    }
+
+    // The engine thread cannot start the run before RequestWork(), so an
+    // abort cannot reach RunEnded() before _Queued stored the request. A
+    // queued run cannot be claimed, so RequestWork() succeeds.
+    if (_Queued) {
+        _Queued(RunID);
+    }
+    RequestWork(SIMULATION_RUNFOR);
+    return RunID;
+}
+
+bool Simulation::RunIsActive() const {
+    RunState State = RunState_;
+    return (State == RUN_QUEUED) || (State == RUN_RUNNING) || (State == RUN_PAUSED);
+}
+
+bool Simulation::PauseRun() {
+    if (!RunIsActive()) {
+        return false;
+    }
+    RunPauseRequested_ = true;
+    return true;
+}
+
+bool Simulation::ResumeRun() {
+    if (!RunIsActive()) {
+        return false;
+    }
+    {
+        std::lock_guard<std::mutex> Lock(EngineMutex_);
+        RunPauseRequested_ = false;
+    }
+    EngineWake_.notify_all();
+    return true;
+}
+
+bool Simulation::AbortRun() {
+    if (!RunIsActive()) {
+        return false;
+    }
+    {
+        std::lock_guard<std::mutex> Lock(EngineMutex_);
+        RunAbortRequested_ = true;
+    }
+    EngineWake_.notify_all();
+    return true;
+}
+
+void Simulation::RunStarted(float _tEnd_ms) {
+    std::lock_guard<std::mutex> Lock(EngineMutex_);
+    RunStartT_ms_ = T_ms;
+    RunEndT_ms_ = _tEnd_ms;
+    RunT_ms_ = T_ms;
+    RunStartedAt_ = std::chrono::steady_clock::now();
+    RunPausedFor_ = std::chrono::steady_clock::duration(0);
+    RunState_ = RUN_RUNNING;
+}
+
+bool Simulation::RunStepBoundary() {
+    RunT_ms_ = T_ms;
+    if (RunAbortRequested_) {
+        return false;
+    }
+    if (!RunPauseRequested_) {
+        return true;
+    }
+
+    std::unique_lock<std::mutex> Lock(EngineMutex_);
+    RunPausedAt_ = std::chrono::steady_clock::now();
+    RunState_ = RUN_PAUSED;
+    Logger_->Log("Simulation " + std::to_string(ID) + " Paused At " + std::to_string(T_ms) + " ms", 3);
+    EngineWake_.wait(Lock, [this]() { return (!RunPauseRequested_) || RunAbortRequested_ || (!KeepResident); });
+    RunPausedFor_ += std::chrono::steady_clock::now() - RunPausedAt_;
+    RunState_ = RUN_RUNNING;
+    return !(RunAbortRequested_ || (!KeepResident));
+}
+
+void Simulation::RunEnded(bool _Aborted) {
+    {
+        std::lock_guard<std::mutex> Lock(EngineMutex_);
+        RunT_ms_ = T_ms;
+        RunEndedAt_ = std::chrono::steady_clock::now();
+        RunPauseRequested_ = false;
+        RunAbortRequested_ = false;
+        RunState_ = _Aborted ? RUN_ABORTED : RUN_DONE;
+    }
+    if (_Aborted) {
+        RewriteAbortedRunRequest(T_ms - RunStartT_ms_);
+    }
+}
+
+void Simulation::SetRunRequest(int _RunID) {
+    std::lock_guard<std::mutex> Lock(StoredRequestsMutex_);
+    if (StoredRequests.empty()) {
+        return;
+    }
+    RunRequestID_ = _RunID;
+    RunRequestIndex_ = StoredRequests.size() - 1;
+}
+
+void Simulation::RewriteAbortedRunRequest(float _Done_ms) {
+    std::lock_guard<std::mutex> Lock(StoredRequestsMutex_);
+    if ((RunRequestID_ != RunID_) || (RunRequestIndex_ >= StoredRequests.size())) {
+        return;
+    }
+    RunRequestID_ = -1;
+
+    // Nothing ran, and RunFor does not accept a Runtime_ms of 0.
+    if (_Done_ms <= 0.0f) {
+        StoredRequests.erase(StoredRequests.begin() + RunRequestIndex_);
+        return;
+    }
+
+    StoredRequest& Request = StoredRequests[RunRequestIndex_];
+    nlohmann::json Wrapped = nlohmann::json::parse(Request.RequestJSON, nullptr, false);
+    if (Wrapped.is_discarded() || (!Wrapped.contains(Request.Route))) {
+        return;
+    }
+    Wrapped[Request.Route]["Runtime_ms"] = _Done_ms;
+    Request.RequestJSON = Wrapped.dump();
+}
+
+nlohmann::json Simulation::GetRunProgressJSON() {
+    static const char* StateNames[] = { "idle", "queued", "running", "paused", "done", "aborted" };
+
+    std::lock_guard<std::mutex> Lock(EngineMutex_);
+    RunState State = RunState_;
+    nlohmann::json ProgressJSON;
+    ProgressJSON["RunID"] = int(RunID_);
+    ProgressJSON["State"] = StateNames[State];
+    if ((State == RUN_IDLE) || (State == RUN_QUEUED)) {
+        ProgressJSON["Done_ms"] = 0.0;
+        ProgressJSON["Remaining_ms"] = (State == RUN_QUEUED) ? RunTimes_ms : 0.0;
+        ProgressJSON["PercentComplete"] = 0.0;
+        ProgressJSON["WallElapsed_s"] = 0.0;
+        ProgressJSON["Rate_ms_per_s"] = 0.0;
+        ProgressJSON["ETA_s"] = -1.0;
+        return ProgressJSON;
+    }
+
+    float Done_ms = RunT_ms_ - RunStartT_ms_;
+    float Total_ms = RunEndT_ms_ - RunStartT_ms_;
+    float Remaining_ms = std::max(RunEndT_ms_ - RunT_ms_, 0.0f);
+
+    // Wall-clock time spent running, without pauses.
+    auto Now = (State == RUN_RUNNING) ? std::chrono::steady_clock::now() : ((State == RUN_PAUSED) ? RunPausedAt_ : RunEndedAt_);
+    std::chrono::duration<double> Elapsed = (Now - RunStartedAt_) - RunPausedFor_;
+    double Rate_ms_per_s = (Elapsed.count() > 0.0) ? (Done_ms / Elapsed.count()) : 0.0;
+
+    ProgressJSON["StartT_ms"] = RunStartT_ms_;
+    ProgressJSON["EndT_ms"] = RunEndT_ms_;
+    ProgressJSON["T_ms"] = float(RunT_ms_);
+    ProgressJSON["Done_ms"] = Done_ms;
+    ProgressJSON["Remaining_ms"] = ((State == RUN_DONE) || (State == RUN_ABORTED)) ? 0.0f : Remaining_ms;
+    ProgressJSON["PercentComplete"] = (Total_ms > 0.0f) ? std::min(100.0f * Done_ms / Total_ms, 100.0f) : 100.0f;
+    ProgressJSON["WallElapsed_s"] = Elapsed.count();
+    ProgressJSON["Rate_ms_per_s"] = Rate_ms_per_s;
+    if ((State == RUN_DONE) || (State == RUN_ABORTED)) {
+        ProgressJSON["ETA_s"] = 0.0;
+    } else {
+        ProgressJSON["ETA_s"] = (Rate_ms_per_s > 0.0) ? (Remaining_ms / Rate_ms_per_s) : -1.0;
+    }
+    return ProgressJSON;
+}
+
 std::string Simulation::StoredRequestsSave() const {
     // Make sure the directory exists.
     std::error_code err;
@@ -13,7 +13,11 @@
 // Standard Libraries (BG convention: use <> instead of "")
 #include <atomic>
 #include <cassert>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <stdexcept>
 #include <string>
 #include <tuple>
@@ -32,14 +36,22 @@
 #include <Simulator/Geometries/GeometryCollection.h>
 #include <Simulator/Geometries/VecTools.h>
 #include <Simulator/Structs/BS.h>
+#include <Simulator/Structs/Checkpoint.h>
+#include <Simulator/Structs/ConnectomeIndex.h>
 #include <Simulator/Structs/LIFC.h>
 #include <Simulator/Structs/NeuralCircuit.h>
 #include <Simulator/Structs/Neuron.h>
 #include <Simulator/Structs/PatchClampADC.h>
 #include <Simulator/Structs/PatchClampDAC.h>
 #include <Simulator/Structs/Receptor.h>
+#include <Simulator/Structs/RecordingRetention.h>
+#include <Simulator/Structs/RecordingSink.h>
+#include <Simulator/Structs/SpikeRaster.h>
 #include <Simulator/Structs/Staple.h>
 #include <Simulator/Distributions/Generic.h>
+#include <Simulator/Updaters/NeuronUpdatePool.h>
+#include <Simulator/Updaters/SpikeEventQueue.h>
+#include <Simulator/LIFCompartmental/LIFCStateArrays.h>
 #include <BG/Common/Logger/Logger.h>
 
 #include <Visualizer/VisualizerParameters.h>
@@ -60,9 +72,13 @@ namespace Tools {
     struct RecordingElectrode;
     struct CalciumImaging;
 }
+class ModelFileLoader;
 
 enum SimulationActions { SIMULATION_NONE, SIMULATION_RESET, SIMULATION_RUNFOR, SIMULATION_VSDA, SIMULATION_CALCIUM, SIMULATION_VISUALIZATION};
 
+//! State of the last RunFor job of a simulation, see Simulation::RequestRun().
+enum RunState { RUN_IDLE, RUN_QUEUED, RUN_RUNNING, RUN_PAUSED, RUN_DONE, RUN_ABORTED };
+
 enum SimulationNeuronClass: int {
     UNDETERMINED = -1,
     BSNEURONS = 0,
@@ -77,6 +93,15 @@ struct SaveLoadPrior {
     std::string str() const;
 };
 
+//! Counters of the commands handled by the engine thread of a simulation,
+//! see Simulation::RequestWork() and Simulation::WaitForWork().
+struct EngineStats {
+    size_t NumCommands = 0;   /**Commands picked up by the engine thread*/
+    double LastWait_ms = 0.0; /**Time between request and pick-up of the last command*/
+    double MaxWait_ms = 0.0;
+    double TotalWait_ms = 0.0;
+};
+
 struct StoredRequest {
     std::string Route;
     std::string RequestJSON;
@@ -93,9 +118,39 @@ struct Simulation {
 protected:
     std::vector<StoredRequest> StoredRequests;
     int StoredReqID = 0; // Used to create request IDs for stored NESRequests.
+    mutable std::mutex StoredRequestsMutex_; /**Routes that permit busy simulations store requests while a run may rewrite its own*/
+    int RunRequestID_ = -1; /**Run whose RunFor request is StoredRequests[RunRequestIndex_], see SetRunRequest()*/
+    size_t RunRequestIndex_ = 0;
 
     int RunningManagedTasksCounter = 0; // Tracks running managed tasks, but not Netmorph thread or the thread in SimulationThreads_.
 
+    std::mutex EngineMutex_; /**Guards the hand-over of work to the engine thread and EngineStats_*/
+    std::condition_variable EngineWake_; /**Wakes the engine thread when work is requested, rendering is done or it should stop*/
+    std::chrono::steady_clock::time_point WorkRequestedAt_;
+    EngineStats EngineStats_;
+    bool TaskClaimed_ = false; /**A managed task works on the simulation off the engine thread, see ClaimForTask(). Guarded by EngineMutex_*/
+
+    // RunFor job control and progress. Flags are polled at every timestep
+    // boundary, times are guarded by EngineMutex_.
+    std::atomic<int> RunID_{0};
+    std::atomic<RunState> RunState_{RUN_IDLE};
+    std::atomic<bool> RunPauseRequested_{false};
+    std::atomic<bool> RunAbortRequested_{false};
+    std::atomic<float> RunT_ms_{0.0}; /**Simulated time reached by the current run, T_ms is not safe to read while running*/
+    float RunStartT_ms_ = 0.0;
+    float RunEndT_ms_ = 0.0;
+    std::chrono::steady_clock::time_point RunStartedAt_;
+    std::chrono::steady_clock::time_point RunPausedAt_;
+    std::chrono::steady_clock::time_point RunEndedAt_;
+    std::chrono::steady_clock::duration RunPausedFor_{0};
+
+    bool BuildModel(ModelFileLoader& _Loader);
+
+    void RunStarted(float _tEnd_ms);
+    bool RunStepBoundary(); // false if the run should end here
+    void RunEnded(bool _Aborted);
+    void RewriteAbortedRunRequest(float _Done_ms);
+
 public:
     BG::Common::Logger::LoggingSystem* Logger_ = nullptr;
 
@@ -116,9 +171,19 @@ public:
     bool STDP = false; // STDP simulation included when true
     bool use_abstracted_LIF_receptors = true; // Abstracted functional receptors with LIFCNeuron
     bool triangulate_precise_spiketimes = false; // Use this with larger Dt_ms for better spike time precision
+    bool use_recursive_conductances = false; // O(1) recursive LIFC PSP/AHP/ADP conductances instead of g_norm()
+    bool use_lifc_state_arrays = true; // Update LIFC membranes, thresholds and after-potentials with the vectorized LIFCStateArrays kernels
+    bool use_event_driven_delivery = false; // Deliver LIFC spikes through SpikeEvents_ instead of polling spike histories
 
     bool ShowFunctionalParameters = false; // Mostly for testing, turn on if needed
 
+    bool ParallelUpdate = false; // Update neurons on UpdatePool_ instead of serially (LIFC only)
+    int NumUpdateThreads = 0; // Threads used by UpdatePool_, 0 means all hardware threads
+    std::unique_ptr<Updater::NeuronUpdatePool> UpdatePool_; /**Created on demand at the start of RunFor*/
+    std::unique_ptr<LIFCStateArrays> LIFCArrays_; /**Rebuilt at the start of RunFor with use_lifc_state_arrays*/
+    Updater::SpikeEventQueue SpikeEvents_; /**Spikes in flight with use_event_driven_delivery*/
+    bool EventDrivenActive_ = false; /**Event-driven delivery was used by the current or last RunFor*/
+
     std::atomic<bool> IsProcessing = false;  /**Indicator if the simulation is currently being modified or not*/
     std::atomic<bool> WorkRequested = false; /**Indicator if work is requested to be done on this simulation by a worker thread*/
     std::atomic<bool> IsRendering = false;   /**Indicates if this simulation is being acted upon by a renderer or not*/
@@ -127,6 +192,8 @@ public:
 
     std::vector<float> TInstruments_ms{};
     std::vector<std::unique_ptr<Tools::RecordingElectrode>> RecordingElectrodes;
+    std::vector<float> ElectrodeVm_mV_; /**Membrane potentials gathered for RecordingElectrodes every instrument sample*/
+    std::vector<std::unique_ptr<Tools::RecordingSink>> RecordingSinks; /**Binary streams of recorded variables, index is their id*/
     //std::unique_ptr<Tools::CalciumImaging> CaImaging; --- Replaced by Calcium below.
 
     float InstrumentsStartRecordTime_ms = 0.0;
@@ -135,6 +202,10 @@ public:
     float StartRecordTime_ms = 0.0;
     float MaxRecordTime_ms = 0.0;
 
+    size_t RecordingMaxSamples = 0; /**Retention limit of every recorded series (see Tools::RetentionExcess), 0 keeps everything*/
+    size_t NumTRecordedDropped = 0; /**Samples dropped from the front of TRecorded_ms by the retention limit*/
+    size_t NumTInstrumentsDropped = 0; /**Samples dropped from the front of TInstruments_ms by the retention limit*/
+
     //std::unordered_map<std::string, std::shared_ptr<BrainRegions::BrainRegion>> Regions;
     std::vector<std::unique_ptr<BrainRegions::BrainRegion>> Regions;
     //std::unordered_map<std::string, std::shared_ptr<CoreStructs::NeuralCircuit>> NeuralCircuits;
@@ -156,6 +227,7 @@ public:
     std::vector<std::unique_ptr<Connections::LIFCReceptor>> LIFCReceptors; /**List of receptor connections, index is their id (and it's also stored in the struct itself)*/
     std::vector<std::unique_ptr<CoreStructs::ReceptorData>> ReceptorDataVec; // Used for functional data access
     std::vector<std::unique_ptr<CoreStructs::LIFCReceptorData>> LIFCReceptorDataVec;
+    mutable CoreStructs::ConnectomeIndex Connectome_; /**CSR/CSC index of LIFCReceptorDataVec, see GetConnectomeIndex()*/
 
     std::vector<Tools::PatchClampDAC> PatchClampDACs; /**List of patchclamp dacs, id is index*/
     std::vector<Tools::PatchClampADC> PatchClampADCs; /**List of patchclamp adcs, id is index*/
@@ -197,6 +269,7 @@ public:
     int AddBox(Geometries::Box& _S);
 
     bool CheckCompatibility(SimulationNeuronClass _NewObjectCategory);
+    bool IsCompatible(SimulationNeuronClass _NewObjectCategory) const; // Like CheckCompatibility(), without setting the class.
     int AddSCCompartment(Compartments::BS& _C, SimulationNeuronClass _NewObjectCategory);
     int AddLIFCCompartment(Compartments::LIFC& _C);
     int AddBSNeuron(CoreStructs::BSNeuronStruct& _N);
@@ -212,10 +285,35 @@ public:
 
     void RegisterNeuronUIDToCompartments(std::vector<int> _GeometryCompartmentIDs, uint64_t _NeuronUID);
 
+    //! Models are saved as columnar model files (ModelFile.h). LoadModel
+    //! also reads legacy files, which SaveLegacyModel still writes.
+    //! BS models cannot be saved, SaveModel logs an error and returns false.
     bool SaveModel(const std::string& Name);
     bool LoadModel(const std::string& Name);
+    //! In-memory model images, in the same format as model files.
+    bool SaveModel(std::vector<uint8_t>& _Image);
+    bool LoadModel(std::vector<uint8_t>&& _Image);
+    bool SaveLegacyModel(const std::string& Name);
+    bool LoadLegacyModel(const std::string& Name);
+    void ClearModel();
     void InspectSavedModel(const std::string& Name, SaveLoadPrior& _SaveLoadPrior) const;
 
+    //! Dynamic state checkpoints. These hold everything RunFor() changes but
+    //! not the model, and are restored onto a simulation with the same model
+    //! so that it continues exactly as the saved one would have.
+    void SaveState(Tools::CheckpointWriter& _Writer) const;
+    bool LoadState(Tools::CheckpointReader& _Reader);
+    bool SaveCheckpoint(const std::string& Name) const;
+    bool LoadCheckpoint(const std::string& Name);
+
+    //! Makes _Clone, a fresh simulation, an independent copy of this one:
+    //! model, settings, instruments and dynamic state. Run with the same
+    //! inputs, the clone does exactly what this simulation would do.
+    //! The calcium imaging setup is copied, recording sinks and rendered
+    //! images are not. Fails for models of BS neurons, which cannot be saved.
+    //! The engine of this simulation must not run meanwhile, see ClaimForTask().
+    bool CloneTo(Simulation& _Clone);
+
     size_t GetNumCompartments(); // independent of SimNeuronClass
     Compartments::Compartment* GetCompartmentByIdx(size_t Idx); // independent of SimNeuronClass
     size_t GetNumReceptors(); // independent of SimNeuronClass
@@ -247,15 +345,30 @@ public:
     void SetRecordAll(float tMax_ms = _RECORD_FOREVER_TMAX_MS);
     bool IsRecording() const;
     std::unordered_map<std::string, CoreStructs::CircuitRecording> GetRecording();
-    nlohmann::json GetSpikeTimesJSON() const;
-    nlohmann::json GetRecordingJSON() const;
+    //! Spike times at or after _Cursor_ms. T_ms is the cursor of the next call.
+    nlohmann::json GetSpikeTimesJSON(float _Cursor_ms = 0.0) const;
+    //! Binary spike raster (see Tools::SpikeRasterHeader) of the spikes in
+    //! [_TStart_ms, min(_TEnd_ms, T_ms)). An empty neuron list selects all
+    //! neurons. Returns false if the neuron list contains unknown IDs.
+    bool GetSpikeRaster(float _TStart_ms, float _TEnd_ms, std::vector<int> _NeuronIDs, float _Resolution_ms, std::string& _Raster) const;
+    //! Recorded samples from sample index _Cursor on. The returned "cursor"
+    //! is the index of the next sample to be recorded.
+    nlohmann::json GetRecordingJSON(size_t _Cursor = 0) const;
 
     nlohmann::json GetCaImagingVoxelsJSON();
     void CalciumImagingRecordAposteriori();
 
     void SetRecordInstruments(float tMax_ms = _RECORD_FOREVER_TMAX_MS);
     bool InstrumentsAreRecording() const;
-    nlohmann::json GetInstrumentsRecordingJSON() const;
+    //! Instrument samples from index _Cursor on and calcium imaging samples
+    //! from index _CaCursor on, with "cursor" and "Ca_cursor" for the next call.
+    nlohmann::json GetInstrumentsRecordingJSON(size_t _Cursor = 0, size_t _CaCursor = 0) const;
+
+    //! Drops the oldest recorded samples of all series that exceed the
+    //! RecordingMaxSamples retention limit. Called by RunFor() every timestep.
+    void ApplyRecordingRetention();
+
+    const CoreStructs::ConnectomeIndex& GetConnectomeIndex() const;
 
     nlohmann::json GetSomaPositionsJSON() const;
     nlohmann::json GetConnectomeJSON() const;
@@ -263,17 +376,67 @@ public:
     std::vector<std::vector<size_t>> GetAbstractConnectome(bool NonZero) const;
     nlohmann::json GetAbstractConnectomeJSON(bool Sparse, bool NonZero) const;
 
+    void SetParallelUpdate(bool _ParallelUpdate, int _NumThreads = 0);
+    bool UsesParallelUpdate() const;
+    void PrepareConductanceStates(bool _EventDriven);
+
     void RunFor(float tRun_ms);
 
+    //! Engine thread hand-over (see EngineController.cpp). RequestWork() sets
+    //! CurrentTask and WorkRequested and wakes the engine thread right away,
+    //! it returns false without doing so if the simulation is claimed by a
+    //! task (see ClaimForTask()). Anything else the engine thread waits for (IsRendering, KeepResident,
+    //! the stop flag) must be followed by WakeEngine() or set with
+    //! RenderingDone().
+    bool RequestWork(SimulationActions _Task);
+    void WakeEngine();
+    void RenderingDone();
+    //! Blocks until work is requested (returns true) or the engine thread
+    //! should exit (returns false).
+    bool WaitForWork(const std::atomic<bool>& _StopThreads);
+    void WaitWhileRendering();
+    nlohmann::json GetEngineStatsJSON();
+
+    //! Managed tasks that read or write the whole simulation off the engine
+    //! thread (checkpoints, clones, sweeps) claim it first. ClaimForTask()
+    //! fails if the engine thread is busy, has work or a run queued, or the
+    //! simulation is already claimed. While claimed, RequestWork() and
+    //! RequestRun() refuse and routes treat the simulation as busy.
+    bool ClaimForTask();
+    void ReleaseTaskClaim();
+    bool IsTaskClaimed();
+
+    //! RunFor as a job. RequestRun() queues a run of _Runtime_ms on the
+    //! engine thread and returns its RunID, or -1 if the simulation is
+    //! claimed by a task. _Queued, if given, is called
+    //! with the RunID before the engine thread is woken, e.g. to store the
+    //! request with SetRunRequest(). Pause, resume and abort take
+    //! effect at the next timestep boundary, so an aborted run leaves the
+    //! simulation and its recordings as if it had been asked to run until
+    //! that time. They return false if the run is not queued or running.
+    int RequestRun(float _Runtime_ms, float _Dt_ms, const std::function<void(int)>& _Queued = nullptr);
+    bool PauseRun();
+    bool ResumeRun();
+    bool AbortRun();
+    bool RunIsActive() const;
+    int GetRunID() const { return RunID_; }
+    nlohmann::json GetRunProgressJSON();
+
     void Show();
 
     std::string WrapAsNESRequest(const std::string & _RequestJSON, const std::string & _Route);
     void StoreRequestHandled(const std::string & _Route, const std::string & _RequestJSON);
-    size_t NumStoredRequests() const { return StoredRequests.size(); }
+    size_t NumStoredRequests() const { std::lock_guard<std::mutex> Lock(StoredRequestsMutex_); return StoredRequests.size(); }
     std::string StoredRequestsToString() const;
     std::string StoredRequestsToNESRequestArray() const;
     std::string StoredRequestsSave() const;
-    void ClearStoredRequests() { StoredRequests.clear(); }
+    void ClearStoredRequests() { std::lock_guard<std::mutex> Lock(StoredRequestsMutex_); StoredRequests.clear(); RunRequestID_ = -1; }
+
+    //! Marks the last stored request as the RunFor request of run _RunID.
+    //! If that run is aborted, the request is rewritten with the time that
+    //! was actually run (or removed if nothing ran), so that replaying the
+    //! stored requests reaches the same state.
+    void SetRunRequest(int _RunID);
 };
 
 }; // namespace Simulator
@@ -0,0 +1,305 @@
+#include <Simulator/Structs/SimulationSweep.h>
+
+#include <algorithm>
+#include <chrono>
+#include <map>
+
+#include <Simulator/BallAndStick/BSNeuron.h>
+#include <Simulator/LIFCompartmental/LIFCNeuron.h>
+#include <Simulator/Structs/CalciumImaging.h>
+#include <Simulator/Structs/Checkpoint.h>
+#include <Simulator/Structs/RecordingElectrode.h>
+#include <Simulator/Updaters/NeuronUpdatePool.h>
+
+
+namespace BG {
+namespace NES {
+namespace Simulator {
+
+nlohmann::json SweepSummary::GetJSON() const {
+    nlohmann::json SummaryJSON;
+    SummaryJSON["Ok"] = Ok;
+    if (!Ok) {
+        SummaryJSON["Error"] = Error;
+        return SummaryJSON;
+    }
+    SummaryJSON["T_ms"] = T_ms;
+    SummaryJSON["TotalSpikes"] = TotalSpikes;
+    SummaryJSON["SpikeCounts"] = SpikeCounts;
+    SummaryJSON["Wallclock_ms"] = Wallclock_ms;
+    if (!SpikeTimes.is_null()) {
+        SummaryJSON["SpikeTimes"] = SpikeTimes;
+    }
+    if (!Recording.is_null()) {
+        SummaryJSON["Recording"] = Recording;
+    }
+    return SummaryJSON;
+}
+
+
+bool SimulationSweep::Prepare(Simulation& _Source, std::string& _Error) {
+    if (!_Source.RecordingElectrodes.empty() || !_Source.PatchClampADCs.empty()) {
+        _Error = "Simulations with recording electrodes or patch clamp ADCs cannot be swept";
+        return false;
+    }
+    if (_Source.Neurons.empty()) {
+        _Error = "Simulation has no neurons";
+        return false;
+    }
+
+    if (!_Source.SaveModel(ModelImage_)) {
+        _Error = "Unable to make the model image";
+        return false;
+    }
+
+    Tools::CheckpointWriter Writer;
+    _Source.SaveState(Writer);
+    BaselineState_ = Writer.GetBuffer();
+
+    SourceID_ = _Source.ID;
+    SourceName_ = _Source.Name;
+    SimNeuronClass_ = _Source.SimNeuronClass;
+    UseAbstractedLIFReceptors_ = _Source.use_abstracted_LIF_receptors;
+    return true;
+}
+
+/**
+ * Hands out an idle worker or builds a new one from the model image. At
+ * most one worker per pool thread is ever built, since every thread returns
+ * its worker before it takes the next replica.
+ */
+std::unique_ptr<Simulation> SimulationSweep::TakeWorker(std::string& _Error) {
+    {
+        std::lock_guard<std::mutex> Lock(WorkersMutex_);
+        if (!IdleWorkers_.empty()) {
+            std::unique_ptr<Simulation> Worker = std::move(IdleWorkers_.back());
+            IdleWorkers_.pop_back();
+            return Worker;
+        }
+    }
+
+    // Built without holding the lock, so that workers load in parallel.
+    std::unique_ptr<Simulation> Worker = std::make_unique<Simulation>(Logger_);
+    Worker->ID = SourceID_;
+    Worker->Name = SourceName_ + " (sweep worker)";
+    Worker->use_abstracted_LIF_receptors = UseAbstractedLIFReceptors_;
+    Worker->NumUpdateThreads = 1; // Replicas are already spread over the threads.
+    std::vector<uint8_t> Image = ModelImage_;
+    if (!Worker->LoadModel(std::move(Image)) || (Worker->SimNeuronClass != SimNeuronClass_)) {
+        _Error = "Unable to load the model image";
+        return nullptr;
+    }
+    NumWorkers_++;
+    return Worker;
+}
+
+void SimulationSweep::ReturnWorker(std::unique_ptr<Simulation> _Worker) {
+    std::lock_guard<std::mutex> Lock(WorkersMutex_);
+    IdleWorkers_.push_back(std::move(_Worker));
+}
+
+static bool ValidNeuronIDs(const std::vector<int>& _NeuronIDs, size_t _NumNeurons) {
+    return std::all_of(_NeuronIDs.begin(), _NeuronIDs.end(), [_NumNeurons](int _ID) { return (_ID >= 0) && (size_t(_ID) < _NumNeurons); });
+}
+
+bool SimulationSweep::CheckReplica(const SweepReplica& _Replica, size_t _NumNeurons, std::string& _Error) const {
+    for (auto & [t_ms, NeuronID] : _Replica.SpikeTimes) {
+        if ((NeuronID < 0) || (size_t(NeuronID) >= _NumNeurons) || !(t_ms >= 0.0)) {
+            _Error = "Invalid spike time or neuron ID";
+            return false;
+        }
+    }
+    if ((_Replica.SpontaneousMean_ms != -1.0) &&
+        ((!(_Replica.SpontaneousMean_ms > 0.0)) || (!(_Replica.SpontaneousStDev_ms >= 0.0)) || !ValidNeuronIDs(_Replica.SpontaneousNeuronIDs, _NumNeurons))) {
+        _Error = "Invalid spontaneous activity";
+        return false;
+    }
+    for (auto & Strength : _Replica.Strengths) {
+        bool All = (Strength.PresynapticID == -1) && (Strength.PostsynapticID == -1);
+        if ((!All) && !ValidNeuronIDs({ Strength.PresynapticID, Strength.PostsynapticID }, _NumNeurons)) {
+            _Error = "Invalid connection strength neuron IDs";
+            return false;
+        }
+    }
+    if (!_Replica.NeuronEdits.empty() && (SimNeuronClass_ != LIFCNEURONS)) {
+        _Error = "Neuron parameter overrides need LIFC neurons";
+        return false;
+    }
+    for (auto & NeuronEdit : _Replica.NeuronEdits) {
+        if (!ValidNeuronIDs(NeuronEdit.NeuronIDs, _NumNeurons)) {
+            _Error = "Invalid neuron ID in neuron parameter override";
+            return false;
+        }
+    }
+    return true;
+}
+
+static void MergeEdit(CoreStructs::LIFCEdit& _Into, const CoreStructs::LIFCEdit& _Edit) {
+    _Into.RestingPotential_mV |= _Edit.RestingPotential_mV;
+    _Into.ResetPotential_mV |= _Edit.ResetPotential_mV;
+    _Into.SpikeThreshold_mV |= _Edit.SpikeThreshold_mV;
+    _Into.MembraneResistance_MOhm |= _Edit.MembraneResistance_MOhm;
+    _Into.MembraneCapacitance_pF |= _Edit.MembraneCapacitance_pF;
+    _Into.RefractoryPeriod_ms |= _Edit.RefractoryPeriod_ms;
+    _Into.SpikeDepolarization_mV |= _Edit.SpikeDepolarization_mV;
+}
+
+/**
+ * Runs one replica on _Worker and leaves the worker's parameters as they
+ * were. Dynamic state, including LIFC connection weights, spike schedules
+ * and random generators, is rewound by the next replica's LoadState().
+ * SC connection strengths and LIFC neuron parameters belong to the model,
+ * so the values they had are kept here and written back after the run.
+ */
+SweepSummary SimulationSweep::RunReplica(Simulation& _Worker, const SweepReplica& _Replica, const SweepOptions& _Options) {
+    SweepSummary Summary;
+    if (!CheckReplica(_Replica, _Worker.Neurons.size(), Summary.Error)) {
+        return Summary;
+    }
+
+    Tools::CheckpointReader Reader(BaselineState_);
+    if ((!_Worker.LoadState(Reader)) || (!Reader.AtEnd())) {
+        Summary.Error = "Unable to restore the prepared state";
+        return Summary;
+    }
+
+    // Reseeding restarts the spontaneous activity streams of all neurons.
+    if (_Replica.RandomSeed != -1) {
+        _Worker.SetRandomSeed(_Replica.RandomSeed);
+        for (auto & neuron_ptr : _Worker.Neurons) {
+            if (neuron_ptr->Class_ < CoreStructs::_BSNeuron) continue;
+            auto* BSNeuronPtr = static_cast<BallAndStick::BSNeuron*>(neuron_ptr.get());
+            if (BSNeuronPtr->DtSpontDist) {
+                BSNeuronPtr->SetSpontaneousActivity(BSNeuronPtr->TauSpont_ms.mean, BSNeuronPtr->TauSpont_ms.stdev, _Worker.MasterRandom_->UniformRandomInt());
+            }
+        }
+    }
+
+    if (_Replica.SpontaneousMean_ms != -1.0) {
+        if (!_Worker.MasterRandom_) {
+            _Worker.SetRandomSeed(_Worker.RandomSeed);
+        }
+        if (_Replica.SpontaneousNeuronIDs.empty()) {
+            for (auto & neuron_ptr : _Worker.Neurons) {
+                neuron_ptr->SetSpontaneousActivity(_Replica.SpontaneousMean_ms, _Replica.SpontaneousStDev_ms, _Worker.MasterRandom_->UniformRandomInt());
+            }
+        } else {
+            for (int NeuronID : _Replica.SpontaneousNeuronIDs) {
+                _Worker.Neurons[NeuronID]->SetSpontaneousActivity(_Replica.SpontaneousMean_ms, _Replica.SpontaneousStDev_ms, _Worker.MasterRandom_->UniformRandomInt());
+            }
+        }
+    }
+
+    // Stimuli already delivered stay in front, the rest is kept in order.
+    for (auto & [t_ms, NeuronID] : _Replica.SpikeTimes) {
+        _Worker.Neurons[NeuronID]->AddSpecificAPTime(t_ms);
+    }
+    if (!_Replica.SpikeTimes.empty()) {
+        for (auto & neuron_ptr : _Worker.Neurons) {
+            std::vector<float> & TDirectStim_ms = neuron_ptr->TDirectStim_ms;
+            std::sort(TDirectStim_ms.begin() + std::min(neuron_ptr->next_directstim_idx, TDirectStim_ms.size()), TDirectStim_ms.end());
+        }
+    }
+
+    std::vector<float> SCConductances_nS;
+    if (!_Replica.Strengths.empty() && (_Worker.SimNeuronClass != LIFCNEURONS)) {
+        for (auto & Receptor : _Worker.Receptors) {
+            SCConductances_nS.push_back(Receptor->Conductance_nS);
+        }
+    }
+    for (auto & Strength : _Replica.Strengths) {
+        if ((Strength.PresynapticID == -1) && (Strength.PostsynapticID == -1)) {
+            _Worker.UpdateAllStrength(Strength.Conductance_nS);
+        } else {
+            _Worker.UpdatePrePostStrength(Strength.PresynapticID, Strength.PostsynapticID, Strength.Conductance_nS);
+        }
+    }
+
+    std::map<int, std::tuple<CoreStructs::LIFCNeuronStruct, CoreStructs::LIFCEdit>> EditedNeurons;
+    for (auto & NeuronEdit : _Replica.NeuronEdits) {
+        std::vector<int> NeuronIDs = NeuronEdit.NeuronIDs;
+        if (NeuronIDs.empty()) {
+            for (size_t i = 0; i < _Worker.Neurons.size(); i++) NeuronIDs.push_back(int(i));
+        }
+        for (int NeuronID : NeuronIDs) {
+            auto* LIFCNeuronPtr = static_cast<LIFCNeuron*>(_Worker.Neurons[NeuronID].get());
+            auto Edited = EditedNeurons.emplace(NeuronID, std::make_tuple(LIFCNeuronPtr->build_data, CoreStructs::LIFCEdit())).first;
+            MergeEdit(std::get<1>(Edited->second), NeuronEdit.Edit);
+            LIFCNeuronPtr->Edit(NeuronEdit.Values, NeuronEdit.Edit);
+        }
+    }
+
+    std::vector<unsigned long> StartSpikeCounts;
+    for (auto & neuron_ptr : _Worker.Neurons) {
+        StartSpikeCounts.push_back(neuron_ptr->NumSpikes());
+    }
+    float StartT_ms = _Worker.T_ms;
+    size_t RecordingCursor = _Worker.NumTRecordedDropped + _Worker.TRecorded_ms.size();
+
+    auto StartedAt = std::chrono::steady_clock::now();
+    _Worker.RunFor(_Options.Runtime_ms);
+    Summary.Wallclock_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - StartedAt).count();
+
+    Summary.Ok = true;
+    Summary.T_ms = _Worker.T_ms;
+    for (size_t i = 0; i < _Worker.Neurons.size(); i++) {
+        Summary.SpikeCounts.push_back(_Worker.Neurons[i]->NumSpikes() - StartSpikeCounts[i]);
+        Summary.TotalSpikes += Summary.SpikeCounts.back();
+    }
+    if (_Options.IncludeSpikeTimes) {
+        // A cursor of 0 returns all spikes, which is right for a state at 0 ms.
+        Summary.SpikeTimes = _Worker.GetSpikeTimesJSON(StartT_ms);
+    }
+    if (_Options.IncludeRecording) {
+        Summary.Recording = _Worker.GetRecordingJSON(RecordingCursor);
+    }
+
+    // Write the shared parameters back.
+    for (auto & [NeuronID, Original] : EditedNeurons) {
+        static_cast<LIFCNeuron*>(_Worker.Neurons[NeuronID].get())->Edit(std::get<0>(Original), std::get<1>(Original));
+    }
+    for (size_t i = 0; i < SCConductances_nS.size(); i++) {
+        _Worker.Receptors[i]->Conductance_nS = SCConductances_nS[i];
+    }
+
+    return Summary;
+}
+
+std::vector<SweepSummary> SimulationSweep::Run(const std::vector<SweepReplica>& _Replicas, const SweepOptions& _Options, const std::atomic<bool>* _Cancel) {
+    std::vector<SweepSummary> Summaries(_Replicas.size());
+    if (_Replicas.empty()) {
+        return Summaries;
+    }
+    if (BaselineState_.empty()) {
+        for (auto & Summary : Summaries) Summary.Error = "Sweep was not prepared";
+        return Summaries;
+    }
+
+    int NumThreads = (_Options.NumThreads > 0) ? _Options.NumThreads : int(std::max(1u, std::thread::hardware_concurrency()));
+    NumThreads = int(std::min<size_t>(NumThreads, _Replicas.size()));
+    Logger_->Log("Sweeping " + std::to_string(_Replicas.size()) + " replicas of simulation " + std::to_string(SourceID_) + " on " + std::to_string(NumThreads) + " threads", 3);
+
+    Updater::NeuronUpdatePool Pool(NumThreads);
+    Pool.ParallelFor(_Replicas.size(), 1, [&](size_t _Start, size_t _End) {
+        for (size_t i = _Start; i < _End; i++) {
+            if (_Cancel && *_Cancel) {
+                Summaries[i].Error = "Cancelled";
+                continue;
+            }
+            std::unique_ptr<Simulation> Worker = TakeWorker(Summaries[i].Error);
+            if (!Worker) {
+                continue;
+            }
+            Summaries[i] = RunReplica(*Worker, _Replicas[i], _Options);
+            ReturnWorker(std::move(Worker));
+            NumDone_++;
+        }
+    });
+
+    Logger_->Log("Swept " + std::to_string(NumDone_) + " replicas of simulation " + std::to_string(SourceID_) + " with " + std::to_string(NumWorkers_) + " workers", 3);
+    return Summaries;
+}
+
+}; // namespace Simulator
+}; // namespace NES
+}; // namespace BG
@@ -0,0 +1,158 @@
+//=================================================================//
+// This file is part of the BrainGenix-NES Neuron Emulation System //
+//=================================================================//
+
+/*
+    Description: This file provides batch parameter sweeps over replicas of one simulation model.
+    Additional Notes: None
+    Date Created: 2026-10-17
+*/
+
+#pragma once
+
+// Standard Libraries (BG convention: use <> instead of "")
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <vector>
+
+// Third-Party Libraries (BG convention: use <> instead of "")
+#include <nlohmann/json.hpp>
+
+// Internal Libraries (BG convention: use <> instead of "")
+#include <Simulator/Structs/Neuron.h>
+#include <Simulator/Structs/Simulation.h>
+#include <BG/Common/Logger/Logger.h>
+
+
+namespace BG {
+namespace NES {
+namespace Simulator {
+
+//! Connection strength override, see Simulation::UpdatePrePostStrength().
+//! PresynapticID and PostsynapticID -1 set all connections, see
+//! Simulation::UpdateAllStrength().
+struct SweepStrength {
+    int PresynapticID = -1;
+    int PostsynapticID = -1;
+    float Conductance_nS = 0.0;
+};
+
+//! LIFC neuron parameter override, see Simulation::EditLIFCNeuron(). An
+//! empty NeuronIDs list edits all neurons.
+struct SweepNeuronEdit {
+    std::vector<int> NeuronIDs;
+    CoreStructs::LIFCNeuronStruct Values;
+    CoreStructs::LIFCEdit Edit;
+};
+
+/**
+ * @brief Overrides of one replica of a sweep. Everything not overridden is
+ * as in the model and state the sweep was prepared from.
+ */
+struct SweepReplica {
+    int RandomSeed = -1; /**Reseeds the master random generator and spontaneous activity, -1 keeps them*/
+
+    std::vector<std::tuple<float, int>> SpikeTimes; /**Additional (t_ms, neuron ID) action potentials*/
+
+    float SpontaneousMean_ms = -1.0; /**Spontaneous activity of SpontaneousNeuronIDs (all if empty), -1 keeps it*/
+    float SpontaneousStDev_ms = 0.0;
+    std::vector<int> SpontaneousNeuronIDs;
+
+    std::vector<SweepStrength> Strengths;
+    std::vector<SweepNeuronEdit> NeuronEdits;
+};
+
+struct SweepOptions {
+    float Runtime_ms = 0.0;        /**Simulated time of every replica*/
+    int NumThreads = 0;            /**Replicas run at the same time, 0 means all hardware threads*/
+    bool IncludeSpikeTimes = false;
+    bool IncludeRecording = false; /**God's eye recording of the replica, if the state records*/
+};
+
+/**
+ * @brief Result of one replica. Spike counts, spike times and recordings
+ * only cover the run of the replica, not the history of the state it was
+ * started from.
+ */
+struct SweepSummary {
+    bool Ok = false;
+    std::string Error;
+
+    float T_ms = 0.0;
+    unsigned long TotalSpikes = 0;
+    std::vector<unsigned long> SpikeCounts; /**Index is the neuron ID*/
+    nlohmann::json SpikeTimes;
+    nlohmann::json Recording;
+    double Wallclock_ms = 0.0;
+
+    nlohmann::json GetJSON() const;
+};
+
+/**
+ * @brief Runs many replicas of one simulation that differ only in seeds,
+ * stimuli and a few parameters.
+ *
+ * Prepare() takes a finalized simulation and keeps an immutable image of
+ * it: its model as an in-memory model image (ModelFile.h) and its dynamic
+ * state as a checkpoint buffer (Simulation::SaveState()). The source can be
+ * used again as soon as Prepare() returns.
+ *
+ * Replicas do not build their own model. Every thread of the pool loads the
+ * image into one worker simulation and runs replica after replica on it:
+ * the worker is rewound to the prepared state, the replica's overrides are
+ * written over the shared parameters, and after the run the overridden
+ * parameters are restored. Geometry, topology and parameters are thus
+ * built once per thread instead of once per replica, and a replica only
+ * pays for the parameters it changes.
+ *
+ * Simulations with recording electrodes or patch clamp ADCs cannot be
+ * swept, their instruments are not part of the model image.
+ */
+class SimulationSweep {
+
+private:
+
+    BG::Common::Logger::LoggingSystem* Logger_ = nullptr;
+
+    std::vector<uint8_t> ModelImage_; /**Model image, see Simulation::SaveModel()*/
+    std::string BaselineState_; /**Checkpoint buffer every replica starts from*/
+    int SourceID_ = -1;
+    std::string SourceName_;
+    SimulationNeuronClass SimNeuronClass_ = UNDETERMINED;
+    bool UseAbstractedLIFReceptors_ = true;
+
+    std::mutex WorkersMutex_; /**Guards IdleWorkers_*/
+    std::vector<std::unique_ptr<Simulation>> IdleWorkers_;
+    std::atomic<size_t> NumWorkers_{0};
+    std::atomic<size_t> NumDone_{0};
+
+    std::unique_ptr<Simulation> TakeWorker(std::string& _Error);
+    void ReturnWorker(std::unique_ptr<Simulation> _Worker);
+
+    bool CheckReplica(const SweepReplica& _Replica, size_t _NumNeurons, std::string& _Error) const;
+    SweepSummary RunReplica(Simulation& _Worker, const SweepReplica& _Replica, const SweepOptions& _Options);
+
+public:
+
+    SimulationSweep(BG::Common::Logger::LoggingSystem* _Logger): Logger_(_Logger) {}
+
+    //! Keeps the image of _Source. Its engine must not be running, e.g.
+    //! hold Simulation::ClaimForTask() until Prepare() returns.
+    bool Prepare(Simulation& _Source, std::string& _Error);
+
+    //! Runs the replicas on a pool of _Options.NumThreads threads and
+    //! returns their summaries in the same order. Replicas not started
+    //! when _Cancel is set are reported with the error "Cancelled".
+    std::vector<SweepSummary> Run(const std::vector<SweepReplica>& _Replicas, const SweepOptions& _Options, const std::atomic<bool>* _Cancel = nullptr);
+
+    size_t GetNumDone() const { return NumDone_; }
+    size_t GetNumWorkers() const { return NumWorkers_; }
+
+};
+
+}; // namespace Simulator
+}; // namespace NES
+}; // namespace BG
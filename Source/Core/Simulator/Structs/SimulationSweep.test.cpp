@@ -0,0 +1,206 @@
+//=================================================================//
+// This file is part of the BrainGenix-NES Neuron Emulation System //
+//=================================================================//
+
+/*
+    Description: This file provides unit tests for batch parameter sweeps.
+    Additional Notes: None
+    Date Created: 2026-10-17
+*/
+
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <BG/Common/Logger/Logger.h>
+#include <Simulator/Geometries/Sphere.h>
+#include <Simulator/Structs/Simulation.h>
+#include <Simulator/Structs/SimulationSweep.h>
+#include <Simulator/Structs/RecordingElectrode.h>
+#include <Simulator/Structs/CalciumImaging.h>
+
+
+/**
+ * @brief Test class for sweeps. Builds a small LIFC ring of spontaneously
+ * active neurons, so that seeds, stimuli and parameters all change the
+ * spikes of a replica.
+ */
+
+struct SimulationSweepTest : testing::Test {
+    BG::Common::Logger::LoggingSystem Logger;
+
+    static constexpr int NumNeurons = 6;
+    static constexpr float T_ms = 100.0;
+
+    std::unique_ptr<BG::NES::Simulator::Simulation> MakeNetwork() {
+        using namespace BG::NES::Simulator;
+
+        auto Sim = std::make_unique<Simulation>(&Logger);
+        Sim->ID = 0;
+        Sim->SetRandomSeed(42);
+        Sim->Dt_ms = 0.25;
+
+        std::vector<int> CompartmentIDs;
+        for (int i = 0; i < NumNeurons; i++) {
+            Geometries::Sphere S(Geometries::Vec3D(10.0*i, 0.0, 0.0), 2.0);
+            S.GeometryShape = Geometries::GeometrySphere;
+            int ShapeID = Sim->AddSphere(S);
+
+            Compartments::LIFC C;
+            C.ShapeID = ShapeID;
+            C.RestingPotential_mV = -60.0;
+            C.ResetPotential_mV = -55.0;
+            C.SpikeThreshold_mV = -50.0;
+            C.MembraneResistance_MOhm = 100.0;
+            C.MembraneCapacitance_pF = 100.0;
+            C.AfterHyperpolarizationAmplitude_mV = 0.0;
+            CompartmentIDs.push_back(Sim->AddLIFCCompartment(C));
+
+            CoreStructs::LIFCNeuronStruct N;
+            N.RestingPotential_mV = -60.0;
+            N.ResetPotential_mV = -55.0;
+            N.SpikeThreshold_mV = -50.0;
+            N.MembraneResistance_MOhm = 100.0;
+            N.MembraneCapacitance_pF = 100.0;
+            N.RefractoryPeriod_ms = 2.0;
+            N.SpikeDepolarization_mV = 30.0;
+            N.UpdateMethod = CoreStructs::EXPEULER_CM;
+            N.ResetMethod = CoreStructs::TOVM;
+            N.AfterHyperpolarizationReversalPotential_mV = -90.0;
+            N.FastAfterHyperpolarizationRise_ms = 2.5;
+            N.FastAfterHyperpolarizationDecay_ms = 30.0;
+            N.FastAfterHyperpolarizationPeakConductance_nS = 3.0;
+            N.FastAfterHyperpolarizationMaxPeakConductance_nS = 10.0;
+            N.FastAfterHyperpolarizationHalfActConstant = 0.5;
+            N.SlowAfterHyperpolarizationRise_ms = 30.0;
+            N.SlowAfterHyperpolarizationDecay_ms = 300.0;
+            N.SlowAfterHyperpolarizationPeakConductance_nS = 1.0;
+            N.SlowAfterHyperpolarizationMaxPeakConductance_nS = 5.0;
+            N.SlowAfterHyperpolarizationHalfActConstant = 0.5;
+            N.AfterHyperpolarizationSaturationModel = CoreStructs::AHPCLIP;
+            N.FatigueThreshold = 300.0;
+            N.FatigueRecoveryTime_ms = 1000.0;
+            N.AfterDepolarizationReversalPotential_mV = -20.0;
+            N.AfterDepolarizationRise_ms = 20.0;
+            N.AfterDepolarizationDecay_ms = 200.0;
+            N.AfterDepolarizationPeakConductance_nS = 0.3;
+            N.AfterDepolarizationSaturationMultiplier = 2.0;
+            N.AfterDepolarizationRecoveryTime_ms = 300.0;
+            N.AfterDepolarizationDepletion = 0.3;
+            N.AfterDepolarizationSaturationModel = CoreStructs::ADPCLIP;
+            N.AdaptiveThresholdDiffPerSpike = 0.2;
+            N.AdaptiveTresholdRecoveryTime_ms = 50.0;
+            N.AdaptiveThresholdDiffPotential_mV = 10.0;
+            N.AdaptiveThresholdFloor_mV = -50.0;
+            N.AdaptiveThresholdFloorDeltaPerSpike_mV = 1.0;
+            N.AdaptiveThresholdFloorRecoveryTime_ms = 500.0;
+            N.SomaCompartmentIDs.push_back(CompartmentIDs.back());
+            Sim->AddLIFCNeuron(N);
+        }
+
+        for (int i = 0; i < NumNeurons; i++) {
+            Connections::LIFCReceptor R;
+            R.SourceCompartmentID = CompartmentIDs[i];
+            R.DestinationCompartmentID = CompartmentIDs[(i+1) % NumNeurons];
+            R.ReversalPotential_mV = 0.0;
+            R.PSPRise_ms = 0.5;
+            R.PSPDecay_ms = 3.0;
+            R.PeakConductance_nS = 40.0;
+            R.Weight = 1.0;
+            R.OnsetDelay_ms = 1.5;
+            R.Neurotransmitter = Connections::AMPA;
+            Sim->AddLIFCReceptor(R);
+        }
+
+        for (auto & Neuron : Sim->Neurons) {
+            Neuron->SetSpontaneousActivity(20.0, 10.0, Sim->MasterRandom_->UniformRandomInt());
+        }
+
+        return Sim;
+    }
+
+    void TearDown() { return; }
+};
+
+TEST_F(SimulationSweepTest, test_Replicas_continue_like_the_source) {
+    using namespace BG::NES::Simulator;
+
+    auto Source = MakeNetwork();
+    Source->RunFor(T_ms);
+
+    SimulationSweep Sweep(&Logger);
+    std::string Error;
+    ASSERT_TRUE(Sweep.Prepare(*Source, Error)) << Error;
+
+    SweepOptions Options;
+    Options.Runtime_ms = T_ms;
+    Options.NumThreads = 3;
+    Options.IncludeSpikeTimes = true;
+    std::vector<SweepSummary> Summaries = Sweep.Run(std::vector<SweepReplica>(8), Options);
+
+    // The source is untouched by the sweep and continues the same way.
+    std::vector<unsigned long> SpikesBefore;
+    for (auto & Neuron : Source->Neurons) SpikesBefore.push_back(Neuron->NumSpikes());
+    Source->RunFor(T_ms);
+
+    ASSERT_EQ(Summaries.size(), 8);
+    ASSERT_LE(Sweep.GetNumWorkers(), 3);
+    ASSERT_EQ(Sweep.GetNumDone(), 8);
+    for (auto & Summary : Summaries) {
+        ASSERT_TRUE(Summary.Ok) << Summary.Error;
+        ASSERT_EQ(Summary.T_ms, Source->T_ms);
+        ASSERT_GT(Summary.TotalSpikes, 0);
+        for (int i = 0; i < NumNeurons; i++) {
+            ASSERT_EQ(Summary.SpikeCounts[i], Source->Neurons[i]->NumSpikes() - SpikesBefore[i]) << "neuron " << i;
+            ASSERT_EQ(Summary.SpikeTimes[std::to_string(i)]["tSpike_ms"].size(), Summary.SpikeCounts[i]);
+        }
+    }
+}
+
+TEST_F(SimulationSweepTest, test_Overrides_stay_in_their_replica) {
+    using namespace BG::NES::Simulator;
+
+    auto Source = MakeNetwork();
+    SimulationSweep Sweep(&Logger);
+    std::string Error;
+    ASSERT_TRUE(Sweep.Prepare(*Source, Error)) << Error;
+
+    std::vector<SweepReplica> Replicas(7);
+    Replicas[1].RandomSeed = 7;
+    Replicas[2].RandomSeed = 7;
+    // No spontaneous activity, one forced spike that travels around the ring,
+    // unless the thresholds are raised far above the spike depolarization.
+    for (int r : { 3, 4 }) {
+        Replicas[r].SpontaneousMean_ms = 20.0;
+        Replicas[r].SpontaneousStDev_ms = 0.0;
+        Replicas[r].SpikeTimes.emplace_back(10.0, 2);
+    }
+    SweepNeuronEdit Silence;
+    Silence.Values.SpikeThreshold_mV = 1000.0;
+    Silence.Edit.SpikeThreshold_mV = true;
+    Replicas[3].NeuronEdits.push_back(Silence);
+    Replicas[5].SpikeTimes.emplace_back(5.0, NumNeurons);
+
+    SweepOptions Options;
+    Options.Runtime_ms = T_ms;
+    Options.NumThreads = 1; // A single worker runs every replica after the previous one.
+    std::vector<SweepSummary> Summaries = Sweep.Run(Replicas, Options);
+    ASSERT_EQ(Sweep.GetNumWorkers(), 1);
+
+    for (int r : { 0, 1, 2, 3, 4, 6 }) {
+        ASSERT_TRUE(Summaries[r].Ok) << "replica " << r << ": " << Summaries[r].Error;
+    }
+    ASSERT_FALSE(Summaries[5].Ok);
+
+    // Same seed, same spikes, another seed, other spikes.
+    ASSERT_EQ(Summaries[1].SpikeCounts, Summaries[2].SpikeCounts);
+    ASSERT_NE(Summaries[0].SpikeCounts, Summaries[1].SpikeCounts);
+
+    ASSERT_EQ(Summaries[3].TotalSpikes, 1);
+    ASSERT_EQ(Summaries[3].SpikeCounts[2], 1);
+    ASSERT_GT(Summaries[4].TotalSpikes, NumNeurons);
+
+    // The last replica runs after all overrides and matches the first.
+    ASSERT_EQ(Summaries[0].SpikeCounts, Summaries[6].SpikeCounts);
+}
@@ -0,0 +1,93 @@
+#include <Simulator/Structs/SpikeRaster.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace BG {
+namespace NES {
+namespace Simulator {
+namespace Tools {
+
+void AppendVarint(uint64_t _Value, std::string& _Out) {
+    while (_Value >= 0x80) {
+        _Out.push_back(char((_Value & 0x7F) | 0x80));
+        _Value >>= 7;
+    }
+    _Out.push_back(char(_Value));
+}
+
+bool ReadVarint(const std::string& _In, size_t& _Pos, uint64_t& _Value) {
+    _Value = 0;
+    for (unsigned Shift = 0; (_Pos < _In.size()) && (Shift < 64); Shift += 7) {
+        uint8_t Byte = uint8_t(_In[_Pos++]);
+        _Value |= uint64_t(Byte & 0x7F) << Shift;
+        if ((Byte & 0x80) == 0) return true;
+    }
+    return false;
+}
+
+SpikeRasterEncoder::SpikeRasterEncoder(float _TStart_ms, float _TEnd_ms, float _Resolution_ms) {
+    Header_.TStart_ms = _TStart_ms;
+    Header_.TEnd_ms = std::max(_TStart_ms, _TEnd_ms);
+    Header_.Resolution_ms = _Resolution_ms;
+}
+
+void SpikeRasterEncoder::AddNeuron(int _ID, const std::vector<float>& _TAct_ms) {
+    auto First = std::lower_bound(_TAct_ms.begin(), _TAct_ms.end(), Header_.TStart_ms);
+    auto Last = std::lower_bound(First, _TAct_ms.end(), Header_.TEnd_ms);
+    if (First == Last) return;
+
+    AppendVarint(uint64_t(_ID - LastID_), Body_);
+    AppendVarint(uint64_t(Last - First), Body_);
+    // Rounding keeps ticks ascending, so the deltas are never negative.
+    int64_t PrevTick = 0;
+    for (auto it = First; it != Last; ++it) {
+        int64_t Tick = std::llround((*it - Header_.TStart_ms) / Header_.Resolution_ms);
+        AppendVarint(uint64_t(Tick - PrevTick), Body_);
+        PrevTick = Tick;
+    }
+
+    LastID_ = _ID;
+    Header_.NumNeurons++;
+    Header_.NumSpikes += Last - First;
+}
+
+std::string SpikeRasterEncoder::Finish() const {
+    std::string Data(sizeof(Header_), '\0');
+    std::memcpy(Data.data(), &Header_, sizeof(Header_));
+    return Data + Body_;
+}
+
+bool DecodeSpikeRaster(const std::string& _Data, SpikeRaster& _Raster) {
+    if (_Data.size() < sizeof(SpikeRasterHeader)) return false;
+    std::memcpy(&_Raster.Header, _Data.data(), sizeof(SpikeRasterHeader));
+    if ((std::memcmp(_Raster.Header.Magic, "NSRS", 4) != 0) || (_Raster.Header.Version != 1)) return false;
+
+    _Raster.NeuronIDs.clear();
+    _Raster.Offsets.assign(1, 0);
+    _Raster.Times_ms.clear();
+
+    size_t Pos = sizeof(SpikeRasterHeader);
+    int64_t ID = 0;
+    for (uint32_t i = 0; i < _Raster.Header.NumNeurons; i++) {
+        uint64_t DeltaID, NumSpikes;
+        if ((!ReadVarint(_Data, Pos, DeltaID)) || (!ReadVarint(_Data, Pos, NumSpikes))) return false;
+        ID += DeltaID;
+        _Raster.NeuronIDs.emplace_back(int(ID));
+        int64_t Tick = 0;
+        for (uint64_t s = 0; s < NumSpikes; s++) {
+            uint64_t DeltaTick;
+            if (!ReadVarint(_Data, Pos, DeltaTick)) return false;
+            Tick += DeltaTick;
+            _Raster.Times_ms.emplace_back(_Raster.Header.TStart_ms + Tick * _Raster.Header.Resolution_ms);
+        }
+        _Raster.Offsets.emplace_back(_Raster.Times_ms.size());
+    }
+    return Pos == _Data.size();
+}
+
+}; // namespace Tools
+}; // namespace Simulator
+}; // namespace NES
+}; // namespace BG
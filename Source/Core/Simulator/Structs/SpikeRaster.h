@@ -0,0 +1,118 @@
+//=================================================================//
+// This file is part of the BrainGenix-NES Neuron Emulation System //
+//=================================================================//
+
+/*
+    Description: This file provides the compact binary spike raster used to export spike times.
+    Additional Notes: None
+    Date Created: 2026-10-17
+*/
+
+#pragma once
+
+// Standard Libraries (BG convention: use <> instead of "")
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Third-Party Libraries (BG convention: use <> instead of "")
+
+// Internal Libraries (BG convention: use <> instead of "")
+
+
+namespace BG {
+namespace NES {
+namespace Simulator {
+namespace Tools {
+
+/**
+ * @brief Appends an unsigned LEB128 varint to _Out.
+ */
+void AppendVarint(uint64_t _Value, std::string& _Out);
+
+/**
+ * @brief Reads an unsigned LEB128 varint at _Pos and advances _Pos.
+ *
+ * @return false if the data ends before the varint does.
+ */
+bool ReadVarint(const std::string& _In, size_t& _Pos, uint64_t& _Value);
+
+/**
+ * @brief Fixed size header of a spike raster (little-endian, no padding).
+ *
+ * The header is followed by a varint stream with one record per listed
+ * neuron, in ascending ID order:
+ *  - ID minus the previous listed ID (the first relative to 0),
+ *  - number of spikes,
+ *  - spike times in ticks of Resolution_ms, each relative to the previous
+ *    spike of the neuron (the first relative to TStart_ms).
+ * Neurons without spikes in the window are not listed.
+ */
+struct SpikeRasterHeader {
+    char Magic[4] = {'N', 'S', 'R', 'S'};
+    uint32_t Version = 1;
+    float TStart_ms = 0.0;      /**Spikes at or after this time are included*/
+    float TEnd_ms = 0.0;        /**Spikes before this time are included, use as the next cursor*/
+    float Resolution_ms = 0.0;  /**Size of a time tick*/
+    uint32_t NumNeurons = 0;    /**Number of listed neurons*/
+    uint64_t NumSpikes = 0;
+};
+
+/**
+ * @brief Decoded spike raster in per-neuron offset form.
+ */
+struct SpikeRaster {
+    SpikeRasterHeader Header;
+    std::vector<int> NeuronIDs;
+    std::vector<size_t> Offsets;  /**Spikes of NeuronIDs[i] are Times_ms[Offsets[i]] to Times_ms[Offsets[i+1]]*/
+    std::vector<float> Times_ms;
+};
+
+/**
+ * @brief Builds a spike raster of the time window [TStart_ms, TEnd_ms).
+ *
+ * Spike times are quantized to Resolution_ms, which should be at most the
+ * timestep (or finer, for precise spike times).
+ */
+class SpikeRasterEncoder {
+
+private:
+
+    SpikeRasterHeader Header_;
+    std::string Body_;
+    int LastID_ = 0;
+
+public:
+
+    SpikeRasterEncoder(float _TStart_ms, float _TEnd_ms, float _Resolution_ms);
+
+    /**
+     * @brief Adds the spikes of a neuron that fall inside the window. Must
+     * be called in ascending ID order.
+     *
+     * @param _ID
+     * @param _TAct_ms Spike times in ascending order, e.g. Neuron::TAct_ms.
+     */
+    void AddNeuron(int _ID, const std::vector<float>& _TAct_ms);
+
+    uint64_t GetNumSpikes() const { return Header_.NumSpikes; }
+
+    /**
+     * @brief Returns the header followed by the varint stream.
+     */
+    std::string Finish() const;
+
+};
+
+/**
+ * @brief Decodes a raster produced by SpikeRasterEncoder.
+ *
+ * @return false if the data is truncated or not a spike raster.
+ */
+bool DecodeSpikeRaster(const std::string& _Data, SpikeRaster& _Raster);
+
+}; // namespace Tools
+}; // namespace Simulator
+}; // namespace NES
+}; // namespace BG
@@ -0,0 +1,60 @@
+//=================================================================//
+// This file is part of the BrainGenix-NES Neuron Emulation System //
+//=================================================================//
+
+/*
+    Description: This file provides unit tests for the spike raster export.
+    Additional Notes: None
+    Date Created: 2026-10-17
+*/
+
+#include <Simulator/Structs/SpikeRaster.h>
+#include <gtest/gtest.h>
+
+#include <vector>
+
+namespace Tools = BG::NES::Simulator::Tools;
+
+TEST(SpikeRasterTest, test_Varint_roundtrip) {
+    std::vector<uint64_t> Values = { 0, 1, 127, 128, 300, 16383, 16384, uint64_t(1) << 40 };
+    std::string Data;
+    for (uint64_t Value : Values) Tools::AppendVarint(Value, Data);
+
+    size_t Pos = 0;
+    for (uint64_t Expected : Values) {
+        uint64_t Value;
+        ASSERT_TRUE(Tools::ReadVarint(Data, Pos, Value));
+        ASSERT_EQ(Value, Expected);
+    }
+    ASSERT_EQ(Pos, Data.size());
+    ASSERT_FALSE(Tools::ReadVarint(Data, Pos, Values[0]));
+}
+
+TEST(SpikeRasterTest, test_Raster_window_and_roundtrip) {
+    std::vector<float> Neuron0 = { 0.5, 2.0, 10.25, 20.0 };
+    std::vector<float> Neuron1 = { 30.0 };
+    std::vector<float> Neuron4 = { 1.0, 1.125, 19.999 };
+
+    Tools::SpikeRasterEncoder Encoder(1.0, 20.0, 0.001);
+    Encoder.AddNeuron(0, Neuron0);
+    Encoder.AddNeuron(1, Neuron1); // outside the window, not listed
+    Encoder.AddNeuron(4, Neuron4);
+    ASSERT_EQ(Encoder.GetNumSpikes(), 5);
+
+    Tools::SpikeRaster Raster;
+    ASSERT_TRUE(Tools::DecodeSpikeRaster(Encoder.Finish(), Raster));
+    ASSERT_EQ(Raster.Header.TEnd_ms, 20.0);
+    ASSERT_EQ(Raster.NeuronIDs, std::vector<int>({ 0, 4 }));
+    ASSERT_EQ(Raster.Offsets, std::vector<size_t>({ 0, 2, 5 }));
+
+    std::vector<float> Expected = { 2.0, 10.25, 1.0, 1.125, 19.999 };
+    ASSERT_EQ(Raster.Times_ms.size(), Expected.size());
+    for (size_t i = 0; i < Expected.size(); i++) {
+        ASSERT_NEAR(Raster.Times_ms[i], Expected[i], 0.0005);
+    }
+
+    // Truncated data must be rejected.
+    std::string Truncated = Encoder.Finish();
+    Truncated.pop_back();
+    ASSERT_FALSE(Tools::DecodeSpikeRaster(Truncated, Raster));
+}
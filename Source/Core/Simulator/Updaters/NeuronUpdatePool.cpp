@@ -0,0 +1,130 @@
+#include <Simulator/Updaters/NeuronUpdatePool.h>
+
+#include <algorithm>
+#include <string>
+
+#include <pthread.h>
+
+
+namespace BG {
+namespace NES {
+namespace Simulator {
+namespace Updater {
+
+
+
+NeuronUpdatePool::NeuronUpdatePool(int _NumThreads) {
+
+    if (_NumThreads < 1) {
+        _NumThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    // Reduced threading mode for debugging
+    #ifdef REDUCED_THREADING_DEBUG
+        _NumThreads = 1;
+    #endif
+
+    // The calling thread is the last worker.
+    for (int i = 0; i < _NumThreads - 1; i++) {
+        Threads_.push_back(std::thread(&NeuronUpdatePool::WorkerMainFunction, this, i));
+    }
+}
+
+NeuronUpdatePool::~NeuronUpdatePool() {
+    {
+        std::lock_guard<std::mutex> Lock(Mutex_);
+        StopThreads_ = true;
+    }
+    WorkReady_.notify_all();
+
+    for (auto& Thread : Threads_) {
+        Thread.join();
+    }
+}
+
+void NeuronUpdatePool::RunChunks() {
+    while (true) {
+        size_t Start = NextIndex_.fetch_add(ChunkSize_);
+        if (Start >= Count_) {
+            return;
+        }
+        (*Function_)(Start, std::min(Start + ChunkSize_, Count_));
+    }
+}
+
+void NeuronUpdatePool::WorkerMainFunction(int _ThreadNumber) {
+
+    // Set thread Name
+#ifdef __APPLE__
+    pthread_setname_np(std::string("Neuron Update Pool Thread " + std::to_string(_ThreadNumber)).c_str());
+#else
+    pthread_setname_np(pthread_self(), std::string("Neuron Update Pool Thread " + std::to_string(_ThreadNumber)).c_str());
+#endif
+
+    size_t SeenGeneration = 0;
+    while (true) {
+
+        // Sleep until there is a new job or we are asked to stop.
+        {
+            std::unique_lock<std::mutex> Lock(Mutex_);
+            WorkReady_.wait(Lock, [&] { return StopThreads_ || (Generation_ != SeenGeneration); });
+            if (StopThreads_) {
+                return;
+            }
+            SeenGeneration = Generation_;
+        }
+
+        RunChunks();
+
+        // Report completion, the last worker wakes the caller.
+        {
+            std::lock_guard<std::mutex> Lock(Mutex_);
+            ActiveWorkers_--;
+            if (ActiveWorkers_ == 0) {
+                WorkDone_.notify_one();
+            }
+        }
+    }
+}
+
+void NeuronUpdatePool::ParallelFor(size_t _Count, size_t _ChunkSize, const ChunkFunction& _Function) {
+    if (_Count == 0) {
+        return;
+    }
+
+    // Aim for several chunks per thread so that uneven neuron costs (e.g.
+    // bursting neurons or very different receptor counts) balance out.
+    if (_ChunkSize == 0) {
+        _ChunkSize = std::max<size_t>(1, _Count / (size_t(GetNumThreads()) * 8));
+    }
+
+    // Nothing to distribute, run it here.
+    if (Threads_.empty() || (_Count <= _ChunkSize)) {
+        _Function(0, _Count);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> Lock(Mutex_);
+        Function_ = &_Function;
+        Count_ = _Count;
+        ChunkSize_ = _ChunkSize;
+        NextIndex_ = 0;
+        ActiveWorkers_ = Threads_.size();
+        Generation_++;
+    }
+    WorkReady_.notify_all();
+
+    RunChunks();
+
+    std::unique_lock<std::mutex> Lock(Mutex_);
+    WorkDone_.wait(Lock, [&] { return ActiveWorkers_ == 0; });
+    Function_ = nullptr;
+}
+
+
+
+}; // Close Namespace Updater
+}; // Close Namespace Simulator
+}; // Close Namespace NES
+}; // Close Namespace BG
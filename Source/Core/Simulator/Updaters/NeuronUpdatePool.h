@@ -0,0 +1,113 @@
+//=================================================================//
+// This file is part of the BrainGenix-NES Neuron Emulation System //
+//=================================================================//
+
+/*
+    Description: This file provides the persistent worker pool used to update neurons in parallel.
+    Additional Notes: None
+    Date Created: 2026-10-17
+*/
+
+#pragma once
+
+// Standard Libraries (BG convention: use <> instead of "")
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Third-Party Libraries (BG convention: use <> instead of "")
+
+// Internal Libraries (BG convention: use <> instead of "")
+
+
+namespace BG {
+namespace NES {
+namespace Simulator {
+namespace Updater {
+
+
+//! Function called on a half-open [_Start, _End) range of items.
+using ChunkFunction = std::function<void(size_t _Start, size_t _End)>;
+
+
+/**
+ * @brief Persistent thread pool that splits a range of items into chunks and
+ * processes them on all workers plus the calling thread.
+ *
+ * Unlike the renderer pools, workers do not poll a queue. They sleep on a
+ * condition variable and are woken once per ParallelFor() call, which keeps
+ * the per-timestep overhead of a simulation run in the microsecond range.
+ * ParallelFor() blocks until every chunk is done, so it doubles as the
+ * barrier between the update and commit phases of a timestep.
+ */
+class NeuronUpdatePool {
+
+private:
+
+    std::vector<std::thread> Threads_;       /**Worker threads, the calling thread is the additional worker*/
+
+    std::mutex Mutex_;                       /**Guards the job description and the counters below*/
+    std::condition_variable WorkReady_;      /**Signals workers that a new job is available*/
+    std::condition_variable WorkDone_;       /**Signals the caller that all workers finished the job*/
+    size_t Generation_ = 0;                  /**Incremented for every new job*/
+    size_t ActiveWorkers_ = 0;               /**Number of workers still processing the current job*/
+    bool StopThreads_ = false;               /**Tells workers to exit*/
+
+    const ChunkFunction* Function_ = nullptr; /**Function of the current job*/
+    size_t Count_ = 0;                       /**Number of items in the current job*/
+    size_t ChunkSize_ = 1;                   /**Number of items handed to a worker at a time*/
+    std::atomic<size_t> NextIndex_{0};       /**First item of the next unclaimed chunk*/
+
+    /**
+     * @brief Claims and processes chunks of the current job until none are left.
+     */
+    void RunChunks();
+
+    /**
+     * @brief Entry point for the worker threads.
+     *
+     * @param _ThreadNumber
+     */
+    void WorkerMainFunction(int _ThreadNumber);
+
+public:
+
+    /**
+     * @brief Creates the pool. The calling thread participates in every
+     * job, so _NumThreads-1 worker threads are started.
+     *
+     * @param _NumThreads Total number of threads, values < 1 use the number of hardware threads.
+     */
+    NeuronUpdatePool(int _NumThreads = 0);
+
+    /**
+     * @brief Stops and joins the worker threads.
+     */
+    ~NeuronUpdatePool();
+
+    /**
+     * @brief Calls _Function on chunks of [0, _Count) distributed over the
+     * pool and returns once all of them have completed.
+     *
+     * @param _Count Number of items.
+     * @param _ChunkSize Number of items per chunk, 0 picks a size based on the thread count.
+     * @param _Function
+     */
+    void ParallelFor(size_t _Count, size_t _ChunkSize, const ChunkFunction& _Function);
+
+    /**
+     * @brief Returns the total number of threads used, including the caller.
+     */
+    int GetNumThreads() const { return int(Threads_.size()) + 1; }
+
+};
+
+
+
+}; // Close Namespace Updater
+}; // Close Namespace Simulator
+}; // Close Namespace NES
+}; // Close Namespace BG
@@ -0,0 +1,206 @@
+//=================================================================//
+// This file is part of the BrainGenix-NES Neuron Emulation System //
+//=================================================================//
+
+/*
+    Description: This file provides unit tests for the neuron update pool and the parallel update mode.
+    Additional Notes: None
+    Date Created: 2026-10-17
+*/
+
+#include <atomic>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <BG/Common/Logger/Logger.h>
+#include <Simulator/Geometries/Sphere.h>
+#include <Simulator/Structs/Simulation.h>
+#include <Simulator/Structs/RecordingElectrode.h>
+#include <Simulator/Structs/CalciumImaging.h>
+#include <Simulator/Updaters/NeuronUpdatePool.h>
+
+
+TEST(NeuronUpdatePoolTest, test_ParallelFor_visits_every_item_once) {
+    BG::NES::Simulator::Updater::NeuronUpdatePool Pool(4);
+    ASSERT_EQ(Pool.GetNumThreads(), 4);
+
+    for (size_t Count : {0, 1, 7, 1000}) {
+        for (size_t ChunkSize : {0, 1, 3, 64}) {
+            std::vector<std::atomic<int>> Visits(Count);
+            Pool.ParallelFor(Count, ChunkSize, [&](size_t _Start, size_t _End) {
+                for (size_t i = _Start; i < _End; i++) {
+                    Visits[i]++;
+                }
+            });
+            for (size_t i = 0; i < Count; i++) {
+                ASSERT_EQ(Visits[i], 1) << "item " << i << " of " << Count << ", chunks of " << ChunkSize;
+            }
+        }
+    }
+}
+
+
+/**
+ * @brief Test class for the parallel update mode. Builds a randomly
+ * connected LIFC network with spontaneously active neurons, so that every
+ * neuron reads presynaptic spikes of others during the same timesteps.
+ */
+
+struct ParallelUpdateTest : testing::Test {
+    BG::Common::Logger::LoggingSystem Logger;
+
+    static constexpr int NumNeurons = 24;
+    static constexpr int NumReceptors = 120;
+    static constexpr float T_ms = 150.0;
+
+    std::unique_ptr<BG::NES::Simulator::Simulation> MakeNetwork(bool _EventDriven) {
+        using namespace BG::NES::Simulator;
+
+        auto Sim = std::make_unique<Simulation>(&Logger);
+        Sim->SetRandomSeed(7);
+        Sim->Dt_ms = 0.25;
+        Sim->use_recursive_conductances = _EventDriven;
+        Sim->use_event_driven_delivery = _EventDriven;
+
+        std::vector<int> CompartmentIDs;
+        for (int i = 0; i < NumNeurons; i++) {
+            Geometries::Sphere S(Geometries::Vec3D(10.0*i, 0.0, 0.0), 2.0);
+            int ShapeID = Sim->AddSphere(S);
+
+            Compartments::LIFC C;
+            C.ShapeID = ShapeID;
+            C.RestingPotential_mV = -60.0;
+            C.ResetPotential_mV = -55.0;
+            C.SpikeThreshold_mV = -50.0;
+            C.MembraneResistance_MOhm = 100.0;
+            C.MembraneCapacitance_pF = 100.0;
+            C.AfterHyperpolarizationAmplitude_mV = 0.0;
+            CompartmentIDs.push_back(Sim->AddLIFCCompartment(C));
+
+            CoreStructs::LIFCNeuronStruct N;
+            N.RestingPotential_mV = -60.0;
+            N.ResetPotential_mV = -55.0;
+            N.SpikeThreshold_mV = -50.0;
+            N.MembraneResistance_MOhm = 100.0;
+            N.MembraneCapacitance_pF = 100.0;
+            N.RefractoryPeriod_ms = 2.0;
+            N.SpikeDepolarization_mV = 30.0;
+            N.UpdateMethod = CoreStructs::EXPEULER_CM;
+            N.ResetMethod = CoreStructs::TOVM;
+            N.AfterHyperpolarizationReversalPotential_mV = -90.0;
+            N.FastAfterHyperpolarizationRise_ms = 2.5;
+            N.FastAfterHyperpolarizationDecay_ms = 30.0;
+            N.FastAfterHyperpolarizationPeakConductance_nS = 3.0;
+            N.FastAfterHyperpolarizationMaxPeakConductance_nS = 10.0;
+            N.FastAfterHyperpolarizationHalfActConstant = 0.5;
+            N.SlowAfterHyperpolarizationRise_ms = 30.0;
+            N.SlowAfterHyperpolarizationDecay_ms = 300.0;
+            N.SlowAfterHyperpolarizationPeakConductance_nS = 1.0;
+            N.SlowAfterHyperpolarizationMaxPeakConductance_nS = 5.0;
+            N.SlowAfterHyperpolarizationHalfActConstant = 0.5;
+            N.AfterHyperpolarizationSaturationModel = CoreStructs::AHPCLIP;
+            N.FatigueThreshold = 300.0;
+            N.FatigueRecoveryTime_ms = 1000.0;
+            N.AfterDepolarizationReversalPotential_mV = -20.0;
+            N.AfterDepolarizationRise_ms = 20.0;
+            N.AfterDepolarizationDecay_ms = 200.0;
+            N.AfterDepolarizationPeakConductance_nS = 0.3;
+            N.AfterDepolarizationSaturationMultiplier = 2.0;
+            N.AfterDepolarizationRecoveryTime_ms = 300.0;
+            N.AfterDepolarizationDepletion = 0.3;
+            N.AfterDepolarizationSaturationModel = CoreStructs::ADPCLIP;
+            N.AdaptiveThresholdDiffPerSpike = 0.2;
+            N.AdaptiveTresholdRecoveryTime_ms = 50.0;
+            N.AdaptiveThresholdDiffPotential_mV = 10.0;
+            N.AdaptiveThresholdFloor_mV = -50.0;
+            N.AdaptiveThresholdFloorDeltaPerSpike_mV = 1.0;
+            N.AdaptiveThresholdFloorRecoveryTime_ms = 500.0;
+            N.SomaCompartmentIDs.push_back(CompartmentIDs.back());
+            Sim->AddLIFCNeuron(N);
+        }
+
+        // Random excitatory and inhibitory synapses with STDP, some of them
+        // with delays of a single timestep.
+        std::mt19937 Generator(11);
+        std::uniform_int_distribution<int> Neuron(0, NumNeurons - 1);
+        std::uniform_real_distribution<float> Delay(0.25, 3.0);
+        for (int i = 0; i < NumReceptors; i++) {
+            Connections::LIFCReceptor R;
+            R.SourceCompartmentID = CompartmentIDs[Neuron(Generator)];
+            R.DestinationCompartmentID = CompartmentIDs[Neuron(Generator)];
+            bool Inhibitory = (i % 4) == 0;
+            R.ReversalPotential_mV = Inhibitory ? -70.0 : 0.0;
+            R.PSPRise_ms = 0.5;
+            R.PSPDecay_ms = 3.0;
+            R.PeakConductance_nS = Inhibitory ? 20.0 : 10.0;
+            R.Weight = 1.0;
+            R.OnsetDelay_ms = (i % 5 == 0) ? 0.25 : Delay(Generator);
+            R.Neurotransmitter = Inhibitory ? Connections::GABA : Connections::AMPA;
+            R.STDP_Method = Connections::STDPHEBBIAN;
+            R.STDP_A_pos = 0.1;
+            R.STDP_A_neg = 0.1;
+            R.STDP_Tau_pos = 20.0;
+            R.STDP_Tau_neg = 20.0;
+            Sim->AddLIFCReceptor(R);
+        }
+
+        for (auto & Neuron : Sim->Neurons) {
+            Neuron->SetSpontaneousActivity(40.0, 10.0, Sim->MasterRandom_->UniformRandomInt());
+        }
+        Sim->SetRecordAll();
+
+        return Sim;
+    }
+
+    void ExpectSameRun(BG::NES::Simulator::Simulation& _Serial, BG::NES::Simulator::Simulation& _Parallel) {
+        using BG::NES::Simulator::BallAndStick::BSNeuron;
+        ASSERT_EQ(_Serial.T_ms, _Parallel.T_ms);
+        for (int i = 0; i < NumNeurons; i++) {
+            auto SerialNeuron = std::dynamic_pointer_cast<BSNeuron>(_Serial.Neurons[i]);
+            auto ParallelNeuron = std::dynamic_pointer_cast<BSNeuron>(_Parallel.Neurons[i]);
+            ASSERT_TRUE(SerialNeuron && ParallelNeuron);
+            ASSERT_FALSE(SerialNeuron->VmRecorded_mV.empty());
+            ASSERT_EQ(SerialNeuron->TAct_ms, ParallelNeuron->TAct_ms) << "neuron " << i;
+            ASSERT_EQ(SerialNeuron->VmRecorded_mV, ParallelNeuron->VmRecorded_mV) << "neuron " << i;
+        }
+        for (size_t r = 0; r < _Serial.LIFCReceptorDataVec.size(); r++) {
+            ASSERT_EQ(_Serial.LIFCReceptorDataVec[r]->weight, _Parallel.LIFCReceptorDataVec[r]->weight) << "receptor " << r;
+        }
+    }
+
+    void TearDown() { return; }
+};
+
+TEST_F(ParallelUpdateTest, test_Parallel_matches_serial_exactly) {
+    for (bool EventDriven : {false, true}) {
+        auto Serial = MakeNetwork(EventDriven);
+        Serial->RunFor(T_ms);
+
+        auto Parallel = MakeNetwork(EventDriven);
+        Parallel->SetParallelUpdate(true, 4);
+        ASSERT_TRUE(Parallel->UsesParallelUpdate());
+        Parallel->RunFor(T_ms);
+
+        ASSERT_GT(Serial->TotalSpikes(), (unsigned long)NumNeurons) << "event driven " << EventDriven;
+        ExpectSameRun(*Serial, *Parallel);
+    }
+}
+
+TEST_F(ParallelUpdateTest, test_Switching_modes_between_runs) {
+    auto Serial = MakeNetwork(false);
+    Serial->RunFor(2*T_ms);
+
+    // Parallel, then serial, then parallel with another thread count.
+    auto Mixed = MakeNetwork(false);
+    Mixed->SetParallelUpdate(true, 3);
+    Mixed->RunFor(0.5*T_ms);
+    Mixed->SetParallelUpdate(false);
+    Mixed->RunFor(T_ms);
+    Mixed->SetParallelUpdate(true, 2);
+    Mixed->RunFor(0.5*T_ms);
+
+    ExpectSameRun(*Serial, *Mixed);
+}
@@ -0,0 +1,128 @@
+#include <Simulator/Updaters/SpikeEventQueue.h>
+#include <Simulator/Structs/Neuron.h>
+
+#include <algorithm>
+#include <cmath>
+
+
+namespace BG {
+namespace NES {
+namespace Simulator {
+namespace Updater {
+
+
+
+SpikeEventQueue::SpikeEventQueue() {
+    Slots_.resize(64);
+}
+
+int64_t SpikeEventQueue::StepOf(float _T_ms) const {
+    return int64_t(std::floor(_T_ms / Dt_ms_));
+}
+
+void SpikeEventQueue::Grow(int64_t _Span) {
+    size_t NewSize = Slots_.size();
+    while (int64_t(NewSize) <= _Span) {
+        NewSize *= 2;
+    }
+
+    std::vector<std::vector<SpikeEvent>> OldSlots(NewSize);
+    std::swap(OldSlots, Slots_);
+    NumPending_ = 0;
+    for (auto& Slot : OldSlots) {
+        for (auto& Event : Slot) {
+            Insert(Event);
+        }
+    }
+}
+
+void SpikeEventQueue::Insert(const SpikeEvent& _Event) {
+    int64_t Step = std::max(StepOf(_Event.Arrival_ms), NextStep_);
+    if ((Step - NextStep_) >= int64_t(Slots_.size())) {
+        Grow(Step - NextStep_);
+    }
+    Slots_[size_t(Step) & (Slots_.size() - 1)].push_back(_Event);
+    NumPending_++;
+}
+
+void SpikeEventQueue::Configure(float _Dt_ms, float _T_ms) {
+    if (_Dt_ms == Dt_ms_) {
+        // Time may have advanced without deliveries while the queue was not in use.
+        if (NumPending_ == 0) {
+            NextStep_ = StepOf(_T_ms);
+        }
+        return;
+    }
+
+    std::vector<SpikeEvent> Pending;
+    Pending.reserve(NumPending_);
+    for (auto& Slot : Slots_) {
+        Pending.insert(Pending.end(), Slot.begin(), Slot.end());
+        Slot.clear();
+    }
+    // Keep the events of each receptor in arrival order.
+    std::stable_sort(Pending.begin(), Pending.end(), [](const SpikeEvent& _A, const SpikeEvent& _B) {
+        return _A.Arrival_ms < _B.Arrival_ms;
+    });
+
+    Dt_ms_ = _Dt_ms;
+    NextStep_ = StepOf(_T_ms);
+    NumPending_ = 0;
+    for (auto& Event : Pending) {
+        Insert(Event);
+    }
+}
+
+void SpikeEventQueue::Push(float _Arrival_ms, CoreStructs::LIFCReceptorData* _Receptor) {
+    Insert(SpikeEvent{_Arrival_ms, _Receptor});
+}
+
+void SpikeEventQueue::Deliver(float _T_ms) {
+    // Also deliver the following bucket, this covers rounding of _T_ms and
+    // arrival times to steps. Receptors hold early events until they arrive.
+    int64_t LastStep = StepOf(_T_ms) + 1;
+    int64_t NumSteps = std::min<int64_t>(LastStep - NextStep_ + 1, int64_t(Slots_.size()));
+
+    for (int64_t i = 0; (i < NumSteps) && (NumPending_ > 0); i++) {
+        auto& Slot = Slots_[size_t(NextStep_ + i) & (Slots_.size() - 1)];
+        for (auto& Event : Slot) {
+            Event.Receptor->g_state.arrivals_ms.push_back(Event.Arrival_ms);
+        }
+        NumPending_ -= Slot.size();
+        Slot.clear();
+    }
+    NextStep_ = std::max(NextStep_, LastStep + 1);
+}
+
+void SpikeEventQueue::Clear() {
+    for (auto& Slot : Slots_) {
+        Slot.clear();
+    }
+    NumPending_ = 0;
+}
+
+std::vector<SpikeEvent> SpikeEventQueue::GetPending() const {
+    std::vector<SpikeEvent> Pending;
+    Pending.reserve(NumPending_);
+    for (size_t i = 0; (i < Slots_.size()) && (Pending.size() < NumPending_); i++) {
+        const auto& Slot = Slots_[size_t(NextStep_ + int64_t(i)) & (Slots_.size() - 1)];
+        Pending.insert(Pending.end(), Slot.begin(), Slot.end());
+    }
+    return Pending;
+}
+
+void SpikeEventQueue::Restore(float _Dt_ms, int64_t _NextStep, const std::vector<SpikeEvent>& _Pending) {
+    Clear();
+    Dt_ms_ = _Dt_ms;
+    NextStep_ = _NextStep;
+    for (auto& Event : _Pending) {
+        Insert(Event);
+    }
+}
+
+
+
+}; // Close Namespace Updater
+}; // Close Namespace Simulator
+}; // Close Namespace NES
+}; // Close Namespace BG
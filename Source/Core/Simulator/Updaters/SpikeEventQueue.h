@@ -0,0 +1,139 @@
+//=================================================================//
+// This file is part of the BrainGenix-NES Neuron Emulation System //
+//=================================================================//
+
+/*
+    Description: This file provides the calendar queue used for event-driven LIFC spike delivery.
+    Additional Notes: None
+    Date Created: 2026-10-17
+*/
+
+#pragma once
+
+// Standard Libraries (BG convention: use <> instead of "")
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Third-Party Libraries (BG convention: use <> instead of "")
+
+// Internal Libraries (BG convention: use <> instead of "")
+
+
+namespace BG {
+namespace NES {
+namespace Simulator {
+
+namespace CoreStructs {
+struct LIFCReceptorData;
+};
+
+namespace Updater {
+
+
+/**
+ * @brief A spike on its way to one receptor.
+ */
+struct SpikeEvent {
+    float Arrival_ms;                         /**Presynaptic spike time plus onset delay*/
+    CoreStructs::LIFCReceptorData* Receptor;  /**Receptor the spike arrives at*/
+};
+
+
+/**
+ * @brief Calendar queue of spike events, bucketed by the timestep they arrive in.
+ *
+ * The buckets form a ring that covers the longest pending onset delay and
+ * grows if a longer one is pushed. Delivering a timestep only touches the
+ * events in its bucket, so the cost of spike transmission scales with the
+ * number of spikes times their fan-out instead of with the number of
+ * synapses times the length of the spike history.
+ *
+ * Events are handed to the receptors' DoubleExpState up to one timestep
+ * early. Each receptor then applies them once they have actually arrived,
+ * with the exact decay since the arrival time. Rounding of arrival times to
+ * buckets therefore never changes results.
+ */
+class SpikeEventQueue {
+
+private:
+
+    std::vector<std::vector<SpikeEvent>> Slots_; /**Ring of buckets, size is a power of two*/
+    float Dt_ms_ = 1.0;                          /**Width of a bucket*/
+    int64_t NextStep_ = 0;                       /**First bucket that has not been delivered yet*/
+    size_t NumPending_ = 0;                      /**Number of queued events*/
+
+    int64_t StepOf(float _T_ms) const;
+
+    /**
+     * @brief Resizes the ring so that it covers at least _Span buckets
+     * beyond NextStep_ and redistributes the pending events.
+     */
+    void Grow(int64_t _Span);
+
+    void Insert(const SpikeEvent& _Event);
+
+public:
+
+    SpikeEventQueue();
+
+    /**
+     * @brief Sets the bucket width for a run starting at _T_ms. Pending
+     * events are rebucketed if the width changed.
+     *
+     * @param _Dt_ms
+     * @param _T_ms
+     */
+    void Configure(float _Dt_ms, float _T_ms);
+
+    /**
+     * @brief Queues a spike arriving at _Arrival_ms. Arrival times that
+     * already passed are delivered with the next bucket.
+     *
+     * @param _Arrival_ms
+     * @param _Receptor
+     */
+    void Push(float _Arrival_ms, CoreStructs::LIFCReceptorData* _Receptor);
+
+    /**
+     * @brief Hands all events arriving up to the end of the timestep at
+     * _T_ms to their receptors.
+     *
+     * @param _T_ms
+     */
+    void Deliver(float _T_ms);
+
+    /**
+     * @brief Drops all pending events.
+     */
+    void Clear();
+
+    size_t GetNumPending() const { return NumPending_; }
+
+    float GetDt_ms() const { return Dt_ms_; }
+    int64_t GetNextStep() const { return NextStep_; }
+
+    /**
+     * @brief Returns the pending events in delivery order, used for
+     * checkpoints together with GetDt_ms() and GetNextStep().
+     */
+    std::vector<SpikeEvent> GetPending() const;
+
+    /**
+     * @brief Replaces the queue content with events returned by
+     * GetPending(), keeping their order within each bucket.
+     *
+     * @param _Dt_ms
+     * @param _NextStep
+     * @param _Pending
+     */
+    void Restore(float _Dt_ms, int64_t _NextStep, const std::vector<SpikeEvent>& _Pending);
+
+};
+
+
+
+}; // Close Namespace Updater
+}; // Close Namespace Simulator
+}; // Close Namespace NES
+}; // Close Namespace BG
@@ -0,0 +1,281 @@
+//=================================================================//
+// This file is part of the BrainGenix-NES Neuron Emulation System //
+//=================================================================//
+
+/*
+    Description: This file provides unit tests for the calendar queue of event-driven spike delivery.
+    Additional Notes: None
+    Date Created: 2026-10-17
+*/
+
+#include <deque>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <BG/Common/Logger/Logger.h>
+#include <Simulator/Geometries/Sphere.h>
+#include <Simulator/Structs/Simulation.h>
+#include <Simulator/Structs/RecordingElectrode.h>
+#include <Simulator/Structs/CalciumImaging.h>
+#include <Simulator/Updaters/SpikeEventQueue.h>
+
+
+/**
+ * @brief Test class for the spike event queue and event-driven delivery.
+ * MakeNetwork() builds a small randomly connected LIFC network, whose
+ * receptors also serve as delivery targets for the queue tests.
+ */
+
+struct SpikeEventQueueTest : testing::Test {
+    BG::Common::Logger::LoggingSystem Logger;
+
+    static constexpr int NumNeurons = 12;
+    static constexpr int NumReceptors = 48;
+
+    std::unique_ptr<BG::NES::Simulator::Simulation> MakeNetwork(bool _EventDriven) {
+        using namespace BG::NES::Simulator;
+
+        auto Sim = std::make_unique<Simulation>(&Logger);
+        Sim->SetRandomSeed(3);
+        Sim->Dt_ms = 0.25;
+        Sim->use_recursive_conductances = true;
+        Sim->use_event_driven_delivery = _EventDriven;
+
+        std::vector<int> CompartmentIDs;
+        for (int i = 0; i < NumNeurons; i++) {
+            Geometries::Sphere S(Geometries::Vec3D(10.0*i, 0.0, 0.0), 2.0);
+            int ShapeID = Sim->AddSphere(S);
+
+            Compartments::LIFC C;
+            C.ShapeID = ShapeID;
+            C.RestingPotential_mV = -60.0;
+            C.ResetPotential_mV = -55.0;
+            C.SpikeThreshold_mV = -50.0;
+            C.MembraneResistance_MOhm = 100.0;
+            C.MembraneCapacitance_pF = 100.0;
+            C.AfterHyperpolarizationAmplitude_mV = 0.0;
+            CompartmentIDs.push_back(Sim->AddLIFCCompartment(C));
+
+            CoreStructs::LIFCNeuronStruct N;
+            N.RestingPotential_mV = -60.0;
+            N.ResetPotential_mV = -55.0;
+            N.SpikeThreshold_mV = -50.0;
+            N.MembraneResistance_MOhm = 100.0;
+            N.MembraneCapacitance_pF = 100.0;
+            N.RefractoryPeriod_ms = 2.0;
+            N.SpikeDepolarization_mV = 30.0;
+            N.UpdateMethod = CoreStructs::EXPEULER_CM;
+            N.ResetMethod = CoreStructs::TOVM;
+            N.AfterHyperpolarizationReversalPotential_mV = -90.0;
+            N.FastAfterHyperpolarizationRise_ms = 2.5;
+            N.FastAfterHyperpolarizationDecay_ms = 30.0;
+            N.FastAfterHyperpolarizationPeakConductance_nS = 3.0;
+            N.FastAfterHyperpolarizationMaxPeakConductance_nS = 10.0;
+            N.FastAfterHyperpolarizationHalfActConstant = 0.5;
+            N.SlowAfterHyperpolarizationRise_ms = 30.0;
+            N.SlowAfterHyperpolarizationDecay_ms = 300.0;
+            N.SlowAfterHyperpolarizationPeakConductance_nS = 1.0;
+            N.SlowAfterHyperpolarizationMaxPeakConductance_nS = 5.0;
+            N.SlowAfterHyperpolarizationHalfActConstant = 0.5;
+            N.AfterHyperpolarizationSaturationModel = CoreStructs::AHPCLIP;
+            N.FatigueThreshold = 300.0;
+            N.FatigueRecoveryTime_ms = 1000.0;
+            N.AfterDepolarizationReversalPotential_mV = -20.0;
+            N.AfterDepolarizationRise_ms = 20.0;
+            N.AfterDepolarizationDecay_ms = 200.0;
+            N.AfterDepolarizationPeakConductance_nS = 0.3;
+            N.AfterDepolarizationSaturationMultiplier = 2.0;
+            N.AfterDepolarizationRecoveryTime_ms = 300.0;
+            N.AfterDepolarizationDepletion = 0.3;
+            N.AfterDepolarizationSaturationModel = CoreStructs::ADPCLIP;
+            N.AdaptiveThresholdDiffPerSpike = 0.2;
+            N.AdaptiveTresholdRecoveryTime_ms = 50.0;
+            N.AdaptiveThresholdDiffPotential_mV = 10.0;
+            N.AdaptiveThresholdFloor_mV = -50.0;
+            N.AdaptiveThresholdFloorDeltaPerSpike_mV = 1.0;
+            N.AdaptiveThresholdFloorRecoveryTime_ms = 500.0;
+            N.SomaCompartmentIDs.push_back(CompartmentIDs.back());
+            Sim->AddLIFCNeuron(N);
+        }
+
+        // Delays from below one timestep to well beyond the initial ring of buckets.
+        std::mt19937 Generator(5);
+        std::uniform_int_distribution<int> Neuron(0, NumNeurons - 1);
+        std::uniform_real_distribution<float> Delay(0.1, 30.0);
+        for (int i = 0; i < NumReceptors; i++) {
+            Connections::LIFCReceptor R;
+            R.SourceCompartmentID = CompartmentIDs[Neuron(Generator)];
+            R.DestinationCompartmentID = CompartmentIDs[Neuron(Generator)];
+            R.ReversalPotential_mV = (i % 4 == 0) ? -70.0 : 0.0;
+            R.PSPRise_ms = 0.5;
+            R.PSPDecay_ms = 3.0;
+            R.PeakConductance_nS = 15.0;
+            R.Weight = 1.0;
+            R.OnsetDelay_ms = Delay(Generator);
+            R.Neurotransmitter = (i % 4 == 0) ? Connections::GABA : Connections::AMPA;
+            Sim->AddLIFCReceptor(R);
+        }
+
+        for (auto & Neuron : Sim->Neurons) {
+            Neuron->SetSpontaneousActivity(30.0, 10.0, Sim->MasterRandom_->UniformRandomInt());
+        }
+        Sim->SetRecordAll();
+
+        return Sim;
+    }
+
+    BG::NES::Simulator::CoreStructs::LIFCReceptorData* Receptor(BG::NES::Simulator::Simulation& _Sim, int _Index) {
+        auto* RData = _Sim.LIFCReceptorDataVec.at(_Index).get();
+        RData->g_state.arrivals_ms.clear();
+        return RData;
+    }
+
+    void TearDown() { return; }
+};
+
+TEST_F(SpikeEventQueueTest, test_Delivery_order_and_delays) {
+    auto Sim = MakeNetwork(false);
+    auto* A = Receptor(*Sim, 0);
+    auto* B = Receptor(*Sim, 1);
+
+    BG::NES::Simulator::Updater::SpikeEventQueue Queue;
+    Queue.Configure(0.25, 0.0);
+
+    // Pushed out of order, across buckets and within one bucket.
+    Queue.Push(2.0, A);
+    Queue.Push(0.6, B);
+    Queue.Push(0.55, A);
+    Queue.Push(0.7, A);
+    Queue.Push(5.1, B);
+    ASSERT_EQ(Queue.GetNumPending(), 5);
+
+    // A step hands over its own bucket and the next one, never anything later.
+    Queue.Deliver(0.0);
+    ASSERT_TRUE(A->g_state.arrivals_ms.empty());
+    ASSERT_TRUE(B->g_state.arrivals_ms.empty());
+
+    Queue.Deliver(0.25);
+    ASSERT_EQ(A->g_state.arrivals_ms, (std::deque<float>{0.55, 0.7}));
+    ASSERT_EQ(B->g_state.arrivals_ms, (std::deque<float>{0.6}));
+    ASSERT_EQ(Queue.GetNumPending(), 2);
+
+    for (float T = 0.5; T < 1.75; T += 0.25) {
+        Queue.Deliver(T);
+    }
+    ASSERT_EQ(A->g_state.arrivals_ms.size(), 2);
+    Queue.Deliver(1.75);
+    ASSERT_EQ(A->g_state.arrivals_ms, (std::deque<float>{0.55, 0.7, 2.0}));
+
+    // An arrival time that already passed goes out with the next delivery.
+    Queue.Push(0.1, A);
+    Queue.Deliver(2.0);
+    ASSERT_EQ(A->g_state.arrivals_ms.back(), 0.1f);
+
+    for (float T = 2.25; T < 5.0; T += 0.25) {
+        Queue.Deliver(T);
+    }
+    ASSERT_EQ(B->g_state.arrivals_ms, (std::deque<float>{0.6, 5.1}));
+    ASSERT_EQ(Queue.GetNumPending(), 0);
+}
+
+TEST_F(SpikeEventQueueTest, test_Calendar_wraps_and_grows) {
+    auto Sim = MakeNetwork(false);
+    BG::NES::Simulator::CoreStructs::LIFCReceptorData* Targets[3] = { Receptor(*Sim, 0), Receptor(*Sim, 1), Receptor(*Sim, 2) };
+
+    BG::NES::Simulator::Updater::SpikeEventQueue Queue;
+    const float Dt_ms = 0.25;
+    Queue.Configure(Dt_ms, 0.0);
+
+    // Run many times around the ring, pushing delays both shorter and far
+    // longer than the ring covers, and check that each event arrives in the
+    // step before or the step of its arrival time.
+    std::mt19937 Generator(9);
+    std::uniform_real_distribution<float> Delay(0.0, 200.0);
+    std::vector<std::vector<float>> Expected(3);
+    size_t NumPushed = 0;
+    for (int Step = 0; Step < 4000; Step++) {
+        float T = Step * Dt_ms;
+        if (Step < 3000) {
+            int Target = Step % 3;
+            float Arrival = T + Delay(Generator);
+            Queue.Push(Arrival, Targets[Target]);
+            Expected[Target].push_back(Arrival);
+            NumPushed++;
+        }
+        size_t Before[3];
+        for (int t = 0; t < 3; t++) {
+            Before[t] = Targets[t]->g_state.arrivals_ms.size();
+        }
+        Queue.Deliver(T);
+        for (int t = 0; t < 3; t++) {
+            for (size_t i = Before[t]; i < Targets[t]->g_state.arrivals_ms.size(); i++) {
+                float Arrival = Targets[t]->g_state.arrivals_ms[i];
+                ASSERT_LT(Arrival, T + 2*Dt_ms) << "delivered too early at step " << Step;
+                ASSERT_GE(Arrival, T - Dt_ms) << "delivered too late at step " << Step;
+            }
+        }
+    }
+    ASSERT_EQ(Queue.GetNumPending(), 0);
+
+    size_t NumDelivered = 0;
+    for (int t = 0; t < 3; t++) {
+        std::vector<float> Delivered(Targets[t]->g_state.arrivals_ms.begin(), Targets[t]->g_state.arrivals_ms.end());
+        std::sort(Expected[t].begin(), Expected[t].end());
+        std::sort(Delivered.begin(), Delivered.end());
+        ASSERT_EQ(Delivered, Expected[t]);
+        NumDelivered += Delivered.size();
+    }
+    ASSERT_EQ(NumDelivered, NumPushed);
+}
+
+TEST_F(SpikeEventQueueTest, test_Pending_restore_and_rebucketing) {
+    auto Sim = MakeNetwork(false);
+    auto* A = Receptor(*Sim, 0);
+
+    BG::NES::Simulator::Updater::SpikeEventQueue Queue;
+    Queue.Configure(0.25, 10.0);
+    for (float Arrival : {40.0f, 10.6f, 25.0f, 10.55f}) {
+        Queue.Push(Arrival, A);
+    }
+
+    // Pending events come out in delivery order and restore to the same queue.
+    std::vector<BG::NES::Simulator::Updater::SpikeEvent> Pending = Queue.GetPending();
+    ASSERT_EQ(Pending.size(), 4);
+    for (size_t i = 1; i < Pending.size(); i++) {
+        ASSERT_LE(std::floor(Pending[i-1].Arrival_ms / 0.25), std::floor(Pending[i].Arrival_ms / 0.25));
+    }
+    BG::NES::Simulator::Updater::SpikeEventQueue Restored;
+    Restored.Restore(Queue.GetDt_ms(), Queue.GetNextStep(), Pending);
+    ASSERT_EQ(Restored.GetNumPending(), 4);
+
+    // A new timestep size rebuckets without losing or reordering events.
+    Restored.Configure(0.1, 10.0);
+    for (float T = 10.0; T < 45.0; T += 0.1) {
+        Restored.Deliver(T);
+    }
+    ASSERT_EQ(A->g_state.arrivals_ms, (std::deque<float>{10.55, 10.6, 25.0, 40.0}));
+    ASSERT_EQ(Restored.GetNumPending(), 0);
+}
+
+TEST_F(SpikeEventQueueTest, test_Event_driven_matches_time_driven) {
+    using BG::NES::Simulator::BallAndStick::BSNeuron;
+
+    auto TimeDriven = MakeNetwork(false);
+    auto EventDriven = MakeNetwork(true);
+    TimeDriven->RunFor(300.0);
+    EventDriven->RunFor(300.0);
+
+    ASSERT_GT(TimeDriven->TotalSpikes(), (unsigned long)NumNeurons);
+    for (int i = 0; i < NumNeurons; i++) {
+        auto TimeNeuron = std::dynamic_pointer_cast<BSNeuron>(TimeDriven->Neurons[i]);
+        auto EventNeuron = std::dynamic_pointer_cast<BSNeuron>(EventDriven->Neurons[i]);
+        ASSERT_EQ(TimeNeuron->TAct_ms, EventNeuron->TAct_ms) << "neuron " << i;
+        ASSERT_EQ(TimeNeuron->VmRecorded_mV.size(), EventNeuron->VmRecorded_mV.size());
+        for (size_t t = 0; t < TimeNeuron->VmRecorded_mV.size(); t++) {
+            ASSERT_NEAR(TimeNeuron->VmRecorded_mV[t], EventNeuron->VmRecorded_mV[t], 1e-3) << "neuron " << i << ", sample " << t;
+        }
+    }
+}
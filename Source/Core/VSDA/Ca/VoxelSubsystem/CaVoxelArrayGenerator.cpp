@@ -28,27 +28,6 @@ namespace Calcium {
 
 
 
-bool IsShapeInsideRegion(Simulator::Simulation* _Sim, size_t _ShapeID, Simulator::BoundingBox _Region, WorldInfo _WorldInfo) {
-
-    bool IsInside = false;
-    Simulator::Geometries::GeometryCollection* GeometryCollection = &_Sim->Collection;
-    if (GeometryCollection->IsSphere(_ShapeID)) {
-        Simulator::Geometries::Sphere& ThisSphere = GeometryCollection->GetSphere(_ShapeID);
-        IsInside = ThisSphere.IsInsideRegion(_Region, _WorldInfo);
-    }
-    else if (GeometryCollection->IsBox(_ShapeID)) {
-        Simulator::Geometries::Box& ThisBox = GeometryCollection->GetBox(_ShapeID); 
-        IsInside = ThisBox.IsInsideRegion(_Region, _WorldInfo);
-    }
-    else if (GeometryCollection->IsCylinder(_ShapeID)) {
-        Simulator::Geometries::Cylinder& ThisCylinder = GeometryCollection->GetCylinder(_ShapeID);
-        IsInside = ThisCylinder.IsInsideRegion(_Region, _WorldInfo);
-    }
-
-    return IsInside;
-
-}
-
 bool CaCreateVoxelArrayFromSimulation(BG::Common::Logger::LoggingSystem* _Logger, Simulator::Simulation* _Sim, CaMicroscopeParameters* _Params, VoxelArray* _Array, Simulator::ScanRegion _Region, VoxelArrayGenerator::ArrayGeneratorPool* _GeneratorPool) {
     assert(_Array != nullptr);
     assert(_Params != nullptr);
@@ -79,6 +58,16 @@ bool CaCreateVoxelArrayFromSimulation(BG::Common::Logger::LoggingSystem* _Logger
     Info.WorldRotationOffsetZ_rad = _Region.SampleRotationZ_rad;
 
 
+    // Find the shapes inside the region through the collection's spatial index,
+    // rather than testing every shape's bounding box against the region
+    std::vector<size_t> ShapesInRegion;
+    _Sim->Collection.QueryRegion(RegionBoundingBox, Info, ShapesInRegion);
+    std::vector<bool> IsShapeInRegion(_Sim->Collection.Size(), false);
+    for (size_t ShapeID : ShapesInRegion) {
+        IsShapeInRegion[ShapeID] = true;
+    }
+
+
     // Build Bounding Boxes For All Compartments
     int AddedShapes = 0;
     int TotalShapes = 0;
@@ -102,7 +91,7 @@ bool CaCreateVoxelArrayFromSimulation(BG::Common::Logger::LoggingSystem* _Logger
         Task->CompartmentID_ = i; //ThisCompartment->ID;
 
         // Now submit to render queue if it's inside the region, otherwise skip it
-        if (IsShapeInsideRegion(_Sim, ShapeID, RegionBoundingBox, Info)) {
+        if (IsShapeInRegion[ShapeID]) {
             
             AddedShapes++;
 
@@ -67,6 +67,7 @@ struct CaMicroscopeParameters {
     float IndicatorInterval_ms;             /**Interval of update for the indicator in milliseconds*/
     float ImagingInterval_ms;               /**Interval at which Ca images are produced, typically on the same order as IndicatorDecayTime_ms*/
     float AttenuationPerUm;                 /** something*/
+    bool UseIncrementalIndicatorFilter = false; /**Compute Ca samples from the newest indicator inputs only instead of convolving a FIFO, same results (see Simulator::Tools::CalciumImaging)*/
 
     float BrightnessAmplification;          /**This tunes the output amplification for fluorescence imaging*/
 
@@ -65,14 +65,14 @@ bool ExecuteSubRenderOperations(Config::Config* _Config, BG::Common::Logger::Log
 
 
     // Now, calculate the maximum number of voxels in system ram
-    uint64_t MaxVoxels = uint64_t(double(getTotalSystemMemory()) * ScalingFactor) / sizeof(VoxelType);
+    uint64_t MaxVoxels = uint64_t(double(getTotalSystemMemory()) * ScalingFactor) / sizeof(CompactVoxelType);
     size_t MaxVoxelArraySizeOnAxisInRAM = std::cbrt(MaxVoxels);
 
     size_t MaxVoxelArrayAxisSize_vox = std::min(MaxVoxelSizeLimit, MaxVoxelArraySizeOnAxisInRAM);
 
 
     // Make Log Message about memory consumption figures
-    double MemorySize_MB = ((MaxVoxelArrayAxisSize_vox * MaxVoxelArrayAxisSize_vox * MaxVoxelArrayAxisSize_vox) * sizeof(VoxelType)) / 1024. / 1024;
+    double MemorySize_MB = ((MaxVoxelArrayAxisSize_vox * MaxVoxelArrayAxisSize_vox * MaxVoxelArrayAxisSize_vox) * sizeof(CompactVoxelType)) / 1024. / 1024;
     double SystemRAM_MB = double(getTotalSystemMemory()) / 1024. / 1024.; 
     std::string LogMessage = "Using Maximum Voxel Array Dimensions Of '" + std::to_string(MaxVoxelArrayAxisSize_vox) + "', This May Use Up To ~" + std::to_string(round(MemorySize_MB)) + "MiB";
     LogMessage += " (" + std::to_string(ScalingFactor*100) + "% of ~" + std::to_string(round(SystemRAM_MB)) + "MiB System Memory)";
@@ -228,6 +228,7 @@ bool ExecuteSubRenderOperations(Config::Config* _Config, BG::Common::Logger::Log
                 ThisSubRegion.MaxImagesY = ImagesPerSubRegionY;                
                 ThisSubRegion.LayerOffset = ZStep * MaxVoxelArrayAxisSize_vox;
                 ThisSubRegion.Region = ThisRegion;
+                ThisSubRegion.SparseArray = _Config->SparseVoxelArray_;
 
                 _Logger->Log("Created SubRegion At Location " + ThisRegion.ToString() + " Of Size " + ThisRegion.GetDimensionsInVoxels(Params->VoxelResolution_um), 3);
 
@@ -31,15 +31,15 @@ std::unordered_map<uint64_t, Mesh> MarchingCubes::GenerateMeshes(
             for (int z = startZ; z < endZ; ++z) {
 
                 // Get the 8 voxels forming the current cube
-                std::array<VoxelType, 8> cubeVoxels = {
-                    voxelArray->GetVoxel(x,     y,     z),     // 0
-                    voxelArray->GetVoxel(x + 1, y,     z),     // 1
-                    voxelArray->GetVoxel(x + 1, y,     z + 1), // 2
-                    voxelArray->GetVoxel(x,     y,     z + 1), // 3
-                    voxelArray->GetVoxel(x,     y + 1, z),     // 4
-                    voxelArray->GetVoxel(x + 1, y + 1, z),     // 5
-                    voxelArray->GetVoxel(x + 1, y + 1, z + 1), // 6
-                    voxelArray->GetVoxel(x,     y + 1, z + 1)  // 7
+                std::array<CompactVoxelType, 8> cubeVoxels = {
+                    voxelArray->GetCompactVoxel(x,     y,     z),     // 0
+                    voxelArray->GetCompactVoxel(x + 1, y,     z),     // 1
+                    voxelArray->GetCompactVoxel(x + 1, y,     z + 1), // 2
+                    voxelArray->GetCompactVoxel(x,     y,     z + 1), // 3
+                    voxelArray->GetCompactVoxel(x,     y + 1, z),     // 4
+                    voxelArray->GetCompactVoxel(x + 1, y + 1, z),     // 5
+                    voxelArray->GetCompactVoxel(x + 1, y + 1, z + 1), // 6
+                    voxelArray->GetCompactVoxel(x,     y + 1, z + 1)  // 7
                 };
 
                 // Determine the cube index
@@ -96,7 +96,7 @@ std::unordered_map<uint64_t, Mesh> MarchingCubes::GenerateMeshes(
                     );
 
                     // Determine the ParentUID for this triangle
-                    uint64_t parentUID = cubeVoxels[0].ParentUID; // Use the first voxel's ParentUID
+                    uint64_t parentUID = voxelArray->GetParentUID(cubeVoxels[0].PaletteIndex_); // Use the first voxel's ParentUID
 
                     // Add the triangle to the corresponding mesh
                     Mesh& mesh = neuronMeshes[parentUID];
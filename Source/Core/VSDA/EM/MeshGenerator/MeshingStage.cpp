@@ -41,7 +41,7 @@ void MeshingStage::Process() {
                     for (int cy = y; cy < endY; ++cy) {
                         for (int cx = x; cx < endX; ++cx) {
                             // Convert voxel data to MC's scalar field format
-                            const auto& voxel = voxelArray->GetVoxel(cx, cy, cz);
+                            const CompactVoxelType voxel = voxelArray->GetCompactVoxel(cx, cy, cz);
                             const int idx = (cz - z) * chunkNY * chunkNX + (cy - y) * chunkNX + (cx - x);
                             scalarField[idx] = voxel.DistanceToEdge_vox_ - isolevel; // Adjust sign as needed
                         }
@@ -87,6 +87,10 @@ void ArrayGeneratorPool::RendererThreadMainFunction(int _ThreadNumber) {
                 FillWedge(Array, &ThisTask->ThisWedge, ThisTask->WorldInfo_, ThisTask->Parameters_, &PerlinGenerator);
                 ShapeName = "Wedge";
             } else if (ThisTask->CustomShape_ == CUSTOM_NONE) {
+                if (!ThisTask->Baked_) {
+                    ThisTask->Baked_ = GeometryCollection->GetBaked(ThisTask->WorldInfo_);
+                }
+                const Geometries::BakedGeometry& Baked = *ThisTask->Baked_;
                 if (GeometryCollection->IsSphere(ShapeID)) {
                     Geometries::Sphere & ThisSphere = GeometryCollection->GetSphere(ShapeID);
                     ShapeInfo += "Radius: " + std::to_string(ThisSphere.Radius_um);
@@ -94,27 +98,26 @@ void ArrayGeneratorPool::RendererThreadMainFunction(int _ThreadNumber) {
                     ShapeInfo += ", Y: " + std::to_string(ThisSphere.Center_um.y);
                     ShapeInfo += ", Z: " + std::to_string(ThisSphere.Center_um.z);
                     ShapeName = "Sphere";
-                    FillSpherePart(1, 0, Array, &ThisSphere, ThisTask->WorldInfo_, ThisTask->Parameters_, &PerlinGenerator);
+                    FillSpherePart(1, 0, Array, Baked.GetSphere(ShapeID), ThisSphere.ParentID, ThisTask->WorldInfo_, ThisTask->Parameters_, &PerlinGenerator);
                 }
                 else if (GeometryCollection->IsBox(ShapeID)) {
                     Geometries::Box & ThisBox = GeometryCollection->GetBox(ShapeID); 
                     ShapeName = "Box";
-                    FillBox(Array, &ThisBox, ThisTask->WorldInfo_, ThisTask->Parameters_, &PerlinGenerator);
+                    FillBox(Array, Baked.GetBox(ShapeID), ThisBox.ParentID, ThisTask->WorldInfo_, ThisTask->Parameters_, &PerlinGenerator);
                 }
                 else if (GeometryCollection->IsCylinder(ShapeID)) {
                     Geometries::Cylinder & ThisCylinder = GeometryCollection->GetCylinder(ShapeID);
                     ShapeName = "Cylinder";
-                    //FillCylinder(Array, &ThisCylinder, ThisTask->WorldInfo_, ThisTask->Parameters_, &PerlinGenerator);
-                    FillCylinderPart(1, 0, Array, &ThisCylinder, ThisTask->WorldInfo_, ThisTask->Parameters_, &PerlinGenerator);
+                    FillCylinderPart(1, 0, Array, Baked.GetCylinder(ShapeID), ThisCylinder.ParentID, ThisTask->WorldInfo_, ThisTask->Parameters_, &PerlinGenerator);
                 }
             } else {
 
                 if (ThisTask->CustomShape_ == CUSTOM_CYLINDER) {
                     ShapeName = "CylinderPart";
-                    FillCylinderPart(ThisTask->CustomTotalComponents, ThisTask->CustomThisComponent, Array, &ThisTask->CustomCylinder_, ThisTask->WorldInfo_, ThisTask->Parameters_, &PerlinGenerator);
+                    FillCylinderPart(ThisTask->CustomTotalComponents, ThisTask->CustomThisComponent, Array, ThisTask->CustomCylinder_, ThisTask->CustomParentID_, ThisTask->WorldInfo_, ThisTask->Parameters_, &PerlinGenerator);
                 } else if (ThisTask->CustomShape_ == CUSTOM_SPHERE) {
                     ShapeName = "SpherePart";
-                    FillSpherePart(ThisTask->CustomTotalComponents, ThisTask->CustomThisComponent, Array, &ThisTask->CustomSphere_, ThisTask->WorldInfo_, ThisTask->Parameters_, &PerlinGenerator);
+                    FillSpherePart(ThisTask->CustomTotalComponents, ThisTask->CustomThisComponent, Array, ThisTask->CustomSphere_, ThisTask->CustomParentID_, ThisTask->WorldInfo_, ThisTask->Parameters_, &PerlinGenerator);
 
                 }
             }
@@ -42,6 +42,7 @@
 
 // Internal Libraries (BG convention: use <> instead of "")
 #include <VSDA/EM/VoxelSubsystem/Structs/VoxelArray.h>
+#include <Simulator/Geometries/BakedGeometry.h>
 #include <Simulator/Geometries/GeometryCollection.h>
 #include <Simulator/Geometries/Wedge.h>
 #include <Simulator/Geometries/Cylinder.h>
@@ -80,8 +81,10 @@ struct Task {
     VoxelArray*                     Array_ = nullptr;      /**Pointer to the voxel array that we're writing to.*/
     MicroscopeParameters*           Parameters_ = nullptr; /**Pointer to instance of the microscope parameters struct, used to get info about noise params, etc.*/
     CustomShape                     CustomShape_;          /**Optionally, use a custom shape defined here instead of the one from a geometry collection*/
-    Geometries::Cylinder            CustomCylinder_;       /**Custom cylinder, used when we are subdividing shapes*/
-    Geometries::Sphere              CustomSphere_;         /**Custom sphere, used to define the sphere*/
+    Geometries::BakedCylinder       CustomCylinder_;       /**Custom cylinder in world space, used when we are subdividing shapes*/
+    Geometries::BakedSphere         CustomSphere_;         /**Custom sphere in world space, used to define the sphere*/
+    uint64_t                        CustomParentID_ = 0;   /**ParentID written for the custom shape*/
+    std::shared_ptr<const Geometries::BakedGeometry> Baked_; /**World-space records of the collection for WorldInfo_, baked on demand if not set*/
     int CustomThisComponent = 0;
     int CustomTotalComponents = 0;
 
@@ -203,10 +203,10 @@ bool EMRenderSubRegion(BG::Common::Logger::LoggingSystem* _Logger, SubRegion* _S
     // Create Voxel Array
     _Logger->Log(std::string("Creating Voxel Array Of Size ") + RequestedRegion.Dimensions() + std::string(" With Points ") + RequestedRegion.ToString(), 2);
     uint64_t TargetArraySize = RequestedRegion.GetVoxelSize(VSDAData_->Params_.VoxelResolution_um);
-    if (VSDAData_->Array_.get() == nullptr || VSDAData_->Array_->GetSize() <= TargetArraySize) {
+    if (VSDAData_->Array_.get() == nullptr || VSDAData_->Array_->GetSize() <= TargetArraySize || VSDAData_->Array_->IsSparse() != _SubRegion->SparseArray) {
         _Logger->Log("Voxel Array Does Not Exist Yet Or Is Wrong Size, (Re)Creating Now", 2);
         VSDAData_->Array_ = std::make_unique<VoxelArray>(_Logger, ScanRegion(), 99.);
-        VSDAData_->Array_ = std::make_unique<VoxelArray>(_Logger, RequestedRegion, VSDAData_->Params_.VoxelResolution_um);
+        VSDAData_->Array_ = std::make_unique<VoxelArray>(_Logger, RequestedRegion, VSDAData_->Params_.VoxelResolution_um, _SubRegion->SparseArray);
     } else {
         _Logger->Log("Reusing Existing Voxel Array, Clearing Data", 2);
         bool Status = VSDAData_->Array_->SetSize(RequestedRegion, VSDAData_->Params_.VoxelResolution_um);
@@ -231,6 +231,13 @@ bool EMRenderSubRegion(BG::Common::Logger::LoggingSystem* _Logger, SubRegion* _S
 
     CreateVoxelArrayFromSimulation(_Logger, Sim, &VSDAData_->Params_, VSDAData_->Array_.get(), RequestedRegion, _GeneratorPool);
 
+    // Bricks that ended up uniform (e.g. all inside one soma) are freed again, so rendering can skip them
+    if (VSDAData_->Array_->IsSparse()) {
+        uint64_t NumCollapsed = VSDAData_->Array_->CollapseUniformBricks();
+        double ArraySize_MiB = VSDAData_->Array_->GetAllocatedBytes() / 1024. / 1024.;
+        _Logger->Log("Sparse Voxel Array Uses " + std::to_string(ArraySize_MiB) + "MiB After Freeing " + std::to_string(NumCollapsed) + " Uniform Bricks", 2);
+    }
+
 
 
     // Calculate Number Of Steps For The Z Value
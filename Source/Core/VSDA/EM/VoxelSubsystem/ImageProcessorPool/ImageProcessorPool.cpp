@@ -153,32 +153,44 @@ void ImageProcessorPool::EncoderThreadMainFunction(int _ThreadNumber) {
                     OneToOneVoxelImage.TargetFileName_ = Task->TargetFileName_;
 
                     // Now enumerate the voxel array and populate the image with the desired pixels (for the subregion we're on)
-                    for (unsigned int XVoxelIndex = Task->VoxelStartingX; XVoxelIndex < Task->VoxelEndingX; XVoxelIndex++) {
-                        for (unsigned int YVoxelIndex = Task->VoxelStartingY; YVoxelIndex < Task->VoxelEndingY; YVoxelIndex++) {
+                    // This is done one brick at a time, so that uniform bricks of sparse arrays are not looked up voxel by voxel
+                    for (unsigned int BrickStartX = Task->VoxelStartingX; BrickStartX < Task->VoxelEndingX; BrickStartX = GetNextBrickStart(BrickStartX)) {
+                        for (unsigned int BrickStartY = Task->VoxelStartingY; BrickStartY < Task->VoxelEndingY; BrickStartY = GetNextBrickStart(BrickStartY)) {
+
+                            CompactVoxelType BrickValue;
+                            bool IsBrickUniform = Task->Array_->GetUniformBrick(BrickStartX, BrickStartY, Task->VoxelZ, &BrickValue);
+                            unsigned int BrickEndX = std::min((unsigned int)Task->VoxelEndingX, GetNextBrickStart(BrickStartX));
+                            unsigned int BrickEndY = std::min((unsigned int)Task->VoxelEndingY, GetNextBrickStart(BrickStartY));
+
+                            for (unsigned int XVoxelIndex = BrickStartX; XVoxelIndex < BrickEndX; XVoxelIndex++) {
+                                for (unsigned int YVoxelIndex = BrickStartY; YVoxelIndex < BrickEndY; YVoxelIndex++) {
 
                         
-                            // Enumerate Depth, Compose based on rules defined above
-                            VoxelType PresentingVoxel = Task->Array_->GetVoxel(XVoxelIndex, YVoxelIndex, Task->VoxelZ);
+                                    // Enumerate Depth, Compose based on rules defined above
+                                    CompactVoxelType PresentingVoxel = IsBrickUniform ? BrickValue : Task->Array_->GetCompactVoxel(XVoxelIndex, YVoxelIndex, Task->VoxelZ);
         
 
-                            // Calculate Pixel Index
-                            int ThisPixelX = XVoxelIndex - Task->VoxelStartingX;
-                            int ThisPixelY = YVoxelIndex - Task->VoxelStartingY;
+                                    // Calculate Pixel Index
+                                    int ThisPixelX = XVoxelIndex - Task->VoxelStartingX;
+                                    int ThisPixelY = YVoxelIndex - Task->VoxelStartingY;
 
-                            uint64_t Seed = PresentingVoxel.ParentUID;
-                            unsigned int R = (Seed * 9301 + 49297) % 256;
-                            unsigned int G = (Seed * 8303 + 49299) % 256;
-                            unsigned int B = (Seed * 7307 + 49303) % 256;
+                                    uint64_t Seed = Task->Array_->GetParentUID(PresentingVoxel.PaletteIndex_);
+                                    unsigned int R = (Seed * 9301 + 49297) % 256;
+                                    unsigned int G = (Seed * 8303 + 49299) % 256;
+                                    unsigned int B = (Seed * 7307 + 49303) % 256;
 
-                            if ((Seed == 0) || (PresentingVoxel.State_ == VoxelState_EMPTY) || (PresentingVoxel.State_ == VoxelState_OUT_OF_BOUNDS)) {
-                                R = 0;
-                                G = 0;
-                                B = 0;
-                            }
+                                    if ((Seed == 0) || (PresentingVoxel.State_ == VoxelState_EMPTY) || (PresentingVoxel.State_ == VoxelState_OUT_OF_BOUNDS)) {
+                                        R = 0;
+                                        G = 0;
+                                        B = 0;
+                                    }
 
-                            OneToOneVoxelImage.SetPixel(ThisPixelX, ThisPixelY, R, G, B);
+                                    OneToOneVoxelImage.SetPixel(ThisPixelX, ThisPixelY, R, G, B);
                                 
 
+                                }
+                            }
+
                         }
                     }
 
@@ -226,64 +238,86 @@ void ImageProcessorPool::EncoderThreadMainFunction(int _ThreadNumber) {
             OneToOneVoxelImage.TargetFileName_ = Task->TargetFileName_;
 
             // Now enumerate the voxel array and populate the image with the desired pixels (for the subregion we're on)
+            // This is done one brick at a time, so that uniform bricks of sparse arrays are not looked up voxel by voxel
             bool IsImageEmpty = true;
-            for (unsigned int XVoxelIndex = Task->VoxelStartingX; XVoxelIndex < Task->VoxelEndingX; XVoxelIndex++) {
-                for (unsigned int YVoxelIndex = Task->VoxelStartingY; YVoxelIndex < Task->VoxelEndingY; YVoxelIndex++) {
-
-                    // -- Compositor Rules -- //
-                    // In order for us to have some way that the system can repeatibly handle information, we define these rules
-                    // They specify what will show up from a multilayer voxel array
-                    // Firstly, we render from bottom to top - that is, from a lower Z height to a higher Z Height.
-                    // Any debug colors (from bottom to top, whichever is encountered earlier), will overwrite any color in the pixels
-                    // This will also terminate the continuation of enumerating up the Z height
-                    // Other than those enums, we will pick the darkest color currently <--- NO WE DON'T WE JUST PICK THE TOP ONE!
-                    // This isn't super realistic and needs to be fixed later, (such as with a focal distance, and blurring), but it works for now
-
-
-                    // Enumerate Depth, Compose based on rules defined above
-                    VoxelType PresentingVoxel = Task->Array_->GetVoxel(XVoxelIndex, YVoxelIndex, Task->VoxelZ);
-
-                    // Calculate Pixel Index
-                    int ThisPixelX = XVoxelIndex - Task->VoxelStartingX;
-                    int ThisPixelY = YVoxelIndex - Task->VoxelStartingY;
-
-                    // Calculate Color To Be Set
-                    if (PresentingVoxel.State_ == VoxelState_BLACK) {
-                        OneToOneVoxelImage.SetPixel(ThisPixelX, ThisPixelY, 0);
-                        IsImageEmpty = false;
-                        continue;
-                    } else if (PresentingVoxel.State_ == VoxelState_WHITE) {
-                        OneToOneVoxelImage.SetPixel(ThisPixelX, ThisPixelY, 255);
-                        IsImageEmpty = false;
+            for (unsigned int BrickStartX = Task->VoxelStartingX; BrickStartX < Task->VoxelEndingX; BrickStartX = GetNextBrickStart(BrickStartX)) {
+                for (unsigned int BrickStartY = Task->VoxelStartingY; BrickStartY < Task->VoxelEndingY; BrickStartY = GetNextBrickStart(BrickStartY)) {
+
+                    CompactVoxelType BrickValue;
+                    bool IsBrickUniform = Task->Array_->GetUniformBrick(BrickStartX, BrickStartY, Task->VoxelZ, &BrickValue);
+                    unsigned int BrickEndX = std::min((unsigned int)Task->VoxelEndingX, GetNextBrickStart(BrickStartX));
+                    unsigned int BrickEndY = std::min((unsigned int)Task->VoxelEndingY, GetNextBrickStart(BrickStartY));
+
+                    // Empty bricks only hold background, so there is nothing to look up or compose
+                    if (IsBrickUniform && (BrickValue.State_ == VoxelState_EMPTY)) {
+                        for (unsigned int XVoxelIndex = BrickStartX; XVoxelIndex < BrickEndX; XVoxelIndex++) {
+                            for (unsigned int YVoxelIndex = BrickStartY; YVoxelIndex < BrickEndY; YVoxelIndex++) {
+                                OneToOneVoxelImage.SetPixel(XVoxelIndex - Task->VoxelStartingX, YVoxelIndex - Task->VoxelStartingY, 240); // <-- THAT IS THE DEFAULT IMAGE COLOR, SHOULD BE CONFIGURABLE
+                            }
+                        }
                         continue;
-                    } else if (PresentingVoxel.State_ == VoxelState_EMPTY) {
-                        OneToOneVoxelImage.SetPixel(ThisPixelX, ThisPixelY, 240); // <-- THAT IS THE DEFAULT IMAGE COLOR, SHOULD BE CONFIGURABLE
-                        continue;                    
-                    } else if (PresentingVoxel.State_ == VoxelState_OUT_OF_BOUNDS) {
-                        OneToOneVoxelImage.SetPixel(ThisPixelX, ThisPixelY, 0); // Force out of bounds color to be black.
-                        continue;                    
-                    } 
-
-                    // If we've gotten this far, the voxel must be inside something
-                    // then we set the color based on the perlin noise, and distance to edge
-                    uint8_t Intensity;
-                    if (Task->Params_->GeneratePerlinNoise_) {
-                        float X = Task->Array_->GetXPositionAtIndex(XVoxelIndex);
-                        float Y = Task->Array_->GetYPositionAtIndex(YVoxelIndex);
-                        float Z = Task->Array_->GetZPositionAtIndex(Task->VoxelZ);
-                        Intensity = GenerateVoxelColor(X, Y, Z, Task->Params_, Task->Generator_);
-                    } else {
-                        Intensity = Task->Params_->DefaultIntensity_;
                     }
 
-                    if (Task->Params_->RenderBorders) {
-                        Intensity = CalculateBorderColor(Intensity, PresentingVoxel.DistanceToEdge_vox_, Task->Params_);
-                    }
+                    for (unsigned int XVoxelIndex = BrickStartX; XVoxelIndex < BrickEndX; XVoxelIndex++) {
+                        for (unsigned int YVoxelIndex = BrickStartY; YVoxelIndex < BrickEndY; YVoxelIndex++) {
+
+                            // -- Compositor Rules -- //
+                            // In order for us to have some way that the system can repeatibly handle information, we define these rules
+                            // They specify what will show up from a multilayer voxel array
+                            // Firstly, we render from bottom to top - that is, from a lower Z height to a higher Z Height.
+                            // Any debug colors (from bottom to top, whichever is encountered earlier), will overwrite any color in the pixels
+                            // This will also terminate the continuation of enumerating up the Z height
+                            // Other than those enums, we will pick the darkest color currently <--- NO WE DON'T WE JUST PICK THE TOP ONE!
+                            // This isn't super realistic and needs to be fixed later, (such as with a focal distance, and blurring), but it works for now
 
-                    OneToOneVoxelImage.SetPixel(ThisPixelX, ThisPixelY, Intensity);
-                    IsImageEmpty = false;
+
+                            // Enumerate Depth, Compose based on rules defined above
+                            CompactVoxelType PresentingVoxel = IsBrickUniform ? BrickValue : Task->Array_->GetCompactVoxel(XVoxelIndex, YVoxelIndex, Task->VoxelZ);
+
+                            // Calculate Pixel Index
+                            int ThisPixelX = XVoxelIndex - Task->VoxelStartingX;
+                            int ThisPixelY = YVoxelIndex - Task->VoxelStartingY;
+
+                            // Calculate Color To Be Set
+                            if (PresentingVoxel.State_ == VoxelState_BLACK) {
+                                OneToOneVoxelImage.SetPixel(ThisPixelX, ThisPixelY, 0);
+                                IsImageEmpty = false;
+                                continue;
+                            } else if (PresentingVoxel.State_ == VoxelState_WHITE) {
+                                OneToOneVoxelImage.SetPixel(ThisPixelX, ThisPixelY, 255);
+                                IsImageEmpty = false;
+                                continue;
+                            } else if (PresentingVoxel.State_ == VoxelState_EMPTY) {
+                                OneToOneVoxelImage.SetPixel(ThisPixelX, ThisPixelY, 240); // <-- THAT IS THE DEFAULT IMAGE COLOR, SHOULD BE CONFIGURABLE
+                                continue;                    
+                            } else if (PresentingVoxel.State_ == VoxelState_OUT_OF_BOUNDS) {
+                                OneToOneVoxelImage.SetPixel(ThisPixelX, ThisPixelY, 0); // Force out of bounds color to be black.
+                                continue;                    
+                            } 
+
+                            // If we've gotten this far, the voxel must be inside something
+                            // then we set the color based on the perlin noise, and distance to edge
+                            uint8_t Intensity;
+                            if (Task->Params_->GeneratePerlinNoise_) {
+                                float X = Task->Array_->GetXPositionAtIndex(XVoxelIndex);
+                                float Y = Task->Array_->GetYPositionAtIndex(YVoxelIndex);
+                                float Z = Task->Array_->GetZPositionAtIndex(Task->VoxelZ);
+                                Intensity = GenerateVoxelColor(X, Y, Z, Task->Params_, Task->Generator_);
+                            } else {
+                                Intensity = Task->Params_->DefaultIntensity_;
+                            }
+
+                            if (Task->Params_->RenderBorders) {
+                                Intensity = CalculateBorderColor(Intensity, PresentingVoxel.DistanceToEdge_vox_, Task->Params_);
+                            }
+
+                            OneToOneVoxelImage.SetPixel(ThisPixelX, ThisPixelY, Intensity);
+                            IsImageEmpty = false;
                         
 
+                        }
+                    }
+
                 }
             }
 
@@ -56,16 +56,33 @@ void SegmentationCompressor::CompressSegmentationRegion(VoxelArray& _Array, uint
     uint64_t ZStride = Channels;
     uint64_t ChannelStride = 1;
 
-    // Populate data (assuming channel=0)
-    for (uint64_t X = _StartX; X < _EndX; X++) {
-        for (uint64_t Y = _StartY; Y < _EndY; Y++) {
-            for (uint64_t Z = _StartZ; Z < _EndZ; Z++) {
-                uint64_t index = (X - _StartX) * XStride + (Y - _StartY) * YStride + (Z - _StartZ) * ZStride + 0 * ChannelStride; // Channel index 0
-                VoxelType Vox = _Array.GetVoxel(X, Y, Z);
-                if (Vox.State_ != VoxelState_EMPTY) {
-                    SegMapData[index] = Vox.ParentUID;
-                } else {
-                    SegMapData[index] = 0;
+    // Populate data (assuming channel=0), one brick at a time so that uniform bricks of sparse arrays are filled without lookups
+    for (uint64_t BrickX = _StartX; BrickX < _EndX; BrickX = GetNextBrickStart(BrickX)) {
+        for (uint64_t BrickY = _StartY; BrickY < _EndY; BrickY = GetNextBrickStart(BrickY)) {
+            for (uint64_t BrickZ = _StartZ; BrickZ < _EndZ; BrickZ = GetNextBrickStart(BrickZ)) {
+                uint64_t BrickEndX = std::min(_EndX, (uint64_t)GetNextBrickStart(BrickX));
+                uint64_t BrickEndY = std::min(_EndY, (uint64_t)GetNextBrickStart(BrickY));
+                uint64_t BrickEndZ = std::min(_EndZ, (uint64_t)GetNextBrickStart(BrickZ));
+
+                // The values start out as 0, so empty bricks are already done
+                CompactVoxelType BrickValue;
+                bool IsBrickUniform = _Array.GetUniformBrick(BrickX, BrickY, BrickZ, &BrickValue);
+                if (IsBrickUniform && (BrickValue.State_ == VoxelState_EMPTY)) {
+                    continue;
+                }
+
+                for (uint64_t X = BrickX; X < BrickEndX; X++) {
+                    for (uint64_t Y = BrickY; Y < BrickEndY; Y++) {
+                        for (uint64_t Z = BrickZ; Z < BrickEndZ; Z++) {
+                            uint64_t index = (X - _StartX) * XStride + (Y - _StartY) * YStride + (Z - _StartZ) * ZStride + 0 * ChannelStride; // Channel index 0
+                            CompactVoxelType Vox = IsBrickUniform ? BrickValue : _Array.GetCompactVoxel(X, Y, Z);
+                            if (Vox.State_ != VoxelState_EMPTY) {
+                                SegMapData[index] = _Array.GetParentUID(Vox.PaletteIndex_);
+                            } else {
+                                SegMapData[index] = 0;
+                            }
+                        }
+                    }
                 }
             }
         }
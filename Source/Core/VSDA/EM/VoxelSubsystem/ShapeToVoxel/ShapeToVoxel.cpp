@@ -109,21 +109,28 @@ Geometries::Vec3D RotatedVec(float _X, float _Y, float _Z, float _RY, float _RZ,
 // }
 
 
-bool FillSpherePart(int _TotalThreads, int _ThisThread, VoxelArray* _Array, Geometries::Sphere*_Shape, VSDA::WorldInfo& _WorldInfo, MicroscopeParameters* _Params, noise::module::Perlin* _Generator) {
+bool FillSpherePart(int _TotalThreads, int _ThisThread, VoxelArray* _Array, const Geometries::BakedSphere& _Sphere, uint64_t _ParentID, VSDA::WorldInfo& _WorldInfo, MicroscopeParameters* _Params, noise::module::Perlin* _Generator) {
     assert(_WorldInfo.VoxelScale_um != 0); // Will get stuck in infinite loop
     assert(_Params != nullptr);
     assert(_Generator != nullptr);
 
 
-    BoundingBox BB = _Shape->GetBoundingBox(_WorldInfo);
+    // The center is already rotated into the world, so each voxel only needs its squared distance to it.
+    const BoundingBox& BB = _Sphere.BB;
+    float Radius2_um2 = _Sphere.Radius_um * _Sphere.Radius_um;
+    uint32_t PaletteIndex = _Array->GetPaletteIndex(_ParentID);
 
     for (float X = BB.bb_point1[0] + (_ThisThread * _WorldInfo.VoxelScale_um); X < BB.bb_point2[0]; X+= (_TotalThreads * _WorldInfo.VoxelScale_um)) {
+        float DX = X - _Sphere.Center_um.x;
         for (float Y = BB.bb_point1[1]; Y < BB.bb_point2[1]; Y+= _WorldInfo.VoxelScale_um) {
+            float DY = Y - _Sphere.Center_um.y;
             for (float Z = BB.bb_point1[2]; Z < BB.bb_point2[2]; Z+= _WorldInfo.VoxelScale_um) {
-                if (_Shape->IsPointInShape(Geometries::Vec3D(X, Y, Z), _WorldInfo)) {
+                float DZ = Z - _Sphere.Center_um.z;
+                float Distance2_um2 = DX*DX + DY*DY + DZ*DZ;
+                if (Distance2_um2 <= Radius2_um2) {
 
-                    float DistanceToEdge = _Shape->Radius_um - Geometries::Vec3D(X, Y, Z).Distance(_Shape->Center_um);
-                    _Array->CompositeVoxel(X, Y, Z, VoxelState_INTERIOR, DistanceToEdge, _Shape->ParentID);
+                    float DistanceToEdge = _Sphere.Radius_um - std::sqrt(Distance2_um2);
+                    _Array->CompositeVoxel(X, Y, Z, VoxelState_INTERIOR, DistanceToEdge, PaletteIndex);
 
                 }
             }
@@ -134,117 +141,41 @@ bool FillSpherePart(int _TotalThreads, int _ThisThread, VoxelArray* _Array, Geom
 
 }
 
-int isPointInCylinder(const Geometries::Vec3D& P1, const Geometries::Vec3D& P2, double r1, double r2, const Geometries::Vec3D& point) {
-	// Vector from P1 to P2
-	Geometries::Vec3D axis = P2 - P1;
-	double height = axis.Magnitude();
-	Geometries::Vec3D axisDir = axis.Normalize();
-    
-	// Vector from P1 to the point
-	Geometries::Vec3D pointVector = point - P1;
-    
-	// Projection of pointVector onto the axis
-	double projectionLength = pointVector.Dot(axisDir);
-    
-	// Check if the point is within the bounds along the axis
-	if (projectionLength < 0) {
-        return 1;
-    }
-    if (projectionLength > height) {
-        return 2;
-    	//return false;
-	}
-
-	// Calculate the radius at the projection point along the cylinder's height
-	double currentRadius = r1 + (r2 - r1) * (projectionLength / height);
-
-	// Closest point on the axis to the given point
-	Geometries::Vec3D closestPointOnAxis = P1 + axisDir * projectionLength;
-
-	// Distance from the point to the closest point on the axis
-	double distanceToAxis = (point - closestPointOnAxis).Magnitude();
-    
-	// Check if the distance is within the current radius
-	//return distanceToAxis <= currentRadius;
-    if (distanceToAxis <= currentRadius) {
-        return 0;
-    }
-    return 3;
-}
-
-bool FillCylinderPart(int _TotalThreads, int _ThisThread, VoxelArray* _Array, Geometries::Cylinder* _Cylinder, VSDA::WorldInfo& _WorldInfo, MicroscopeParameters* _Params, noise::module::Perlin* _Generator) {
+bool FillCylinderPart(int _TotalThreads, int _ThisThread, VoxelArray* _Array, const Geometries::BakedCylinder& _Cylinder, uint64_t _ParentID, VSDA::WorldInfo& _WorldInfo, MicroscopeParameters* _Params, noise::module::Perlin* _Generator) {
     assert(_Array != nullptr);
     assert(_WorldInfo.VoxelScale_um != 0); // Will get stuck in infinite loop
 
-    // Rotate The Endpoints Around World Origin By Amount Set In World Info
-    //   This deals with the rotation of the whole model
-    Geometries::Vec3D RotatedEnd0 = _Cylinder->End0Pos_um.rotate_around_xyz(_WorldInfo.WorldRotationOffsetX_rad, _WorldInfo.WorldRotationOffsetY_rad, _WorldInfo.WorldRotationOffsetZ_rad);
-    Geometries::Vec3D RotatedEnd1 = _Cylinder->End1Pos_um.rotate_around_xyz(_WorldInfo.WorldRotationOffsetX_rad, _WorldInfo.WorldRotationOffsetY_rad, _WorldInfo.WorldRotationOffsetZ_rad);
-
-    // Get rotation angles and length (r, theta, phi).
-    //   Moving the midline of the cylinder to (0,0,0) then switching to spherical coords
-    //   allows us to find angles to rotate around Y and Z axes.
-    Geometries::Vec3D diff = RotatedEnd1 - RotatedEnd0;
-    Geometries::Vec3D diff_spherical_coords = diff.cartesianToSpherical();
-    float rot_y = diff_spherical_coords.theta();
-    float rot_z = diff_spherical_coords.phi();
-
-    float cyl_length = diff_spherical_coords.r();
-
-    // Use this to know the extent to which to gradually change the radius as you move along the length of the cylinder.
-    float radius_difference = _Cylinder->End1Radius_um - _Cylinder->End0Radius_um;
-    float midpoint_radius_um = _Cylinder->End0Radius_um + (0.5*radius_difference);
-
-    // Stepping at half voxel size ensures finding voxels without gaps.
-    float stepsize = 0.5*_WorldInfo.VoxelScale_um;
-
-    Geometries::Vec3D spherical_halfdist_v(cyl_length/2.0, rot_y, rot_z); // mid point vector (from 0,0,0)
-    Geometries::Vec3D cartesian_halfdist_v = spherical_halfdist_v.sphericalToCartesian();
-    Geometries::Vec3D translate = RotatedEnd0 + cartesian_halfdist_v; // actual mid point
-
-    //for (float X = BB.bb_point1[0] + (_ThisThread * _WorldInfo.VoxelScale_um); X < BB.bb_point2[0]; X+= (_TotalThreads * _WorldInfo.VoxelScale_um)) {
-
-    // Calculate all the points and stuff them into the array
-    for (float z = -0.5*cyl_length; z <= 0.5*cyl_length; z += stepsize) {
-        // 2. At each step, get points in a disk around the axis at the right radius.
-        float d_ratio = z / cyl_length; // This goes from -0.5 to 0.5 as we move along the length of the cylinder.
-        float radius_at_z = midpoint_radius_um + d_ratio*radius_difference; // Radius at this position on the axis.
-
-        // Next disc center point along cylinder midline.
-        Geometries::Vec3D RotatedPoint = RotatedVec(0.0, 0.0, z, rot_y, rot_z, translate);
-
-        // Set voxel for midline point.
-        // VoxelType FinalVoxelValue = GenerateVoxelColor(RotatedPoint.x, RotatedPoint.y, RotatedPoint.z, _Params, _Generator);
-        // _Array->SetVoxelIfNotDarker(RotatedPoint.x, RotatedPoint.y, RotatedPoint.z, FinalVoxelValue);
-        float DistanceToEdge = radius_at_z;
-        _Array->CompositeVoxel(RotatedPoint.x, RotatedPoint.y, RotatedPoint.z, VoxelState_INTERIOR, DistanceToEdge, _Cylinder->ParentID);
-
-        // Find points on circles around the midline up to the radius at this point along the cylinder.
-        for (float r = stepsize + (_ThisThread * stepsize); r <= radius_at_z; r += (_TotalThreads * stepsize)) {
-            // Circumpherence is 2*pi*r, number of voxels that fit along the circumpherence is 2*pi*r/stepsize.
-            // So, in a whole 2*pi rotation, for each step the angle change is 2*pi/(2*pi*r/stepsize) = stepsize/r.
-            float radians_per_step = stepsize / r;
-            for (float theta = 0; theta < 2.0*M_PI; theta += radians_per_step) {
-
-                // Next point on circumpherence at radius r.
-                float y = r*std::cos(theta);
-                float x = r*std::sin(theta);
-                Geometries::Vec3D RotatedPoint = RotatedVec(x, y, z, rot_y, rot_z, translate);
-
-                float DistanceToEdge = radius_at_z - r;
-                _Array->CompositeVoxel(RotatedPoint.x, RotatedPoint.y, RotatedPoint.z, VoxelState_INTERIOR, DistanceToEdge, _Cylinder->ParentID);
-
-
-                // // Set voxel at the point.
-                // VoxelType FinalVoxelValue = GenerateVoxelColor(RotatedPoint.x, RotatedPoint.y, RotatedPoint.z, _Params, _Generator);
-                // if (_Params->RenderBorders) {
-                //     float DistanceToEdge = radius_at_z - r;
-                //     FinalVoxelValue = CalculateBorderColor(FinalVoxelValue, DistanceToEdge, _Params);
-                // }
-                // _Array->SetVoxelIfNotDarker(RotatedPoint.x, RotatedPoint.y, RotatedPoint.z, FinalVoxelValue);
-            }
+    // Voxel centers of the array, the rasterizer fills every one inside the frustum
+    BoundingBox ArrayBB = _Array->GetBoundingBox();
+    Geometries::VoxelGrid Grid;
+    Grid.Origin_um = Geometries::Vec3D(ArrayBB.bb_point1[0], ArrayBB.bb_point1[1], ArrayBB.bb_point1[2]);
+    Grid.VoxelScale_um = _Array->GetResolution();
+    Grid.Size[0] = _Array->GetX();
+    Grid.Size[1] = _Array->GetY();
+    Grid.Size[2] = _Array->GetZ();
+    uint32_t PaletteIndex = _Array->GetPaletteIndex(_ParentID);
+
+    Geometries::RasterizeFrustum(_Cylinder, Grid, _TotalThreads, _ThisThread, [&](int _X, int _Y, int _ZBegin, int _ZEnd) {
+        Geometries::Vec3D Point = Grid.Origin_um + Geometries::Vec3D(_X, _Y, _ZBegin) * Grid.VoxelScale_um;
+        for (int Z = _ZBegin; Z < _ZEnd; Z++) {
+            float DistanceToEdge = Geometries::GetFrustumDistanceToEdge(_Cylinder, Point);
+            _Array->CompositeVoxelAtIndex(_X, _Y, Z, VoxelState_INTERIOR, DistanceToEdge, PaletteIndex);
+            Point.z += Grid.VoxelScale_um;
+        }
+    });
+
+    // Dendrites thinner than a voxel may not contain any voxel center, so the
+    // midline is still traced voxel by voxel to keep them connected.
+    if (_ThisThread == 0) {
+        float cyl_length = _Cylinder.Length_um;
+        float radius_difference = _Cylinder.End1Radius_um - _Cylinder.End0Radius_um;
+        float stepsize = 0.5*_WorldInfo.VoxelScale_um;
+        for (float z = 0.0; z <= cyl_length; z += stepsize) {
+            float d_ratio = (cyl_length > 0.0) ? (z / cyl_length) : 0.0;
+            float radius_at_z = _Cylinder.End0Radius_um + d_ratio*radius_difference;
+            Geometries::Vec3D MidlinePoint = _Cylinder.End0_um + _Cylinder.AxisFrame[2] * z;
+            _Array->CompositeVoxel(MidlinePoint.x, MidlinePoint.y, MidlinePoint.z, VoxelState_INTERIOR, radius_at_z, PaletteIndex);
         }
-
     }
 
     return true;
@@ -391,7 +322,7 @@ bool FillWedge(VoxelArray* _Array, Geometries::Wedge* _Wedge, VSDA::WorldInfo& _
 
         // Set voxel for midline point.
         // VoxelType FinalVoxelValue = GenerateVoxelColor(RotatedPoint.x, RotatedPoint.y, RotatedPoint.z, _Params, _Generator);
-        VoxelType FinalVoxelValue; //GenerateVoxelColor(RotatedPoint.x, RotatedPoint.y, RotatedPoint.z, _Params, _Generator);
+        VoxelType FinalVoxelValue{}; //GenerateVoxelColor(RotatedPoint.x, RotatedPoint.y, RotatedPoint.z, _Params, _Generator);
         // FinalVoxelValue.Intensity_ = 0;
         FinalVoxelValue.State_ = VoxelState_BLACK;
         _Array->SetVoxelAtPosition(RotatedPoint.x, RotatedPoint.y, RotatedPoint.z, FinalVoxelValue);
@@ -405,7 +336,7 @@ bool FillWedge(VoxelArray* _Array, Geometries::Wedge* _Wedge, VSDA::WorldInfo& _
                 Geometries::Vec3D RotatedPoint = RotatedVec(x, y, z, rot_y, rot_z, translate);
 
                 // Set voxel at the point.
-                VoxelType FinalVoxelValue; //GenerateVoxelColor(RotatedPoint.x, RotatedPoint.y, RotatedPoint.z, _Params, _Generator);
+                VoxelType FinalVoxelValue{}; //GenerateVoxelColor(RotatedPoint.x, RotatedPoint.y, RotatedPoint.z, _Params, _Generator);
                 // FinalVoxelValue.Intensity_ = 0;
                 FinalVoxelValue.State_ = VoxelState_BLACK;
                 // if (_Params->RenderBorders) {
@@ -425,37 +356,29 @@ bool FillWedge(VoxelArray* _Array, Geometries::Wedge* _Wedge, VSDA::WorldInfo& _
 }
 
 
-bool FillBox(VoxelArray* _Array, Geometries::Box* _Box, VSDA::WorldInfo& _WorldInfo, MicroscopeParameters* _Params, noise::module::Perlin* _Generator) {
+bool FillBox(VoxelArray* _Array, const Geometries::BakedBox& _Box, uint64_t _ParentID, VSDA::WorldInfo& _WorldInfo, MicroscopeParameters* _Params, noise::module::Perlin* _Generator) {
     assert(_Array != nullptr);
-    assert(_Box != nullptr);
     assert(_WorldInfo.VoxelScale_um != 0); // Will get stuck in infinite loop
 
 
     // Now fill it (based on the algorithm in GetPointCloud)
     float stepsize = 0.5*_WorldInfo.VoxelScale_um;
 
-    float half_xlen = _Box->Dims_um.x / 2.0;
-    float half_ylen = _Box->Dims_um.y / 2.0;
-    float half_zlen = _Box->Dims_um.z / 2.0;
+    float half_xlen = _Box.HalfDims_um.x;
+    float half_ylen = _Box.HalfDims_um.y;
+    float half_zlen = _Box.HalfDims_um.z;
+    uint32_t PaletteIndex = _Array->GetPaletteIndex(_ParentID);
 
     for (float x = -half_xlen; x <= half_xlen; x += stepsize) {
+        Geometries::Vec3D RowX = _Box.Center_um + _Box.Axes[0] * x;
         for (float y = -half_ylen; y <= half_ylen; y += stepsize) {
+            Geometries::Vec3D RowXY = RowX + _Box.Axes[1] * y;
             for (float z = -half_zlen; z <= half_zlen; z += stepsize) {
 
-                // Firstly, we create and rotate the local-space points (around object center)
-                Geometries::Vec3D Point(x, y, z);
-                Point = Point.rotate_around_xyz(_Box->Rotations_rad.x, _Box->Rotations_rad.y, _Box->Rotations_rad.z);
-
-                // Now we transform and rotate around world origin
-                Point = Point + _Box->Center_um;
-                Point = Point.rotate_around_xyz(_WorldInfo.WorldRotationOffsetX_rad, _WorldInfo.WorldRotationOffsetY_rad, _WorldInfo.WorldRotationOffsetZ_rad);
-
-                // Rather than making a point cloud like before, we just write it directly into the array
-                
-                // VoxelType FinalVoxelValue = GenerateVoxelColor(Point.x, Point.y, Point.z, _Params, _Generator, -180);
-                // _Array->SetVoxelIfNotDarker(Point.x, Point.y, Point.z, FinalVoxelValue);
-
-                _Array->CompositeVoxel(x, y, z, VoxelState_BLACK, 0, _Box->ParentID);
+                // The baked axes combine the box and world rotations, so the
+                // local-space point maps straight to its world position
+                Geometries::Vec3D Point = RowXY + _Box.Axes[2] * z;
+                _Array->CompositeVoxel(Point.x, Point.y, Point.z, VoxelState_BLACK, 0, PaletteIndex);
 
             }
         }
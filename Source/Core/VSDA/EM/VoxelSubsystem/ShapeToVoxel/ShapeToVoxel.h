@@ -39,6 +39,8 @@
 
 // Internal Libraries (BG convention: use <> instead of "")
 #include <VSDA/EM/VoxelSubsystem/Structs/VoxelArray.h>
+#include <Simulator/Geometries/BakedGeometry.h>
+#include <Simulator/Geometries/FrustumRasterizer.h>
 #include <Simulator/Geometries/GeometryCollection.h>
 #include <Simulator/Geometries/Wedge.h>
 
@@ -54,40 +56,43 @@ namespace VoxelArrayGenerator {
 
 
 /**
- * @brief Rasterizes the given box struct, writes it into the voxelarray in question given the scale set.
+ * @brief Rasterizes the given baked box, writes it into the voxelarray in question given the scale set.
  * 
  * @param _Array 
- * @param _Box 
- * @param _VoxelScale 
+ * @param _Box World-space box, baked for the rotation of _WorldInfo
+ * @param _ParentID ParentID of the shape the box was baked from
+ * @param _WorldInfo 
  * @return true 
  * @return false 
  */
-bool FillBox(VoxelArray* _Array, Geometries::Box* _Box, VSDA::WorldInfo& _WorldInfo, MicroscopeParameters* _Params, noise::module::Perlin* _Generator);
+bool FillBox(VoxelArray* _Array, const Geometries::BakedBox& _Box, uint64_t _ParentID, VSDA::WorldInfo& _WorldInfo, MicroscopeParameters* _Params, noise::module::Perlin* _Generator);
 
 /**
- * @brief Rasterize the given cylinder struct, and writes it into the given voxelarray at the given scale.
+ * @brief Rasterize the given baked cylinder as a capped cone frustum, and writes it into the given voxelarray at the given scale.
+ * Fills every voxel whose center is inside the frustum, one run per voxel row, see Geometries::RasterizeFrustum().
  * 
  * @param _Array 
- * @param _Cylinder 
- * @param _VoxelScale 
+ * @param _Cylinder World-space cylinder, baked for the rotation of _WorldInfo
+ * @param _ParentID ParentID of the shape the cylinder was baked from
+ * @param _WorldInfo 
  * @return true 
  * @return false 
  */
 // bool FillCylinder(VoxelArray* _Array, Geometries::Cylinder* _Cylinder, VSDA::WorldInfo& _WorldInfo, MicroscopeParameters* _Params, noise::module::Perlin* _Generator);
-bool FillCylinderPart(int _TotalThreads, int _ThisThread, VoxelArray* _Array, Geometries::Cylinder* _Cylinder, VSDA::WorldInfo& _WorldInfo, MicroscopeParameters* _Params, noise::module::Perlin* _Generator);
+bool FillCylinderPart(int _TotalThreads, int _ThisThread, VoxelArray* _Array, const Geometries::BakedCylinder& _Cylinder, uint64_t _ParentID, VSDA::WorldInfo& _WorldInfo, MicroscopeParameters* _Params, noise::module::Perlin* _Generator);
 
 /**
- * @brief Uses a generic ispointinshape function to write an object into the voxelarray.
- * Some objects don't support this (such as boxes and cylinders).
+ * @brief Writes the baked sphere into the voxelarray, testing each voxel of its bounding box against the world-space center.
  * 
  * @param _Array 
- * @param _Shape 
- * @param _VoxelScale 
+ * @param _Sphere World-space sphere, baked for the rotation of _WorldInfo
+ * @param _ParentID ParentID of the shape the sphere was baked from
+ * @param _WorldInfo 
  * @return true 
  * @return false 
  */
 // bool FillSphere(VoxelArray* _Array, Geometries::Sphere* _Shape, VSDA::WorldInfo& _WorldInfo, MicroscopeParameters* _Params, noise::module::Perlin* _Generator);
-bool FillSpherePart(int _TotalThreads, int _ThisThread, VoxelArray* _Array, Geometries::Sphere* _Shape, VSDA::WorldInfo& _WorldInfo, MicroscopeParameters* _Params, noise::module::Perlin* _Generator);
+bool FillSpherePart(int _TotalThreads, int _ThisThread, VoxelArray* _Array, const Geometries::BakedSphere& _Sphere, uint64_t _ParentID, VSDA::WorldInfo& _WorldInfo, MicroscopeParameters* _Params, noise::module::Perlin* _Generator);
 
 //bool FillLine(VoxelArray* _Array, int P1X, int P1Y, int P1Thickness, int P2X, int P2Y, int P2Thickness, VSDA::WorldInfo& _WorldInfo, MicroscopeParameters* _Params, noise::module::Perlin* _Generator);
 bool FillWedge(VoxelArray* _Array, Geometries::Wedge* _Wedge, VSDA::WorldInfo& _WorldInfo, MicroscopeParameters* _Params, noise::module::Perlin* _Generator);
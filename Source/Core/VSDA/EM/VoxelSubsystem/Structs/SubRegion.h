@@ -74,6 +74,7 @@ struct SubRegion {
     // Working Data Params
     ScanRegion Region;                       /**Region that we're going to perform the rendering on*/
     Simulation* Sim;                         /**Simulation that we're rendering*/
+    bool SparseArray = false;                /**Store the voxel array in bricks allocated on demand*/
     // std::unique_ptr<VoxelArray> RegionArray; /**Array for this region, which we deallocate when we're done with*/
     
 
@@ -1,4 +1,5 @@
 #include <iostream>
+#include <algorithm>
 #include <cstring>
 #include <future>
 #include <cstdlib>
@@ -14,7 +15,7 @@ namespace Simulator {
 
 
 
-VoxelArray::VoxelArray(BG::Common::Logger::LoggingSystem* _Logger, BoundingBox _BB, float _VoxelScale_um) {
+VoxelArray::VoxelArray(BG::Common::Logger::LoggingSystem* _Logger, BoundingBox _BB, float _VoxelScale_um, bool _Sparse) {
     Logger_ = _Logger;
 
     // Calculate Dimensions
@@ -33,15 +34,22 @@ VoxelArray::VoxelArray(BG::Common::Logger::LoggingSystem* _Logger, BoundingBox _
 
     // Malloc array
     DataMaxLength_ = (uint64_t)SizeX_ * (uint64_t)SizeY_ * (uint64_t)SizeZ_;
-    float SizeMiB = (sizeof(VoxelType) * DataMaxLength_) / 1024. / 1024.;
+    float SizeMiB = (sizeof(CompactVoxelType) * DataMaxLength_) / 1024. / 1024.;
+    ResetPalette();
+    IsSparse_ = _Sparse;
+    if (IsSparse_) {
+        _Logger->Log("Creating Sparse Array Of Up To " + std::to_string(SizeMiB) + "MiB In System RAM", 2);
+        ResetBricks();
+        return;
+    }
     _Logger->Log("Allocating Array Of Size " + std::to_string(SizeMiB) + "MiB In System RAM", 2);
-    Data_ = std::make_unique<VoxelType[]>(DataMaxLength_);
+    Data_ = std::make_unique<CompactVoxelType[]>(DataMaxLength_);
 
     // We don't need to clear this because make unique does it for us
     // Reset the array so we don't get a bunch of crap in it
     // ClearArray();
 }
-VoxelArray::VoxelArray(BG::Common::Logger::LoggingSystem* _Logger, ScanRegion _Region, float _VoxelScale_um) {
+VoxelArray::VoxelArray(BG::Common::Logger::LoggingSystem* _Logger, ScanRegion _Region, float _VoxelScale_um, bool _Sparse) {
     Logger_ = _Logger;
 
     // Create Bounding Box From Region, Then Call Other Constructor
@@ -70,10 +78,17 @@ VoxelArray::VoxelArray(BG::Common::Logger::LoggingSystem* _Logger, ScanRegion _R
 
     // Malloc array
     DataMaxLength_ = (uint64_t)SizeX_ * (uint64_t)SizeY_ * (uint64_t)SizeZ_;
-    float SizeMiB = (sizeof(VoxelType) * DataMaxLength_) / 1024. / 1024.;
+    float SizeMiB = (sizeof(CompactVoxelType) * DataMaxLength_) / 1024. / 1024.;
+    ResetPalette();
+    IsSparse_ = _Sparse;
+    if (IsSparse_) {
+        _Logger->Log("Creating Sparse Array Of Up To " + std::to_string(SizeMiB) + "MiB In System RAM", 2);
+        ResetBricks();
+        return;
+    }
     _Logger->Log("Allocating Array Of Size " + std::to_string(SizeMiB) + "MiB In System RAM", 2);
-    VoxelType* VoxelArrayPtr = (VoxelType*)std::malloc(DataMaxLength_ * sizeof(VoxelType));
-    Data_ = std::unique_ptr<VoxelType[]>(VoxelArrayPtr);
+    CompactVoxelType* VoxelArrayPtr = (CompactVoxelType*)std::malloc(DataMaxLength_ * sizeof(CompactVoxelType));
+    Data_ = std::unique_ptr<CompactVoxelType[]>(VoxelArrayPtr);
 
     ClearArrayThreaded(std::thread::hardware_concurrency());
     // make unique already clears memory, so we're doing it twice.
@@ -85,11 +100,110 @@ VoxelArray::VoxelArray(BG::Common::Logger::LoggingSystem* _Logger, ScanRegion _R
 VoxelArray::~VoxelArray() {
 
     // delete[] Data_;
+    FreeBricks();
+    if (PaletteChunks_) {
+        for (int i = 0; i < VOXELARRAY_PALETTE_NUM_CHUNKS; i++) {
+            delete[] PaletteChunks_[i].load();
+        }
+    }
+}
+
+void VoxelArray::ResetPalette() {
+    if (!PaletteChunks_) {
+        PaletteChunks_ = std::make_unique<std::atomic<uint64_t*>[]>(VOXELARRAY_PALETTE_NUM_CHUNKS);
+        for (int i = 0; i < VOXELARRAY_PALETTE_NUM_CHUNKS; i++) {
+            PaletteChunks_[i] = nullptr;
+        }
+    }
+    PaletteIndices_.clear();
+    PaletteSize_ = 0;
+    IsPaletteFull_ = false;
+    GetPaletteIndex(0);
+}
+
+uint32_t VoxelArray::GetPaletteIndex(uint64_t _ParentUID) {
+    std::lock_guard<std::mutex> Lock(PaletteMutex_);
+
+    auto Existing = PaletteIndices_.find(_ParentUID);
+    if (Existing != PaletteIndices_.end()) {
+        return Existing->second;
+    }
+
+    // Out of indices, so the voxel loses its parent rather than getting someone else's
+    if (PaletteSize_ >= MaxPaletteSize_) {
+        if (!IsPaletteFull_) {
+            Logger_->Log("Voxel Array Palette Is Full, Further ParentUIDs Will Be Stored As 0", 7);
+            IsPaletteFull_ = true;
+        }
+        return 0;
+    }
+
+    uint32_t Index = PaletteSize_;
+    std::atomic<uint64_t*>& Chunk = PaletteChunks_[Index >> VOXELARRAY_PALETTE_CHUNK_SHIFT];
+    if (Chunk.load() == nullptr) {
+        Chunk.store(new uint64_t[VOXELARRAY_PALETTE_CHUNK_SIZE], std::memory_order_release);
+    }
+    Chunk.load()[Index & (VOXELARRAY_PALETTE_CHUNK_SIZE - 1)] = _ParentUID;
+    PaletteIndices_[_ParentUID] = Index;
+    PaletteSize_++;
+    return Index;
+}
+
+uint64_t VoxelArray::GetParentUID(uint32_t _PaletteIndex) {
+    uint64_t* Chunk = PaletteChunks_[_PaletteIndex >> VOXELARRAY_PALETTE_CHUNK_SHIFT].load(std::memory_order_acquire);
+    if (Chunk == nullptr) {
+        return 0;
+    }
+    return Chunk[_PaletteIndex & (VOXELARRAY_PALETTE_CHUNK_SIZE - 1)];
+}
+
+uint32_t VoxelArray::GetPaletteSize() {
+    std::lock_guard<std::mutex> Lock(PaletteMutex_);
+    return PaletteSize_;
+}
+
+void VoxelArray::SetMaxPaletteSize(uint32_t _MaxSize) {
+    std::lock_guard<std::mutex> Lock(PaletteMutex_);
+    MaxPaletteSize_ = std::clamp(_MaxSize, 1u, 1u << VOXELARRAY_PALETTE_INDEX_BITS);
+}
+
+void VoxelArray::FreeBricks() {
+    for (uint64_t i = 0; i < NumBricks_; i++) {
+        delete[] Bricks_[i].exchange(nullptr);
+    }
+    NumAllocatedBricks_ = 0;
+}
+
+void VoxelArray::ResetBricks() {
+    FreeBricks();
+
+    uint64_t BricksX = (SizeX_ + VOXELARRAY_BRICK_SIZE - 1) >> VOXELARRAY_BRICK_SIZE_SHIFT;
+    BricksY_ = (SizeY_ + VOXELARRAY_BRICK_SIZE - 1) >> VOXELARRAY_BRICK_SIZE_SHIFT;
+    BricksZ_ = (SizeZ_ + VOXELARRAY_BRICK_SIZE - 1) >> VOXELARRAY_BRICK_SIZE_SHIFT;
+    NumBricks_ = BricksX * BricksY_ * BricksZ_;
+
+    CompactVoxelType Empty;
+    Empty.State_ = VoxelState_EMPTY;
+    Empty.DistanceToEdge_vox_ = 0;
+    Empty.PaletteIndex_ = 0;
+
+    Bricks_ = std::make_unique<std::atomic<CompactVoxelType*>[]>(NumBricks_);
+    BrickValues_ = std::make_unique<CompactVoxelType[]>(NumBricks_);
+    for (uint64_t i = 0; i < NumBricks_; i++) {
+        Bricks_[i] = nullptr;
+        BrickValues_[i] = Empty;
+    }
 }
 
 void VoxelArray::ClearArray() {
 
-    std::memset(Data_.get(), 0, DataMaxLength_*sizeof(VoxelType));
+    ResetPalette();
+    if (IsSparse_) {
+        ResetBricks();
+        return;
+    }
+
+    std::memset(Data_.get(), 0, DataMaxLength_*sizeof(CompactVoxelType));
 
     // // Reset everything to 0s
     // for (uint64_t i = 0; i < DataMaxLength_; i++) {
@@ -101,20 +215,29 @@ void VoxelArray::ClearArray() {
 
 void VoxelArray::ClearArrayThreaded(int _NumThreads) {
 
+    // Freeing the bricks is cheap enough on one thread
+    ResetPalette();
+    if (IsSparse_) {
+        ResetBricks();
+        return;
+    }
+
     uint64_t ElementStepSize = DataMaxLength_ / _NumThreads;
     // VoxelType* StartAddress = Data_.get();
 
     // Initializer
-    VoxelType Empty;
+    CompactVoxelType Empty;
     Empty.State_ = VoxelState_EMPTY;
+    Empty.DistanceToEdge_vox_ = 0;
+    Empty.PaletteIndex_ = 0;
 
     // Create a bunch of memset tasks
     std::vector<std::future<int>> AsyncTasks;
-    for (size_t i = 0; i < _NumThreads; i++) {
+    for (int i = 0; i < _NumThreads; i++) {
         // VoxelType* ThreadStartAddress = StartAddress + (ElementStepSize * i);
         uint64_t ThreadStartIndex = (ElementStepSize * i);
-        uint64_t ThreadEndIndex = (ElementStepSize * i) + ElementStepSize;
-        VoxelType* Array = Data_.get();
+        uint64_t ThreadEndIndex = (i + 1 == _NumThreads) ? DataMaxLength_ : (ElementStepSize * i) + ElementStepSize; // The last thread also takes the remainder
+        CompactVoxelType* Array = Data_.get();
 
         AsyncTasks.push_back(std::async(std::launch::async, [Array, ThreadStartIndex, ThreadEndIndex, Empty]{
             for (uint64_t i = ThreadStartIndex; i < ThreadEndIndex; i++) {
@@ -159,49 +282,124 @@ uint64_t VoxelArray::GetIndex(int _X, int _Y, int _Z) {
     return uint64_t(_X)*(SizeY_*SizeZ_) + uint64_t(_Y)*SizeZ_ + uint64_t(_Z);
 }
 
-VoxelType VoxelArray::GetVoxel(int _X, int _Y, int _Z) {
+bool VoxelArray::IsInBounds(int _X, int _Y, int _Z) {
+    if (_X < 0 || _Y < 0 || _Z < 0) {
+        return false;
+    }
+    return (uint64_t(_X) < SizeX_) && (uint64_t(_Y) < SizeY_) && (uint64_t(_Z) < SizeZ_);
+}
+
+uint64_t VoxelArray::GetBrickIndex(int _X, int _Y, int _Z) {
+    uint64_t BrickX = uint64_t(_X) >> VOXELARRAY_BRICK_SIZE_SHIFT;
+    uint64_t BrickY = uint64_t(_Y) >> VOXELARRAY_BRICK_SIZE_SHIFT;
+    uint64_t BrickZ = uint64_t(_Z) >> VOXELARRAY_BRICK_SIZE_SHIFT;
+    return BrickX*(BricksY_*BricksZ_) + BrickY*BricksZ_ + BrickZ;
+}
+
+uint64_t VoxelArray::GetIndexInBrick(int _X, int _Y, int _Z) {
+    const int Mask = VOXELARRAY_BRICK_SIZE - 1;
+    return ((_X & Mask) << (2 * VOXELARRAY_BRICK_SIZE_SHIFT)) | ((_Y & Mask) << VOXELARRAY_BRICK_SIZE_SHIFT) | (_Z & Mask);
+}
+
+CompactVoxelType* VoxelArray::GetOrAllocateBrick(uint64_t _BrickIndex) {
+    CompactVoxelType* Brick = Bricks_[_BrickIndex].load(std::memory_order_acquire);
+    if (Brick != nullptr) {
+        return Brick;
+    }
+
+    // Fill a new brick with the uniform value, then publish it unless another thread was faster
+    CompactVoxelType* NewBrick = new CompactVoxelType[VOXELARRAY_BRICK_VOXELS];
+    std::fill(NewBrick, NewBrick + VOXELARRAY_BRICK_VOXELS, BrickValues_[_BrickIndex]);
+    if (Bricks_[_BrickIndex].compare_exchange_strong(Brick, NewBrick, std::memory_order_acq_rel, std::memory_order_acquire)) {
+        NumAllocatedBricks_++;
+        return NewBrick;
+    }
+    delete[] NewBrick;
+    return Brick;
+}
+
+CompactVoxelType VoxelArray::GetCompactVoxel(int _X, int _Y, int _Z) {
 
     // Check Bounds
-    if ((_X < 0 || _X >= SizeX_) || (_Y < 0 || _Y >= SizeY_) || (_Z < 0 || _Z >= SizeZ_)) {
-        VoxelType Ret;
-        Ret.ParentUID = 0;
+    if (!IsInBounds(_X, _Y, _Z)) {
+        CompactVoxelType Ret;
+        Ret.PaletteIndex_ = 0;
         Ret.DistanceToEdge_vox_ = 0;
         Ret.State_ = VoxelState_OUT_OF_BOUNDS;
         return Ret;
     }
 
+    if (IsSparse_) {
+        uint64_t BrickIndex = GetBrickIndex(_X, _Y, _Z);
+        CompactVoxelType* Brick = Bricks_[BrickIndex].load(std::memory_order_acquire);
+        if (Brick == nullptr) {
+            return BrickValues_[BrickIndex];
+        }
+        return Brick[GetIndexInBrick(_X, _Y, _Z)];
+    }
+
     // Hope this works (please work dear god don't segfault)
     uint64_t Index = GetIndex(_X, _Y, _Z);
     if (Index < DataMaxLength_) {
         return Data_.get()[Index];
     }
     
-    VoxelType Ret;
-    Ret.ParentUID = 0;
+    CompactVoxelType Ret;
+    Ret.PaletteIndex_ = 0;
     Ret.DistanceToEdge_vox_ = 0;
     Ret.State_ = VoxelState_OUT_OF_BOUNDS;
     return Ret;
 
 }
 
+VoxelType VoxelArray::GetVoxel(int _X, int _Y, int _Z) {
+    CompactVoxelType Voxel = GetCompactVoxel(_X, _Y, _Z);
+
+    VoxelType Ret;
+    Ret.State_ = VoxelState(Voxel.State_);
+    Ret.DistanceToEdge_vox_ = Voxel.DistanceToEdge_vox_;
+    Ret.ParentUID = GetParentUID(Voxel.PaletteIndex_);
+    return Ret;
+}
+
+void VoxelArray::SetCompactVoxel(int _X, int _Y, int _Z, CompactVoxelType _Value) {
+    if (IsSparse_) {
+        // Writing the value a brick already holds everywhere needs no brick
+        uint64_t BrickIndex = GetBrickIndex(_X, _Y, _Z);
+        if ((Bricks_[BrickIndex].load(std::memory_order_acquire) == nullptr) && IsSameVoxel(BrickValues_[BrickIndex], _Value)) {
+            return;
+        }
+        GetOrAllocateBrick(BrickIndex)[GetIndexInBrick(_X, _Y, _Z)] = _Value;
+        return;
+    }
+    Data_[GetIndex(_X, _Y, _Z)] = _Value;
+}
+
 void VoxelArray::SetVoxel(int _X, int _Y, int _Z, VoxelType _Value) {
     uint64_t CurrentIndex = GetIndex(_X, _Y, _Z);
-    if (CurrentIndex < 0 || CurrentIndex >= DataMaxLength_) {
+    if (IsSparse_ && !IsInBounds(_X, _Y, _Z)) {
+        CurrentIndex = DataMaxLength_;
+    }
+    if (CurrentIndex >= DataMaxLength_) {
         std::string ErrorMsg = std::string("E: Cannot Set Voxel At ") + std::to_string(_X);
         ErrorMsg += std::string(" ") + std::to_string(_Y) + std::string(" ") + std::to_string(_Z);
         ErrorMsg += std::string(" As This Would Be Out Of Range (index): ") + std::to_string(CurrentIndex) + "!";
         throw std::out_of_range(ErrorMsg.c_str());
     }
-    Data_[CurrentIndex] = _Value;
+
+    CompactVoxelType Voxel;
+    Voxel.State_ = _Value.State_;
+    Voxel.DistanceToEdge_vox_ = std::min(int(_Value.DistanceToEdge_vox_), VOXELARRAY_MAX_DISTANCE_TO_EDGE_VOX);
+    Voxel.PaletteIndex_ = GetPaletteIndex(_Value.ParentUID);
+    SetCompactVoxel(_X, _Y, _Z, Voxel);
 }
 
 void VoxelArray::SetVoxelAtIndex(int _XIndex, int _YIndex, int _ZIndex, VoxelType _Value) {
-    
-    uint64_t CurrentIndex = GetIndex(_XIndex, _YIndex, _ZIndex);
-    if (CurrentIndex < 0 || CurrentIndex >= DataMaxLength_) {
+
+    if (!IsInBounds(_XIndex, _YIndex, _ZIndex)) {
         return;
     }
-    Data_[CurrentIndex] = _Value;
+    SetVoxel(_XIndex, _YIndex, _ZIndex, _Value);
 
 }
 
@@ -213,7 +411,7 @@ void VoxelArray::SetVoxelAtPosition(float _X, float _Y, float _Z, VoxelType _Val
     int ZIndex = round((_Z - BoundingBox_.bb_point1[2])/VoxelScale_um);
 
     // Check Bounds (so if it's out of bounds, we print a warning and do nothing!)
-    if ((XIndex < 0 || XIndex >= SizeX_) || (YIndex < 0 || YIndex >= SizeY_) || (ZIndex < 0 || ZIndex >= SizeZ_)) {
+    if (!IsInBounds(XIndex, YIndex, ZIndex)) {
         return;
     }
 
@@ -314,6 +512,10 @@ bool VoxelArray::SetSize(int _X, int _Y, int _Z) {
         SizeY_ = _Y;
         SizeZ_ = _Z;
 
+        if (IsSparse_) {
+            ResetBricks();
+        }
+
         return true;
     } else {
         Logger_->Log("Cannot Resize Voxel Array To Requested Size, It Exceeds Currently Allocated Size", 10);
@@ -336,6 +538,69 @@ uint64_t VoxelArray::GetSize() {
     return DataMaxLength_;
 }
 
+bool VoxelArray::IsSparse() {
+    return IsSparse_;
+}
+
+bool VoxelArray::GetUniformBrick(int _X, int _Y, int _Z, CompactVoxelType* _Value) {
+    if (!IsSparse_ || !IsInBounds(_X, _Y, _Z)) {
+        return false;
+    }
+
+    // Bricks on the far faces reach past the array, where voxels read as out of bounds
+    if ((GetNextBrickStart(_X) > SizeX_) || (GetNextBrickStart(_Y) > SizeY_) || (GetNextBrickStart(_Z) > SizeZ_)) {
+        return false;
+    }
+    uint64_t BrickIndex = GetBrickIndex(_X, _Y, _Z);
+    if (Bricks_[BrickIndex].load(std::memory_order_acquire) != nullptr) {
+        return false;
+    }
+    (*_Value) = BrickValues_[BrickIndex];
+    return true;
+}
+
+uint64_t VoxelArray::CollapseUniformBricks() {
+    if (!IsSparse_) {
+        return 0;
+    }
+
+    uint64_t NumCollapsed = 0;
+    for (uint64_t i = 0; i < NumBricks_; i++) {
+        CompactVoxelType* Brick = Bricks_[i].load();
+        if (Brick == nullptr) {
+            continue;
+        }
+        CompactVoxelType* End = Brick + VOXELARRAY_BRICK_VOXELS;
+        if (std::all_of(Brick + 1, End, [Brick](const CompactVoxelType& _Voxel) { return IsSameVoxel(_Voxel, Brick[0]); })) {
+            BrickValues_[i] = Brick[0];
+            Bricks_[i] = nullptr;
+            delete[] Brick;
+            NumAllocatedBricks_--;
+            NumCollapsed++;
+        }
+    }
+    return NumCollapsed;
+}
+
+uint64_t VoxelArray::GetAllocatedBytes() {
+    uint64_t PaletteBytes = VOXELARRAY_PALETTE_NUM_CHUNKS * sizeof(std::atomic<uint64_t*>);
+    for (int i = 0; i < VOXELARRAY_PALETTE_NUM_CHUNKS; i++) {
+        if (PaletteChunks_[i].load() != nullptr) {
+            PaletteBytes += VOXELARRAY_PALETTE_CHUNK_SIZE * sizeof(uint64_t);
+        }
+    }
+    {
+        std::lock_guard<std::mutex> Lock(PaletteMutex_);
+        PaletteBytes += PaletteIndices_.size() * (sizeof(uint64_t) + sizeof(uint32_t) + 2 * sizeof(void*));
+    }
+
+    if (!IsSparse_) {
+        return PaletteBytes + DataMaxLength_ * sizeof(CompactVoxelType);
+    }
+    uint64_t TableBytes = NumBricks_ * (sizeof(std::atomic<CompactVoxelType*>) + sizeof(CompactVoxelType));
+    return PaletteBytes + TableBytes + NumAllocatedBricks_.load() * VOXELARRAY_BRICK_VOXELS * sizeof(CompactVoxelType);
+}
+
 int VoxelArray::GetX() {
     return SizeX_;
 }
@@ -374,38 +639,38 @@ float VoxelArray::GetZPositionAtIndex(int _ZIndex) {
     return BoundingBox_.bb_point1[2] + _ZIndex * VoxelScale_um;
 }
 
-void VoxelArray::CompositeVoxel(float _X, float _Y, float _Z, VoxelState _State, float _DistanceToEdge, uint64_t _ParentUID) {
+void VoxelArray::CompositeVoxel(float _X, float _Y, float _Z, VoxelState _State, float _DistanceToEdge, uint32_t _PaletteIndex) {
     // Convert worldspace coordinates to voxel indices
     int XIndex = round((_X - BoundingBox_.bb_point1[0]) / VoxelScale_um);
     int YIndex = round((_Y - BoundingBox_.bb_point1[1]) / VoxelScale_um);
     int ZIndex = round((_Z - BoundingBox_.bb_point1[2]) / VoxelScale_um);
 
     // Call the index-based function
-    CompositeVoxelAtIndex(XIndex, YIndex, ZIndex, _State, _DistanceToEdge, _ParentUID);
+    CompositeVoxelAtIndex(XIndex, YIndex, ZIndex, _State, _DistanceToEdge, _PaletteIndex);
 }
-void VoxelArray::CompositeVoxelAtIndex(int _X, int _Y, int _Z, VoxelState _State, float _DistanceToEdge_um, uint64_t _ParentUID) {
+void VoxelArray::CompositeVoxelAtIndex(int _X, int _Y, int _Z, VoxelState _State, float _DistanceToEdge_um, uint32_t _PaletteIndex) {
     int XIndex = _X;
     int YIndex = _Y;
     int ZIndex = _Z;
 
     // Check bounds
-    if ((XIndex < 0 || XIndex >= SizeX_) || (YIndex < 0 || YIndex >= SizeY_) || (ZIndex < 0 || ZIndex >= SizeZ_)) {
+    if (!IsInBounds(XIndex, YIndex, ZIndex)) {
         return;
     }
 
     // Get the current voxel at the index
-    VoxelType ThisVoxel = GetVoxel(XIndex, YIndex, ZIndex);
+    CompactVoxelType ThisVoxel = GetCompactVoxel(XIndex, YIndex, ZIndex);
 
     // Update the voxel state and distance to edge
-    uint8_t CorrectedDistanceToEdge_vox = std::min(255, int(_DistanceToEdge_um / VoxelScale_um));
+    uint8_t CorrectedDistanceToEdge_vox = std::min(VOXELARRAY_MAX_DISTANCE_TO_EDGE_VOX, std::max(0, int(_DistanceToEdge_um / VoxelScale_um)));
     if (ThisVoxel.DistanceToEdge_vox_ < CorrectedDistanceToEdge_vox) {
         ThisVoxel.DistanceToEdge_vox_ = CorrectedDistanceToEdge_vox;
     }
     if (ThisVoxel.State_ < VoxelState_BLACK) {
         ThisVoxel.State_ = _State;
     }
-    ThisVoxel.ParentUID = _ParentUID;
-    SetVoxel(XIndex, YIndex, ZIndex, ThisVoxel);
+    ThisVoxel.PaletteIndex_ = _PaletteIndex;
+    SetCompactVoxel(XIndex, YIndex, ZIndex, ThisVoxel);
 
 }
 
@@ -36,6 +36,9 @@
 #include <math.h>
 #include <memory>
 #include <atomic>
+#include <thread>
+#include <mutex>
+#include <unordered_map>
 
 
 // Third-Party Libraries (BG convention: use <> instead of "")
@@ -54,6 +57,17 @@ namespace NES {
 namespace Simulator {
 
 
+#define VOXELARRAY_BRICK_SIZE_SHIFT 3                           /**Sparse arrays are stored in bricks of 8x8x8 voxels*/
+#define VOXELARRAY_BRICK_SIZE (1 << VOXELARRAY_BRICK_SIZE_SHIFT)
+#define VOXELARRAY_BRICK_VOXELS (VOXELARRAY_BRICK_SIZE * VOXELARRAY_BRICK_SIZE * VOXELARRAY_BRICK_SIZE)
+
+#define VOXELARRAY_MAX_DISTANCE_TO_EDGE_VOX 31                  /**Compact voxels keep 5 bits of distance to the edge*/
+#define VOXELARRAY_PALETTE_INDEX_BITS 24                        /**Compact voxels index up to 2^24 ParentUIDs*/
+#define VOXELARRAY_PALETTE_CHUNK_SHIFT 12                       /**The palette grows in chunks of 4096 ParentUIDs*/
+#define VOXELARRAY_PALETTE_CHUNK_SIZE (1 << VOXELARRAY_PALETTE_CHUNK_SHIFT)
+#define VOXELARRAY_PALETTE_NUM_CHUNKS (1 << (VOXELARRAY_PALETTE_INDEX_BITS - VOXELARRAY_PALETTE_CHUNK_SHIFT))
+
+
 enum VoxelState:uint8_t {
     VoxelState_EMPTY=0,
     VoxelState_INTERIOR=1,
@@ -75,18 +89,70 @@ struct VoxelType {
 
 };
 
+/**
+ * @brief The form voxels are stored in, 4 bytes instead of the 16 of VoxelType.
+ * The ParentUID is replaced by an index into the array's palette of ParentUIDs,
+ * and the distance to the edge saturates at VOXELARRAY_MAX_DISTANCE_TO_EDGE_VOX,
+ * which is well beyond the borders and isosurfaces it is used for.
+ */
+struct CompactVoxelType {
+
+    uint32_t State_ : 3;                                        /**VoxelState of the voxel*/
+    uint32_t DistanceToEdge_vox_ : 5;                           /**Distance to the nearest edge in voxels, saturating*/
+    uint32_t PaletteIndex_ : VOXELARRAY_PALETTE_INDEX_BITS;     /**Index of the voxel's ParentUID in the array's palette, 0 for none*/
+
+};
+static_assert(sizeof(CompactVoxelType) == 4, "CompactVoxelType must stay 4 bytes");
+
+/**
+ * @brief Returns true if both voxels hold the same state, distance and parent.
+ */
+inline bool IsSameVoxel(const CompactVoxelType& _A, const CompactVoxelType& _B) {
+    return (_A.State_ == _B.State_) && (_A.DistanceToEdge_vox_ == _B.DistanceToEdge_vox_) && (_A.PaletteIndex_ == _B.PaletteIndex_);
+}
+
+/**
+ * @brief Returns the first index of the brick after the one holding the given index, used to walk ranges brick by brick.
+ */
+inline unsigned int GetNextBrickStart(unsigned int _Index) {
+    return ((_Index >> VOXELARRAY_BRICK_SIZE_SHIFT) + 1) << VOXELARRAY_BRICK_SIZE_SHIFT;
+}
+
 
 /**
  * @brief Defines the voxel array.
+ * Voxels are either held in one dense block, or, for sparse arrays, in bricks of
+ * VOXELARRAY_BRICK_SIZE^3 voxels that are only allocated once a voxel in them is
+ * set to something other than the value shared by the whole brick. Most of a
+ * sample is empty, so most bricks never get allocated.
+ *
+ * Either way voxels are stored as CompactVoxelType, whose ParentUIDs are kept
+ * once per array in a palette. GetVoxel() resolves them; the renderers read
+ * GetCompactVoxel() and only look up the ParentUIDs they need.
  * 
  */
 class VoxelArray {
 
 private:
 
-    std::unique_ptr<VoxelType[]> Data_; /**Big blob of memory that holds all the voxels*/
+    std::unique_ptr<CompactVoxelType[]> Data_; /**Big blob of memory that holds all the voxels*/
     uint64_t DataMaxLength_ = 0;
 
+    bool IsSparse_ = false;                                 /**Store the voxels in bricks allocated on demand instead of Data_*/
+    uint64_t BricksY_ = 0;                                  /**Number of bricks in y dimension*/
+    uint64_t BricksZ_ = 0;                                  /**Number of bricks in z dimension*/
+    uint64_t NumBricks_ = 0;                                /**Total number of bricks*/
+    std::unique_ptr<std::atomic<CompactVoxelType*>[]> Bricks_;  /**Voxels of each brick, nullptr while all of them have the brick's uniform value*/
+    std::unique_ptr<CompactVoxelType[]> BrickValues_;           /**Value of every voxel of each unallocated brick*/
+    std::atomic<uint64_t> NumAllocatedBricks_ = 0;              /**Number of bricks that hold their own voxels*/
+
+    std::unique_ptr<std::atomic<uint64_t*>[]> PaletteChunks_;      /**ParentUIDs by palette index, in chunks that never move once allocated*/
+    std::unordered_map<uint64_t, uint32_t> PaletteIndices_;        /**Palette index of each ParentUID in the palette*/
+    uint32_t PaletteSize_ = 0;                                      /**Number of ParentUIDs in the palette*/
+    uint32_t MaxPaletteSize_ = 1u << VOXELARRAY_PALETTE_INDEX_BITS; /**Number of ParentUIDs the palette may hold*/
+    bool IsPaletteFull_ = false;                                    /**Set once a ParentUID did not fit, so that this is only logged once*/
+    std::mutex PaletteMutex_;                                       /**Guards adding ParentUIDs to the palette*/
+
     uint64_t SizeX_; /**Number of voxels in x dimension*/
     uint64_t SizeY_; /**Number of voxels in y dimension*/
     uint64_t SizeZ_; /**Number of voxels in z dimension*/
@@ -108,6 +174,40 @@ private:
      */
     uint64_t GetIndex(int _X, int _Y, int _Z);
 
+    /**
+     * @brief Returns true if the given coords are inside the array.
+     */
+    bool IsInBounds(int _X, int _Y, int _Z);
+
+    /**
+     * @brief Returns the index of the brick holding the voxel at the given coords, and of the voxel within it.
+     */
+    uint64_t GetBrickIndex(int _X, int _Y, int _Z);
+    uint64_t GetIndexInBrick(int _X, int _Y, int _Z);
+
+    /**
+     * @brief Returns the voxels of the given brick, allocating them filled with the brick's uniform value if needed.
+     * Safe to call from several threads at once.
+     */
+    CompactVoxelType* GetOrAllocateBrick(uint64_t _BrickIndex);
+
+    /**
+     * @brief Stores the compact voxel at the given coords, which must be in range.
+     */
+    void SetCompactVoxel(int _X, int _Y, int _Z, CompactVoxelType _Value);
+
+    /**
+     * @brief Empties the palette, leaving only ParentUID 0 at index 0.
+     * Its chunks are kept for reuse, so this must not run while voxels are being read or written.
+     */
+    void ResetPalette();
+
+    /**
+     * @brief (Re)creates the brick tables for the current size, with every brick empty.
+     */
+    void ResetBricks();
+    void FreeBricks();
+
 
 
 public:
@@ -117,9 +217,10 @@ public:
      * 
      * @param _BB Bounding box of the array, in world space
      * @param _VoxelScale_um Scale of each voxel in micrometers
+     * @param _Sparse Store the voxels in bricks allocated on demand instead of one dense block
      */
-    VoxelArray(BG::Common::Logger::LoggingSystem* _Logger, BoundingBox _BB, float _VoxelScale_um);
-    VoxelArray(BG::Common::Logger::LoggingSystem* _Logger, ScanRegion _Region, float _VoxelScale_um);
+    VoxelArray(BG::Common::Logger::LoggingSystem* _Logger, BoundingBox _BB, float _VoxelScale_um, bool _Sparse=false);
+    VoxelArray(BG::Common::Logger::LoggingSystem* _Logger, ScanRegion _Region, float _VoxelScale_um, bool _Sparse=false);
 
     /**
      * @brief Destroy the Voxel Array object
@@ -130,7 +231,7 @@ public:
 
 
     /**
-     * @brief Returns the voxel at the given coordinates
+     * @brief Returns the voxel at the given coordinates, with its ParentUID looked up in the palette.
      * 
      * @param _X 
      * @param _Y 
@@ -139,9 +240,40 @@ public:
      */
     VoxelType GetVoxel(int _X, int _Y, int _Z);
 
+    /**
+     * @brief Returns the voxel at the given coordinates as stored, out of bounds voxels have state VoxelState_OUT_OF_BOUNDS.
+     * Use GetParentUID() on its palette index where the ParentUID is needed.
+     */
+    CompactVoxelType GetCompactVoxel(int _X, int _Y, int _Z);
+
+    /**
+     * @brief Returns the ParentUID at the given palette index.
+     * ParentUIDs are only ever appended to the palette, so indices read from voxels stay valid until the array is cleared.
+     */
+    uint64_t GetParentUID(uint32_t _PaletteIndex);
+
+    /**
+     * @brief Returns the palette index of the given ParentUID, adding it to the palette if it is new.
+     * Safe to call from several threads at once. Once the palette is full, new ParentUIDs get index 0 (no parent).
+     */
+    uint32_t GetPaletteIndex(uint64_t _ParentUID);
+
+    /**
+     * @brief Returns the number of ParentUIDs in the palette, including 0 at index 0.
+     */
+    uint32_t GetPaletteSize();
+
+    /**
+     * @brief Limits the palette to _MaxSize ParentUIDs (at most 2^VOXELARRAY_PALETTE_INDEX_BITS, the default), bounding its memory.
+     * ParentUIDs already in the palette keep their indices, new ones beyond the limit get index 0.
+     */
+    void SetMaxPaletteSize(uint32_t _MaxSize);
+
 
     /**
      * @brief Sets the voxel at the given coords to _Value.
+     * Looks up the ParentUID with GetPaletteIndex(), which takes PaletteMutex_ for every voxel. Bulk writers
+     * should look up the palette index once per shape and use CompositeVoxel(), or cache the last lookup.
      * 
      * @param _X 
      * @param _Y 
@@ -184,9 +316,10 @@ public:
 
     /**
      * @brief Compositor function that simply sets information about the sate of the given voxel.
+     * Takes the palette index of the ParentUID, which callers look up once per shape with GetPaletteIndex().
      */
-    void CompositeVoxel(float _X, float _Y, float _Z, VoxelState _State, float _DistanceToEdge, uint64_t _ParentUID);
-    void CompositeVoxelAtIndex(int _X, int _Y, int _Z, VoxelState _State, float _DistanceToEdge, uint64_t _ParentUID);
+    void CompositeVoxel(float _X, float _Y, float _Z, VoxelState _State, float _DistanceToEdge, uint32_t _PaletteIndex);
+    void CompositeVoxelAtIndex(int _X, int _Y, int _Z, VoxelState _State, float _DistanceToEdge, uint32_t _PaletteIndex);
 
     /**
      * @brief Get the size of the array, populate the int ptrs
@@ -199,6 +332,7 @@ public:
 
     /**
      * @brief Attempt to set the size of the current array, if it's less than or equal to the max array size.
+     * Sparse arrays lay out their bricks again for the new size, which empties them.
      * 
      * @param _X Dimension In Voxels
      * @param _Y Dimension In Voxels
@@ -295,6 +429,7 @@ public:
 
     /**
      * @brief Clears the given array to all 0s
+     * Sparse arrays just free their bricks, so this does not touch every voxel.
      * 
      */
     void ClearArray();
@@ -307,6 +442,29 @@ public:
      */
     uint64_t GetSize();
 
+    /**
+     * @brief Returns true if the voxels are stored in bricks allocated on demand.
+     */
+    bool IsSparse();
+
+    /**
+     * @brief Returns true if every voxel of the brick holding the given voxel has the same value, and writes it to _Value.
+     * Lets callers handle a whole brick at once instead of voxel by voxel. Always false for dense arrays,
+     * and for bricks that reach past the end of the array.
+     */
+    bool GetUniformBrick(int _X, int _Y, int _Z, CompactVoxelType* _Value);
+
+    /**
+     * @brief Frees the allocated bricks whose voxels all ended up with the same value, returns how many were freed.
+     * Must not run while voxels are being set. Does nothing for dense arrays.
+     */
+    uint64_t CollapseUniformBricks();
+
+    /**
+     * @brief Returns the number of bytes held for the voxels (bricks and their tables for sparse arrays) and the palette.
+     */
+    uint64_t GetAllocatedBytes();
+
 };
 
 
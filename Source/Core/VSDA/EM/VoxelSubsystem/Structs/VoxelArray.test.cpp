@@ -0,0 +1,497 @@
+//=================================================================//
+// This file is part of the BrainGenix-NES Neuron Emulation System //
+//=================================================================//
+
+/*
+    Description: This file provides unit tests for the dense and sparse storage of the EM voxel array.
+    Additional Notes: None
+    Date Created: 2026-10-17
+*/
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <BG/Common/Logger/Logger.h>
+#include <VSDA/EM/VoxelSubsystem/Structs/VoxelArray.h>
+
+
+/**
+ * @brief Test class for voxel arrays. Fills dense and sparse arrays with the
+ * same voxels and expects them to read back the same. Arrays are sized so
+ * that the bricks on the far faces only partly lie inside them.
+ */
+
+struct VoxelArrayTest : testing::Test {
+    BG::Common::Logger::LoggingSystem Logger;
+
+    static constexpr int SizeX = 21;
+    static constexpr int SizeY = 14;
+    static constexpr int SizeZ = 11;
+
+    std::unique_ptr<BG::NES::Simulator::VoxelArray> MakeArray(bool _Sparse, int _X = SizeX, int _Y = SizeY, int _Z = SizeZ) {
+        BG::NES::Simulator::BoundingBox BB;
+        BB.bb_point1[0] = 0.0; BB.bb_point1[1] = 0.0; BB.bb_point1[2] = 0.0;
+        BB.bb_point2[0] = _X;  BB.bb_point2[1] = _Y;  BB.bb_point2[2] = _Z;
+        return std::make_unique<BG::NES::Simulator::VoxelArray>(&Logger, BB, 1.0, _Sparse);
+    }
+
+    static uint32_t Hash(int _X, int _Y, int _Z) {
+        return (uint32_t(_X) * 73856093u) ^ (uint32_t(_Y) * 19349663u) ^ (uint32_t(_Z) * 83492791u);
+    }
+
+    // A third of the voxels is left empty, so that some bricks stay empty too.
+    static bool IsFilled(int _X, int _Y, int _Z) {
+        return (Hash(_X, _Y, _Z) % 3) != 0 && (_X < 4 || _X > 8);
+    }
+
+    static BG::NES::Simulator::VoxelType PatternVoxel(int _X, int _Y, int _Z) {
+        uint32_t H = Hash(_X, _Y, _Z);
+        BG::NES::Simulator::VoxelType Voxel;
+        Voxel.State_ = BG::NES::Simulator::VoxelState(1 + (H / 3) % 4);
+        Voxel.DistanceToEdge_vox_ = (H / 12) % 40;
+        Voxel.ParentUID = 1000 * ((H / 480) % 17) + 7;
+        return Voxel;
+    }
+
+    // Writes the voxels of every _NumParts-th flat index starting at _Part,
+    // with SetVoxel(), then composites a second shape over some of them.
+    static void Fill(BG::NES::Simulator::VoxelArray& _Array, int _Part = 0, int _NumParts = 1) {
+        int Index = 0;
+        for (int X = 0; X < SizeX; X++) {
+            for (int Y = 0; Y < SizeY; Y++) {
+                for (int Z = 0; Z < SizeZ; Z++, Index++) {
+                    if (((Index % _NumParts) != _Part) || !IsFilled(X, Y, Z)) {
+                        continue;
+                    }
+                    _Array.SetVoxel(X, Y, Z, PatternVoxel(X, Y, Z));
+                    if ((Hash(X, Y, Z) % 5) == 0) {
+                        _Array.CompositeVoxelAtIndex(X, Y, Z, BG::NES::Simulator::VoxelState_BORDER, 2.5 * (Z + 1), _Array.GetPaletteIndex(42));
+                    }
+                }
+            }
+        }
+    }
+
+    static void ExpectSameVoxels(BG::NES::Simulator::VoxelArray& _A, BG::NES::Simulator::VoxelArray& _B) {
+        for (int X = -1; X <= SizeX; X++) {
+            for (int Y = -1; Y <= SizeY; Y++) {
+                for (int Z = -1; Z <= SizeZ; Z++) {
+                    BG::NES::Simulator::VoxelType A = _A.GetVoxel(X, Y, Z);
+                    BG::NES::Simulator::VoxelType B = _B.GetVoxel(X, Y, Z);
+                    ASSERT_EQ(A.State_, B.State_) << X << "," << Y << "," << Z;
+                    ASSERT_EQ(A.DistanceToEdge_vox_, B.DistanceToEdge_vox_) << X << "," << Y << "," << Z;
+                    ASSERT_EQ(A.ParentUID, B.ParentUID) << X << "," << Y << "," << Z;
+                }
+            }
+        }
+    }
+
+    static void ExpectEmpty(BG::NES::Simulator::VoxelArray& _Array) {
+        for (int X = 0; X < _Array.GetX(); X++) {
+            for (int Y = 0; Y < _Array.GetY(); Y++) {
+                for (int Z = 0; Z < _Array.GetZ(); Z++) {
+                    BG::NES::Simulator::VoxelType Voxel = _Array.GetVoxel(X, Y, Z);
+                    ASSERT_EQ(Voxel.State_, BG::NES::Simulator::VoxelState_EMPTY) << X << "," << Y << "," << Z;
+                    ASSERT_EQ(Voxel.DistanceToEdge_vox_, 0);
+                    ASSERT_EQ(Voxel.ParentUID, 0u);
+                }
+            }
+        }
+    }
+
+    // Bricks holding at least one voxel that differs from empty.
+    static uint64_t NumFilledBricks() {
+        uint64_t Count = 0;
+        for (int BX = 0; BX < SizeX; BX += VOXELARRAY_BRICK_SIZE) {
+            for (int BY = 0; BY < SizeY; BY += VOXELARRAY_BRICK_SIZE) {
+                for (int BZ = 0; BZ < SizeZ; BZ += VOXELARRAY_BRICK_SIZE) {
+                    bool Filled = false;
+                    for (int X = BX; X < std::min(BX + VOXELARRAY_BRICK_SIZE, SizeX); X++) {
+                        for (int Y = BY; Y < std::min(BY + VOXELARRAY_BRICK_SIZE, SizeY); Y++) {
+                            for (int Z = BZ; Z < std::min(BZ + VOXELARRAY_BRICK_SIZE, SizeZ); Z++) {
+                                Filled = Filled || IsFilled(X, Y, Z);
+                            }
+                        }
+                    }
+                    Count += Filled;
+                }
+            }
+        }
+        return Count;
+    }
+
+    void TearDown() { return; }
+};
+
+TEST_F(VoxelArrayTest, test_Sparse_reads_like_dense) {
+    auto Dense = MakeArray(false);
+    auto Sparse = MakeArray(true);
+    ASSERT_FALSE(Dense->IsSparse());
+    ASSERT_TRUE(Sparse->IsSparse());
+    ExpectSameVoxels(*Dense, *Sparse);
+
+    Fill(*Dense);
+    Fill(*Sparse);
+    ExpectSameVoxels(*Dense, *Sparse);
+    ASSERT_EQ(Sparse->GetVoxel(SizeX, 0, 0).State_, BG::NES::Simulator::VoxelState_OUT_OF_BOUNDS);
+    ASSERT_EQ(Sparse->GetVoxel(SizeX - 1, SizeY - 1, SizeZ - 1).State_, Dense->GetVoxel(SizeX - 1, SizeY - 1, SizeZ - 1).State_);
+    ASSERT_THROW(Sparse->SetVoxel(SizeX, 0, 0, PatternVoxel(0, 0, 0)), std::out_of_range);
+}
+
+TEST_F(VoxelArrayTest, test_Sparse_allocates_only_filled_bricks) {
+    auto Dense = MakeArray(false);
+    auto Sparse = MakeArray(true);
+    uint64_t DenseFresh = Dense->GetAllocatedBytes();
+    uint64_t SparseFresh = Sparse->GetAllocatedBytes();
+    ASSERT_LT(SparseFresh, DenseFresh);
+
+    Fill(*Dense);
+    Fill(*Sparse);
+    uint64_t PaletteGrowth = Dense->GetAllocatedBytes() - DenseFresh;
+    uint64_t BrickBytes = VOXELARRAY_BRICK_VOXELS * sizeof(BG::NES::Simulator::CompactVoxelType);
+    ASSERT_GT(NumFilledBricks(), 0u);
+    ASSERT_EQ(Sparse->GetAllocatedBytes(), SparseFresh + PaletteGrowth + NumFilledBricks() * BrickBytes);
+}
+
+TEST_F(VoxelArrayTest, test_Concurrent_writers_share_bricks) {
+    auto Dense = MakeArray(false);
+    Fill(*Dense);
+    auto Serial = MakeArray(true);
+    Fill(*Serial);
+
+    // Neighbouring voxels go to different threads, so that they race to
+    // allocate the same bricks.
+    for (int Round = 0; Round < 5; Round++) {
+        auto Sparse = MakeArray(true);
+        const int NumThreads = 8;
+        std::atomic<int> Ready = 0;
+        std::vector<std::thread> Threads;
+        for (int i = 0; i < NumThreads; i++) {
+            Threads.emplace_back([&Sparse, &Ready, i, NumThreads]() {
+                Ready++;
+                while (Ready < NumThreads) {
+                    std::this_thread::yield();
+                }
+                Fill(*Sparse, i, NumThreads);
+            });
+        }
+        for (auto & Thread : Threads) {
+            Thread.join();
+        }
+
+        ExpectSameVoxels(*Dense, *Sparse);
+        // Each brick is published once, the bricks that lost the race are not counted.
+        ASSERT_EQ(Sparse->GetAllocatedBytes(), Serial->GetAllocatedBytes());
+        ASSERT_EQ(Sparse->GetPaletteSize(), Serial->GetPaletteSize());
+    }
+}
+
+TEST_F(VoxelArrayTest, test_CollapseUniformBricks) {
+    using namespace BG::NES::Simulator;
+    auto Sparse = MakeArray(true, 16, 16, 16);
+    uint64_t Fresh = Sparse->GetAllocatedBytes();
+
+    VoxelType Interior;
+    Interior.State_ = VoxelState_INTERIOR;
+    Interior.DistanceToEdge_vox_ = 3;
+    Interior.ParentUID = 5;
+    VoxelType Empty;
+    Empty.State_ = VoxelState_EMPTY;
+    Empty.DistanceToEdge_vox_ = 0;
+    Empty.ParentUID = 0;
+
+    // Brick 0 filled with one value, brick (8,0,0) set and reset to empty,
+    // brick (0,8,0) holding two values.
+    for (int X = 0; X < 8; X++) {
+        for (int Y = 0; Y < 8; Y++) {
+            for (int Z = 0; Z < 8; Z++) {
+                Sparse->SetVoxel(X, Y, Z, Interior);
+            }
+        }
+    }
+    Sparse->SetVoxel(9, 1, 1, Interior);
+    Sparse->SetVoxel(9, 1, 1, Empty);
+    Sparse->SetVoxel(1, 9, 1, Interior);
+
+    uint64_t BrickBytes = VOXELARRAY_BRICK_VOXELS * sizeof(CompactVoxelType);
+    uint64_t PaletteBytes = Sparse->GetAllocatedBytes() - Fresh - 3 * BrickBytes;
+    CompactVoxelType Value;
+    ASSERT_FALSE(Sparse->GetUniformBrick(0, 0, 0, &Value));
+
+    ASSERT_EQ(Sparse->CollapseUniformBricks(), 2u);
+    ASSERT_EQ(Sparse->GetAllocatedBytes(), Fresh + PaletteBytes + BrickBytes);
+    ASSERT_EQ(Sparse->CollapseUniformBricks(), 0u);
+
+    ASSERT_TRUE(Sparse->GetUniformBrick(3, 4, 5, &Value));
+    ASSERT_EQ(Value.State_, VoxelState_INTERIOR);
+    ASSERT_EQ(Value.DistanceToEdge_vox_, 3u);
+    ASSERT_EQ(Sparse->GetParentUID(Value.PaletteIndex_), 5u);
+    ASSERT_TRUE(Sparse->GetUniformBrick(9, 1, 1, &Value));
+    ASSERT_EQ(Value.State_, VoxelState_EMPTY);
+    ASSERT_FALSE(Sparse->GetUniformBrick(1, 9, 1, &Value));
+    ASSERT_EQ(Sparse->GetVoxel(7, 7, 7).ParentUID, 5u);
+    ASSERT_EQ(Sparse->GetVoxel(1, 9, 1).ParentUID, 5u);
+
+    // Writing into a collapsed brick allocates it again, filled with its value.
+    Sparse->SetVoxel(0, 0, 0, Empty);
+    ASSERT_FALSE(Sparse->GetUniformBrick(0, 0, 0, &Value));
+    ASSERT_EQ(Sparse->GetVoxel(0, 0, 0).State_, VoxelState_EMPTY);
+    ASSERT_EQ(Sparse->GetVoxel(0, 0, 1).State_, VoxelState_INTERIOR);
+    ASSERT_EQ(Sparse->GetVoxel(0, 0, 1).ParentUID, 5u);
+
+    auto Dense = MakeArray(false, 16, 16, 16);
+    Dense->SetVoxel(0, 0, 0, Interior);
+    ASSERT_EQ(Dense->CollapseUniformBricks(), 0u);
+    ASSERT_FALSE(Dense->GetUniformBrick(4, 4, 4, &Value));
+}
+
+TEST_F(VoxelArrayTest, test_GetUniformBrick_edge_bricks) {
+    using namespace BG::NES::Simulator;
+    auto Sparse = MakeArray(true, 20, 13, 9);
+    CompactVoxelType Value;
+
+    ASSERT_TRUE(Sparse->GetUniformBrick(0, 0, 0, &Value));
+    ASSERT_EQ(Value.State_, VoxelState_EMPTY);
+    ASSERT_EQ(Value.PaletteIndex_, 0u);
+    ASSERT_TRUE(Sparse->GetUniformBrick(15, 7, 7, &Value));
+
+    // Bricks that reach past the far faces are never uniform.
+    ASSERT_FALSE(Sparse->GetUniformBrick(16, 0, 0, &Value));
+    ASSERT_FALSE(Sparse->GetUniformBrick(19, 0, 0, &Value));
+    ASSERT_FALSE(Sparse->GetUniformBrick(0, 8, 0, &Value));
+    ASSERT_FALSE(Sparse->GetUniformBrick(0, 0, 8, &Value));
+
+    // Nor are voxels outside the array.
+    ASSERT_FALSE(Sparse->GetUniformBrick(-1, 0, 0, &Value));
+    ASSERT_FALSE(Sparse->GetUniformBrick(20, 0, 0, &Value));
+    ASSERT_FALSE(Sparse->GetUniformBrick(0, 13, 0, &Value));
+    ASSERT_FALSE(Sparse->GetUniformBrick(0, 0, 9, &Value));
+
+    // A voxel on the far face still reads back.
+    VoxelType Voxel;
+    Voxel.State_ = VoxelState_BORDER;
+    Voxel.DistanceToEdge_vox_ = 1;
+    Voxel.ParentUID = 99;
+    Sparse->SetVoxel(19, 12, 8, Voxel);
+    ASSERT_EQ(Sparse->GetVoxel(19, 12, 8).ParentUID, 99u);
+    ASSERT_EQ(Sparse->GetVoxel(18, 12, 8).State_, VoxelState_EMPTY);
+    ASSERT_EQ(Sparse->GetVoxel(20, 12, 8).State_, VoxelState_OUT_OF_BOUNDS);
+}
+
+TEST_F(VoxelArrayTest, test_ClearArray_and_SetSize_reset) {
+    using namespace BG::NES::Simulator;
+
+    for (bool IsSparse : {false, true}) {
+        auto Array = MakeArray(IsSparse);
+        uint64_t Fresh = Array->GetAllocatedBytes();
+        Fill(*Array);
+        ASSERT_GT(Array->GetPaletteSize(), 1u);
+
+        Array->ClearArray();
+        ExpectEmpty(*Array);
+        ASSERT_EQ(Array->GetPaletteSize(), 1u);
+        ASSERT_EQ(Array->GetAllocatedBytes(), Fresh);
+
+        // The thread count does not divide the number of voxels.
+        Fill(*Array);
+        Array->ClearArrayThreaded(4);
+        ExpectEmpty(*Array);
+        ASSERT_EQ(Array->GetAllocatedBytes(), Fresh);
+    }
+
+    // Resizing a sparse array empties it, sizes beyond the allocation are refused.
+    auto Sparse = MakeArray(true);
+    Fill(*Sparse);
+    ASSERT_FALSE(Sparse->SetSize(SizeX + 1, SizeY, SizeZ));
+    ASSERT_EQ(Sparse->GetX(), SizeX);
+    auto Dense = MakeArray(false);
+    Fill(*Dense);
+    ExpectSameVoxels(*Dense, *Sparse);
+
+    ASSERT_TRUE(Sparse->SetSize(12, 10, 9));
+    ASSERT_EQ(Sparse->GetX(), 12);
+    ASSERT_EQ(Sparse->GetY(), 10);
+    ASSERT_EQ(Sparse->GetZ(), 9);
+    ExpectEmpty(*Sparse);
+    ASSERT_EQ(Sparse->GetVoxel(12, 0, 0).State_, VoxelState_OUT_OF_BOUNDS);
+    CompactVoxelType Value;
+    ASSERT_TRUE(Sparse->GetUniformBrick(0, 0, 0, &Value));
+    ASSERT_FALSE(Sparse->GetUniformBrick(8, 0, 0, &Value));
+
+    Sparse->ClearArray();
+    ASSERT_EQ(Sparse->GetAllocatedBytes(), MakeArray(true, 12, 10, 9)->GetAllocatedBytes());
+}
+
+TEST_F(VoxelArrayTest, test_CompactVoxel_packing) {
+    using namespace BG::NES::Simulator;
+    ASSERT_EQ(sizeof(CompactVoxelType), 4u);
+
+    CompactVoxelType Voxel;
+    Voxel.State_ = VoxelState_OUT_OF_BOUNDS;
+    Voxel.DistanceToEdge_vox_ = VOXELARRAY_MAX_DISTANCE_TO_EDGE_VOX;
+    Voxel.PaletteIndex_ = (1u << VOXELARRAY_PALETTE_INDEX_BITS) - 1;
+    ASSERT_EQ(Voxel.State_, VoxelState_OUT_OF_BOUNDS);
+    ASSERT_EQ(Voxel.DistanceToEdge_vox_, 31u);
+    ASSERT_EQ(Voxel.PaletteIndex_, (1u << 24) - 1);
+
+    // Fields do not spill into each other.
+    CompactVoxelType Other = Voxel;
+    ASSERT_TRUE(IsSameVoxel(Voxel, Other));
+    Other.State_ = VoxelState_EMPTY;
+    ASSERT_EQ(Other.DistanceToEdge_vox_, 31u);
+    ASSERT_EQ(Other.PaletteIndex_, (1u << 24) - 1);
+    ASSERT_FALSE(IsSameVoxel(Voxel, Other));
+    Other = Voxel;
+    Other.DistanceToEdge_vox_ = 0;
+    ASSERT_EQ(Other.State_, VoxelState_OUT_OF_BOUNDS);
+    ASSERT_FALSE(IsSameVoxel(Voxel, Other));
+    Other = Voxel;
+    Other.PaletteIndex_ = 0;
+    ASSERT_EQ(Other.DistanceToEdge_vox_, 31u);
+    ASSERT_FALSE(IsSameVoxel(Voxel, Other));
+
+    // Stored voxels unpack to what was set.
+    for (bool IsSparse : {false, true}) {
+        auto Array = MakeArray(IsSparse);
+        VoxelType Value;
+        Value.State_ = VoxelState_WHITE;
+        Value.DistanceToEdge_vox_ = 17;
+        Value.ParentUID = 123456;
+        Array->SetVoxel(20, 13, 10, Value);
+        CompactVoxelType Stored = Array->GetCompactVoxel(20, 13, 10);
+        ASSERT_EQ(Stored.State_, VoxelState_WHITE);
+        ASSERT_EQ(Stored.DistanceToEdge_vox_, 17u);
+        ASSERT_EQ(Stored.PaletteIndex_, Array->GetPaletteIndex(123456));
+        ASSERT_EQ(Array->GetParentUID(Stored.PaletteIndex_), 123456u);
+        ASSERT_EQ(Array->GetCompactVoxel(-1, 0, 0).State_, VoxelState_OUT_OF_BOUNDS);
+    }
+}
+
+TEST_F(VoxelArrayTest, test_DistanceToEdge_saturates) {
+    using namespace BG::NES::Simulator;
+
+    for (bool IsSparse : {false, true}) {
+        auto Array = MakeArray(IsSparse);
+        VoxelType Value;
+        Value.State_ = VoxelState_INTERIOR;
+        Value.ParentUID = 1;
+        int Z = 0;
+        for (int Distance : {0, 30, 31, 32, 100, 255}) {
+            Value.DistanceToEdge_vox_ = Distance;
+            Array->SetVoxel(0, 0, Z, Value);
+            ASSERT_EQ(Array->GetVoxel(0, 0, Z).DistanceToEdge_vox_, std::min(Distance, 31)) << Distance;
+            Z++;
+        }
+
+        // Compositing converts from micrometers, saturates and never lowers the distance.
+        uint32_t Index = Array->GetPaletteIndex(2);
+        Array->CompositeVoxelAtIndex(1, 0, 0, VoxelState_BORDER, 12.0, Index);
+        ASSERT_EQ(Array->GetVoxel(1, 0, 0).DistanceToEdge_vox_, 12);
+        Array->CompositeVoxelAtIndex(1, 0, 0, VoxelState_BORDER, 5.0, Index);
+        ASSERT_EQ(Array->GetVoxel(1, 0, 0).DistanceToEdge_vox_, 12);
+        Array->CompositeVoxelAtIndex(1, 0, 0, VoxelState_BORDER, 1000.0, Index);
+        ASSERT_EQ(Array->GetVoxel(1, 0, 0).DistanceToEdge_vox_, 31);
+        Array->CompositeVoxelAtIndex(1, 0, 1, VoxelState_BORDER, -3.0, Index);
+        ASSERT_EQ(Array->GetVoxel(1, 0, 1).DistanceToEdge_vox_, 0);
+        ASSERT_EQ(Array->GetVoxel(1, 0, 1).ParentUID, 2u);
+    }
+}
+
+TEST_F(VoxelArrayTest, test_ParentUID_roundtrip) {
+    using namespace BG::NES::Simulator;
+    const std::vector<uint64_t> ParentUIDs = {0, 1, 7, 4096, 4097, uint64_t(1) << 40, ~uint64_t(0)};
+
+    for (bool IsSparse : {false, true}) {
+        auto Array = MakeArray(IsSparse);
+        ASSERT_EQ(Array->GetPaletteSize(), 1u);
+        ASSERT_EQ(Array->GetParentUID(0), 0u);
+
+        VoxelType Value;
+        Value.State_ = VoxelState_INTERIOR;
+        Value.DistanceToEdge_vox_ = 1;
+        for (size_t i = 0; i < ParentUIDs.size(); i++) {
+            Value.ParentUID = ParentUIDs[i];
+            Array->SetVoxel(i, 1, 2, Value);
+            Array->SetVoxel(i, 3, 4, Value);
+        }
+        for (size_t i = 0; i < ParentUIDs.size(); i++) {
+            ASSERT_EQ(Array->GetVoxel(i, 1, 2).ParentUID, ParentUIDs[i]);
+            ASSERT_EQ(Array->GetVoxel(i, 3, 4).ParentUID, ParentUIDs[i]);
+            ASSERT_EQ(Array->GetCompactVoxel(i, 1, 2).PaletteIndex_, Array->GetCompactVoxel(i, 3, 4).PaletteIndex_);
+        }
+        // Each ParentUID is kept once, 0 is always at index 0.
+        ASSERT_EQ(Array->GetPaletteSize(), ParentUIDs.size());
+        ASSERT_EQ(Array->GetCompactVoxel(0, 1, 2).PaletteIndex_, 0u);
+
+        // More ParentUIDs than fit into one palette chunk.
+        for (uint64_t UID = 0; UID < 2 * VOXELARRAY_PALETTE_CHUNK_SIZE; UID++) {
+            Value.ParentUID = 1000000 + UID;
+            Array->SetVoxel(UID % SizeX, (UID / SizeX) % SizeY, 10, Value);
+            ASSERT_EQ(Array->GetVoxel(UID % SizeX, (UID / SizeX) % SizeY, 10).ParentUID, 1000000 + UID);
+        }
+        ASSERT_EQ(Array->GetParentUID(Array->GetPaletteIndex(~uint64_t(0))), ~uint64_t(0));
+    }
+}
+
+TEST_F(VoxelArrayTest, test_Palette_resets_on_ClearArray) {
+    using namespace BG::NES::Simulator;
+
+    for (bool IsSparse : {false, true}) {
+        auto Array = MakeArray(IsSparse);
+        uint32_t First = Array->GetPaletteIndex(500);
+        Array->GetPaletteIndex(600);
+        ASSERT_EQ(Array->GetPaletteSize(), 3u);
+
+        Array->ClearArray();
+        ASSERT_EQ(Array->GetPaletteSize(), 1u);
+        ASSERT_EQ(Array->GetPaletteIndex(0), 0u);
+        // Indices are handed out from the start again.
+        ASSERT_EQ(Array->GetPaletteIndex(600), First);
+        ASSERT_EQ(Array->GetParentUID(First), 600u);
+        ASSERT_EQ(Array->GetPaletteSize(), 2u);
+
+        Array->ClearArrayThreaded(2);
+        ASSERT_EQ(Array->GetPaletteSize(), 1u);
+    }
+}
+
+TEST_F(VoxelArrayTest, test_Full_palette_stores_0) {
+    using namespace BG::NES::Simulator;
+
+    for (bool IsSparse : {false, true}) {
+        auto Array = MakeArray(IsSparse);
+        Array->SetMaxPaletteSize(3);
+
+        VoxelType Value;
+        Value.State_ = VoxelState_INTERIOR;
+        Value.DistanceToEdge_vox_ = 4;
+        for (uint64_t UID : {11, 12, 13, 14}) {
+            Value.ParentUID = UID;
+            Array->SetVoxel(UID, 0, 0, Value);
+        }
+        ASSERT_EQ(Array->GetPaletteSize(), 3u);
+        ASSERT_EQ(Array->GetVoxel(11, 0, 0).ParentUID, 11u);
+        ASSERT_EQ(Array->GetVoxel(12, 0, 0).ParentUID, 12u);
+        // No room left: the voxel keeps its state but loses its parent.
+        ASSERT_EQ(Array->GetVoxel(13, 0, 0).ParentUID, 0u);
+        ASSERT_EQ(Array->GetVoxel(13, 0, 0).State_, VoxelState_INTERIOR);
+        ASSERT_EQ(Array->GetPaletteIndex(14), 0u);
+        // ParentUIDs already in the palette are still found.
+        ASSERT_EQ(Array->GetParentUID(Array->GetPaletteIndex(12)), 12u);
+
+        // The limit stays, the palette empties.
+        Array->ClearArray();
+        ASSERT_NE(Array->GetPaletteIndex(13), 0u);
+        ASSERT_NE(Array->GetPaletteIndex(14), 0u);
+        ASSERT_EQ(Array->GetPaletteIndex(15), 0u);
+
+        // The limit cannot exceed what the voxels can index.
+        Array->SetMaxPaletteSize(~uint32_t(0));
+        ASSERT_NE(Array->GetPaletteIndex(15), 0u);
+    }
+}
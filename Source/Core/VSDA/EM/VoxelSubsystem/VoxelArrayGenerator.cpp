@@ -27,28 +27,6 @@ namespace NES {
 namespace Simulator {
 
 
-bool IsShapeInsideRegion(Simulation* _Sim, size_t _ShapeID, BoundingBox _Region, VSDA::WorldInfo _WorldInfo) {
-
-    bool IsInside = false;
-    Geometries::GeometryCollection* GeometryCollection = &_Sim->Collection;
-    if (GeometryCollection->IsSphere(_ShapeID)) {
-        Geometries::Sphere& ThisSphere = GeometryCollection->GetSphere(_ShapeID);
-        IsInside = ThisSphere.IsInsideRegion(_Region, _WorldInfo);
-    }
-    else if (GeometryCollection->IsBox(_ShapeID)) {
-        Geometries::Box& ThisBox = GeometryCollection->GetBox(_ShapeID); 
-        IsInside = ThisBox.IsInsideRegion(_Region, _WorldInfo);
-    }
-    else if (GeometryCollection->IsCylinder(_ShapeID)) {
-        Geometries::Cylinder& ThisCylinder = GeometryCollection->GetCylinder(_ShapeID);
-        IsInside = ThisCylinder.IsInsideRegion(_Region, _WorldInfo);
-    }
-
-    return IsInside;
-
-}
-
-
 std::vector<Geometries::Vec3D> SubdivideLine(Geometries::Vec3D Point1, Geometries::Vec3D Point2, int NumPoints) {
     std::vector<Geometries::Vec3D> segments;
 
@@ -113,6 +91,20 @@ bool CreateVoxelArrayFromSimulation(BG::Common::Logger::LoggingSystem* _Logger,
     _Logger->Log("Rasterization Preprocessing " + std::to_string(numcompartments) + " Shapes", 4);
 
 
+    // Find the shapes inside the region through the collection's spatial index,
+    // rather than testing every shape's bounding box against the region
+    std::vector<size_t> ShapesInRegion;
+    _Sim->Collection.QueryRegion(RegionBoundingBox, Info, ShapesInRegion);
+    std::vector<bool> IsShapeInRegion(_Sim->Collection.Size(), false);
+    for (size_t ShapeID : ShapesInRegion) {
+        IsShapeInRegion[ShapeID] = true;
+    }
+    _Logger->Log("Found " + std::to_string(ShapesInRegion.size()) + " Of " + std::to_string(_Sim->Collection.Size()) + " Shapes In Region", 4);
+
+    // World-space geometry for this rotation, baked once and shared by all tasks
+    std::shared_ptr<const Geometries::BakedGeometry> Baked = _Sim->Collection.GetBaked(Info);
+
+
     // Build Bounding Boxes For All Compartments
     int AddedShapes = 0;
     int TotalShapes = 0;
@@ -157,7 +149,7 @@ bool CreateVoxelArrayFromSimulation(BG::Common::Logger::LoggingSystem* _Logger,
         //     std::cout<<RegionBoundingBox.ToString()<<std::endl;
         // }
 
-        if (IsShapeInsideRegion(_Sim, ShapeID, RegionBoundingBox, Info)) {
+        if (IsShapeInRegion[ShapeID]) {
             
             
             // Check if we need to render this in parts
@@ -190,7 +182,8 @@ bool CreateVoxelArrayFromSimulation(BG::Common::Logger::LoggingSystem* _Logger,
                     Task->WorldInfo_ = Info;
                     Task->Parameters_ = _Params;
 
-                    Task->CustomSphere_ = ThisSphere;
+                    Task->CustomSphere_ = Baked->GetSphere(ShapeID);
+                    Task->CustomParentID_ = ThisSphere.ParentID;
 
                     Task->CustomThisComponent = i;
                     Task->CustomTotalComponents = NumSegments;
@@ -223,6 +216,7 @@ bool CreateVoxelArrayFromSimulation(BG::Common::Logger::LoggingSystem* _Logger,
 
                 // Calculate size of the cylinder in question
                 Geometries::Cylinder& ThisCylinder = _Sim->Collection.GetCylinder(ShapeID);
+                const Geometries::BakedCylinder& BakedCylinder = Baked->GetCylinder(ShapeID);
 
                 double AverageRadius_um = (ThisCylinder.End0Radius_um + ThisCylinder.End1Radius_um) / 2.;
                 double Distance_um = ThisCylinder.End0Pos_um.Distance(ThisCylinder.End1Pos_um);
@@ -261,11 +255,11 @@ bool CreateVoxelArrayFromSimulation(BG::Common::Logger::LoggingSystem* _Logger,
                         Task->Parameters_ = _Params;
 
                         // We have to build a new sphere cause one doesnt exist yet, so we do it just in time
-                        Geometries::Sphere ThisSphere;
-                        ThisSphere.Center_um = ThisCylinder.End0Pos_um;
-                        ThisSphere.Radius_um = ThisCylinder.End0Radius_um;
-                        ThisSphere.ParentID = ThisCylinder.ParentID;
-                        Task->CustomSphere_ = ThisSphere;
+                        Geometries::SphereBase EndSphere;
+                        EndSphere.Center_um = ThisCylinder.End0Pos_um;
+                        EndSphere.Radius_um = ThisCylinder.End0Radius_um;
+                        Task->CustomSphere_ = Geometries::BakeSphere(EndSphere, Info);
+                        Task->CustomParentID_ = ThisCylinder.ParentID;
 
                         Task->CustomThisComponent = i;
                         Task->CustomTotalComponents = NumSegments;
@@ -292,11 +286,8 @@ bool CreateVoxelArrayFromSimulation(BG::Common::Logger::LoggingSystem* _Logger,
                         Task->WorldInfo_ = Info;
                         Task->Parameters_ = _Params;
 
-                        Task->CustomCylinder_.End0Pos_um = ThisCylinder.End0Pos_um;
-                        Task->CustomCylinder_.End0Radius_um = ThisCylinder.End0Radius_um;
-                        Task->CustomCylinder_.End1Pos_um = ThisCylinder.End1Pos_um;
-                        Task->CustomCylinder_.End1Radius_um = ThisCylinder.End1Radius_um;
-                        Task->CustomCylinder_.ParentID = ThisCylinder.ParentID;
+                        Task->CustomCylinder_ = BakedCylinder;
+                        Task->CustomParentID_ = ThisCylinder.ParentID;
 
                         Task->CustomThisComponent = i;
                         Task->CustomTotalComponents = NumSegments;
@@ -359,6 +350,7 @@ bool CreateVoxelArrayFromSimulation(BG::Common::Logger::LoggingSystem* _Logger,
         Task->ShapeID_ = ShapeID;
         Task->WorldInfo_ = Info;
         Task->Parameters_ = _Params;
+        Task->Baked_ = Baked;
 
         // Calculate size of receptor box and make warning if it's huge
         if (_Sim->Collection.IsBox(Task->ShapeID_)) {
@@ -374,7 +366,7 @@ bool CreateVoxelArrayFromSimulation(BG::Common::Logger::LoggingSystem* _Logger,
         }
 
         // Now submit to render queue if it's inside the region, otherwise skip it
-        if (IsShapeInsideRegion(_Sim, ShapeID, RegionBoundingBox, Info)) {
+        if (IsShapeInRegion[ShapeID]) {
             
             AddedShapes++;
 
@@ -103,10 +103,14 @@ bool VSDA_CA_QueueRenderOperation(BG::Common::Logger::LoggingSystem* _Logger, Si
     }
 
     // Setup Enums, Indicate that work is requested
+    CaState PreviousState = _Sim->CaData_->State_;
     _Sim->CaData_->ActiveRegionID_ = _RegionID;
     _Sim->CaData_->State_ = CA_RENDER_REQUESTED;
-    _Sim->CurrentTask = Simulator::SIMULATION_CALCIUM;
-    _Sim->WorkRequested = true;
+    if (!_Sim->RequestWork(Simulator::SIMULATION_CALCIUM)) {
+        _Sim->CaData_->State_ = PreviousState;
+        _Logger->Log("VSDA Ca QueueRenderOperation Error, Simulation Is Claimed By A Task!", 6);
+        return false;
+    }
 
     return true;
 
@@ -102,10 +102,14 @@ bool VSDA_EM_QueueRenderOperation(BG::Common::Logger::LoggingSystem* _Logger, Si
     }
 
     // Setup Enums, Indicate that work is requested
+    VSDAState PreviousState = _Sim->VSDAData_->State_;
     _Sim->VSDAData_->ActiveRegionID_ = _RegionID;
     _Sim->VSDAData_->State_ = VSDA_RENDER_REQUESTED;
-    _Sim->CurrentTask = SIMULATION_VSDA;
-    _Sim->WorkRequested = true;
+    if (!_Sim->RequestWork(SIMULATION_VSDA)) {
+        _Sim->VSDAData_->State_ = PreviousState;
+        _Logger->Log("VSDA EM QueueRenderOperation Error, Simulation Is Claimed By A Task!", 6);
+        return false;
+    }
 
     return true;
 
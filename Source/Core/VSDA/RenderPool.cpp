@@ -45,7 +45,7 @@ void RenderPool::RendererThreadMainFunction(int _ThreadNumber) {
                 Logger_->Log("RenderPool Thread " + std::to_string(_ThreadNumber) + " Converting EM Stack To Neuroglancer Precomputed Format For Simulation " + std::to_string(SimToProcess->ID), 5);
                 ExecuteConversionOperation(Logger_, SimToProcess, EMImageConversionPool_.get());
             }
-            SimToProcess->IsRendering = false;
+            SimToProcess->RenderingDone();
 
         } else {
 
@@ -437,8 +437,11 @@ std::string VSDARPCInterface::VSDAEMPrepareNeuroglancerDataset(std::string _JSON
     // Setup Enums, Indicate that work is requested
     ThisSimulation->VSDAData_->ActiveRegionID_ = ScanRegionID;
     ThisSimulation->VSDAData_->State_ = VSDA_CONVERSION_REQUESTED;
-    ThisSimulation->CurrentTask = SIMULATION_VSDA;
-    ThisSimulation->WorkRequested = true;
+    if (!ThisSimulation->RequestWork(SIMULATION_VSDA)) {
+        ThisSimulation->VSDAData_->State_ = VSDA_RENDER_DONE;
+        Logger_->Log(std::string("VSDA EM PrepareNeuroglancerDataset Called On Simulation Claimed By A Task"), 7);
+        return Handle.ErrResponse(API::BGStatusCode::BGStatusSimulationBusy);
+    }
 
    
     // Build Response
@@ -678,6 +681,7 @@ std::string VSDARPCInterface::VSDACASetupMicroscope(std::string _JSONRequest) {
     Handle.GetParInt("NumPixelsPerVoxel_px", Params.NumPixelsPerVoxel_px);
     Handle.GetParFloat("BrightnessAmplification", Params.BrightnessAmplification);
     Handle.GetParFloat("AttenuationPerUm", Params.AttenuationPerUm);
+    Handle.GetParBool("UseIncrementalIndicatorFilter", Params.UseIncrementalIndicatorFilter, true);
     if (Handle.HasError()) {
         return Handle.ErrResponse();
     }
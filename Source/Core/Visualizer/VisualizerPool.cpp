@@ -49,7 +49,7 @@ void VisualizerPool::RendererThreadMainFunction(int _ThreadNumber) {
         
 
 
-            SimToProcess->IsRendering = false;
+            SimToProcess->RenderingDone();
 
 
 
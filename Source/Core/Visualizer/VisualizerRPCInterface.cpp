@@ -198,9 +198,11 @@ std::string VisualizerRPCInterface::VisualizerGenerateImages(std::string _JSONRe
 
     
 
-    Handle.Sim()->CurrentTask = SIMULATION_VISUALIZATION;
     Handle.Sim()->VisualizerParams->State = VISUALIZER_REQUESTED;
-    Handle.Sim()->WorkRequested = true;
+    if (!Handle.Sim()->RequestWork(SIMULATION_VISUALIZATION)) {
+        Handle.Sim()->VisualizerParams->State = VISUALIZER_NONE;
+        return Handle.ErrResponse(API::BGStatusCode::BGStatusSimulationBusy);
+    }
 
 
     // Return Result ID